@@ -25,6 +25,7 @@
 #include "client/dump/mysql_crawler.h"
 
 #include <stdlib.h>
+#include <string.h>
 #include <functional>
 #include <optional>
 #include <string>
@@ -241,11 +242,20 @@ void Mysql_crawler::enumerate_tables(const Database &db) {
                                 " FROM " + this->quote_name(db.get_name()),
                             &fields_data);
     std::vector<Field> fields;
+    std::string primary_key;
+    std::string primary_key_type;
+    int primary_key_parts = 0;
     for (std::vector<const Mysql::Tools::Base::Mysql_query_runner::Row
                          *>::iterator field_it = fields_data.begin();
          field_it != fields_data.end(); ++field_it) {
       fields.push_back(Field((**field_it)[0], (**field_it)[1]));
+      if ((**field_it)[3] == "PRI") {  // "Key"
+        primary_key = (**field_it)[0];
+        primary_key_type = (**field_it)[1];
+        primary_key_parts++;
+      }
     }
+    if (primary_key_parts != 1) primary_key.clear();
     Mysql::Tools::Base::Mysql_query_runner::cleanup_result(&fields_data);
     /*
       For views create a dummy view so that dependent objects are
@@ -290,22 +300,46 @@ void Mysql_crawler::enumerate_tables(const Database &db) {
 
     Table_definition_dump_task *ddl_task =
         new Table_definition_dump_task(table);
-    Table_rows_dump_task *rows_task = new Table_rows_dump_task(table);
     Table_deferred_indexes_dump_task *indexes_task =
         new Table_deferred_indexes_dump_task(table);
 
+    std::vector<Table_rows_dump_task *> rows_tasks;
+    std::vector<std::string> chunk_conditions =
+        this->get_table_chunk_conditions(runner, *table, primary_key,
+                                         primary_key_type);
+    if (chunk_conditions.empty()) {
+      rows_tasks.push_back(new Table_rows_dump_task(table));
+    } else {
+      for (std::vector<std::string>::iterator chunk_it =
+               chunk_conditions.begin();
+           chunk_it != chunk_conditions.end(); ++chunk_it) {
+        rows_tasks.push_back(new Table_rows_dump_task(
+            table, *chunk_it, chunk_it == chunk_conditions.begin()));
+      }
+    }
+
     ddl_task->add_dependency(m_current_database_start_dump_task);
-    rows_task->add_dependency(ddl_task);
-    indexes_task->add_dependency(rows_task);
+    for (Table_rows_dump_task *rows_task : rows_tasks) {
+      rows_task->add_dependency(ddl_task);
+      indexes_task->add_dependency(rows_task);
+    }
     m_current_database_end_dump_task->add_dependency(indexes_task);
     m_tables_definition_ready_dump_task->add_dependency(ddl_task);
 
     this->process_dump_task(ddl_task);
-    this->process_dump_task(rows_task);
+    for (Table_rows_dump_task *rows_task : rows_tasks)
+      this->process_dump_task(rows_task);
 
-    this->enumerate_table_triggers(*table, rows_task);
+    /*
+      Triggers and histograms must follow all rows of the table. When it is
+      split into chunks, the deferred indexes task waits for all of them.
+    */
+    Abstract_dump_task *rows_dumped_task = indexes_task;
+    if (rows_tasks.size() == 1) rows_dumped_task = rows_tasks[0];
 
-    this->enumerate_column_statistics(*table, rows_task);
+    this->enumerate_table_triggers(*table, rows_dumped_task);
+
+    this->enumerate_column_statistics(*table, rows_dumped_task);
 
     this->process_dump_task(indexes_task);
   }
@@ -320,6 +354,72 @@ void Mysql_crawler::enumerate_tables(const Database &db) {
   delete runner;
 }
 
+std::vector<std::string> Mysql_crawler::get_table_chunk_conditions(
+    Mysql::Tools::Base::Mysql_query_runner *runner, const Table &table,
+    const std::string &primary_key, const std::string &primary_key_type) {
+  std::vector<std::string> conditions;
+  uint64 chunk_rows = m_mysqldump_tool_cmaker_options->m_table_chunk_rows;
+
+  if (chunk_rows == 0 || table.get_row_count() <= chunk_rows ||
+      primary_key.empty())
+    return conditions;
+
+  static const char *integer_types[] = {"tinyint", "smallint", "mediumint",
+                                        "int", "bigint"};
+  bool is_integer = false;
+  for (const char *integer_type : integer_types) {
+    if (primary_key_type.compare(0, strlen(integer_type), integer_type) == 0)
+      is_integer = true;
+  }
+  if (!is_integer) return conditions;
+
+  std::string quoted_key = this->quote_name(primary_key);
+  std::vector<const Mysql::Tools::Base::Mysql_query_runner::Row *> range;
+  runner->run_query_store(
+      "SELECT MIN(" + quoted_key + "), MAX(" + quoted_key + ") FROM " +
+          this->get_quoted_object_full_name(table.get_schema(),
+                                            table.get_name()),
+      &range);
+
+  if (range.size() == 1 && !range[0]->is_value_null(0) &&
+      !range[0]->is_value_null(1)) {
+    const Mysql::Tools::Base::Mysql_query_runner::Row &range_data = *range[0];
+    bool is_unsigned = primary_key_type.find("unsigned") != std::string::npos;
+    /*
+      Keep both signed and unsigned keys as uint64, so that the difference
+      between them and the boundaries can be computed without overflow.
+    */
+    uint64 min_key = is_unsigned
+                         ? strtoull(range_data[0].c_str(), nullptr, 10)
+                         : (uint64)strtoll(range_data[0].c_str(), nullptr, 10);
+    uint64 max_key = is_unsigned
+                         ? strtoull(range_data[1].c_str(), nullptr, 10)
+                         : (uint64)strtoll(range_data[1].c_str(), nullptr, 10);
+    uint64 chunks = (table.get_row_count() + chunk_rows - 1) / chunk_rows;
+    uint64 step = (max_key - min_key) / chunks;
+
+    if (step > 0) {
+      auto boundary = [&](uint64 chunk) {
+        uint64 key = min_key + chunk * step;
+        return is_unsigned ? std::to_string(key)
+                           : std::to_string((int64)key);
+      };
+      /*
+        First and last chunks are open ended, so that rows are not missed
+        even if the key range changed since it was read.
+      */
+      conditions.push_back(quoted_key + " < " + boundary(1));
+      for (uint64 chunk = 1; chunk + 1 < chunks; chunk++) {
+        conditions.push_back(quoted_key + " >= " + boundary(chunk) + " AND " +
+                             quoted_key + " < " + boundary(chunk + 1));
+      }
+      conditions.push_back(quoted_key + " >= " + boundary(chunks - 1));
+    }
+  }
+  Mysql::Tools::Base::Mysql_query_runner::cleanup_result(&range);
+  return conditions;
+}
+
 void Mysql_crawler::enumerate_views(const Database &db) {
   Mysql::Tools::Base::Mysql_query_runner *runner = this->get_runner();
   std::vector<const Mysql::Tools::Base::Mysql_query_runner::Row *> tables;
@@ -26,9 +26,12 @@
 #define MYSQL_CRAWLER_INCLUDED
 
 #include <functional>
+#include <string>
+#include <vector>
 
 #include "client/base/abstract_program.h"
 #include "client/base/message_data.h"
+#include "client/base/mysql_query_runner.h"
 #include "client/dump/abstract_crawler.h"
 #include "client/dump/abstract_dump_task.h"
 #include "client/dump/abstract_mysql_chain_element_extension.h"
@@ -96,6 +99,15 @@ class Mysql_crawler : public Abstract_crawler,
   void enumerate_column_statistics(const Table &table,
                                    Abstract_dump_task *dependency);
 
+  /**
+    Returns conditions splitting rows of the table into primary key ranges
+    of about --table-chunk-rows rows each, or empty vector if the table is
+    not to be split.
+   */
+  std::vector<std::string> get_table_chunk_conditions(
+      Mysql::Tools::Base::Mysql_query_runner *runner, const Table &table,
+      const std::string &primary_key, const std::string &primary_key_type);
+
   void enumerate_views(const Database &db);
 
   template <typename TObject>
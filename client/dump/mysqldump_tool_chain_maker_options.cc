@@ -282,6 +282,13 @@ void Mysqldump_tool_chain_maker_options::create_options() {
           "of values greater than 1 is mutually exclusive with "
           "--single-transaction.")
       ->set_value(2);
+  this->create_new_option(
+          &m_table_chunk_rows, "table-chunk-rows",
+          "Split rows of tables having more than N rows and a single column "
+          "integer primary key into primary key ranges of about N rows, so "
+          "that parallel queue threads can dump them concurrently. 0 "
+          "disables splitting.")
+      ->set_value(0);
   this->create_new_option(
       &m_result_file, "result-file",
       "Direct all output generated for all objects to a given file.");
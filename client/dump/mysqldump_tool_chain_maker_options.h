@@ -67,6 +67,7 @@ class Mysqldump_tool_chain_maker_options
   bool m_dump_all_databases;
   bool m_dump_selected_databases;
   uint32 m_default_parallelism;
+  uint64 m_table_chunk_rows;
   std::optional<std::string> m_result_file;
   std::optional<std::string> m_compress_output_algorithm;
   bool m_skip_rows_data;
@@ -26,5 +26,15 @@
 
 using namespace Mysql::Tools::Dump;
 
-Table_rows_dump_task::Table_rows_dump_task(Table *related_table)
-    : Abstract_table_dump_task(related_table) {}
+Table_rows_dump_task::Table_rows_dump_task(Table *related_table,
+                                           const std::string &chunk_condition,
+                                           bool is_first_chunk)
+    : Abstract_table_dump_task(related_table),
+      m_chunk_condition(chunk_condition),
+      m_is_first_chunk(is_first_chunk) {}
+
+const std::string &Table_rows_dump_task::get_chunk_condition() const {
+  return m_chunk_condition;
+}
+
+bool Table_rows_dump_task::is_first_chunk() const { return m_is_first_chunk; }
@@ -25,6 +25,8 @@
 #ifndef TABLE_ROWS_DUMP_TASK_INCLUDED
 #define TABLE_ROWS_DUMP_TASK_INCLUDED
 
+#include <string>
+
 #include "client/dump/abstract_table_dump_task.h"
 
 namespace Mysql {
@@ -32,11 +34,30 @@ namespace Tools {
 namespace Dump {
 
 /**
-  Represents task for extracting rows of single DB table.
+  Represents task for extracting rows of single DB table, or of a single
+  primary key range of it when the table is split into chunks.
  */
 class Table_rows_dump_task : public Abstract_table_dump_task {
  public:
-  explicit Table_rows_dump_task(Table *related_table);
+  explicit Table_rows_dump_task(Table *related_table,
+                                const std::string &chunk_condition = "",
+                                bool is_first_chunk = true);
+
+  /**
+    Returns condition selecting rows of the chunk this task dumps, or empty
+    string if the task dumps all rows of the table.
+   */
+  const std::string &get_chunk_condition() const;
+
+  /**
+    Returns true for the only task of a table that is not split into chunks
+    and for the first chunk of a table that is.
+   */
+  bool is_first_chunk() const;
+
+ private:
+  std::string m_chunk_condition;
+  bool m_is_first_chunk;
 };
 
 }  // namespace Dump
@@ -1180,6 +1180,75 @@ static bool shall_skip_gtids(const Log_event *ev) {
   return filtered;
 }
 
+/**
+  Check if an event of the given type, met while filter_based_on_gtids is
+  set, is filtered out by shall_skip_gtids() whatever its content. Such
+  events need not be decoded at all.
+
+  @param type Type code of the event.
+
+  @return true if the event is skipped, false otherwise.
+*/
+static bool is_skipped_in_filtered_transaction(Log_event_type type) {
+  switch (type) {
+    case binary_log::GTID_LOG_EVENT:
+    case binary_log::ANONYMOUS_GTID_LOG_EVENT:
+    case binary_log::PREVIOUS_GTIDS_LOG_EVENT:
+    case binary_log::XID_EVENT:
+    case binary_log::QUERY_EVENT:
+    case binary_log::SLAVE_EVENT:
+    case binary_log::STOP_EVENT:
+    case binary_log::FORMAT_DESCRIPTION_EVENT:
+    case binary_log::ROTATE_EVENT:
+    case binary_log::IGNORABLE_LOG_EVENT:
+    case binary_log::INCIDENT_EVENT:
+      return false;
+    default:
+      return true;
+  }
+}
+
+/**
+  Do for an undecoded event, for which is_skipped_in_filtered_transaction()
+  holds, what process_event() does for it before shall_skip_gtids() skips
+  it: apply the offset, date and position range options and print the
+  position of the event.
+
+  @param print_event_info Parameters and context state determining how to
+  print.
+  @param event_data Serialized event.
+  @param pos Position of the event in the binlog.
+
+  @retval OK_CONTINUE No error, the program should continue.
+  @retval OK_STOP The end of the specified range of events is reached.
+*/
+static Exit_status process_filtered_event(PRINT_EVENT_INFO *print_event_info,
+                                          const unsigned char *event_data,
+                                          my_off_t pos) {
+  char ll_buff[21];
+  Exit_status retval = OK_CONTINUE;
+  my_time_t when = uint4korr(event_data);
+  ulong server_id = uint4korr(event_data + SERVER_ID_OFFSET);
+
+  if (rec_count >= offset && when >= start_datetime) {
+    start_datetime = 0;
+    offset = 0;
+    // Events skipped by --server-id are not checked against stop options.
+    bool skipped_by_server_id =
+        filter_server_id &&
+        filter_server_id != (server_id & opt_server_id_mask);
+    if (!skipped_by_server_id) {
+      if (pos >= stop_position_mot || when >= stop_datetime)
+        retval = OK_STOP;
+      else if (!short_form)
+        my_b_printf(&print_event_info->head_cache, "# at %s\n",
+                    llstr(pos, ll_buff));
+    }
+  }
+  rec_count++;
+  return retval;
+}
+
 /**
   Print auxiliary statements ending a binary log (or a logical binary log
   within a sequence of relay logs; see below).
@@ -3055,6 +3124,35 @@ static Exit_status dump_local_log_entries(PRINT_EVENT_INFO *print_event_info,
     char llbuff[21];
     my_off_t old_off = mysqlbinlog_file_reader.position();
 
+    /*
+      Inside a transaction filtered out by --include-gtids or
+      --exclude-gtids, skip row and other data events without decoding
+      them, which is most of the work for large or compressed transactions.
+      Other events are read again and decoded as usual. Stdin can not seek
+      back, and --require-row-format needs every event decoded.
+    */
+    if (filter_based_on_gtids && !opt_require_row_format &&
+        strcmp(logname, "-") != 0) {
+      unsigned char *event_data = nullptr;
+      unsigned int event_len = 0;
+      if (!mysqlbinlog_file_reader.read_event_data(&event_data, &event_len)) {
+        bool skipped = is_skipped_in_filtered_transaction(
+            static_cast<Log_event_type>(event_data[EVENT_TYPE_OFFSET]));
+        if (skipped)
+          retval = process_filtered_event(print_event_info, event_data,
+                                          old_off);
+        mysqlbinlog_file_reader.allocator()->deallocate(event_data);
+        if (skipped) {
+          if (retval != OK_CONTINUE) return retval;
+          continue;
+        }
+      }
+      if (mysqlbinlog_file_reader.seek(old_off)) {
+        error("Could not seek back to offset %s.", llstr(old_off, llbuff));
+        return ERROR_STOP;
+      }
+    }
+
     Log_event *ev = mysqlbinlog_file_reader.read_event_object();
     if (ev == nullptr) {
       /*
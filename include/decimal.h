@@ -66,6 +66,27 @@ int decimal2ulonglong(const decimal_t *from, ulonglong *to);
 int ulonglong2decimal(ulonglong from, decimal_t *to);
 int decimal2longlong(const decimal_t *from, longlong *to);
 int longlong2decimal(longlong from, decimal_t *to);
+#ifdef __SIZEOF_INT128__
+/**
+  Convert a decimal to an integer scaled by 10^scale, e.g. 12.34 with
+  scale 3 becomes 12340.
+
+  @param  from   Decimal value, with at most "scale" fractional digits
+  @param  scale  Number of fractional digits to keep, at most
+                 DECIMAL_MAX_SCALE
+  @param  [out] to  Scaled value, with at most 38 digits
+
+  @retval E_DEC_OK         on success
+  @retval E_DEC_TRUNCATED  if "from" has more than "scale" fractional digits
+  @retval E_DEC_OVERFLOW   if the result needs more than 38 digits
+*/
+int decimal2int128(const decimal_t *from, int scale, __int128 *to);
+/**
+  Convert an integer scaled by 10^scale back to a decimal with "scale"
+  fractional digits. The inverse of decimal2int128().
+*/
+int int1282decimal(__int128 from, int scale, decimal_t *to);
+#endif
 int decimal2double(const decimal_t *from, double *to);
 int double2decimal(double from, decimal_t *to);
 int decimal_actual_fraction(const decimal_t *from);
@@ -175,7 +175,8 @@ enum enum_cursor_type {
   CURSOR_TYPE_READ_ONLY = 1,
   CURSOR_TYPE_FOR_UPDATE = 2,
   CURSOR_TYPE_SCROLLABLE = 4,
-  PARAMETER_COUNT_AVAILABLE = 8
+  PARAMETER_COUNT_AVAILABLE = 8,
+  PARAMETER_ARRAY_AVAILABLE = 16
 };
 enum enum_mysql_set_option {
   MYSQL_OPTION_MULTI_STATEMENTS_ON,
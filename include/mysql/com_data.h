@@ -67,6 +67,11 @@ struct COM_STMT_EXECUTE_DATA {
   PS_PARAM *parameters;
   unsigned long parameter_count;
   unsigned char has_new_types;
+  /**
+    Number of parameter rows in parameters, each of parameter_count
+    values. Only used with PARAMETER_ARRAY_AVAILABLE.
+  */
+  unsigned long iteration_count;
 };
 
 struct COM_STMT_FETCH_DATA {
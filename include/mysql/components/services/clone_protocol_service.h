@@ -62,6 +62,11 @@ struct mysql_clone_ssl_context {
   /** Enable network compression. */
   bool m_enable_compression;
   NET_SERVER *m_server_extn;
+
+  /** Network compression algorithm: "zlib" or "zstd". */
+  const char *m_compression_algorithm;
+  /** Compression level used with zstd. */
+  unsigned int m_zstd_compression_level;
 };
 
 /** Vector of string values */
@@ -28,6 +28,7 @@ struct COM_STMT_EXECUTE_DATA {
   PS_PARAM *parameters;
   unsigned long parameter_count;
   unsigned char has_new_types;
+  unsigned long iteration_count;
 };
 struct COM_STMT_FETCH_DATA {
   unsigned long stmt_id;
@@ -1049,7 +1049,12 @@ enum enum_cursor_type {
     On when the client will send the parameter count
     even for 0 parameters.
   */
-  PARAMETER_COUNT_AVAILABLE = 8
+  PARAMETER_COUNT_AVAILABLE = 8,
+  /**
+    On when iteration_count rows of parameter values are sent, to
+    execute the statement once for each row.
+  */
+  PARAMETER_ARRAY_AVAILABLE = 16
 };
 
 /** options for ::mysql_options() */
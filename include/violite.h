@@ -162,6 +162,7 @@ void vio_delete(MYSQL_VIO vio);
 int vio_shutdown(MYSQL_VIO vio);
 bool vio_reset(MYSQL_VIO vio, enum enum_vio_type type, my_socket sd, void *ssl,
                uint flags);
+bool vio_set_buffered_read(MYSQL_VIO vio);
 bool vio_is_blocking(Vio *vio);
 int vio_set_blocking(Vio *vio, bool set_blocking_mode);
 int vio_set_blocking_flag(Vio *vio, bool set_blocking_flag);
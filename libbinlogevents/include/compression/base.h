@@ -155,6 +155,18 @@ class Compressor : public Base_compressor_decompressor {
   */
   virtual void set_compression_level(unsigned int compression_level) = 0;
 
+  /**
+    Announces the exact number of bytes that will be compressed before the
+    compressor is next closed. Compressors may use it to size their internal
+    state for the input. It is only effective if done before opening the
+    compressor, and it applies to that one stream only.
+
+    The default implementation ignores the hint.
+
+    @param size the number of bytes that will be compressed.
+  */
+  virtual void set_pledged_input_size(std::size_t size);
+
   /**
     This member function SHALL compress the data provided with the given
     length. Note that the buffer to store the compressed data must have
@@ -70,6 +70,12 @@ class Zstd_comp : public Compressor {
    */
   unsigned int m_compression_level_next{DEFAULT_COMPRESSION_LEVEL};
 
+  /**
+    The input size announced for the next stream, or
+    ZSTD_CONTENTSIZE_UNKNOWN if none was announced.
+   */
+  unsigned long long m_pledged_input_size{ZSTD_CONTENTSIZE_UNKNOWN};
+
  public:
   Zstd_comp();
   ~Zstd_comp() override;
@@ -78,6 +84,13 @@ class Zstd_comp : public Compressor {
    */
   void set_compression_level(unsigned int compression_level) override;
 
+  /**
+    Shall announce the size of the next stream. Knowing it lets ZSTD pick
+    smaller tables and windows for small inputs, which makes compressing
+    small transactions cheaper, and records the size in the frame header.
+   */
+  void set_pledged_input_size(std::size_t size) override;
+
   /**
     Shall get the compressor type code.
 
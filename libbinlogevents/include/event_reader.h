@@ -445,8 +445,11 @@ class Event_reader {
     @param[out] destination the vector be filled.
     @param[in] length the amount of bytes to read from the cursor (and to move
                       forward).
+    @param[in] spare extra capacity to reserve in the vector, so that the
+                     caller can append that many bytes without reallocating.
   */
-  void assign(std::vector<uint8_t> *destination, size_t length);
+  void assign(std::vector<uint8_t> *destination, size_t length,
+              size_t spare = 0);
 
  private:
   /* The buffer with the serialized binary log event */
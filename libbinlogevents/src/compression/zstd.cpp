@@ -60,6 +60,10 @@ void Zstd_comp::set_compression_level(unsigned int clevel) {
   }
 }
 
+void Zstd_comp::set_pledged_input_size(std::size_t size) {
+  m_pledged_input_size = size;
+}
+
 Zstd_comp::~Zstd_comp() {
   if (m_ctx != nullptr) {
     ZSTD_freeCStream(m_ctx);
@@ -73,6 +77,8 @@ type Zstd_comp::compression_type_code() { return ZSTD; }
 
 bool Zstd_comp::open() {
   size_t ret{0};
+  [[maybe_unused]] unsigned long long pledged_input_size{m_pledged_input_size};
+  m_pledged_input_size = ZSTD_CONTENTSIZE_UNKNOWN;
   if (m_ctx == nullptr) goto err;
 
     /*
@@ -87,14 +93,14 @@ bool Zstd_comp::open() {
   if (m_compression_level_current == m_compression_level_next) {
     ret = ZSTD_CCtx_reset(m_ctx, ZSTD_reset_session_only);
     if (ZSTD_isError(ret)) goto err;
-
-    ret = ZSTD_CCtx_setPledgedSrcSize(m_ctx, ZSTD_CONTENTSIZE_UNKNOWN);
-    if (ZSTD_isError(ret)) goto err;
   } else {
     ret = ZSTD_initCStream(m_ctx, m_compression_level_next);
     if (ZSTD_isError(ret)) goto err;
     m_compression_level_current = m_compression_level_next;
   }
+
+  ret = ZSTD_CCtx_setPledgedSrcSize(m_ctx, pledged_input_size);
+  if (ZSTD_isError(ret)) goto err;
 #else
   ret = ZSTD_initCStream(m_ctx, m_compression_level_next);
   if (ZSTD_isError(ret)) goto err;
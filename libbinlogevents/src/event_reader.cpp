@@ -210,7 +210,8 @@ void Event_reader::strncpyz(char *destination, size_t max_length,
   m_ptr = m_ptr + strlen(destination) + 1;
 }
 
-void Event_reader::assign(std::vector<uint8_t> *vector, size_t length) {
+void Event_reader::assign(std::vector<uint8_t> *vector, size_t length,
+                          size_t spare) {
   PRINT_READER_STATUS("Event_reader::assign");
   BAPI_ASSERT(vector->empty());
   if (!can_read(length)) {
@@ -218,6 +219,7 @@ void Event_reader::assign(std::vector<uint8_t> *vector, size_t length) {
     return;
   }
   try {
+    vector->reserve(length + spare);
     vector->assign(m_ptr, m_ptr + length);
   } catch (const std::bad_alloc &) {
     vector->clear();
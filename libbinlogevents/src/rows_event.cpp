@@ -473,7 +473,12 @@ Rows_event::Rows_event(const char *buf, const Format_description_event *fde)
     columns_after_image = columns_before_image;
 
   data_size = READER_CALL(available_to_read);
-  READER_TRY_CALL(assign, &row, data_size);
+  /*
+    Reserve room for the trailing byte up front: for large row images the
+    push_back below would otherwise reallocate and copy the whole buffer a
+    second time on the applier coordinator.
+  */
+  READER_TRY_CALL(assign, &row, data_size, 1);
   // JAG: TODO: Investigate and comment here about the need of this extra byte
   row.push_back(0);
 
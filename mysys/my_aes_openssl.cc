@@ -143,6 +143,58 @@ int my_create_key(unsigned char *rkey, const unsigned char *key,
   return 0;
 }
 
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+namespace {
+/**
+  A cipher context kept per thread and reused across calls. Callers such as
+  InnoDB tablespace encryption use the same key for every page, so when the
+  cipher, key and direction are unchanged only the IV is reset: no context is
+  allocated and the key schedule is not expanded again.
+*/
+class Thread_cipher_ctx {
+ public:
+  ~Thread_cipher_ctx() { EVP_CIPHER_CTX_free(m_ctx); }
+
+  /**
+    Get the context, initialized for the given cipher, key, IV and direction.
+
+    @return the context, or nullptr on failure
+  */
+  EVP_CIPHER_CTX *init(const EVP_CIPHER *cipher, const unsigned char *key,
+                       const unsigned char *iv, bool encrypt) {
+    if (m_ctx == nullptr && (m_ctx = EVP_CIPHER_CTX_new()) == nullptr)
+      return nullptr;
+
+    const size_t key_size = EVP_CIPHER_key_length(cipher);
+    const bool same_key = cipher == m_cipher && encrypt == m_encrypt &&
+                          memcmp(key, m_key, key_size) == 0;
+    if (!EVP_CipherInit_ex(m_ctx, same_key ? nullptr : cipher, nullptr,
+                           same_key ? nullptr : key, iv, encrypt ? 1 : 0)) {
+      invalidate();
+      return nullptr;
+    }
+    if (!same_key) {
+      m_cipher = cipher;
+      m_encrypt = encrypt;
+      memcpy(m_key, key, key_size);
+    }
+    return m_ctx;
+  }
+
+  /// Forget the key, so that the next init() sets the context up again.
+  void invalidate() { m_cipher = nullptr; }
+
+ private:
+  EVP_CIPHER_CTX *m_ctx{nullptr};
+  const EVP_CIPHER *m_cipher{nullptr};
+  bool m_encrypt{false};
+  unsigned char m_key[MAX_AES_KEY_LENGTH / 8];
+};
+
+thread_local Thread_cipher_ctx thread_cipher_ctx;
+}  // namespace
+#endif /* OPENSSL_VERSION_NUMBER >= 0x10100000L */
+
 int my_aes_encrypt(const unsigned char *source, uint32 source_length,
                    unsigned char *dest, const unsigned char *key,
                    uint32 key_length, enum my_aes_opmode mode,
@@ -152,7 +204,7 @@ int my_aes_encrypt(const unsigned char *source, uint32 source_length,
   EVP_CIPHER_CTX stack_ctx;
   EVP_CIPHER_CTX *ctx = &stack_ctx;
 #else  /* OPENSSL_VERSION_NUMBER < 0x10100000L */
-  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  EVP_CIPHER_CTX *ctx = nullptr;
 #endif /* OPENSSL_VERSION_NUMBER < 0x10100000L */
   const EVP_CIPHER *cipher = aes_evp_type(mode);
   int u_len, f_len;
@@ -162,10 +214,15 @@ int my_aes_encrypt(const unsigned char *source, uint32 source_length,
   if (my_create_key(rkey, key, key_length, mode, kdf_options)) {
     return MY_AES_BAD_DATA;
   }
-  if (!ctx || !cipher || (EVP_CIPHER_iv_length(cipher) > 0 && !iv))
+  if (!cipher || (EVP_CIPHER_iv_length(cipher) > 0 && !iv))
     return MY_AES_BAD_DATA;
 
-  if (!EVP_EncryptInit(ctx, cipher, rkey, iv)) goto aes_error;   /* Error */
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+  if (!EVP_EncryptInit(ctx, cipher, rkey, iv)) goto aes_error; /* Error */
+#else  /* OPENSSL_VERSION_NUMBER < 0x10100000L */
+  ctx = thread_cipher_ctx.init(cipher, rkey, iv, true);
+  if (ctx == nullptr) goto aes_error; /* Error */
+#endif /* OPENSSL_VERSION_NUMBER < 0x10100000L */
   if (!EVP_CIPHER_CTX_set_padding(ctx, padding)) goto aes_error; /* Error */
   if (!EVP_EncryptUpdate(ctx, dest, &u_len, source, source_length))
     goto aes_error; /* Error */
@@ -174,8 +231,6 @@ int my_aes_encrypt(const unsigned char *source, uint32 source_length,
 
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
   EVP_CIPHER_CTX_cleanup(ctx);
-#else  /* OPENSSL_VERSION_NUMBER < 0x10100000L */
-  EVP_CIPHER_CTX_free(ctx);
 #endif /* OPENSSL_VERSION_NUMBER < 0x10100000L */
   return u_len + f_len;
 
@@ -185,7 +240,7 @@ aes_error:
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
   EVP_CIPHER_CTX_cleanup(ctx);
 #else  /* OPENSSL_VERSION_NUMBER < 0x10100000L */
-  EVP_CIPHER_CTX_free(ctx);
+  thread_cipher_ctx.invalidate();
 #endif /* OPENSSL_VERSION_NUMBER < 0x10100000L */
   return MY_AES_BAD_DATA;
 }
@@ -199,7 +254,7 @@ int my_aes_decrypt(const unsigned char *source, uint32 source_length,
   EVP_CIPHER_CTX stack_ctx;
   EVP_CIPHER_CTX *ctx = &stack_ctx;
 #else  /* OPENSSL_VERSION_NUMBER < 0x10100000L */
-  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  EVP_CIPHER_CTX *ctx = nullptr;
 #endif /* OPENSSL_VERSION_NUMBER < 0x10100000L */
   const EVP_CIPHER *cipher = aes_evp_type(mode);
   int u_len, f_len;
@@ -211,11 +266,16 @@ int my_aes_decrypt(const unsigned char *source, uint32 source_length,
     return MY_AES_BAD_DATA;
   }
 
-  if (!ctx || !cipher || (EVP_CIPHER_iv_length(cipher) > 0 && !iv))
+  if (!cipher || (EVP_CIPHER_iv_length(cipher) > 0 && !iv))
     return MY_AES_BAD_DATA;
 
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
   if (!EVP_DecryptInit(ctx, aes_evp_type(mode), rkey, iv))
-    goto aes_error;                                              /* Error */
+    goto aes_error; /* Error */
+#else  /* OPENSSL_VERSION_NUMBER < 0x10100000L */
+  ctx = thread_cipher_ctx.init(cipher, rkey, iv, false);
+  if (ctx == nullptr) goto aes_error; /* Error */
+#endif /* OPENSSL_VERSION_NUMBER < 0x10100000L */
   if (!EVP_CIPHER_CTX_set_padding(ctx, padding)) goto aes_error; /* Error */
   if (!EVP_DecryptUpdate(ctx, dest, &u_len, source, source_length))
     goto aes_error; /* Error */
@@ -224,8 +284,6 @@ int my_aes_decrypt(const unsigned char *source, uint32 source_length,
 
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
   EVP_CIPHER_CTX_cleanup(ctx);
-#else  /* OPENSSL_VERSION_NUMBER < 0x10100000L */
-  EVP_CIPHER_CTX_free(ctx);
 #endif /* OPENSSL_VERSION_NUMBER < 0x10100000L */
 
   return u_len + f_len;
@@ -236,7 +294,7 @@ aes_error:
 #if OPENSSL_VERSION_NUMBER < 0x10100000L
   EVP_CIPHER_CTX_cleanup(ctx);
 #else  /* OPENSSL_VERSION_NUMBER < 0x10100000L */
-  EVP_CIPHER_CTX_free(ctx);
+  thread_cipher_ctx.invalidate();
 #endif /* OPENSSL_VERSION_NUMBER < 0x10100000L */
   return MY_AES_BAD_DATA;
 }
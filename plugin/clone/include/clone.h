@@ -90,6 +90,15 @@ extern uint clone_max_io_bandwidth;
 /** Clone system variable: If network compression is enabled */
 extern bool clone_enable_compression;
 
+/** Clone system variable: Network compression algorithm */
+extern ulong clone_compression_algorithm;
+
+/** Network compression algorithm names */
+extern const char *clone_compression_algorithm_names[];
+
+/** Clone system variable: Compression level for zstd */
+extern uint clone_zstd_compression_level;
+
 /** Clone system variable: SSL private key */
 extern char *clone_client_ssl_private_key;
 
@@ -67,6 +67,12 @@ uint clone_max_io_bandwidth;
 /** Clone system variable: If network compression is enabled */
 bool clone_enable_compression;
 
+/** Clone system variable: Network compression algorithm */
+ulong clone_compression_algorithm;
+
+/** Clone system variable: Compression level for zstd */
+uint clone_zstd_compression_level;
+
 /** Clone system variable: valid list of donor addresses. */
 static char *clone_valid_donor_list;
 
@@ -575,6 +581,33 @@ static MYSQL_SYSVAR_BOOL(enable_compression, clone_enable_compression,
                          "If compression is done at network", nullptr, nullptr,
                          false); /* Disable compression by default */
 
+/** Network compression algorithm names. */
+const char *clone_compression_algorithm_names[] = {"zlib", "zstd", NullS};
+
+/** Network compression algorithm type library. */
+static TYPELIB clone_compression_algorithm_typelib = {
+    array_elements(clone_compression_algorithm_names) - 1,
+    "clone_compression_algorithm_typelib", clone_compression_algorithm_names,
+    nullptr};
+
+/** Compression algorithm used when clone_enable_compression is set. */
+static MYSQL_SYSVAR_ENUM(compression_algorithm, clone_compression_algorithm,
+                         PLUGIN_VAR_RQCMDARG,
+                         "Network compression algorithm used when "
+                         "clone_enable_compression is ON: zlib or zstd",
+                         nullptr, nullptr, 0, /* Default = zlib */
+                         &clone_compression_algorithm_typelib);
+
+/** Compression level for zstd network compression. */
+static MYSQL_SYSVAR_UINT(zstd_compression_level, clone_zstd_compression_level,
+                         PLUGIN_VAR_RQCMDARG,
+                         "Compression level for zstd network compression. "
+                         "Lower levels use less CPU on the donor.",
+                         nullptr, nullptr, 3, /* Default =  3 */
+                         1,                   /* Minimum =  1 */
+                         22,                  /* Maximum = 22 */
+                         1);                  /* Step    =  1 */
+
 /** List of valid donor addresses allowed to clone from. */
 static MYSQL_SYSVAR_STR(valid_donor_list, clone_valid_donor_list,
                         PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_MEMALLOC,
@@ -637,6 +670,8 @@ static SYS_VAR *clone_system_variables[] = {
     MYSQL_SYSVAR(max_network_bandwidth),
     MYSQL_SYSVAR(max_data_bandwidth),
     MYSQL_SYSVAR(enable_compression),
+    MYSQL_SYSVAR(compression_algorithm),
+    MYSQL_SYSVAR(zstd_compression_level),
     MYSQL_SYSVAR(autotune_concurrency),
     MYSQL_SYSVAR(valid_donor_list),
     MYSQL_SYSVAR(ssl_key),
@@ -160,6 +160,21 @@ class Gcs_message_data {
 
   bool decode(const uchar *data, uint64_t data_len);
 
+  /**
+    Decodes data received via GCS without copying it. This object takes
+    ownership of the allocation that holds the data, which must have been
+    obtained with malloc, and frees it when deleted. It must only be called
+    on an object created with the default constructor.
+
+    @param[in] allocation Buffer that contains the data
+    @param[in] data Data received via network, located inside allocation
+    @param[in] data_len Data length received via network
+
+    @return true on error, false otherwise.
+  */
+
+  bool decode_in_place(uchar *allocation, uchar *data, uint64_t data_len);
+
   /**
     @return the message header in little endian format
   */
@@ -261,6 +276,21 @@ class Gcs_message_data {
   */
   bool m_owner;
 
+  /*
+    Allocation to free when deleted if it is not m_buffer itself, which
+    happens when the buffer was adopted by decode_in_place().
+  */
+  uchar *m_allocation;
+
+  /**
+    Parses the header and payload lengths out of the internal buffer.
+
+    @param[in] data_len Length of the encoded data in the internal buffer
+
+    @return true on error, false otherwise.
+  */
+  bool decode_buffer(uint64_t data_len);
+
   /**
     On memory allocation this function is called, so that memory
     consumption can be tracked.
@@ -289,6 +289,10 @@ bool Gcs_packet::allocate_serialization_buffer() {
   return error;
 }
 
+Gcs_packet::buffer_ptr Gcs_packet::release_serialization_buffer() {
+  return std::move(m_serialized_packet);
+}
+
 std::pair<Gcs_packet::buffer_ptr, unsigned long long> Gcs_packet::serialize() {
   assert(m_serialized_packet.get() != nullptr);
 
@@ -258,6 +258,17 @@ class Gcs_packet {
    */
   std::pair<buffer_ptr, unsigned long long> serialize();
 
+  /**
+   Release ownership of the serialization buffer without encoding anything,
+   so that the payload can be handed to the upper layer without copying it.
+
+   Pointers previously obtained with @c get_payload_pointer remain valid and
+   point into the returned buffer.
+
+   @returns The buffer with the serialized packet
+   */
+  buffer_ptr release_serialization_buffer();
+
   /**
    Create a string representation of the packet to be logged.
 
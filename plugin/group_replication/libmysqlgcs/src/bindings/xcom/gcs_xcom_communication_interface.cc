@@ -489,6 +489,7 @@ bool Gcs_xcom_communication::recover_packets(
 Gcs_message *Gcs_xcom_communication::convert_packet_to_message(
     Gcs_packet &&packet, std::unique_ptr<Gcs_xcom_nodes> &&xcom_nodes) {
   Gcs_message_data *message_data = nullptr;
+  unsigned char *payload = nullptr;
   Gcs_xcom_synode packet_synode;
   Gcs_xcom_node_information const *node = nullptr;
   Gcs_member_identifier origin;
@@ -517,11 +518,14 @@ Gcs_message *Gcs_xcom_communication::convert_packet_to_message(
    Transform the incoming packet into the message that will be delivered to
    the upper layer.
 
-   Decode the incoming packet into the message.
+   Decode the incoming packet into the message. The message adopts the
+   packet's buffer, so the payload is not copied.
    */
-  message_data = new Gcs_message_data(packet_in.get_payload_length());
-  if (message_data->decode(packet_in.get_payload_pointer(),
-                           packet_in.get_payload_length())) {
+  message_data = new Gcs_message_data();
+  payload = packet_in.get_payload_pointer();
+  if (message_data->decode_in_place(
+          packet_in.release_serialization_buffer().release(), payload,
+          packet_in.get_payload_length())) {
     /* purecov: begin inspected */
     delete message_data;
     MYSQL_GCS_LOG_WARN("Discarding message. Unable to decode it.");
@@ -2402,6 +2402,14 @@ static int proposer_task(task_arg arg) {
      * call stack overflow. */
     if (!is_config(ep->client_msg->p->a->body.c_t) &&
         !is_view(ep->client_msg->p->a->body.c_t)) {
+      /* If other proposals are still in flight, this one will not be
+       * delivered before them anyway. Yield once, so that messages queued
+       * in the meantime join this batch instead of each one taking a Paxos
+       * instance of its own. */
+      if (AUTOBATCH && link_empty(&prop_input_queue.data) &&
+          prop_started - prop_finished > 1) {
+        TASK_YIELD;
+      }
       ep->size = app_data_size(ep->client_msg->p->a);
       ep->nr_batched_app_data = 1;
       while (AUTOBATCH && ep->size <= MAX_BATCH_SIZE &&
@@ -46,7 +46,8 @@ Gcs_message_data::Gcs_message_data()
       m_payload_capacity(0),
       m_buffer(nullptr),
       m_buffer_len(0),
-      m_owner(true) {}
+      m_owner(true),
+      m_allocation(nullptr) {}
 
 Gcs_message_data::Gcs_message_data(const uint32_t header_capacity,
                                    const uint64_t payload_capacity)
@@ -59,7 +60,8 @@ Gcs_message_data::Gcs_message_data(const uint32_t header_capacity,
       m_payload_len(0),
       m_payload_capacity(payload_capacity),
       m_buffer_len(0),
-      m_owner(true) {
+      m_owner(true),
+      m_allocation(nullptr) {
   m_buffer_len = header_capacity + payload_capacity + get_encode_header_size();
   size_t buf_tmp_len = sizeof(uchar) * m_buffer_len;
   m_buffer = static_cast<uchar *>(malloc(buf_tmp_len));
@@ -80,7 +82,8 @@ Gcs_message_data::Gcs_message_data(const uint64_t data_len)
       m_payload_capacity(0),
       m_buffer(nullptr),
       m_buffer_len(data_len),
-      m_owner(true) {
+      m_owner(true),
+      m_allocation(nullptr) {
   size_t buf_tmp_len = sizeof(uchar) * m_buffer_len;
   m_buffer = static_cast<uchar *>(malloc(buf_tmp_len));
   Gcs_message_data::report_allocate_memory(buf_tmp_len);
@@ -88,7 +91,7 @@ Gcs_message_data::Gcs_message_data(const uint64_t data_len)
 
 Gcs_message_data::~Gcs_message_data() {
   if (m_owner) {
-    free(m_buffer);
+    free(m_allocation != nullptr ? m_allocation : m_buffer);
     Gcs_message_data::report_deallocate_memory(sizeof(uchar) * m_buffer_len);
   }
 }
@@ -265,8 +268,6 @@ bool Gcs_message_data::encode(uchar *buffer, uint64_t *buffer_len) const {
 }
 
 bool Gcs_message_data::decode(const uchar *data, uint64_t data_len) {
-  uchar *slider = m_buffer;
-
   if (data == nullptr || data_len == 0 || m_buffer == nullptr) {
     MYSQL_GCS_LOG_ERROR(
         "Buffer to decode information from is not properly configured.");
@@ -287,6 +288,37 @@ bool Gcs_message_data::decode(const uchar *data, uint64_t data_len) {
   */
   memcpy(m_buffer, data, data_len);
 
+  return decode_buffer(data_len);
+}
+
+bool Gcs_message_data::decode_in_place(uchar *allocation, uchar *data,
+                                       uint64_t data_len) {
+  assert(m_buffer == nullptr && m_allocation == nullptr);
+
+  if (allocation == nullptr || data == nullptr || data_len == 0) {
+    /* purecov: begin inspected */
+    MYSQL_GCS_LOG_ERROR(
+        "Buffer to decode information from is not properly configured.");
+    free(allocation);
+    return true;
+    /* purecov: end */
+  }
+
+  /*
+    Adopt the external buffer instead of copying it.
+  */
+  m_allocation = allocation;
+  m_buffer = data;
+  m_buffer_len = data_len;
+  m_owner = true;
+  Gcs_message_data::report_allocate_memory(sizeof(uchar) * m_buffer_len);
+
+  return decode_buffer(data_len);
+}
+
+bool Gcs_message_data::decode_buffer(uint64_t data_len) {
+  uchar *slider = m_buffer;
+
   /*
     Get header metadata from the internal buffer.
   */
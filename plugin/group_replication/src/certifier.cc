@@ -24,6 +24,7 @@
 #include <signal.h>
 #include <time.h>
 #include <map>
+#include <unordered_map>
 
 #include <mysql/components/services/log_builtins.h>
 #include "my_dbug.h"
@@ -1227,11 +1228,21 @@ void Certifier::garbage_collect() {
     "t" was already committed when they executed (thus "t"
     precedes them), then "t" is stable and can be removed from
     the certification info.
+
+    All write sets of a transaction share the same snapshot version, so
+    the outcome of the comparison is remembered per snapshot version rather
+    than computed again for each write set. A snapshot version is only
+    deleted once no write set refers to it, so its address cannot be reused
+    during this loop.
   */
+  std::unordered_map<const Gtid_set_ref *, bool> stable_snapshot_versions;
   Certification_info::iterator it = certification_info.begin();
   stable_gtid_set_lock->wrlock();
   while (it != certification_info.end()) {
-    if (it->second->is_subset_not_equals(stable_gtid_set)) {
+    auto stable = stable_snapshot_versions.emplace(it->second, false);
+    if (stable.second)
+      stable.first->second = it->second->is_subset_not_equals(stable_gtid_set);
+    if (stable.first->second) {
       if (it->second->unlink() == 0) delete it->second;
       certification_info.erase(it++);
     } else
@@ -242,6 +242,7 @@ static void init_net(NET *net, unsigned char *buff, unsigned int buff_len) {
 void Ack_receiver::run() {
   NET net;
   unsigned char net_buff[REPLY_MESSAGE_MAX_LENGTH];
+  unsigned char ack_buff[REPLY_MESSAGE_MAX_LENGTH];
   uint i;
   Socket_listener listener;
 
@@ -304,17 +305,31 @@ void Ack_receiver::run() {
             (server_extension->compress_ctx.algorithm == MYSQL_ZLIB) ||
             (server_extension->compress_ctx.algorithm == MYSQL_ZSTD);
 
+        /*
+          A replica acknowledges positions in binlog order, so when several
+          acks are already buffered on its socket only the last one needs to
+          be reported. This takes LOCK_binlog_ once per batch, not per ack.
+        */
+        ulong ack_len = 0;
         do {
           net_clear(&net, false);
 
           len = my_net_read(&net);
-          if (likely(len != packet_error))
-            repl_semisync->reportReplyPacket(slave_obj.server_id, net.read_pos,
-                                             len);
-          else if (net.last_errno == ER_NET_READ_ERROR) {
+          if (likely(len != packet_error)) {
+            if (likely(len <= sizeof(ack_buff))) {
+              memcpy(ack_buff, net.read_pos, len);
+              ack_len = len;
+            } else
+              repl_semisync->reportReplyPacket(slave_obj.server_id,
+                                               net.read_pos, len);
+          } else if (net.last_errno == ER_NET_READ_ERROR) {
             listener.clear_socket_info(i);
           }
         } while (net.vio->has_data(net.vio) && m_status == ST_UP);
+
+        if (ack_len > 0)
+          repl_semisync->reportReplyPacket(slave_obj.server_id, ack_buff,
+                                           ack_len);
       }
       i++;
     }
@@ -415,23 +415,36 @@ class Compression_zstandard : public ::protocol::Compression_buffer_interface {
 
     in_page = input_buffer->m_front;
     ZSTD_inBuffer in_buffer;
+    size_t result = 0;
+    bool frame_ended = false;
     while (in_page) {
       in_buffer =
           ZSTD_inBuffer{in_page->m_begin_data, in_page->get_used_bytes(), 0};
 
       m_all_uncompressed += in_buffer.size;
 
+#if ZSTD_VERSION_NUMBER >= 10400
+      /*
+        Ending the frame together with the last page lets zstd compress a
+        message that fits in one page in a single pass, without copying it
+        to its internal input buffer first.
+      */
+      const auto directive =
+          in_page->m_next_page ? ZSTD_e_continue : ZSTD_e_end;
+#endif
+
       while (in_buffer.pos < in_buffer.size) {
         ZSTD_outBuffer out_buffer{out_page->m_current_data,
                                   out_page->get_free_bytes(), 0};
 
 #if ZSTD_VERSION_NUMBER < 10400
-        if (is_error(ZSTD_compressStream(m_stream, &out_buffer, &in_buffer)))
+        result = ZSTD_compressStream(m_stream, &out_buffer, &in_buffer);
 #else
-        if (is_error(ZSTD_compressStream2(m_stream, &out_buffer, &in_buffer,
-                                          ZSTD_e_continue)))
+        result = ZSTD_compressStream2(m_stream, &out_buffer, &in_buffer,
+                                      directive);
+        frame_ended = directive == ZSTD_e_end && result == 0;
 #endif
-          return false;
+        if (is_error(result)) return false;
 
         out_page->m_current_data += out_buffer.pos;
         m_all_compressed += out_buffer.pos;
@@ -443,8 +456,7 @@ class Compression_zstandard : public ::protocol::Compression_buffer_interface {
       in_page = in_page->m_next_page;
     }
 
-    size_t result = 0;
-    do {
+    while (!frame_ended) {
       ZSTD_outBuffer out_buffer{out_page->m_current_data,
                                 out_page->get_free_bytes(), 0};
 #if ZSTD_VERSION_NUMBER < 10400
@@ -459,9 +471,10 @@ class Compression_zstandard : public ::protocol::Compression_buffer_interface {
       out_page->m_current_data += out_buffer.pos;
       m_all_compressed += out_buffer.pos;
 
-      if (result != 0 && out_buffer.pos == out_buffer.size)
+      frame_ended = result == 0;
+      if (!frame_ended && out_buffer.pos == out_buffer.size)
         out_page = output_buffer->get_next_page();
-    } while (result);
+    }
 
     return true;
   }
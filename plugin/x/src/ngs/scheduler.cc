@@ -222,10 +222,7 @@ void *Scheduler_dynamic::worker() {
       try {
         Task *task = nullptr;
 
-        while (is_running() && m_tasks.empty() == false &&
-               task_available == false) {
-          task_available = m_tasks.pop(task);
-        }
+        if (is_running()) task_available = m_tasks.pop(task);
 
         if (task_available && task) {
           Memory_instrumented<Task>::Unique_ptr task_ptr(task);
@@ -27,7 +27,7 @@
 
 #include <atomic>
 #include <functional>
-#include <list>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -94,7 +94,7 @@ class Scheduler_dynamic : public xpl::iface::Scheduler_dynamic {
     bool remove_if(Element_type &result,
                    std::function<bool(Element_type &)> matches) {
       MUTEX_LOCK(guard, m_access_mutex);
-      for (typename std::list<Element_type>::iterator it = m_list.begin();
+      for (typename std::deque<Element_type>::iterator it = m_list.begin();
            it != m_list.end(); ++it) {
         if (matches(*it)) {
           result = *it;
@@ -108,7 +108,7 @@ class Scheduler_dynamic : public xpl::iface::Scheduler_dynamic {
 
    private:
     xpl::Mutex m_access_mutex;
-    std::list<Element_type> m_list;
+    std::deque<Element_type> m_list;
   };
 
   Scheduler_dynamic(const Scheduler_dynamic &);
@@ -235,6 +235,11 @@ class CONNECTION_POOL_EXPORT ConnectionPool {
   /**
    * get a connection from the pool that matches a predicate.
    *
+   * the most recently pooled matching connection is returned. Reusing the
+   * warmest connections first lets the surplus ones reach their idle-timeout
+   * and close, which keeps the number of server connections close to what
+   * the clients actually need.
+   *
    * @returns a connection if one exists.
    */
   template <class UnaryPredicate>
@@ -242,9 +247,11 @@ class CONNECTION_POOL_EXPORT ConnectionPool {
     return pool_(
         [this,
          &pred](auto &pool) -> std::optional<ConnectionPool::connection_type> {
-          auto it = std::find_if(pool.begin(), pool.end(), pred);
+          auto rit = std::find_if(pool.rbegin(), pool.rend(), pred);
+
+          if (rit == pool.rend()) return {};
 
-          if (it == pool.end()) return {};
+          auto it = std::prev(rit.base());
 
           auto pooled_conn = std::move(*it);
 
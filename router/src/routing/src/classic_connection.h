@@ -492,7 +492,14 @@ class MysqlRoutingClassicConnection
   ExecutionContext exec_ctx_;
 
  public:
-  void trace(Tracer::Event e) { tracer_.trace(e); }
+  void trace(Tracer::Event e) { tracer_.trace(std::move(e)); }
+
+  /**
+   * check if events are traced.
+   *
+   * allows callers to skip building expensive trace-messages.
+   */
+  bool tracing_enabled() const { return tracer_.enabled(); }
 
  private:
   Tracer tracer_{false};
@@ -24,9 +24,11 @@
 
 #include "classic_query.h"
 
+#include <algorithm>  // search
 #include <charconv>
 #include <limits>
 #include <memory>
+#include <string_view>
 #include <system_error>
 #include <variant>
 
@@ -775,10 +777,34 @@ class Parser {
   std::string error_{};
 };
 
+/**
+ * check if a statement may be intercepted by
+ * intercept_diagnostics_area_queries().
+ *
+ * All intercepted statements either contain the SHOW keyword or a
+ * system-variable like @@warning_count. Statements which contain neither
+ * can skip the lexer.
+ */
+static bool may_be_diagnostics_area_query(const std::string &stmt) {
+  if (stmt.find('@') != std::string::npos) return true;
+
+  const std::string_view show_kw{"SHOW"};
+
+  return std::search(stmt.begin(), stmt.end(), show_kw.begin(),
+                     show_kw.end(), [](char c, char kw_c) {
+                       // ascii-upper-case
+                       return ((c >= 'a' && c <= 'z') ? c - 0x20 : c) == kw_c;
+                     }) != stmt.end();
+}
+
 static stdx::expected<
     std::variant<std::monostate, ShowWarningCount, ShowWarnings>,
     std::error_code>
 intercept_diagnostics_area_queries(const std::string &stmt) {
+  if (!may_be_diagnostics_area_query(stmt)) {
+    return {std::in_place, std::monostate{}};
+  }
+
   MEM_ROOT mem_root;
   THD session;
   session.mem_root = &mem_root;
@@ -809,8 +835,10 @@ stdx::expected<Processor::Result, std::error_code> QueryForwarder::command() {
             src_channel, src_protocol);
     if (!msg_res) return recv_client_failed(msg_res.error());
 
-    trace(Tracer::Event().stage("query::command: " +
-                                msg_res->statement().substr(0, 1024)));
+    if (connection()->tracing_enabled()) {
+      trace(Tracer::Event().stage("query::command: " +
+                                  msg_res->statement().substr(0, 1024)));
+    }
 
     if (connection()->connection_sharing_allowed()) {
       // the diagnostics-area is only maintained, if connection-sharing is
@@ -851,8 +879,10 @@ stdx::expected<Processor::Result, std::error_code> QueryForwarder::command() {
 
     stmt_classified_ = classify(msg_res->statement(), true);
 
-    trace(Tracer::Event().stage("query::classified: " +
-                                mysqlrouter::to_string(stmt_classified_)));
+    if (connection()->tracing_enabled()) {
+      trace(Tracer::Event().stage("query::classified: " +
+                                  mysqlrouter::to_string(stmt_classified_)));
+    }
 
     // SET session_track... is forbidden if router sets session-trackers on the
     // server-side.
@@ -1266,7 +1296,9 @@ stdx::expected<Processor::Result, std::error_code> QuerySender::command() {
   auto dst_protocol = connection()->server_protocol();
 
   trace(Tracer::Event().stage("query::command"));
-  trace(Tracer::Event().stage(">> " + stmt_));
+  if (connection()->tracing_enabled()) {
+    trace(Tracer::Event().stage(">> " + stmt_));
+  }
 
   dst_protocol->seq_id(0xff);
 
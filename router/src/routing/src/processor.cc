@@ -22,7 +22,8 @@
   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
-#include <memory>  // make_unique
+#include <memory>   // make_unique
+#include <utility>  // move
 
 #include "classic_connection.h"
 #include "classic_forwarder.h"
@@ -123,7 +124,9 @@ void Processor::log_fatal_error_code(const char *msg, std::error_code ec) {
             ec.value());
 }
 
-void Processor::trace(Tracer::Event e) { return connection()->trace(e); }
+void Processor::trace(Tracer::Event e) {
+  return connection()->trace(std::move(e));
+}
 
 stdx::expected<Processor::Result, std::error_code>
 Processor::forward_server_to_client(bool noflush) {
@@ -123,6 +123,8 @@ class Tracer {
 
   static std::string stage(Event::Stage st) { return st.name(); }
 
+  bool enabled() const { return enabled_; }
+
   void trace(Event e) {
     if (!enabled_) return;
 
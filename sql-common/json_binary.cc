@@ -24,12 +24,22 @@
 
 #include <string.h>
 
-#include <algorithm>  // std::min
+#include <algorithm>  // std::min, std::stable_sort
 #include <cassert>
+#include <cmath>      // std::isfinite
 #include <map>
 #include <memory>
+#include <new>
 #include <string>
 #include <utility>
+#include <vector>
+
+#include "my_rapidjson_size_t.h"  // IWYU pragma: keep
+
+#include <rapidjson/error/en.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
+
 #include "m_ctype.h"
 
 #include "my_byteorder.h"
@@ -41,7 +51,9 @@
 #include "sql-common/json_dom.h"  // Json_dom
 #include "sql-common/json_syntax_check.h"
 #include "sql/field.h"      // Field_json
-#include "sql/sql_class.h"  // THD
+#include "sql/malloc_allocator.h"
+#include "sql/psi_memory_key.h"  // key_memory_JSON
+#include "sql/sql_class.h"       // THD
 #include "sql/sql_const.h"
 #include "sql/system_variables.h"
 #include "sql/table.h"  // TABLE::add_binary_diff()
@@ -861,6 +873,563 @@ static enum_serialization_result serialize_json_value(
 
   return result;
 }
+
+namespace {
+
+/**
+  A JSON text parsed into a flat sequence of nodes in document order.
+
+  This is used by serialize_text() to convert JSON text to the binary
+  format without building a Json_dom tree first. Building the DOM
+  requires one heap allocation per value, plus a map entry per object
+  member, whereas the tape only needs two growing buffers: one for the
+  nodes and one for the string data.
+
+  The class implements the rapidjson handler interface, see the
+  description of Rapid_json_handler in json_dom.cc.
+*/
+class Json_text_tape {
+ public:
+  enum enum_node_type : uint8 {
+    NODE_NULL,
+    NODE_TRUE,
+    NODE_FALSE,
+    NODE_INT,
+    NODE_UINT,
+    NODE_DOUBLE,
+    NODE_STRING,
+    NODE_KEY,
+    NODE_ARRAY,
+    NODE_OBJECT
+  };
+
+  struct Node {
+    enum_node_type m_type;
+    /**
+      For strings and keys, the length of the string. For arrays and
+      objects, the number of elements or members as seen by the parser
+      (duplicate keys included).
+    */
+    size_t m_length;
+    union {
+      int64 m_int;
+      uint64 m_uint;
+      double m_double;
+      /// For strings and keys, the position of the data in the string buffer.
+      size_t m_offset;
+      /// For arrays and objects, the index one past the last node inside it.
+      size_t m_end;
+    };
+  };
+
+  /// A member of an object: the index of the key node and the value node.
+  using Member = std::pair<size_t, size_t>;
+
+  explicit Json_text_tape(JsonDocumentDepthHandler depth_handler)
+      : m_nodes(Malloc_allocator<Node>(key_memory_JSON)),
+        m_strings(Malloc_allocator<char>(key_memory_JSON)),
+        m_open(Malloc_allocator<size_t>(key_memory_JSON)),
+        m_depth_handler(std::move(depth_handler)) {}
+
+  const Node &node(size_t idx) const { return m_nodes[idx]; }
+
+  /// @return the string data of a string or key node
+  const char *string_data(size_t idx) const {
+    return m_strings.data() + m_nodes[idx].m_offset;
+  }
+
+  /// @return the index of the node following the value at idx
+  size_t next(size_t idx) const {
+    const Node &n = m_nodes[idx];
+    return (n.m_type == NODE_ARRAY || n.m_type == NODE_OBJECT) ? n.m_end
+                                                               : idx + 1;
+  }
+
+  /**
+    Get the members of an object in the order they are stored in the
+    binary format, that is, sorted by key. If a key appears more than
+    once, only the last member with that key is kept, just like
+    Json_object::add_alias() does.
+
+    @param[in]  idx      the index of the object node
+    @param[out] members  the members of the object
+  */
+  void sorted_members(size_t idx, std::vector<Member> *members) const {
+    const Node &obj = m_nodes[idx];
+    assert(obj.m_type == NODE_OBJECT);
+    members->clear();
+    members->reserve(obj.m_length);
+    for (size_t i = idx + 1; i < obj.m_end; i = next(i + 1))
+      members->emplace_back(i, i + 1);
+
+    const auto key_less = [this](const Member &a, const Member &b) {
+      const Node &ka = m_nodes[a.first];
+      const Node &kb = m_nodes[b.first];
+      if (ka.m_length != kb.m_length) return ka.m_length < kb.m_length;
+      return memcmp(string_data(a.first), string_data(b.first), ka.m_length) <
+             0;
+    };
+
+    // A stable sort keeps duplicate keys in document order, so the last
+    // of a run of equal keys is the one that wins.
+    std::stable_sort(members->begin(), members->end(), key_less);
+    size_t kept = 0;
+    for (size_t i = 0; i < members->size(); ++i) {
+      if (i + 1 < members->size() &&
+          !key_less((*members)[i], (*members)[i + 1]))
+        continue;
+      (*members)[kept++] = (*members)[i];
+    }
+    members->resize(kept);
+  }
+
+  bool Null() { return !add_node(NODE_NULL); }
+
+  bool Bool(bool b) { return !add_node(b ? NODE_TRUE : NODE_FALSE); }
+
+  bool Int(int i) { return Int64(i); }
+
+  bool Uint(unsigned u) { return Int64(static_cast<int64>(u)); }
+
+  bool Int64(int64_t i) {
+    if (add_node(NODE_INT)) return false; /* purecov: inspected */
+    m_nodes.back().m_int = i;
+    return true;
+  }
+
+  bool Uint64(uint64_t ui64) {
+    if (add_node(NODE_UINT)) return false; /* purecov: inspected */
+    m_nodes.back().m_uint = ui64;
+    return true;
+  }
+
+  bool Double(double d) {
+    // We only accept finite values, see Rapid_json_handler::Double().
+    if (!std::isfinite(d)) return false;
+    if (add_node(NODE_DOUBLE)) return false; /* purecov: inspected */
+    m_nodes.back().m_double = d;
+    return true;
+  }
+
+  /* purecov: begin deadcode */
+  bool RawNumber(const char *, rapidjson::SizeType, bool) {
+    assert(false);
+    return false;
+  }
+  /* purecov: end */
+
+  bool String(const char *str, rapidjson::SizeType length, bool) {
+    return add_string(NODE_STRING, str, length);
+  }
+
+  bool Key(const char *str, rapidjson::SizeType length, bool) {
+    return add_string(NODE_KEY, str, length);
+  }
+
+  bool StartObject() { return start_container(NODE_OBJECT); }
+
+  bool EndObject(rapidjson::SizeType count) {
+    end_container(count);
+    return true;
+  }
+
+  bool StartArray() { return start_container(NODE_ARRAY); }
+
+  bool EndArray(rapidjson::SizeType count) {
+    end_container(count);
+    return true;
+  }
+
+ private:
+  /// Append a node of the given type. Returns true on out-of-memory.
+  bool add_node(enum_node_type type) {
+    try {
+      m_nodes.push_back(Node{type, 0, {0}});
+    } catch (const std::bad_alloc &) {
+      return true; /* purecov: inspected */
+    }
+    return false;
+  }
+
+  bool add_string(enum_node_type type, const char *str, size_t length) {
+    if (add_node(type)) return false; /* purecov: inspected */
+    Node &n = m_nodes.back();
+    n.m_length = length;
+    n.m_offset = m_strings.size();
+    try {
+      m_strings.insert(m_strings.end(), str, str + length);
+    } catch (const std::bad_alloc &) {
+      return false; /* purecov: inspected */
+    }
+    return true;
+  }
+
+  bool start_container(enum_node_type type) {
+    if (add_node(type)) return false; /* purecov: inspected */
+    try {
+      m_open.push_back(m_nodes.size() - 1);
+    } catch (const std::bad_alloc &) {
+      return false; /* purecov: inspected */
+    }
+    return !check_json_depth(m_open.size(), m_depth_handler);
+  }
+
+  void end_container(size_t count) {
+    Node &n = m_nodes[m_open.back()];
+    n.m_length = count;
+    n.m_end = m_nodes.size();
+    m_open.pop_back();
+  }
+
+  std::vector<Node, Malloc_allocator<Node>> m_nodes;
+  std::vector<char, Malloc_allocator<char>> m_strings;
+  /// The indexes of the arrays and objects that are currently open.
+  std::vector<size_t, Malloc_allocator<size_t>> m_open;
+  JsonDocumentDepthHandler m_depth_handler;
+};
+
+}  // namespace
+
+static enum_serialization_result serialize_json_value(
+    const THD *thd, const Json_text_tape &tape, size_t idx, size_t type_pos,
+    String *dest, size_t depth, bool small_parent);
+
+/**
+  Attempt to inline a value from a Json_text_tape in its value entry.
+  Works like the Json_dom overload of this function.
+*/
+static bool attempt_inline_value(const Json_text_tape::Node &value,
+                                 String *dest, size_t pos, bool large) {
+  int32 inlined_val;
+  char inlined_type;
+  switch (value.m_type) {
+    case Json_text_tape::NODE_NULL:
+      inlined_val = JSONB_NULL_LITERAL;
+      inlined_type = JSONB_TYPE_LITERAL;
+      break;
+    case Json_text_tape::NODE_TRUE:
+      inlined_val = JSONB_TRUE_LITERAL;
+      inlined_type = JSONB_TYPE_LITERAL;
+      break;
+    case Json_text_tape::NODE_FALSE:
+      inlined_val = JSONB_FALSE_LITERAL;
+      inlined_type = JSONB_TYPE_LITERAL;
+      break;
+    case Json_text_tape::NODE_INT: {
+      const int64 i = value.m_int;
+      const bool is_16bit = INT_MIN16 <= i && i <= INT_MAX16;
+      if (!is_16bit && !(large && INT_MIN32 <= i && i <= INT_MAX32))
+        return false;  // cannot inline this value
+      inlined_val = static_cast<int32>(i);
+      inlined_type = is_16bit ? JSONB_TYPE_INT16 : JSONB_TYPE_INT32;
+      break;
+    }
+    case Json_text_tape::NODE_UINT: {
+      const uint64 i = value.m_uint;
+      const bool is_16bit = i <= UINT_MAX16;
+      if (!is_16bit && !(large && i <= UINT_MAX32))
+        return false;  // cannot inline this value
+      inlined_val = static_cast<int32>(i);
+      inlined_type = is_16bit ? JSONB_TYPE_UINT16 : JSONB_TYPE_UINT32;
+      break;
+    }
+    default:
+      return false;  // cannot inline value of this type
+  }
+
+  (*dest)[pos] = inlined_type;
+  insert_offset_or_size(dest, pos + 1, inlined_val, large);
+  return true;
+}
+
+/**
+  Serialize a JSON array from a Json_text_tape at the end of the
+  destination string. Works like the Json_dom overload of this function.
+*/
+static enum_serialization_result serialize_json_array(
+    const THD *thd, const Json_text_tape &tape, size_t idx, String *dest,
+    bool large, size_t depth) {
+  if (check_stack_overrun(thd, STACK_MIN_SIZE, nullptr))
+    return FAILURE; /* purecov: inspected */
+
+  const Json_text_tape::Node &array = tape.node(idx);
+  const size_t start_pos = dest->length();
+  const size_t size = array.m_length;
+
+  if (check_json_depth(++depth, JsonDocumentDefaultDepthHandler)) {
+    return FAILURE;
+  }
+
+  if (is_too_big_for_json(size, large)) return VALUE_TOO_BIG;
+
+  // First write the number of elements in the array.
+  if (append_offset_or_size(dest, size, large))
+    return FAILURE; /* purecov: inspected */
+
+  // Reserve space for the size of the array in bytes. To be filled in later.
+  const size_t size_pos = dest->length();
+  if (append_offset_or_size(dest, 0, large))
+    return FAILURE; /* purecov: inspected */
+
+  size_t entry_pos = dest->length();
+
+  // Reserve space for the value entries at the beginning of the array.
+  const auto entry_size = value_entry_size(large);
+  if (dest->fill(dest->length() + size * entry_size, 0))
+    return FAILURE; /* purecov: inspected */
+
+  for (size_t i = idx + 1; i < array.m_end; i = tape.next(i)) {
+    if (!attempt_inline_value(tape.node(i), dest, entry_pos, large)) {
+      size_t offset = dest->length() - start_pos;
+      if (is_too_big_for_json(offset, large)) return VALUE_TOO_BIG;
+      insert_offset_or_size(dest, entry_pos + 1, offset, large);
+      auto res =
+          serialize_json_value(thd, tape, i, entry_pos, dest, depth, !large);
+      if (res != OK) return res;
+    }
+    entry_pos += entry_size;
+  }
+
+  // Finally, write the size of the object in bytes.
+  size_t bytes = dest->length() - start_pos;
+  if (is_too_big_for_json(bytes, large))
+    return VALUE_TOO_BIG; /* purecov: inspected */
+  insert_offset_or_size(dest, size_pos, bytes, large);
+
+  return OK;
+}
+
+/**
+  Serialize a JSON object from a Json_text_tape at the end of the
+  destination string. Works like the Json_dom overload of this function.
+*/
+static enum_serialization_result serialize_json_object(
+    const THD *thd, const Json_text_tape &tape, size_t idx, String *dest,
+    bool large, size_t depth) {
+  if (check_stack_overrun(thd, STACK_MIN_SIZE, nullptr))
+    return FAILURE; /* purecov: inspected */
+
+  std::vector<Json_text_tape::Member> members;
+  try {
+    tape.sorted_members(idx, &members);
+  } catch (const std::bad_alloc &) {
+    return FAILURE; /* purecov: inspected */
+  }
+
+  const size_t start_pos = dest->length();
+  const size_t size = members.size();
+
+  if (check_json_depth(++depth, JsonDocumentDefaultDepthHandler)) {
+    return FAILURE;
+  }
+
+  if (is_too_big_for_json(size, large))
+    return VALUE_TOO_BIG; /* purecov: inspected */
+
+  // First write the number of members in the object.
+  if (append_offset_or_size(dest, size, large))
+    return FAILURE; /* purecov: inspected */
+
+  // Reserve space for the size of the object in bytes. To be filled in later.
+  const size_t size_pos = dest->length();
+  if (append_offset_or_size(dest, 0, large))
+    return FAILURE; /* purecov: inspected */
+
+  const auto key_entry_size = json_binary::key_entry_size(large);
+  const auto value_entry_size = json_binary::value_entry_size(large);
+
+  // The first key comes right after the value entries.
+  size_t key_offset =
+      dest->length() + size * (key_entry_size + value_entry_size) - start_pos;
+
+  // Append all the key entries.
+  for (const auto &member : members) {
+    const size_t len = tape.node(member.first).m_length;
+
+    // We only have two bytes for the key size. Check if the key is too big.
+    if (len > UINT_MAX16) {
+      my_error(ER_JSON_KEY_TOO_BIG, MYF(0));
+      return FAILURE;
+    }
+
+    if (is_too_big_for_json(key_offset, large))
+      return VALUE_TOO_BIG; /* purecov: inspected */
+
+    if (append_offset_or_size(dest, key_offset, large) ||
+        append_int16(dest, static_cast<int16>(len)))
+      return FAILURE; /* purecov: inspected */
+    key_offset += len;
+  }
+
+  const size_t start_of_value_entries = dest->length();
+
+  // Reserve space for the value entries. Will be filled in later.
+  dest->fill(dest->length() + size * value_entry_size, 0);
+
+  // Add the actual keys.
+  for (const auto &member : members) {
+    if (dest->append(tape.string_data(member.first),
+                     tape.node(member.first).m_length))
+      return FAILURE; /* purecov: inspected */
+  }
+
+  // Add the values, and update the value entries accordingly.
+  size_t entry_pos = start_of_value_entries;
+  for (const auto &member : members) {
+    if (!attempt_inline_value(tape.node(member.second), dest, entry_pos,
+                              large)) {
+      size_t offset = dest->length() - start_pos;
+      if (is_too_big_for_json(offset, large)) return VALUE_TOO_BIG;
+      insert_offset_or_size(dest, entry_pos + 1, offset, large);
+      auto res = serialize_json_value(thd, tape, member.second, entry_pos,
+                                      dest, depth, !large);
+      if (res != OK) return res;
+    }
+    entry_pos += value_entry_size;
+  }
+
+  // Finally, write the size of the object in bytes.
+  size_t bytes = dest->length() - start_pos;
+  if (is_too_big_for_json(bytes, large)) return VALUE_TOO_BIG;
+  insert_offset_or_size(dest, size_pos, bytes, large);
+
+  return OK;
+}
+
+/**
+  Serialize a JSON value from a Json_text_tape at the end of the
+  destination string. Works like the Json_dom overload of this function.
+*/
+static enum_serialization_result serialize_json_value(
+    const THD *thd, const Json_text_tape &tape, size_t idx, size_t type_pos,
+    String *dest, size_t depth, bool small_parent) {
+  const size_t start_pos = dest->length();
+  assert(type_pos < start_pos);
+
+  const Json_text_tape::Node &node = tape.node(idx);
+  enum_serialization_result result = OK;
+
+  switch (node.m_type) {
+    case Json_text_tape::NODE_ARRAY:
+      (*dest)[type_pos] = JSONB_TYPE_SMALL_ARRAY;
+      result = serialize_json_array(thd, tape, idx, dest, false, depth);
+      if (result == VALUE_TOO_BIG) {
+        // If the parent uses the small storage format, it needs to grow too.
+        if (small_parent) return VALUE_TOO_BIG;
+        dest->length(start_pos);
+        (*dest)[type_pos] = JSONB_TYPE_LARGE_ARRAY;
+        result = serialize_json_array(thd, tape, idx, dest, true, depth);
+      }
+      break;
+    case Json_text_tape::NODE_OBJECT:
+      (*dest)[type_pos] = JSONB_TYPE_SMALL_OBJECT;
+      result = serialize_json_object(thd, tape, idx, dest, false, depth);
+      if (result == VALUE_TOO_BIG) {
+        // If the parent uses the small storage format, it needs to grow too.
+        if (small_parent) return VALUE_TOO_BIG;
+        dest->length(start_pos);
+        (*dest)[type_pos] = JSONB_TYPE_LARGE_OBJECT;
+        result = serialize_json_object(thd, tape, idx, dest, true, depth);
+      }
+      break;
+    case Json_text_tape::NODE_STRING:
+      if (append_variable_length(dest, node.m_length) ||
+          dest->append(tape.string_data(idx), node.m_length))
+        return FAILURE; /* purecov: inspected */
+      (*dest)[type_pos] = JSONB_TYPE_STRING;
+      break;
+    case Json_text_tape::NODE_INT: {
+      const int64 val = node.m_int;
+      if (INT_MIN16 <= val && val <= INT_MAX16) {
+        if (append_int16(dest, static_cast<int16>(val)))
+          return FAILURE; /* purecov: inspected */
+        (*dest)[type_pos] = JSONB_TYPE_INT16;
+      } else if (INT_MIN32 <= val && val <= INT_MAX32) {
+        if (append_int32(dest, static_cast<int32>(val)))
+          return FAILURE; /* purecov: inspected */
+        (*dest)[type_pos] = JSONB_TYPE_INT32;
+      } else {
+        if (append_int64(dest, val)) return FAILURE; /* purecov: inspected */
+        (*dest)[type_pos] = JSONB_TYPE_INT64;
+      }
+      break;
+    }
+    case Json_text_tape::NODE_UINT: {
+      const uint64 val = node.m_uint;
+      if (val <= UINT_MAX16) {
+        if (append_int16(dest, static_cast<int16>(val)))
+          return FAILURE; /* purecov: inspected */
+        (*dest)[type_pos] = JSONB_TYPE_UINT16;
+      } else if (val <= UINT_MAX32) {
+        if (append_int32(dest, static_cast<int32>(val)))
+          return FAILURE; /* purecov: inspected */
+        (*dest)[type_pos] = JSONB_TYPE_UINT32;
+      } else {
+        if (append_int64(dest, val)) return FAILURE; /* purecov: inspected */
+        (*dest)[type_pos] = JSONB_TYPE_UINT64;
+      }
+      break;
+    }
+    case Json_text_tape::NODE_DOUBLE:
+      // Store the double in a platform-independent eight-byte format.
+      if (reserve(dest, 8)) return FAILURE; /* purecov: inspected */
+      float8store(dest->ptr() + dest->length(), node.m_double);
+      dest->length(dest->length() + 8);
+      (*dest)[type_pos] = JSONB_TYPE_DOUBLE;
+      break;
+    case Json_text_tape::NODE_NULL:
+    case Json_text_tape::NODE_TRUE:
+    case Json_text_tape::NODE_FALSE: {
+      const char c = node.m_type == Json_text_tape::NODE_NULL
+                         ? JSONB_NULL_LITERAL
+                         : node.m_type == Json_text_tape::NODE_TRUE
+                               ? JSONB_TRUE_LITERAL
+                               : JSONB_FALSE_LITERAL;
+      if (dest->append(c)) return FAILURE; /* purecov: inspected */
+      (*dest)[type_pos] = JSONB_TYPE_LITERAL;
+      break;
+    }
+    default:
+      /* purecov: begin deadcode */
+      assert(false);
+      my_error(ER_INTERNAL_ERROR, MYF(0), "JSON serialization failed");
+      return FAILURE;
+      /* purecov: end */
+  }
+
+  if (result == OK && dest->length() > thd->variables.max_allowed_packet) {
+    my_error(ER_WARN_ALLOWED_PACKET_OVERFLOWED, MYF(0),
+             "json_binary::serialize", thd->variables.max_allowed_packet);
+    return FAILURE;
+  }
+
+  return result;
+}
+
+bool serialize_text(const THD *thd, const char *text, size_t length,
+                    String *dest, const JsonParseErrorHandler &error_handler,
+                    const JsonDocumentDepthHandler &depth_handler) {
+  Json_text_tape tape(depth_handler);
+  rapidjson::MemoryStream ss(text, length);
+  rapidjson::Reader reader;
+  if (!reader.Parse<rapidjson::kParseDefaultFlags>(ss, tape)) {
+    error_handler(rapidjson::GetParseError_En(reader.GetParseErrorCode()),
+                  reader.GetErrorOffset());
+    return true;
+  }
+
+  /*
+    The text may live in the destination buffer (see
+    Field_json::store()), so don't touch it until the text has been
+    parsed completely.
+  */
+  dest->length(0);
+  dest->set_charset(&my_charset_bin);
+
+  // Reserve space (one byte) for the type identifier.
+  if (dest->append('\0')) return true; /* purecov: inspected */
+  return serialize_json_value(thd, tape, 0, 0, dest, 0, false) != OK;
+}
 #endif  // ifdef MYSQL_SERVER
 
 bool Value::is_valid() const {
@@ -184,6 +184,26 @@ namespace json_binary {
 */
 #ifdef MYSQL_SERVER
 bool serialize(const THD *thd, const Json_dom *dom, String *dest);
+
+/**
+  Parse a JSON text and serialize it to binary format in the destination
+  string, replacing any content already in the destination string. This
+  gives the same result as Json_dom::parse() followed by serialize(), but
+  does not build a DOM.
+
+  @param[in]     thd            THD handle
+  @param[in]     text           the JSON text, encoded in utf8mb4
+  @param[in]     length         the length of the text in bytes
+  @param[in,out] dest           the destination string. It may hold the
+                                text on entry.
+  @param[in]     error_handler  called if the text could not be parsed
+  @param[in]     depth_handler  called if the maximum depth is exceeded
+  @retval false on success
+  @retval true if an error occurred
+*/
+bool serialize_text(const THD *thd, const char *text, size_t length,
+                    String *dest, const JsonParseErrorHandler &error_handler,
+                    const JsonDocumentDepthHandler &depth_handler);
 #endif
 
 /**
@@ -2167,6 +2167,38 @@ bool Json_wrapper::seek(const Json_seekable_path &path, size_t legs,
       m_value, begin, Json_seek_params(end, hits, auto_wrap, only_need_one));
 }
 
+bool Json_wrapper::seek_single(const Json_seekable_path &path, bool auto_wrap,
+                               Json_wrapper *hit) const {
+  assert(!is_dom());
+  json_binary::Value value = m_value;
+  for (const Json_path_leg *leg : path) {
+    switch (leg->get_type()) {
+      case jpl_member: {
+        if (!value.is_object()) return false;
+        const size_t pos = value.lookup_index(leg->get_member_name());
+        if (pos == value.element_count()) return false;
+        value = value.element(pos);
+        break;
+      }
+      case jpl_array_cell:
+        if (value.is_array()) {
+          const Json_array_index idx =
+              leg->first_array_index(value.element_count());
+          if (!idx.within_bounds()) return false;
+          value = value.element(idx.position());
+        } else if (!auto_wrap || !leg->is_autowrap()) {
+          return false;
+        }
+        break;
+      default:
+        assert(false); /* purecov: deadcode */
+        return false;
+    }
+  }
+  *hit = Json_wrapper(value);
+  return true;
+}
+
 size_t Json_wrapper::length() const {
   if (empty()) {
     return 0;
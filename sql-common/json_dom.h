@@ -1557,6 +1557,24 @@ class Json_wrapper {
   bool seek(const Json_seekable_path &path, size_t legs,
             Json_wrapper_vector *hits, bool auto_wrap, bool only_need_one);
 
+  /**
+    Find the value addressed by a path that can match at most one value,
+    that is, a path without wildcards, ranges or ellipses. The legs are
+    walked directly on the binary representation, so this is cheaper than
+    seek() for such paths.
+
+    @param[in]  path       the address of the sub-document
+    @param[in]  auto_wrap  true if a non-array matches [0] and [last]
+    @param[out] hit        the sub-document, if found
+
+    @retval true  if the path matched a value
+    @retval false if nothing matched
+
+    @pre The wrapper holds a binary value, not a DOM.
+  */
+  bool seek_single(const Json_seekable_path &path, bool auto_wrap,
+                   Json_wrapper *hit) const;
+
   /**
     Compute the length of a document. This is the value which would be
     returned by the JSON_LENGTH() system function. So, this returns
@@ -447,6 +447,22 @@ bool my_net_write(NET *net, const uchar *packet, size_t len) {
 
   /* turn off non blocking operations */
   if (!vio_is_blocking(net->vio)) vio_set_blocking_flag(net->vio, true);
+
+  /*
+    Fast path for result set rows and other small packets: if header and
+    payload fit in the free space of the write buffer, store them there
+    directly instead of going through net_write_buff() twice.
+  */
+  if (!net->compress && len < MAX_PACKET_LENGTH &&
+      NET_HEADER_SIZE + len <=
+          static_cast<size_t>(net->buff_end - net->write_pos)) {
+    int3store(net->write_pos, static_cast<uint>(len));
+    net->write_pos[3] = (uchar)net->pkt_nr++;
+    if (len > 0) memcpy(net->write_pos + NET_HEADER_SIZE, packet, len);
+    net->write_pos += NET_HEADER_SIZE + len;
+    return false;
+  }
+
   /*
     Big packets are handled by splitting them in packets of MAX_PACKET_LENGTH
     length. The last packet is always a packet that is < MAX_PACKET_LENGTH.
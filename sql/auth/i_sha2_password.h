@@ -150,10 +150,17 @@ class Caching_sha2_password {
   unsigned int m_fast_digest_rounds;
   /** Digest type */
   Digest_info m_digest_type;
-  /** Lock to protect @c m_cache */
-  mysql_rwlock_t m_cache_lock;
-  /** user=>password cache */
-  SHA2_password_cache m_cache;
+  /** Number of partitions of the password cache */
+  static constexpr size_t CACHE_PARTITIONS = 16;
+  /** Locks to protect @c m_cache, one per partition */
+  mysql_rwlock_t m_cache_lock[CACHE_PARTITIONS];
+  /** user=>password cache, partitioned by authorization id */
+  SHA2_password_cache m_cache[CACHE_PARTITIONS];
+
+  /** @returns the cache partition of an authorization id */
+  static size_t cache_partition(const std::string &authorization_id) {
+    return std::hash<std::string>{}(authorization_id) % CACHE_PARTITIONS;
+  }
 };
 }  // namespace sha2_password
 
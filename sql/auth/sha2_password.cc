@@ -192,7 +192,8 @@ Caching_sha2_password::Caching_sha2_password(
       m_digest_type(digest_type) {
   int count = array_elements(all_rwlocks);
   mysql_rwlock_register(category, all_rwlocks, count);
-  mysql_rwlock_init(key_m_cache_lock, &m_cache_lock);
+  for (auto &cache_lock : m_cache_lock)
+    mysql_rwlock_init(key_m_cache_lock, &cache_lock);
 
   if (fast_digest_rounds > MAX_FAST_DIGEST_ROUNDS ||
       fast_digest_rounds < MIN_FAST_DIGEST_ROUNDS)
@@ -204,10 +205,10 @@ Caching_sha2_password::Caching_sha2_password(
 }
 
 /**
-  Caching_sha2_password destructor - destroy rw lock
+  Caching_sha2_password destructor - destroy rw locks
 */
 Caching_sha2_password::~Caching_sha2_password() {
-  mysql_rwlock_destroy(&m_cache_lock);
+  for (auto &cache_lock : m_cache_lock) mysql_rwlock_destroy(&cache_lock);
 }
 
 /**
@@ -303,10 +304,13 @@ std::pair<bool, bool> Caching_sha2_password::authenticate(
         return std::make_pair(false, second);
       }
 
-      rwlock_scoped_lock wrlock(&m_cache_lock, true, __FILE__, __LINE__);
-      if (m_cache.add(authorization_id, fast_digest)) {
+      const size_t partition = cache_partition(authorization_id);
+      SHA2_password_cache &cache = m_cache[partition];
+      rwlock_scoped_lock wrlock(&m_cache_lock[partition], true, __FILE__,
+                                __LINE__);
+      if (cache.add(authorization_id, fast_digest)) {
         sha2_cache_entry stored_digest;
-        m_cache.search(authorization_id, stored_digest);
+        cache.search(authorization_id, stored_digest);
 
         /* Same digest is already added, so just return. */
         if (memcmp(fast_digest.digest_buffer[i], stored_digest.digest_buffer[i],
@@ -318,8 +322,8 @@ std::pair<bool, bool> Caching_sha2_password::authenticate(
         memcpy(fast_digest.digest_buffer[retain_index],
                stored_digest.digest_buffer[retain_index],
                sizeof(fast_digest.digest_buffer[retain_index]));
-        m_cache.remove(authorization_id);
-        m_cache.add(authorization_id, fast_digest);
+        cache.remove(authorization_id);
+        cache.add(authorization_id, fast_digest);
         DBUG_PRINT("info", ("An old digest for %s was recorded in cache. "
                             "It has been replaced with the latest digest.",
                             authorization_id.c_str()));
@@ -361,10 +365,18 @@ std::pair<bool, bool> Caching_sha2_password::fast_authenticate(
     return std::make_pair(true, false);
   }
 
-  rwlock_scoped_lock rdlock(&m_cache_lock, false, __FILE__, __LINE__);
   sha2_cache_entry digest;
+  bool not_found;
+
+  /* The entry is copied, so the scramble is validated without the lock. */
+  {
+    const size_t partition = cache_partition(authorization_id);
+    rwlock_scoped_lock rdlock(&m_cache_lock[partition], false, __FILE__,
+                              __LINE__);
+    not_found = m_cache[partition].search(authorization_id, digest);
+  }
 
-  if (m_cache.search(authorization_id, digest)) {
+  if (not_found) {
     DBUG_PRINT("info", ("Could not find entry for %s in cache.",
                         authorization_id.c_str()));
     return std::make_pair(true, false);
@@ -396,9 +408,11 @@ std::pair<bool, bool> Caching_sha2_password::fast_authenticate(
 
 void Caching_sha2_password::remove_cached_entry(
     const std::string authorization_id) {
-  rwlock_scoped_lock wrlock(&m_cache_lock, true, __FILE__, __LINE__);
+  const size_t partition = cache_partition(authorization_id);
+  rwlock_scoped_lock wrlock(&m_cache_lock[partition], true, __FILE__,
+                            __LINE__);
   /* It is possible that entry is not present at all, but we don't care */
-  (void)m_cache.remove(authorization_id);
+  (void)m_cache[partition].remove(authorization_id);
 }
 
 /**
@@ -686,15 +700,21 @@ bool Caching_sha2_password::generate_sha2_multi_hash(const std::string &source,
 
 size_t Caching_sha2_password::get_cache_count() {
   DBUG_TRACE;
-  rwlock_scoped_lock rdlock(&m_cache_lock, false, __FILE__, __LINE__);
-  return m_cache.size();
+  size_t count = 0;
+  for (size_t i = 0; i < CACHE_PARTITIONS; ++i) {
+    rwlock_scoped_lock rdlock(&m_cache_lock[i], false, __FILE__, __LINE__);
+    count += m_cache[i].size();
+  }
+  return count;
 }
 
 /** Clear the password cache */
 void Caching_sha2_password::clear_cache() {
   DBUG_TRACE;
-  rwlock_scoped_lock wrlock(&m_cache_lock, true, __FILE__, __LINE__);
-  m_cache.clear_cache();
+  for (size_t i = 0; i < CACHE_PARTITIONS; ++i) {
+    rwlock_scoped_lock wrlock(&m_cache_lock[i], true, __FILE__, __LINE__);
+    m_cache[i].clear_cache();
+  }
 }
 
 /**
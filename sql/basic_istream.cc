@@ -21,6 +21,7 @@
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
 
 #include "sql/basic_istream.h"
+#include <fcntl.h>
 #include <my_io.h>
 #include <my_sys.h>
 #include <mysql/psi/mysql_file.h>
@@ -40,6 +41,16 @@ bool IO_CACHE_istream::open(
   file = mysql_file_open(log_file_key, file_name, O_RDONLY, MYF(MY_WME));
   if (file < 0) return true;
 
+#ifdef POSIX_FADV_SEQUENTIAL
+  /*
+    Binary and relay logs are read front to back. Readers of the same file,
+    e.g. several dump threads, share its pages through the file system cache,
+    so a larger read-ahead window lets whichever reader runs first fetch the
+    file for the others in bigger chunks.
+  */
+  posix_fadvise(file, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif /* POSIX_FADV_SEQUENTIAL */
+
 #ifdef HAVE_PSI_INTERFACE
   if (init_io_cache_ext(&m_io_cache, file, cache_size, READ_CACHE, 0, false,
                         flags, log_cache_key))
@@ -2039,6 +2039,8 @@ bool binlog_cache_data::compress(THD *thd) {
 
     ctype = compressor->compression_type_code();
 
+    // the whole cache is compressed as a single stream, so its size is known
+    compressor->set_pledged_input_size(uncompressed_size);
     compressor->open();
 
     // inject the compressor in the output stream
@@ -4451,6 +4453,10 @@ bool MYSQL_BIN_LOG::find_first_log_not_in_gtid_set(char *binlog_file_name,
                                                    std::string &errmsg) {
   DBUG_TRACE;
   LOG_INFO linfo;
+  ulonglong cache_generation;
+  mysql_mutex_lock(&LOCK_index);
+  cache_generation = m_previous_gtids_cache_generation;
+  mysql_mutex_unlock(&LOCK_index);
   auto log_index = this->get_log_index();
   std::list<std::string> filename_list = log_index.second;
   int error = log_index.first;
@@ -4492,12 +4498,30 @@ bool MYSQL_BIN_LOG::find_first_log_not_in_gtid_set(char *binlog_file_name,
   while (rit != filename_list.rend()) {
     binlog_previous_gtid_set.clear();
     const char *filename = rit->c_str();
-    DBUG_PRINT("info",
-               ("Read Previous_gtids_log_event from filename='%s'", filename));
-    switch (read_gtids_from_binlog(filename, nullptr, &binlog_previous_gtid_set,
-                                   first_gtid,
-                                   binlog_previous_gtid_set.get_sid_map(),
-                                   opt_source_verify_checksum, is_relay_log)) {
+    enum_read_gtids_from_binlog_status status;
+    bool has_first_gtid = false;
+    if (first_gtid != nullptr &&
+        get_cached_previous_gtids(filename, &binlog_previous_gtid_set,
+                                  first_gtid, &has_first_gtid)) {
+      status = has_first_gtid ? GOT_GTIDS : GOT_PREVIOUS_GTIDS;
+    } else {
+      DBUG_PRINT("info", ("Read Previous_gtids_log_event from filename='%s'",
+                          filename));
+      status = read_gtids_from_binlog(
+          filename, nullptr, &binlog_previous_gtid_set, first_gtid,
+          binlog_previous_gtid_set.get_sid_map(), opt_source_verify_checksum,
+          is_relay_log);
+      /*
+        Only the newest file in the index may still be written to, and a
+        first GTID can only be told apart from "no GTID yet" for the others.
+      */
+      if (first_gtid != nullptr && rit != filename_list.rbegin() &&
+          (status == GOT_GTIDS || status == GOT_PREVIOUS_GTIDS))
+        cache_previous_gtids(filename, binlog_previous_gtid_set,
+                             status == GOT_GTIDS ? first_gtid : nullptr,
+                             cache_generation);
+    }
+    switch (status) {
       case ERROR:
         errmsg.assign(
             "Error reading header of binary log while looking for "
@@ -4543,6 +4567,56 @@ end:
   return error != 0 ? true : false;
 }
 
+bool MYSQL_BIN_LOG::get_cached_previous_gtids(const char *log_name,
+                                              Gtid_set *previous_gtids,
+                                              Gtid *first_gtid,
+                                              bool *has_first_gtid) {
+  MUTEX_LOCK(lock, &LOCK_index);
+  auto it = m_previous_gtids_cache.find(log_name);
+  if (it == m_previous_gtids_cache.end()) return false;
+  const Previous_gtids_cache_entry &entry = it->second;
+
+  if (previous_gtids->add_gtid_encoding(
+          pointer_cast<const uchar *>(entry.previous_gtids.data()),
+          entry.previous_gtids.size()) != RETURN_STATUS_OK) {
+    /* purecov: begin inspected */
+    previous_gtids->clear();
+    return false;
+    /* purecov: end */
+  }
+  if (entry.has_first_gtid) {
+    rpl_sidno sidno = previous_gtids->get_sid_map()->add_sid(entry.first_sid);
+    if (sidno <= 0) {
+      /* purecov: begin inspected */
+      previous_gtids->clear();
+      return false;
+      /* purecov: end */
+    }
+    first_gtid->set(sidno, entry.first_gno);
+  }
+  *has_first_gtid = entry.has_first_gtid;
+  return true;
+}
+
+void MYSQL_BIN_LOG::cache_previous_gtids(const char *log_name,
+                                         const Gtid_set &previous_gtids,
+                                         const Gtid *first_gtid,
+                                         ulonglong generation) {
+  Previous_gtids_cache_entry entry;
+  entry.previous_gtids.resize(previous_gtids.get_encoded_length());
+  previous_gtids.encode(pointer_cast<uchar *>(&entry.previous_gtids[0]));
+  if (first_gtid != nullptr) {
+    entry.has_first_gtid = true;
+    entry.first_sid =
+        previous_gtids.get_sid_map()->sidno_to_sid(first_gtid->sidno);
+    entry.first_gno = first_gtid->gno;
+  }
+
+  MUTEX_LOCK(lock, &LOCK_index);
+  if (generation == m_previous_gtids_cache_generation)
+    m_previous_gtids_cache.emplace(log_name, std::move(entry));
+}
+
 bool MYSQL_BIN_LOG::init_gtid_sets(Gtid_set *all_gtids, Gtid_set *lost_gtids,
                                    bool verify_checksum, bool need_lock,
                                    Transaction_boundary_parser *trx_parser,
@@ -5642,6 +5716,8 @@ bool MYSQL_BIN_LOG::reset_logs(THD *thd, bool delete_only) {
   */
   mysql_mutex_lock(&LOCK_log);
   mysql_mutex_lock(&LOCK_index);
+  m_previous_gtids_cache.clear();
+  m_previous_gtids_cache_generation++;
 
   if (is_relay_log)
     sid_lock = previous_gtid_set_relaylog->get_sid_map()->get_sid_lock();
@@ -5900,6 +5976,8 @@ int MYSQL_BIN_LOG::remove_logs_from_index(LOG_INFO *log_info,
     goto err;
   }
 
+  m_previous_gtids_cache.clear();
+
   // now update offsets in index file for running threads
   if (need_update_threads)
     adjust_linfo_offsets(log_info->index_file_start_offset);
@@ -6725,11 +6803,19 @@ end:
   return error;
 }
 
+/**
+  Upper bound on the number of relay log bytes of an unfinished transaction
+  that after_write_to_relay_log() leaves unflushed in the IO_CACHE.
+*/
+static constexpr my_off_t RELAY_LOG_MAX_DEFERRED_FLUSH = 64 * 1024;
+
 /**
   Called after an event has been written to the relay log by the IO
   thread.  This flushes and possibly syncs the file (according to the
   sync options), rotates the file if it has grown over the limit, and
-  finally calls signal_update().
+  finally calls signal_update(). Within a transaction received with GTID
+  auto-positioning the flush may be deferred, see
+  RELAY_LOG_MAX_DEFERRED_FLUSH.
 
   @note The caller must hold LOCK_log before invoking this function.
 
@@ -6761,6 +6847,24 @@ bool MYSQL_BIN_LOG::after_write_to_relay_log(Master_info *mi) {
   }
 #endif
 
+  /*
+    With GTID auto-positioning a partially received transaction is discarded
+    and fetched again after a crash, so there is no need to make each of its
+    events visible to the applier as it arrives. Let the IO_CACHE accumulate
+    them and flush once per transaction instead, bounded so that the applier
+    can still start on large transactions early. sync_relay_log=1 asks for
+    every event to be synced, so keep flushing per event then.
+  */
+  if (!can_rotate && mi->is_auto_position() && get_sync_period() != 1 &&
+      m_binlog_file->position() - atomic_binlog_end_pos <
+          RELAY_LOG_MAX_DEFERRED_FLUSH) {
+    lock_binlog_end_pos();
+    mi->rli->ign_master_log_name_end[0] = 0;
+    harvest_bytes_written(mi->rli, true /*need_log_space_lock=true*/);
+    unlock_binlog_end_pos();
+    return false;
+  }
+
   // Flush and sync
   bool error = flush_and_sync(false);
   if (error) {
@@ -8948,18 +9052,36 @@ int MYSQL_BIN_LOG::ordered_commit(THD *thd, bool all, bool skip_commit) {
     it is considered as a special case and delay will be executed
     for every group just like how it is done when sync_binlog= 1.
   */
+  const long sync_latency_target = opt_binlog_group_commit_sync_latency_target;
   if (!flush_error && (sync_counter + 1 >= get_sync_period()))
     Commit_stage_manager::get_instance().wait_count_or_timeout(
         opt_binlog_group_commit_sync_no_delay_count,
-        opt_binlog_group_commit_sync_delay, Commit_stage_manager::SYNC_STAGE);
+        sync_latency_target > 0
+            ? Commit_stage_manager::get_instance().get_adaptive_sync_delay(
+                  sync_latency_target)
+            : opt_binlog_group_commit_sync_delay,
+        Commit_stage_manager::SYNC_STAGE);
 
   final_queue = Commit_stage_manager::get_instance().fetch_queue_acquire_lock(
       Commit_stage_manager::SYNC_STAGE);
 
+  const ulonglong sync_start = sync_latency_target > 0 ? my_micro_time() : 0;
+  bool synced = false;
+
   if (flush_error == 0 && total_bytes > 0) {
     DEBUG_SYNC(thd, "before_sync_binlog_file");
     std::pair<bool, bool> result = sync_binlog_file(false);
     sync_error = result.first;
+    synced = result.second;
+  }
+
+  if (sync_latency_target > 0 && synced) {
+    ulong group_size = 0;
+    for (THD *tmp_thd = final_queue; tmp_thd != nullptr;
+         tmp_thd = tmp_thd->next_to_commit)
+      ++group_size;
+    Commit_stage_manager::get_instance().update_sync_stats(
+        group_size, sync_start, my_micro_time());
   }
 
   if (update_binlog_end_pos_after_sync && flush_error == 0 && sync_error == 0) {
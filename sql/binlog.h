@@ -27,9 +27,12 @@
 #include <sys/types.h>
 #include <time.h>
 #include <atomic>
+#include <map>
+#include <string>
 #include <utility>
 
 #include "libbinlogevents/include/binlog_event.h"  // enum_binlog_checksum_alg
+#include "libbinlogevents/include/uuid.h"
 #include "m_string.h"                              // llstr
 #include "my_dbug.h"
 #include "my_inttypes.h"
@@ -220,6 +223,60 @@ class MYSQL_BIN_LOG : public TC_LOG {
   */
   IO_CACHE purge_index_file;
   char purge_index_file_name[FN_REFLEN];
+
+  /**
+    The header of a closed binary log, as read by
+    find_first_log_not_in_gtid_set().
+  */
+  struct Previous_gtids_cache_entry {
+    /** The encoded set of the file's Previous_gtids_log_event. */
+    std::string previous_gtids;
+    /** Whether the file contains any Gtid_log_event. */
+    bool has_first_gtid{false};
+    /** The SID of the first GTID in the file, if any. */
+    binary_log::Uuid first_sid;
+    /** The GNO of the first GTID in the file, if any. */
+    int64 first_gno{0};
+  };
+  /**
+    Headers of closed binary logs keyed by file name. Closed files never
+    change, so replicas reconnecting with a GTID set do not need to reopen
+    every file newer than their position. Emptied when binary logs are
+    purged or reset. Protected by LOCK_index.
+  */
+  std::map<std::string, Previous_gtids_cache_entry> m_previous_gtids_cache;
+  /**
+    Incremented whenever binary logs are reset, since file names may then
+    be reused for different contents. Protected by LOCK_index.
+  */
+  ulonglong m_previous_gtids_cache_generation{0};
+
+  /**
+    Looks up the header of a closed binary log in m_previous_gtids_cache.
+
+    @param[in]  log_name the binary log file name
+    @param[out] previous_gtids the set the file's previous GTIDs are added to
+    @param[out] first_gtid set to the first GTID in the file, if it has one
+    @param[out] has_first_gtid set to whether the file has a GTID at all
+
+    @retval true the file was found and the output parameters are filled in
+    @retval false the file is not cached and must be read
+  */
+  bool get_cached_previous_gtids(const char *log_name, Gtid_set *previous_gtids,
+                                 Gtid *first_gtid, bool *has_first_gtid);
+  /**
+    Stores the header of a closed binary log in m_previous_gtids_cache.
+
+    @param log_name the binary log file name
+    @param previous_gtids the file's previous GTIDs
+    @param first_gtid the first GTID in the file, or nullptr if it has none
+    @param generation m_previous_gtids_cache_generation as it was before the
+                      file name was read from the index; nothing is stored
+                      if the logs were reset since
+  */
+  void cache_previous_gtids(const char *log_name,
+                            const Gtid_set &previous_gtids,
+                            const Gtid *first_gtid, ulonglong generation);
   /*
      The max size before rotation (usable only if log_type == LOG_BIN: binary
      logs and relay logs).
@@ -136,6 +136,17 @@ class Bounded_queue {
    */
   size_t num_elements() const { return m_queue.size(); }
 
+  /**
+    Whether the queue is full, so that the next push() will replace top().
+   */
+  bool is_full() const { return m_queue.size() == m_queue.capacity(); }
+
+  /**
+    The largest key in the queue. Once the queue is full, an element whose
+    key is larger than this would be discarded by push() anyway.
+   */
+  const Key_type &top() const { return m_queue.top(); }
+
  private:
   Queue_type m_queue;
   Key_type *m_sort_keys;
@@ -118,4 +118,46 @@ class One_thread_connection_handler : public Connection_handler {
   uint get_max_threads() const override { return 1; }
 };
 
+/**
+  This class represents the connection handling functionality
+  of connections being handled by a pool of worker threads.
+
+  Connections are distributed over thread groups. The workers of a group
+  wait in epoll for requests on the connections of the group and execute
+  them, so that a connection only occupies a thread while it has a request
+  to run. Requests of sessions with an active transaction are run first.
+*/
+class Thread_pool_connection_handler : public Connection_handler {
+  Thread_pool_connection_handler(const Thread_pool_connection_handler &);
+  Thread_pool_connection_handler &operator=(
+      const Thread_pool_connection_handler &);
+
+ public:
+  // System variables related to the thread pool.
+  /** Number of thread groups, 0 for the number of CPUs */
+  static uint group_count;
+  /** Milliseconds after which a thread group without progress is stalled */
+  static uint stall_limit;
+  /** Maximum number of worker threads of all thread groups */
+  static uint max_threads_limit;
+
+  Thread_pool_connection_handler() = default;
+  ~Thread_pool_connection_handler() override;
+
+  /**
+    Create the thread groups and start the timer thread.
+
+    @retval true  Failed.
+  */
+  bool init();
+
+ protected:
+  bool add_connection(Channel_info *channel_info) override;
+
+  uint get_max_threads() const override;
+
+ private:
+  bool m_initialized{false};
+};
+
 #endif  // CONNECTION_HANDLER_IMPL_INCLUDED
@@ -24,6 +24,8 @@
 
 #include "sql/conn_handler/connection_handler_manager.h"
 
+#include "my_config.h"
+
 #include <assert.h>
 #include <ctime>
 #include <new>
@@ -156,6 +158,22 @@ bool Connection_handler_manager::init() {
     case SCHEDULER_NO_THREADS:
       connection_handler = new (std::nothrow) One_thread_connection_handler();
       break;
+    case SCHEDULER_POOL_OF_THREADS:
+#ifdef HAVE_EPOLL
+    {
+      Thread_pool_connection_handler *pool =
+          new (std::nothrow) Thread_pool_connection_handler();
+      if (pool != nullptr && pool->init()) {
+        delete pool;
+        pool = nullptr;
+      }
+      connection_handler = pool;
+    }
+#else
+      // No epoll, fall back to one thread per connection.
+      connection_handler = new (std::nothrow) Per_thread_connection_handler();
+#endif
+      break;
     default:
       assert(false);
   }
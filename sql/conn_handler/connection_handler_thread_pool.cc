@@ -0,0 +1,807 @@
+/*
+   Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+*/
+
+#include "my_config.h"
+
+#include <stddef.h>
+
+#include "sql/conn_handler/connection_handler_impl.h"
+
+// System variables
+uint Thread_pool_connection_handler::group_count = 0;
+uint Thread_pool_connection_handler::stall_limit = 500;
+uint Thread_pool_connection_handler::max_threads_limit = 2000;
+
+#ifdef HAVE_EPOLL
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <new>
+#include <thread>
+
+#include "my_dbug.h"
+#include "my_psi_config.h"
+#include "my_sys.h"
+#include "my_systime.h"
+#include "my_thread.h"
+#include "mysql/components/services/log_builtins.h"
+#include "mysql/psi/mysql_cond.h"
+#include "mysql/psi/mysql_mutex.h"
+#include "mysql/psi/mysql_socket.h"
+#include "mysql/psi/mysql_thread.h"
+#include "mysql/service_thd_wait.h"
+#include "mysqld_error.h"                   // ER_*
+#include "sql/conn_handler/channel_info.h"  // Channel_info
+#include "sql/conn_handler/connection_handler_manager.h"  // Connection_handler_manager
+#include "sql/log.h"                                      // Error_log_throttle
+#include "sql/mysqld.h"                // connection_errors_internal
+#include "sql/mysqld_thd_manager.h"    // Global_THD_manager
+#include "sql/protocol_classic.h"      // Protocol_classic
+#include "sql/sql_class.h"             // THD
+#include "sql/sql_connect.h"           // close_connection
+#include "sql/sql_parse.h"             // do_command
+#include "sql/sql_thd_internal_api.h"  // thd_set_thread_stack
+#include "violite.h"                   // Vio
+
+/**
+  Number of workers of a thread group that may execute requests at the same
+  time before queued requests are left to wait for one of them to finish.
+  Workers blocked in thd_wait_begin() are not counted.
+*/
+static constexpr uint THREAD_GROUP_OVERSUBSCRIBE = 4;
+
+/** Idle time after which a worker exits, unless it is the last of its group */
+static constexpr std::chrono::seconds WORKER_IDLE_TIMEOUT{60};
+
+/** Maximum number of epoll events fetched by one epoll_wait() call */
+static constexpr int MAX_EVENTS = 16;
+
+class Thread_group;
+
+/** A client connection served by the thread pool. */
+struct Pool_connection {
+  explicit Pool_connection(Channel_info *channel_info)
+      : m_channel_info(channel_info) {}
+
+  /** Connection channel, until the worker doing the login creates m_thd */
+  Channel_info *m_channel_info;
+  /** Session, nullptr until the first worker picks up the connection */
+  THD *m_thd{nullptr};
+  /** Group whose epoll set the connection is registered with */
+  Thread_group *m_group{nullptr};
+  /** Socket descriptor of the connection */
+  int m_fd{-1};
+  /** true once authentication has succeeded */
+  bool m_logged_in{false};
+  /** true if the session has an active multi-statement transaction */
+  bool m_in_trx{false};
+
+  /** true while waiting in epoll for the next request. Group mutex. */
+  bool m_idle{false};
+  /** true once the socket was shut down by wait_timeout. Group mutex. */
+  bool m_timed_out{false};
+  /** Start of the current idle period. Group mutex. */
+  std::chrono::steady_clock::time_point m_idle_since;
+
+  /** Links in the list of connections of m_group. Group mutex. */
+  Pool_connection *m_prev{nullptr};
+  Pool_connection *m_next{nullptr};
+};
+
+#ifdef HAVE_PSI_INTERFACE
+static PSI_mutex_key key_LOCK_thread_group;
+static PSI_cond_key key_COND_thread_group;
+static PSI_thread_key key_thread_pool_worker;
+static PSI_thread_key key_thread_pool_timer;
+
+static PSI_mutex_info all_thread_pool_mutexes[] = {
+    {&key_LOCK_thread_group, "LOCK_thread_group", 0, 0, PSI_DOCUMENT_ME}};
+
+static PSI_cond_info all_thread_pool_conds[] = {
+    {&key_COND_thread_group, "COND_thread_group", 0, 0, PSI_DOCUMENT_ME}};
+
+static PSI_thread_info all_thread_pool_threads[] = {
+    {&key_thread_pool_worker, "thread_pool_worker", "tp_worker",
+     PSI_FLAG_USER, 0, PSI_DOCUMENT_ME},
+    {&key_thread_pool_timer, "thread_pool_timer", "tp_timer",
+     PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME}};
+#endif /* HAVE_PSI_INTERFACE */
+
+// Error log throttle for the thread creation failure of the pool.
+static Error_log_throttle create_worker_err_log_throttle(
+    Log_throttle ::LOG_THROTTLE_WINDOW_SIZE, ERROR_LEVEL, 0,
+    "connection_handler",
+    "Error log throttle: %10lu"
+    " 'Can't create thread to"
+    " handle new connection'"
+    " error(s) suppressed");
+
+/** Number of worker threads in all thread groups */
+static std::atomic<uint> worker_count{0};
+
+/**
+  A set of worker threads serving the connections assigned to the group.
+
+  At most one worker at a time is the listener, which waits in epoll_wait()
+  for requests on the connections of the group. The listener keeps the first
+  ready connection for itself and queues the others for the remaining
+  workers. Connections with an active transaction are queued ahead of the
+  others so that they release their locks sooner. Workers with nothing to do
+  take queued connections from other groups before they go to sleep.
+*/
+class Thread_group {
+ public:
+  bool init() {
+    mysql_mutex_init(key_LOCK_thread_group, &m_mutex, MY_MUTEX_INIT_FAST);
+    mysql_cond_init(key_COND_thread_group, &m_cond);
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epoll_fd < 0 || m_wakeup_fd < 0) return true;
+
+    /* The wakeup descriptor is the only one with a nullptr data pointer. */
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;
+    return epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wakeup_fd, &ev) != 0;
+  }
+
+  void destroy() {
+    if (m_wakeup_fd >= 0) close(m_wakeup_fd);
+    if (m_epoll_fd >= 0) close(m_epoll_fd);
+    mysql_cond_destroy(&m_cond);
+    mysql_mutex_destroy(&m_mutex);
+  }
+
+  /** Make the listener return from epoll_wait(). */
+  void wakeup_listener() {
+    uint64_t one = 1;
+    [[maybe_unused]] auto ret = write(m_wakeup_fd, &one, sizeof(one));
+  }
+
+  /** Queue a connection ready for processing. Group mutex. */
+  void enqueue(Pool_connection *conn) {
+    mysql_mutex_assert_owner(&m_mutex);
+    conn->m_idle = false;
+    if (conn->m_in_trx)
+      m_high_prio_queue.push_back(conn);
+    else
+      m_queue.push_back(conn);
+  }
+
+  /** Take the next queued connection, if any. Group mutex. */
+  Pool_connection *dequeue() {
+    mysql_mutex_assert_owner(&m_mutex);
+    std::deque<Pool_connection *> &queue =
+        m_high_prio_queue.empty() ? m_queue : m_high_prio_queue;
+    if (queue.empty()) return nullptr;
+    Pool_connection *conn = queue.front();
+    queue.pop_front();
+    m_dequeued++;
+    return conn;
+  }
+
+  bool queue_empty() const {
+    return m_queue.empty() && m_high_prio_queue.empty();
+  }
+
+  /** Add a connection to the list of connections of the group. */
+  void link(Pool_connection *conn) {
+    mysql_mutex_assert_owner(&m_mutex);
+    conn->m_prev = nullptr;
+    conn->m_next = m_connections;
+    if (m_connections != nullptr) m_connections->m_prev = conn;
+    m_connections = conn;
+  }
+
+  /** Remove a connection from the list of connections of the group. */
+  void unlink(Pool_connection *conn) {
+    mysql_mutex_assert_owner(&m_mutex);
+    if (conn->m_prev != nullptr)
+      conn->m_prev->m_next = conn->m_next;
+    else
+      m_connections = conn->m_next;
+    if (conn->m_next != nullptr) conn->m_next->m_prev = conn->m_prev;
+    conn->m_prev = conn->m_next = nullptr;
+  }
+
+  /**
+    Get a worker going for queued requests: wake a sleeping worker, make the
+    listener look at the queue, or start a new worker. Group mutex.
+  */
+  void wake_or_create_worker();
+
+  /**
+    Shut down the sockets of connections idle for longer than their
+    wait_timeout, and get a new worker going if the group made no progress
+    since the last check although it has work.
+  */
+  void check_stall_and_timeouts(std::chrono::steady_clock::time_point now);
+
+  mysql_mutex_t m_mutex;
+  /** Signalled to wake up sleeping workers and on worker exit */
+  mysql_cond_t m_cond;
+
+  int m_epoll_fd{-1};
+  int m_wakeup_fd{-1};
+
+  /** Ready connections with an active transaction */
+  std::deque<Pool_connection *> m_high_prio_queue;
+  /** Other ready connections */
+  std::deque<Pool_connection *> m_queue;
+
+  /** Connections of the group, for wait_timeout checks */
+  Pool_connection *m_connections{nullptr};
+
+  /** Workers of the group */
+  uint m_thread_count{0};
+  /** Workers not sleeping and not blocked in thd_wait_begin() */
+  uint m_active_count{0};
+  /** Workers sleeping on m_cond */
+  uint m_waiting_count{0};
+  /** true while a worker waits in epoll_wait() */
+  bool m_has_listener{false};
+  /** Number of requests taken by workers, for stall detection */
+  ulonglong m_dequeued{0};
+  ulonglong m_dequeued_at_last_check{0};
+  /** Set when the pool is shut down */
+  bool m_shutdown{false};
+};
+
+static Thread_group *thread_groups = nullptr;
+static uint thread_group_count = 0;
+static std::atomic<uint> next_group{0};
+
+/** Group of the current worker thread, nullptr in other threads */
+static thread_local Thread_group *current_group = nullptr;
+/** Nesting depth of thd_wait_begin() calls of the current worker */
+static thread_local int current_wait_depth = 0;
+/** Stack start of the current worker thread */
+static thread_local char *current_stack_start = nullptr;
+
+static mysql_mutex_t LOCK_thread_pool_timer;
+static mysql_cond_t COND_thread_pool_timer;
+static bool timer_running = false;
+static bool timer_shutdown = false;
+
+extern "C" {
+static void *worker_main(void *arg);
+static void *timer_main(void *arg);
+}
+
+/** Start a worker thread for the group. Group mutex. */
+static bool create_worker(Thread_group *group) {
+  mysql_mutex_assert_owner(&group->m_mutex);
+  if (worker_count.load() >=
+      Thread_pool_connection_handler::max_threads_limit)
+    return true;
+
+  my_thread_handle id;
+  int error = mysql_thread_create(key_thread_pool_worker, &id,
+                                  &connection_attrib, worker_main, group);
+  if (error != 0) {
+    if (!create_worker_err_log_throttle.log())
+      LogErr(ERROR_LEVEL, ER_CONN_PER_THREAD_NO_THREAD, error);
+    return true;
+  }
+
+  worker_count++;
+  group->m_thread_count++;
+  group->m_active_count++;
+  Global_THD_manager::get_instance()->inc_thread_created();
+  return false;
+}
+
+void Thread_group::wake_or_create_worker() {
+  mysql_mutex_assert_owner(&m_mutex);
+  if (m_waiting_count > 0) {
+    mysql_cond_signal(&m_cond);
+  } else if (m_has_listener) {
+    wakeup_listener();
+  } else if (m_active_count < THREAD_GROUP_OVERSUBSCRIBE ||
+             m_thread_count == 0) {
+    create_worker(this);
+  }
+}
+
+void Thread_group::check_stall_and_timeouts(
+    std::chrono::steady_clock::time_point now) {
+  mysql_mutex_lock(&m_mutex);
+
+  /*
+    The group is stalled if no request was taken since the last check
+    although requests are queued, or all workers are busy so that nobody
+    listens for new requests.
+  */
+  bool has_work = !queue_empty() || (!m_has_listener && m_waiting_count == 0 &&
+                                     m_connections != nullptr);
+  if (has_work && m_dequeued == m_dequeued_at_last_check) {
+    if (m_waiting_count > 0)
+      mysql_cond_signal(&m_cond);
+    else
+      create_worker(this);
+  }
+  m_dequeued_at_last_check = m_dequeued;
+
+  for (Pool_connection *conn = m_connections; conn != nullptr;
+       conn = conn->m_next) {
+    if (!conn->m_idle || conn->m_timed_out) continue;
+    auto timeout =
+        std::chrono::seconds(conn->m_thd->variables.net_wait_timeout);
+    if (now - conn->m_idle_since > timeout) {
+      /* The worker picking up the connection sees it closed and ends it. */
+      conn->m_timed_out = true;
+      shutdown(conn->m_fd, SHUT_RDWR);
+    }
+  }
+
+  mysql_mutex_unlock(&m_mutex);
+}
+
+/** Bind a session to the current worker thread. */
+static void attach_thd(Pool_connection *conn) {
+  THD *thd = conn->m_thd;
+  thd_set_thread_stack(thd, current_stack_start);
+  thd->store_globals();
+  mysql_thread_set_psi_id(thd->thread_id());
+  mysql_thread_set_psi_THD(thd);
+  mysql_socket_set_thread_owner(
+      thd->get_protocol_classic()->get_vio()->mysql_socket);
+}
+
+/** Unbind a session from the current worker thread. */
+static void detach_thd(Pool_connection *conn) {
+  mysql_thread_set_psi_THD(nullptr);
+  conn->m_thd->restore_globals();
+}
+
+/**
+  Create the session of a new connection. Same as init_new_thd() of
+  Per_thread_connection_handler.
+*/
+static bool create_connection_thd(Pool_connection *conn) {
+  Channel_info *channel_info = conn->m_channel_info;
+  conn->m_channel_info = nullptr;
+
+  THD *thd = channel_info->create_thd();
+  if (thd == nullptr) {
+    connection_errors_internal++;
+    channel_info->send_error_and_close_channel(ER_OUT_OF_RESOURCES, 0, false);
+    delete channel_info;
+    return true;
+  }
+  delete channel_info;
+
+  thd->set_new_thread_id();
+  conn->m_thd = thd;
+  conn->m_fd = mysql_socket_getfd(
+      thd->get_protocol_classic()->get_vio()->mysql_socket);
+  return false;
+}
+
+/** End a connection and free its session. */
+static void end_pool_connection(Pool_connection *conn) {
+  THD *thd = conn->m_thd;
+  Thread_group *group = conn->m_group;
+
+  mysql_mutex_lock(&group->m_mutex);
+  group->unlink(conn);
+  mysql_mutex_unlock(&group->m_mutex);
+  epoll_ctl(group->m_epoll_fd, EPOLL_CTL_DEL, conn->m_fd, nullptr);
+
+  if (conn->m_logged_in) end_connection(thd);
+  close_connection(thd, 0, false, false);
+
+  thd->get_stmt_da()->reset_diagnostics_area();
+  thd->release_resources();
+  Global_THD_manager::get_instance()->remove_thd(thd);
+  Connection_handler_manager::dec_connection_count();
+
+  detach_thd(conn);
+  delete thd;
+  delete conn;
+}
+
+/**
+  Wait in epoll for the next request on the connection. The descriptor is
+  registered with EPOLLONESHOT, so that only one worker gets each request.
+
+  @retval true  Failed, the connection must be ended.
+*/
+static bool wait_for_next_request(Pool_connection *conn, bool first) {
+  Thread_group *group = conn->m_group;
+
+  mysql_mutex_lock(&group->m_mutex);
+  if (first) group->link(conn);
+  conn->m_idle = true;
+  conn->m_idle_since = std::chrono::steady_clock::now();
+  mysql_mutex_unlock(&group->m_mutex);
+
+  epoll_event ev{};
+  ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+  ev.data.ptr = conn;
+  return epoll_ctl(group->m_epoll_fd, first ? EPOLL_CTL_ADD : EPOLL_CTL_MOD,
+                   conn->m_fd, &ev) != 0;
+}
+
+/** Log in a new connection or execute the requests pending on it. */
+static void process_connection(Pool_connection *conn) {
+  bool first = false;
+
+  if (conn->m_thd == nullptr) {
+    if (create_connection_thd(conn)) {
+      Connection_handler_manager::get_instance()->inc_aborted_connects();
+      Connection_handler_manager::dec_connection_count();
+      delete conn;
+      return;
+    }
+    attach_thd(conn);
+    Global_THD_manager::get_instance()->add_thd(conn->m_thd);
+    first = true;
+  } else {
+    attach_thd(conn);
+  }
+
+  THD *thd = conn->m_thd;
+  bool end = false;
+
+  if (!conn->m_logged_in) {
+    if (thd_prepare_connection(thd)) {
+      Connection_handler_manager::get_instance()->inc_aborted_connects();
+      end = true;
+    } else {
+      conn->m_logged_in = true;
+    }
+  } else {
+    /*
+      Execute one request, and more if the client sent them already. Data
+      buffered in the Vio, e.g. by SSL, does not make epoll report the
+      descriptor again.
+    */
+    Vio *vio = thd->get_protocol_classic()->get_vio();
+    do {
+      if (do_command(thd)) {
+        end = true;
+        break;
+      }
+    } while (thd_connection_alive(thd) && vio->has_data(vio));
+  }
+
+  if (!end && !thd_connection_alive(thd)) end = true;
+
+  if (end) {
+    if (first) {
+      /* Not registered with the group yet: link so that unlink works. */
+      mysql_mutex_lock(&conn->m_group->m_mutex);
+      conn->m_group->link(conn);
+      mysql_mutex_unlock(&conn->m_group->m_mutex);
+    }
+    end_pool_connection(conn);
+    return;
+  }
+
+  conn->m_in_trx = thd->in_active_multi_stmt_transaction();
+  detach_thd(conn);
+
+  if (wait_for_next_request(conn, first)) {
+    attach_thd(conn);
+    end_pool_connection(conn);
+  }
+}
+
+/**
+  Try to take a queued connection of another group.
+  Group mutex of the caller's group is not held.
+*/
+static Pool_connection *steal_connection(Thread_group *own) {
+  for (uint i = 0; i < thread_group_count; i++) {
+    Thread_group *group = &thread_groups[i];
+    if (group == own || group->queue_empty()) continue;
+    if (mysql_mutex_trylock(&group->m_mutex) != 0) continue;
+    Pool_connection *conn = group->dequeue();
+    mysql_mutex_unlock(&group->m_mutex);
+    if (conn != nullptr) return conn;
+  }
+  return nullptr;
+}
+
+/**
+  Get the next connection to work on, listening on the epoll set of the
+  group if no other worker does. Group mutex is held on entry and on exit.
+
+  @return connection, or nullptr if the worker should exit.
+*/
+static Pool_connection *get_connection(Thread_group *group) {
+  mysql_mutex_assert_owner(&group->m_mutex);
+
+  for (;;) {
+    if (group->m_shutdown) return nullptr;
+
+    Pool_connection *conn = group->dequeue();
+    if (conn != nullptr) return conn;
+
+    mysql_mutex_unlock(&group->m_mutex);
+    conn = steal_connection(group);
+    mysql_mutex_lock(&group->m_mutex);
+    if (conn != nullptr) return conn;
+
+    if (!group->m_has_listener) {
+      epoll_event events[MAX_EVENTS];
+
+      group->m_has_listener = true;
+      mysql_mutex_unlock(&group->m_mutex);
+      int n = epoll_wait(group->m_epoll_fd, events, MAX_EVENTS, -1);
+      mysql_mutex_lock(&group->m_mutex);
+      group->m_has_listener = false;
+
+      for (int i = 0; i < n; i++) {
+        auto ready = static_cast<Pool_connection *>(events[i].data.ptr);
+        if (ready == nullptr) {
+          uint64_t count;
+          [[maybe_unused]] auto ret =
+              read(group->m_wakeup_fd, &count, sizeof(count));
+          continue;
+        }
+        group->enqueue(ready);
+      }
+
+      conn = group->dequeue();
+      if (!group->queue_empty() || conn != nullptr) {
+        /* Someone else has to listen while we work, and take the rest. */
+        if (group->m_waiting_count > 0) mysql_cond_signal(&group->m_cond);
+      }
+      if (conn != nullptr) return conn;
+      continue;
+    }
+
+    /* Sleep until there is work, or exit if idle for long. */
+    group->m_active_count--;
+    group->m_waiting_count++;
+    struct timespec abstime;
+    set_timespec(&abstime, WORKER_IDLE_TIMEOUT.count());
+    int error = mysql_cond_timedwait(&group->m_cond, &group->m_mutex, &abstime);
+    group->m_waiting_count--;
+    group->m_active_count++;
+
+    if (is_timeout(error) && group->m_thread_count > 1 &&
+        group->queue_empty())
+      return nullptr;
+  }
+}
+
+extern "C" {
+static void *worker_main(void *arg) {
+  Thread_group *group = static_cast<Thread_group *>(arg);
+  char stack_start;
+
+  if (my_thread_init()) {
+    mysql_mutex_lock(&group->m_mutex);
+    group->m_thread_count--;
+    group->m_active_count--;
+    worker_count--;
+    mysql_cond_broadcast(&group->m_cond);
+    mysql_mutex_unlock(&group->m_mutex);
+    my_thread_exit(nullptr);
+    return nullptr;
+  }
+
+  current_group = group;
+  current_stack_start = &stack_start;
+
+  mysql_mutex_lock(&group->m_mutex);
+  for (;;) {
+    Pool_connection *conn = get_connection(group);
+    if (conn == nullptr) break;
+
+    mysql_mutex_unlock(&group->m_mutex);
+    process_connection(conn);
+    mysql_mutex_lock(&group->m_mutex);
+  }
+  group->m_thread_count--;
+  group->m_active_count--;
+  worker_count--;
+  mysql_cond_broadcast(&group->m_cond);
+  mysql_mutex_unlock(&group->m_mutex);
+
+  current_group = nullptr;
+  my_thread_end();
+  my_thread_exit(nullptr);
+  return nullptr;
+}
+
+static void *timer_main(void *) {
+  my_thread_init();
+
+  mysql_mutex_lock(&LOCK_thread_pool_timer);
+  while (!timer_shutdown) {
+    struct timespec abstime;
+    set_timespec_nsec(&abstime, Thread_pool_connection_handler::stall_limit *
+                                    1000000ULL);
+    mysql_cond_timedwait(&COND_thread_pool_timer, &LOCK_thread_pool_timer,
+                         &abstime);
+    if (timer_shutdown) break;
+
+    mysql_mutex_unlock(&LOCK_thread_pool_timer);
+    auto now = std::chrono::steady_clock::now();
+    for (uint i = 0; i < thread_group_count; i++)
+      thread_groups[i].check_stall_and_timeouts(now);
+    mysql_mutex_lock(&LOCK_thread_pool_timer);
+  }
+  timer_running = false;
+  mysql_cond_broadcast(&COND_thread_pool_timer);
+  mysql_mutex_unlock(&LOCK_thread_pool_timer);
+
+  my_thread_end();
+  my_thread_exit(nullptr);
+  return nullptr;
+}
+}  // extern "C"
+
+/**
+  A worker is about to block. If it was the last active worker of its group
+  and requests are waiting, get another worker going.
+*/
+static void tp_wait_begin(THD *, int) {
+  Thread_group *group = current_group;
+  if (group == nullptr || current_wait_depth++ > 0) return;
+
+  mysql_mutex_lock(&group->m_mutex);
+  group->m_active_count--;
+  if (group->m_active_count == 0 &&
+      (!group->queue_empty() || !group->m_has_listener))
+    group->wake_or_create_worker();
+  mysql_mutex_unlock(&group->m_mutex);
+}
+
+static void tp_wait_end(THD *) {
+  Thread_group *group = current_group;
+  if (group == nullptr || --current_wait_depth > 0) return;
+
+  mysql_mutex_lock(&group->m_mutex);
+  group->m_active_count++;
+  mysql_mutex_unlock(&group->m_mutex);
+}
+
+static THD_event_functions thread_pool_event_functions = {
+    tp_wait_begin, tp_wait_end, nullptr};
+
+bool Thread_pool_connection_handler::init() {
+#ifdef HAVE_PSI_INTERFACE
+  int count = static_cast<int>(array_elements(all_thread_pool_mutexes));
+  mysql_mutex_register("sql", all_thread_pool_mutexes, count);
+
+  count = static_cast<int>(array_elements(all_thread_pool_conds));
+  mysql_cond_register("sql", all_thread_pool_conds, count);
+
+  count = static_cast<int>(array_elements(all_thread_pool_threads));
+  mysql_thread_register("sql", all_thread_pool_threads, count);
+#endif
+
+  thread_group_count = group_count;
+  if (thread_group_count == 0)
+    thread_group_count = std::max(1U, std::thread::hardware_concurrency());
+
+  thread_groups = new (std::nothrow) Thread_group[thread_group_count];
+  if (thread_groups == nullptr) return true;
+
+  for (uint i = 0; i < thread_group_count; i++) {
+    if (thread_groups[i].init()) return true;
+  }
+
+  mysql_mutex_init(PSI_NOT_INSTRUMENTED, &LOCK_thread_pool_timer,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(PSI_NOT_INSTRUMENTED, &COND_thread_pool_timer);
+
+  my_thread_handle id;
+  timer_running = true;
+  if (mysql_thread_create(key_thread_pool_timer, &id, &connection_attrib,
+                          timer_main, nullptr) != 0) {
+    timer_running = false;
+    return true;
+  }
+
+  Connection_handler_manager::event_functions = &thread_pool_event_functions;
+  m_initialized = true;
+  return false;
+}
+
+Thread_pool_connection_handler::~Thread_pool_connection_handler() {
+  if (thread_groups == nullptr) return;
+
+  if (m_initialized) {
+    Connection_handler_manager::event_functions = nullptr;
+
+    mysql_mutex_lock(&LOCK_thread_pool_timer);
+    timer_shutdown = true;
+    mysql_cond_broadcast(&COND_thread_pool_timer);
+    while (timer_running)
+      mysql_cond_wait(&COND_thread_pool_timer, &LOCK_thread_pool_timer);
+    mysql_mutex_unlock(&LOCK_thread_pool_timer);
+
+    mysql_mutex_destroy(&LOCK_thread_pool_timer);
+    mysql_cond_destroy(&COND_thread_pool_timer);
+
+    /* All connections have ended, stop the workers. */
+    for (uint i = 0; i < thread_group_count; i++) {
+      Thread_group *group = &thread_groups[i];
+      mysql_mutex_lock(&group->m_mutex);
+      group->m_shutdown = true;
+      while (group->m_thread_count > 0) {
+        mysql_cond_broadcast(&group->m_cond);
+        group->wakeup_listener();
+        mysql_cond_wait(&group->m_cond, &group->m_mutex);
+      }
+      mysql_mutex_unlock(&group->m_mutex);
+    }
+  }
+
+  for (uint i = 0; i < thread_group_count; i++) thread_groups[i].destroy();
+  delete[] thread_groups;
+  thread_groups = nullptr;
+}
+
+bool Thread_pool_connection_handler::add_connection(
+    Channel_info *channel_info) {
+  DBUG_TRACE;
+
+  Pool_connection *conn = new (std::nothrow) Pool_connection(channel_info);
+  if (conn == nullptr) {
+    connection_errors_internal++;
+    channel_info->send_error_and_close_channel(ER_OUT_OF_RESOURCES, 0, false);
+    Connection_handler_manager::dec_connection_count();
+    return true;
+  }
+
+  Thread_group *group = &thread_groups[next_group++ % thread_group_count];
+  conn->m_group = group;
+
+  /* The login is done by a worker, as the first request. */
+  mysql_mutex_lock(&group->m_mutex);
+  group->enqueue(conn);
+  group->wake_or_create_worker();
+  bool no_worker = group->m_thread_count == 0;
+  if (no_worker) group->m_queue.pop_back();
+  mysql_mutex_unlock(&group->m_mutex);
+
+  if (no_worker) {
+    conn->m_channel_info = nullptr;
+    delete conn;
+    connection_errors_internal++;
+    channel_info->send_error_and_close_channel(ER_CANT_CREATE_THREAD, 0, true);
+    Connection_handler_manager::dec_connection_count();
+    return true;
+  }
+  return false;
+}
+
+uint Thread_pool_connection_handler::get_max_threads() const {
+  return max_threads_limit;
+}
+
+#endif /* HAVE_EPOLL */
@@ -23,6 +23,8 @@
 #ifndef DD__DD_INCLUDED
 #define DD__DD_INCLUDED
 
+#include "my_inttypes.h"
+
 namespace dd {
 
 ///////////////////////////////////////////////////////////////////////////
@@ -69,6 +71,23 @@ bool shutdown();
 */
 class Dictionary *get_dictionary();
 
+/**
+  Lookup statistics of the shared dictionary object cache, summed over
+  all object types.
+*/
+struct Cache_stats {
+  ulonglong hits{0};        ///< Lookups finding the object in the cache.
+  ulonglong misses{0};      ///< Lookups reading the object from storage.
+  ulonglong miss_waits{0};  ///< Lookups waiting for a concurrent miss.
+};
+
+/**
+  Get the lookup statistics of the shared dictionary object cache.
+
+  @param [out] stats  Statistics.
+*/
+void get_cache_stats(Cache_stats *stats);
+
 /**
   Create a instance of data dictionary object of type X.
   E.g., X could be 'dd::Table', 'dd::View' and etc.
@@ -73,6 +73,19 @@ void Shared_dictionary_cache::shutdown() {
   instance()->m_map<Resource_group>()->shutdown();
 }
 
+void Shared_dictionary_cache::get_stats(Cache_stats *stats) {
+  instance()->m_map<Abstract_table>()->add_stats(stats);
+  instance()->m_map<Collation>()->add_stats(stats);
+  instance()->m_map<Column_statistics>()->add_stats(stats);
+  instance()->m_map<Charset>()->add_stats(stats);
+  instance()->m_map<Event>()->add_stats(stats);
+  instance()->m_map<Routine>()->add_stats(stats);
+  instance()->m_map<Schema>()->add_stats(stats);
+  instance()->m_map<Spatial_reference_system>()->add_stats(stats);
+  instance()->m_map<Tablespace>()->add_stats(stats);
+  instance()->m_map<Resource_group>()->add_stats(stats);
+}
+
 // Don't call this function anywhere except upgrade scenario.
 void Shared_dictionary_cache::reset(bool keep_dd_entities) {
   shutdown();
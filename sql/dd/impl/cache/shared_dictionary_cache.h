@@ -194,6 +194,9 @@ class Shared_dictionary_cache {
   // Reset the shared cache. Optionally keep the core DD table meta data.
   static void reset(bool keep_dd_entities);
 
+  // Sum up the lookup statistics of the shared maps.
+  static void get_stats(Cache_stats *stats);
+
   // Reset the table and tablespace partitions.
   static bool reset_tables_and_tablespaces(THD *thd);
 
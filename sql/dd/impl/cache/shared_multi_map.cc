@@ -248,10 +248,14 @@ template <typename K>
 bool Shared_multi_map<T>::get(const K &key, Cache_element<T> **element) {
   Autolocker lock(this);
   *element = use_if_present(key);
-  if (*element) return false;
+  if (*element) {
+    m_hits++;
+    return false;
+  }
 
   // Is the element already missed?
   if (m_map<K>()->is_missed(key)) {
+    m_miss_waits++;
     while (m_map<K>()->is_missed(key))
       mysql_cond_wait(&m_miss_handled, &m_lock);
 
@@ -263,10 +267,14 @@ bool Shared_multi_map<T>::get(const K &key, Cache_element<T> **element) {
     // it to the cache, before this waiting thread was alerted. Thus,
     // we need to handle this situation as a cache miss if the element
     // is absent.
-    if (*element) return false;
+    if (*element) {
+      m_hits++;
+      return false;
+    }
   }
 
   // Mark the key as being missed.
+  m_misses++;
   m_map<K>()->set_missed(key);
   return true;
 }
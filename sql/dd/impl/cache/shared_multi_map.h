@@ -37,6 +37,7 @@
 #include "mysql/psi/mysql_mutex.h"
 #include "mysql/psi/mysql_thread.h"
 #include "sql/dd/cache/multi_map_base.h"      // Multi_map_base
+#include "sql/dd/dd.h"                         // dd::Cache_stats
 #include "sql/dd/impl/cache/cache_element.h"  // Cache_element
 #include "sql/dd/impl/cache/free_list.h"      // Free_list
 #include "sql/dd/types/abstract_table.h"
@@ -188,6 +189,11 @@ class Shared_multi_map : public Multi_map_base<T> {
                        // number of elements exceeds this
                        // limit, shrink the free list.
 
+  // Lookup statistics, protected by m_lock.
+  ulonglong m_hits{0};        // Lookups finding the element.
+  ulonglong m_misses{0};      // Lookups marking the key as missed.
+  ulonglong m_miss_waits{0};  // Lookups waiting for another miss.
+
   /**
     Template helper function getting the element map.
 
@@ -337,6 +343,20 @@ class Shared_multi_map : public Multi_map_base<T> {
     rectify_free_list(&lock);
   }
 
+  /**
+    Add the lookup statistics of this map to the given counters.
+
+    @param [in,out]  stats  Counters to add to.
+  */
+
+  void add_stats(Cache_stats *stats) {
+    mysql_mutex_lock(&m_lock);
+    stats->hits += m_hits;
+    stats->misses += m_misses;
+    stats->miss_waits += m_miss_waits;
+    mysql_mutex_unlock(&m_lock);
+  }
+
   /**
     Check if an element with the given key is available.
   */
@@ -67,6 +67,11 @@ bool init(enum_dd_init_type dd_init) {
 
 ///////////////////////////////////////////////////////////////////////////
 
+void get_cache_stats(Cache_stats *stats) {
+  *stats = Cache_stats();
+  cache::Shared_dictionary_cache::get_stats(stats);
+}
+
 bool shutdown() {
   cache::Shared_dictionary_cache::shutdown();
   return Dictionary_impl::shutdown();
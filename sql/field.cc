@@ -7640,22 +7640,23 @@ type_conversion_status Field_json::store(const char *from, size_t length,
 
   const char *err_table_name = *table_name;
   const char *err_field_name = field_name;
-  std::unique_ptr<Json_dom> dom(Json_dom::parse(
-      s, ss,
-      [err_table_name, err_field_name](const char *parse_err,
-                                       size_t err_offset) {
-        String s_err;
-        s_err.append(err_table_name);
-        s_err.append('.');
-        s_err.append(err_field_name);
-        my_error(ER_INVALID_JSON_TEXT, MYF(0), parse_err, err_offset,
-                 s_err.c_ptr_safe());
-      },
-      JsonDocumentDefaultDepthHandler));
-
-  if (dom.get() == nullptr) return TYPE_ERR_BAD_VALUE;
-
-  if (json_binary::serialize(current_thd, dom.get(), &value))
+  /*
+    Go straight from text to the binary format. The text may live in
+    the value buffer, which is fine, as serialize_text() doesn't write
+    to the destination before the whole text has been parsed.
+  */
+  if (json_binary::serialize_text(
+          current_thd, s, ss, &value,
+          [err_table_name, err_field_name](const char *parse_err,
+                                           size_t err_offset) {
+            String s_err;
+            s_err.append(err_table_name);
+            s_err.append('.');
+            s_err.append(err_field_name);
+            my_error(ER_INVALID_JSON_TEXT, MYF(0), parse_err, err_offset,
+                     s_err.c_ptr_safe());
+          },
+          JsonDocumentDefaultDepthHandler))
     return TYPE_ERR_BAD_VALUE;
 
   return store_binary(value.ptr(), value.length());
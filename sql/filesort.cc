@@ -425,6 +425,7 @@ bool filesort(THD *thd, Filesort *filesort, RowIterator *source_iterator,
                            sortlength(thd, filesort->sortorder, s_length),
                            filesort->tables, max_rows,
                            filesort->m_remove_duplicates);
+  param->m_num_sort_threads = thd->variables.sort_threads;
 
   fs_info->addon_fields = param->addon_fields;
 
@@ -471,6 +472,7 @@ bool filesort(THD *thd, Filesort *filesort, RowIterator *source_iterator,
     filesort->using_pq = true;
     param->using_pq = true;
     param->m_addon_fields_status = Addon_fields_status::using_priority_queue;
+    param->init_key_prefix_check();
   } else {
     DBUG_PRINT("info", ("filesort PQ is not applicable"));
     filesort->using_pq = false;
@@ -587,7 +589,8 @@ bool filesort(THD *thd, Filesort *filesort, RowIterator *source_iterator,
                                                        : "rowid");
     sort_mode.append(">");
 
-    const char *algo_text[] = {"none", "std::sort", "std::stable_sort"};
+    const char *algo_text[] = {"none", "std::sort", "std::stable_sort",
+                               "radix_sort"};
 
     Opt_trace_object filesort_summary(trace, "filesort_summary");
     filesort_summary.add("memory_available", memory_available)
@@ -604,6 +607,9 @@ bool filesort(THD *thd, Filesort *filesort, RowIterator *source_iterator,
           "unpacked_addon_fields",
           addon_fields_text(param->m_addon_fields_status));
     filesort_summary.add_alnum("sort_mode", sort_mode.c_ptr());
+    if (param->m_use_key_prefix_check)
+      filesort_summary.add("num_rows_rejected_by_key_prefix",
+                           param->m_num_rows_rejected_by_prefix);
   }
 
   if (num_rows_found > param->max_rows) {
@@ -1000,9 +1006,16 @@ static ha_rows read_all_rows(
 
     ++(*found_rows);
     num_total_records++;
-    if (pq)
-      pq->push(tables);
-    else {
+    if (pq) {
+      // Once the queue is full, most rows do not make it into the top N.
+      // Weed them out on the first sort field, before making the full key.
+      if (param->m_use_key_prefix_check && pq->is_full() &&
+          param->key_prefix_exceeds(pq->top())) {
+        ++param->m_num_rows_rejected_by_prefix;
+      } else {
+        pq->push(tables);
+      }
+    } else {
       size_t key_length;
       bool out_of_mem_or_error = alloc_and_make_sortkey(
           param, fs_info, tables, &key_length, &longest_addon_so_far);
@@ -1379,6 +1392,45 @@ size_t make_sortkey_from_item(Item *item, Item_result result_type,
 
 }  // namespace
 
+void Sort_param::init_key_prefix_check() {
+  m_use_key_prefix_check = false;
+  m_num_rows_rejected_by_prefix = 0;
+  if (local_sortorder.empty()) return;
+  const st_sort_field &sort_field = local_sortorder[0];
+  // Evaluating anything but a column twice could have side effects, or give
+  // a different value the second time (think ORDER BY RAND()).
+  m_use_key_prefix_check = !sort_field.is_varlen &&
+                           sort_field.length <= kMaxKeyPrefixLength &&
+                           sort_field.item->type() == Item::FIELD_ITEM;
+}
+
+bool Sort_param::key_prefix_exceeds(const uchar *key) {
+  assert(m_use_key_prefix_check);
+  const st_sort_field &sort_field = local_sortorder[0];
+  uchar buf[kMaxKeyPrefixLength + 1];
+  bool maybe_null;
+  ulonglong hash = 0;
+  const size_t actual_length = make_sortkey_from_item(
+      sort_field.item, sort_field.result_type, sort_field.length, &tmp_buffer,
+      buf, buf + sizeof(buf), &maybe_null, &hash);
+  // Leave any errors to make_sortkey().
+  if (actual_length == UINT_MAX) return false;
+
+  // Reverse the key if needed, the same way as make_sortkey() does.
+  uchar *to = buf;
+  if (maybe_null) {
+    if (sort_field.reverse && *to == 0) *to = 0xff;
+    ++to;
+  }
+  if (sort_field.reverse) {
+    for (size_t i = 0; i < actual_length; ++i) to[i] = static_cast<uchar>(~to[i]);
+  }
+  const size_t prefix_length = (to - buf) + actual_length;
+
+  if (using_varlen_keys()) key += size_of_varlength_field;
+  return memcmp(buf, key, prefix_length) > 0;
+}
+
 uint Sort_param::make_sortkey(Bounds_checked_array<uchar> dst,
                               const Mem_root_array<TABLE *> &tables,
                               size_t *longest_addon_so_far) {
@@ -1993,6 +2045,11 @@ static int merge_buffers(THD *thd, Sort_param *param, IO_CACHE *from_file,
       merge_chunk->advance_current_key(row_length);
       merge_chunk->decrement_mem_count();
       if (0 == merge_chunk->mem_count()) {
+        // The same chunk can stay at the top of the queue for most of the
+        // pass, so check for kill once per buffer refill, not per chunk.
+        if (thd->killed) {
+          return 1;
+        }
         // No more records in memory for this chunk. Read more, and if there's
         // none, take it out of the queue.
         if (!(error = (int)read_to_buffer(from_file, merge_chunk, param))) {
@@ -2017,6 +2074,9 @@ static int merge_buffers(THD *thd, Sort_param *param, IO_CACHE *from_file,
   merge_chunk->set_max_keys(param->max_rows_per_buffer);
 
   do {
+    if (thd->killed) {
+      return 1;
+    }
     for (uint ix = 0; ix < merge_chunk->mem_count(); ++ix) {
       unsigned row_length, payload_length;
       param->get_rec_and_res_len(merge_chunk->current_key(), &row_length,
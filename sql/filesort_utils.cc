@@ -25,14 +25,21 @@
 #include <string.h>
 #include <algorithm>
 #include <cmath>
+#include <memory>
+#include <new>
 
 #include "add_with_saturate.h"
 #include "my_dbug.h"
 #include "my_io.h"
 #include "my_pointer_arithmetic.h"
+#include "mutex_lock.h"
 #include "sql/cmp_varlen_keys.h"
+#include "sql/current_thd.h"
+#include "sql/mysqld.h"
 #include "sql/opt_costmodel.h"
+#include "sql/parallel_tasks.h"
 #include "sql/sort_param.h"
+#include "sql/sql_class.h"
 #include "sql/sql_sort.h"
 #include "sql/thr_malloc.h"
 
@@ -125,6 +132,142 @@ class Equality_from_less {
   const Comp &m_comp;
 };
 
+/*
+  The minimum number of rows to give each thread when sorting in parallel.
+  For smaller slices, starting the threads costs more than it saves.
+ */
+constexpr size_t kMinRowsPerSortThread = 16384;
+
+/*
+  Keys up to this length are sorted with radix_sort() rather than with
+  std::stable_sort. Radix sort does one pass over the rows per key byte
+  (although it skips bytes that are equal for all rows in a bucket), so for
+  long keys, a comparison sort that mostly looks at the first few bytes wins.
+ */
+constexpr size_t kMaxRadixSortKeyLength = 16;
+
+/*
+  Buckets with fewer rows than this are not split further by radix_sort(),
+  but sorted with std::stable_sort on the remaining key bytes.
+ */
+constexpr size_t kRadixSortCutoff = 64;
+
+/*
+  A stable MSD radix sort of the keys in [first, last), on the key bytes from
+  “depth” up to key_len, which are normalized so that they can be compared
+  with memcmp(). “tmp” is scratch space for last - first pointers.
+ */
+void radix_sort(uchar **first, uchar **last, uchar **tmp, size_t key_len,
+                size_t depth) {
+  const size_t num_rows = last - first;
+  for (;;) {
+    if (depth == key_len) return;
+    if (num_rows < kRadixSortCutoff) {
+      stable_sort(first, last, [depth, key_len](const uchar *a,
+                                                const uchar *b) {
+        return memcmp(a + depth, b + depth, key_len - depth) < 0;
+      });
+      return;
+    }
+
+    size_t counts[256] = {0};
+    for (uchar **it = first; it != last; ++it) ++counts[(*it)[depth]];
+
+    // All rows in the same bucket; no need to move anything around.
+    if (counts[(*first)[depth]] == num_rows) {
+      ++depth;
+      continue;
+    }
+
+    size_t offsets[256];
+    size_t offset = 0;
+    for (size_t i = 0; i < 256; ++i) {
+      offsets[i] = offset;
+      offset += counts[i];
+    }
+    for (uchar **it = first; it != last; ++it) {
+      tmp[offsets[(*it)[depth]]++] = *it;
+    }
+    std::copy(tmp, tmp + num_rows, first);
+
+    size_t start = 0;
+    for (size_t i = 0; i < 256; ++i) {
+      if (counts[i] > 1) {
+        radix_sort(first + start, first + start + counts[i], tmp + start,
+                   key_len, depth + 1);
+      }
+      start += counts[i];
+    }
+    return;
+  }
+}
+
+/*
+  Sort [first, last) using radix_sort() if radix_key_len is nonzero, or else
+  using std::stable_sort or std::sort, with up to num_threads threads. The range is split into equally large slices which are
+  sorted concurrently, and then merged pairwise with std::inplace_merge, the
+  independent merges of each round running concurrently, until one sorted
+  range is left. The merges are stable, so the result is stable if the slices
+  were sorted stably.
+
+  The comparators only look at the sort keys (and the sort field array, which
+  is read-only at this point), so they are safe to call from worker threads.
+ */
+template <class Iterator, class Comp>
+void sort_maybe_parallel(Iterator first, Iterator last, const Comp &comp,
+                         bool stable, size_t num_threads,
+                         size_t radix_key_len = 0) {
+  const auto sort_slice = [&comp, stable, radix_key_len](Iterator begin,
+                                                          Iterator end) {
+    if (radix_key_len > 0) {
+      const size_t num_rows = end - begin;
+      std::unique_ptr<uchar *[]> tmp(new (std::nothrow) uchar *[num_rows]);
+      if (tmp != nullptr) {
+        radix_sort(&*begin, &*begin + num_rows, tmp.get(), radix_key_len,
+                   /*depth=*/0);
+        return;
+      }
+      // Out of memory; fall back to a comparison sort (which is also stable).
+    }
+    if (stable || radix_key_len > 0)
+      stable_sort(begin, end, comp);
+    else
+      sort(begin, end, comp);
+  };
+
+  const size_t num_rows = last - first;
+  const size_t num_slices =
+      min<size_t>(num_threads, num_rows / kMinRowsPerSortThread);
+  if (num_slices <= 1) {
+    sort_slice(first, last);
+    return;
+  }
+
+  // Slice i is [first + bounds[i], first + bounds[i + 1]).
+  vector<size_t> bounds(num_slices + 1);
+  for (size_t i = 0; i <= num_slices; ++i) {
+    bounds[i] = num_rows * i / num_slices;
+  }
+
+  RunParallelTasks(num_slices, num_threads, [&](size_t i) {
+    sort_slice(first + bounds[i], first + bounds[i + 1]);
+  });
+
+  // Each round merges pairs of sorted runs that are “width” slices long.
+  for (size_t width = 1; width < num_slices; width *= 2) {
+    const size_t num_merges = (num_slices + 2 * width - 1) / (2 * width);
+    RunParallelTasks(num_merges, num_threads, [&](size_t i) {
+      const size_t lo = i * 2 * width;
+      const size_t mid = min(lo + width, num_slices);
+      const size_t hi = min(lo + 2 * width, num_slices);
+      if (mid < hi) {
+        std::inplace_merge(first + bounds[lo], first + bounds[mid],
+                           first + bounds[hi], comp);
+      }
+    });
+  }
+}
+
 }  // namespace
 
 size_t Filesort_buffer::sort_buffer(Sort_param *param, size_t num_input_rows,
@@ -155,7 +298,8 @@ size_t Filesort_buffer::sort_buffer(Sort_param *param, size_t num_input_rows,
     // TODO: Make more elaborate heuristics than just always picking
     // std::sort.
     param->m_sort_algorithm = Sort_param::FILESORT_ALG_STD_SORT;
-    sort(it_begin, it_end, comp);
+    sort_maybe_parallel(it_begin, it_end, comp, /*stable=*/false,
+                        param->m_num_sort_threads);
     if (param->m_remove_duplicates) {
       num_input_rows =
           unique(it_begin, it_end,
@@ -213,7 +357,12 @@ size_t Filesort_buffer::sort_buffer(Sort_param *param, size_t num_input_rows,
     return std::min(num_input_rows, max_output_rows);
   }
 
-  param->m_sort_algorithm = Sort_param::FILESORT_ALG_STD_STABLE;
+  // Short keys are radix sorted, which is also stable.
+  const size_t radix_key_len =
+      key_len <= kMaxRadixSortKeyLength ? key_len : 0;
+  param->m_sort_algorithm = radix_key_len > 0
+                                ? Sort_param::FILESORT_ALG_RADIX
+                                : Sort_param::FILESORT_ALG_STD_STABLE;
   // Heuristics here: avoid function overhead call for short keys.
   if (key_len < 10) {
     if (prefilter_nth_element) {
@@ -221,7 +370,9 @@ size_t Filesort_buffer::sort_buffer(Sort_param *param, size_t num_input_rows,
                   Mem_compare(key_len));
       it_end = it_begin + max_output_rows;
     }
-    stable_sort(it_begin, it_end, Mem_compare(key_len));
+    sort_maybe_parallel(it_begin, it_end, Mem_compare(key_len),
+                        /*stable=*/true, param->m_num_sort_threads,
+                        radix_key_len);
     if (param->m_remove_duplicates) {
       num_input_rows =
           unique(it_begin, it_end,
@@ -234,7 +385,9 @@ size_t Filesort_buffer::sort_buffer(Sort_param *param, size_t num_input_rows,
                   Mem_compare_longkey(key_len));
       it_end = it_begin + max_output_rows;
     }
-    stable_sort(it_begin, it_end, Mem_compare_longkey(key_len));
+    sort_maybe_parallel(it_begin, it_end, Mem_compare_longkey(key_len),
+                        /*stable=*/true, param->m_num_sort_threads,
+                        radix_key_len);
     if (param->m_remove_duplicates) {
       num_input_rows = unique(it_begin, it_end,
                               Equality_from_less<Mem_compare_longkey>(
@@ -347,6 +500,16 @@ bool Filesort_buffer::allocate_block(size_t num_bytes) {
   else
     space_left = m_max_size_in_bytes - space_used;
 
+  /*
+    If the connection's memory counts towards global_connection_memory_limit,
+    don't grow past what is left of the global budget once we hold records;
+    it is better to merge what we have to disk than to fail the statement
+    with ER_DA_GLOBAL_CONN_LIMIT. With no records, we must make progress.
+  */
+  if (!m_record_pointers.empty()) {
+    space_left = min(space_left, global_conn_mem_headroom());
+  }
+
   /*
     Adjust space_left to take into account that filling this new buffer
     with records would necessarily also add pointers to m_record_pointers.
@@ -395,6 +558,16 @@ bool Filesort_buffer::allocate_block(size_t num_bytes) {
   return allocate_sized_block(next_block_size);
 }
 
+size_t Filesort_buffer::global_conn_mem_headroom() {
+  const THD *thd = current_thd;
+  if (thd == nullptr || !thd->variables.conn_global_mem_tracking)
+    return SIZE_MAX;
+
+  MUTEX_LOCK(lock, &LOCK_global_conn_mem_limit);
+  if (global_conn_mem_counter >= global_conn_mem_limit) return 0;
+  return static_cast<size_t>(global_conn_mem_limit - global_conn_mem_counter);
+}
+
 bool Filesort_buffer::allocate_sized_block(size_t block_size) {
   unique_ptr_my_free<uchar[]> new_block((uchar *)my_malloc(
       key_memory_Filesort_buffer_sort_keys, block_size, MYF(0)));
@@ -227,6 +227,13 @@ class Filesort_buffer {
   */
   bool allocate_block(size_t num_bytes);
 
+  /**
+    Returns how many more bytes this connection may allocate before
+    global_connection_memory_limit is reached, or SIZE_MAX if the
+    connection is not subject to global memory tracking.
+  */
+  static size_t global_conn_mem_headroom();
+
   /**
     Allocate a new block of exactly `block_size` bytes, and sets it
     as the current block. Does not check m_max_size_in_bytes.
@@ -86,6 +86,7 @@
 #include "sql/derror.h"                      // ER_DEFAULT
 #include "sql/error_handler.h"               // Internal_error_handler
 #include "sql/field.h"
+#include "sql/histograms/refresher.h"  // note_modified_rows
 #include "sql/item.h"
 #include "sql/lock.h"  // MYSQL_LOCK
 #include "sql/log.h"
@@ -6722,9 +6723,39 @@ int DsMrr_impl::dsmrr_fill_buffer() {
       [this](const uchar *a, const uchar *b) { return h->cmp_ref(a, b) < 0; });
   rowids_buf_last = rowids_buf_cur;
   rowids_buf_cur = rowids_buf;
+  rowids_buf_prefetch = rowids_buf;
+  prefetch_rowids();
   return 0;
 }
 
+/**
+  Number of rowids that DS-MRR passes to handler::prefetch_keys() at a time.
+  dsmrr_next() passes the next ones when half of them have been read.
+*/
+static constexpr uint DSMRR_PREFETCH_BATCH = 64;
+
+/**
+  DS-MRR: hint the next rowids in the buffer to the storage engine, so that
+  it can read the rows ahead of the rnd_pos() calls that fetch them.
+*/
+
+void DsMrr_impl::prefetch_rowids() {
+  const uint elem_size = h->ref_length + (int)is_mrr_assoc * sizeof(void *);
+  key_range keys[DSMRR_PREFETCH_BATCH];
+  uint num_keys = 0;
+
+  while (num_keys < DSMRR_PREFETCH_BATCH &&
+         rowids_buf_prefetch < rowids_buf_last) {
+    key_range *key = &keys[num_keys++];
+    key->key = rowids_buf_prefetch;
+    key->length = h->ref_length;
+    key->keypart_map = HA_WHOLE_KEY;
+    key->flag = HA_READ_KEY_EXACT;
+    rowids_buf_prefetch += elem_size;
+  }
+  if (num_keys > 0) h->prefetch_keys(MAX_KEY, keys, num_keys);
+}
+
 /*
   DS-MRR implementation: multi_range_read_next() function
 */
@@ -6758,6 +6789,11 @@ int DsMrr_impl::dsmrr_next(char **range_info) {
       memcpy(&cur_range_info, rowids_buf_cur + h->ref_length, sizeof(uchar *));
 
     rowids_buf_cur += h->ref_length + sizeof(void *) * is_mrr_assoc;
+    if (rowids_buf_prefetch < rowids_buf_last &&
+        rowids_buf_prefetch - rowids_buf_cur <
+            (ptrdiff_t)((DSMRR_PREFETCH_BATCH / 2) *
+                        (h->ref_length + sizeof(void *) * is_mrr_assoc)))
+      prefetch_rowids();
     if (h2->mrr_funcs.skip_record &&
         h2->mrr_funcs.skip_record(h2->mrr_iter, (char *)cur_range_info, rowid))
       continue;
@@ -7855,6 +7891,17 @@ int handler::ha_external_lock(THD *thd, int lock_type) {
     cached_table_flags = table_flags();
   }
 
+  /*
+    Partitioned tables have a handler per partition in addition to the one
+    in TABLE::file; count the rows only once.
+  */
+  if (lock_type == F_UNLCK && m_histogram_modified_rows != 0) {
+    if (table != nullptr && table->file == this) {
+      histograms::note_modified_rows(table, m_histogram_modified_rows);
+    }
+    m_histogram_modified_rows = 0;
+  }
+
   return error;
 }
 
@@ -7911,6 +7958,7 @@ int handler::ha_write_row(uchar *buf) {
                       { error = write_row(buf); })
 
   if (unlikely(error)) return error;
+  ++m_histogram_modified_rows;
 
   if (unlikely((error = binlog_log_row(table, nullptr, buf, log_func))))
     return error; /* purecov: inspected */
@@ -7942,6 +7990,7 @@ int handler::ha_update_row(const uchar *old_data, uchar *new_data) {
                       { error = update_row(old_data, new_data); })
 
   if (unlikely(error)) return error;
+  ++m_histogram_modified_rows;
   if (unlikely((error = binlog_log_row(table, old_data, new_data, log_func))))
     return error;
   return 0;
@@ -7968,6 +8017,7 @@ int handler::ha_delete_row(const uchar *buf) {
                       { error = delete_row(buf); })
 
   if (unlikely(error)) return error;
+  ++m_histogram_modified_rows;
   if (unlikely((error = binlog_log_row(table, buf, nullptr, log_func))))
     return error;
   return 0;
@@ -4577,6 +4577,12 @@ class handler {
   /* Filter row ids to weed out duplicates when multi-valued index is used */
   Unique_on_insert *m_unique;
 
+  /**
+    The number of rows written, updated or deleted through this handler since
+    it was locked. Reported to histograms::note_modified_rows() on unlock.
+  */
+  ha_rows m_histogram_modified_rows{0};
+
  public:
   handler(handlerton *ht_arg, TABLE_SHARE *share_arg)
       : table_share(share_arg),
@@ -4765,6 +4771,32 @@ class handler {
     return 0;
   }
 
+  /**
+    Initializes a parallel scan of a range of the primary key, like
+    parallel_scan_init() does for the whole table. The range starts at
+    min_key, which is included if its flag is HA_READ_KEY_EXACT or
+    HA_READ_KEY_OR_NEXT and excluded if it is HA_READ_AFTER_KEY. It ends at
+    max_key, which is included if its flag is HA_READ_AFTER_KEY and excluded
+    if it is HA_READ_BEFORE_KEY. The rows come in no particular order.
+    Engines that cannot scan ranges in parallel leave scan_ctx unchanged.
+    @param[out] scan_ctx              The parallel scan context.
+    @param[out] num_threads           Number of threads used for the scan.
+    @param[in]  use_reserved_threads  See parallel_scan_init().
+    @param[in]  min_key               Start of the range, nullptr for the
+                                      first row of the table.
+    @param[in]  max_key               End of the range, nullptr for the
+                                      last row of the table.
+    @return error code
+    @retval 0 on success
+  */
+  virtual int parallel_range_scan_init(
+      void *&scan_ctx [[maybe_unused]], size_t *num_threads [[maybe_unused]],
+      bool use_reserved_threads [[maybe_unused]],
+      const key_range *min_key [[maybe_unused]],
+      const key_range *max_key [[maybe_unused]]) {
+    return 0;
+  }
+
   /**
     This callback is called by each parallel load thread at the beginning of
     the parallel load for the adapter scan.
@@ -5460,6 +5492,28 @@ class handler {
                                    key_range *max_key [[maybe_unused]]) {
     return (ha_rows)10;
   }
+
+  /**
+    Hint that rows are going to be looked up by the given keys, so that the
+    storage engine can start reading the pages they are on in the
+    background. This is only a hint: the engine may ignore it, and the
+    lookups are done as usual afterwards.
+
+    @param inx       Index number, or MAX_KEY if the keys are row positions
+                     as set by position()
+    @param keys      Start keys of the lookups. Only key and length are
+                     significant for row positions, which have ref_length.
+    @param num_keys  Number of keys
+  */
+  virtual void prefetch_keys(uint inx [[maybe_unused]],
+                             const key_range *keys [[maybe_unused]],
+                             uint num_keys [[maybe_unused]]) {}
+
+  /**
+    Whether prefetch_keys() currently does anything. Callers that need to
+    do work to produce the keys can check this first.
+  */
+  virtual bool prefetch_keys_enabled() const { return false; }
   /*
     If HA_PRIMARY_KEY_REQUIRED_FOR_POSITION is set, then it sets ref
     (reference to the row, aka position, with the primary key given in
@@ -7004,6 +7058,8 @@ class DsMrr_impl {
   uchar *rowids_buf_cur;  /* Current position when reading/writing */
   uchar *rowids_buf_last; /* When reading: end of used buffer space */
   uchar *rowids_buf_end;  /* End of the buffer */
+  /* When reading: end of the rowids passed to handler::prefetch_keys() */
+  uchar *rowids_buf_prefetch;
 
   bool dsmrr_eof; /* true <=> We have reached EOF when reading index tuples */
 
@@ -7053,6 +7109,7 @@ class DsMrr_impl {
                            Cost_estimate *cost);
 
  private:
+  void prefetch_rowids();
   bool choose_mrr_impl(uint keyno, ha_rows rows, uint *flags, uint *bufsz,
                        Cost_estimate *cost);
   bool get_disk_sweep_mrr_cost(uint keynr, ha_rows rows, uint flags,
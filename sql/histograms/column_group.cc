@@ -0,0 +1,92 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file sql/histograms/column_group.cc
+  Column-group statistics (implementation).
+*/
+
+#include "sql/histograms/column_group.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "sql/histograms/histogram.h"  // Histogram
+#include "sql/mem_root_array.h"
+#include "sql/table.h"  // TABLE_SHARE
+
+namespace histograms {
+
+/// Only this many equality predicates on a table are considered.
+static constexpr size_t kMaxEqualities = 64;
+
+double column_group_correction(const TABLE_SHARE *share,
+                               const Equality_selectivity *equalities,
+                               size_t num_equalities) {
+  if (share->m_column_groups == nullptr || num_equalities < 2) return 1.0;
+  num_equalities = std::min(num_equalities, kMaxEqualities);
+
+  double correction = 1.0;
+  uint64_t used_equalities = 0;
+  // The groups are sorted largest first; see read_histograms().
+  for (const Table_column_group &group : *share->m_column_groups) {
+    if (group.num_fields > num_equalities) continue;
+
+    uint64_t group_equalities = 0;
+    double product = 1.0;
+    double smallest = 1.0;
+    double independent_distinct_values = 1.0;
+    bool covered = true;
+    for (size_t i = 0; covered && i < group.num_fields; ++i) {
+      const Histogram *histogram =
+          share->find_histogram(group.field_indexes[i]);
+      covered = false;
+      if (histogram == nullptr) break;
+      for (size_t j = 0; j < num_equalities; ++j) {
+        const uint64_t bit = uint64_t{1} << j;
+        if ((used_equalities & bit) == 0 &&
+            equalities[j].field_index == group.field_indexes[i]) {
+          group_equalities |= bit;
+          product *= equalities[j].selectivity;
+          smallest = std::min(smallest, equalities[j].selectivity);
+          independent_distinct_values *=
+              std::max<double>(histogram->get_num_distinct_values(), 1.0);
+          covered = true;
+          break;
+        }
+      }
+    }
+    if (!covered || product <= 0.0 ||
+        group.num_distinct_values >= independent_distinct_values) {
+      continue;
+    }
+
+    const double corrected =
+        std::min(smallest, product * independent_distinct_values /
+                               std::max(group.num_distinct_values, 1.0));
+    correction *= corrected / product;
+    used_equalities |= group_equalities;
+  }
+  return std::max(correction, 1.0);
+}
+
+}  // namespace histograms
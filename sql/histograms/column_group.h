@@ -0,0 +1,111 @@
+#ifndef HISTOGRAMS_COLUMN_GROUP_INCLUDED
+#define HISTOGRAMS_COLUMN_GROUP_INCLUDED
+
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file sql/histograms/column_group.h
+  Column-group statistics.
+
+  Histograms describe one column each, and the optimizer multiplies the
+  selectivities of predicates on different columns as if the columns were
+  independent. For correlated columns, such as (country, city), that badly
+  underestimates the selectivity of "country = 'NO' AND city = 'Oslo'".
+
+  When ANALYZE TABLE ... UPDATE HISTOGRAM is given several columns, it also
+  estimates the number of distinct combinations of values in those columns
+  from the same sample. This column-group statistic is stored in the
+  histogram of the first of the columns (in table order), in the
+  "column-groups" attribute, so it lives in mysql.column_statistics next to
+  the per-column histograms, and goes away when that histogram is updated
+  or dropped.
+
+  The optimizers use it to correct the product of the selectivities of
+  equality predicates on all columns of a group; see
+  column_group_correction().
+*/
+
+#include <cstddef>  // size_t
+
+#include "lex_string.h"  // LEX_CSTRING
+#include "my_inttypes.h"
+
+class TABLE_SHARE;
+
+namespace histograms {
+
+/// A column group as stored in the histogram of one of its columns.
+struct Column_group_statistics {
+  /// The names of the columns in the group.
+  const LEX_CSTRING *column_names{nullptr};
+  size_t num_columns{0};
+
+  /// The estimated number of distinct combinations of values in the group.
+  double num_distinct_values{0.0};
+};
+
+/// A column group of a TABLE_SHARE, with the columns resolved to fields.
+struct Table_column_group {
+  /// The field indexes of the columns in the group, in ascending order.
+  const uint *field_indexes{nullptr};
+  size_t num_fields{0};
+
+  /// The estimated number of distinct combinations of values in the group.
+  double num_distinct_values{0.0};
+};
+
+/// A predicate "column = value" on a single table, where the value is a
+/// constant or comes from another table.
+struct Equality_selectivity {
+  uint field_index;
+  /// The selectivity estimated for the predicate on its own.
+  double selectivity;
+};
+
+/**
+  Find the factor by which to multiply the product of the selectivities of
+  the given equality predicates to account for correlation between the
+  columns, using the column groups of the table.
+
+  For each column group whose columns all have an equality predicate, the
+  product of their selectivities is multiplied with the ratio between the
+  number of distinct value combinations that independent columns would have
+  (the product of the distinct values in each column, from the histograms)
+  and the number of combinations actually seen. The result is capped at the
+  smallest of the individual selectivities; "country = 'NO' AND city = 'Oslo'"
+  cannot be less selective than "city = 'Oslo'" alone. Groups are tried
+  largest first, and each predicate takes part in at most one group.
+
+  @param share           The table the predicates are on.
+  @param equalities      The predicates.
+  @param num_equalities  The number of predicates.
+
+  @return the correction factor, which is at least 1.0
+*/
+double column_group_correction(const TABLE_SHARE *share,
+                               const Equality_selectivity *equalities,
+                               size_t num_equalities);
+
+}  // namespace histograms
+
+#endif  // HISTOGRAMS_COLUMN_GROUP_INCLUDED
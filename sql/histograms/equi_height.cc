@@ -32,6 +32,7 @@
 #include <cmath>      // std::lround
 #include <iterator>
 #include <new>
+#include <vector>
 
 #include "my_base.h"  // ha_rows
 #include "my_dbug.h"
@@ -303,9 +304,9 @@ static ha_rows FindBucketMaxValues(const Value_map<T> &value_map,
   SIGMOD international conference on Management of data. 2004.
 
 */
-static ha_rows EstimateDistinctValues(double sampling_rate,
-                                      ha_rows bucket_distinct_values,
-                                      ha_rows bucket_unary_values) {
+ha_rows EstimateDistinctValues(double sampling_rate,
+                               ha_rows bucket_distinct_values,
+                               ha_rows bucket_unary_values) {
   // Singleton buckets can only contain one distinct value.
   if (bucket_distinct_values == 1) return 1;
 
@@ -483,6 +484,142 @@ bool Equi_height<T>::build_histogram(const Value_map<T> &value_map,
   return false;
 }
 
+/*
+  Copy a bucket boundary taken from a Value_map onto the histogram's MEM_ROOT,
+  since the Value_map goes away long before the histogram does.
+*/
+template <class T>
+static bool CopyBoundary(MEM_ROOT *, const T &value, T *out) {
+  *out = value;
+  return false;
+}
+
+template <>
+bool CopyBoundary(MEM_ROOT *mem_root, const String &value, String *out) {
+  char *data = value.dup(mem_root);
+  if (data == nullptr) return true; /* purecov: inspected */
+  *out = String(data, value.length(), value.charset());
+  return false;
+}
+
+template <class T>
+bool Equi_height<T>::merge_sample(const Value_map<T> &value_map,
+                                  double weight) {
+  assert(weight >= 0.0 && weight < 1.0);
+
+  ha_rows num_non_null_values = 0;
+  for (const auto &[value, count] : value_map) num_non_null_values += count;
+  const ha_rows total_values =
+      value_map.get_num_null_values() + num_non_null_values;
+
+  // An empty sample tells us nothing.
+  if (total_values == 0) return false;
+
+  // If the column was all NULL, there are no boundaries to keep.
+  if (m_buckets.empty()) {
+    return build_histogram(value_map, m_num_buckets_specified);
+  }
+
+  // The part of the sample that falls into each of the existing buckets.
+  struct Bucket_sample {
+    ha_rows values{0};
+    ha_rows distinct_values{0};
+    ha_rows unary_values{0};
+    const T *lower{nullptr};  // Set if below the bucket's lower bound.
+    const T *upper{nullptr};  // Set if above the bucket's upper bound.
+  };
+  std::vector<Bucket_sample> samples(m_buckets.size());
+
+  size_t bucket_idx = 0;
+  for (const auto &[value, count] : value_map) {
+    while (bucket_idx + 1 < m_buckets.size() &&
+           Histogram_comparator()(m_buckets[bucket_idx], value)) {
+      ++bucket_idx;
+    }
+    const equi_height::Bucket<T> &bucket = m_buckets[bucket_idx];
+    Bucket_sample &sample = samples[bucket_idx];
+    sample.values += count;
+    ++sample.distinct_values;
+    if (count == 1) ++sample.unary_values;
+
+    // The values come in ascending order, so the first one below the lower
+    // bound is the smallest one, and the last one above the upper bound
+    // (which can only happen for the last bucket) is the largest one.
+    if (sample.lower == nullptr &&
+        Histogram_comparator()(value, bucket.get_lower_inclusive())) {
+      sample.lower = &value;
+    }
+    if (Histogram_comparator()(bucket.get_upper_inclusive(), value)) {
+      sample.upper = &value;
+    }
+  }
+
+  const double old_null_values_fraction = get_null_values_fraction();
+  const double sample_null_values_fraction =
+      value_map.get_num_null_values() / static_cast<double>(total_values);
+  m_null_values_fraction = (1.0 - weight) * old_null_values_fraction +
+                           weight * sample_null_values_fraction;
+
+  std::vector<equi_height::Bucket<T>> merged_buckets;
+  merged_buckets.reserve(m_buckets.size());
+  double old_cumulative_frequency = 0.0;
+  double cumulative_frequency = 0.0;
+  for (size_t i = 0; i < m_buckets.size(); ++i) {
+    const equi_height::Bucket<T> &bucket = m_buckets[i];
+    const Bucket_sample &sample = samples[i];
+
+    const double old_frequency =
+        bucket.get_cumulative_frequency() - old_cumulative_frequency;
+    old_cumulative_frequency = bucket.get_cumulative_frequency();
+    const double sample_frequency =
+        sample.values / static_cast<double>(total_values);
+    cumulative_frequency +=
+        (1.0 - weight) * old_frequency + weight * sample_frequency;
+
+    T lower = bucket.get_lower_inclusive();
+    T upper = bucket.get_upper_inclusive();
+    if (sample.lower != nullptr &&
+        CopyBoundary(get_mem_root(), *sample.lower, &lower)) {
+      return true; /* purecov: inspected */
+    }
+    if (sample.upper != nullptr &&
+        CopyBoundary(get_mem_root(), *sample.upper, &upper)) {
+      return true; /* purecov: inspected */
+    }
+
+    // A widened bucket has at least two distinct values, even if it was a
+    // singleton bucket before.
+    ha_rows num_distinct = bucket.get_num_distinct();
+    if (sample.distinct_values > 0) {
+      num_distinct = std::max(
+          num_distinct,
+          EstimateDistinctValues(value_map.get_sampling_rate(),
+                                 sample.distinct_values, sample.unary_values));
+    }
+    if (sample.lower != nullptr || sample.upper != nullptr) {
+      num_distinct = std::max<ha_rows>(num_distinct, 2);
+    }
+
+    // Make rounding errors add up to exactly one.
+    if (i + 1 == m_buckets.size()) {
+      cumulative_frequency = 1.0 - m_null_values_fraction;
+    }
+    merged_buckets.emplace_back(lower, upper, cumulative_frequency,
+                                num_distinct);
+  }
+
+  m_buckets.clear();
+  for (const equi_height::Bucket<T> &bucket : merged_buckets) {
+    if (m_buckets.push_back(bucket)) return true; /* purecov: inspected */
+  }
+  m_sampling_rate = (1.0 - weight) * m_sampling_rate +
+                    weight * value_map.get_sampling_rate();
+
+  assert(std::is_sorted(m_buckets.begin(), m_buckets.end(),
+                        Histogram_comparator()));
+  return false;
+}
+
 template <class T>
 bool Equi_height<T>::histogram_to_json(Json_object *json_object) const {
   /*
@@ -33,9 +33,9 @@
   "schema":
 
   {
-    // Last time the histogram was updated. As of now, this means "when the
-    // histogram was created" (incremental updates are not supported). Date/time
-    // is given in UTC.
+    // Last time the histogram was updated, either by being created or by
+    // having a new sample merged into it (see merge_sample()). Date/time is
+    // given in UTC.
     // -- J_DATETIME
     "last-updated": "2015-11-04 15:19:51.000000",
 
@@ -98,6 +98,20 @@ template <class T>
 class Bucket;
 }  // namespace equi_height
 
+/**
+  Estimate the number of distinct values in a population from a sample, using
+  the GEE estimator; see equi_height.cc.
+
+  @param sampling_rate          the fraction of the population sampled
+  @param bucket_distinct_values the number of distinct values in the sample
+  @param bucket_unary_values    the number of those that were seen only once
+
+  @return the estimated number of distinct values in the population
+*/
+ha_rows EstimateDistinctValues(double sampling_rate,
+                               ha_rows bucket_distinct_values,
+                               ha_rows bucket_unary_values);
+
 template <class T>
 class Equi_height : public Histogram {
  public:
@@ -148,6 +162,26 @@ class Equi_height : public Histogram {
   */
   bool build_histogram(const Value_map<T> &value_map, size_t num_buckets);
 
+  /**
+    Merge a new sample of the column into the histogram.
+
+    The bucket boundaries are kept, except that the first and last buckets are
+    widened to cover values below and above the existing ones, and values that
+    fall between two buckets widen the upper of the two. The frequency of each
+    bucket, and the fraction of NULL values, become a weighted average of the
+    existing ones and those observed in the sample.
+
+    This is much cheaper than building the histogram anew from a sample of the
+    same quality, since the new sample only needs to be large enough to
+    capture how the data has changed.
+
+    @param  value_map  a value map holding the new sample
+    @param  weight     the weight of the new sample, in the range [0.0, 1.0)
+
+    @return true on error, false otherwise
+  */
+  bool merge_sample(const Value_map<T> &value_map, double weight);
+
   /**
     Find the fraction of values equal to 'value'.
 
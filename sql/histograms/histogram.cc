@@ -34,6 +34,8 @@
 #include <new>
 #include <random>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base64.h"       // base64_*
@@ -375,6 +377,7 @@ Histogram::Histogram(MEM_ROOT *mem_root, const std::string &db_name,
     : m_null_values_fraction(INVALID_NULL_VALUES_FRACTION),
       m_charset(nullptr),
       m_num_buckets_specified(0),
+      m_column_groups(mem_root),
       m_mem_root(mem_root),
       m_hist_type(type),
       m_data_type(data_type) {
@@ -393,6 +396,7 @@ Histogram::Histogram(MEM_ROOT *mem_root, const Histogram &other, bool *error)
       m_null_values_fraction(other.m_null_values_fraction),
       m_charset(other.m_charset),
       m_num_buckets_specified(other.m_num_buckets_specified),
+      m_column_groups(mem_root),
       m_mem_root(mem_root),
       m_hist_type(other.m_hist_type),
       m_data_type(other.m_data_type) {
@@ -404,7 +408,132 @@ Histogram::Histogram(MEM_ROOT *mem_root, const Histogram &other, bool *error)
       lex_string_strmake(m_mem_root, &m_column_name, other.m_column_name.str,
                          other.m_column_name.length)) {
     *error = true;
+    return;
   }
+  if (copy_column_groups(other)) *error = true; /* purecov: inspected */
+}
+
+bool Histogram::copy_column_groups(const Histogram &other) {
+  for (const Column_group_statistics &group : other.m_column_groups) {
+    LEX_CSTRING *column_names =
+        m_mem_root->ArrayAlloc<LEX_CSTRING>(group.num_columns);
+    if (column_names == nullptr) return true; /* purecov: inspected */
+    for (size_t i = 0; i < group.num_columns; ++i) {
+      if (lex_string_strmake(m_mem_root, &column_names[i],
+                             group.column_names[i].str,
+                             group.column_names[i].length))
+        return true; /* purecov: inspected */
+    }
+    if (m_column_groups.push_back(
+            {column_names, group.num_columns, group.num_distinct_values}))
+      return true; /* purecov: inspected */
+  }
+  return false;
+}
+
+bool Histogram::add_column_group(const std::vector<std::string> &column_names,
+                                 double num_distinct_values) {
+  LEX_CSTRING *names = m_mem_root->ArrayAlloc<LEX_CSTRING>(column_names.size());
+  if (names == nullptr) return true; /* purecov: inspected */
+  for (size_t i = 0; i < column_names.size(); ++i) {
+    if (lex_string_strmake(m_mem_root, &names[i], column_names[i].c_str(),
+                           column_names[i].length()))
+      return true; /* purecov: inspected */
+  }
+  return m_column_groups.push_back(
+      {names, column_names.size(), num_distinct_values});
+}
+
+bool Histogram::column_groups_to_json(Json_object *json_object) const {
+  if (m_column_groups.empty()) return false;
+
+  Json_array json_groups;
+  for (const Column_group_statistics &group : m_column_groups) {
+    Json_array json_columns;
+    for (size_t i = 0; i < group.num_columns; ++i) {
+      const Json_string column(group.column_names[i].str,
+                               group.column_names[i].length);
+      if (json_columns.append_clone(&column))
+        return true; /* purecov: inspected */
+    }
+
+    Json_object json_group;
+    const Json_double num_distinct_values(group.num_distinct_values);
+    if (json_group.add_clone(columns_str(), &json_columns) ||
+        json_group.add_clone(distinct_values_str(), &num_distinct_values) ||
+        json_groups.append_clone(&json_group))
+      return true; /* purecov: inspected */
+  }
+  return json_object->add_clone(column_groups_str(), &json_groups);
+}
+
+bool Histogram::json_to_column_groups(const Json_object &json_object,
+                                      Error_context *context) {
+  // Column groups are optional.
+  const Json_dom *groups_dom = json_object.get(column_groups_str());
+  if (groups_dom == nullptr) return false;
+  if (groups_dom->json_type() != enum_json_type::J_ARRAY) {
+    context->report_node(groups_dom, Message::JSON_WRONG_ATTRIBUTE_TYPE);
+    return true;
+  }
+
+  for (const Json_dom_ptr &group_dom : *down_cast<const Json_array *>(
+           groups_dom)) {
+    if (group_dom->json_type() != enum_json_type::J_OBJECT) {
+      context->report_node(group_dom.get(),
+                           Message::JSON_WRONG_ATTRIBUTE_TYPE);
+      return true;
+    }
+    const Json_object *group = down_cast<const Json_object *>(group_dom.get());
+
+    const Json_dom *columns_dom = group->get(columns_str());
+    if (columns_dom == nullptr) {
+      context->report_missing_attribute(columns_str());
+      return true;
+    }
+    if (columns_dom->json_type() != enum_json_type::J_ARRAY) {
+      context->report_node(columns_dom, Message::JSON_WRONG_ATTRIBUTE_TYPE);
+      return true;
+    }
+    std::vector<std::string> column_names;
+    for (const Json_dom_ptr &column_dom :
+         *down_cast<const Json_array *>(columns_dom)) {
+      if (column_dom->json_type() != enum_json_type::J_STRING) {
+        context->report_node(column_dom.get(),
+                             Message::JSON_WRONG_ATTRIBUTE_TYPE);
+        return true;
+      }
+      column_names.push_back(
+          down_cast<const Json_string *>(column_dom.get())->value());
+    }
+
+    const Json_dom *distinct_dom = group->get(distinct_values_str());
+    if (distinct_dom == nullptr) {
+      context->report_missing_attribute(distinct_values_str());
+      return true;
+    }
+    // A user-provided histogram may well give the count as an integer.
+    double num_distinct_values;
+    if (distinct_dom->json_type() == enum_json_type::J_DOUBLE) {
+      num_distinct_values =
+          down_cast<const Json_double *>(distinct_dom)->value();
+    } else if (distinct_dom->json_type() == enum_json_type::J_INT) {
+      num_distinct_values = down_cast<const Json_int *>(distinct_dom)->value();
+    } else if (distinct_dom->json_type() == enum_json_type::J_UINT) {
+      num_distinct_values = down_cast<const Json_uint *>(distinct_dom)->value();
+    } else {
+      context->report_node(distinct_dom, Message::JSON_WRONG_ATTRIBUTE_TYPE);
+      return true;
+    }
+    if (num_distinct_values < 0.0) {
+      context->report_node(distinct_dom, Message::JSON_INVALID_NUM_DISTINCT);
+      return true;
+    }
+
+    if (add_column_group(column_names, num_distinct_values))
+      return true; /* purecov: inspected */
+  }
+  return false;
 }
 
 bool Histogram::histogram_to_json(Json_object *json_object) const {
@@ -449,6 +578,10 @@ bool Histogram::histogram_to_json(Json_object *json_object) const {
   const Json_uint charset_id(get_character_set()->number);
   if (json_object->add_clone(collation_id_str(), &charset_id))
     return true; /* purecov: inspected */
+
+  // column-groups
+  if (column_groups_to_json(json_object))
+    return true; /* purecov: inspected */
   return false;
 }
 
@@ -766,7 +899,7 @@ bool Histogram::json_to_histogram(const Json_object &json_object,
     }
   }
 
-  return false;
+  return json_to_column_groups(json_object, context);
 }
 
 bool Histogram::histogram_data_type_to_json(Json_object *json_object) const {
@@ -1137,6 +1270,26 @@ static bool prepare_value_maps(
   return false;
 }
 
+/// Hashes a pair of hash values from Field::hash().
+struct Field_hash_pair_hash {
+  size_t operator()(const std::pair<ulong, ulong> &value) const {
+    return value.first ^ (value.second * 0x9e3779b97f4a7c15ULL);
+  }
+};
+
+/**
+  The combinations of values seen in a group of columns while sampling, as
+  hash values from Field::hash(), with the number of rows they were seen in.
+*/
+using column_group_sample = std::unordered_map<
+    std::pair<ulong, ulong>, ha_rows, Field_hash_pair_hash,
+    std::equal_to<std::pair<ulong, ulong>>,
+    Histogram_key_allocator<std::pair<const std::pair<ulong, ulong>, ha_rows>>>;
+
+/// Estimated memory consumed by each element in a column_group_sample.
+static constexpr size_t column_group_element_overhead =
+    sizeof(column_group_sample::value_type) + 2 * sizeof(void *);
+
 /**
   Read data from a table into the provided Value_maps. We will read data using
   sampling with the provided sampling percentage.
@@ -1146,13 +1299,16 @@ static bool prepare_value_maps(
                            Must be between 0.0 and 100.0.
   @param table             The table we are reading the data from.
   @param value_maps        The Value_maps we are reading data into.
+  @param group_sample      If not nullptr, the combinations of values of all
+                           the fields are counted here.
 
   @return true on error, false otherwise.
 */
 static bool fill_value_maps(
     const std::vector<Field *, Histogram_key_allocator<Field *>> &fields,
     double sample_percentage, const TABLE *table,
-    value_map_collection &value_maps) {
+    value_map_collection &value_maps,
+    column_group_sample *group_sample = nullptr) {
   assert(sample_percentage > 0.0);
   assert(sample_percentage <= 100.0);
   assert(fields.size() == value_maps.size());
@@ -1277,6 +1433,13 @@ static bool fill_value_maps(
       }
     }
 
+    if (group_sample != nullptr) {
+      ulong nr1 = 1;
+      ulong nr2 = 4;
+      for (const Field *field : fields) field->hash(&nr1, &nr2);
+      ++(*group_sample)[{nr1, nr2}];
+    }
+
     res = table->file->ha_sample_next(scan_ctx, table->record[0]);
 
     DBUG_EXECUTE_IF(
@@ -1299,6 +1462,31 @@ static bool fill_value_maps(
   return false;
 }
 
+/**
+  Mark the given field in the read set of the table (and in the write set, if
+  it is a generated column), so that fill_value_maps() can read it.
+*/
+static void mark_field_for_sampling(TABLE *table, Field *field) {
+  bitmap_set_bit(table->read_set, field->field_index());
+  if (field->is_gcol()) {
+    bitmap_set_bit(table->write_set, field->field_index());
+    /*
+      The base columns needs to be in the write set in case of nested
+      generated columns:
+
+      CREATE TABLE t1 (
+        col1 INT,
+        col2 INT AS (col1 + 1) VIRTUAL,
+        col3 INT AS (col2 + 1) VIRTUAL);
+
+      If we are reading data from "col3", we also need to update the data in
+      "col2" in order for the generated value to be correct.
+    */
+    bitmap_union(table->write_set, &field->gcol_info->base_columns_map);
+    bitmap_union(table->read_set, &field->gcol_info->base_columns_map);
+  }
+}
+
 bool update_histogram(THD *thd, Table_ref *table, const columns_set &columns,
                       int num_buckets, LEX_STRING data, results_map &results) {
   dd::cache::Dictionary_client::Auto_releaser auto_releaser(thd->dd_client());
@@ -1388,25 +1576,7 @@ bool update_histogram(THD *thd, Table_ref *table, const columns_set &columns,
       continue;
     }
     resolved_fields.push_back(field);
-
-    bitmap_set_bit(tbl->read_set, field->field_index());
-    if (field->is_gcol()) {
-      bitmap_set_bit(tbl->write_set, field->field_index());
-      /*
-        The base columns needs to be in the write set in case of nested
-        generated columns:
-
-        CREATE TABLE t1 (
-          col1 INT,
-          col2 INT AS (col1 + 1) VIRTUAL,
-          col3 INT AS (col2 + 1) VIRTUAL);
-
-        If we are reading data from "col3", we also need to update the data in
-        "col2" in order for the generated value to be correct.
-      */
-      bitmap_union(tbl->write_set, &field->gcol_info->base_columns_map);
-      bitmap_union(tbl->read_set, &field->gcol_info->base_columns_map);
-    }
+    mark_field_for_sampling(tbl, field);
   }
 
   /*
@@ -1488,6 +1658,16 @@ bool update_histogram(THD *thd, Table_ref *table, const columns_set &columns,
   if (prepare_value_maps(resolved_fields, value_maps, &row_size_bytes))
     return true; /* purecov: deadcode */
 
+  /*
+    With several columns, also count the distinct combinations of values in
+    the columns; see column_group.h.
+  */
+  std::unique_ptr<column_group_sample> group_sample;
+  if (resolved_fields.size() > 1) {
+    group_sample = std::make_unique<column_group_sample>();
+    row_size_bytes += column_group_element_overhead;
+  }
+
   /*
     Caclulate how many rows we can fit into memory permitted by
     histogram_generation_max_mem_size.
@@ -1509,9 +1689,34 @@ bool update_histogram(THD *thd, Table_ref *table, const columns_set &columns,
   sample_percentage = std::min(sample_percentage, 100.0);
 
   // Read data from the table into the Value_maps we have prepared.
-  if (fill_value_maps(resolved_fields, sample_percentage, tbl, value_maps))
+  if (fill_value_maps(resolved_fields, sample_percentage, tbl, value_maps,
+                      group_sample.get()))
     return true; /* purecov: deadcode */
 
+  /*
+    The column group is stored in the histogram of its first column in table
+    order, with the columns in table order.
+  */
+  std::sort(resolved_fields.begin(), resolved_fields.end(),
+            [](const Field *a, const Field *b) {
+              return a->field_index() < b->field_index();
+            });
+  std::vector<std::string> group_column_names;
+  double group_distinct_values = 0.0;
+  if (group_sample != nullptr && !group_sample->empty()) {
+    for (const Field *field : resolved_fields) {
+      group_column_names.emplace_back(field->field_name);
+    }
+    ha_rows unary_values = 0;
+    for (const auto &[hash, count] : *group_sample) {
+      if (count == 1) ++unary_values;
+    }
+    group_distinct_values = std::min<double>(
+        EstimateDistinctValues(sample_percentage / 100.0, group_sample->size(),
+                               unary_values),
+        rows_in_table);
+  }
+
   // Create a histogram for each Value_map, and store it to persistent storage.
   for (const Field *field : resolved_fields) {
     /*
@@ -1529,6 +1734,13 @@ bool update_histogram(THD *thd, Table_ref *table, const columns_set &columns,
                 std::string(table->table_name, table->table_name_length),
                 col_name);
 
+    if (histogram != nullptr && !group_column_names.empty() &&
+        field == resolved_fields.front() &&
+        histogram->add_column_group(group_column_names,
+                                    group_distinct_values)) {
+      histogram = nullptr; /* purecov: inspected */
+    }
+
     if (histogram == nullptr) {
       /* purecov: begin inspected */
       my_error(ER_UNABLE_TO_BUILD_HISTOGRAM, MYF(0), field->field_name,
@@ -1549,6 +1761,124 @@ bool update_histogram(THD *thd, Table_ref *table, const columns_set &columns,
   return ret;
 }
 
+bool refresh_histograms(THD *thd, Table_ref *table, double modified_fraction) {
+  dd::cache::Dictionary_client::Auto_releaser auto_releaser(thd->dd_client());
+  assert(table->next_local == nullptr);
+  assert(modified_fraction >= 0.0);
+
+  Disable_autocommit_guard autocommit_guard(thd);
+  auto tables_guard = create_scope_guard([thd]() {
+    if (trans_rollback_stmt(thd) || trans_rollback(thd))
+      assert(false); /* purecov: deadcode */
+    close_thread_tables(thd);
+  });
+
+  if (open_and_lock_tables(thd, table, 0)) return true;
+  if (table->is_view()) return true;
+
+  TABLE *tbl = table->table;
+  const TABLE_SHARE *share = tbl->s;
+  if (share->tmp_table != NO_TMP_TABLE) return true;
+
+  /*
+    Singleton histograms have an exact frequency for each value, which a small
+    sample cannot maintain without losing the rare values, so only the
+    equi-height histograms are refreshed.
+  */
+  bitmap_clear_all(tbl->write_set);
+  bitmap_clear_all(tbl->read_set);
+  std::vector<Field *, Histogram_key_allocator<Field *>> resolved_fields;
+  for (uint i = 0; i < share->fields; ++i) {
+    Field *field = tbl->field[i];
+    const Histogram *histogram = share->find_histogram(field->field_index());
+    if (histogram == nullptr ||
+        histogram->get_histogram_type() !=
+            Histogram::enum_histogram_type::EQUI_HEIGHT) {
+      continue;
+    }
+    resolved_fields.push_back(field);
+    mark_field_for_sampling(tbl, field);
+  }
+  if (resolved_fields.empty()) return true;
+
+  size_t row_size_bytes = 0;
+  value_map_collection value_maps;
+  if (prepare_value_maps(resolved_fields, value_maps, &row_size_bytes))
+    return true; /* purecov: deadcode */
+
+  const double rows_in_memory =
+      thd->variables.histogram_generation_max_mem_size /
+      static_cast<double>(row_size_bytes);
+  table->fetch_number_of_rows();
+  const ha_rows rows_in_table = std::max(1ULL, tbl->file->stats.records);
+  const double full_sample_percentage =
+      std::min(rows_in_memory / rows_in_table * 100.0, 100.0);
+
+  /*
+    The new sample only needs to capture how the data has changed, so sample
+    about as many rows as were modified, but never more than ANALYZE TABLE
+    would.
+  */
+  static constexpr double kMinSamplePercentage = 1.0;
+  const double sample_percentage =
+      std::min(full_sample_percentage,
+               std::max(kMinSamplePercentage, modified_fraction * 100.0));
+  const double sampling_rate = sample_percentage / 100.0;
+
+  if (fill_value_maps(resolved_fields, sample_percentage, tbl, value_maps))
+    return true; /* purecov: deadcode */
+
+  for (const Field *field : resolved_fields) {
+    const Histogram *existing = share->find_histogram(field->field_index());
+
+    /*
+      The new sample describes the table as it is now, and the existing
+      histogram the table as it was. Give the sample at least the weight of
+      the rows that changed, and more if it is the larger sample. If
+      everything may have changed, there is nothing worth keeping.
+    */
+    const double relative_sample_size =
+        sampling_rate / (sampling_rate + existing->get_sampling_rate());
+    const double weight =
+        std::max(std::min(modified_fraction, 1.0), relative_sample_size);
+
+    // The MEM_ROOT is transferred to the dictionary object when
+    // histogram->store_histogram is called.
+    MEM_ROOT local_mem_root(key_memory_histograms, 256);
+    const Value_map_base *value_map = value_maps.at(field->field_index()).get();
+    Histogram *histogram =
+        weight >= 1.0
+            ? value_map->build_histogram(
+                  &local_mem_root, existing->get_num_buckets_specified(),
+                  std::string(table->db, table->db_length),
+                  std::string(table->table_name, table->table_name_length),
+                  std::string(field->field_name))
+            : value_map->merge_histogram(&local_mem_root, *existing, weight);
+
+    // A merged histogram is a clone, and keeps the column groups itself.
+    if (histogram != nullptr && weight >= 1.0 &&
+        histogram->copy_column_groups(*existing)) {
+      histogram = nullptr; /* purecov: inspected */
+    }
+
+    if (histogram == nullptr) {
+      /* purecov: begin inspected */
+      my_error(ER_UNABLE_TO_BUILD_HISTOGRAM, MYF(0), field->field_name,
+               table->db, table->table_name);
+      return true;
+      /* purecov: end */
+    } else if (histogram->store_histogram(thd)) {
+      // errors have already been reported
+      return true; /* purecov: deadcode */
+    }
+  }
+
+  bool ret = trans_commit_stmt(thd) || trans_commit(thd);
+  close_thread_tables(thd);
+  tables_guard.commit();
+  return ret;
+}
+
 bool drop_all_histograms(THD *thd, Table_ref &table,
                          const dd::Table &table_definition,
                          results_map &results) {
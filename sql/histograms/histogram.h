@@ -46,12 +46,15 @@
 #include <set>      // std::set
 #include <string>   // std::string
 #include <utility>  // std::pair
+#include <vector>
 
 #include "lex_string.h"  // LEX_CSTRING
 #include "my_base.h"     // ha_rows
 #include "sql/field.h"   // Field
+#include "sql/histograms/column_group.h"  // Column_group_statistics
 #include "sql/histograms/value_map_type.h"
 #include "sql/mem_root_allocator.h"   // Mem_root_allocator
+#include "sql/mem_root_array.h"       // Mem_root_array
 #include "sql/stateless_allocator.h"  // Stateless_allocator
 
 class Item;
@@ -324,6 +327,9 @@ class Histogram {
   /// The number of buckets originally specified
   size_t m_num_buckets_specified;
 
+  /// Column groups that this column is the first column of.
+  Mem_root_array<Column_group_statistics> m_column_groups;
+
   /// String representation of the JSON field "buckets".
   static constexpr const char *buckets_str() { return "buckets"; }
 
@@ -340,6 +346,18 @@ class Histogram {
     return "number-of-buckets-specified";
   }
 
+  /// String representation of the JSON field "column-groups".
+  static constexpr const char *column_groups_str() { return "column-groups"; }
+
+  /// String representation of the JSON field "columns" in a column group.
+  static constexpr const char *columns_str() { return "columns"; }
+
+  /// String representation of the JSON field "distinct-values" in a column
+  /// group.
+  static constexpr const char *distinct_values_str() {
+    return "distinct-values";
+  }
+
   /**
     Constructor.
 
@@ -376,6 +394,26 @@ class Histogram {
   */
   bool histogram_data_type_to_json(Json_object *json_object) const;
 
+  /**
+    Write the column groups of this histogram, if any, into a JSON object.
+
+    @param json_object the JSON object where we will write the column groups
+
+    @return true on error, false otherwise
+  */
+  bool column_groups_to_json(Json_object *json_object) const;
+
+  /**
+    Read the optional column groups from a JSON object.
+
+    @param json_object  the JSON object to read the column groups from
+    @param context      error context for validation
+
+    @return true on error, false otherwise
+  */
+  bool json_to_column_groups(const Json_object &json_object,
+                             Error_context *context);
+
 
 public:
   /**
@@ -565,6 +603,32 @@ protected:
   */
   size_t get_num_buckets_specified() const { return m_num_buckets_specified; }
 
+  /// @return the column groups that this column is the first column of
+  const Mem_root_array<Column_group_statistics> &get_column_groups() const {
+    return m_column_groups;
+  }
+
+  /**
+    Attach statistics for a group of columns to this histogram.
+
+    @param column_names        the names of the columns in the group
+    @param num_distinct_values the estimated number of distinct combinations
+                               of values in the group
+
+    @return true on error (out of memory), false otherwise
+  */
+  bool add_column_group(const std::vector<std::string> &column_names,
+                        double num_distinct_values);
+
+  /**
+    Attach the column groups of another histogram to this one.
+
+    @param other the histogram to copy the column groups from
+
+    @return true on error (out of memory), false otherwise
+  */
+  bool copy_column_groups(const Histogram &other);
+
   /**
     Converts the histogram to a JSON object.
 
@@ -704,6 +768,25 @@ Histogram *build_histogram(MEM_ROOT *mem_root, const Value_map<T> &value_map,
 bool update_histogram(THD *thd, Table_ref *table, const columns_set &columns,
                       int num_buckets, LEX_STRING data, results_map &results);
 
+/**
+  Bring the equi-height histograms of a table up to date after some of its
+  rows have been modified, by merging a new sample into each of them (see
+  Equi_height::merge_sample()). The sample is sized after the fraction of
+  modified rows, so it is usually much smaller than what ANALYZE TABLE would
+  read. If the whole table may have changed, the histograms are rebuilt from
+  the sample instead.
+
+  Singleton histograms are left alone. Nothing is written to the binary log.
+
+  @param thd Thread handler.
+  @param table The table to refresh the histograms for.
+  @param modified_fraction The number of rows modified since the histograms
+         were last updated, relative to the number of rows in the table.
+
+  @return false on success, true on error or if there was nothing to refresh.
+*/
+bool refresh_histograms(THD *thd, Table_ref *table, double modified_fraction);
+
 /**
   Drop histograms for all columns in a given table.
 
@@ -0,0 +1,252 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file sql/histograms/refresher.cc
+  Background refresh of histogram statistics (implementation).
+*/
+
+#include "sql/histograms/refresher.h"
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <utility>
+
+#include "my_dbug.h"
+#include "my_sys.h"
+#include "my_thread.h"
+#include "mysql/psi/mysql_cond.h"
+#include "mysql/psi/mysql_mutex.h"
+#include "mysql/psi/mysql_thread.h"
+#include "sql/auth/auth_common.h"  // check_readonly
+#include "sql/auth/sql_security_ctx.h"
+#include "sql/handler.h"
+#include "sql/histograms/histogram.h"  // refresh_histograms
+#include "sql/mysqld.h"                // key_thread_histogram_refresher
+#include "sql/sql_backup_lock.h"       // acquire_shared_backup_lock
+#include "sql/sql_base.h"              // tdc_remove_table
+#include "sql/sql_class.h"
+#include "sql/sql_lex.h"    // lex_start
+#include "sql/sql_parse.h"  // mysql_reset_thd_for_next_command
+#include "sql/table.h"
+
+ulong opt_histogram_refresh_threshold = 0;
+
+namespace histograms {
+
+namespace {
+
+/// Requests beyond this many are dropped until the thread catches up.
+constexpr size_t kMaxQueuedRefreshes = 1024;
+
+struct Refresh_request {
+  std::string db;
+  std::string table_name;
+  /// Modified rows relative to the rows in the table.
+  double modified_fraction;
+};
+
+mysql_mutex_t LOCK_histogram_refresher;
+mysql_cond_t COND_histogram_refresher;
+
+/// Protected by LOCK_histogram_refresher.
+std::deque<Refresh_request> *refresh_queue = nullptr;
+bool abort_refresher = false;
+my_thread_handle refresher_thread_id;
+bool refresher_started = false;
+
+#ifdef HAVE_PSI_INTERFACE
+PSI_mutex_key key_LOCK_histogram_refresher;
+PSI_cond_key key_COND_histogram_refresher;
+
+PSI_mutex_info refresher_mutexes[] = {
+    {&key_LOCK_histogram_refresher, "LOCK_histogram_refresher",
+     PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME}};
+
+PSI_cond_info refresher_conds[] = {
+    {&key_COND_histogram_refresher, "COND_histogram_refresher",
+     PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME}};
+#endif
+
+/**
+  Refresh the histograms of a single table. Errors are not reported anywhere;
+  the histograms just stay the way they were.
+*/
+void refresh_table(THD *thd, const Refresh_request &request) {
+  DBUG_TRACE;
+  DBUG_PRINT("info", ("refreshing histograms for %s.%s",
+                      request.db.c_str(), request.table_name.c_str()));
+
+  // Like ANALYZE TABLE, do not write to the dictionary on a read-only server.
+  if (check_readonly(thd, false)) return;
+
+  thd->set_time();
+  lex_start(thd);
+  mysql_reset_thd_for_next_command(thd);
+
+  Table_ref table(request.db.c_str(), request.db.length(),
+                  request.table_name.c_str(), request.table_name.length(),
+                  request.table_name.c_str(), TL_READ);
+  const bool error =
+      acquire_shared_backup_lock(thd, thd->variables.lock_wait_timeout) ||
+      refresh_histograms(thd, &table, request.modified_fraction);
+  if (!error) {
+    // The histograms are cached in the TABLE_SHARE; see
+    // Sql_cmd_analyze_table::handle_histogram_command().
+    tdc_remove_table(thd, TDC_RT_REMOVE_UNUSED, request.db.c_str(),
+                     request.table_name.c_str(), false);
+  }
+
+  thd->mdl_context.release_transactional_locks();
+  thd->clear_error();
+  thd->get_stmt_da()->reset_condition_info(thd);
+  lex_end(thd->lex);
+  thd->mem_root->ClearForReuse();
+}
+
+extern "C" {
+static void *histogram_refresher(void *arg) {
+  THD *thd = static_cast<THD *>(arg);
+  mysql_thread_set_psi_id(thd->thread_id());
+  my_thread_init();
+  {
+    DBUG_TRACE;
+    thd->thread_stack = reinterpret_cast<char *>(&thd);
+    thd->set_command(COM_DAEMON);
+    thd->security_context()->skip_grants();
+    thd->system_thread = SYSTEM_THREAD_BACKGROUND;
+    thd->store_globals();
+
+    for (;;) {
+      mysql_mutex_lock(&LOCK_histogram_refresher);
+      while (refresh_queue->empty() && !abort_refresher) {
+        mysql_cond_wait(&COND_histogram_refresher, &LOCK_histogram_refresher);
+      }
+      if (abort_refresher) {
+        mysql_mutex_unlock(&LOCK_histogram_refresher);
+        break;
+      }
+      Refresh_request request = std::move(refresh_queue->front());
+      refresh_queue->pop_front();
+      mysql_mutex_unlock(&LOCK_histogram_refresher);
+
+      refresh_table(thd, request);
+    }
+
+    thd->release_resources();
+    thd->restore_globals();
+    delete thd;
+  }
+  my_thread_end();
+  my_thread_exit(nullptr);
+  return nullptr;
+}
+}  // extern "C"
+
+}  // namespace
+
+void note_modified_rows(const TABLE *table, ha_rows rows) {
+  if (opt_histogram_refresh_threshold == 0 || !refresher_started) return;
+
+  TABLE_SHARE *share = table->s;
+  if (share->tmp_table != NO_TMP_TABLE ||
+      share->table_category != TABLE_CATEGORY_USER ||
+      share->m_histograms == nullptr || share->m_histograms->empty()) {
+    return;
+  }
+
+  const ha_rows modified_rows =
+      share->m_histogram_modified_rows.fetch_add(rows,
+                                                 std::memory_order_relaxed) +
+      rows;
+  const ha_rows rows_in_table = std::max<ha_rows>(table->file->stats.records, 1);
+  if (modified_rows * 100 < opt_histogram_refresh_threshold * rows_in_table) {
+    return;
+  }
+
+  // Only one request per share; the refreshed histograms come in a new one.
+  if (share->m_histogram_refresh_requested.exchange(true)) return;
+
+  Refresh_request request{
+      std::string(share->db.str, share->db.length),
+      std::string(share->table_name.str, share->table_name.length),
+      static_cast<double>(modified_rows) / rows_in_table};
+
+  mysql_mutex_lock(&LOCK_histogram_refresher);
+  if (refresh_queue->size() < kMaxQueuedRefreshes) {
+    refresh_queue->push_back(std::move(request));
+    mysql_cond_signal(&COND_histogram_refresher);
+  }
+  mysql_mutex_unlock(&LOCK_histogram_refresher);
+}
+
+void start_histogram_refresher() {
+  DBUG_TRACE;
+#ifdef HAVE_PSI_INTERFACE
+  mysql_mutex_register("sql", refresher_mutexes,
+                       static_cast<int>(array_elements(refresher_mutexes)));
+  mysql_cond_register("sql", refresher_conds,
+                      static_cast<int>(array_elements(refresher_conds)));
+#endif
+  mysql_mutex_init(key_LOCK_histogram_refresher, &LOCK_histogram_refresher,
+                   MY_MUTEX_INIT_FAST);
+  mysql_cond_init(key_COND_histogram_refresher, &COND_histogram_refresher);
+  refresh_queue = new std::deque<Refresh_request>;
+  abort_refresher = false;
+
+  THD *thd = new THD;
+  thd->set_new_thread_id();
+  my_thread_attr_t attr;
+  my_thread_attr_init(&attr);
+  const int error =
+      mysql_thread_create(key_thread_histogram_refresher, &refresher_thread_id,
+                          &attr, histogram_refresher, thd);
+  my_thread_attr_destroy(&attr);
+  if (error != 0) {
+    // Histograms will only be updated by ANALYZE TABLE.
+    delete thd;
+    return;
+  }
+  refresher_started = true;
+}
+
+void stop_histogram_refresher() {
+  DBUG_TRACE;
+  if (refresh_queue == nullptr) return;
+
+  if (refresher_started) {
+    mysql_mutex_lock(&LOCK_histogram_refresher);
+    abort_refresher = true;
+    mysql_cond_signal(&COND_histogram_refresher);
+    mysql_mutex_unlock(&LOCK_histogram_refresher);
+    my_thread_join(&refresher_thread_id, nullptr);
+    refresher_started = false;
+  }
+
+  delete refresh_queue;
+  refresh_queue = nullptr;
+  mysql_cond_destroy(&COND_histogram_refresher);
+  mysql_mutex_destroy(&LOCK_histogram_refresher);
+}
+
+}  // namespace histograms
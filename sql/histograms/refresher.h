@@ -0,0 +1,70 @@
+#ifndef HISTOGRAMS_REFRESHER_INCLUDED
+#define HISTOGRAMS_REFRESHER_INCLUDED
+
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file sql/histograms/refresher.h
+  Background refresh of histogram statistics.
+
+  Histograms are only built by ANALYZE TABLE ... UPDATE HISTOGRAM, and go
+  stale as the table changes. To keep them reasonably fresh, the server counts
+  the rows written, updated and deleted in each table that has histograms.
+  When the count passes histogram_refresh_threshold percent of the rows in
+  the table, a background thread samples the table and merges the sample into
+  its equi-height histograms (see histograms::refresh_histograms()).
+
+  The count is kept in the TABLE_SHARE, so it starts over whenever the share
+  is evicted from the table definition cache, and when the refreshed
+  histograms are loaded into a new share.
+*/
+
+#include "my_base.h"  // ha_rows
+#include "my_inttypes.h"
+
+struct TABLE;
+
+/// The value of histogram_refresh_threshold. 0 disables the refresh.
+extern ulong opt_histogram_refresh_threshold;
+
+namespace histograms {
+
+/**
+  Count rows modified in the given table by a statement that is done with
+  it, and request a refresh of the table's histograms if enough rows have
+  been modified since they were last updated.
+
+  @param table The table that was modified.
+  @param rows  The number of rows written, updated or deleted.
+*/
+void note_modified_rows(const TABLE *table, ha_rows rows);
+
+/// Start the background thread. Called once at server startup.
+void start_histogram_refresher();
+
+/// Stop the background thread, abandoning any queued refreshes.
+void stop_histogram_refresher();
+
+}  // namespace histograms
+
+#endif  // HISTOGRAMS_REFRESHER_INCLUDED
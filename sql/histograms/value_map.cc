@@ -36,6 +36,7 @@
 #include "my_sys.h"
 #include "my_time.h"
 #include "mysql_time.h"  // MYSQL_TIME
+#include "sql/histograms/equi_height.h"
 #include "sql/histograms/histogram.h"
 #include "sql/my_decimal.h"      // my_decimal_cmp
 #include "sql/psi_memory_key.h"  // key_memory_histograms
@@ -153,6 +154,21 @@ Histogram *Value_map<T>::build_histogram(MEM_ROOT *mem_root, size_t num_buckets,
                                      tbl_name, col_name);
 }
 
+template <class T>
+Histogram *Value_map<T>::merge_histogram(MEM_ROOT *mem_root,
+                                         const Histogram &existing,
+                                         double weight) const {
+  assert(existing.get_histogram_type() ==
+         Histogram::enum_histogram_type::EQUI_HEIGHT);
+  assert(existing.get_data_type() == get_data_type());
+  Histogram *histogram = existing.clone(mem_root);
+  if (histogram == nullptr) return nullptr; /* purecov: inspected */
+  if (down_cast<Equi_height<T> *>(histogram)->merge_sample(*this, weight)) {
+    return nullptr; /* purecov: inspected */
+  }
+  return histogram;
+}
+
 // Explicit template instantiations.
 template class Value_map<double>;
 template class Value_map<String>;
@@ -230,6 +230,22 @@ class Value_map_base {
                                      const std::string &tbl_name,
                                      const std::string &col_name) const = 0;
 
+  /**
+    Merge this Value_map, which holds a new sample of a column, into an
+    existing equi-height histogram for that column. See
+    Equi_height::merge_sample().
+
+    @param mem_root The MEM_ROOT to allocate the merged histogram on
+    @param existing The histogram to merge into. Must be an equi-height
+                    histogram over the same data type as this Value_map.
+    @param weight   The weight of the new sample, in the range [0.0, 1.0)
+
+    @return nullptr on error, or the merged histogram if success.
+  */
+  virtual Histogram *merge_histogram(MEM_ROOT *mem_root,
+                                     const Histogram &existing,
+                                     double weight) const = 0;
+
   /// @return The sampling rate that was used to generate this Value_map.
   double get_sampling_rate() const { return m_sampling_rate; }
 
@@ -308,6 +324,9 @@ class Value_map final : public Value_map_base {
                              const std::string &tbl_name,
                              const std::string &col_name) const override;
 
+  Histogram *merge_histogram(MEM_ROOT *mem_root, const Histogram &existing,
+                             double weight) const override;
+
   /// @return the overhead in bytes for each distinct value stored in the
   ///         Value_map. The value 32 is obtained from both GCC 8.2 and
   ///         Clang 8.0 (same as sizeof(value_map_type::node_type) in C++17).
@@ -31,6 +31,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <cmath>
@@ -46,6 +47,7 @@
 #include "my_alloc.h"
 #include "my_bit.h"
 #include "my_bitmap.h"
+#include "my_byteorder.h"
 #include "my_dbug.h"
 #include "my_sqlcommand.h"
 #include "my_sys.h"
@@ -53,6 +55,7 @@
 #include "mysql_com.h"
 #include "mysql_time.h"
 #include "mysqld_error.h"
+#include "prealloced_array.h"
 #include "sql-common/json_dom.h"  // Json_scalar_holder
 #include "sql/aggregate_check.h"  // Distinct_check
 #include "sql/check_stack.h"
@@ -60,6 +63,7 @@
 #include "sql/derror.h"       // ER_THD
 #include "sql/error_handler.h"
 #include "sql/field.h"
+#include "sql/histograms/column_group.h"  // column_group_correction
 #include "sql/histograms/histogram.h"
 #include "sql/item_func.h"
 #include "sql/item_json_func.h"  // json_value, get_json_atom_wrapper
@@ -74,6 +78,7 @@
 #include "sql/opt_trace_context.h"
 #include "sql/parse_tree_helpers.h"    // PT_item_list
 #include "sql/parse_tree_node_base.h"  // Parse_context
+#include "sql/psi_memory_key.h"
 #include "sql/query_options.h"
 #include "sql/sql_array.h"
 #include "sql/sql_base.h"
@@ -760,6 +765,61 @@ void Arg_comparator::cleanup() {
   value2.mem_free();
 }
 
+/**
+  Get the weights that compare_string_ascii() uses for a collation.
+
+  Qualifying collations are the untailored UCA 9.0.0 NO PAD collations that
+  compare on the primary level only, such as utf8mb4_0900_ai_ci. In those,
+  every printable ASCII character (0x20..0x7E) is one byte with exactly one
+  non-zero weight and there are no contractions, so two strings made of such
+  characters compare like their sequences of weights.
+
+  The tables are computed once per collation through the collation's own
+  strnxfrm(), and are never freed.
+
+  @param cs  the collation used for the comparison
+
+  @returns a table of 128 weights indexed by byte value, or nullptr if the
+           collation does not qualify
+*/
+static const uint16 *ascii_weights_for(const CHARSET_INFO *cs) {
+  if (cs->uca == nullptr || cs->tailoring != nullptr ||
+      cs->levels_for_compare != 1 || cs->pad_attribute != NO_PAD ||
+      cs->mbminlen != 1 || !my_charset_is_ascii_based(cs) ||
+      cs->number >= MY_ALL_CHARSETS_SIZE)
+    return nullptr;
+
+  static std::atomic<const uint16 *> tables[MY_ALL_CHARSETS_SIZE];
+  static const uint16 not_applicable = 0;
+
+  const uint16 *table = tables[cs->number].load(std::memory_order_acquire);
+  if (table == nullptr) {
+    uint16 *weights = static_cast<uint16 *>(
+        my_malloc(key_memory_Arg_comparator_ascii_weights, 128 * sizeof(uint16), MYF(0)));
+    if (weights == nullptr) return nullptr;
+    memset(weights, 0, 128 * sizeof(uint16));
+    table = weights;
+    for (uchar ch = 0x20; ch < 0x7f; ++ch) {
+      uchar dst[8];
+      if (cs->coll->strnxfrm(cs, dst, sizeof(dst), 1, &ch, 1, 0) != 2 ||
+          load16be(dst) == 0) {
+        table = &not_applicable;
+        break;
+      }
+      weights[ch] = load16be(dst);
+    }
+    if (table == &not_applicable) my_free(weights);
+    const uint16 *expected = nullptr;
+    if (!tables[cs->number].compare_exchange_strong(
+            expected, table, std::memory_order_acq_rel)) {
+      // Another thread got there first.
+      if (table != &not_applicable) my_free(weights);
+      table = expected;
+    }
+  }
+  return table == &not_applicable ? nullptr : table;
+}
+
 bool Arg_comparator::set_compare_func(Item_result_field *item,
                                       Item_result type) {
   m_compare_type = type;
@@ -809,6 +869,10 @@ bool Arg_comparator::set_compare_func(Item_result_field *item,
         */
         if (func == &Arg_comparator::compare_string)
           func = &Arg_comparator::compare_binary_string;
+      } else if (func == &Arg_comparator::compare_string) {
+        m_ascii_weights = ascii_weights_for(cmp_collation.collation);
+        if (m_ascii_weights != nullptr)
+          func = &Arg_comparator::compare_string_ascii;
       }
       /*
         If the comparison's and arguments' collations differ, prevent column
@@ -838,6 +902,9 @@ bool Arg_comparator::set_compare_func(Item_result_field *item,
                       : &Arg_comparator::compare_int_unsigned_signed);
         else if ((*right)->unsigned_flag)
           func = &Arg_comparator::compare_int_signed_unsigned;
+        else if ((*left)->type() == Item::FIELD_ITEM &&
+                 (*right)->type() == Item::FIELD_ITEM)
+          func = &Arg_comparator::compare_int_signed_fields;
       }
       break;
     }
@@ -1128,6 +1195,12 @@ static longlong get_time_value(THD *, Item ***item_arg, Item **, const Item *,
     Here we override the chosen result type for certain expression
     containing date or time or decimal expressions.
  */
+/// @returns true if get_datetime_value() reads the item with
+///   val_date_temporal(), i.e. without any string conversion.
+static bool is_temporal_not_year(const Item *item) {
+  return item->is_temporal() && item->data_type() != MYSQL_TYPE_YEAR;
+}
+
 bool Arg_comparator::set_cmp_func(Item_result_field *owner_arg, Item **left_arg,
                                   Item **right_arg, Item_result type) {
   m_compare_type = type;
@@ -1192,6 +1265,12 @@ bool Arg_comparator::set_cmp_func(Item_result_field *owner_arg, Item **left_arg,
     get_value_b_func = &get_datetime_value;
     cmp_collation.set(&my_charset_numeric);
     set_cmp_context_for_datetime();
+    /*
+      When both sides are temporal, get_datetime_value() reduces to
+      val_date_temporal(), so read the packed values directly.
+    */
+    if (is_temporal_not_year(*left) && is_temporal_not_year(*right))
+      func = &Arg_comparator::compare_datetime_packed;
     return false;
   } else if ((type == STRING_RESULT ||
               // When comparing time field and cached/converted time constant
@@ -1205,6 +1284,8 @@ bool Arg_comparator::set_cmp_func(Item_result_field *owner_arg, Item **left_arg,
     get_value_a_func = &get_time_value;
     get_value_b_func = &get_time_value;
     set_cmp_context_for_datetime();
+    // get_time_value() reduces to val_time_temporal() for TIME arguments.
+    func = &Arg_comparator::compare_time_packed;
     return false;
   } else if (type == STRING_RESULT && (*left)->result_type() == STRING_RESULT &&
              (*right)->result_type() == STRING_RESULT) {
@@ -1356,7 +1437,8 @@ bool Arg_comparator::inject_cast_nodes() {
     if (bb->result_type() != REAL_RESULT &&
         wrap_in_cast(right, MYSQL_TYPE_DOUBLE))
       return true; /* purecov: inspected */
-  } else if (func == &Arg_comparator::compare_datetime) {
+  } else if (func == &Arg_comparator::compare_datetime ||
+             func == &Arg_comparator::compare_datetime_packed) {
     Item *aa = (*left)->real_item();
     Item *bb = (*right)->real_item();
     // Check that none of the arguments are of type YEAR
@@ -1626,6 +1708,27 @@ int Arg_comparator::compare_datetime() {
   return left_value < right_value ? -1 : (left_value > right_value ? 1 : 0);
 }
 
+/**
+  Compare two temporal items as packed DATETIME values.
+
+  Used instead of compare_datetime() when neither side needs a string
+  conversion, so the values can be read directly.
+*/
+int Arg_comparator::compare_datetime_packed() {
+  const longlong left_value = (*left)->val_date_temporal();
+  if ((*left)->null_value) {
+    if (set_null) owner->null_value = true;
+    return -1;
+  }
+  const longlong right_value = (*right)->val_date_temporal();
+  if ((*right)->null_value) {
+    if (set_null) owner->null_value = true;
+    return -1;
+  }
+  if (set_null) owner->null_value = false;
+  return left_value < right_value ? -1 : (left_value > right_value ? 1 : 0);
+}
+
 /**
   Get one of the arguments to the comparator as a JSON value.
 
@@ -1740,6 +1843,52 @@ int Arg_comparator::compare_string() {
                                pointer_cast<const uchar *>(res2->ptr()), l2);
 }
 
+/**
+  Compare strings in a collation that has a table of ASCII weights, see
+  ascii_weights_for().
+
+  Strings made only of printable ASCII characters are compared on the
+  weights from the table. As soon as a character outside that range is
+  seen, the full strnncollsp() of the collation is used instead.
+*/
+int Arg_comparator::compare_string_ascii() {
+  const CHARSET_INFO *cs = cmp_collation.collation;
+  String *res1 = eval_string_arg(cs, *left, &value1);
+  if (res1 == nullptr) {
+    if (set_null) owner->null_value = true;
+    return -1;
+  }
+  String *res2 = eval_string_arg(cs, *right, &value2);
+  if (res2 == nullptr) {
+    if (set_null) owner->null_value = true;
+    return -1;
+  }
+
+  if (set_null) owner->null_value = false;
+  const uchar *s1 = pointer_cast<const uchar *>(res1->ptr());
+  const uchar *s2 = pointer_cast<const uchar *>(res2->ptr());
+  const size_t l1 = res1->length();
+  const size_t l2 = res2->length();
+  const size_t min_length = min(l1, l2);
+  for (size_t i = 0; i < min_length; ++i) {
+    const uchar c1 = s1[i];
+    const uchar c2 = s2[i];
+    if (c1 < 0x20 || c1 > 0x7e || c2 < 0x20 || c2 > 0x7e)
+      return cs->coll->strnncollsp(cs, s1, l1, s2, l2);
+    if (c1 != c2 && m_ascii_weights[c1] != m_ascii_weights[c2])
+      return m_ascii_weights[c1] < m_ascii_weights[c2] ? -1 : 1;
+  }
+  if (l1 == l2) return 0;
+  /*
+    The common prefix is equal. The longer string is greater unless what
+    follows is ignorable, which only a printable ASCII character rules out.
+  */
+  const uchar next = l1 > l2 ? s1[min_length] : s2[min_length];
+  if (next < 0x20 || next > 0x7e)
+    return cs->coll->strnncollsp(cs, s1, l1, s2, l2);
+  return l1 > l2 ? 1 : -1;
+}
+
 /**
   Compare strings byte by byte. End spaces are also compared.
 
@@ -1839,6 +1988,25 @@ int Arg_comparator::compare_int_signed() {
   return -1;
 }
 
+/**
+  Compare two integer fields as signed values.
+
+  Reading a field cannot raise an error, so unlike compare_int_signed() there
+  is no need to check the diagnostics area after each argument.
+*/
+int Arg_comparator::compare_int_signed_fields() {
+  const longlong val1 = (*left)->val_int();
+  if (!(*left)->null_value) {
+    const longlong val2 = (*right)->val_int();
+    if (!(*right)->null_value) {
+      if (set_null) owner->null_value = false;
+      return val1 < val2 ? -1 : (val1 > val2 ? 1 : 0);
+    }
+  }
+  if (set_null) owner->null_value = true;
+  return -1;
+}
+
 /**
   Compare arguments using numeric packed temporal representation.
 */
@@ -4405,15 +4573,27 @@ bool in_row::compare_elems(uint pos1, uint pos2) const {
   return base_pointers[pos1]->compare(base_pointers[pos2]) != 0;
 }
 
+/// IN lists of strings with at least this many elements are looked up
+/// through a hash table instead of by binary search.
+static constexpr uint MIN_HASHED_IN_STRINGS = 32;
+
 in_string::in_string(MEM_ROOT *mem_root, uint elements, const CHARSET_INFO *cs)
     : in_vector(elements),
       tmp(buff, sizeof(buff), &my_charset_bin),
       base_objects(mem_root, elements),
       base_pointers(mem_root, elements),
-      collation(cs) {
+      collation(cs),
+      hash_slots(mem_root) {
   for (uint ix = 0; ix < elements; ++ix) {
     base_pointers[ix] = &base_objects[ix];
   }
+  if (elements >= MIN_HASHED_IN_STRINGS) {
+    // A power of two with a load factor of at most 1/2.
+    uint num_slots = 1;
+    while (num_slots < 2 * elements) num_slots <<= 1;
+    if (hash_slots.reserve(num_slots)) return;  // Use binary search.
+    hash_slots.resize(num_slots, UINT_MAX);
+  }
 }
 
 void in_string::set(uint pos, Item *item) {
@@ -4453,16 +4633,43 @@ class Cmp_string {
 };
 }  // namespace
 
+uint64 in_string::hash_value(const String *str) const {
+  uint64 nr1 = 1, nr2 = 4;
+  collation->coll->hash_sort(collation, pointer_cast<const uchar *>(str->ptr()),
+                             str->length(), &nr1, &nr2);
+  return nr1;
+}
+
 // Sort string pointers, not string objects.
 void in_string::sort_array() {
   std::sort(base_pointers.begin(), base_pointers.begin() + m_used_size,
             Cmp_string(collation));
+
+  if (hash_slots.empty()) return;
+  // Values that compare equal hash equally, so duplicates share a chain and
+  // any one of them is found.
+  const size_t mask = hash_slots.size() - 1;
+  std::fill(hash_slots.begin(), hash_slots.end(), UINT_MAX);
+  for (uint pos = 0; pos < m_used_size; ++pos) {
+    size_t slot = hash_value(base_pointers[pos]) & mask;
+    while (hash_slots[slot] != UINT_MAX) slot = (slot + 1) & mask;
+    hash_slots[slot] = pos;
+  }
 }
 
 bool in_string::find_item(Item *item) {
   if (m_used_size == 0) return false;
   const String *str = eval_string_arg(collation, item, &tmp);
   if (str == nullptr) return false;
+  if (!hash_slots.empty()) {
+    const size_t mask = hash_slots.size() - 1;
+    for (size_t slot = hash_value(str) & mask; hash_slots[slot] != UINT_MAX;
+         slot = (slot + 1) & mask) {
+      if (srtcmp_in(collation, base_pointers[hash_slots[slot]], str) == 0)
+        return true;
+    }
+    return false;
+  }
   return std::binary_search(base_pointers.begin(),
                             base_pointers.begin() + m_used_size, str,
                             Cmp_string(collation));
@@ -5942,6 +6149,65 @@ bool Item_cond::truth_transform_arguments(THD *thd, Bool_test test) {
   return false;
 }
 
+/**
+  If the given condition is an equality between exactly one column of
+  'filter_for_table' and a constant or a column of a table in 'read_tables',
+  return that column.
+
+  @param cond             The condition.
+  @param filter_for_table The table we are calculating filter effect for.
+  @param read_tables      Tables earlier in the join sequence.
+  @param fields_to_ignore Columns that already contribute to the filter.
+
+  @return the field of 'filter_for_table', or nullptr
+*/
+static const Field *equality_filter_field(const Item *cond,
+                                          table_map filter_for_table,
+                                          table_map read_tables,
+                                          const MY_BITMAP *fields_to_ignore) {
+  const auto usable_field = [&](const Item *item) -> const Field * {
+    if (item->type() != Item::FIELD_ITEM ||
+        item->used_tables() != filter_for_table)
+      return nullptr;
+    const Field *field = down_cast<const Item_field *>(item)->field;
+    if (bitmap_is_set(fields_to_ignore, field->field_index())) return nullptr;
+    return field;
+  };
+  const auto usable_value = [&](const Item *item) {
+    return (item->used_tables() & ~(read_tables | PSEUDO_TABLE_BITS)) == 0;
+  };
+
+  if (is_function_of_type(cond, Item_func::EQ_FUNC)) {
+    const Item_func_eq *eq = down_cast<const Item_func_eq *>(cond);
+    const Item *left = eq->arguments()[0];
+    const Item *right = eq->arguments()[1];
+    if (const Field *field = usable_field(left);
+        field != nullptr && usable_value(right))
+      return field;
+    if (const Field *field = usable_field(right);
+        field != nullptr && usable_value(left))
+      return field;
+    return nullptr;
+  }
+
+  if (is_function_of_type(cond, Item_func::MULT_EQUAL_FUNC)) {
+    const Item_equal *equal = down_cast<const Item_equal *>(cond);
+    const Field *found = nullptr;
+    bool found_comparable = equal->const_arg() != nullptr;
+    for (const Item_field &item_field : equal->get_fields()) {
+      if (const Field *field = usable_field(&item_field); field != nullptr) {
+        if (found != nullptr) return nullptr;  // Several columns of the table.
+        found = field;
+      } else if (usable_value(&item_field)) {
+        found_comparable = true;
+      }
+    }
+    return found_comparable ? found : nullptr;
+  }
+
+  return nullptr;
+}
+
 float Item_cond_and::get_filtering_effect(THD *thd, table_map filter_for_table,
                                           table_map read_tables,
                                           const MY_BITMAP *fields_to_ignore,
@@ -5956,10 +6222,32 @@ float Item_cond_and::get_filtering_effect(THD *thd, table_map filter_for_table,
   /*
     Calculated as "Conjunction of independent events":
        P(A and B ...) = P(A) * P(B) * ...
+
+    Equalities on columns of the table are remembered, so that we can correct
+    for correlated columns that have column-group statistics.
   */
-  while ((item = it++))
-    filter *= item->get_filtering_effect(thd, filter_for_table, read_tables,
-                                         fields_to_ignore, rows_in_table);
+  Prealloced_array<histograms::Equality_selectivity, 8> equalities(
+      PSI_NOT_INSTRUMENTED);
+  const TABLE_SHARE *share = nullptr;
+  while ((item = it++)) {
+    const float item_filter = item->get_filtering_effect(
+        thd, filter_for_table, read_tables, fields_to_ignore, rows_in_table);
+    filter *= item_filter;
+
+    const Field *field = equality_filter_field(item, filter_for_table,
+                                               read_tables, fields_to_ignore);
+    if (field != nullptr && field->table->s->m_column_groups != nullptr) {
+      share = field->table->s;
+      equalities.push_back({field->field_index(), item_filter});
+    }
+  }
+
+  if (equalities.size() > 1) {
+    const double correction = histograms::column_group_correction(
+        share, equalities.begin(), equalities.size());
+    filter = static_cast<float>(
+        std::min<double>(COND_FILTER_ALLPASS, filter * correction));
+  }
   return filter;
 }
 
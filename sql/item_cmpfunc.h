@@ -160,6 +160,11 @@ class Arg_comparator {
     SQL value to a JSON value.
   */
   Json_scalar_holder *json_scalar{nullptr};
+  /**
+    Only used by compare_string_ascii(). Primary weights of the printable
+    ASCII characters in cmp_collation, indexed by byte value.
+  */
+  const uint16 *m_ascii_weights{nullptr};
 
  public:
   DTCollation cmp_collation;
@@ -214,6 +219,7 @@ class Arg_comparator {
   int compare_real();           // compare args[0] & args[1]
   int compare_decimal();        // compare args[0] & args[1]
   int compare_int_signed();     // compare args[0] & args[1]
+  int compare_int_signed_fields();
   int compare_int_signed_unsigned();
   int compare_int_unsigned_signed();
   int compare_int_unsigned();
@@ -221,6 +227,8 @@ class Arg_comparator {
   int compare_row();  // compare args[0] & args[1]
   int compare_real_fixed();
   int compare_datetime();  // compare args[0] & args[1] as DATETIMEs
+  int compare_datetime_packed();
+  int compare_string_ascii();
   int compare_json();
   bool compare_null_values();
 
@@ -1650,6 +1658,12 @@ class in_string final : public in_vector {
   // String objects are not sortable, sort pointers instead.
   Mem_root_array<String *> base_pointers;
   const CHARSET_INFO *collation;
+  /**
+    For long lists, an open addressing hash table of positions in
+    base_pointers, keyed on the collation's hash_sort(), so that lookups do
+    not need log2(n) collation-aware comparisons. Empty if not used.
+  */
+  Mem_root_array<uint> hash_slots;
 
  public:
   in_string(MEM_ROOT *mem_root, uint elements, const CHARSET_INFO *cs);
@@ -1665,6 +1679,7 @@ class in_string final : public in_vector {
  private:
   void set(uint pos, Item *item) override;
   void sort_array() override;
+  uint64 hash_value(const String *str) const;
 };
 
 class in_longlong : public in_vector {
@@ -3073,7 +3073,7 @@ template <bool to_left>
 String *Item_func_shift::eval_str_op(String *) {
   assert(fixed);
 
-  String tmp_str;
+  StringBuffer<STRING_BUFFER_USUAL_SIZE> tmp_str;
   String *arg = args[0]->val_str(&tmp_str);
   if (!arg || args[0]->null_value) return error_str();
 
@@ -3208,12 +3208,12 @@ template <class Char_func, class Int_func>
 String *Item_func_bit_two_param::eval_str_op(String *, Char_func char_func,
                                              Int_func int_func) {
   assert(fixed);
-  String arg0_buff;
+  StringBuffer<STRING_BUFFER_USUAL_SIZE> arg0_buff;
   String *s1 = args[0]->val_str(&arg0_buff);
 
   if (args[0]->null_value || !s1) return error_str();
 
-  String arg1_buff;
+  StringBuffer<STRING_BUFFER_USUAL_SIZE> arg1_buff;
   String *s2 = args[1]->val_str(&arg1_buff);
 
   if (args[1]->null_value || !s2) return error_str();
@@ -27,6 +27,7 @@
 #include <sys/types.h>
 
 #include <cstddef>
+#include <memory>
 #include <vector>
 
 #include "field_types.h"  // MYSQL_TYPE_BLOB
@@ -970,6 +971,7 @@ class Item_func_spatial_relation : public Item_bool_func2 {
  public:
   Item_func_spatial_relation(const POS &pos, Item *a, Item *b)
       : Item_bool_func2(pos, a, b) {}
+  ~Item_func_spatial_relation() override;
   bool resolve_type(THD *thd) override {
     if (param_type_is_default(thd, 0, -1, MYSQL_TYPE_GEOMETRY)) return true;
     // Spatial relation functions may return NULL if either parameter is NULL or
@@ -983,6 +985,7 @@ class Item_func_spatial_relation : public Item_bool_func2 {
     Item_func::print(thd, str, query_type);
   }
   longlong val_int() override;
+  void cleanup() override;
   bool is_null() override {
     // The superclass implementation only checks is_null on the item's
     // arguments. However, relational functions may return NULL even if the
@@ -1008,6 +1011,30 @@ class Item_func_spatial_relation : public Item_bool_func2 {
   virtual bool eval(const dd::Spatial_reference_system *srs,
                     const gis::Geometry *g1, const gis::Geometry *g2,
                     bool *result, bool *null) = 0;
+
+ private:
+  /**
+    Get the geometry of an argument. Arguments that are constant during
+    execution are parsed only once, and then reused for all rows.
+
+    @param[in] thd Thread handle.
+    @param[in] arg_no The argument number.
+    @param[in] str The value of the argument, or nullptr if the argument is
+    constant and already parsed.
+    @param[out] srs The spatial reference system of the geometry.
+    @param[out] parsed Holds the geometry if it isn't cached.
+
+    @return The geometry, or nullptr if an error has been reported with
+    my_error.
+  */
+  const gis::Geometry *get_geometry(THD *thd, int arg_no, const String *str,
+                                    const dd::Spatial_reference_system **srs,
+                                    std::unique_ptr<gis::Geometry> *parsed);
+
+  /// Parsed geometries of arguments that are constant during execution.
+  std::unique_ptr<gis::Geometry> m_const_geometry[2];
+  /// The SRIDs of the geometries in m_const_geometry.
+  gis::srid_t m_const_srid[2]{0, 0};
 };
 
 class Item_func_st_contains final : public Item_func_spatial_relation {
@@ -64,38 +64,79 @@ struct cartesian;
 }  // namespace geometry
 }  // namespace boost
 
+Item_func_spatial_relation::~Item_func_spatial_relation() = default;
+
+void Item_func_spatial_relation::cleanup() {
+  Item_bool_func2::cleanup();
+  m_const_geometry[0].reset();
+  m_const_geometry[1].reset();
+}
+
+const gis::Geometry *Item_func_spatial_relation::get_geometry(
+    THD *thd, int arg_no, const String *str,
+    const dd::Spatial_reference_system **srs,
+    std::unique_ptr<gis::Geometry> *parsed) {
+  if (m_const_geometry[arg_no] != nullptr) {
+    // The SRS is acquired for every row, as the dictionary client only keeps
+    // it while the Auto_releaser in val_int() is alive.
+    const gis::srid_t srid = m_const_srid[arg_no];
+    *srs = nullptr;
+    if (srid != 0) {
+      Srs_fetcher fetcher(thd);
+      if (fetcher.acquire(srid, srs)) return nullptr;
+      if (*srs == nullptr) {
+        my_error(ER_SRS_NOT_FOUND, MYF(0), srid);
+        return nullptr;
+      }
+    }
+    return m_const_geometry[arg_no].get();
+  }
+
+  if (gis::parse_geometry(thd, func_name(), str, srs, parsed)) return nullptr;
+
+  if (args[arg_no]->const_for_execution()) {
+    m_const_srid[arg_no] = *srs == nullptr ? 0 : (*srs)->id();
+    m_const_geometry[arg_no] = std::move(*parsed);
+    return m_const_geometry[arg_no].get();
+  }
+  return parsed->get();
+}
+
 longlong Item_func_spatial_relation::val_int() {
   DBUG_TRACE;
   assert(fixed);
 
+  // Constant arguments that have already been parsed aren't evaluated again.
   String tmp_value1;
   String tmp_value2;
-  String *res1 = args[0]->val_str(&tmp_value1);
-  String *res2 = args[1]->val_str(&tmp_value2);
+  String *res1 = nullptr;
+  String *res2 = nullptr;
+  if (m_const_geometry[0] == nullptr) {
+    res1 = args[0]->val_str(&tmp_value1);
+    if (args[0]->null_value) res1 = nullptr;
+  }
+  if (m_const_geometry[1] == nullptr) {
+    res2 = args[1]->val_str(&tmp_value2);
+    if (args[1]->null_value) res2 = nullptr;
+  }
 
-  if ((null_value =
-           (!res1 || args[0]->null_value || !res2 || args[1]->null_value))) {
+  if ((null_value = ((res1 == nullptr && m_const_geometry[0] == nullptr) ||
+                     (res2 == nullptr && m_const_geometry[1] == nullptr)))) {
     assert(is_nullable());
     return 0;
   }
 
-  if (res1 == nullptr || res2 == nullptr) {
-    assert(false);
-    my_error(ER_GIS_INVALID_DATA, MYF(0), func_name());
-    return error_int();
-  }
-
+  THD *thd = current_thd;
   const dd::Spatial_reference_system *srs1 = nullptr;
   const dd::Spatial_reference_system *srs2 = nullptr;
-  std::unique_ptr<gis::Geometry> g1;
-  std::unique_ptr<gis::Geometry> g2;
+  std::unique_ptr<gis::Geometry> parsed1;
+  std::unique_ptr<gis::Geometry> parsed2;
   std::unique_ptr<dd::cache::Dictionary_client::Auto_releaser> releaser(
-      new dd::cache::Dictionary_client::Auto_releaser(
-          current_thd->dd_client()));
-  if (gis::parse_geometry(current_thd, func_name(), res1, &srs1, &g1) ||
-      gis::parse_geometry(current_thd, func_name(), res2, &srs2, &g2)) {
-    return error_int();
-  }
+      new dd::cache::Dictionary_client::Auto_releaser(thd->dd_client()));
+  const gis::Geometry *g1 = get_geometry(thd, 0, res1, &srs1, &parsed1);
+  if (g1 == nullptr) return error_int();
+  const gis::Geometry *g2 = get_geometry(thd, 1, res2, &srs2, &parsed2);
+  if (g2 == nullptr) return error_int();
 
   gis::srid_t srid1 = srs1 == nullptr ? 0 : srs1->id();
   gis::srid_t srid2 = srs2 == nullptr ? 0 : srs2->id();
@@ -105,7 +146,7 @@ longlong Item_func_spatial_relation::val_int() {
   }
 
   bool result;
-  bool error = eval(srs1, g1.get(), g2.get(), &result, &null_value);
+  bool error = eval(srs1, g1, g2, &result, &null_value);
 
   if (error) return error_int();
 
@@ -597,7 +597,7 @@ static bool do_json_schema_validation(
     Json_schema_validation_report *validation_report) {
   assert(is_convertible_to_json(json_document));
 
-  String document_buffer;
+  StringBuffer<STRING_BUFFER_USUAL_SIZE> document_buffer;
   String *document_string = json_document->val_str(&document_buffer);
   if (thd->is_error()) return true;
   if (json_document->null_value) {
@@ -1852,6 +1852,18 @@ bool Item_func_json_extract::val_json(Json_wrapper *wr) {
 
       could_return_multiple_matches |= path->can_match_many();
 
+      if (!could_return_multiple_matches && !w.is_dom()) {
+        // A single simple path into a binary document. Walk it directly.
+        Json_wrapper hit;
+        if (!w.seek_single(*path, true, &hit)) {
+          null_value = true;
+          return false;
+        }
+        *wr = std::move(hit);
+        null_value = false;
+        return false;
+      }
+
       if (w.seek(*path, path->leg_count(), &v, true, false))
         return error_json(); /* purecov: inspected */
     }
@@ -3850,7 +3862,7 @@ longlong Item_func_json_overlaps::val_int() {
   int res = 0;
   null_value = false;
   try {
-    String m_doc_value;
+    StringBuffer<STRING_BUFFER_USUAL_SIZE> m_doc_value;
     Json_wrapper wr_a, wr_b;
     Json_wrapper *doc_a = &wr_a;
     Json_wrapper *doc_b = &wr_b;
@@ -3943,8 +3955,8 @@ Item *Item_func_json_overlaps::key_item() const {
 longlong Item_func_member_of::val_int() {
   null_value = false;
   try {
-    String m_doc_value;
-    String conv_buf;
+    StringBuffer<STRING_BUFFER_USUAL_SIZE> m_doc_value;
+    StringBuffer<STRING_BUFFER_USUAL_SIZE> conv_buf;
     Json_wrapper doc_a, doc_b;
     bool is_doc_b_sorted = false;
 
@@ -4569,7 +4581,7 @@ bool Item_func_json_value::extract_json_value(
         return false;
       }
     } else {
-      String buffer;
+      StringBuffer<STRING_BUFFER_USUAL_SIZE> buffer;
       const String *doc_string = args[0]->val_str(&buffer);
       null_value = args[0]->null_value;
       if (null_value) {
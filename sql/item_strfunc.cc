@@ -2909,7 +2909,7 @@ longlong Item_func_is_uuid::val_int() {
   assert(fixed && arg_count == 1);
   null_value = true;
 
-  String buffer;
+  StringBuffer<STRING_BUFFER_USUAL_SIZE> buffer;
   String *arg_str = args[0]->val_str(&buffer);
 
   if (!arg_str) return 0;
@@ -3731,7 +3731,7 @@ String *Item_load_file::val_str(String *str) {
 
 String *Item_func_export_set::val_str(String *str) {
   assert(fixed);
-  String yes_buf, no_buf, sep_buf;
+  StringBuffer<STRING_BUFFER_USUAL_SIZE> yes_buf, no_buf, sep_buf;
   const ulonglong the_set = static_cast<ulonglong>(args[0]->val_int());
   if (current_thd->is_error() || args[0]->null_value) {
     return error_str();
@@ -46,6 +46,7 @@
 #include "my_dbug.h"
 #include "my_double2ulonglong.h"
 #include "my_sys.h"
+#include "my_xxhash.h"
 #include "mysql_com.h"
 #include "mysqld_error.h"
 #include "sql-common/json_dom.h"
@@ -1146,7 +1147,8 @@ bool Aggregator_distinct::setup(THD *thd) {
       }
       assert(tree == nullptr);
       tree = new (thd->mem_root) Unique(compare_key, cmp_arg, tree_key_length,
-                                        item_sum->ram_limitation(thd));
+                                        item_sum->ram_limitation(thd),
+                                        /*raw_keys=*/all_binary);
       /*
         The only time tree_key_length could be 0 is if someone does
         count(distinct) on a char(0) field - stupid thing to do,
@@ -1209,7 +1211,7 @@ bool Aggregator_distinct::setup(THD *thd) {
     */
     tree = new (thd->mem_root)
         Unique(simple_raw_key_cmp, &tree_key_length, tree_key_length,
-               item_sum->ram_limitation(thd));
+               item_sum->ram_limitation(thd), /*raw_keys=*/true);
 
     return tree == nullptr;
   }
@@ -1834,6 +1836,9 @@ Item_sum_sum::Item_sum_sum(THD *thd, Item_sum_sum *item)
       curr_dec_buff(item->curr_dec_buff),
       m_count(item->m_count),
       m_frame_null_count(item->m_frame_null_count) {
+#ifdef __SIZEOF_INT128__
+  m_int128_sum = item->m_int128_sum;
+#endif
   /* TODO: check if the following assignments are really needed */
   if (hybrid_type == DECIMAL_RESULT) {
     my_decimal2decimal(item->dec_buffs, dec_buffs);
@@ -1855,6 +1860,9 @@ void Item_sum_sum::clear() {
     curr_dec_buff = 0;
     my_decimal_set_zero(&dec_buffs[0]);
     my_decimal_set_zero(&dec_buffs[1]);
+#ifdef __SIZEOF_INT128__
+    m_int128_sum = 0;
+#endif
   } else
     sum = 0.0;
   m_count = 0;
@@ -1932,6 +1940,18 @@ bool Item_sum_sum::check_wf_semantics1(THD *thd, Query_block *select,
   return result;
 }
 
+void Item_sum_sum::fold_int128_sum() {
+#ifdef __SIZEOF_INT128__
+  if (m_int128_sum == 0) return;
+  my_decimal partial;
+  int1282decimal(m_int128_sum, decimals, &partial);
+  my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1), &partial,
+                 dec_buffs + curr_dec_buff);
+  curr_dec_buff ^= 1;
+  m_int128_sum = 0;
+#endif
+}
+
 bool Item_sum_sum::add() {
   DBUG_TRACE;
   assert(!m_is_window_function);
@@ -1940,10 +1960,22 @@ bool Item_sum_sum::add() {
     const my_decimal *val = aggr->arg_val_decimal(&value);
     if (current_thd->is_error()) return true;
     if (!aggr->arg_is_null(true)) {
+      null_value = false;
+#ifdef __SIZEOF_INT128__
+      /*
+        Adding scaled integers is much cheaper than decimal_add(), so do that
+        as long as the value and the running sum fit in 38 digits. Otherwise,
+        fold what we have and fall back to decimal arithmetic.
+      */
+      __int128 scaled;
+      if (decimal2int128(val, decimals, &scaled) == E_DEC_OK &&
+          !__builtin_add_overflow(m_int128_sum, scaled, &m_int128_sum))
+        return false;
+      fold_int128_sum();
+#endif
       my_decimal_add(E_DEC_FATAL_ERROR, dec_buffs + (curr_dec_buff ^ 1), val,
                      dec_buffs + curr_dec_buff);
       curr_dec_buff ^= 1;
-      null_value = false;
     }
   } else {
     sum += aggr->arg_val_real();
@@ -1970,8 +2002,7 @@ longlong Item_sum_sum::val_int() {
   if (aggr) aggr->endup();
   if (hybrid_type == DECIMAL_RESULT) {
     longlong result;
-    my_decimal2int(E_DEC_FATAL_ERROR, dec_buffs + curr_dec_buff, unsigned_flag,
-                   &result);
+    my_decimal2int(E_DEC_FATAL_ERROR, decimal_sum(), unsigned_flag, &result);
     return result;
   }
   return llrint_with_overflow_check(val_real());
@@ -2016,7 +2047,7 @@ double Item_sum_sum::val_real() {
   } else {
     if (aggr) aggr->endup();
     if (hybrid_type == DECIMAL_RESULT)
-      my_decimal2double(E_DEC_FATAL_ERROR, dec_buffs + curr_dec_buff, &sum);
+      my_decimal2double(E_DEC_FATAL_ERROR, decimal_sum(), &sum);
     return sum;
   }
 }
@@ -2066,7 +2097,7 @@ my_decimal *Item_sum_sum::val_decimal(my_decimal *val) {
   }
 
   if (aggr) aggr->endup();
-  if (hybrid_type == DECIMAL_RESULT) return (dec_buffs + curr_dec_buff);
+  if (hybrid_type == DECIMAL_RESULT) return decimal_sum();
   return val_decimal_from_real(val);
 }
 
@@ -2212,6 +2243,137 @@ void Item_sum_count::cleanup() {
   Item_sum_int::cleanup();
 }
 
+bool Item_sum_approx_count_distinct::resolve_type(THD *thd) {
+  if (param_type_is_default(thd, 0, -1)) return true;
+  if (reject_geometry_args(arg_count, args, this)) return true;
+  set_nullable(false);
+  null_value = false;
+  return false;
+}
+
+Item *Item_sum_approx_count_distinct::copy_or_same(THD *thd) {
+  return new (thd->mem_root) Item_sum_approx_count_distinct(thd, this);
+}
+
+void Item_sum_approx_count_distinct::clear() {
+  if (m_registers != nullptr) memset(m_registers, 0, kRegisters);
+}
+
+bool Item_sum_approx_count_distinct::hash_argument(uint64 *hash) {
+  Item *arg = args[0];
+  uchar buffer[DECIMAL_MAX_FIELD_SIZE + 1];
+  size_t length = 0;
+
+  if (arg->is_temporal()) {
+    const longlong value = arg->val_temporal_by_field_type();
+    if (arg->null_value) return true;
+    int8store(buffer, value);
+    length = 8;
+  } else {
+    switch (arg->result_type()) {
+      case INT_RESULT: {
+        const longlong value = arg->val_int();
+        if (arg->null_value) return true;
+        int8store(buffer, value);
+        length = 8;
+        // Keep negative values apart from large unsigned ones.
+        if (value < 0) buffer[length++] = arg->unsigned_flag;
+        break;
+      }
+      case REAL_RESULT: {
+        double value = arg->val_real();
+        if (arg->null_value) return true;
+        if (value == 0.0) value = 0.0;  // Ensure that -0.0 hashes as +0.0.
+        float8store(buffer, value);
+        length = 8;
+        break;
+      }
+      case DECIMAL_RESULT: {
+        my_decimal value_buffer;
+        const my_decimal *value = arg->val_decimal(&value_buffer);
+        if (arg->null_value) return true;
+        // Zero is hashed as the empty string, whatever its scale and sign.
+        if (!decimal_is_zero(value)) {
+          const int scale = value->frac;
+          const int precision = my_decimal_intg(value) + scale;
+          my_decimal2binary(E_DEC_FATAL_ERROR, value, buffer, precision,
+                            scale);
+          length = my_decimal_get_binary_size(precision, scale);
+        }
+        break;
+      }
+      case STRING_RESULT: {
+        StringBuffer<STRING_BUFFER_USUAL_SIZE> value_buffer;
+        const String *value = arg->val_str(&value_buffer);
+        if (arg->null_value || value == nullptr) return true;
+        // Strings equal under the collation must land in the same register.
+        const CHARSET_INFO *cs = arg->collation.collation;
+        uint64 nr1 = 1, nr2 = 4;
+        cs->coll->hash_sort(cs, pointer_cast<const uchar *>(value->ptr()),
+                            value->length(), &nr1, &nr2);
+        int8store(buffer, nr1);
+        length = 8;
+        break;
+      }
+      default:
+        assert(false);
+        return true;
+    }
+  }
+  *hash = MY_XXH64(buffer, length, 0);
+  return false;
+}
+
+bool Item_sum_approx_count_distinct::add() {
+  THD *thd = current_thd;
+  if (m_registers == nullptr) {
+    m_registers = thd->mem_root->ArrayAlloc<uchar>(kRegisters, 0);
+    if (m_registers == nullptr) return true;
+  }
+
+  uint64 hash;
+  if (hash_argument(&hash)) return thd->is_error();
+
+  // The top kPrecision bits select the register; it keeps the highest
+  // position of the first set bit seen among the remaining bits.
+  const size_t index = hash >> (64 - kPrecision);
+  uint64 rest = hash << kPrecision;
+  uchar rank = 1;
+  while (rank <= 64 - kPrecision && (rest & (uint64{1} << 63)) == 0) {
+    rest <<= 1;
+    rank++;
+  }
+  if (rank > m_registers[index]) m_registers[index] = rank;
+  return thd->is_error();
+}
+
+longlong Item_sum_approx_count_distinct::val_int() {
+  assert(fixed);
+  if (m_registers == nullptr) return 0;
+
+  double sum = 0.0;
+  size_t zero_registers = 0;
+  for (size_t i = 0; i < kRegisters; i++) {
+    sum += std::ldexp(1.0, -static_cast<int>(m_registers[i]));
+    if (m_registers[i] == 0) zero_registers++;
+  }
+
+  const double m = static_cast<double>(kRegisters);
+  const double alpha = 0.7213 / (1.0 + 1.079 / m);
+  double estimate = alpha * m * m / sum;
+  // Small cardinalities are estimated better by linear counting. With a
+  // 64-bit hash, no large range correction is needed.
+  if (estimate <= 2.5 * m && zero_registers > 0)
+    estimate = m * std::log(m / static_cast<double>(zero_registers));
+  return static_cast<longlong>(std::llround(estimate));
+}
+
+void Item_sum_approx_count_distinct::cleanup() {
+  // The registers live on the execution mem_root.
+  m_registers = nullptr;
+  Item_sum_int::cleanup();
+}
+
 bool Item_sum_avg::resolve_type(THD *thd) {
   if (Item_sum_sum::resolve_type(thd)) return true;
 
@@ -2379,7 +2541,7 @@ my_decimal *Item_sum_avg::val_decimal(my_decimal *val) {
       return result;
     }
 
-    sum_dec = dec_buffs + curr_dec_buff;
+    sum_dec = decimal_sum();
     int2my_decimal(E_DEC_FATAL_ERROR, m_count, false, &cnt);
     my_decimal_div(E_DEC_FATAL_ERROR, val, sum_dec, &cnt, prec_increment);
     return val;
@@ -2763,6 +2925,8 @@ void Item_sum_variance::update_field() {
 /* min & max */
 
 void Item_sum_hybrid::clear() {
+  m_sliding_values.clear();
+  m_sliding_head = 0;
   value->clear();
   value->store(args[0]);
   arg_cache->clear();
@@ -2804,7 +2968,14 @@ bool Item_sum_hybrid::check_wf_semantics1(THD *thd, Query_block *select,
       }
     }
   }
-  if (!m_optimize) {
+  // Min/max over a moving frame of numbers: keep a sliding window of
+  // candidates instead of revisiting the whole frame for every row.
+  if (!m_optimize && (r->row_optimizable || r->range_optimizable) &&
+      (hybrid_type == INT_RESULT || hybrid_type == REAL_RESULT) &&
+      !args[0]->is_temporal()) {
+    m_sliding = true;
+  }
+  if (!m_optimize && !m_sliding) {
     r->row_optimizable = false;
     r->range_optimizable = false;
   }
@@ -3061,6 +3232,8 @@ void Item_sum_hybrid::cleanup() {
   DBUG_TRACE;
   Item_sum::cleanup();
   if (cmp != nullptr) cmp->cleanup();
+  std::vector<Sliding_value>().swap(m_sliding_values);
+  m_sliding_head = 0;
   /*
     by default it is true to avoid true reporting by
     Item_func_not_all/Item_func_nop_all if this item was never called.
@@ -3106,7 +3279,78 @@ static bool min_max_best_so_far(int comparison_result, bool is_min) {
   return is_min ? comparison_result < 0 : comparison_result > 0;
 }
 
+bool Item_sum_hybrid::add_sliding() {
+  const int64 rowno = m_window->rowno_being_visited();
+  if (m_window->do_inverse()) {
+    // Rows leave the frame in the order they entered it.
+    while (m_sliding_head < m_sliding_values.size() &&
+           m_sliding_values[m_sliding_head].rowno <= rowno) {
+      ++m_sliding_head;
+    }
+    if (m_sliding_head >= 64 && m_sliding_head * 2 >= m_sliding_values.size()) {
+      m_sliding_values.erase(m_sliding_values.begin(),
+                             m_sliding_values.begin() + m_sliding_head);
+      m_sliding_head = 0;
+    }
+  } else {
+    Sliding_value new_value{rowno, 0, 0.0};
+    if (hybrid_type == INT_RESULT)
+      new_value.int_value = args[0]->val_int();
+    else
+      new_value.real_value = args[0]->val_real();
+    if (current_thd->is_error()) return true;
+
+    if (!args[0]->null_value) {
+      const bool is_unsigned = args[0]->unsigned_flag;
+      // Whether “a” is a better min/max than “b”.
+      const auto better = [this, is_unsigned](const Sliding_value &a,
+                                              const Sliding_value &b) {
+        int cmp;
+        if (hybrid_type == REAL_RESULT)
+          cmp = a.real_value < b.real_value
+                    ? -1
+                    : (a.real_value > b.real_value ? 1 : 0);
+        else if (is_unsigned)
+          cmp = static_cast<ulonglong>(a.int_value) <
+                        static_cast<ulonglong>(b.int_value)
+                    ? -1
+                    : (a.int_value != b.int_value ? 1 : 0);
+        else
+          cmp = a.int_value < b.int_value
+                    ? -1
+                    : (a.int_value > b.int_value ? 1 : 0);
+        return min_max_best_so_far(cmp, m_is_min);
+      };
+      // Values that are no better than the new one will never be the
+      // min/max again, since the new one stays in the frame longer.
+      while (m_sliding_values.size() > m_sliding_head &&
+             !better(m_sliding_values.back(), new_value)) {
+        m_sliding_values.pop_back();
+      }
+      m_sliding_values.push_back(new_value);
+      // Without buffering, rows never leave the frame, so only the best
+      // value needs to be kept.
+      if (!m_window->needs_buffering())
+        m_sliding_values.resize(m_sliding_head + 1);
+    }
+  }
+
+  if (m_sliding_head == m_sliding_values.size()) {
+    value->clear();
+    null_value = true;
+    return false;
+  }
+  const Sliding_value &best = m_sliding_values[m_sliding_head];
+  null_value = false;
+  if (hybrid_type == INT_RESULT)
+    down_cast<Item_cache_int *>(value)->store_value(this, best.int_value);
+  else
+    down_cast<Item_cache_real *>(value)->store_value(this, best.real_value);
+  return false;
+}
+
 bool Item_sum_hybrid::add() {
+  if (m_sliding) return add_sliding();
   arg_cache->cache_value();
   if (current_thd->is_error()) {
     return true;
@@ -461,7 +461,8 @@ class Item_sum : public Item_func {
     FIRST_LAST_VALUE_FUNC,
     NTH_VALUE_FUNC,
     ROLLUP_SUM_SWITCHER_FUNC,
-    GEOMETRY_AGGREGATE_FUNC
+    GEOMETRY_AGGREGATE_FUNC,
+    APPROX_COUNT_DISTINCT_FUNC  // APPROX_COUNT_DISTINCT
   };
 
   /**
@@ -1023,6 +1024,23 @@ class Item_sum_sum : public Item_sum_num {
   */
   ulonglong m_frame_null_count;
 
+#ifdef __SIZEOF_INT128__
+  /**
+    Execution state: part of a DECIMAL sum that add() accumulated as an
+    integer scaled by 10^decimals, not yet folded into dec_buffs. Values that
+    do not fit go through dec_buffs directly. See fold_int128_sum().
+  */
+  __int128 m_int128_sum{0};
+#endif
+
+  /// Fold the pending integer part of the sum into dec_buffs.
+  void fold_int128_sum();
+  /// @returns the DECIMAL sum of the rows added so far
+  my_decimal *decimal_sum() {
+    fold_int128_sum();
+    return dec_buffs + curr_dec_buff;
+  }
+
  public:
   Item_sum_sum(const POS &pos, Item *item_par, bool distinct, PT_window *window)
       : Item_sum_num(pos, item_par, window),
@@ -1102,6 +1120,54 @@ class Item_sum_count : public Item_sum_int {
   Item *copy_or_same(THD *thd) override;
 };
 
+/**
+  APPROX_COUNT_DISTINCT(expr): estimates the number of distinct non-NULL
+  values of expr with a HyperLogLog sketch of 2^kPrecision one-byte registers,
+  for a standard error of about 0.8%. Unlike COUNT(DISTINCT), memory use is
+  fixed and nothing is sorted or spilled to disk.
+
+  The sketch of two partial aggregates over the same expression is merged by
+  taking the maximum of each register pair, so the state may be combined
+  independently of the order in which rows were seen.
+
+  Grouping through a temporary table is not supported (the registers do not
+  fit a result field), so the optimizer sorts for GROUP BY instead, as it does
+  for GROUP_CONCAT.
+*/
+class Item_sum_approx_count_distinct : public Item_sum_int {
+  /// Number of hash bits used to select a register.
+  static constexpr uint kPrecision = 14;
+  static constexpr size_t kRegisters = size_t{1} << kPrecision;
+
+  /// Registers; allocated on first add() and released with the statement.
+  uchar *m_registers{nullptr};
+
+  void clear() override;
+  bool add() override;
+  void cleanup() override;
+  /// Hash the current value of args[0]. @returns true if it is NULL.
+  bool hash_argument(uint64 *hash);
+
+ public:
+  Item_sum_approx_count_distinct(const POS &pos, Item *item_par)
+      : Item_sum_int(pos, item_par, nullptr) {
+    allow_group_via_temp_table = false;
+  }
+  Item_sum_approx_count_distinct(THD *thd,
+                                 Item_sum_approx_count_distinct *item)
+      : Item_sum_int(thd, item) {}
+  enum Sumfunctype sum_func() const override {
+    return APPROX_COUNT_DISTINCT_FUNC;
+  }
+  bool resolve_type(THD *thd) override;
+  void no_rows_in_result() override { clear(); }
+  longlong val_int() override;
+  void reset_field() override { assert(0); }
+  void update_field() override { assert(0); }
+  const char *func_name() const override { return "approx_count_distinct"; }
+  Item *copy_or_same(THD *thd) override;
+};
+
 /* Item to get the value of a stored sum function */
 
 class Item_sum_avg;
@@ -1575,6 +1641,39 @@ class Item_sum_hybrid : public Item_sum {
   */
   int64 m_saved_last_value_at;
 
+  /**
+    Set to true when min/max over a moving frame is computed with a sliding
+    window, see add_sliding(). Used when m_optimize is false, but the argument
+    is a number, so that its values are cheap to keep.
+  */
+  bool m_sliding{false};
+
+  /// A value in the sliding window, and the row it was read from.
+  struct Sliding_value {
+    int64 rowno;
+    longlong int_value;
+    double real_value;
+  };
+
+  /**
+    Execution state for m_sliding: the candidates for the min/max of the
+    current frame or of any frame after it, from m_sliding_head onwards.
+    Their row numbers are increasing, and each value is strictly better than
+    all that come after it, so the first one is the min/max of the frame.
+    Entries before m_sliding_head have left the frame, and are removed in
+    bulk, so that all operations are amortized O(1).
+  */
+  std::vector<Sliding_value> m_sliding_values;
+  size_t m_sliding_head{0};
+
+  /**
+    Add the current row to the sliding window, or in inverse mode, remove it,
+    and set the value to that of the first value in the window.
+
+    @return true on error
+  */
+  bool add_sliding();
+
   /**
     This function implements the optimized version of retrieving min/max
     value. When we have "ordered ASC" results in a window, min will always
@@ -30,7 +30,13 @@
 #include "sql/iterators/basic_row_iterators.h"
 
 #include <assert.h>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <new>
 #include <string>
 #include <utility>
 #include <vector>
@@ -38,14 +44,20 @@
 #include "my_base.h"
 #include "my_inttypes.h"
 #include "my_sys.h"
+#include "my_thread.h"
+#include "mysql/psi/mysql_thread.h"
 #include "mysqld_error.h"
 #include "sql/debug_sync.h"
 #include "sql/handler.h"
+#include "sql/iterators/row_batch.h"
 #include "sql/iterators/row_iterator.h"
 #include "sql/mem_root_array.h"
+#include "sql/mysqld.h"  // key_thread_parallel_task
+#include "sql/range_optimizer/range_optimizer.h"  // QUICK_RANGE
 #include "sql/sql_bitmap.h"
 #include "sql/sql_class.h"  // THD
 #include "sql/sql_executor.h"
+#include "sql/sql_lex.h"
 #include "sql/sql_tmp_table.h"
 #include "sql/system_variables.h"
 #include "sql/table.h"
@@ -132,6 +144,26 @@ int IndexScanIterator<true>::Read() {  // Backward read.
 template class IndexScanIterator<true>;
 template class IndexScanIterator<false>;
 
+/**
+  The default implementation of batch reads, used by all iterators that
+  do not have a more efficient way of producing batches: Read one row at a
+  time, copying each into the batch.
+*/
+int RowIterator::ReadBatch(RowBatch *batch) {
+  assert(batch->empty());
+  if (batch->at_eof()) return -1;
+  while (!batch->full()) {
+    const int err = Read();
+    if (err == 1) return 1;
+    if (err == -1) {
+      batch->set_at_eof(true);
+      break;
+    }
+    batch->StoreCurrentRow();
+  }
+  return batch->empty() ? -1 : 0;
+}
+
 /**
   The default implementation of unlock-row method of RowIterator,
   used in all access methods except EQRefIterator.
@@ -275,6 +307,244 @@ int TableScanIterator::Read() {
   return 0;
 }
 
+int TableScanIterator::ReadBatch(RowBatch *batch) {
+  // EXCEPT and INTERSECT need to look at the counter for every row, so they
+  // go through the generic (row-at-a-time) implementation.
+  if (!table()->is_union_or_table()) return RowIterator::ReadBatch(batch);
+
+  assert(batch->empty() && batch->table() == table());
+  if (batch->at_eof()) return -1;
+  handler *const file = table()->file;
+  while (!batch->full()) {
+    const int tmp = file->ha_rnd_next(m_record);
+    if (tmp != 0) {
+      if (tmp == HA_ERR_RECORD_DELETED && !thd()->killed) continue;
+      if (batch->empty() || tmp != HA_ERR_END_OF_FILE) return HandleError(tmp);
+      // Hand out the rows we already have; the next call returns EOF.
+      batch->set_at_eof(true);
+      break;
+    }
+    batch->StoreCurrentRow();
+  }
+  if (m_examined_rows != nullptr) {
+    *m_examined_rows += batch->size();
+  }
+  return 0;
+}
+
+/**
+  The rows gathered from the scan threads of a ParallelTableScanIterator.
+  The scan is run by a driver thread, as handler::parallel_scan() does not
+  return until all the scan threads are done, while the session thread
+  consumes the rows.
+ */
+struct ParallelTableScanIterator::Gather {
+  std::mutex mutex;
+  /// Signalled when a batch is added or removed, and when the scan ends.
+  std::condition_variable cond;
+  /// Batches of rows in the MySQL record format, waiting for Read().
+  std::deque<std::vector<uchar>> batches;
+  /// Scan threads wait for Read() while this many batches are queued.
+  size_t max_batches{0};
+  /// Set by the session thread to make the scan threads stop.
+  bool abort{false};
+  /// Set by the driver thread when the scan has ended.
+  bool done{false};
+  /// The result of handler::parallel_scan().
+  int error{0};
+
+  handler *file{nullptr};
+  size_t row_length{0};
+  void *scan_ctx{nullptr};
+  /// One cookie per scan thread for handler::parallel_scan(); they all
+  /// point to this object.
+  std::vector<void *> thread_ctxs;
+  my_thread_handle driver;
+
+  /// Called by a scan thread for each batch of rows it has read. Returns
+  /// true if the scan should stop.
+  bool Add(uint num_rows, const void *rows) {
+    std::vector<uchar> batch(static_cast<const uchar *>(rows),
+                             static_cast<const uchar *>(rows) +
+                                 size_t{num_rows} * row_length);
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [&] { return abort || batches.size() < max_batches; });
+    if (abort) return true;
+    batches.push_back(std::move(batch));
+    cond.notify_all();
+    return false;
+  }
+
+  void Run() {
+    const int result = file->parallel_scan(
+        scan_ctx, thread_ctxs.data(),
+        [this](void *, ulong, ulong row_len, const ulong *, const ulong *,
+               const ulong *) { return row_len != row_length; },
+        [](void *cookie, uint num_rows, void *rows, uint64_t) {
+          return static_cast<Gather *>(cookie)->Add(num_rows, rows);
+        },
+        [](void *) {});
+    std::lock_guard<std::mutex> lock(mutex);
+    error = result;
+    done = true;
+    cond.notify_all();
+  }
+};
+
+namespace {
+
+extern "C" void *parallel_table_scan_driver(void *arg) {
+  my_thread_init();
+  static_cast<ParallelTableScanIterator::Gather *>(arg)->Run();
+  my_thread_end();
+  my_thread_exit(nullptr);
+  return nullptr;
+}
+
+}  // namespace
+
+ParallelTableScanIterator::ParallelTableScanIterator(
+    THD *thd, TABLE *table, QUICK_RANGE *range, ha_rows *examined_rows,
+    unique_ptr_destroy_only<RowIterator> serial)
+    : TableRowIterator(thd, table),
+      m_range(range),
+      m_examined_rows(examined_rows),
+      m_serial(std::move(serial)) {}
+
+ParallelTableScanIterator::~ParallelTableScanIterator() { EndParallelScan(); }
+
+void ParallelTableScanIterator::EndParallelScan() {
+  if (m_gather == nullptr) return;
+  {
+    std::lock_guard<std::mutex> lock(m_gather->mutex);
+    m_gather->abort = true;
+    m_gather->cond.notify_all();
+  }
+  my_thread_join(&m_gather->driver, nullptr);
+  table()->file->parallel_scan_end(m_gather->scan_ctx);
+  delete m_gather;
+  m_gather = nullptr;
+  m_batch.clear();
+  m_batch_pos = 0;
+}
+
+bool ParallelTableScanIterator::Init() {
+  EndParallelScan();
+
+  handler *const file = table()->file;
+  void *scan_ctx = nullptr;
+  size_t num_threads = 0;
+  int error = 0;
+  if (file->inited != handler::NONE) {
+    error = HA_ERR_WRONG_COMMAND;
+  } else if (m_range == nullptr) {
+    error = file->parallel_scan_init(scan_ctx, &num_threads, false);
+  } else {
+    key_range min_key, max_key;
+    m_range->make_min_endpoint(&min_key);
+    m_range->make_max_endpoint(&max_key);
+    error = file->parallel_range_scan_init(
+        scan_ctx, &num_threads, false,
+        (m_range->flag & NO_MIN_RANGE) ? nullptr : &min_key,
+        (m_range->flag & NO_MAX_RANGE) ? nullptr : &max_key);
+  }
+  if (error != 0 || scan_ctx == nullptr) {
+    // The engine could not start a parallel scan, for instance because all
+    // the parallel read threads are in use. Read the rows the usual way.
+    if (thd()->is_error()) return true;
+    return m_serial->Init();
+  }
+
+  empty_record(table());
+
+  auto gather = new (std::nothrow) Gather;
+  if (gather == nullptr) {
+    file->parallel_scan_end(scan_ctx);
+    my_error(ER_OUTOFMEMORY, MYF(ME_FATALERROR), sizeof(Gather));
+    return true;
+  }
+  gather->file = file;
+  gather->row_length = table()->s->reclength;
+  gather->scan_ctx = scan_ctx;
+  gather->max_batches = 2 * std::max<size_t>(num_threads, 1);
+  gather->thread_ctxs.assign(std::max<size_t>(num_threads, 1), gather);
+
+  my_thread_attr_t attr;
+  my_thread_attr_init(&attr);
+  error = mysql_thread_create(key_thread_parallel_task, &gather->driver, &attr,
+                              parallel_table_scan_driver, gather);
+  my_thread_attr_destroy(&attr);
+  if (error != 0) {
+    file->parallel_scan_end(scan_ctx);
+    delete gather;
+    return m_serial->Init();
+  }
+  m_gather = gather;
+  return false;
+}
+
+int ParallelTableScanIterator::Read() {
+  if (m_gather == nullptr) return m_serial->Read();
+
+  const size_t row_length = m_gather->row_length;
+  if (m_batch_pos == m_batch.size()) {
+    std::unique_lock<std::mutex> lock(m_gather->mutex);
+    while (m_gather->batches.empty() && !m_gather->done) {
+      m_gather->cond.wait_for(lock, std::chrono::milliseconds(100));
+      if (thd()->killed) {
+        lock.unlock();
+        thd()->send_kill_message();
+        return 1;
+      }
+    }
+    if (m_gather->batches.empty()) {
+      const int error = m_gather->error;
+      lock.unlock();
+      if (error != 0) {
+        PrintError(error);
+        return 1;
+      }
+      return -1;
+    }
+    m_batch = std::move(m_gather->batches.front());
+    m_gather->batches.pop_front();
+    m_gather->cond.notify_all();
+    m_batch_pos = 0;
+  }
+
+  memcpy(table()->record[0], &m_batch[m_batch_pos], row_length);
+  m_batch_pos += row_length;
+  if (m_examined_rows != nullptr) {
+    ++*m_examined_rows;
+  }
+  return 0;
+}
+
+bool UseParallelTableScan(THD *thd, const TABLE *table, double num_rows) {
+  const ulonglong min_rows = thd->variables.parallel_table_scan_min_rows;
+  if (min_rows == 0 || thd->lex->sql_command != SQLCOM_SELECT) return false;
+
+  // The gathered rows are consistent reads; locking reads must go through
+  // the handler one row at a time.
+  if (table->reginfo.lock_type != TL_READ ||
+      thd->tx_isolation == ISO_SERIALIZABLE ||
+      thd->tx_isolation == ISO_READ_UNCOMMITTED) {
+    return false;
+  }
+
+  // BLOB and virtual columns point outside the record, so they cannot be
+  // gathered by copying records. The primary key is needed for
+  // handler::position() to work from the record alone.
+  const TABLE_SHARE *share = table->s;
+  if (share->tmp_table != NO_TMP_TABLE || table->part_info != nullptr ||
+      share->blob_fields > 0 || table->vfield != nullptr ||
+      share->primary_key == MAX_KEY) {
+    return false;
+  }
+
+  return num_rows >= static_cast<double>(min_rows);
+}
+
 ZeroRowsIterator::ZeroRowsIterator(THD *thd,
                                    Mem_root_array<TABLE *> pruned_tables)
     : RowIterator(thd), m_pruned_tables(std::move(pruned_tables)) {}
@@ -31,8 +31,10 @@
 
 #include <assert.h>
 #include <sys/types.h>
+#include <vector>
 
 #include "mem_root_deque.h"
+#include "my_alloc.h"
 #include "my_base.h"
 #include "my_inttypes.h"
 #include "sql/iterators/row_iterator.h"
@@ -41,6 +43,7 @@
 class Filesort_info;
 class Item;
 class JOIN;
+class QUICK_RANGE;
 class Sort_result;
 class THD;
 struct IO_CACHE;
@@ -72,6 +75,7 @@ class TableScanIterator final : public TableRowIterator {
 
   bool Init() override;
   int Read() override;
+  int ReadBatch(RowBatch *batch) override;
 
  private:
   uchar *const m_record;
@@ -95,6 +99,67 @@ class TableScanIterator final : public TableRowIterator {
   ha_rows m_stored_rows{0};
 };
 
+/**
+  A full table scan, or a scan of one range of the primary key, that uses
+  the parallel scan interface of the storage engine
+  (handler::parallel_scan_init() and friends): the engine reads and
+  converts the rows with several threads, and Read() hands them out one by
+  one as they are gathered, in no particular order. Conditions and
+  aggregates are still evaluated by the session thread, as Items cannot be
+  evaluated anywhere else. If the engine cannot do the parallel scan, the
+  rows are read with the given serial iterator instead.
+
+  Only fixed-size rows can be gathered, so the table must not have BLOB or
+  virtual columns; see UseParallelTableScan() for the other requirements.
+ */
+class ParallelTableScanIterator final : public TableRowIterator {
+ public:
+  /**
+    @param thd           session context
+    @param table         table to be scanned
+    @param range         range of the primary key to scan, or nullptr to scan
+                         the whole table
+    @param examined_rows if not nullptr, is incremented for each successful
+                         Read()
+    @param serial        iterator that reads the same rows without a parallel
+                         scan
+  */
+  ParallelTableScanIterator(THD *thd, TABLE *table, QUICK_RANGE *range,
+                            ha_rows *examined_rows,
+                            unique_ptr_destroy_only<RowIterator> serial);
+  ~ParallelTableScanIterator() override;
+
+  bool Init() override;
+  int Read() override;
+
+  /// The state shared with the scan threads; see the .cc file.
+  struct Gather;
+
+ private:
+  /// Stop the parallel scan, if one is running, and wait for it to end.
+  void EndParallelScan();
+
+  QUICK_RANGE *const m_range;
+  ha_rows *const m_examined_rows;
+  unique_ptr_destroy_only<RowIterator> m_serial;
+  /// The state shared with the scan threads, nullptr if the rows are read
+  /// with m_serial.
+  Gather *m_gather{nullptr};
+  /// The batch of rows that Read() is returning rows from.
+  std::vector<uchar> m_batch;
+  /// Offset of the next row to return in m_batch.
+  size_t m_batch_pos{0};
+};
+
+/**
+  Whether a scan of the given table that is estimated to return num_rows rows
+  should be done with ParallelTableScanIterator: parallel_table_scan_min_rows
+  is set and num_rows is at least that, the statement is a SELECT doing a
+  consistent (non-locking) read, and the table is a non-partitioned base
+  table with a primary key and without BLOB or virtual columns.
+ */
+bool UseParallelTableScan(THD *thd, const TABLE *table, double num_rows);
+
 /** Perform a full index scan along an index. */
 template <bool Reverse>
 class IndexScanIterator final : public TableRowIterator {
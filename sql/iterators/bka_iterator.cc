@@ -56,6 +56,12 @@ using pack_rows::TableCollection;
 using std::string;
 using std::vector;
 
+/// At most this many lookup keys of a batch are announced to the handler
+/// with handler::prefetch_keys() before the multi-range read starts.
+static constexpr size_t kMaxPrefetchRows = 256;
+/// Number of keys passed to each handler::prefetch_keys() call.
+static constexpr size_t kPrefetchBatchSize = 64;
+
 static bool NeedMatchFlags(JoinType join_type) {
   return join_type == JoinType::OUTER || join_type == JoinType::SEMI ||
          join_type == JoinType::ANTI;
@@ -365,11 +371,51 @@ bool MultiRangeRowIterator::Init() {
      1. MrrInitCallback at the start, to initialize iteration.
      2. MrrNextCallback is called to yield ranges to scan, until it returns 1.
    */
+  if (m_file->prefetch_keys_enabled()) {
+    PrefetchKeys();
+  }
+
   return m_file->multi_range_read_init(&seq_funcs, this,
                                        std::distance(m_begin, m_end),
                                        m_mrr_flags, &m_mrr_buffer);
 }
 
+void MultiRangeRowIterator::PrefetchKeys() {
+  // A single lookup follows right away, so there is nothing to gain.
+  if (std::distance(m_begin, m_end) < 2) return;
+
+  if (m_prefetch_key_buffer == nullptr) {
+    m_prefetch_key_buffer = thd()->mem_root->ArrayAlloc<uchar>(
+        kPrefetchBatchSize * m_ref->key_length);
+    if (m_prefetch_key_buffer == nullptr) return;
+  }
+
+  key_range keys[kPrefetchBatchSize];
+  size_t num_keys = 0;
+  size_t num_rows = 0;
+  for (const BufferRow *row = m_begin;
+       row != m_end && num_rows < kMaxPrefetchRows; ++row, ++num_rows) {
+    LoadBufferRowIntoTableBuffers(m_outer_input_tables, *row);
+    // Any error is raised again when MRR constructs the same key.
+    if (construct_lookup(thd(), table(), m_ref)) return;
+    if (m_ref->impossible_null_ref()) continue;
+
+    uchar *key_copy = m_prefetch_key_buffer + num_keys * m_ref->key_length;
+    memcpy(key_copy, m_ref->key_buff, m_ref->key_length);
+
+    key_range *key = &keys[num_keys];
+    key->key = key_copy;
+    key->length = m_ref->key_length;
+    key->keypart_map = (1 << m_ref->key_parts) - 1;  // All keyparts.
+    key->flag = HA_READ_KEY_EXACT;
+    if (++num_keys == kPrefetchBatchSize) {
+      m_file->prefetch_keys(m_ref->key, keys, num_keys);
+      num_keys = 0;
+    }
+  }
+  if (num_keys > 0) m_file->prefetch_keys(m_ref->key, keys, num_keys);
+}
+
 range_seq_t MultiRangeRowIterator::MrrInitCallback(uint, uint) {
   m_current_pos = m_begin;
   return this;
@@ -376,6 +376,11 @@ class MultiRangeRowIterator final : public TableRowIterator {
   bool MrrSkipIndexTuple(char *range_info);
   bool MrrSkipRecord(char *range_info);
 
+  /// Announce the lookup keys of the first rows in the batch to the handler
+  /// with handler::prefetch_keys(), so that it can start reading the index
+  /// pages they are on before MRR looks them up one by one.
+  void PrefetchKeys();
+
   /// Handler for the table we are reading from.
   handler *const m_file;
 
@@ -403,6 +408,10 @@ class MultiRangeRowIterator final : public TableRowIterator {
   /// See set_match_flag_buffer().
   uchar *m_match_flag_buffer = nullptr;
 
+  /// Copies of the lookup keys passed to handler::prefetch_keys().
+  /// Allocated on first use.
+  uchar *m_prefetch_key_buffer = nullptr;
+
   /// Tables and columns needed for each outer row. Same as m_outer_input_tables
   /// in the corresponding BKAIterator.
   pack_rows::TableCollection m_outer_input_tables;
@@ -27,10 +27,13 @@
 #include <atomic>
 #include <list>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "extra/robin-hood-hashing/robin_hood.h"
 #include "field_types.h"
 #include "mem_root_deque.h"
+#include "my_alloc.h"
 #include "my_dbug.h"
 #include "my_inttypes.h"
 #include "my_sys.h"
@@ -42,9 +45,11 @@
 #include "sql/field.h"
 #include "sql/handler.h"
 #include "sql/item.h"
+#include "sql/item_cmpfunc.h"
 #include "sql/item_func.h"
 #include "sql/item_sum.h"
 #include "sql/iterators/basic_row_iterators.h"
+#include "sql/iterators/row_batch.h"
 #include "sql/iterators/timing_iterator.h"
 #include "sql/join_optimizer/access_path.h"
 #include "sql/join_optimizer/materialize_path_parameters.h"
@@ -52,6 +57,7 @@
 #include "sql/opt_trace.h"
 #include "sql/opt_trace_context.h"
 #include "sql/pfs_batch_mode.h"
+#include "sql/psi_memory_key.h"
 #include "sql/sql_base.h"
 #include "sql/sql_class.h"
 #include "sql/sql_executor.h"
@@ -71,12 +77,197 @@ using std::string;
 using std::swap;
 using std::vector;
 
+FilterIterator::FilterIterator(THD *thd,
+                               unique_ptr_destroy_only<RowIterator> source,
+                               Item *condition)
+    : RowIterator(thd),
+      m_source(std::move(source)),
+      m_condition(condition),
+      m_program(thd->mem_root) {}
+
+bool FilterIterator::Init() {
+  if (!m_compile_attempted) {
+    m_compile_attempted = true;
+    if (thd()->variables.filter_compile_conditions) CompileCondition();
+  }
+  return m_source->Init();
+}
+
+/**
+  Checks whether item is a column that can be read with Field::val_int()
+  and compared as an integer, like Arg_comparator does for integer columns.
+*/
+static bool is_compilable_int_field(const Item *item) {
+  if (item->type() != Item::FIELD_ITEM || item->returns_array()) return false;
+  switch (down_cast<const Item_field *>(item)->field->type()) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void FilterIterator::CompileCondition() {
+  CompileConjuncts(m_condition);
+
+  // Not worth it if no conjunct could be compiled.
+  bool any_compiled = false;
+  for (const Compiled_conjunct &conjunct : m_program) {
+    if (conjunct.opcode != Compiled_conjunct::ITEM) any_compiled = true;
+  }
+  if (!any_compiled || thd()->is_error()) m_program.clear();
+}
+
+void FilterIterator::CompileConjuncts(Item *cond) {
+  Compiled_conjunct conjunct{Compiled_conjunct::ITEM, false, nullptr, cond, 0};
+
+  if (cond->type() == Item::COND_ITEM &&
+      down_cast<Item_cond *>(cond)->functype() == Item_func::COND_AND_FUNC) {
+    for (Item &item : *down_cast<Item_cond *>(cond)->argument_list()) {
+      CompileConjuncts(&item);
+    }
+    return;
+  }
+
+  if (cond->type() == Item::FUNC_ITEM) {
+    Item_func *func = down_cast<Item_func *>(cond);
+    Item **args = func->arguments();
+    switch (func->functype()) {
+      case Item_func::ISNULL_FUNC:
+      case Item_func::ISNOTNULL_FUNC:
+        if (is_compilable_int_field(args[0])) {
+          conjunct.opcode = func->functype() == Item_func::ISNULL_FUNC
+                                ? Compiled_conjunct::IS_NULL
+                                : Compiled_conjunct::IS_NOT_NULL;
+          conjunct.field = down_cast<Item_field *>(args[0])->field;
+        }
+        break;
+      case Item_func::EQ_FUNC:
+      case Item_func::NE_FUNC:
+      case Item_func::LT_FUNC:
+      case Item_func::LE_FUNC:
+      case Item_func::GT_FUNC:
+      case Item_func::GE_FUNC: {
+        // Normalize to <column> <op> <constant>.
+        Item *column = args[0];
+        Item *constant = args[1];
+        Item_func::Functype functype = func->functype();
+        if (!is_compilable_int_field(column)) {
+          std::swap(column, constant);
+          functype = down_cast<Item_bool_func2 *>(func)->rev_functype();
+        }
+        if (!is_compilable_int_field(column) || !constant->basic_const_item() ||
+            constant->result_type() != INT_RESULT)
+          break;
+
+        const longlong value = constant->val_int();
+        if (constant->null_value || thd()->is_error()) break;
+
+        // Mixed signedness is only compiled where both agree on the sign.
+        Field *field = down_cast<Item_field *>(column)->field;
+        const bool field_unsigned = field->is_unsigned();
+        if (field_unsigned != constant->unsigned_flag && value < 0) break;
+
+        switch (functype) {
+          case Item_func::EQ_FUNC:
+            conjunct.opcode = Compiled_conjunct::EQ;
+            break;
+          case Item_func::NE_FUNC:
+            conjunct.opcode = Compiled_conjunct::NE;
+            break;
+          case Item_func::LT_FUNC:
+            conjunct.opcode = Compiled_conjunct::LT;
+            break;
+          case Item_func::LE_FUNC:
+            conjunct.opcode = Compiled_conjunct::LE;
+            break;
+          case Item_func::GT_FUNC:
+            conjunct.opcode = Compiled_conjunct::GT;
+            break;
+          default:
+            conjunct.opcode = Compiled_conjunct::GE;
+            break;
+        }
+        conjunct.is_unsigned = field_unsigned;
+        conjunct.field = field;
+        conjunct.value = value;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  m_program.push_back(conjunct);
+}
+
+bool FilterIterator::EvaluateProgram() const {
+  for (const Compiled_conjunct &conjunct : m_program) {
+    int cmp;
+    switch (conjunct.opcode) {
+      case Compiled_conjunct::ITEM:
+        if (conjunct.item->val_int() == 0) return false;
+        continue;
+      case Compiled_conjunct::IS_NULL:
+        if (!conjunct.field->is_null()) return false;
+        continue;
+      case Compiled_conjunct::IS_NOT_NULL:
+        if (conjunct.field->is_null()) return false;
+        continue;
+      default: {
+        // NULL compares as neither true nor false, which rejects the row.
+        if (conjunct.field->is_null()) return false;
+        const longlong value = conjunct.field->val_int();
+        if (conjunct.is_unsigned) {
+          const ulonglong a = static_cast<ulonglong>(value);
+          const ulonglong b = static_cast<ulonglong>(conjunct.value);
+          cmp = a < b ? -1 : (a > b ? 1 : 0);
+        } else {
+          cmp = value < conjunct.value ? -1 : (value > conjunct.value ? 1 : 0);
+        }
+      }
+    }
+
+    bool result;
+    switch (conjunct.opcode) {
+      case Compiled_conjunct::EQ:
+        result = cmp == 0;
+        break;
+      case Compiled_conjunct::NE:
+        result = cmp != 0;
+        break;
+      case Compiled_conjunct::LT:
+        result = cmp < 0;
+        break;
+      case Compiled_conjunct::LE:
+        result = cmp <= 0;
+        break;
+      case Compiled_conjunct::GT:
+        result = cmp > 0;
+        break;
+      default:
+        result = cmp >= 0;
+        break;
+    }
+    if (!result) return false;
+  }
+  return true;
+}
+
+inline bool FilterIterator::ConditionIsTrue() const {
+  return m_program.empty() ? m_condition->val_int() != 0 : EvaluateProgram();
+}
+
 int FilterIterator::Read() {
   for (;;) {
     int err = m_source->Read();
     if (err != 0) return err;
 
-    bool matched = m_condition->val_int();
+    bool matched = ConditionIsTrue();
 
     if (thd()->killed) {
       thd()->send_kill_message();
@@ -96,6 +287,31 @@ int FilterIterator::Read() {
   }
 }
 
+int FilterIterator::ReadBatch(RowBatch *batch) {
+  for (;;) {
+    int err = m_source->ReadBatch(batch);
+    if (err != 0) return err;
+
+    ha_rows kept = 0;
+    for (ha_rows i = 0; i < batch->size(); ++i) {
+      batch->LoadRow(i);
+      if (ConditionIsTrue()) batch->MoveRow(i, kept++);
+    }
+
+    if (thd()->killed) {
+      thd()->send_kill_message();
+      return 1;
+    }
+
+    /* check for errors evaluating the condition */
+    if (thd()->is_error()) return 1;
+
+    batch->Truncate(kept);
+    if (kept > 0) return 0;
+    if (batch->at_eof()) return -1;
+  }
+}
+
 bool LimitOffsetIterator::Init() {
   if (m_source->Init()) {
     return true;
@@ -196,6 +412,16 @@ bool AggregateIterator::Init() {
     return true;
   }
 
+  // If we read from a single table whose rows can be copied around freely,
+  // fetch the input rows in batches. (This is invisible to the rest of the
+  // iterator, which keeps reading one row at a time through m_source_reader.)
+  if (m_batch == nullptr && m_tables.tables().size() == 1 &&
+      RowBatch::CanBatchTable(m_tables.tables()[0].table)) {
+    m_batch = RowBatch::Create(thd()->mem_root, m_tables.tables()[0].table);
+    if (m_batch == nullptr) return true;
+  }
+  m_source_reader = BatchedRowReader(m_source.get(), m_batch);
+
   // If we have a HAVING after us, it needs to be evaluated within the context
   // of the slice we're in (unless we're in the hypergraph optimizer, which
   // doesn't use slices). However, we might have a sort before us, and
@@ -227,7 +453,7 @@ int AggregateIterator::Read() {
     case READING_FIRST_ROW: {
       // Start the first group, if possible. (If we're not at the first row,
       // we already saw the first row in the new group at the previous Read().)
-      int err = m_source->Read();
+      int err = m_source_reader.Read();
       if (err == -1) {
         m_seen_eof = true;
         m_state = DONE_OUTPUTTING_ROWS;
@@ -306,7 +532,7 @@ int AggregateIterator::Read() {
 
       // Keep reading rows as long as they are part of the existing group.
       for (;;) {
-        int err = m_source->Read();
+        int err = m_source_reader.Read();
         if (err == 1) return 1;  // Error.
 
         if (err == -1) {
@@ -1623,8 +1849,90 @@ class TemptableAggregateIterator final : public TableRowIterator {
   bool using_hash_key() const { return table()->hash_field; }
 
   bool move_table_to_disk(int error, bool was_insert);
+
+  /**
+    Whether the groups can be aggregated in memory, in m_groups, instead of
+    through an index lookup and a row update in the temporary table for every
+    input row. This requires that
+    - the group key (in m_temp_table_param->group_buff) is equal for two rows
+      if and only if its bytes are, which rules out strings (collations),
+      floating-point numbers (-0.0 vs. 0.0) and a few others,
+    - the whole group row is contained in the record buffer, i.e., there
+      are no BLOBs, and
+    - the aggregate functions keep all of their state in the row.
+   */
+  bool can_use_hash_aggregation() const;
+
+  /// Write all groups in m_groups to the temporary table, and clear m_groups.
+  bool write_hashed_groups();
+
+  /**
+    For hash aggregation: the group rows (in record format) seen so far,
+    keyed on the group key. Both are allocated on m_groups_mem_root.
+    When this grows beyond tmp_table_size, the groups are written to the
+    temporary table, and the rest of the input is aggregated directly in
+    the temporary table as usual.
+   */
+  robin_hood::unordered_flat_map<std::string_view, uchar *> m_groups;
+  MEM_ROOT m_groups_mem_root{key_memory_hash_aggregation, 16384};
 };
 
+template <typename Profiler>
+bool TemptableAggregateIterator<Profiler>::can_use_hash_aggregation() const {
+  if (using_hash_key() || table()->s->blob_fields != 0) return false;
+  for (ORDER *group = table()->group; group; group = group->next) {
+    switch (group->field_in_tmp_table->real_type()) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_INT24:
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_LONGLONG:
+      case MYSQL_TYPE_YEAR:
+      case MYSQL_TYPE_NEWDATE:
+      case MYSQL_TYPE_TIME2:
+      case MYSQL_TYPE_DATETIME2:
+      case MYSQL_TYPE_TIMESTAMP2:
+      case MYSQL_TYPE_NEWDECIMAL:
+      case MYSQL_TYPE_ENUM:
+      case MYSQL_TYPE_SET:
+        break;
+      default:
+        return false;
+    }
+  }
+  for (Item_sum **func = m_join->sum_funcs; *func != nullptr; ++func) {
+    switch ((*func)->sum_func()) {
+      case Item_sum::COUNT_FUNC:
+      case Item_sum::SUM_FUNC:
+      case Item_sum::AVG_FUNC:
+      case Item_sum::MIN_FUNC:
+      case Item_sum::MAX_FUNC:
+      case Item_sum::SUM_BIT_FUNC:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+template <typename Profiler>
+bool TemptableAggregateIterator<Profiler>::write_hashed_groups() {
+  for (const auto &[key, record] : m_groups) {
+    memcpy(table()->record[0], record, table()->s->reclength);
+    const int error = table()->file->ha_write_row(table()->record[0]);
+    if (error != 0) {
+      // The groups are distinct, so this can only be the table being full.
+      if (move_table_to_disk(error, /*was_insert=*/true)) return true;
+    } else {
+      m_profiler.IncrementNumRows(1);
+    }
+  }
+  m_groups.clear();
+  m_groups_mem_root.ClearForReuse();
+  return false;
+}
+
 /**
   Move the in-memory temporary table to disk.
 
@@ -1702,6 +2010,11 @@ bool TemptableAggregateIterator<Profiler>::Init() {
   auto end_unique_index =
       create_scope_guard([&] { table()->file->ha_index_end(); });
 
+  bool hash_aggregation = m_join->sum_funcs != nullptr &&
+                          can_use_hash_aggregation();
+  m_groups.clear();
+  m_groups_mem_root.ClearForReuse();
+
   PFSBatchMode pfs_batch_mode(m_subquery_iterator.get());
   for (;;) {
     int read_error = m_subquery_iterator->Read();
@@ -1722,7 +2035,60 @@ bool TemptableAggregateIterator<Profiler>::Init() {
     // See if we have seen this row already; if so, we want to update it,
     // not insert a new one.
     bool group_found;
-    if (using_hash_key()) {
+    uchar **hashed_group = nullptr;
+    if (hash_aggregation) {
+      for (ORDER *group = table()->group; group; group = group->next) {
+        Item *item = *group->item;
+        Field *field = group->field_in_tmp_table;
+        item->save_org_in_field(field);
+        if (item->is_nullable()) {
+          group->buff[-1] = (char)field->is_null();
+          // Don't let a stale value make NULLs compare differently.
+          if (field->is_null()) {
+            memset(field->field_ptr(), 0, field->pack_length());
+          }
+        }
+      }
+      const std::string_view key(
+          pointer_cast<const char *>(m_temp_table_param->group_buff),
+          m_temp_table_param->group_length);
+      const auto it = m_groups.find(key);
+      if (it != m_groups.end()) {
+        memcpy(table()->record[0], it->second, table()->s->reclength);
+        update_tmptable_sum_func(m_join->sum_funcs, table());
+        if (thd()->is_error()) {
+          return true;
+        }
+        memcpy(it->second, table()->record[0], table()->s->reclength);
+        continue;
+      }
+      if (m_groups_mem_root.allocated_size() >
+          thd()->variables.tmp_table_size) {
+        // Out of memory for new groups; move the ones we have into the
+        // temporary table, and continue with the regular aggregation there.
+        if (write_hashed_groups()) {
+          end_unique_index.commit();
+          return true;
+        }
+        hash_aggregation = false;
+        // Writing the groups overwrote the fields copied for this row.
+        if (copy_funcs(m_temp_table_param, thd(), CFT_FIELDS)) return true;
+        // Fall through to a regular lookup, which will not find the group.
+      } else {
+        char *key_copy = m_groups_mem_root.ArrayAlloc<char>(key.size());
+        uchar *record =
+            m_groups_mem_root.ArrayAlloc<uchar>(table()->s->reclength);
+        if (key_copy == nullptr || record == nullptr) return true;
+        memcpy(key_copy, key.data(), key.size());
+        hashed_group =
+            &m_groups.emplace(std::string_view(key_copy, key.size()), record)
+                 .first->second;
+      }
+    }
+    if (hashed_group != nullptr) {
+      // A new group, to be filled in below.
+      group_found = false;
+    } else if (using_hash_key()) {
       /*
         We need to call copy_funcs here in order to get correct value for
         hash_field. However, this call isn't needed so early when
@@ -1848,6 +2214,10 @@ bool TemptableAggregateIterator<Profiler>::Init() {
     if (thd()->is_error()) {
       return true;
     }
+    if (hashed_group != nullptr) {
+      memcpy(*hashed_group, table()->record[0], table()->s->reclength);
+      continue;
+    }
     int error = table()->file->ha_write_row(table()->record[0]);
     if (error != 0) {
       /*
@@ -1878,6 +2248,11 @@ bool TemptableAggregateIterator<Profiler>::Init() {
     }
   }
 
+  if (hash_aggregation && write_hashed_groups()) {
+    end_unique_index.commit();
+    return true;
+  }
+
   table()->file->ha_index_end();
   end_unique_index.commit();
 
@@ -1970,6 +2345,9 @@ WeedoutIterator::WeedoutIterator(THD *thd,
 }
 
 bool WeedoutIterator::Init() {
+  m_rowids.clear();
+  m_rowids_mem_root.ClearForReuse();
+  m_rowids_in_table = false;
   if (m_sj->tmp_table->file->ha_delete_all_rows()) {
     return true;
   }
@@ -2002,6 +2380,20 @@ int WeedoutIterator::Read() {
       }
     }
 
+    if (!m_rowids_in_table) {
+      const std::string_view tuple = store_sj_weedout_rowids(m_sj);
+      if (m_rowids.count(tuple) != 0) continue;  // Duplicate.
+      if (m_rowids_mem_root.allocated_size() <=
+          thd()->variables.tmp_table_size) {
+        char *copy = m_rowids_mem_root.ArrayAlloc<char>(tuple.size());
+        if (copy == nullptr) return 1;
+        memcpy(copy, tuple.data(), tuple.size());
+        m_rowids.emplace(copy, tuple.size());
+        return 0;
+      }
+      if (write_hashed_rowids()) return 1;
+    }
+
     ret = do_sj_dups_weedout(thd(), m_sj);
     if (ret == -1) {
       // Error.
@@ -2017,6 +2409,17 @@ int WeedoutIterator::Read() {
   }
 }
 
+bool WeedoutIterator::write_hashed_rowids() {
+  for (const std::string_view &tuple : m_rowids) {
+    // The tuples are distinct, so only errors can be reported here.
+    if (write_sj_weedout_row(thd(), m_sj, tuple) == -1) return true;
+  }
+  m_rowids.clear();
+  m_rowids_mem_root.ClearForReuse();
+  m_rowids_in_table = true;
+  return false;
+}
+
 RemoveDuplicatesIterator::RemoveDuplicatesIterator(
     THD *thd, unique_ptr_destroy_only<RowIterator> source, JOIN *join,
     Item **group_items, int group_items_size)
@@ -43,17 +43,21 @@
 #include <stdio.h>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "extra/robin-hood-hashing/robin_hood.h"
 #include "my_alloc.h"
 #include "my_base.h"
 #include "my_inttypes.h"
 #include "my_table_map.h"
+#include "sql/iterators/row_batch.h"
 #include "sql/iterators/row_iterator.h"
 #include "sql/join_type.h"
 #include "sql/mem_root_array.h"
 #include "sql/pack_rows.h"
+#include "sql/psi_memory_key.h"
 #include "sql/table.h"
 #include "sql_string.h"
 
@@ -77,13 +81,16 @@ class Temp_table_param;
 class FilterIterator final : public RowIterator {
  public:
   FilterIterator(THD *thd, unique_ptr_destroy_only<RowIterator> source,
-                 Item *condition)
-      : RowIterator(thd), m_source(std::move(source)), m_condition(condition) {}
+                 Item *condition);
 
-  bool Init() override { return m_source->Init(); }
+  bool Init() override;
 
   int Read() override;
 
+  /// Reads a batch from the source and compacts away the rows that do not
+  /// satisfy the condition, until at least one row remains.
+  int ReadBatch(RowBatch *batch) override;
+
   void SetNullRowFlag(bool is_null_row) override {
     m_source->SetNullRowFlag(is_null_row);
   }
@@ -95,8 +102,41 @@ class FilterIterator final : public RowIterator {
   void UnlockRow() override { m_source->UnlockRow(); }
 
  private:
+  /**
+    One conjunct of the condition. Comparisons of an integer column with an
+    integer constant, and IS [NOT] NULL tests of an integer column, are
+    evaluated directly on the Field; any other conjunct is evaluated through
+    its Item.
+  */
+  struct Compiled_conjunct {
+    enum Opcode : uint8_t { EQ, NE, LT, LE, GT, GE, IS_NULL, IS_NOT_NULL, ITEM };
+    Opcode opcode;
+    /// Compare as unsigned values.
+    bool is_unsigned;
+    /// The column, unless opcode is ITEM.
+    Field *field;
+    /// The conjunct, if opcode is ITEM.
+    Item *item;
+    /// The constant compared with.
+    longlong value;
+  };
+
+  /// Tries to compile m_condition into m_program.
+  void CompileCondition();
+  /// Adds the conjuncts of cond to m_program.
+  void CompileConjuncts(Item *cond);
+  /// Evaluates m_program for the current row.
+  bool EvaluateProgram() const;
+
+  /// Evaluates the condition for the current row.
+  bool ConditionIsTrue() const;
+
   unique_ptr_destroy_only<RowIterator> m_source;
   Item *m_condition;
+
+  /// The condition as a list of conjuncts, or empty if not compiled.
+  Mem_root_array<Compiled_conjunct> m_program;
+  bool m_compile_attempted{false};
 };
 
 /**
@@ -302,6 +342,16 @@ class AggregateIterator final : public RowIterator {
    */
   int m_output_slice = -1;
 
+  /**
+    If the input rows come from a single table that can be read in batches
+    (see RowBatch::CanBatchTable()), the buffer holding the current batch.
+    Allocated on the first Init() and reused after that.
+   */
+  RowBatch *m_batch = nullptr;
+
+  /// Where Read() gets its input rows from; wraps m_source and m_batch.
+  BatchedRowReader m_source_reader;
+
   void SetRollupLevel(int level);
 };
 
@@ -676,6 +726,21 @@ class WeedoutIterator final : public RowIterator {
   unique_ptr_destroy_only<RowIterator> m_source;
   SJ_TMP_TABLE *m_sj;
   const table_map m_tables_to_get_rowid_for;
+
+  /// Write all tuples in m_rowids to the temporary table, and clear m_rowids.
+  bool write_hashed_rowids();
+
+  /**
+    The rowid tuples seen so far, allocated on m_rowids_mem_root. Checking
+    a tuple here is much cheaper than a write to the temporary table with
+    its unique index. When this grows beyond tmp_table_size, the tuples are
+    written to the temporary table, which then weeds out the rest of the
+    rows as usual.
+   */
+  robin_hood::unordered_flat_set<std::string_view> m_rowids;
+  MEM_ROOT m_rowids_mem_root{key_memory_hash_join, 16384};
+  /// Whether m_rowids has been moved to the temporary table.
+  bool m_rowids_in_table{false};
 };
 
 /**
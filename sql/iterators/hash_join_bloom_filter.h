@@ -0,0 +1,142 @@
+#ifndef SQL_ITERATORS_HASH_JOIN_BLOOM_FILTER_H_
+#define SQL_ITERATORS_HASH_JOIN_BLOOM_FILTER_H_
+
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include <string.h>
+#include <algorithm>
+#include <cstdint>
+
+#include "my_alloc.h"
+#include "my_xxhash.h"
+
+namespace hash_join_buffer {
+
+/// A Bloom filter over the join keys of the build input of a hash join.
+///
+/// Once the entire build input has been read, a probe row whose join key is
+/// not in the filter cannot have a matching row, neither in the hash table nor
+/// in any of the chunk files on disk. Checking the filter is a lot cheaper than
+/// a lookup in a hash table that does not fit in the CPU caches, and for
+/// on-disk hash join, it saves us from writing the probe row out to a chunk
+/// file in the first place.
+///
+/// The filter is a split block Bloom filter: each key sets one bit in each of
+/// the eight 32-bit words of a single 256-bit block, so that both inserting
+/// and checking a key touches one cache line only. With ten bits per key, the
+/// false positive rate is about 1%.
+class BloomFilter {
+ public:
+  /// The number of bits we aim to spend per key.
+  static constexpr size_t kBitsPerKey = 10;
+
+  /// Allocate the filter on the given MEM_ROOT, sized for the given number of
+  /// keys, but never larger than max_bytes. May be called multiple times; the
+  /// memory is allocated only the first time.
+  ///
+  /// @retval true on OOM.
+  bool Init(MEM_ROOT *mem_root, size_t expected_keys, size_t max_bytes) {
+    if (m_blocks == nullptr) {
+      const size_t wanted_bytes = expected_keys * kBitsPerKey / 8;
+      m_num_blocks = std::max<size_t>(
+          1, std::min(wanted_bytes, max_bytes) / sizeof(Block));
+      m_blocks = mem_root->ArrayAlloc<Block>(m_num_blocks);
+      if (m_blocks == nullptr) return true;
+    }
+    Clear();
+    return false;
+  }
+
+  bool inited() const { return m_blocks != nullptr; }
+
+  /// Remove all keys from the filter.
+  void Clear() {
+    memset(m_blocks, 0, m_num_blocks * sizeof(Block));
+    m_num_keys = 0;
+  }
+
+  /// The number of keys the filter is sized for.
+  size_t capacity() const {
+    return m_num_blocks * sizeof(Block) * 8 / kBitsPerKey;
+  }
+
+  /// The number of keys inserted since the last Clear(). Duplicates are
+  /// counted once per insertion.
+  size_t num_keys() const { return m_num_keys; }
+
+  void Insert(const char *key, size_t length) {
+    const uint64_t hash = Hash(key, length);
+    Block &block = m_blocks[BlockIndex(hash)];
+    for (int i = 0; i < kWordsPerBlock; ++i) {
+      block.words[i] |= BitInWord(hash, i);
+    }
+    ++m_num_keys;
+  }
+
+  /// @returns false if the key is definitely not in the filter.
+  bool MayContain(const char *key, size_t length) const {
+    const uint64_t hash = Hash(key, length);
+    const Block &block = m_blocks[BlockIndex(hash)];
+    for (int i = 0; i < kWordsPerBlock; ++i) {
+      if ((block.words[i] & BitInWord(hash, i)) == 0) return false;
+    }
+    return true;
+  }
+
+ private:
+  static constexpr int kWordsPerBlock = 8;
+
+  struct Block {
+    uint32_t words[kWordsPerBlock];
+  };
+
+  // A seed that differs from the ones used for the hash table and for
+  // partitioning rows into chunk files, so that the three are independent.
+  static constexpr uint64_t kHashSeed = 0x6b3f9d21;
+
+  static uint64_t Hash(const char *key, size_t length) {
+    return MY_XXH64(key, length, kHashSeed);
+  }
+
+  // The upper 32 bits of the hash select the block.
+  size_t BlockIndex(uint64_t hash) const {
+    return static_cast<size_t>(((hash >> 32) * m_num_blocks) >> 32);
+  }
+
+  // The lower 32 bits of the hash select one bit in each word, using a
+  // different odd multiplier for each word.
+  static uint32_t BitInWord(uint64_t hash, int word) {
+    static constexpr uint32_t kSalts[kWordsPerBlock] = {
+        0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+        0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+    return uint32_t{1} << ((static_cast<uint32_t>(hash) * kSalts[word]) >> 27);
+  }
+
+  Block *m_blocks{nullptr};
+  size_t m_num_blocks{0};
+  size_t m_num_keys{0};
+};
+
+}  // namespace hash_join_buffer
+
+#endif  // SQL_ITERATORS_HASH_JOIN_BLOOM_FILTER_H_
@@ -26,6 +26,7 @@
 #include <cstddef>
 #include <cstring>
 #include <iterator>
+#include <exception>
 #include <new>
 #include <unordered_map>
 
@@ -41,6 +42,7 @@
 #include "sql/handler.h"
 #include "sql/item_cmpfunc.h"
 #include "sql/join_optimizer/bit_utils.h"
+#include "sql/parallel_tasks.h"
 #include "sql/psi_memory_key.h"
 #include "sql/sql_class.h"
 #include "sql/sql_executor.h"
@@ -114,19 +116,96 @@ void LoadImmutableStringIntoTableBuffers(const TableCollection &tables,
 
 HashJoinRowBuffer::HashJoinRowBuffer(
     TableCollection tables, std::vector<HashJoinCondition> join_conditions,
-    size_t max_mem_available)
+    size_t max_mem_available, size_t num_build_threads)
     : m_join_conditions(std::move(join_conditions)),
       m_tables(std::move(tables)),
       m_mem_root(key_memory_hash_join, 16384 /* 16 kB */),
       m_overflow_mem_root(key_memory_hash_join, 256),
       m_hash_map(nullptr),
       m_max_mem_available(
-          std::max<size_t>(max_mem_available, 16384 /* 16 kB */)) {
+          std::max<size_t>(max_mem_available, 16384 /* 16 kB */)),
+      m_num_build_threads(std::max<size_t>(num_build_threads, 1)),
+      m_staging_mem_root(key_memory_hash_join, 16384 /* 16 kB */) {
   // Limit is being applied only after the first row.
   m_mem_root.set_max_capacity(0);
+
+  if (m_num_build_threads > 1) {
+    // Use a few partitions per thread, so that an uneven distribution of keys
+    // does not leave the threads idle.
+    m_partition_shift = 64;
+    while (m_num_partitions < 4 * m_num_build_threads &&
+           m_num_partitions < kMaxPartitions) {
+      m_num_partitions *= 2;
+      --m_partition_shift;
+    }
+  }
+}
+
+size_t HashJoinRowBuffer::size() const {
+  if (!partitioned()) return m_hash_map->size();
+  size_t total = 0;
+  for (size_t i = 0; i < m_num_partitions; ++i) {
+    total += m_partitions[i].hash_map->size();
+  }
+  return total;
+}
+
+LinkedImmutableString HashJoinRowBuffer::find(const Key &key) const {
+  const hash_map_type &hash_map =
+      partitioned() ? *m_partitions[PartitionForKey(key)].hash_map
+                    : *m_hash_map;
+  const auto it = hash_map.find(key);
+  return it == hash_map.end() ? LinkedImmutableString{nullptr} : it->second;
+}
+
+LinkedImmutableString HashJoinRowBuffer::first_row() const {
+  if (!partitioned()) {
+    return m_hash_map->empty() ? LinkedImmutableString{nullptr}
+                               : m_hash_map->begin()->second;
+  }
+  for (size_t i = 0; i < m_num_partitions; ++i) {
+    if (!m_partitions[i].hash_map->empty()) {
+      return m_partitions[i].hash_map->begin()->second;
+    }
+  }
+  return LinkedImmutableString{nullptr};
 }
 
 bool HashJoinRowBuffer::Init() {
+  if (partitioned()) {
+    m_row_size_upper_bound = ComputeRowSizeUpperBound(m_tables);
+    if (m_partitions == nullptr) {
+      m_partitions.reset(new (std::nothrow) Partition[m_num_partitions]);
+      if (m_partitions == nullptr) {
+        my_error(ER_OUTOFMEMORY, MYF(ME_FATALERROR),
+                 sizeof(Partition) * m_num_partitions);
+        return true;
+      }
+    }
+    for (size_t i = 0; i < m_num_partitions; ++i) {
+      Partition &partition = m_partitions[i];
+      // Destroy the hash map before clearing the MEM_ROOT it points into.
+      partition.hash_map.reset(new (std::nothrow) hash_map_type(
+          /*bucket_count=*/10, KeyHasher()));
+      if (partition.hash_map == nullptr) {
+        my_error(ER_OUTOFMEMORY, MYF(ME_FATALERROR), sizeof(hash_map_type));
+        return true;
+      }
+      partition.mem_root.ClearForReuse();
+      partition.staged_rows.clear();
+      partition.last_row_seqno = 0;
+      partition.last_row = LinkedImmutableString{nullptr};
+      partition.error = false;
+    }
+    m_staging_mem_root.ClearForReuse();
+    m_num_staged_rows = 0;
+    m_next_seqno = 0;
+    m_partition_bytes = 0;
+    m_last_row_stored = LinkedImmutableString{nullptr};
+    m_initialized = true;
+    return false;
+  }
+
   if (m_hash_map.get() != nullptr) {
     // Reset the unique_ptr, so that the hash map destructors are called before
     // clearing the MEM_ROOT.
@@ -152,6 +231,7 @@ bool HashJoinRowBuffer::Init() {
   }
 
   m_last_row_stored = LinkedImmutableString{nullptr};
+  m_initialized = true;
   return false;
 }
 
@@ -180,34 +260,46 @@ StoreRowResult HashJoinRowBuffer::StoreRow(
     }
   }
 
-  // Store the key in the MEM_ROOT. Note that we will only commit the memory
-  // usage for it if the key was a new one (see the call to emplace() below)..
-  const size_t required_key_bytes =
-      ImmutableStringWithLength::RequiredBytesForEncode(m_buffer.length());
-  ImmutableStringWithLength key;
-
-  std::pair<char *, char *> block = m_mem_root.Peek();
-  if (static_cast<size_t>(block.second - block.first) < required_key_bytes) {
-    // No room in this block; ask for a new one and try again.
-    m_mem_root.ForceNewBlock(required_key_bytes);
-    block = m_mem_root.Peek();
+  if (m_key_filter != nullptr) {
+    m_key_filter->Insert(m_buffer.ptr(), m_buffer.length());
   }
+
+  if (partitioned()) return StageRow(reject_duplicate_keys);
+
+  // Store the key in the MEM_ROOT, unless it is short enough to be stored in
+  // the hash table slot itself. Note that we will only commit the memory usage
+  // for it if the key was a new one (see the call to emplace() below)..
+  StoredKey key;
   size_t bytes_to_commit = 0;
-  if (static_cast<size_t>(block.second - block.first) >= required_key_bytes) {
-    char *ptr = block.first;
-    key = ImmutableStringWithLength::Encode(m_buffer.ptr(), m_buffer.length(),
-                                            &ptr);
-    assert(ptr < block.second);
-    bytes_to_commit = ptr - block.first;
+  if (m_buffer.length() <= StoredKey::kMaxInlineLength) {
+    key = StoredKey::Inline(Key{m_buffer.ptr(), m_buffer.length()});
   } else {
-    char *ptr =
-        pointer_cast<char *>(m_overflow_mem_root.Alloc(required_key_bytes));
-    if (ptr == nullptr) {
-      return StoreRowResult::FATAL_ERROR;
+    const size_t required_key_bytes =
+        ImmutableStringWithLength::RequiredBytesForEncode(m_buffer.length());
+
+    std::pair<char *, char *> block = m_mem_root.Peek();
+    if (static_cast<size_t>(block.second - block.first) < required_key_bytes) {
+      // No room in this block; ask for a new one and try again.
+      m_mem_root.ForceNewBlock(required_key_bytes);
+      block = m_mem_root.Peek();
+    }
+    if (static_cast<size_t>(block.second - block.first) >=
+        required_key_bytes) {
+      char *ptr = block.first;
+      key = StoredKey::External(ImmutableStringWithLength::Encode(
+          m_buffer.ptr(), m_buffer.length(), &ptr));
+      assert(ptr < block.second);
+      bytes_to_commit = ptr - block.first;
+    } else {
+      char *ptr =
+          pointer_cast<char *>(m_overflow_mem_root.Alloc(required_key_bytes));
+      if (ptr == nullptr) {
+        return StoreRowResult::FATAL_ERROR;
+      }
+      key = StoredKey::External(ImmutableStringWithLength::Encode(
+          m_buffer.ptr(), m_buffer.length(), &ptr));
+      // Keep bytes_to_commit == 0; the value is already committed.
     }
-    key = ImmutableStringWithLength::Encode(m_buffer.ptr(), m_buffer.length(),
-                                            &ptr);
-    // Keep bytes_to_commit == 0; the value is already committed.
   }
 
   std::pair<hash_map_type::iterator, bool> key_it_and_inserted;
@@ -258,6 +350,125 @@ StoreRowResult HashJoinRowBuffer::StoreRow(
   }
 }
 
+StoreRowResult HashJoinRowBuffer::StageRow(bool reject_duplicate_keys) {
+  size_t row_size_upper_bound = m_row_size_upper_bound;
+  if (m_tables.has_blob_column()) {
+    row_size_upper_bound = ComputeRowSizeUpperBound(m_tables);
+  }
+
+  // Copy the key (which is in m_buffer) and the packed row to the staging
+  // area; they must stay put until the next Flush().
+  const size_t key_length = m_buffer.length();
+  char *key = pointer_cast<char *>(
+      m_staging_mem_root.Alloc(key_length + row_size_upper_bound));
+  if (key == nullptr) return StoreRowResult::FATAL_ERROR;
+  memcpy(key, m_buffer.ptr(), key_length);
+  char *row = key + key_length;
+  const char *row_end = pointer_cast<const char *>(
+      StoreFromTableBuffersRaw(m_tables, pointer_cast<uchar *>(row)));
+  assert(static_cast<size_t>(row_end - row) <= row_size_upper_bound);
+
+  Partition &partition = m_partitions[PartitionForKey(Key{key, key_length})];
+  try {
+    partition.staged_rows.push_back(
+        StagedRow{++m_next_seqno, key, key_length, row,
+                  static_cast<size_t>(row_end - row)});
+  } catch (const std::bad_alloc &) {
+    return StoreRowResult::FATAL_ERROR;
+  }
+  m_reject_duplicate_keys = reject_duplicate_keys;
+  ++m_num_staged_rows;
+
+  // Insert the staged rows once there are enough of them to keep all threads
+  // busy for a while, or once the staging area itself would push us over the
+  // memory limit.
+  if (m_num_staged_rows >= kStagedRowsPerThread * m_num_build_threads ||
+      m_partition_bytes + m_staging_mem_root.allocated_size() >=
+          m_max_mem_available) {
+    return Flush();
+  }
+  return StoreRowResult::ROW_STORED;
+}
+
+void HashJoinRowBuffer::InsertStagedRows(Partition *partition) {
+  hash_map_type *hash_map = partition->hash_map.get();
+  for (const StagedRow &staged : partition->staged_rows) {
+    const Key key{staged.key, staged.key_length};
+    LinkedImmutableString next_ptr{nullptr};
+    hash_map_type::iterator it;
+    try {
+      it = hash_map->find(key);
+      if (it != hash_map->end()) {
+        if (m_reject_duplicate_keys) continue;
+        next_ptr = it->second;
+      } else {
+        StoredKey stored_key;
+        if (key.size() <= StoredKey::kMaxInlineLength) {
+          stored_key = StoredKey::Inline(key);
+        } else {
+          char *ptr = pointer_cast<char *>(partition->mem_root.Alloc(
+              ImmutableStringWithLength::RequiredBytesForEncode(key.size())));
+          if (ptr == nullptr) {
+            partition->error = true;
+            return;
+          }
+          stored_key = StoredKey::External(
+              ImmutableStringWithLength::Encode(key.data(), key.size(), &ptr));
+        }
+        it = hash_map->emplace(stored_key, LinkedImmutableString{nullptr})
+                 .first;
+      }
+    } catch (const std::exception &) {
+      // Out of memory, or an extremely bad hash function
+      // (should never happen in practice).
+      partition->error = true;
+      return;
+    }
+
+    char *dptr = pointer_cast<char *>(partition->mem_root.Alloc(
+        LinkedImmutableString::RequiredBytesForEncode(staged.row_length)));
+    if (dptr == nullptr) {
+      partition->error = true;
+      return;
+    }
+    it->second = LinkedImmutableString::EncodeHeader(next_ptr, &dptr);
+    memcpy(dptr, staged.row, staged.row_length);
+    partition->last_row_seqno = staged.seqno;
+    partition->last_row = it->second;
+  }
+}
+
+StoreRowResult HashJoinRowBuffer::Flush() {
+  if (!partitioned() || m_num_staged_rows == 0) {
+    return StoreRowResult::ROW_STORED;
+  }
+
+  RunParallelTasks(m_num_partitions, m_num_build_threads, [this](size_t idx) {
+    InsertStagedRows(&m_partitions[idx]);
+  });
+
+  uint64_t last_row_seqno = 0;
+  m_partition_bytes = 0;
+  for (size_t i = 0; i < m_num_partitions; ++i) {
+    Partition &partition = m_partitions[i];
+    if (partition.error) return StoreRowResult::FATAL_ERROR;
+    partition.staged_rows.clear();
+    if (partition.last_row_seqno > last_row_seqno) {
+      last_row_seqno = partition.last_row_seqno;
+      m_last_row_stored = partition.last_row;
+    }
+    m_partition_bytes +=
+        partition.mem_root.allocated_size() +
+        partition.hash_map->calcNumBytesTotal(partition.hash_map->mask() + 1);
+  }
+  m_staging_mem_root.ClearForReuse();
+  m_num_staged_rows = 0;
+
+  return m_partition_bytes >= m_max_mem_available
+             ? StoreRowResult::BUFFER_FULL
+             : StoreRowResult::ROW_STORED;
+}
+
 }  // namespace hash_join_buffer
 
 // From protobuf.
@@ -42,7 +42,9 @@
 /// the hash table key will be the value found in "t2.key", since that is the
 /// join condition that belongs to t2. If we have multiple equalities, they
 /// will be concatenated together in order to form the hash table key. The hash
-/// table key is a std::string_view.
+/// table key is a std::string_view. The hash table is an open-addressing table
+/// (robin_hood::unordered_flat_map), where short keys are kept inline in the
+/// slots, and the rows are kept on the MEM_ROOT (see StoredKey).
 ///
 /// In order to store a row, we use the function StoreFromTableBuffers. See the
 /// comments attached to the function for more details.
@@ -55,9 +57,21 @@
 ///
 /// The primary use case for these classes is, as the name implies,
 /// for implementing hash join.
-
+///
+/// If asked to use more than one build thread, the hash table is split into
+/// several partitions, each with its own hash map and MEM_ROOT, and a row is
+/// placed in the partition given by the top bits of the hash of its key.
+/// StoreRow() then only computes the join key and packs the row into a
+/// staging area (this needs the Items and the tables' record buffers, so it
+/// must happen on the session thread), and every so often, the staged rows
+/// are inserted into their partitions by several threads at the same time.
+/// Since no two threads touch the same partition, the insertion needs no
+/// locking.
+
+#include <assert.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <memory>
 #include <vector>
 
@@ -70,7 +84,9 @@
 #include "prealloced_array.h"
 #include "sql/immutable_string.h"
 #include "sql/item_cmpfunc.h"
+#include "sql/iterators/hash_join_bloom_filter.h"
 #include "sql/pack_rows.h"
+#include "sql/psi_memory_key.h"
 #include "sql/table.h"
 #include "sql_string.h"
 
@@ -106,21 +122,82 @@ namespace hash_join_buffer {
 /// not needed; the key object is only needed when the lookup is done.
 using Key = std::string_view;
 
+/// A key as it is stored in the hash table.
+///
+/// Short keys are stored inline in the hash table slot. This covers all keys
+/// on a single integer column, and all keys on a single string column, since
+/// strings are represented by a hash of their sort key (see
+/// append_hash_for_string_value()). Comparing against an inline key does not
+/// involve following a pointer to somewhere else in memory, which is likely a
+/// cache miss once the hash table is larger than the CPU caches, and neither
+/// does computing its hash value when the hash table grows. Inline keys also
+/// need no memory besides the slot itself.
+///
+/// Longer keys are encoded as an ImmutableStringWithLength on the row buffer's
+/// MEM_ROOT, and the slot holds a pointer to it.
+class StoredKey {
+ public:
+  /// The longest key that can be stored inline. The last byte of the slot holds
+  /// the length of the key.
+  static constexpr size_t kMaxInlineLength = 2 * sizeof(const char *) - 1;
+
+  StoredKey() = default;
+
+  /// Make a key that is stored inline. The key must not be longer than
+  /// kMaxInlineLength.
+  static StoredKey Inline(Key key) {
+    assert(key.size() <= kMaxInlineLength);
+    StoredKey ret;
+    memcpy(ret.m_data, key.data(), key.size());
+    ret.m_data[kMaxInlineLength] = static_cast<char>(key.size());
+    return ret;
+  }
+
+  /// Make a key that points to an encoded string.
+  static StoredKey External(ImmutableStringWithLength str) {
+    static_assert(sizeof(str) <= kMaxInlineLength);
+    StoredKey ret;
+    memcpy(ret.m_data, &str, sizeof(str));
+    ret.m_data[kMaxInlineLength] = kExternal;
+    return ret;
+  }
+
+  bool is_inline() const { return m_data[kMaxInlineLength] != kExternal; }
+
+  Key Decode() const {
+    if (is_inline()) {
+      return {m_data, static_cast<size_t>(m_data[kMaxInlineLength])};
+    }
+    ImmutableStringWithLength str;
+    memcpy(&str, m_data, sizeof(str));
+    return str.Decode();
+  }
+
+  bool operator==(const StoredKey &other) const {
+    return Decode() == other.Decode();
+  }
+
+ private:
+  // Marks a key that is not stored inline. Must be larger than
+  // kMaxInlineLength.
+  static constexpr char kExternal = 0x7f;
+
+  char m_data[kMaxInlineLength + 1];
+};
+
 class KeyEquals {
  public:
   // This is a marker from C++17 that signals to the container that
   // operator() can be called with arguments of which one of the types
-  // differs from the container's key type (ImmutableStringWithLength),
-  // and thus enables map.find(Key). The type itself does not matter.
+  // differs from the container's key type (StoredKey), and thus enables
+  // map.find(Key). The type itself does not matter.
   using is_transparent = void;
 
-  bool operator()(const Key &str1,
-                  const ImmutableStringWithLength &other) const {
+  bool operator()(const Key &str1, const StoredKey &other) const {
     return str1 == other.Decode();
   }
 
-  bool operator()(const ImmutableStringWithLength &str1,
-                  const ImmutableStringWithLength &str2) const {
+  bool operator()(const StoredKey &str1, const StoredKey &str2) const {
     return str1 == str2;
   }
 };
@@ -132,16 +209,16 @@ class KeyHasher {
  public:
   // This is a marker from C++17 that signals to the container that
   // operator() can be called with an argument that differs from the
-  // container's key type (ImmutableStringWithLength), and thus enables
-  // map.find(Key). The type itself does not matter.
+  // container's key type (StoredKey), and thus enables map.find(Key). The
+  // type itself does not matter.
   using is_transparent = void;
 
   size_t operator()(hash_join_buffer::Key key) const {
     return robin_hood::hash_bytes(key.data(), key.size());
   }
 
-  size_t operator()(ImmutableStringWithLength key) const {
-    std::string_view decoded = key.Decode();
+  size_t operator()(const StoredKey &key) const {
+    const Key decoded = key.Decode();
     return robin_hood::hash_bytes(decoded.data(), decoded.size());
   }
 };
@@ -164,7 +241,8 @@ class HashJoinRowBuffer {
   // be used.
   HashJoinRowBuffer(pack_rows::TableCollection tables,
                     std::vector<HashJoinCondition> join_conditions,
-                    size_t max_mem_available_bytes);
+                    size_t max_mem_available_bytes,
+                    size_t num_build_threads = 1);
 
   // Initialize the HashJoinRowBuffer so it is ready to store rows. This
   // function can be called multiple times; subsequent calls will only clear the
@@ -189,33 +267,97 @@ class HashJoinRowBuffer {
   StoreRowResult StoreRow(THD *thd, bool reject_duplicate_keys,
                           bool store_rows_with_null_in_condition);
 
-  size_t size() const { return m_hash_map->size(); }
+  /// Make sure that all rows given to StoreRow() are in the hash table. This
+  /// must be called after the last StoreRow() call before the hash table is
+  /// used for lookups. It is a no-op unless the buffer is partitioned, in
+  /// which case StoreRow() may have left some rows in the staging area.
+  ///
+  /// @retval ROW_STORED all rows were inserted.
+  /// @retval BUFFER_FULL all rows were inserted, and the buffer is full.
+  /// @retval FATAL_ERROR an unrecoverable error occurred (most likely,
+  ///         malloc failed). It is the caller's responsibility to call
+  ///         my_error().
+  StoreRowResult Flush();
 
-  bool empty() const { return m_hash_map->empty(); }
+  /// If set, the join key of every row given to StoreRow() is also inserted
+  /// into the given Bloom filter. Pass nullptr to stop doing so.
+  void set_key_filter(BloomFilter *key_filter) { m_key_filter = key_filter; }
 
-  bool inited() const { return m_hash_map != nullptr; }
+  /// The number of distinct keys in the hash table.
+  size_t size() const;
 
-  using hash_map_type = robin_hood::unordered_flat_map<
-      ImmutableStringWithLength, LinkedImmutableString, KeyHasher, KeyEquals>;
+  bool empty() const { return size() == 0; }
 
-  using hash_map_iterator = hash_map_type::const_iterator;
+  bool inited() const { return Initialized(); }
 
-  hash_map_iterator find(const Key &key) const { return m_hash_map->find(key); }
+  using hash_map_type = robin_hood::unordered_flat_map<
+      StoredKey, LinkedImmutableString, KeyHasher, KeyEquals>;
 
-  hash_map_iterator begin() const { return m_hash_map->begin(); }
+  /// Find the rows stored under the given key.
+  ///
+  /// @returns the first row in the chain of rows having the given key, or
+  ///   nullptr if there are none.
+  LinkedImmutableString find(const Key &key) const;
 
-  hash_map_iterator end() const { return m_hash_map->end(); }
+  /// Get an arbitrary chain of rows (nullptr if the buffer is empty). Used
+  /// when there are no join conditions, and all rows thus have the same key.
+  LinkedImmutableString first_row() const;
 
   LinkedImmutableString LastRowStored() const {
     assert(Initialized());
     return m_last_row_stored;
   }
 
-  bool Initialized() const { return m_hash_map.get() != nullptr; }
+  bool Initialized() const { return m_initialized; }
 
-  bool contains(const Key &key) const { return find(key) != end(); }
+  bool contains(const Key &key) const { return find(key) != nullptr; }
 
  private:
+  /// A row that StoreRow() has packed, but not yet inserted into the
+  /// hash table. Both the key and the row are stored on m_staging_mem_root.
+  struct StagedRow {
+    uint64_t seqno;
+    const char *key;
+    size_t key_length;
+    const char *row;
+    size_t row_length;
+  };
+
+  /// One of the partitions of the hash table, when building with multiple
+  /// threads. All members are only touched by one thread at a time.
+  struct Partition {
+    Partition() : mem_root(key_memory_hash_join, 16384 /* 16 kB */) {}
+
+    MEM_ROOT mem_root;
+    std::unique_ptr<hash_map_type> hash_map;
+
+    /// The staged rows that belong to this partition.
+    std::vector<StagedRow> staged_rows;
+
+    /// The sequence number and location of the last row inserted into this
+    /// partition, for maintaining m_last_row_stored.
+    uint64_t last_row_seqno{0};
+    LinkedImmutableString last_row{nullptr};
+
+    /// Set if inserting a row failed.
+    bool error{false};
+  };
+
+  /// The maximum number of partitions when building with multiple threads.
+  static constexpr size_t kMaxPartitions = 256;
+
+  /// How many rows to stage per build thread before inserting them.
+  static constexpr size_t kStagedRowsPerThread = 4096;
+
+  bool partitioned() const { return m_num_partitions > 1; }
+
+  size_t PartitionForKey(Key key) const {
+    return static_cast<uint64_t>(KeyHasher()(key)) >> m_partition_shift;
+  }
+
+  StoreRowResult StageRow(bool reject_duplicate_keys);
+  void InsertStagedRows(Partition *partition);
+
   const std::vector<HashJoinCondition> m_join_conditions;
 
   // A row can consist of parts from different tables. This structure tells us
@@ -242,6 +384,9 @@ class HashJoinRowBuffer {
   String m_buffer;
   size_t m_row_size_upper_bound;
 
+  // See set_key_filter().
+  BloomFilter *m_key_filter{nullptr};
+
   // The maximum size of the buffer, given in bytes.
   const size_t m_max_mem_available;
 
@@ -253,6 +398,27 @@ class HashJoinRowBuffer {
   // See HashJoinIterator::BuildHashTable() for an example of this.
   LinkedImmutableString m_last_row_stored{nullptr};
 
+  bool m_initialized{false};
+
+  // The number of threads to insert staged rows with, and the number of
+  // partitions (a power of two; 1 if not partitioned). m_partition_shift is
+  // the number of bits to shift a 64-bit hash value right by to get the
+  // partition number.
+  const size_t m_num_build_threads;
+  size_t m_num_partitions{1};
+  int m_partition_shift{0};
+
+  // Used if partitioned() only; m_hash_map, m_mem_root and
+  // m_overflow_mem_root are unused in that case.
+  std::unique_ptr<Partition[]> m_partitions;
+  MEM_ROOT m_staging_mem_root;
+  size_t m_num_staged_rows{0};
+  uint64_t m_next_seqno{0};
+  bool m_reject_duplicate_keys{false};
+
+  // The number of bytes used by the partitions, as of the last Flush().
+  size_t m_partition_bytes{0};
+
   // Fetch the relevant fields from each table, and pack them into m_mem_root
   // as a LinkedImmutableString where the “next” pointer points to “next_ptr”.
   // If that does not work (capacity reached), pack into m_overflow_mem_root
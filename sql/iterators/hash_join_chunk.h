@@ -88,6 +88,9 @@ class HashJoinChunk {
   /// @returns the number of rows in this HashJoinChunk
   ha_rows num_rows() const { return m_num_rows; }
 
+  /// @returns the number of bytes of row data written to this HashJoinChunk
+  ulonglong num_bytes() const { return m_num_bytes; }
+
   /// Write a row to the HashJoinChunk.
   ///
   /// Read the row that lies in the record buffer (record[0]) of the given
@@ -133,6 +136,10 @@ class HashJoinChunk {
   // The number of rows in this chunk file.
   ha_rows m_num_rows{0};
 
+  // The number of bytes of row data in this chunk file (not counting the
+  // length and match flag written before each row).
+  ulonglong m_num_bytes{0};
+
   // The underlying file that is used when reading data to and from disk.
   IO_CACHE m_file;
 
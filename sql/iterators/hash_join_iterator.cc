@@ -58,6 +58,10 @@ using hash_join_buffer::LoadImmutableStringIntoTableBuffers;
 // from doing arithmetic on nullptr, which is undefined behavior.
 static constexpr size_t kZeroKeyLengthHash = 2669509769;
 
+// Loops that move rows between chunk files and the hash table without
+// returning to Read() check for kill once per this many rows.
+static constexpr ha_rows kKilledCheckInterval = 1024;
+
 HashJoinIterator::HashJoinIterator(
     THD *thd, unique_ptr_destroy_only<RowIterator> build_input,
     const Prealloced_array<TABLE *, 4> &build_input_tables,
@@ -79,11 +83,13 @@ HashJoinIterator::HashJoinIterator(
       m_build_input_tables(build_input_tables, store_rowids,
                            tables_to_get_rowid_for),
       m_tables_to_get_rowid_for(tables_to_get_rowid_for),
-      m_row_buffer(m_build_input_tables, join_conditions, max_memory_available),
+      m_row_buffer(m_build_input_tables, join_conditions, max_memory_available,
+                   thd->variables.hash_join_build_threads),
       m_join_conditions(PSI_NOT_INSTRUMENTED, join_conditions.data(),
                         join_conditions.data() + join_conditions.size()),
       m_chunk_files_on_disk(thd->mem_root, kMaxChunks),
       m_estimated_build_rows(estimated_build_rows),
+      m_max_memory_available(max_memory_available),
       m_probe_input_batch_mode(probe_input_batch_mode),
       m_allow_spill_to_disk(allow_spill_to_disk),
       m_join_type(join_type) {
@@ -183,6 +189,19 @@ bool HashJoinIterator::Init() {
     return true;
   }
 
+  // If the build input is a single table whose rows can be copied around
+  // freely, read it in batches. The row IDs are taken from the handler, so
+  // they rule out batching.
+  if (m_build_batch == nullptr && m_build_input_tables.tables().size() == 1 &&
+      !m_build_input_tables.store_rowids()) {
+    TABLE *build_table = m_build_input_tables.tables()[0].table;
+    if (RowBatch::CanBatchTable(build_table)) {
+      m_build_batch = RowBatch::Create(thd()->mem_root, build_table);
+      if (m_build_batch == nullptr) return true;
+    }
+  }
+  m_build_reader = BatchedRowReader(m_build_input.get(), m_build_batch);
+
   // We always start out by doing everything in memory.
   m_hash_join_type = HashJoinType::IN_MEMORY;
   m_write_to_probe_row_saving = false;
@@ -227,6 +246,22 @@ bool HashJoinIterator::Init() {
   m_probe_chunk_current_row = 0;
   m_current_chunk = -1;
 
+  // Collect the join keys of the build input in a Bloom filter, so that probe
+  // rows without a match can be rejected cheaply once the build input has been
+  // read. The filter is sized from the planner's estimate, and gets at most an
+  // eighth of the memory that the hash table can use.
+  m_build_key_filter_complete = false;
+  if (!m_join_conditions.empty()) {
+    const size_t expected_keys = static_cast<size_t>(
+        std::clamp(m_estimated_build_rows, 1024.0, 1e9));
+    if (m_build_key_filter.Init(thd()->mem_root, expected_keys,
+                                m_max_memory_available / 8)) {
+      my_error(ER_OUTOFMEMORY, MYF(0), m_max_memory_available / 8);
+      return true;
+    }
+    m_row_buffer.set_key_filter(&m_build_key_filter);
+  }
+
   PrepareForRequestRowId(m_probe_input_tables.tables(),
                          m_tables_to_get_rowid_for);
 
@@ -289,7 +324,8 @@ static bool WriteRowToChunk(
     const pack_rows::TableCollection &tables,
     const Prealloced_array<HashJoinCondition, 4> &join_conditions,
     const uint32 xxhash_seed, bool row_has_match,
-    bool store_row_with_null_in_join_key, String *join_key_and_row_buffer) {
+    bool store_row_with_null_in_join_key, String *join_key_and_row_buffer,
+    hash_join_buffer::BloomFilter *key_filter = nullptr) {
   assert(!thd->is_error());
   bool null_in_join_key = ConstructJoinKey(
       thd, join_conditions, tables.tables_bitmap(), join_key_and_row_buffer);
@@ -302,6 +338,11 @@ static bool WriteRowToChunk(
     return false;
   }
 
+  if (key_filter != nullptr) {
+    key_filter->Insert(join_key_and_row_buffer->ptr(),
+                       join_key_and_row_buffer->length());
+  }
+
   const uint64_t join_key_hash =
       join_key_and_row_buffer->length() == 0
           ? kZeroKeyLengthHash
@@ -323,14 +364,16 @@ static bool WriteRowToChunk(
 }
 
 // Write all the remaining rows from the given iterator out to chunk files
-// on disk. If the function returns true, an unrecoverable error occurred
-// (IO error etc.).
+// on disk. If "key_filter" is not nullptr, the join key of each row written is
+// also inserted into it. If the function returns true, an unrecoverable error
+// occurred (IO error etc.).
 static bool WriteRowsToChunks(
-    THD *thd, RowIterator *iterator, const pack_rows::TableCollection &tables,
+    THD *thd, BatchedRowReader *iterator, const pack_rows::TableCollection &tables,
     const Prealloced_array<HashJoinCondition, 4> &join_conditions,
     const uint32 xxhash_seed, Mem_root_array<ChunkPair> *chunks,
     bool write_to_build_chunk, bool write_rows_with_null_in_join_key,
-    table_map tables_to_get_rowid_for, String *join_key_buffer) {
+    table_map tables_to_get_rowid_for, String *join_key_buffer,
+    hash_join_buffer::BloomFilter *key_filter) {
   for (;;) {  // Termination condition within loop.
     int res = iterator->Read();
     if (res == 1) {
@@ -348,13 +391,40 @@ static bool WriteRowsToChunks(
     RequestRowId(tables.tables(), tables_to_get_rowid_for);
     if (WriteRowToChunk(thd, chunks, write_to_build_chunk, tables,
                         join_conditions, xxhash_seed, /*row_has_match=*/false,
-                        write_rows_with_null_in_join_key, join_key_buffer)) {
+                        write_rows_with_null_in_join_key, join_key_buffer,
+                        key_filter)) {
       assert(thd->is_error());  // my_error should have been called.
       return true;
     }
   }
 }
 
+// Resize "chunk_pairs" to hold "num_chunks" chunk pairs, and open a chunk file
+// for each of the two inputs in every pair.
+static bool InitializeChunkPairs(size_t num_chunks,
+                                 const pack_rows::TableCollection &probe_tables,
+                                 const pack_rows::TableCollection &build_tables,
+                                 bool include_match_flag_for_probe, uint level,
+                                 Mem_root_array<ChunkPair> *chunk_pairs) {
+  if (chunk_pairs->reserve(num_chunks)) {
+    my_error(ER_OUTOFMEMORY, MYF(ME_FATALERROR),
+             num_chunks * sizeof(ChunkPair));
+    return true;
+  }
+  chunk_pairs->resize(num_chunks);
+  for (ChunkPair &chunk_pair : *chunk_pairs) {
+    chunk_pair.level = level;
+    if (chunk_pair.build_chunk.Init(build_tables, /*uses_match_flags=*/false) ||
+        chunk_pair.probe_chunk.Init(probe_tables,
+                                    include_match_flag_for_probe)) {
+      my_error(ER_TEMP_FILE_WRITE_FAILURE, MYF(0));
+      return true;
+    }
+  }
+
+  return false;
+}
+
 // Initialize all HashJoinChunks for both inputs. When estimating how many
 // chunks we need, we first assume that the estimated row count from the planner
 // is correct. Furthermore, we assume that the current row buffer is
@@ -393,17 +463,18 @@ static bool InitializeChunkFiles(size_t estimated_rows_produced_by_join,
   const size_t num_chunks_pow_2 = my_round_up_to_next_power(num_chunks);
 
   assert(chunk_pairs != nullptr && chunk_pairs->empty());
-  chunk_pairs->resize(num_chunks_pow_2);
-  for (ChunkPair &chunk_pair : *chunk_pairs) {
-    if (chunk_pair.build_chunk.Init(build_tables, /*uses_match_flags=*/false) ||
-        chunk_pair.probe_chunk.Init(probe_tables,
-                                    include_match_flag_for_probe)) {
-      my_error(ER_TEMP_FILE_WRITE_FAILURE, MYF(0));
-      return true;
-    }
-  }
+  return InitializeChunkPairs(num_chunks_pow_2, probe_tables, build_tables,
+                              include_match_flag_for_probe, /*level=*/0,
+                              chunk_pairs);
+}
 
-  return false;
+void HashJoinIterator::FinishBuildKeyFilter() {
+  m_row_buffer.set_key_filter(nullptr);
+  // With many more keys than the filter was sized for, nearly all bits are
+  // set, and checking the filter would be pure overhead.
+  m_build_key_filter_complete =
+      m_build_key_filter.inited() && !m_join_conditions.empty() &&
+      m_build_key_filter.num_keys() <= 2 * m_build_key_filter.capacity();
 }
 
 bool HashJoinIterator::BuildHashTable() {
@@ -451,7 +522,7 @@ bool HashJoinIterator::BuildHashTable() {
 
   PFSBatchMode batch_mode(m_build_input.get());
   for (;;) {  // Termination condition within loop.
-    int res = m_build_input->Read();
+    int res = m_build_reader.Read();
     if (res == 1) {
       assert(thd()->is_error() ||
              thd()->killed);  // my_error should have been called.
@@ -460,6 +531,14 @@ bool HashJoinIterator::BuildHashTable() {
 
     if (res == -1) {
       m_build_iterator_has_more_rows = false;
+      FinishBuildKeyFilter();
+      if (m_row_buffer.Flush() ==
+          hash_join_buffer::StoreRowResult::FATAL_ERROR) {
+        my_error(ER_OUTOFMEMORY, MYF(ME_FATALERROR),
+                 thd()->variables.join_buff_size);
+        return true;
+      }
+
       // If the build input was empty, the result of inner joins and semijoins
       // will also be empty. However, if the build input was empty, the output
       // of antijoins will be all the rows from the probe input.
@@ -514,6 +593,8 @@ bool HashJoinIterator::BuildHashTable() {
           assert(thd()->is_error());  // my_error should have been called.
           return true;
         }
+        m_spill_stats.initial_chunks += m_chunk_files_on_disk.size();
+        m_spill_stats.total_chunks += m_chunk_files_on_disk.size();
 
         // Write out the remaining rows from the build input out to chunk files.
         // The probe input will be written out to chunk files later; we will do
@@ -527,17 +608,20 @@ bool HashJoinIterator::BuildHashTable() {
         //
         // We never write out rows with NULL in condition for the build/right
         // input, as these rows will never match in a join condition.
-        if (WriteRowsToChunks(thd(), m_build_input.get(), m_build_input_tables,
+        if (WriteRowsToChunks(thd(), &m_build_reader, m_build_input_tables,
                               m_join_conditions, kChunkPartitioningHashSeed,
                               &m_chunk_files_on_disk,
                               true /* write_to_build_chunks */,
                               false /* write_rows_with_null_in_join_key */,
                               m_tables_to_get_rowid_for,
-                              &m_temporary_row_and_join_key_buffer)) {
+                              &m_temporary_row_and_join_key_buffer,
+                              m_build_key_filter.inited() ? &m_build_key_filter
+                                                          : nullptr)) {
           assert(thd()->is_error() ||
                  thd()->killed);  // my_error should have been called.
           return true;
         }
+        FinishBuildKeyFilter();
 
         // Flush and position all chunk files from the build input at the
         // beginning.
@@ -563,6 +647,105 @@ bool HashJoinIterator::BuildHashTable() {
   }
 }
 
+// How many chunk pairs to split a chunk pair into when its build chunk holds
+// "chunk_bytes" bytes of row data. Like in InitializeChunkFiles(), we aim a bit
+// below the memory limit, and use a power of two.
+static size_t RepartitionFanout(ulonglong chunk_bytes,
+                                size_t max_memory_available,
+                                size_t max_fanout) {
+  constexpr double kReductionFactor = 0.9;
+  const double reduced_memory =
+      std::max<double>(1, max_memory_available * kReductionFactor);
+  const size_t chunks_needed = std::ceil(chunk_bytes / reduced_memory);
+  return my_round_up_to_next_power(
+      static_cast<uint32_t>(std::clamp<size_t>(chunks_needed, 2, max_fanout)));
+}
+
+bool HashJoinIterator::RepartitionCurrentChunk() {
+  const ChunkPair &current = m_chunk_files_on_disk[m_current_chunk];
+  const uint level = current.level + 1;
+  const ha_rows build_rows = current.build_chunk.num_rows();
+  const size_t fanout =
+      RepartitionFanout(current.build_chunk.num_bytes(),
+                        m_max_memory_available, kMaxRepartitionFanout);
+
+  Mem_root_array<ChunkPair> sub_chunks(thd()->mem_root);
+  if (InitializeChunkPairs(fanout, m_probe_input_tables, m_build_input_tables,
+                           /*include_match_flag_for_probe=*/m_join_type ==
+                               JoinType::OUTER,
+                           level, &sub_chunks)) {
+    assert(thd()->is_error());  // my_error should have been called.
+    return true;
+  }
+
+  // All rows in the current chunk pair have the same hash value modulo the
+  // number of chunks on the levels above, so we need a different seed for each
+  // level to spread them out. The rows are loaded through a separate buffer, as
+  // BLOB columns in the record buffers point into the buffer the row was loaded
+  // from, and m_temporary_row_and_join_key_buffer is overwritten when the row
+  // is written out again. Everything that made it into the chunk files must
+  // survive, so rows with NULL in the join key are kept.
+  const uint32_t xxhash_seed = kChunkPartitioningHashSeed + level;
+  String row_buffer;
+  ChunkPair &chunk_pair = m_chunk_files_on_disk[m_current_chunk];
+  for (const bool build : {true, false}) {
+    HashJoinChunk &chunk =
+        build ? chunk_pair.build_chunk : chunk_pair.probe_chunk;
+    // The build chunk is rewound when we are done writing to it, but the probe
+    // chunk is not.
+    if (!build && chunk.Rewind()) return true;
+    const pack_rows::TableCollection &tables =
+        build ? m_build_input_tables : m_probe_input_tables;
+    for (ha_rows row = 0; row < chunk.num_rows(); ++row) {
+      if ((row % kKilledCheckInterval) == 0 && thd()->killed) {
+        thd()->send_kill_message();
+        return true;
+      }
+      bool matched = false;
+      if (chunk.LoadRowFromChunk(&row_buffer, &matched) ||
+          WriteRowToChunk(thd(), &sub_chunks, build, tables, m_join_conditions,
+                          xxhash_seed, matched,
+                          /*store_row_with_null_in_join_key=*/true,
+                          &m_temporary_row_and_join_key_buffer)) {
+        assert(thd()->is_error());  // my_error should have been called.
+        return true;
+      }
+    }
+    if (thd()->killed) {
+      thd()->send_kill_message();
+      return true;
+    }
+  }
+
+  // If one of the new build chunks got all the rows, the rows are all equal
+  // on the join key, and further repartitioning will not help.
+  bool split_failed = false;
+  for (ChunkPair &sub_chunk : sub_chunks) {
+    if (sub_chunk.build_chunk.Rewind()) return true;
+    if (sub_chunk.build_chunk.num_rows() == build_rows) split_failed = true;
+  }
+  if (split_failed) {
+    for (ChunkPair &sub_chunk : sub_chunks) {
+      sub_chunk.level = kMaxRepartitionLevels;
+    }
+  }
+
+  // Replace the current chunk pair (closing its files) with the first of the
+  // new chunk pairs, and process the rest of them at the end.
+  chunk_pair = std::move(sub_chunks[0]);
+  for (size_t i = 1; i < sub_chunks.size(); ++i) {
+    if (m_chunk_files_on_disk.push_back(std::move(sub_chunks[i]))) {
+      my_error(ER_OUTOFMEMORY, MYF(ME_FATALERROR), sizeof(ChunkPair));
+      return true;
+    }
+  }
+
+  ++m_spill_stats.repartitioned_chunks;
+  m_spill_stats.total_chunks += fanout - 1;
+  m_spill_stats.max_level = std::max(m_spill_stats.max_level, level);
+  return false;
+}
+
 bool HashJoinIterator::ReadNextHashJoinChunk() {
   // See if we should proceed to the next pair of chunk files. In general,
   // it works like this; if we are at the end of the build chunk, move to the
@@ -583,6 +766,11 @@ bool HashJoinIterator::ReadNextHashJoinChunk() {
   }
 
   if (move_to_next_chunk) {
+    // Close the chunk files we are done with, so that the number of open files
+    // stays bounded when repartitioning adds more chunk pairs.
+    if (m_current_chunk != -1) {
+      m_chunk_files_on_disk[m_current_chunk] = ChunkPair();
+    }
     m_current_chunk++;
     m_build_chunk_current_row = 0;
 
@@ -597,6 +785,42 @@ bool HashJoinIterator::ReadNextHashJoinChunk() {
     return false;
   }
 
+  if (move_to_next_chunk) {
+    // If the build chunk is too large for the hash table, split it into
+    // smaller chunks instead of reading the probe chunk once per refill of the
+    // hash table. There is no point in doing so if the probe chunk is empty.
+    for (;;) {
+      const ChunkPair &chunk_pair = m_chunk_files_on_disk[m_current_chunk];
+      const size_t fanout =
+          RepartitionFanout(chunk_pair.build_chunk.num_bytes(),
+                            m_max_memory_available, kMaxRepartitionFanout);
+      const size_t open_chunk_pairs =
+          m_chunk_files_on_disk.size() - m_current_chunk;
+      if (chunk_pair.level >= kMaxRepartitionLevels ||
+          chunk_pair.probe_chunk.num_rows() == 0 ||
+          chunk_pair.build_chunk.num_bytes() <= m_max_memory_available ||
+          open_chunk_pairs + fanout - 1 > kMaxChunks) {
+        break;
+      }
+      if (RepartitionCurrentChunk()) {
+        assert(thd()->is_error() ||
+               thd()->killed);  // my_error should have been called.
+        return true;
+      }
+    }
+
+    const HashJoinChunk &build_chunk =
+        m_chunk_files_on_disk[m_current_chunk].build_chunk;
+    m_spill_stats.max_build_chunk_rows =
+        std::max(m_spill_stats.max_build_chunk_rows, build_chunk.num_rows());
+    m_spill_stats.max_build_chunk_bytes =
+        std::max(m_spill_stats.max_build_chunk_bytes, build_chunk.num_bytes());
+  } else {
+    // We are reading the rest of a build chunk that did not fit in the hash
+    // table.
+    ++m_spill_stats.hash_table_refills;
+  }
+
   if (InitRowBuffer()) {
     return true;
   }
@@ -608,6 +832,12 @@ bool HashJoinIterator::ReadNextHashJoinChunk() {
   const bool store_rows_with_null_in_join_key = m_join_type == JoinType::OUTER;
   for (; m_build_chunk_current_row < build_chunk.num_rows();
        ++m_build_chunk_current_row) {
+    if ((m_build_chunk_current_row % kKilledCheckInterval) == 0 &&
+        thd()->killed) {
+      thd()->send_kill_message();
+      return true;
+    }
+
     // Read the next row from the chunk file, and put it in the in-memory row
     // buffer. If the buffer goes full, do the probe phase against the rows we
     // managed to put in the buffer and continue reading where we left in the
@@ -644,6 +874,14 @@ bool HashJoinIterator::ReadNextHashJoinChunk() {
     assert(store_row_result == hash_join_buffer::StoreRowResult::ROW_STORED);
   }
 
+  // All rows must be in the hash table before we start probing it. (If
+  // the buffer went full above, StoreRow() has already done this.)
+  if (m_row_buffer.Flush() == hash_join_buffer::StoreRowResult::FATAL_ERROR) {
+    my_error(ER_OUTOFMEMORY, MYF(ME_FATALERROR),
+             thd()->variables.join_buff_size);
+    return true;
+  }
+
   // Prepare to do a lookup in the hash table for all rows from the probe
   // chunk.
   if (m_chunk_files_on_disk[m_current_chunk].probe_chunk.Rewind()) {
@@ -851,11 +1089,7 @@ void HashJoinIterator::LookupProbeRowInHashTable() {
   if (m_join_conditions.empty()) {
     // Skip the call to find() in case we don't have any join conditions.
     // TODO(sgunders): Is this relevant for performance anymore?
-    if (m_row_buffer.empty()) {
-      m_current_row = LinkedImmutableString{nullptr};
-    } else {
-      m_current_row = m_row_buffer.begin()->second;
-    }
+    m_current_row = m_row_buffer.first_row();
     m_state = State::READING_FIRST_ROW_FROM_HASH_TABLE;
     return;
   }
@@ -879,15 +1113,27 @@ void HashJoinIterator::LookupProbeRowInHashTable() {
     return;
   }
 
+  if (m_build_key_filter_complete &&
+      !m_build_key_filter.MayContain(
+          m_temporary_row_and_join_key_buffer.ptr(),
+          m_temporary_row_and_join_key_buffer.length())) {
+    // There is no matching row in the hash table nor in any of the chunk
+    // files. Inner joins and semijoins can skip the row right away, just like
+    // rows with NULL in the join key. Antijoins and outer joins must treat it
+    // as any other row without a match.
+    if (m_join_type == JoinType::ANTI || m_join_type == JoinType::OUTER) {
+      m_current_row = LinkedImmutableString{nullptr};
+      m_state = State::READING_FIRST_ROW_FROM_HASH_TABLE;
+    } else {
+      SetReadingProbeRowState();
+    }
+    return;
+  }
+
   hash_join_buffer::Key key{m_temporary_row_and_join_key_buffer.ptr(),
                             m_temporary_row_and_join_key_buffer.length()};
 
-  auto it = m_row_buffer.find(key);
-  if (it == m_row_buffer.end()) {
-    m_current_row = LinkedImmutableString{nullptr};
-  } else {
-    m_current_row = it->second;
-  }
+  m_current_row = m_row_buffer.find(key);
 
   m_state = State::READING_FIRST_ROW_FROM_HASH_TABLE;
 }
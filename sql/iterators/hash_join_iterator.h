@@ -36,6 +36,7 @@
 #include "sql/item_cmpfunc.h"
 #include "sql/iterators/hash_join_buffer.h"
 #include "sql/iterators/hash_join_chunk.h"
+#include "sql/iterators/row_batch.h"
 #include "sql/iterators/row_iterator.h"
 #include "sql/join_type.h"
 #include "sql/mem_root_array.h"
@@ -49,6 +50,31 @@ class THD;
 struct ChunkPair {
   HashJoinChunk probe_chunk;
   HashJoinChunk build_chunk;
+
+  // How many times the rows in this pair have been repartitioned. Chunk pairs
+  // created when the hash join first spills to disk are at level 0.
+  uint level{0};
+};
+
+/// Statistics about how a hash join has used chunk files on disk. Exposed
+/// through EXPLAIN ANALYZE; all counters are zero if the join ran in memory.
+struct HashJoinSpillStats {
+  /// The number of chunk pairs created when the join first spilled to disk.
+  size_t initial_chunks{0};
+  /// The total number of chunk pairs, including the ones created by
+  /// repartitioning.
+  size_t total_chunks{0};
+  /// The number of chunk pairs that were too large for the hash table and were
+  /// split into smaller chunk pairs.
+  size_t repartitioned_chunks{0};
+  /// The deepest level of repartitioning that was reached.
+  uint max_level{0};
+  /// The number of times the hash table had to be refilled from a build chunk
+  /// that did not fit in memory, causing the probe chunk to be read again.
+  size_t hash_table_refills{0};
+  /// The size of the largest build chunk that was loaded into the hash table.
+  ha_rows max_build_chunk_rows{0};
+  ulonglong max_build_chunk_bytes{0};
 };
 
 /// @file
@@ -156,14 +182,23 @@ struct ChunkPair {
 /// spilling to disk, we lose any reasonable ordering properties.
 ///
 /// Note that we still might end up in a case where a single chunk file from
-/// disk won't fit into memory. This is resolved by reading as much as possible
-/// into the hash table, and then reading the entire probe chunk file for each
-/// time the hash table is reloaded. This might happen if we have a very skewed
-/// data set, for instance.
+/// disk won't fit into memory, either because the planner underestimated the
+/// size of the build input, or because we hit the limit on the number of chunk
+/// files. Before such a chunk pair is loaded, it is repartitioned: both the
+/// build and the probe chunk are read back and split into a set of smaller
+/// chunk pairs, using a different hash seed than the one used for the level
+/// above (see RepartitionCurrentChunk()). This is done recursively, up to
+/// "kMaxRepartitionLevels" levels. If the chunk still does not fit (this might
+/// happen if we have a very skewed data set, where many rows share the same
+/// join key), we fall back to reading as much as possible into the hash table,
+/// and then reading the entire probe chunk file for each time the hash table
+/// is reloaded.
 ///
 /// When we start spilling to disk, we allocate a maximum of "kMaxChunks"
 /// chunk files on disk for each of the two inputs. The reason for having an
-/// upper limit is to avoid running out of file descriptors.
+/// upper limit is to avoid running out of file descriptors. Chunk pairs are
+/// closed as soon as they are processed, and repartitioning is only done if
+/// the number of open chunk pairs stays within the same limit.
 ///
 /// There is also a flag we can set to avoid hash join spilling to disk
 /// regardless of the input size. If the flag is set, the join algorithm works
@@ -340,6 +375,9 @@ class HashJoinIterator final : public RowIterator {
 
   int ChunkCount() { return m_chunk_files_on_disk.size(); }
 
+  /// @returns statistics about chunk file usage, for EXPLAIN ANALYZE
+  const HashJoinSpillStats &spill_stats() const { return m_spill_stats; }
+
  private:
   /// Read all rows from the build input and store the rows into the in-memory
   /// hash table. If the hash table goes full, the rest of the rows are written
@@ -348,12 +386,28 @@ class HashJoinIterator final : public RowIterator {
   /// @retval true in case of error
   bool BuildHashTable();
 
+  /// Called when the entire build input has been read (into the hash table
+  /// and/or chunk files). Stops collecting join keys into m_build_key_filter,
+  /// and starts using it for rejecting probe rows, unless it got too full to
+  /// be of any use.
+  void FinishBuildKeyFilter();
+
   /// Read all rows from the next chunk file into the in-memory hash table.
   /// See the class comment for details.
   ///
   /// @retval true in case of error
   bool ReadNextHashJoinChunk();
 
+  /// Split the current chunk pair into a number of smaller chunk pairs, so
+  /// that each new build chunk (hopefully) fits into the hash table. The first
+  /// of the new chunk pairs replaces the current one, and the rest are appended
+  /// to the list of chunk pairs. If the split did not make the build chunk any
+  /// smaller (all rows have the same join key), the new chunk pairs are marked
+  /// so that they are not repartitioned again.
+  ///
+  /// @retval true in case of error. my_error has been called.
+  bool RepartitionCurrentChunk();
+
   /// Read a single row from the probe iterator input into the tables' record
   /// buffers. If we have started spilling to disk, the row is written out to a
   /// chunk file on disk as well.
@@ -504,6 +558,13 @@ class HashJoinIterator final : public RowIterator {
   const unique_ptr_destroy_only<RowIterator> m_build_input;
   const unique_ptr_destroy_only<RowIterator> m_probe_input;
 
+  // If the build input can be read in batches (see RowBatch::CanBatchTable()),
+  // the batch buffer; allocated on the first Init(). The build input is always
+  // read through m_build_reader, which falls back to row-at-a-time reads if
+  // there is no batch.
+  RowBatch *m_build_batch{nullptr};
+  BatchedRowReader m_build_reader;
+
   // The last row that was read from the hash table, or nullptr if none.
   // All rows under the same key are linked together (see the documentation
   // for LinkedImmutableString), so this allows iterating through the rows
@@ -526,6 +587,14 @@ class HashJoinIterator final : public RowIterator {
   // A list of the join conditions (all of them are equi-join conditions).
   Prealloced_array<HashJoinCondition, 4> m_join_conditions;
 
+  // A Bloom filter over the join keys of all rows in the build input, whether
+  // they went into the hash table or into a chunk file. It can only be used for
+  // rejecting probe rows once the whole build input has been read, which is
+  // what m_build_key_filter_complete tells. That is never the case for the
+  // hash join type IN_MEMORY_WITH_HASH_TABLE_REFILL until the last refill.
+  hash_join_buffer::BloomFilter m_build_key_filter;
+  bool m_build_key_filter_complete{false};
+
   // Array to hold the list of chunk files on disk in case we degrade into
   // on-disk hash join.
   Mem_root_array<ChunkPair> m_chunk_files_on_disk;
@@ -560,6 +629,18 @@ class HashJoinIterator final : public RowIterator {
   // should be placed in.
   static constexpr size_t kMaxChunks = 128;
 
+  // How many times a chunk pair can be repartitioned, and the maximum number of
+  // chunk pairs each repartitioning splits a chunk pair into.
+  static constexpr uint kMaxRepartitionLevels = 3;
+  static constexpr size_t kMaxRepartitionFanout = 16;
+
+  // The amount of memory available for the hash table. Used to decide whether
+  // a build chunk must be repartitioned before it is loaded.
+  const size_t m_max_memory_available;
+
+  // Statistics about chunk file usage. See spill_stats().
+  HashJoinSpillStats m_spill_stats;
+
   // A buffer that is used during two phases:
   // 1) when constructing a join key from join conditions.
   // 2) when moving a row between tables' record buffers and the hash table.
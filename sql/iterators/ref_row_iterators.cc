@@ -43,6 +43,7 @@
 #include "sql/item_sum.h"  // Item_sum
 #include "sql/iterators/basic_row_iterators.h"
 #include "sql/iterators/ref_row_iterators.h"
+#include "sql/iterators/row_batch.h"
 #include "sql/iterators/row_iterator.h"
 #include "sql/iterators/timing_iterator.h"
 #include "sql/join_optimizer/access_path.h"
@@ -334,10 +335,89 @@ static bool init_index(TABLE *table, handler *file, uint idx, bool sorted) {
   return false;
 }
 
+/**
+  Whether RefIterator may answer lookups from an in-memory copy of the table
+  instead of the index. This requires that the copied rows are exactly what
+  the index lookups would have returned, so
+  - the table must be a base table that nobody writes to during the
+    statement, and whose rows can be copied (see RowBatch::CanBatchTable()),
+  - the handler must not filter rows with pushed conditions, since those may
+    depend on the outer row,
+  - the lookup must be a plain equality on whole key parts, of types whose
+    key images compare equal exactly when the values are equal (no
+    collations, no NULLs),
+  - the row ID must be computable from the record alone, for consumers that
+    call handler::position(), and
+  - all of the table must be expected to fit in join_buffer_size.
+ */
+static bool CanHashLookups(THD *thd, const TABLE *table,
+                           const Index_lookup *ref) {
+  if (thd->variables.join_ref_hash_threshold == 0) return false;
+  if (!RowBatch::CanBatchTable(table) || table->s->tmp_table != NO_TMP_TABLE ||
+      table->pos_in_table_list == nullptr ||
+      !table->pos_in_table_list->is_base_table()) {
+    return false;
+  }
+  const handler *file = table->file;
+  if (file->pushed_idx_cond != nullptr || file->pushed_cond != nullptr) {
+    return false;
+  }
+  if ((file->ha_table_flags() & HA_PRIMARY_KEY_REQUIRED_FOR_POSITION) == 0 ||
+      table->s->primary_key == MAX_KEY) {
+    return false;
+  }
+  if (ref->keypart_hash != nullptr) return false;
+  const KEY &key = table->key_info[ref->key];
+  if (key.flags & (HA_MULTI_VALUED_KEY | HA_FULLTEXT | HA_SPATIAL)) {
+    return false;
+  }
+  for (uint part_idx = 0; part_idx < ref->key_parts; ++part_idx) {
+    if (ref->cond_guards != nullptr && ref->cond_guards[part_idx] != nullptr) {
+      return false;
+    }
+    const KEY_PART_INFO &key_part = key.key_part[part_idx];
+    if (key_part.field->is_nullable() ||
+        (key_part.key_part_flag & HA_PART_KEY_SEG)) {
+      return false;
+    }
+    switch (key_part.field->real_type()) {
+      case MYSQL_TYPE_TINY:
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_INT24:
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_LONGLONG:
+      case MYSQL_TYPE_YEAR:
+      case MYSQL_TYPE_NEWDATE:
+      case MYSQL_TYPE_TIME2:
+      case MYSQL_TYPE_DATETIME2:
+      case MYSQL_TYPE_TIMESTAMP2:
+      case MYSQL_TYPE_NEWDECIMAL:
+      case MYSQL_TYPE_ENUM:
+      case MYSQL_TYPE_SET:
+        break;
+      default:
+        return false;
+    }
+  }
+  const double expected_bytes =
+      static_cast<double>(file->stats.records) *
+      (table->s->reclength + ref->key_length + 4 * sizeof(uchar *));
+  return expected_bytes <= thd->variables.join_buff_size;
+}
+
 template <bool Reverse>
 bool RefIterator<Reverse>::Init() {
   m_first_record_since_init = true;
   m_is_mvi_unique_filter_enabled = false;
+  if (m_lookups_before_hashing == 0) {
+    // Reading the whole table costs about as much as doing one lookup per
+    // row, so don't switch before that, even if the threshold is lower.
+    m_lookups_before_hashing =
+        !Reverse && CanHashLookups(thd(), table(), m_ref)
+            ? std::max<ha_rows>(thd()->variables.join_ref_hash_threshold,
+                                table()->file->stats.records)
+            : HA_POS_ERROR;
+  }
   if (table()->file->inited) return false;
   if (init_index(table(), table()->file, m_ref->key, m_use_order)) {
     return true;
@@ -377,6 +457,18 @@ int RefIterator<false>::Read() {  // Forward read.
       return -1;
     }
 
+    if (!m_use_hash_table &&
+        ++m_num_index_lookups > m_lookups_before_hashing) {
+      if (BuildHashTable()) return 1;
+    }
+    if (m_use_hash_table) {
+      ++m_num_hashed_lookups;
+      const auto it = m_hash_table.find(std::string_view(
+          pointer_cast<const char *>(m_ref->key_buff), m_ref->key_length));
+      m_next_hashed_row = it == m_hash_table.end() ? nullptr : it->second.first;
+      return ReadHashedRow();
+    }
+
     pair<uchar *, key_part_map> key_buff_and_map = FindKeyBufferAndMap(m_ref);
     int error = table()->file->ha_index_read_map(
         table()->record[0], key_buff_and_map.first, key_buff_and_map.second,
@@ -384,6 +476,8 @@ int RefIterator<false>::Read() {  // Forward read.
     if (error) {
       return HandleError(error);
     }
+  } else if (m_use_hash_table) {
+    return ReadHashedRow();
   } else {
     int error = 0;
     // Fetch unique rows matching the Ref Key in case of multi-value index
@@ -461,6 +555,75 @@ int RefIterator<true>::Read() {  // Reverse read.
   return 0;
 }
 
+template <bool Reverse>
+bool RefIterator<Reverse>::BuildHashTable() {
+  // Whatever happens, this is tried only once.
+  m_lookups_before_hashing = HA_POS_ERROR;
+
+  TABLE *const tab = table();
+  const KEY &key = tab->key_info[m_ref->key];
+  const size_t record_size = tab->s->reclength;
+  uchar key_image[MAX_KEY_LENGTH];
+
+  // The handler is already set up for reading this index, so scan it from
+  // the start, which also keeps rows with the same key in index order.
+  int error = tab->file->ha_index_first(tab->record[0]);
+  for (; error == 0; error = tab->file->ha_index_next(tab->record[0])) {
+    if (thd()->killed) {
+      thd()->send_kill_message();
+      return true;
+    }
+    if (m_hash_mem_root.allocated_size() > thd()->variables.join_buff_size) {
+      // The estimate was wrong; keep using the index.
+      m_hash_table.clear();
+      m_hash_mem_root.Clear();
+      return false;
+    }
+
+    uchar *row = m_hash_mem_root.ArrayAlloc<uchar>(sizeof(uchar *) + record_size);
+    if (row == nullptr) return true;
+    uchar *const no_next_row = nullptr;
+    memcpy(row, &no_next_row, sizeof(no_next_row));
+    memcpy(row + sizeof(uchar *), tab->record[0], record_size);
+
+    key_copy(key_image, tab->record[0], &key, m_ref->key_length);
+    const auto it = m_hash_table.find(std::string_view(
+        pointer_cast<const char *>(key_image), m_ref->key_length));
+    if (it == m_hash_table.end()) {
+      char *key_copy_buf = m_hash_mem_root.ArrayAlloc<char>(m_ref->key_length);
+      if (key_copy_buf == nullptr) return true;
+      memcpy(key_copy_buf, key_image, m_ref->key_length);
+      m_hash_table.emplace(std::string_view(key_copy_buf, m_ref->key_length),
+                           Hashed_rows{row, row});
+    } else {
+      memcpy(it->second.last, &row, sizeof(row));
+      it->second.last = row;
+    }
+  }
+  if (error != HA_ERR_END_OF_FILE && error != HA_ERR_KEY_NOT_FOUND) {
+    (void)report_handler_error(tab, error);
+    return true;
+  }
+  m_use_hash_table = true;
+  return false;
+}
+
+template <bool Reverse>
+int RefIterator<Reverse>::ReadHashedRow() {
+  if (m_next_hashed_row == nullptr) {
+    table()->set_no_row();
+    return -1;
+  }
+  memcpy(table()->record[0], m_next_hashed_row + sizeof(uchar *),
+         table()->s->reclength);
+  table()->set_found_row();
+  memcpy(&m_next_hashed_row, m_next_hashed_row, sizeof(m_next_hashed_row));
+  if (m_examined_rows != nullptr) {
+    ++*m_examined_rows;
+  }
+  return 0;
+}
+
 template <bool Reverse>
 RefIterator<Reverse>::~RefIterator() {
   if (table()->key_info[m_ref->key].flags & HA_MULTI_VALUED_KEY &&
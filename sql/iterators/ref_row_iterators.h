@@ -25,12 +25,15 @@
 
 #include <sys/types.h>
 #include <memory>
+#include <string_view>
 
+#include "extra/robin-hood-hashing/robin_hood.h"
 #include "my_alloc.h"
 #include "my_bitmap.h"
 #include "my_inttypes.h"
 #include "sql/iterators/basic_row_iterators.h"
 #include "sql/iterators/row_iterator.h"
+#include "sql/psi_memory_key.h"
 #include "sql/sql_sort.h"
 
 class Item_func_match;
@@ -42,6 +45,12 @@ struct TABLE;
 /**
   For each record on the left side of a join (given in Init()), returns one or
   more matching rows from the given table, i.e., WHERE column=\<ref\>.
+
+  If the forward iterator is asked for many more lookups than the optimizer
+  expected, and the table is small, it switches to reading the entire table
+  into an in-memory hash table keyed on the lookup key, and answers the
+  remaining lookups from there, like the build side of a hash join. See
+  join_ref_hash_threshold and CanHashLookups() for when this happens.
  */
 template <bool Reverse>
 class RefIterator final : public TableRowIterator {
@@ -59,13 +68,46 @@ class RefIterator final : public TableRowIterator {
   bool Init() override;
   int Read() override;
 
+  /// The number of lookups done in the index before switching to the hash
+  /// table, if it did switch. For EXPLAIN ANALYZE.
+  ha_rows num_lookups_before_hashing() const {
+    return m_num_hashed_lookups == 0 ? 0 : m_num_index_lookups;
+  }
+  /// The number of lookups answered from the hash table.
+  ha_rows num_hashed_lookups() const { return m_num_hashed_lookups; }
+
  private:
+  /// Read all rows of the table into m_hash_table, unless they turn out not
+  /// to fit in join_buffer_size. @returns true on error.
+  bool BuildHashTable();
+  /// Return the next row for the current lookup from m_hash_table.
+  int ReadHashedRow();
+
   Index_lookup *const m_ref;
   const bool m_use_order;
   const double m_expected_rows;
   ha_rows *const m_examined_rows;
   bool m_first_record_since_init;
   bool m_is_mvi_unique_filter_enabled;
+
+  /// The rows of the table that have the same key, in index order. Each row
+  /// is a pointer to the next one, followed by a copy of the record.
+  struct Hashed_rows {
+    uchar *first;
+    uchar *last;
+  };
+
+  /// Switch to m_hash_table after this many index lookups; 0 if not yet
+  /// decided in Init().
+  ha_rows m_lookups_before_hashing{0};
+  ha_rows m_num_index_lookups{0};
+  ha_rows m_num_hashed_lookups{0};
+  bool m_use_hash_table{false};
+  robin_hood::unordered_flat_map<std::string_view, Hashed_rows> m_hash_table;
+  /// The next row to return from m_hash_table, or nullptr.
+  uchar *m_next_hashed_row{nullptr};
+  /// Holds the keys and rows in m_hash_table.
+  MEM_ROOT m_hash_mem_root{key_memory_hash_join, 16384};
 };
 
 /**
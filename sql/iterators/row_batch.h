@@ -0,0 +1,208 @@
+#ifndef SQL_ITERATORS_ROW_BATCH_H_
+#define SQL_ITERATORS_ROW_BATCH_H_
+
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file
+
+  Support for reading rows from a RowIterator in batches instead of one at a
+  time; see RowIterator::ReadBatch().
+
+  A batch holds copies of the record buffer (TABLE::record[0]) of a single
+  table, stored back to back in a Record_buffer, which is the same layout the
+  storage engine uses for its prefetch cache. Producers append rows to the
+  batch, filters compact it in place, and consumers load the rows back into
+  the table's record buffer one by one, so that Items can be evaluated on them
+  as usual. The gain over row-at-a-time execution is that the virtual call
+  chain from the consumer down to the handler is traversed once per batch
+  instead of once per row.
+
+  Batch mode is only used where copying the record buffer is enough to
+  reproduce the row; see RowBatch::CanBatchTable() for the restrictions.
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+
+#include "my_alloc.h"
+#include "my_base.h"
+#include "my_inttypes.h"
+#include "sql/handler.h"
+#include "sql/iterators/row_iterator.h"
+#include "sql/record_buffer.h"
+#include "sql/table.h"
+#include "thr_lock.h"
+
+class RowBatch {
+ public:
+  /// The default number of rows in a batch.
+  static constexpr ha_rows kDefaultMaxRows = 128;
+
+  /// Upper bound on the memory used by a single batch.
+  static constexpr size_t kMaxBatchBytes = 128 * 1024;  // 128KB
+
+  RowBatch(TABLE *table, const Record_buffer &buffer)
+      : m_table(table), m_buffer(buffer) {}
+
+  /**
+    Whether rows from the given table can be carried in a batch, i.e., whether
+    a copy of the record buffer is all that is needed to reproduce a row at a
+    later point in time. This is not the case if
+    - the table has BLOB columns, since the record buffer only holds a pointer
+      to data owned by the storage engine, which may be overwritten by the
+      next read,
+    - the row is locked (SELECT ... FOR UPDATE etc.), since rows rejected
+      by a filter must be unlocked while the handler is still positioned on
+      them (see RowIterator::UnlockRow()),
+    - the consumer depends on the handler being positioned on the current
+      row, like for row IDs and full-text search, or
+    - the table may be NULL-complemented.
+   */
+  static bool CanBatchTable(const TABLE *table) {
+    return table->s->blob_fields == 0 && !table->const_table &&
+           !table->is_nullable() && table->file->ft_handler == nullptr &&
+           table->reginfo.lock_type <= TL_READ;
+  }
+
+  /**
+    Allocate a batch for the given table on the given MEM_ROOT.
+
+    @returns the batch, or nullptr on OOM.
+   */
+  static RowBatch *Create(MEM_ROOT *mem_root, TABLE *table,
+                          ha_rows max_rows = kDefaultMaxRows) {
+    const size_t record_size = std::max<size_t>(table->s->reclength, 1);
+    max_rows = std::max<ha_rows>(
+        1, std::min<ha_rows>(max_rows, kMaxBatchBytes / record_size));
+    uchar *ptr = mem_root->ArrayAlloc<uchar>(
+        Record_buffer::buffer_size(max_rows, record_size));
+    if (ptr == nullptr) return nullptr;
+    return new (mem_root)
+        RowBatch(table, Record_buffer{max_rows, record_size, ptr});
+  }
+
+  TABLE *table() const { return m_table; }
+
+  /// The number of rows currently in the batch.
+  ha_rows size() const { return m_buffer.records(); }
+  bool empty() const { return size() == 0; }
+  bool full() const { return size() == m_buffer.max_records(); }
+
+  /**
+    Whether the producer has seen the end of its input. Rows that are already
+    in the batch must still be consumed; the next ReadBatch() call will
+    return -1 without touching the source.
+   */
+  bool at_eof() const { return m_at_eof; }
+  void set_at_eof(bool at_eof) { m_at_eof = at_eof; }
+
+  /// Append a copy of the row currently in the table's record buffer.
+  void StoreCurrentRow() {
+    memcpy(m_buffer.add_record(), m_table->record[0], m_buffer.record_size());
+  }
+
+  /// Copy the row at the given position back into the table's record buffer.
+  void LoadRow(ha_rows pos) const {
+    memcpy(m_table->record[0], m_buffer.record(pos), m_buffer.record_size());
+    // The handler may have hit EOF after this row was read.
+    m_table->set_found_row();
+  }
+
+  /**
+    Move the row at position “from” to position “to” (where to <= from).
+    Used for compacting the batch in place when rows are filtered away.
+   */
+  void MoveRow(ha_rows from, ha_rows to) {
+    assert(to <= from);
+    if (to != from) {
+      memcpy(m_buffer.record(to), m_buffer.record(from),
+             m_buffer.record_size());
+    }
+  }
+
+  /// Keep only the first “rows” rows.
+  void Truncate(ha_rows rows) { m_buffer.truncate(rows); }
+
+  /// Remove all rows, and clear the end-of-input flag.
+  void Reset() {
+    m_buffer.reset();
+    m_at_eof = false;
+  }
+
+ private:
+  TABLE *const m_table;
+  Record_buffer m_buffer;
+  bool m_at_eof = false;
+};
+
+/**
+  An adapter that lets a consumer keep its row-at-a-time loop while pulling
+  rows from its source in batches. If created without a batch, Read() simply
+  forwards to the source iterator, so that the consumer does not need separate
+  code paths for the two modes.
+
+  Note that in batch mode, the source is ahead of the consumer, so the
+  consumer must not rely on any state of the source (or of the handler) other
+  than the table's record buffer.
+ */
+class BatchedRowReader {
+ public:
+  BatchedRowReader() = default;
+  BatchedRowReader(RowIterator *source, RowBatch *batch)
+      : m_source(source), m_batch(batch) {}
+
+  bool batch_mode() const { return m_batch != nullptr; }
+
+  /// Discard any buffered rows. Must be called whenever the source is
+  /// reinitialized.
+  void Reset() {
+    if (m_batch != nullptr) m_batch->Reset();
+    m_pos = 0;
+  }
+
+  /// Same contract as RowIterator::Read().
+  int Read() {
+    if (m_batch == nullptr) return m_source->Read();
+    if (m_pos == m_batch->size()) {
+      m_pos = 0;
+      m_batch->Truncate(0);
+      if (m_batch->at_eof()) return -1;
+      const int err = m_source->ReadBatch(m_batch);
+      if (err != 0) return err;
+      assert(!m_batch->empty());
+    }
+    m_batch->LoadRow(m_pos++);
+    return 0;
+  }
+
+ private:
+  RowIterator *m_source = nullptr;
+  RowBatch *m_batch = nullptr;
+
+  /// The next row in m_batch to hand out.
+  ha_rows m_pos = 0;
+};
+
+#endif  // SQL_ITERATORS_ROW_BATCH_H_
@@ -28,6 +28,7 @@
 
 class Item;
 class JOIN;
+class RowBatch;
 class THD;
 struct TABLE;
 
@@ -114,6 +115,29 @@ class RowIterator {
    */
   virtual int Read() = 0;
 
+  /**
+    Read a batch of rows into the given batch, which must be empty on entry,
+    and whose table must be the only table this iterator outputs rows for.
+    Unlike Read(), the rows are not left in the table's record buffer; its
+    contents are undefined after the call, and the consumer is expected to
+    load the rows it wants to look at with RowBatch::LoadRow().
+
+    The default implementation calls Read() until the batch is full, so all
+    iterators support batch mode. Iterators that can do better (typically
+    those that read directly from a handler, or that only forward rows from
+    their child) override it. The caller is responsible for checking that
+    the table is eligible for batching (see RowBatch::CanBatchTable()).
+
+    @retval
+      0   OK; at least one row was put in the batch. If the end of the input
+          was seen while filling it, RowBatch::at_eof() is set.
+    @retval
+      -1   End of records; the batch is empty.
+    @retval
+      1   Error
+   */
+  virtual int ReadBatch(RowBatch *batch);
+
   /**
     Mark the current row buffer as containing a NULL row or not, so that if you
     read from it and the flag is true, you'll get only NULLs no matter what is
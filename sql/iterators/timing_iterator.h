@@ -28,6 +28,7 @@
 #include <chrono>
 
 #include "my_alloc.h"
+#include "sql/iterators/row_batch.h"
 #include "sql/iterators/row_iterator.h"
 #include "sql/sql_class.h"
 #include "sql/sql_lex.h"
@@ -101,6 +102,16 @@ class IteratorProfilerImpl final : public IteratorProfiler {
     }
   }
 
+  /**
+      Mark the end of an iterator->ReadBatch() call.
+      @param start_time time when ReadBatch() started.
+      @param rows_read the number of rows put in the batch.
+  */
+  void StopReadBatch(TimeStamp start_time, uint64_t rows_read) {
+    StopRead(start_time, /*read_ok=*/false);
+    m_num_rows += rows_read;
+  }
+
  private:
   static double DurationToMs(duration dur) {
     return std::chrono::duration<double>(dur).count() * 1e3;
@@ -177,6 +188,14 @@ class TimingIterator final : public RowIterator {
     return err;
   }
 
+  int ReadBatch(RowBatch *batch) override {
+    const IteratorProfilerImpl::TimeStamp start_time =
+        IteratorProfilerImpl::Now();
+    int err = m_iterator.ReadBatch(batch);
+    m_profiler.StopReadBatch(start_time, err == 0 ? batch->size() : 0);
+    return err;
+  }
+
   void SetNullRowFlag(bool is_null_row) override {
     m_iterator.SetNullRowFlag(is_null_row);
   }
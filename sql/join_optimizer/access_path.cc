@@ -349,6 +349,26 @@ void SetupJobsForChildren(MEM_ROOT *mem_root, AccessPath *outer,
   todo->push_back({outer, join, false, &job->children[0], {}});
 }
 
+/**
+  Whether an index range scan can be replaced by a parallel scan of its
+  range: it reads one range of the primary key, and the rows are not needed
+  in index order. The parallel scan has no ordering, so sorted range scans
+  stay serial.
+ */
+bool CanScanRangeInParallel(const AccessPath *path) {
+  const auto &param = path->index_range_scan();
+  const TABLE *table = param.used_key_part[0].field->table;
+  if (param.index != table->s->primary_key || param.num_ranges != 1 ||
+      param.in_list_keys != nullptr || param.need_rows_in_rowid_order ||
+      param.reuse_handler || (param.mrr_flags & HA_MRR_SORTED)) {
+    return false;
+  }
+  constexpr uint kSupportedFlags =
+      NO_MIN_RANGE | NO_MAX_RANGE | NEAR_MIN | NEAR_MAX | EQ_RANGE |
+      UNIQUE_RANGE;
+  return (param.ranges[0]->flag & ~kSupportedFlags) == 0;
+}
+
 }  // namespace
 
 unique_ptr_destroy_only<RowIterator> CreateIteratorFromAccessPath(
@@ -399,6 +419,13 @@ unique_ptr_destroy_only<RowIterator> CreateIteratorFromAccessPath(
         const auto &param = path->table_scan();
         iterator = NewIterator<TableScanIterator>(
             thd, mem_root, param.table, path->num_output_rows(), examined_rows);
+        if (UseParallelTableScan(
+                thd, param.table,
+                static_cast<double>(param.table->file->stats.records))) {
+          iterator = NewIterator<ParallelTableScanIterator>(
+              thd, mem_root, param.table, /*range=*/nullptr, examined_rows,
+              std::move(iterator));
+        }
         break;
       }
       case AccessPath::INDEX_SCAN: {
@@ -496,7 +523,14 @@ unique_ptr_destroy_only<RowIterator> CreateIteratorFromAccessPath(
               thd, mem_root, table, examined_rows, path->num_output_rows(),
               param.index, param.need_rows_in_rowid_order, param.reuse_handler,
               mem_root, param.mrr_flags, param.mrr_buf_size,
-              Bounds_checked_array{param.ranges, param.num_ranges});
+              Bounds_checked_array{param.ranges, param.num_ranges},
+              param.in_list_keys);
+          if (CanScanRangeInParallel(path) &&
+              UseParallelTableScan(thd, table, path->num_output_rows())) {
+            iterator = NewIterator<ParallelTableScanIterator>(
+                thd, mem_root, table, param.ranges[0], examined_rows,
+                std::move(iterator));
+          }
         }
         break;
       }
@@ -59,6 +59,7 @@ class Window;
 struct AccessPath;
 struct GroupIndexSkipScanParameters;
 struct IndexSkipScanParameters;
+struct In_list_keys;
 struct Index_lookup;
 struct KEY_PART;
 struct ORDER;
@@ -915,8 +916,13 @@ struct AccessPath {
       // The actual ranges we are scanning over (originally derived from “key”).
       // Not a Bounds_checked_array, to save 4 bytes on the length.
       QUICK_RANGE **ranges;
-      unsigned num_ranges;
 
+      // If not nullptr, the values of a large IN-list to look up instead of
+      // scanning “ranges” (which cover them all); see In_list_keys. Placed
+      // before num_ranges to keep the variant within the AccessPath size limit.
+      const In_list_keys *in_list_keys;
+
+      unsigned num_ranges;
       unsigned mrr_flags;
       unsigned mrr_buf_size;
 
@@ -0,0 +1,239 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/join_optimizer/cardinality_feedback.h"
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "my_sys.h"
+#include "mutex_lock.h"
+#include "mysql/psi/mysql_mutex.h"
+#include "sql/item.h"
+#include "sql/iterators/row_iterator.h"
+#include "sql/join_optimizer/access_path.h"
+#include "sql/join_optimizer/print_utils.h"
+#include "sql/join_optimizer/walk_access_paths.h"
+
+using std::string;
+
+ulong opt_cardinality_feedback_size = 0;
+
+namespace {
+
+/// Filters that saw fewer rows than this are not recorded; the observed
+/// selectivity would be too noisy to be trusted over the estimate.
+constexpr uint64_t kMinRowsForFeedback = 100;
+
+struct Feedback {
+  /// The selectivity the optimizer estimated when the entry was made.
+  double estimated_selectivity;
+  /// The selectivity EXPLAIN ANALYZE observed.
+  double observed_selectivity;
+  std::list<string>::iterator lru_pos;
+};
+
+mysql_mutex_t LOCK_cardinality_feedback;
+bool cardinality_feedback_inited = false;
+
+/// Protected by LOCK_cardinality_feedback.
+std::unordered_map<string, Feedback> *cardinality_feedback = nullptr;
+/// Keys of cardinality_feedback, most recently used first.
+std::list<string> *cardinality_feedback_lru = nullptr;
+/// cardinality_feedback->size(), readable without taking the lock.
+std::atomic<size_t> num_cardinality_feedback_entries{0};
+
+#ifdef HAVE_PSI_INTERFACE
+PSI_mutex_key key_LOCK_cardinality_feedback;
+
+PSI_mutex_info cardinality_feedback_mutexes[] = {
+    {&key_LOCK_cardinality_feedback, "LOCK_cardinality_feedback",
+     PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME}};
+#endif
+
+/// An observation from a single FILTER access path.
+struct Observation {
+  string key;
+  double estimated_selectivity;
+  double observed_selectivity;
+};
+
+/**
+  Whether the given access path returns all rows of its table, or is not a
+  table access at all. Access paths that use an index to read only some of
+  the rows have already applied some of the predicates, so the selectivity
+  of a filter on top of them is not that of the filter condition alone.
+ */
+bool ReadsAllRows(const AccessPath *path) {
+  switch (path->type) {
+    case AccessPath::REF:
+    case AccessPath::REF_OR_NULL:
+    case AccessPath::EQ_REF:
+    case AccessPath::PUSHED_JOIN_REF:
+    case AccessPath::FULL_TEXT_SEARCH:
+    case AccessPath::MRR:
+    case AccessPath::INDEX_RANGE_SCAN:
+    case AccessPath::INDEX_MERGE:
+    case AccessPath::ROWID_INTERSECTION:
+    case AccessPath::ROWID_UNION:
+    case AccessPath::INDEX_SKIP_SCAN:
+    case AccessPath::GROUP_INDEX_SKIP_SCAN:
+    case AccessPath::DYNAMIC_INDEX_RANGE_SCAN:
+      return false;
+    default:
+      return true;
+  }
+}
+
+void StoreObservation(Observation *observation) {
+  MUTEX_LOCK(lock, &LOCK_cardinality_feedback);
+  auto it = cardinality_feedback->find(observation->key);
+  if (it != cardinality_feedback->end()) {
+    // Keep the estimate from when the entry was first made; later estimates
+    // are based on the feedback itself.
+    it->second.observed_selectivity = observation->observed_selectivity;
+    cardinality_feedback_lru->splice(cardinality_feedback_lru->begin(),
+                                     *cardinality_feedback_lru,
+                                     it->second.lru_pos);
+    return;
+  }
+  while (!cardinality_feedback->empty() &&
+         cardinality_feedback->size() >= opt_cardinality_feedback_size) {
+    cardinality_feedback->erase(cardinality_feedback_lru->back());
+    cardinality_feedback_lru->pop_back();
+  }
+  cardinality_feedback_lru->push_front(observation->key);
+  cardinality_feedback->emplace(
+      std::move(observation->key),
+      Feedback{observation->estimated_selectivity,
+               observation->observed_selectivity,
+               cardinality_feedback_lru->begin()});
+  num_cardinality_feedback_entries.store(cardinality_feedback->size(),
+                                         std::memory_order_relaxed);
+}
+
+}  // namespace
+
+void InitCardinalityFeedback() {
+#ifdef HAVE_PSI_INTERFACE
+  const int count =
+      static_cast<int>(array_elements(cardinality_feedback_mutexes));
+  mysql_mutex_register("sql", cardinality_feedback_mutexes, count);
+#endif
+  mysql_mutex_init(key_LOCK_cardinality_feedback, &LOCK_cardinality_feedback,
+                   MY_MUTEX_INIT_FAST);
+  cardinality_feedback = new std::unordered_map<string, Feedback>;
+  cardinality_feedback_lru = new std::list<string>;
+  cardinality_feedback_inited = true;
+}
+
+void FreeCardinalityFeedback() {
+  if (!cardinality_feedback_inited) return;
+  cardinality_feedback_inited = false;
+  num_cardinality_feedback_entries = 0;
+  delete cardinality_feedback;
+  cardinality_feedback = nullptr;
+  delete cardinality_feedback_lru;
+  cardinality_feedback_lru = nullptr;
+  mysql_mutex_destroy(&LOCK_cardinality_feedback);
+}
+
+void RecordCardinalityFeedback(const AccessPath *root) {
+  if (opt_cardinality_feedback_size == 0 || !cardinality_feedback_inited ||
+      root == nullptr) {
+    return;
+  }
+
+  // Print the conditions before taking the lock.
+  std::vector<Observation> observations;
+  WalkAccessPaths(
+      root, /*join=*/nullptr, WalkAccessPathPolicy::ENTIRE_TREE,
+      [&observations](const AccessPath *path, const JOIN *) {
+        if (path->type != AccessPath::FILTER) return false;
+        const AccessPath *child = path->filter().child;
+        if (!ReadsAllRows(child) || path->iterator == nullptr ||
+            child->iterator == nullptr) {
+          return false;
+        }
+        const uint64_t rows_in = child->iterator->GetProfiler()->GetNumRows();
+        const uint64_t rows_out = path->iterator->GetProfiler()->GetNumRows();
+        if (rows_in < kMinRowsForFeedback || rows_out > rows_in) return false;
+
+        // A filter that removed every row would otherwise tell the optimizer
+        // that the condition can never be true, so assume that half a row
+        // would have made it through.
+        const double observed =
+            std::max<double>(rows_out, 0.5) / static_cast<double>(rows_in);
+        double estimated = -1.0;
+        if (child->num_output_rows() > 0.0 && path->num_output_rows() >= 0.0) {
+          estimated = path->num_output_rows() / child->num_output_rows();
+        }
+        observations.push_back(
+            Observation{ItemToString(path->filter().condition), estimated,
+                        observed});
+        return false;
+      });
+
+  for (Observation &observation : observations) {
+    StoreObservation(&observation);
+  }
+}
+
+bool HasCardinalityFeedback() {
+  return opt_cardinality_feedback_size != 0 &&
+         num_cardinality_feedback_entries.load(std::memory_order_relaxed) != 0;
+}
+
+bool LookupCardinalityFeedback(const Item *condition, double *selectivity,
+                               string *trace) {
+  if (!HasCardinalityFeedback() || condition == nullptr) return false;
+
+  const string key = ItemToString(condition);
+  double estimated;
+  {
+    MUTEX_LOCK(lock, &LOCK_cardinality_feedback);
+    auto it = cardinality_feedback->find(key);
+    if (it == cardinality_feedback->end()) return false;
+    cardinality_feedback_lru->splice(cardinality_feedback_lru->begin(),
+                                     *cardinality_feedback_lru,
+                                     it->second.lru_pos);
+    *selectivity = it->second.observed_selectivity;
+    estimated = it->second.estimated_selectivity;
+  }
+
+  if (trace != nullptr) {
+    if (estimated >= 0.0) {
+      *trace += StringPrintf(
+          " - using observed selectivity %.4f for (%s), estimated %.4f\n",
+          *selectivity, key.c_str(), estimated);
+    } else {
+      *trace += StringPrintf(" - using observed selectivity %.4f for (%s)\n",
+                             *selectivity, key.c_str());
+    }
+  }
+  return true;
+}
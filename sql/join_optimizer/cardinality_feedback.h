@@ -0,0 +1,89 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef SQL_JOIN_OPTIMIZER_CARDINALITY_FEEDBACK_H_
+#define SQL_JOIN_OPTIMIZER_CARDINALITY_FEEDBACK_H_
+
+/**
+  @file
+
+  A server-wide store of filter selectivities observed while running
+  EXPLAIN ANALYZE, which the hypergraph optimizer uses in place of its own
+  estimates when it sees the same filter again.
+
+  EXPLAIN ANALYZE counts the rows going into and coming out of every FILTER
+  access path. When enough rows went in, the ratio between the two is a much
+  better selectivity estimate than what we can derive from indexes and
+  histograms, in particular for conjunctions of correlated predicates, which
+  EstimateSelectivity() assumes to be independent.
+
+  Entries are keyed on the printed condition (see ItemToString()), which
+  includes the literals and the table aliases. This is deliberately more
+  specific than the statement digest: the selectivity of “t1.x < 10” says
+  nothing about the selectivity of “t1.x < 1000”. It also means that an entry
+  made by EXPLAIN ANALYZE SELECT ... is found by the plain SELECT ..., which
+  has a different digest.
+
+  The store is disabled when optimizer_cardinality_feedback_size is 0, which
+  is the default.
+ */
+
+#include <string>
+
+#include "my_inttypes.h"
+
+class Item;
+struct AccessPath;
+
+/// The maximum number of entries in the store.
+extern ulong opt_cardinality_feedback_size;
+
+void InitCardinalityFeedback();
+void FreeCardinalityFeedback();
+
+/**
+  Remember the selectivity of all FILTER access paths below (and including)
+  the given one that saw enough rows, and whose input was not restricted by
+  an index lookup. Must be called after the query has been run by EXPLAIN
+  ANALYZE, so that all iterators have profiling data.
+ */
+void RecordCardinalityFeedback(const AccessPath *root);
+
+/**
+  Whether there may be any feedback to look up. Lets callers skip building
+  lookup keys when the store is disabled or empty.
+ */
+bool HasCardinalityFeedback();
+
+/**
+  Look up the observed selectivity for the given condition.
+
+  @param condition The condition, which may be a conjunction.
+  @param[out] selectivity The observed selectivity, if found.
+  @param trace If not nullptr, a line is added if feedback was found.
+
+  @return true if feedback was found
+ */
+bool LookupCardinalityFeedback(const Item *condition, double *selectivity,
+                               std::string *trace);
+
+#endif  // SQL_JOIN_OPTIMIZER_CARDINALITY_FEEDBACK_H_
@@ -36,6 +36,7 @@
 #include "sql/item_cmpfunc.h"
 #include "sql/item_func.h"
 #include "sql/join_optimizer/bit_utils.h"
+#include "sql/join_optimizer/cardinality_feedback.h"
 #include "sql/join_optimizer/print_utils.h"
 #include "sql/key.h"
 #include "sql/sql_bitmap.h"
@@ -225,6 +226,12 @@ double EstimateSelectivity(THD *thd, Item *condition, string *trace) {
     return (condition->val_int() != 0) ? 1.0 : 0.0;
   }
 
+  // If EXPLAIN ANALYZE has seen this exact condition filter enough rows,
+  // trust that over anything we can derive from indexes and histograms.
+  double observed_selectivity;
+  if (LookupCardinalityFeedback(condition, &observed_selectivity, trace)) {
+    return observed_selectivity;
+  }
 
   // For field = field (e.g. t1.x = t2.y), we try to use index information
   // to find a better selectivity estimate. We look for indexes on both
@@ -389,3 +396,17 @@ double EstimateSelectivity(THD *thd, Item *condition, string *trace) {
   }
   return selectivity;
 }
+
+const Field *GetEqualityField(const Item *condition) {
+  if (!is_function_of_type(condition, Item_func::EQ_FUNC)) return nullptr;
+  const Item_func_eq *eq = down_cast<const Item_func_eq *>(condition);
+  for (int i : {0, 1}) {
+    const Item *field_side = eq->arguments()[i];
+    const Item *value_side = eq->arguments()[1 - i];
+    if (field_side->type() == Item::FIELD_ITEM &&
+        !Overlaps(value_side->used_tables(), field_side->used_tables())) {
+      return down_cast<const Item_field *>(field_side)->field;
+    }
+  }
+  return nullptr;
+}
@@ -25,6 +25,7 @@
 
 #include <string>
 
+class Field;
 class THD;
 class Item;
 
@@ -34,4 +35,12 @@ class Item;
  */
 double EstimateSelectivity(THD *thd, Item *condition, std::string *trace);
 
+/**
+  If the given condition is "field = value", where the value does not depend
+  on the field's table (i.e., it is a constant or comes from other tables),
+  returns the field. Otherwise, returns nullptr. Used for applying
+  column-group statistics (see histograms::column_group_correction()).
+ */
+const Field *GetEqualityField(const Item *condition);
+
 #endif  // SQL_JOIN_OPTIMIZER_ESTIMATE_SELECTIVITY
@@ -908,6 +908,49 @@ static bool AddPathCosts(const AccessPath *path,
   return error;
 }
 
+/**
+   For EXPLAIN ANALYZE, describe how a hash join used chunk files on disk, if it
+   spilled to disk at all.
+
+   @param stats the statistics collected by the HashJoinIterator.
+   @param obj the JSON object describing the hash join.
+   @param[in,out] description the description of the hash join.
+   @returns true on OOM.
+ */
+static bool AddHashJoinSpillStats(const HashJoinSpillStats &stats,
+                                  Json_object *obj, string *description) {
+  if (stats.initial_chunks == 0) return false;
+
+  *description += ", spill to disk: " + std::to_string(stats.total_chunks) +
+                  " chunks";
+  if (stats.repartitioned_chunks > 0) {
+    *description += " (" + std::to_string(stats.repartitioned_chunks) +
+                    " repartitioned, max level " +
+                    std::to_string(stats.max_level) + ")";
+  }
+  if (stats.hash_table_refills > 0) {
+    *description += ", " + std::to_string(stats.hash_table_refills) +
+                    " hash table refills";
+  }
+
+  bool error = false;
+  error |= AddMemberToObject<Json_int>(obj, "spill_initial_chunks",
+                                       stats.initial_chunks);
+  error |= AddMemberToObject<Json_int>(obj, "spill_total_chunks",
+                                       stats.total_chunks);
+  error |= AddMemberToObject<Json_int>(obj, "spill_repartitioned_chunks",
+                                       stats.repartitioned_chunks);
+  error |= AddMemberToObject<Json_int>(obj, "spill_max_repartition_level",
+                                       stats.max_level);
+  error |= AddMemberToObject<Json_int>(obj, "spill_hash_table_refills",
+                                       stats.hash_table_refills);
+  error |= AddMemberToObject<Json_int>(obj, "spill_max_build_chunk_rows",
+                                       stats.max_build_chunk_rows);
+  error |= AddMemberToObject<Json_int>(obj, "spill_max_build_chunk_bytes",
+                                       stats.max_build_chunk_bytes);
+  return error;
+}
+
 /**
    Given a json object, update it's appropriate json fields according to the
    input path. Also update the 'children' with a flat list of direct children
@@ -984,6 +1027,22 @@ static std::unique_ptr<Json_object> SetObjectMembers(
           RefToString(*path->ref().ref, key, /*include_nulls=*/false),
           /*ranges=*/nullptr, nullptr, path->ref().reverse,
           table->file->pushed_idx_cond, obj);
+      if (current_thd->lex->is_explain_analyze && path->iterator != nullptr &&
+          !path->ref().reverse) {
+        const auto *ref_iterator = down_cast<const RefIterator<false> *>(
+            path->iterator->real_iterator());
+        if (ref_iterator->num_hashed_lookups() > 0) {
+          description += ", switched to hash table after " +
+                         std::to_string(
+                             ref_iterator->num_lookups_before_hashing()) +
+                         " lookups";
+          error |= AddMemberToObject<Json_int>(
+              obj, "lookups_before_hashing",
+              ref_iterator->num_lookups_before_hashing());
+          error |= AddMemberToObject<Json_int>(
+              obj, "hashed_lookups", ref_iterator->num_hashed_lookups());
+        }
+      }
       error |= AddChildrenFromPushedCondition(table, children);
       break;
     }
@@ -1271,6 +1330,14 @@ static std::unique_ptr<Json_object> SetObjectMembers(
       if (extra_condition->size() > 0)
         error |= obj->add_alias("extra_condition", std::move(extra_condition));
 
+      if (current_thd->lex->is_explain_analyze && path->iterator != nullptr) {
+        error |= AddHashJoinSpillStats(
+            down_cast<const HashJoinIterator *>(
+                path->iterator->real_iterator())
+                ->spill_stats(),
+            obj, &description);
+      }
+
       error |= AddMemberToObject<Json_string>(obj, "access_type", "join");
       error |= AddMemberToObject<Json_string>(obj, "join_type", json_join_type);
       error |= AddMemberToObject<Json_string>(obj, "join_algorithm", "hash");
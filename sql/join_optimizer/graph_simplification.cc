@@ -27,6 +27,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <memory>
 #include <new>
 #include <string>
 #include <type_traits>
@@ -48,6 +49,7 @@
 #include "sql/join_optimizer/trivial_receiver.h"
 #include "sql/mem_root_allocator.h"
 #include "sql/mem_root_array.h"
+#include "sql/parallel_tasks.h"
 #include "sql/sql_array.h"
 #include "sql/sql_class.h"
 #include "sql/sql_const.h"
@@ -426,6 +428,29 @@ bool IsQueryGraphSimpleEnough(THD *thd [[maybe_unused]],
   return !error;
 }
 
+/// A number of simplification steps to try, with a copy of the hypergraph
+/// after those steps, so that the subgraph pairs can be counted without
+/// touching the graph the simplifier is working on.
+struct SimplificationProbe {
+  explicit SimplificationProbe(MEM_ROOT *mem_root) : graph(mem_root) {}
+
+  int num_steps = 0;
+  Hypergraph graph;
+  bool simple_enough = false;
+  int seen_subgraph_pairs = -1;
+};
+
+void CopyHypergraph(const Hypergraph &from, Hypergraph *to) {
+  to->nodes.reserve(from.nodes.size());
+  for (const hypergraph::Node &node : from.nodes) {
+    to->nodes.push_back(node);
+  }
+  to->edges.reserve(from.edges.size());
+  for (const Hyperedge &edge : from.edges) {
+    to->edges.push_back(edge);
+  }
+}
+
 void SetNumberOfSimplifications(int num_simplifications,
                                 GraphSimplifier *simplifier) {
   while (simplifier->num_steps_done() < num_simplifications) {
@@ -978,6 +1003,48 @@ void SimplifyQueryGraph(THD *thd, int subgraph_pair_limit,
   // At this point, lower_bound is the highest number that we know for sure
   // isn't enough, and upper_bound is the lowest number that we know for sure
   // is enough.
+  //
+  // With more than one thread, we do a k-ary search instead, counting the
+  // subgraph pairs for several step counts at the same time. Counting only
+  // looks at the hypergraph and the conflict rules of the join predicates,
+  // so the worker threads do not need the THD.
+  const int num_threads =
+      static_cast<int>(thd->variables.optimizer_simplification_threads);
+  while (num_threads > 1 && upper_bound - lower_bound > 2) {
+    const int num_probes = std::min(num_threads, upper_bound - lower_bound - 1);
+    MEM_ROOT probe_mem_root;
+    std::vector<std::unique_ptr<SimplificationProbe>> probes;
+    for (int i = 0; i < num_probes; ++i) {
+      auto probe = std::make_unique<SimplificationProbe>(&probe_mem_root);
+      probe->num_steps = lower_bound + static_cast<int>(
+                                           int64_t{upper_bound - lower_bound} *
+                                           (i + 1) / (num_probes + 1));
+      SetNumberOfSimplifications(probe->num_steps, &simplifier);
+      CopyHypergraph(graph->graph, &probe->graph);
+      probes.push_back(std::move(probe));
+    }
+
+    RunParallelTasks(probes.size(), num_threads, [&](size_t probe_idx) {
+      SimplificationProbe *probe = probes[probe_idx].get();
+      MEM_ROOT mem_root;
+      TrivialReceiver counting_receiver(*graph, &mem_root, subgraph_pair_limit);
+      probe->simple_enough =
+          !EnumerateAllConnectedPartitions(probe->graph, &counting_receiver);
+      probe->seen_subgraph_pairs = counting_receiver.seen_subgraph_pairs;
+    });
+
+    // The probes are in increasing order of steps, so the first one that is
+    // simple enough is the new upper bound, and the one before it (if any)
+    // is the new lower bound.
+    for (const std::unique_ptr<SimplificationProbe> &probe : probes) {
+      if (probe->simple_enough) {
+        upper_bound = probe->num_steps;
+        num_subgraph_pairs_upper = probe->seen_subgraph_pairs;
+        break;
+      }
+      lower_bound = probe->num_steps;
+    }
+  }
   while (upper_bound - lower_bound > 1) {
     int mid = (lower_bound + upper_bound) / 2;
     SetNumberOfSimplifications(mid, &simplifier);
@@ -59,6 +59,7 @@
 #include "sql/field.h"
 #include "sql/filesort.h"
 #include "sql/handler.h"
+#include "sql/histograms/column_group.h"  // column_group_correction
 #include "sql/item.h"
 #include "sql/item_cmpfunc.h"
 #include "sql/item_func.h"
@@ -66,6 +67,7 @@
 #include "sql/join_optimizer/access_path.h"
 #include "sql/join_optimizer/bit_utils.h"
 #include "sql/join_optimizer/build_interesting_orders.h"
+#include "sql/join_optimizer/cardinality_feedback.h"
 #include "sql/join_optimizer/compare_access_paths.h"
 #include "sql/join_optimizer/cost_model.h"
 #include "sql/join_optimizer/estimate_selectivity.h"
@@ -1227,6 +1229,7 @@ AccessPath *FindCheapestIndexRangeScan(THD *thd, SEL_TREE *tree,
   path->index_range_scan().used_key_part = param->key[best_key];
   path->index_range_scan().ranges = &ranges[0];
   path->index_range_scan().num_ranges = ranges.size();
+  path->index_range_scan().in_list_keys = nullptr;
   path->index_range_scan().mrr_flags = best_mrr_flags;
   path->index_range_scan().mrr_buf_size = best_mrr_buf_size;
   path->index_range_scan().can_be_used_for_ror =
@@ -1418,6 +1421,9 @@ bool CostingReceiver::FindIndexRangeScans(
     path.index_range_scan().used_key_part = param.key[scan.idx];
     path.index_range_scan().ranges = &scan.ranges[0];
     path.index_range_scan().num_ranges = scan.ranges.size();
+    path.index_range_scan().in_list_keys =
+        get_in_list_keys(m_thd, &param, tree, scan.idx, scan.used_key_parts,
+                         &scan.ranges[0], scan.ranges.size());
     path.index_range_scan().mrr_flags = scan.mrr_flags;
     path.index_range_scan().mrr_buf_size = scan.mrr_buf_size;
     path.index_range_scan().can_be_used_for_ror =
@@ -2803,6 +2809,45 @@ void CostingReceiver::ApplyPredicatesForBaseTable(
   path->filter_predicates = std::move(filter_predicates);
   path->delayed_predicates = std::move(delayed_predicates);
 
+  // If there are column-group statistics for the table, correct the product
+  // of the selectivities of equalities on correlated columns.
+  const TABLE *table = m_graph->nodes[node_idx].table;
+  if (table->s->m_column_groups != nullptr) {
+    Prealloced_array<histograms::Equality_selectivity, 8> equalities(
+        PSI_NOT_INSTRUMENTED);
+    for (int pred_idx : BitsSetIn(path->filter_predicates)) {
+      if (IsBitSet(pred_idx, applied_predicates)) continue;
+      const Predicate &predicate = m_graph->predicates[pred_idx];
+      const Field *field = GetEqualityField(predicate.condition);
+      if (field != nullptr && field->table == table) {
+        equalities.push_back({field->field_index(), predicate.selectivity});
+      }
+    }
+    const double correction = histograms::column_group_correction(
+        table->s, equalities.data(), equalities.size());
+    path->set_num_output_rows(
+        std::min(path->num_output_rows_before_filter,
+                 path->num_output_rows() * correction));
+  }
+
+  // The selectivities above are multiplied as if the predicates were
+  // independent. If EXPLAIN ANALYZE has seen a filter on the conjunction
+  // of all of them, use what it saw instead. Not if some of them were
+  // already applied by a ref access, though; feedback is only recorded for
+  // filters that see all rows of the table.
+  double observed_selectivity;
+  if (HasCardinalityFeedback() &&
+      PopulationCount(path->filter_predicates) > 1 &&
+      !Overlaps(path->filter_predicates, applied_predicates) &&
+      LookupCardinalityFeedback(
+          ConditionFromFilterPredicates(m_graph->predicates,
+                                        path->filter_predicates,
+                                        m_graph->num_where_predicates),
+          &observed_selectivity, /*trace=*/nullptr)) {
+    path->set_num_output_rows(path->num_output_rows_before_filter *
+                              observed_selectivity);
+  }
+
   if (materialize_subqueries) {
     CommitBitsetsToHeap(path);
     ExpandSingleFilterAccessPath(m_thd, path, m_query_block->join,
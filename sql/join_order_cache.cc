@@ -0,0 +1,247 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/join_order_cache.h"
+
+#include <string.h>
+#include <algorithm>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "lex_string.h"
+#include "my_sys.h"
+#include "my_table_map.h"
+#include "mutex_lock.h"
+#include "mysql/psi/mysql_mutex.h"
+#include "sql/sql_class.h"
+#include "sql/sql_digest.h"
+#include "sql/sql_lex.h"
+#include "sql/sql_cmd.h"
+#include "sql/sql_optimizer.h"
+#include "sql/sql_prepare.h"
+#include "sql/sql_select.h"
+#include "sql/table.h"
+#include "template_utils.h"
+
+ulong opt_join_order_cache_size = 0;
+
+namespace {
+
+/// A table in a cached join order, and what we know about it from when the
+/// order was chosen.
+struct Cached_table {
+  uint tableno;
+  std::string db;
+  std::string name;
+  /// TABLE_SHARE::get_table_def_version(), for base tables only.
+  ulonglong def_version;
+  ha_rows found_records;
+};
+
+struct Cache_entry {
+  /// The non-constant tables, in join order.
+  std::vector<Cached_table> tables;
+  std::list<std::string>::iterator lru_pos;
+};
+
+mysql_mutex_t LOCK_join_order_cache;
+bool join_order_cache_inited = false;
+
+/// Protected by LOCK_join_order_cache.
+std::unordered_map<std::string, Cache_entry> *join_order_cache = nullptr;
+/// Keys of join_order_cache, most recently used first.
+std::list<std::string> *join_order_cache_lru = nullptr;
+
+#ifdef HAVE_PSI_INTERFACE
+PSI_mutex_key key_LOCK_join_order_cache;
+
+PSI_mutex_info join_order_cache_mutexes[] = {
+    {&key_LOCK_join_order_cache, "LOCK_join_order_cache", PSI_FLAG_SINGLETON,
+     0, PSI_DOCUMENT_ME}};
+#endif
+
+/**
+  Build the cache key for the given join: the digest of the statement, the
+  current database (which unqualified table names depend on), the query
+  block and the set of non-constant tables.
+
+  @return false if the join cannot use the cache
+*/
+bool make_cache_key(const JOIN *join, std::string *key) {
+  THD *const thd = join->thd;
+  if (opt_join_order_cache_size == 0 || !join_order_cache_inited) return false;
+
+  // Semijoin strategies are chosen together with the join order.
+  if (!join->query_block->sj_nests.empty()) return false;
+
+  // Statements in stored programs have no digest of their own.
+  if (thd->sp_runtime_ctx != nullptr) return false;
+
+  unsigned char hash[DIGEST_HASH_SIZE];
+  const unsigned char *digest_hash = nullptr;
+  LEX_CSTRING db = thd->db();
+  if (thd->stmt_arena->is_regular()) {
+    if (thd->m_digest == nullptr) return false;
+    const sql_digest_storage &digest = thd->m_digest->m_digest_storage;
+    // A truncated digest may be shared by statements that differ after the
+    // truncation point.
+    if (digest.m_byte_count == 0 || digest.m_full) return false;
+    compute_digest_hash(&digest, hash);
+    digest_hash = hash;
+  } else {
+    // A prepared statement: thd->m_digest is that of the EXECUTE statement,
+    // so use the digest of the statement text from when it was prepared,
+    // which sessions preparing the same statement share.
+    const Prepared_statement *stmt = thd->lex->m_sql_cmd != nullptr
+                                         ? thd->lex->m_sql_cmd->owner()
+                                         : nullptr;
+    if (stmt == nullptr || stmt->digest_hash() == nullptr) return false;
+    digest_hash = stmt->digest_hash();
+    db = stmt->db();
+  }
+
+  const uint select_number = join->query_block->select_number;
+  const table_map tables = join->all_table_map & ~join->const_table_map;
+  key->assign(pointer_cast<const char *>(digest_hash), DIGEST_HASH_SIZE);
+  key->append(pointer_cast<const char *>(&select_number),
+              sizeof(select_number));
+  key->append(pointer_cast<const char *>(&tables), sizeof(tables));
+  if (db.str != nullptr) key->append(db.str, db.length);
+  return true;
+}
+
+/// Whether the estimate has changed so much that the order should be
+/// chosen anew.
+bool estimate_has_changed(ha_rows cached, ha_rows current) {
+  const double cached_rows = std::max(1.0, static_cast<double>(cached));
+  const double current_rows = std::max(1.0, static_cast<double>(current));
+  return current_rows > cached_rows * 2.0 || cached_rows > current_rows * 2.0;
+}
+
+const char *or_empty(const char *str) { return str == nullptr ? "" : str; }
+
+ulonglong def_version(const JOIN_TAB *tab) {
+  return tab->table_ref->is_base_table()
+             ? tab->table()->s->get_table_def_version()
+             : 0;
+}
+
+}  // namespace
+
+void join_order_cache_init() {
+#ifdef HAVE_PSI_INTERFACE
+  const int count = static_cast<int>(array_elements(join_order_cache_mutexes));
+  mysql_mutex_register("sql", join_order_cache_mutexes, count);
+#endif
+  mysql_mutex_init(key_LOCK_join_order_cache, &LOCK_join_order_cache,
+                   MY_MUTEX_INIT_FAST);
+  join_order_cache = new std::unordered_map<std::string, Cache_entry>;
+  join_order_cache_lru = new std::list<std::string>;
+  join_order_cache_inited = true;
+}
+
+void join_order_cache_free() {
+  if (!join_order_cache_inited) return;
+  join_order_cache_inited = false;
+  delete join_order_cache;
+  join_order_cache = nullptr;
+  delete join_order_cache_lru;
+  join_order_cache_lru = nullptr;
+  mysql_mutex_destroy(&LOCK_join_order_cache);
+}
+
+bool join_order_cache_lookup(JOIN *join) {
+  std::string key;
+  if (!make_cache_key(join, &key)) return false;
+
+  JOIN_TAB **const first = join->best_ref + join->const_tables;
+  const uint num_tables = join->tables - join->const_tables;
+
+  // Copy the order out of the cache, so that we hold the lock for as short
+  // as possible.
+  std::vector<Cached_table> tables;
+  {
+    MUTEX_LOCK(lock, &LOCK_join_order_cache);
+    auto it = join_order_cache->find(key);
+    if (it == join_order_cache->end()) return false;
+    join_order_cache_lru->splice(join_order_cache_lru->begin(),
+                                 *join_order_cache_lru, it->second.lru_pos);
+    tables = it->second.tables;
+  }
+  if (tables.size() != num_tables) return false;
+
+  std::vector<JOIN_TAB *> order;
+  order.reserve(num_tables);
+  for (const Cached_table &cached : tables) {
+    JOIN_TAB *tab = nullptr;
+    for (uint i = 0; i < num_tables; ++i) {
+      if (first[i]->table_ref->tableno() == cached.tableno) {
+        tab = first[i];
+        break;
+      }
+    }
+    if (tab == nullptr || cached.db != or_empty(tab->table_ref->db) ||
+        cached.name != or_empty(tab->table_ref->table_name) ||
+        cached.def_version != def_version(tab) ||
+        estimate_has_changed(cached.found_records, tab->found_records)) {
+      return false;
+    }
+    order.push_back(tab);
+  }
+
+  std::copy(order.begin(), order.end(), first);
+  return true;
+}
+
+void join_order_cache_store(const JOIN *join) {
+  std::string key;
+  if (!make_cache_key(join, &key)) return;
+
+  Cache_entry entry;
+  entry.tables.reserve(join->tables - join->const_tables);
+  for (uint i = join->const_tables; i < join->tables; ++i) {
+    const JOIN_TAB *tab = join->best_positions[i].table;
+    entry.tables.push_back(
+        Cached_table{tab->table_ref->tableno(), or_empty(tab->table_ref->db),
+                     or_empty(tab->table_ref->table_name), def_version(tab),
+                     tab->found_records});
+  }
+
+  MUTEX_LOCK(lock, &LOCK_join_order_cache);
+  auto it = join_order_cache->find(key);
+  if (it != join_order_cache->end()) {
+    // A stale entry, or another session got here first.
+    join_order_cache_lru->erase(it->second.lru_pos);
+    join_order_cache->erase(it);
+  }
+  while (!join_order_cache->empty() &&
+         join_order_cache->size() >= opt_join_order_cache_size) {
+    join_order_cache->erase(join_order_cache_lru->back());
+    join_order_cache_lru->pop_back();
+  }
+  join_order_cache_lru->push_front(key);
+  entry.lru_pos = join_order_cache_lru->begin();
+  join_order_cache->emplace(std::move(key), std::move(entry));
+}
@@ -0,0 +1,80 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef SQL_JOIN_ORDER_CACHE_INCLUDED
+#define SQL_JOIN_ORDER_CACHE_INCLUDED
+
+/**
+  @file sql/join_order_cache.h
+
+  A server-wide cache of the join orders chosen by the greedy search of the
+  old join optimizer, keyed on the statement digest.
+
+  Statements that differ only in their literals have the same digest, and
+  nearly always end up with the same join order. When the cache has an order
+  for a query block, the optimizer skips the greedy search and costs the
+  cached order only, like it does for STRAIGHT_JOIN. All other optimization
+  (access methods, condition pushdown, etc.) is still done for every
+  execution, since it depends on the literals.
+
+  Prepared statements are keyed on the digest of the statement text computed
+  when they were prepared, so all sessions that prepare the same statement
+  share the entry, and a session that prepares it again after reconnecting
+  finds the order its predecessors chose.
+
+  An entry is only used if the query block has the same set of non-constant
+  tables as when the entry was made. It goes stale, and is replaced, if any
+  of the tables has a new definition (ALTER TABLE, ANALYZE TABLE with
+  histograms, FLUSH TABLES etc. all create a new TABLE_SHARE), or if the
+  estimated number of rows for any of the tables has changed by more than a
+  factor of two.
+
+  The cache is disabled when optimizer_join_order_cache_size is 0, which is
+  the default.
+*/
+
+#include "my_inttypes.h"
+
+class JOIN;
+
+/// The maximum number of entries in the cache.
+extern ulong opt_join_order_cache_size;
+
+void join_order_cache_init();
+void join_order_cache_free();
+
+/**
+  Look up the join order for the given join, which must be ready for
+  choosing the join order. If a valid order is found, join->best_ref is
+  permuted into that order.
+
+  @return true if join->best_ref now holds a cached order
+*/
+bool join_order_cache_lookup(JOIN *join);
+
+/**
+  Remember the join order that was chosen for the given join, as found in
+  join->best_positions.
+*/
+void join_order_cache_store(const JOIN *join);
+
+#endif  // SQL_JOIN_ORDER_CACHE_INCLUDED
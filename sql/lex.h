@@ -835,6 +835,7 @@ static const SYMBOL symbols[] = {
      order)
     */
     {SYM_FN("ADDDATE", ADDDATE_SYM)},
+    {SYM_FN("APPROX_COUNT_DISTINCT", APPROX_COUNT_DISTINCT_SYM)},
     {SYM_FN("BIT_AND", BIT_AND_SYM)},
     {SYM_FN("BIT_OR", BIT_OR_SYM)},
     {SYM_FN("BIT_XOR", BIT_XOR_SYM)},
@@ -8337,6 +8337,12 @@ void Rows_log_event::decide_row_lookup_algorithm_and_key() {
     | No Index     | Ht        | T    | Ht   | Ht   |
     |--------------+-----------+------+------+------|
 
+    For DELETE events over a PK / UK, Hi is preferred over I whenever
+    hash scans are allowed: the distinct keys are then looked up in index
+    order instead of in event order, which avoids random B-tree descents
+    for large batches. Deleted rows are all distinct and deleting them in
+    a different order leaves the same result, which is not true of
+    UPDATE events that may change the key.
   */
   TABLE *table = this->m_table;
   uint event_type = this->get_general_type_code();
@@ -8355,6 +8361,10 @@ void Rows_log_event::decide_row_lookup_algorithm_and_key() {
   this->m_key_index =
       search_key_in_table(table, cols, (PRI_KEY_FLAG | UNIQUE_KEY_FLAG));
   if (this->m_key_index != MAX_KEY) {
+    if (event_type == binary_log::DELETE_ROWS_EVENT &&
+        (slave_rows_search_algorithms_options & SLAVE_ROWS_HASH_SCAN) &&
+        !(table->file->ha_table_flags() & HA_READ_OUT_OF_SYNC))
+      goto TABLE_OR_INDEX_HASH_SCAN;
     DBUG_PRINT("info",
                ("decide_row_lookup_algorithm_and_key: decided - INDEX_SCAN"));
     this->m_rows_lookup_algorithm = ROW_LOOKUP_INDEX_SCAN;
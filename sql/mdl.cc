@@ -912,8 +912,17 @@ class MDL_lock {
           In order to enforce the above rules and other invariants,
           MDL_lock::m_fast_path_state should not be updated directly.
           Use fast_path_state_cas()/add()/reset() wrapper methods instead.
+
+    @note All "fast path" lockers of this object update this member, while
+          they only read MDL_lock::key, MDL_lock::m_strategy and others.
+          Padding keeps it on a cache line of its own, so that lookups and
+          strategy checks of other connections do not miss the cache each
+          time a lock is acquired or released.
   */
+  char m_fast_path_state_pad_before[CPU_LEVEL1_DCACHE_LINESIZE];
   std::atomic<fast_path_state_t> m_fast_path_state;
+  char m_fast_path_state_pad_after[CPU_LEVEL1_DCACHE_LINESIZE -
+                                   sizeof(std::atomic<fast_path_state_t>)];
 
   /**
     Wrapper for atomic compare-and-swap operation on m_fast_path_state member
@@ -787,6 +787,7 @@ MySQL clients support the protocol:
 #include "sql/event_data_objects.h"  // init_scheduler_psi_keys
 #include "sql/events.h"              // Events
 #include "sql/handler.h"
+#include "sql/histograms/refresher.h"  // start_histogram_refresher
 #include "sql/hostname_cache.h"  // hostname_cache_init
 #include "sql/init.h"            // unireg_init
 #include "sql/item.h"
@@ -794,6 +795,8 @@ MySQL clients support the protocol:
 #include "sql/item_create.h"
 #include "sql/item_func.h"
 #include "sql/item_strfunc.h"  // Item_func_uuid
+#include "sql/join_optimizer/cardinality_feedback.h"  // InitCardinalityFeedback
+#include "sql/join_order_cache.h"  // join_order_cache_init
 #include "sql/keycaches.h"     // get_or_create_key_cache
 #include "sql/log.h"
 #include "sql/log_event.h"  // Rows_log_event
@@ -1159,6 +1162,7 @@ const char *default_tmp_storage_engine;
 ulonglong temptable_max_ram;
 ulonglong temptable_max_mmap;
 bool temptable_use_mmap;
+bool temptable_spill_to_mmap;
 static char compiled_default_collation_name[] = MYSQL_DEFAULT_COLLATION_NAME;
 static bool binlog_format_used = false;
 
@@ -1348,6 +1352,7 @@ ulong binlog_stmt_cache_size = 0;
 int32 opt_binlog_max_flush_queue_time = 0;
 long opt_binlog_group_commit_sync_delay = 0;
 ulong opt_binlog_group_commit_sync_no_delay_count = 0;
+long opt_binlog_group_commit_sync_latency_target = 0;
 ulonglong max_binlog_stmt_cache_size = 0;
 ulong refresh_version; /* Increments on each reload */
 std::atomic<query_id_t> atomic_global_query_id{1};
@@ -1380,6 +1385,12 @@ Deployed_components *g_deployed_components = nullptr;
   Is necessary to protect the server against out-of-memory attacks.
 */
 ulong max_prepared_stmt_count;
+/**
+  Largest amount of statement memory a session keeps for its next statement.
+*/
+ulong query_alloc_retain_size;
+/** Total memory kept by sessions between statements */
+std::atomic<ulonglong> query_alloc_retained_bytes{0};
 /**
   Current total number of prepared statements in the server. This number
   is exact, and therefore may not be equal to the difference between
@@ -2556,6 +2567,7 @@ static void clean_up(bool print_message) {
 
   Events::deinit();
   stop_handle_manager();
+  histograms::stop_histogram_refresher();
 
   memcached_shutdown();
 
@@ -2585,6 +2597,8 @@ static void clean_up(bool print_message) {
   acl_free(true);
   grant_free();
   hostname_cache_free();
+  join_order_cache_free();
+  FreeCardinalityFeedback();
   range_optimizer_free();
   item_func_sleep_free();
   lex_free(); /* Free some memory */
@@ -6111,6 +6125,8 @@ static int init_server_components() {
   */
   mdl_init();
   partitioning_init();
+  join_order_cache_init();
+  InitCardinalityFeedback();
   if (table_def_init() || hostname_cache_init(host_cache_size))
     unireg_abort(MYSQLD_ABORT_EXIT);
 
@@ -8134,6 +8150,7 @@ int mysqld_main(int argc, char **argv)
   }
 
   start_handle_manager();
+  histograms::start_histogram_refresher();
 
   create_compress_gtid_table_thread();
 
@@ -9426,6 +9443,14 @@ static int show_global_mem_counter(THD *, SHOW_VAR *var, char *buff) {
   return 0;
 }
 
+static int show_query_alloc_retained_bytes(THD *, SHOW_VAR *var,
+                                           char *buff) {
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  *((longlong *)buff) = (longlong)query_alloc_retained_bytes.load();
+  return 0;
+}
+
 static int show_table_definitions(THD *, SHOW_VAR *var, char *buff) {
   var->type = SHOW_LONG;
   var->value = buff;
@@ -9433,6 +9458,33 @@ static int show_table_definitions(THD *, SHOW_VAR *var, char *buff) {
   return 0;
 }
 
+static int show_dd_cache_hits(THD *, SHOW_VAR *var, char *buff) {
+  dd::Cache_stats stats;
+  dd::get_cache_stats(&stats);
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  *((longlong *)buff) = (longlong)stats.hits;
+  return 0;
+}
+
+static int show_dd_cache_misses(THD *, SHOW_VAR *var, char *buff) {
+  dd::Cache_stats stats;
+  dd::get_cache_stats(&stats);
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  *((longlong *)buff) = (longlong)stats.misses;
+  return 0;
+}
+
+static int show_dd_cache_miss_waits(THD *, SHOW_VAR *var, char *buff) {
+  dd::Cache_stats stats;
+  dd::get_cache_stats(&stats);
+  var->type = SHOW_LONGLONG;
+  var->value = buff;
+  *((longlong *)buff) = (longlong)stats.miss_waits;
+  return 0;
+}
+
 /*
    Functions relying on SSL
    Note: In the show_ssl_* functions, we need to check if we have a
@@ -9613,6 +9665,12 @@ SHOW_VAR status_vars[] = {
     {"Created_tmp_tables",
      (char *)offsetof(System_status_var, created_tmp_tables),
      SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
+    {"Dd_cache_hits", (char *)&show_dd_cache_hits, SHOW_FUNC,
+     SHOW_SCOPE_GLOBAL},
+    {"Dd_cache_miss_waits", (char *)&show_dd_cache_miss_waits, SHOW_FUNC,
+     SHOW_SCOPE_GLOBAL},
+    {"Dd_cache_misses", (char *)&show_dd_cache_misses, SHOW_FUNC,
+     SHOW_SCOPE_GLOBAL},
     {"Delayed_errors", (char *)&delayed_insert_errors, SHOW_LONG,
      SHOW_SCOPE_GLOBAL},
     {"Delayed_insert_threads", (char *)&delayed_insert_threads,
@@ -9739,6 +9797,8 @@ SHOW_VAR status_vars[] = {
      SHOW_SCOPE_GLOBAL},
 #endif
     {"Queries", (char *)&show_queries, SHOW_FUNC, SHOW_SCOPE_ALL},
+    {"Query_alloc_retained_bytes", (char *)&show_query_alloc_retained_bytes,
+     SHOW_FUNC, SHOW_SCOPE_GLOBAL},
     {"Questions", (char *)offsetof(System_status_var, questions),
      SHOW_LONGLONG_STATUS, SHOW_SCOPE_ALL},
     {"Secondary_engine_execution_count",
@@ -11912,6 +11972,7 @@ PSI_thread_key key_thread_handle_manager;
 PSI_thread_key key_thread_one_connection;
 PSI_thread_key key_thread_compress_gtid_table;
 PSI_thread_key key_thread_parser_service;
+PSI_thread_key key_thread_histogram_refresher;
 PSI_thread_key key_thread_handle_con_admin_sockets;
 
 /* clang-format off */
@@ -11931,6 +11992,8 @@ PSI_FLAG_USER | PSI_FLAG_NO_SEQNUM, 0, PSI_DOCUMENT_ME},
   { &key_thread_signal_hand, "signal_handler", "sig_handler", PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
   { &key_thread_compress_gtid_table, "compress_gtid_table", "gtid_zip", PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
   { &key_thread_parser_service, "parser_service", "parser_srv", PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
+  { &key_thread_parallel_task, "parallel_task", "par_task", 0, 0, PSI_DOCUMENT_ME},
+  { &key_thread_histogram_refresher, "histogram_refresher", "hist_refresh", PSI_FLAG_SINGLETON, 0, PSI_DOCUMENT_ME},
   { &key_thread_handle_con_admin_sockets, "admin_interface", "con_admin", PSI_FLAG_USER, 0, PSI_DOCUMENT_ME},
 };
 /* clang-format on */
@@ -246,6 +246,7 @@ extern const char *default_tmp_storage_engine;
 extern ulonglong temptable_max_ram;
 extern ulonglong temptable_max_mmap;
 extern bool temptable_use_mmap;
+extern bool temptable_spill_to_mmap;
 extern bool using_udf_functions;
 extern bool locked_in_memory;
 extern bool opt_using_transactions;
@@ -330,6 +331,8 @@ extern ulong rpl_stop_replica_timeout;
 extern bool log_bin_use_v1_row_events;
 extern ulong what_to_log, flush_time;
 extern ulong max_prepared_stmt_count, prepared_stmt_count;
+extern ulong query_alloc_retain_size;
+extern std::atomic<ulonglong> query_alloc_retained_bytes;
 extern ulong open_files_limit;
 extern bool clone_startup;
 extern bool clone_recovery_error;
@@ -338,6 +341,7 @@ extern ulonglong max_binlog_cache_size, max_binlog_stmt_cache_size;
 extern int32 opt_binlog_max_flush_queue_time;
 extern long opt_binlog_group_commit_sync_delay;
 extern ulong opt_binlog_group_commit_sync_no_delay_count;
+extern long opt_binlog_group_commit_sync_latency_target;
 extern ulong max_binlog_size, max_relay_log_size;
 extern ulong replica_max_allowed_packet;
 extern ulong binlog_row_event_max_size;
@@ -510,6 +514,8 @@ extern PSI_thread_key key_thread_handle_manager;
 extern PSI_thread_key key_thread_one_connection;
 extern PSI_thread_key key_thread_compress_gtid_table;
 extern PSI_thread_key key_thread_parser_service;
+extern PSI_thread_key key_thread_parallel_task;
+extern PSI_thread_key key_thread_histogram_refresher;
 extern PSI_thread_key key_thread_handle_con_admin_sockets;
 extern PSI_cond_key key_monitor_info_run_cond;
 
@@ -68,6 +68,7 @@
 #include "sql/item_subselect.h"
 #include "sql/join_optimizer/access_path.h"
 #include "sql/join_optimizer/bit_utils.h"
+#include "sql/join_optimizer/cardinality_feedback.h"
 #include "sql/join_optimizer/explain_access_path.h"
 #include "sql/key.h"
 #include "sql/mysqld.h"              // stage_explaining
@@ -2246,6 +2247,7 @@ bool explain_query(THD *explain_thd, const THD *query_thd,
       explain_thd->running_explain_analyze = false;
       unit->set_executed();
       if (query_thd->is_error()) return true;
+      RecordCardinalityFeedback(unit->root_access_path());
     }
     if (secondary_engine)
       push_warning(explain_thd, Sql_condition::SL_NOTE, ER_YES,
@@ -24,6 +24,7 @@
 
 #include <assert.h>
 #include <sys/types.h>
+#include <algorithm>
 
 #include "mysql_com.h"
 #include "sql/join_optimizer/bit_utils.h"
@@ -36,6 +37,35 @@ namespace pack_rows {
 
 Column::Column(Field *field) : field(field), field_type(field->real_type()) {}
 
+// Whether the column's value is never NULL and is fully contained in the
+// pack_length() bytes at the field's position in the record buffer, so that
+// copying those bytes is all it takes to store and restore the value. This
+// rules out variable-length types, where Field::pack() only stores the used
+// part, and BIT, which may keep some of its bits among the NULL flags.
+static bool IsFixedWidthNotNullColumn(const Column &column) {
+  if (column.field->is_nullable() || column.field->is_array()) return false;
+  switch (column.field_type) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+    case MYSQL_TYPE_FLOAT:
+    case MYSQL_TYPE_DOUBLE:
+    case MYSQL_TYPE_YEAR:
+    case MYSQL_TYPE_NEWDATE:
+    case MYSQL_TYPE_TIME2:
+    case MYSQL_TYPE_DATETIME2:
+    case MYSQL_TYPE_TIMESTAMP2:
+    case MYSQL_TYPE_NEWDECIMAL:
+    case MYSQL_TYPE_ENUM:
+    case MYSQL_TYPE_SET:
+      return true;
+    default:
+      return false;
+  }
+}
+
 // Take in a QEP_TAB and extract the columns that are needed to satisfy the SQL
 // query (determined by the read set of the table).
 Table::Table(TABLE *table) : table(table), columns(PSI_NOT_INSTRUMENTED) {
@@ -44,6 +74,24 @@ Table::Table(TABLE *table) : table(table), columns(PSI_NOT_INSTRUMENTED) {
       columns.emplace_back(table->field[i]);
     }
   }
+
+  use_column_runs = !columns.empty() &&
+                    std::all_of(columns.begin(), columns.end(),
+                                IsFixedWidthNotNullColumn);
+  if (!use_column_runs) return;
+
+  for (const Column &column : columns) {
+    Field *field = column.field;
+    const size_t length = field->pack_length();
+    if (!column_runs.empty()) {
+      ColumnRun &last = column_runs.back();
+      if (last.first_field->field_ptr() + last.length == field->field_ptr()) {
+        last.length += length;
+        continue;
+      }
+    }
+    column_runs.push_back(ColumnRun{field, length});
+  }
 }
 
 // Take a set of tables involed in a hash join and extract the columns that are
@@ -251,6 +299,16 @@ const uchar *LoadIntoTableBuffers(const TableCollection &tables,
       ptr += table->file->ref_length;
     }
 
+    if (tbl.use_column_runs) {
+      if (!table->has_null_row()) {
+        for (const ColumnRun &run : tbl.column_runs) {
+          memcpy(run.first_field->field_ptr(), ptr, run.length);
+          ptr += run.length;
+        }
+      }
+      continue;
+    }
+
     for (const Column &column : tbl.columns) {
       if (!column.field->is_null()) {
         ptr = column.field->unpack(ptr);
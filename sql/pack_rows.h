@@ -69,6 +69,15 @@ struct Column {
 /// This struct is primarily used for holding the extracted columns in a hash
 /// join. When the hash join iterator is constructed, we extract the columns
 /// that are needed to satisfy the SQL query.
+/// A range of columns that lie back to back in the record buffer, and that
+/// can be copied to and from a packed row with a single memcpy().
+struct ColumnRun {
+  // The first field in the range; the others follow it in the record buffer.
+  Field *first_field;
+  // The total length of the fields in the range, in bytes.
+  size_t length;
+};
+
 struct Table {
   explicit Table(TABLE *tab);
   TABLE *table;
@@ -76,6 +85,16 @@ struct Table {
 
   // Whether to copy the NULL flags or not.
   bool copy_null_flags{false};
+
+  // If all the columns are NOT NULL and of a fixed-width type, the columns are
+  // stored as a raw copy of their bytes in the record buffer instead of through
+  // a virtual Field::pack()/unpack() call per column. Columns that are
+  // adjacent in the record buffer are merged into runs, so that a typical row
+  // is copied with one or a few memcpy() calls. The choice only depends on the
+  // table definition and the read set, so storing and loading always agree on
+  // the format.
+  bool use_column_runs{false};
+  Prealloced_array<ColumnRun, 4> column_runs{PSI_NOT_INSTRUMENTED};
 };
 
 /// A structure that contains a list of tables for the hash join operation,
@@ -210,6 +229,18 @@ static ALWAYS_INLINE uchar *StoreFromTableBuffersRaw(
       dptr += table->file->ref_length;
     }
 
+    if (tbl.use_column_runs) {
+      // All columns are NULL in a NULL-complemented row, so there is nothing
+      // to store. LoadIntoTableBuffers() restores null_row before the columns.
+      if (!table->has_null_row()) {
+        for (const ColumnRun &run : tbl.column_runs) {
+          memcpy(dptr, run.first_field->field_ptr(), run.length);
+          dptr += run.length;
+        }
+      }
+      continue;
+    }
+
     for (const Column &column : tbl.columns) {
       assert(bitmap_is_set(column.field->table->read_set,
                            column.field->field_index()));
@@ -0,0 +1,90 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "sql/parallel_tasks.h"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include "my_thread.h"
+#include "mysql/psi/mysql_thread.h"
+#include "sql/mysqld.h"  // key_thread_parallel_task
+
+// Defined here rather than in mysqld.cc, so that code using RunParallelTasks()
+// can be unit tested without linking in the server.
+PSI_thread_key key_thread_parallel_task;
+
+namespace {
+
+struct Task_queue {
+  const std::function<void(size_t)> *task;
+  size_t num_tasks;
+  std::atomic<size_t> next_task{0};
+
+  void RunUntilEmpty() {
+    for (;;) {
+      const size_t idx = next_task.fetch_add(1, std::memory_order_relaxed);
+      if (idx >= num_tasks) return;
+      (*task)(idx);
+    }
+  }
+};
+
+extern "C" void *parallel_task_worker(void *arg) {
+  my_thread_init();
+  static_cast<Task_queue *>(arg)->RunUntilEmpty();
+  my_thread_end();
+  my_thread_exit(nullptr);
+  return nullptr;
+}
+
+}  // namespace
+
+void RunParallelTasks(size_t num_tasks, size_t max_threads,
+                      const std::function<void(size_t)> &task) {
+  if (num_tasks == 0) return;
+
+  Task_queue queue;
+  queue.task = &task;
+  queue.num_tasks = num_tasks;
+
+  const size_t num_workers =
+      std::min(num_tasks, std::max<size_t>(max_threads, 1)) - 1;
+  std::vector<my_thread_handle> workers;
+  workers.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    my_thread_handle handle;
+    my_thread_attr_t attr;
+    my_thread_attr_init(&attr);
+    const int error = mysql_thread_create(key_thread_parallel_task, &handle,
+                                          &attr, parallel_task_worker, &queue);
+    my_thread_attr_destroy(&attr);
+    if (error != 0) break;  // Make do with what we have.
+    workers.push_back(handle);
+  }
+
+  queue.RunUntilEmpty();
+  for (my_thread_handle &handle : workers) {
+    my_thread_join(&handle, nullptr);
+  }
+}
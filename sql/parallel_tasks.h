@@ -0,0 +1,53 @@
+#ifndef SQL_PARALLEL_TASKS_H_
+#define SQL_PARALLEL_TASKS_H_
+
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/**
+  @file
+
+  A minimal fork/join helper for spreading CPU-bound work inside a single
+  statement over several threads.
+
+  The worker threads do not have a THD, so the tasks must not touch the
+  session in any way: no Items, no Fields bound to a TABLE, no THD MEM_ROOT,
+  no my_error(). What is left is pure data processing on buffers owned by the
+  caller, such as sorting, hashing or merging rows that have already been
+  packed by the session thread. Errors must be reported back through the
+  task's own state and raised by the caller afterwards.
+ */
+
+#include <stddef.h>
+#include <functional>
+
+/**
+  Run task(0), task(1), ..., task(num_tasks - 1), using up to max_threads
+  threads in total (the calling thread included), and return when all of them
+  are done. Tasks are handed out dynamically, so there is no need for them to
+  be of equal size. If worker threads cannot be created, the remaining tasks
+  are simply run on fewer threads; this never fails.
+ */
+void RunParallelTasks(size_t num_tasks, size_t max_threads,
+                      const std::function<void(size_t)> &task);
+
+#endif  // SQL_PARALLEL_TASKS_H_
@@ -468,6 +468,7 @@ using std::min;
 
 static const unsigned int PACKET_BUFFER_EXTRA_ALLOC = 1024;
 static bool net_send_error_packet(THD *, uint, const char *, const char *);
+static bool net_flush_response(NET *net);
 static bool net_send_error_packet(NET *, uint, const char *, const char *, bool,
                                   ulong, const CHARSET_INFO *);
 static bool write_eof_packet(THD *, NET *, uint, uint);
@@ -961,7 +962,7 @@ static bool net_send_ok(THD *thd, uint server_status, uint statement_warn_count,
     return true;
   }
   error = my_net_write(net, start, (size_t)(pos - start));
-  if (!error) error = net_flush(net);
+  if (!error) error = net_flush_response(net);
 
   thd->get_stmt_da()->set_overwrite_status(false);
   DBUG_PRINT("info", ("OK sent, so no more error sending allowed"));
@@ -1057,7 +1058,7 @@ static bool net_send_eof(THD *thd, uint server_status,
   if (net->vio != nullptr) {
     thd->get_stmt_da()->set_overwrite_status(true);
     error = write_eof_packet(thd, net, server_status, statement_warn_count);
-    if (!error) error = net_flush(net);
+    if (!error) error = net_flush_response(net);
     thd->get_stmt_da()->set_overwrite_status(false);
     DBUG_PRINT("info", ("EOF sent, so no more error sending allowed"));
   }
@@ -1404,7 +1405,30 @@ uint Protocol_classic::get_output_pkt_nr() { return m_thd->net.pkt_nr; }
 
 String *Protocol_classic::get_output_packet() { return &m_thd->packet; }
 
+/**
+  Flush the response of a command, unless the client has already sent the
+  next one. The responses to pipelined commands are then sent with a single
+  write, once there is no more buffered input; see
+  Protocol_classic::read_packet().
+
+  @param net  NET of the connection
+
+  @retval false The response was flushed or held back
+  @retval true  An error occurred while flushing
+*/
+static bool net_flush_response(NET *net) {
+  if (!net->compress && net->vio != nullptr && net->vio->has_data(net->vio))
+    return false;
+  return net_flush(net);
+}
+
 int Protocol_classic::read_packet() {
+  /* Send the responses held back by net_flush_response() before waiting. */
+  NET *net = &m_thd->net;
+  if (net->write_pos != net->buff && net->vio != nullptr &&
+      !net->vio->has_data(net->vio) && net_flush(net))
+    return net->error == NET_ERROR_SOCKET_UNUSABLE ? 1 : -1;
+
   input_packet_length = my_net_read(&m_thd->net);
   if (input_packet_length != packet_error) {
     assert(!m_thd->net.error);
@@ -2184,7 +2208,8 @@ int Protocol_classic::read_packet() {
       <td>Flags. See @ref enum_cursor_type</td></tr>
   <tr><td>@ref a_protocol_type_int4 "int&lt;4&gt;"</td>
       <td>iteration_count</td>
-      <td>Number of times to execute the statement. Currently always 1.</td></tr>
+      <td>Number of times to execute the statement. Always 1 unless
+        PARAMETER_ARRAY_AVAILABLE is set in flags.</td></tr>
   <tr><td colspan="3">if (num_params > 0 || (CLIENT_QUERY_ATTRIBUTES && (flags & PARAMETER_COUNT_AVAILABLE)) {</td></tr>
   <tr><td colspan="3">if ::CLIENT_QUERY_ATTRIBUTES is on {</td></tr>
   <tr><td>@ref sect_protocol_basic_dt_int_le "int&lt;lenenc&gt;"</td>
@@ -2214,8 +2239,22 @@ int Protocol_classic::read_packet() {
       <td>value of each parameter</td></tr>
   <tr><td colspan="3">} -- if (parameter_count > 0)</td></tr>
   <tr><td colspan="3">} -- if (num_params > 0 || (CLIENT_QUERY_ATTRIBUTES && (flags & PARAMETER_COUNT_AVAILABLE))</td></tr>
+  <tr><td colspan="3">if (flags & PARAMETER_ARRAY_AVAILABLE), iteration_count - 1 times {</td></tr>
+  <tr><td>@ref sect_protocol_basic_dt_string_var "binary&lt;var&gt;"</td>
+      <td>null_bitmap</td>
+      <td>NULL bitmap of the row, length= (num_params + 7) / 8</td></tr>
+  <tr><td>@ref sect_protocol_basic_dt_string_var "binary&lt;var&gt;"</td>
+      <td>parameter_values</td>
+      <td>value of each parameter of the row, with the types of the
+        first row</td></tr>
+  <tr><td colspan="3">} -- if (flags & PARAMETER_ARRAY_AVAILABLE)</td></tr>
   </table>
 
+  With PARAMETER_ARRAY_AVAILABLE the statement, which must be an INSERT or
+  REPLACE, is executed once for every parameter row and a single OK packet
+  reports the sum of the affected rows. Execution stops at the first error;
+  rows executed before it are not rolled back unless done in a transaction.
+
   @par Example
   ~~~~~~~~~
   12 00 00 00 17 01 00 00    00 00 01 00 00 00 00 01    ................
@@ -2664,6 +2703,92 @@ MY_COMPILER_CLANG_WORKAROUND_REF_DOCBUG()
 */
 MY_COMPILER_DIAGNOSTIC_POP()
 
+/**
+  Parses the parameter values of the second and later rows of a
+  COM_STMT_EXECUTE with the PARAMETER_ARRAY_AVAILABLE flag.
+
+  Every row consists of a NULL bitmap followed by the values, like the
+  first row, which was parsed by parse_query_bind_params(). The types of
+  the first row apply to all rows. Query attributes and long data
+  parameters cannot be combined with parameter arrays.
+
+  On success the parameters of @p execute are replaced by an array of
+  iteration_count * parameter_count values.
+
+  @retval true  The packet is malformed.
+  @retval false Success.
+*/
+static bool parse_param_array(THD *thd, Prepared_statement *stmt,
+                              COM_STMT_EXECUTE_DATA *execute,
+                              uchar **inout_read_pos,
+                              size_t *inout_packet_left) {
+  const ulong param_count = stmt->m_param_count;
+  const ulong iteration_count = execute->iteration_count;
+  uchar *read_pos = *inout_read_pos;
+  size_t packet_left = *inout_packet_left;
+
+  if (param_count == 0 || iteration_count == 0 ||
+      execute->parameter_count != param_count)
+    return true;
+
+  for (ulong i = 0; i < param_count; ++i) {
+    if (stmt->m_param_array[i]->param_state() == Item_param::LONG_DATA_VALUE)
+      return true;
+  }
+
+  /* Every row has at least its NULL bitmap, which bounds the allocation. */
+  const uint null_bits_len = (param_count + 7) / 8;
+  if (packet_left / null_bits_len < iteration_count - 1) return true;
+
+  const PS_PARAM *first = execute->parameters;
+  auto *params = static_cast<PS_PARAM *>(
+      thd->alloc(iteration_count * param_count * sizeof(PS_PARAM)));
+  if (params == nullptr) return true; /* purecov: inspected */
+  memcpy(params, first, param_count * sizeof(PS_PARAM));
+
+  for (ulong row = 1; row < iteration_count; ++row) {
+    PS_PARAM *row_params = params + row * param_count;
+
+    if (packet_left < null_bits_len) return true;
+    const uchar *null_bits = read_pos;
+    read_pos += null_bits_len;
+    packet_left -= null_bits_len;
+
+    for (ulong i = 0; i < param_count; ++i) {
+      row_params[i] = first[i];
+      row_params[i].null_bit =
+          static_cast<bool>(null_bits[i / 8] & (1 << (i & 7)));
+      if (row_params[i].null_bit) {
+        row_params[i].value = nullptr;
+        row_params[i].length = 0;
+        continue;
+      }
+
+      const enum enum_field_types type =
+          execute->has_new_types ? first[i].type
+                                 : stmt->m_param_array[i]->data_type_source();
+      if (type == MYSQL_TYPE_BOOL) return true;
+
+      bool buffer_underrun = false;
+      ulong header_len;
+      row_params[i].length = get_ps_param_len(type, read_pos, packet_left,
+                                              &header_len, &buffer_underrun);
+      if (buffer_underrun) return true;
+
+      read_pos += header_len;
+      packet_left -= header_len;
+      row_params[i].value = read_pos;
+      read_pos += row_params[i].length;
+      packet_left -= row_params[i].length;
+    }
+  }
+
+  execute->parameters = params;
+  *inout_read_pos = read_pos;
+  *inout_packet_left = packet_left;
+  return false;
+}
+
 static bool parse_query_bind_params(
     THD *thd, uint param_count, PS_PARAM **out_parameters,
     unsigned char *out_has_new_types, unsigned long *out_parameter_count,
@@ -2862,8 +2987,9 @@ bool Protocol_classic::parse_packet(union COM_DATA *data,
       data->com_stmt_execute.stmt_id = uint4korr(read_pos);
       read_pos += 4;
       packet_left -= 4;
-      // Get execution flags
+      // Get execution flags and iteration count
       data->com_stmt_execute.open_cursor = *read_pos;
+      data->com_stmt_execute.iteration_count = 1;
       read_pos += 5;
       packet_left -= 5;
       DBUG_PRINT("info", ("stmt %lu", data->com_stmt_execute.stmt_id));
@@ -2895,6 +3021,13 @@ bool Protocol_classic::parse_packet(union COM_DATA *data,
               this->has_client_capability(CLIENT_QUERY_ATTRIBUTES), false))
         goto malformed;
 
+      if (data->com_stmt_execute.open_cursor & PARAMETER_ARRAY_AVAILABLE) {
+        data->com_stmt_execute.iteration_count =
+            uint4korr(input_raw_packet + 5);
+        if (parse_param_array(m_thd, stmt, &data->com_stmt_execute, &read_pos,
+                              &packet_left))
+          goto malformed;
+      }
       break;
     }
     case COM_STMT_FETCH: {
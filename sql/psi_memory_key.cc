@@ -33,6 +33,7 @@
   MAINTAINER: Please keep this list in order, to limit merge collisions.
 */
 
+PSI_memory_key key_memory_Arg_comparator_ascii_weights;
 PSI_memory_key key_memory_DD_cache_infrastructure;
 PSI_memory_key key_memory_DD_column_statistics;
 PSI_memory_key key_memory_DD_default_values;
@@ -87,6 +88,7 @@ PSI_memory_key key_memory_THD_db;
 PSI_memory_key key_memory_THD_handler_tables_hash;
 PSI_memory_key key_memory_THD_variables;
 PSI_memory_key key_memory_Unique_merge_buffer;
+PSI_memory_key key_memory_Unique_on_insert;
 PSI_memory_key key_memory_Unique_sort_buffer;
 PSI_memory_key key_memory_User_level_lock;
 PSI_memory_key key_memory_xa_transaction_contexts;
@@ -106,6 +108,7 @@ PSI_memory_key key_memory_errmsgs_server;
 PSI_memory_key key_memory_global_system_variables;
 PSI_memory_key key_memory_errmsgs_handler;
 PSI_memory_key key_memory_handlerton_objects;
+PSI_memory_key key_memory_hash_aggregation;
 PSI_memory_key key_memory_hash_index_key_buffer;
 PSI_memory_key key_memory_hash_join;
 PSI_memory_key key_memory_help;
@@ -202,6 +205,9 @@ static PSI_memory_info all_server_memory[] = {
      PSI_FLAG_MEM_COLLECT, 0, PSI_DOCUMENT_ME},
 
     {&key_memory_String_value, "String::value", 0, 0, PSI_DOCUMENT_ME},
+    {&key_memory_Arg_comparator_ascii_weights, "Arg_comparator::ascii_weights",
+     PSI_FLAG_ONLY_GLOBAL_STAT, 0,
+     "Weights of ASCII characters used by string comparisons."},
     {&key_memory_Sys_var_charptr_value, "Sys_var_charptr::value", 0, 0,
      PSI_DOCUMENT_ME},
     {&key_memory_queue_item, "Queue::queue_item", 0, 0, PSI_DOCUMENT_ME},
@@ -318,6 +324,10 @@ static PSI_memory_info all_server_memory[] = {
      PSI_FLAG_MEM_COLLECT, 0, PSI_DOCUMENT_ME},
     {&key_memory_Unique_merge_buffer, "Unique::merge_buffer",
      PSI_FLAG_MEM_COLLECT, 0, PSI_DOCUMENT_ME},
+    {&key_memory_Unique_on_insert, "Unique_on_insert",
+     PSI_FLAG_MEM_COLLECT, 0,
+     "Row ids kept in memory by the duplicate filter of multi-valued index "
+     "scans."},
     {&key_memory_TABLE, "TABLE", PSI_FLAG_ONLY_GLOBAL_STAT, 0,
      "Memory used by TABLE objects and their mem root."},
     {&key_memory_LOG_name, "LOG::file_name", 0, 0,
@@ -371,6 +381,8 @@ static PSI_memory_info all_server_memory[] = {
     {&key_memory_histograms, "histograms", 0, 0, PSI_DOCUMENT_ME},
     {&key_memory_hash_join, "hash_join", PSI_FLAG_MEM_COLLECT, 0,
      PSI_DOCUMENT_ME},
+    {&key_memory_hash_aggregation, "hash_aggregation", PSI_FLAG_MEM_COLLECT, 0,
+     PSI_DOCUMENT_ME},
     {&key_memory_rm_table_foreach_root, "rm_table::foreach_root",
      PSI_FLAG_THREAD, 0,
      "Mem root for temporary objects allocated while dropping tables or the "
@@ -58,6 +58,7 @@ extern PSI_memory_key key_memory_string_service_iterator;
 /*
   These are defined in psi_memory_key.cc
  */
+extern PSI_memory_key key_memory_Arg_comparator_ascii_weights;
 extern PSI_memory_key key_memory_DD_cache_infrastructure;
 extern PSI_memory_key key_memory_DD_column_statistics;
 extern PSI_memory_key key_memory_DD_default_values;
@@ -112,6 +113,7 @@ extern PSI_memory_key key_memory_THD_db;
 extern PSI_memory_key key_memory_THD_handler_tables_hash;
 extern PSI_memory_key key_memory_THD_variables;
 extern PSI_memory_key key_memory_Unique_merge_buffer;
+extern PSI_memory_key key_memory_Unique_on_insert;
 extern PSI_memory_key key_memory_Unique_sort_buffer;
 extern PSI_memory_key key_memory_User_level_lock;
 extern PSI_memory_key key_memory_xa_transaction_contexts;
@@ -131,6 +133,7 @@ extern PSI_memory_key key_memory_errmsgs_server;
 extern PSI_memory_key key_memory_global_system_variables;
 extern PSI_memory_key key_memory_errmsgs_handler;
 extern PSI_memory_key key_memory_handlerton_objects;
+extern PSI_memory_key key_memory_hash_aggregation;
 extern PSI_memory_key key_memory_hash_index_key_buffer;
 extern PSI_memory_key key_memory_hash_join;
 extern PSI_memory_key key_memory_help;
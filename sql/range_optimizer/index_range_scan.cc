@@ -56,9 +56,11 @@ IndexRangeScanIterator::IndexRangeScanIterator(
     THD *thd, TABLE *table_arg, ha_rows *examined_rows, double expected_rows,
     uint key_nr, bool need_rows_in_rowid_order, bool reuse_handler,
     MEM_ROOT *return_mem_root, uint mrr_flags, uint mrr_buf_size,
-    Bounds_checked_array<QUICK_RANGE *> ranges_arg)
+    Bounds_checked_array<QUICK_RANGE *> ranges_arg,
+    const In_list_keys *in_list_keys_arg)
     : RowIDCapableRowIterator(thd, table_arg),
       ranges(ranges_arg),
+      in_list_keys(in_list_keys_arg),
       free_file(false),
       cur_range(nullptr),
       last_range(nullptr),
@@ -134,6 +136,8 @@ range_seq_t quick_range_seq_init(void *init_param, uint, uint) {
   quick->qr_traversal_ctx.first = first;
   quick->qr_traversal_ctx.cur = first;
   quick->qr_traversal_ctx.last = last;
+  quick->qr_traversal_ctx.in_list_keys = quick->in_list_keys;
+  quick->qr_traversal_ctx.cur_key = 0;
   return &quick->qr_traversal_ctx;
 }
 
@@ -151,6 +155,9 @@ range_seq_t quick_range_seq_init(void *init_param, uint, uint) {
   This is needed to preserve correct order of records in case of multiple
   ranges over DESC keypart.
 
+  If the iterator has In_list_keys, the ranges are instead equality ranges
+  on the first keypart, one for each of the values.
+
   RETURN
     0  Ok
     1  No more ranges in the sequence
@@ -159,6 +166,24 @@ range_seq_t quick_range_seq_init(void *init_param, uint, uint) {
 uint quick_range_seq_next(range_seq_t rseq, KEY_MULTI_RANGE *range) {
   QUICK_RANGE_SEQ_CTX *ctx = reinterpret_cast<QUICK_RANGE_SEQ_CTX *>(rseq);
 
+  if (ctx->in_list_keys != nullptr) {
+    const In_list_keys *keys = ctx->in_list_keys;
+    if (ctx->cur_key == keys->num_keys) return 1; /* no more ranges */
+
+    const uchar *key = keys->keys + ctx->cur_key * keys->key_length;
+    range->start_key.key = key;
+    range->start_key.length = keys->key_length;
+    range->start_key.keypart_map = 1;
+    range->start_key.flag = HA_READ_KEY_EXACT;
+    range->end_key.key = key;
+    range->end_key.length = keys->key_length;
+    range->end_key.keypart_map = 1;
+    range->end_key.flag = HA_READ_AFTER_KEY;
+    range->range_flag = keys->flag;
+    ctx->cur_key++;
+    return 0;
+  }
+
   if (ctx->cur == ctx->last) return 1; /* no more ranges */
 
   QUICK_RANGE *cur = *(ctx->cur);
@@ -299,6 +324,43 @@ bool InitIndexRangeScan(TABLE *table, handler *file, int index,
   return false;
 }
 
+/// At most this many ranges are announced to the storage engine with
+/// handler::prefetch_keys() when a scan starts.
+static constexpr size_t kMaxPrefetchRanges = 256;
+/// Number of keys passed to each handler::prefetch_keys() call.
+static constexpr size_t kPrefetchBatchSize = 64;
+
+/**
+  Announce the start keys of the ranges to the storage engine, so that it can
+  read the index pages they are on ahead of the scan. Only scans that look up
+  more than one range do so, as the first lookup follows right away.
+*/
+void IndexRangeScanIterator::prefetch_ranges() {
+  const size_t num_ranges =
+      in_list_keys != nullptr ? in_list_keys->num_keys : ranges.size();
+  if (num_ranges < 2) return;
+
+  key_range keys[kPrefetchBatchSize];
+  uint num_keys = 0;
+  for (size_t i = 0; i < std::min(num_ranges, kMaxPrefetchRanges); ++i) {
+    key_range *key = &keys[num_keys];
+    if (in_list_keys != nullptr) {
+      key->key = in_list_keys->keys + i * in_list_keys->key_length;
+      key->length = in_list_keys->key_length;
+      key->keypart_map = 1;
+      key->flag = HA_READ_KEY_EXACT;
+    } else {
+      if (ranges[i]->flag & NO_MIN_RANGE) continue;
+      ranges[i]->make_min_endpoint(key);
+    }
+    if (++num_keys == kPrefetchBatchSize) {
+      file->prefetch_keys(index, keys, num_keys);
+      num_keys = 0;
+    }
+  }
+  if (num_keys > 0) file->prefetch_keys(index, keys, num_keys);
+}
+
 bool IndexRangeScanIterator::shared_reset() {
   last_range = nullptr;
   cur_range = ranges.begin();
@@ -335,10 +397,14 @@ bool IndexRangeScanIterator::shared_reset() {
         nullptr;
   }
 
+  prefetch_ranges();
+
   RANGE_SEQ_IF seq_funcs = {quick_range_seq_init, quick_range_seq_next,
                             nullptr};
   if (int error = file->multi_range_read_init(
-          &seq_funcs, this, ranges.size(), mrr_flags,
+          &seq_funcs, this,
+          in_list_keys != nullptr ? in_list_keys->num_keys : ranges.size(),
+          mrr_flags,
           mrr_buf_desc ? mrr_buf_desc : &empty_buf);
       error != 0) {
     (void)report_handler_error(table(), error);
@@ -399,6 +465,23 @@ int IndexRangeScanIterator::Read() {
 */
 
 bool IndexRangeScanIterator::row_in_ranges() {
+  if (in_list_keys != nullptr) {
+    /* Binary search on the sorted values to look up */
+    uint min = 0;
+    uint max = in_list_keys->num_keys;
+    while (min != max) {
+      const uint mid = (min + max) / 2;
+      const uchar *key = in_list_keys->keys + mid * in_list_keys->key_length;
+      const int cmp = key_cmp(key_part_info, key, in_list_keys->key_length);
+      if (cmp == 0) return true;
+      if (cmp > 0)
+        min = mid + 1;
+      else
+        max = mid;
+    }
+    return false;
+  }
+
   if (ranges.empty()) return false;
 
   QUICK_RANGE *res;
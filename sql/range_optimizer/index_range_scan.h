@@ -39,6 +39,7 @@ class SEL_ARG;
 class SEL_ROOT;
 class String;
 class THD;
+struct In_list_keys;
 struct KEY_MULTI_RANGE;
 struct MEM_ROOT;
 struct TABLE;
@@ -51,6 +52,10 @@ struct QUICK_RANGE_SEQ_CTX {
   Quick_ranges::const_iterator first;
   Quick_ranges::const_iterator cur;
   Quick_ranges::const_iterator last;
+
+  /* If not NULL, the ranges are made from these values instead */
+  const In_list_keys *in_list_keys;
+  uint cur_key;
 };
 
 /*
@@ -76,6 +81,8 @@ class IndexRangeScanIterator : public RowIDCapableRowIterator {
   friend class RowIDIntersectionIterator;
 
   Bounds_checked_array<QUICK_RANGE *> ranges; /* ordered array of range ptrs */
+  /* Values to look up instead of reading the ranges, or NULL */
+  const In_list_keys *in_list_keys;
   bool free_file; /* TRUE <=> this->file is "owned" by this quick select */
 
   /* Range pointers to be used when not using MRR interface */
@@ -106,6 +113,7 @@ class IndexRangeScanIterator : public RowIDCapableRowIterator {
   bool row_in_ranges();
   bool shared_init();
   bool shared_reset();
+  void prefetch_ranges();
   bool init_ror_merged_scan();
 
  public:
@@ -114,7 +122,8 @@ class IndexRangeScanIterator : public RowIDCapableRowIterator {
                          bool need_rows_in_rowid_order, bool reuse_handler,
                          MEM_ROOT *return_mem_root, uint mrr_flags,
                          uint mrr_buf_size,
-                         Bounds_checked_array<QUICK_RANGE *> ranges);
+                         Bounds_checked_array<QUICK_RANGE *> ranges,
+                         const In_list_keys *in_list_keys = nullptr);
   ~IndexRangeScanIterator() override;
 
   IndexRangeScanIterator(const IndexRangeScanIterator &) = delete;
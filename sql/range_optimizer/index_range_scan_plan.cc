@@ -33,6 +33,8 @@
 #include "my_inttypes.h"
 #include "my_sys.h"
 #include "sql/join_optimizer/access_path.h"
+#include "sql/item.h"
+#include "sql/item_cmpfunc.h"
 #include "sql/key.h"
 #include "sql/mem_root_array.h"
 #include "sql/opt_hints.h"
@@ -49,6 +51,7 @@
 #include "sql/sql_class.h"
 #include "sql/sql_lex.h"
 #include "sql/sql_select.h"
+#include "sql/system_variables.h"
 #include "sql/table.h"
 #include "sql/thr_malloc.h"
 #include "sql_string.h"
@@ -790,6 +793,116 @@ bool get_ranges_from_tree(MEM_ROOT *return_mem_root, TABLE *table,
   return false;
 }
 
+/**
+  Compare a key image on a single keypart with a range on the same keypart.
+
+  @return -1 if the key is below the range, 1 if above it, 0 if within it
+*/
+static int compare_key_to_range(Field *field, uchar *key,
+                                const QUICK_RANGE *range) {
+  if (!(range->flag & NO_MIN_RANGE)) {
+    const int cmp = sel_cmp(field, key, range->min_key, 0, 0);
+    if (cmp < 0 || (cmp == 0 && (range->flag & NEAR_MIN))) return -1;
+  }
+  if (!(range->flag & NO_MAX_RANGE)) {
+    const int cmp = sel_cmp(field, key, range->max_key, 0, 0);
+    if (cmp > 0 || (cmp == 0 && (range->flag & NEAR_MAX))) return 1;
+  }
+  return 0;
+}
+
+In_list_keys *get_in_list_keys(THD *thd, RANGE_OPT_PARAM *param,
+                               const SEL_TREE *tree, uint idx,
+                               uint used_key_parts, QUICK_RANGE *const *ranges,
+                               size_t num_ranges) {
+  Item_func_in *in_pred = tree->large_in_list;
+  if (in_pred == nullptr || used_key_parts != 1 || num_ranges == 0)
+    return nullptr;
+
+  KEY_PART *key_part = param->key[idx];
+  const KEY &key = param->table->key_info[param->real_keynr[idx]];
+  const Item *predicand = in_pred->arguments()[0]->real_item();
+  if (predicand->type() != Item::FIELD_ITEM ||
+      down_cast<const Item_field *>(predicand)->field != key_part->field)
+    return nullptr;
+  // Only plain, ascending keyparts, whose key images can be compared with
+  // sel_cmp().
+  if ((key.flags & (HA_SPATIAL | HA_MULTI_VALUED_KEY)) ||
+      (key_part->flag & (HA_REVERSE_SORT | HA_PART_KEY_SEG | HA_BLOB_PART)))
+    return nullptr;
+
+  Field *field = key_part->field;
+  const in_vector *values = in_pred->m_const_array;
+  const uint key_length = key_part->store_length;
+  const uint null_bytes = field->is_nullable() ? 1 : 0;
+  Item_basic_constant *value_item = values->create_item(thd->mem_root);
+  uchar *images =
+      param->temp_mem_root->ArrayAlloc<uchar>(values->m_used_size * key_length);
+  Mem_root_array<uchar *> sorted_images(param->temp_mem_root);
+  if (value_item == nullptr || images == nullptr ||
+      sorted_images.reserve(values->m_used_size))
+    return nullptr;
+
+  // For comparison purposes allow invalid dates like 2000-01-32, as
+  // save_value_and_handle_conversion() does.
+  const sql_mode_t orig_sql_mode = thd->variables.sql_mode;
+  thd->variables.sql_mode |= MODE_INVALID_DATES;
+  bool exact = true;
+  for (uint i = 0; exact && i < values->m_used_size; ++i) {
+    values->value_to_item(i, value_item);
+    // A value that is rounded or truncated when stored in the field could
+    // match rows with other values; just read the ranges then.
+    exact = value_item->save_in_field_no_warnings(field, true) == TYPE_OK;
+    uchar *image = images + i * key_length;
+    if (null_bytes != 0) image[0] = 0;
+    field->get_key_image(image + null_bytes, key_part->length,
+                         key_part->image_type);
+    sorted_images.push_back(image);
+  }
+  thd->variables.sql_mode = orig_sql_mode;
+  if (!exact || param->has_errors()) return nullptr;
+
+  // The values are sorted by the IN predicate's comparator, which need not
+  // be the order of the index.
+  std::sort(sorted_images.begin(), sorted_images.end(),
+            [field](uchar *a, uchar *b) {
+              return sel_cmp(field, a, b, 0, 0) < 0;
+            });
+
+  uchar *keys = param->return_mem_root->ArrayAlloc<uchar>(
+      sorted_images.size() * key_length);
+  In_list_keys *in_list_keys = new (param->return_mem_root) In_list_keys;
+  if (keys == nullptr || in_list_keys == nullptr) return nullptr;
+
+  // Both the images and the ranges are sorted, and the ranges are disjoint.
+  uint num_keys = 0;
+  size_t range_idx = 0;
+  uchar *prev_image = nullptr;
+  for (uchar *image : sorted_images) {
+    if (prev_image != nullptr && sel_cmp(field, prev_image, image, 0, 0) == 0)
+      continue;
+    prev_image = image;
+    int cmp;
+    while ((cmp = compare_key_to_range(field, image, ranges[range_idx])) > 0) {
+      if (++range_idx == num_ranges) break;
+    }
+    if (range_idx == num_ranges) break;
+    if (cmp < 0) continue;
+    memcpy(keys + num_keys * key_length, image, key_length);
+    ++num_keys;
+  }
+  if (num_keys == 0) return nullptr;
+
+  in_list_keys->keys = keys;
+  in_list_keys->num_keys = num_keys;
+  in_list_keys->key_length = key_length;
+  in_list_keys->flag = EQ_RANGE;
+  // Keys extended with primary key parts have no HA_NOSAME flag.
+  if ((key.flags & HA_NOSAME) && key.user_defined_key_parts == 1)
+    in_list_keys->flag |= UNIQUE_RANGE;
+  return in_list_keys;
+}
+
 void trace_basic_info_index_range_scan(THD *thd, const AccessPath *path,
                                        const RANGE_OPT_PARAM *param,
                                        Opt_trace_object *trace_object) {
@@ -802,6 +915,9 @@ void trace_basic_info_index_range_scan(THD *thd, const AccessPath *path,
   trace_object->add_alnum("type", "range_scan")
       .add_utf8("index", cur_key.name)
       .add("rows", path->num_output_rows());
+  if (path->index_range_scan().in_list_keys != nullptr)
+    trace_object->add("in_list_lookups",
+                      path->index_range_scan().in_list_keys->num_keys);
 
   Opt_trace_array trace_range(&thd->opt_trace, "ranges");
 
@@ -972,6 +1088,9 @@ AccessPath *get_key_scans_params(THD *thd, RANGE_OPT_PARAM *param,
   path->index_range_scan().used_key_part = param->key[best_idx];
   path->index_range_scan().ranges = &ranges[0];
   path->index_range_scan().num_ranges = ranges.size();
+  path->index_range_scan().in_list_keys =
+      get_in_list_keys(thd, param, tree, best_idx, used_key_parts, &ranges[0],
+                       ranges.size());
   path->index_range_scan().mrr_flags = best_mrr_flags;
   path->index_range_scan().mrr_buf_size = best_buf_size;
   path->index_range_scan().can_be_used_for_ror =
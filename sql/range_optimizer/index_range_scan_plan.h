@@ -45,6 +45,28 @@ bool get_ranges_from_tree(MEM_ROOT *return_mem_root, TABLE *table,
                           uint num_key_parts, unsigned *used_key_parts,
                           unsigned *num_exact_key_parts, Quick_ranges *ranges);
 
+/**
+  If the tree has a large IN-list (see SEL_TREE::large_in_list) on the
+  first keypart of the given index, and the ranges for the index are all on
+  that keypart, make the sorted, deduplicated key images of the IN-list
+  values that fall within the ranges. A range scan can then look up only
+  those values instead of reading the ranges.
+
+  @param thd             Thread handle
+  @param param           Parameters from test_quick_select
+  @param tree            The tree the ranges were made from
+  @param idx             The index in the tree (not in the table)
+  @param used_key_parts  Number of keyparts used by the ranges
+  @param ranges          The ranges for the index
+  @param num_ranges      Number of ranges
+
+  @return the key images, or nullptr if the ranges should be read as they are
+*/
+In_list_keys *get_in_list_keys(THD *thd, RANGE_OPT_PARAM *param,
+                               const SEL_TREE *tree, uint idx,
+                               uint used_key_parts, QUICK_RANGE *const *ranges,
+                               size_t num_ranges);
+
 /*
   Get best "range" table read plan for given SEL_TREE, also update some info
 
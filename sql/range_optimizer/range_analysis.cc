@@ -153,6 +153,49 @@ static SEL_TREE *get_ne_mm_tree(THD *thd, RANGE_OPT_PARAM *param,
   return tree;
 }
 
+/**
+  Build a SEL_TREE for "field IN (c1, c2, ...)" that is a single range
+  covering all the constants, c_min <= field <= c_max, instead of one range
+  per constant. The IN predicate is remembered in SEL_TREE::large_in_list,
+  so that a range scan can look up the constants one by one; see
+  get_in_list_keys().
+
+  Used for IN-lists with more than range_optimizer_max_in_list_expansion
+  values, where building and ORing one SEL_ARG per value can take a long
+  time, or exceed range_optimizer_max_mem_size so that no range scan is
+  possible at all.
+
+  @param thd         Thread handle
+  @param param       Information on 'just about everything'.
+  @param prev_tables See test_quick_select()
+  @param read_tables See test_quick_select()
+  @param field       The field on the left-hand side of the IN predicate.
+  @param op          The IN predicate, with a sorted m_const_array.
+*/
+static SEL_TREE *get_covering_mm_tree_from_in_predicate(
+    THD *thd, RANGE_OPT_PARAM *param, table_map prev_tables,
+    table_map read_tables, Field *field, Item_func_in *op) {
+  const in_vector *values = op->m_const_array;
+  Item_basic_constant *min_item = values->create_item(thd->mem_root);
+  Item_basic_constant *max_item = values->create_item(thd->mem_root);
+  if (min_item == nullptr || max_item == nullptr) return nullptr;
+  values->value_to_item(0, min_item);
+  values->value_to_item(values->m_used_size - 1, max_item);
+
+  SEL_TREE *tree =
+      tree_and(param,
+               get_mm_parts(thd, param, prev_tables, read_tables, op, field,
+                            Item_func::GE_FUNC, min_item),
+               get_mm_parts(thd, param, prev_tables, read_tables, op, field,
+                            Item_func::LE_FUNC, max_item));
+  if (tree == nullptr || tree->type != SEL_TREE::KEY) return tree;
+
+  // The values between the constants must be filtered out afterwards.
+  tree->inexact = true;
+  tree->large_in_list = op;
+  return tree;
+}
+
 /**
   Factory function to build a SEL_TREE from an @<in predicate@>
 
@@ -364,6 +407,14 @@ static SEL_TREE *get_func_mm_tree_from_in_predicate(
   if (predicand->type() == Item::FIELD_ITEM) {
     // The expression is (<column>) IN (...)
     Field *field = down_cast<Item_field *>(predicand)->field;
+    const ulong max_expansion =
+        thd->variables.range_optimizer_max_in_list_expansion;
+    if (max_expansion != 0 && param->using_real_indexes &&
+        op->m_const_array != nullptr && !op->m_const_array->is_row_result() &&
+        op->m_const_array->m_used_size > max_expansion) {
+      return get_covering_mm_tree_from_in_predicate(
+          thd, param, prev_tables, read_tables, field, op);
+    }
     SEL_TREE *tree =
         get_mm_parts(thd, param, prev_tables, read_tables, op, field,
                      Item_func::EQ_FUNC, op->arguments()[1]);
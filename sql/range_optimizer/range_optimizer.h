@@ -171,6 +171,23 @@ class QUICK_RANGE {
 using Quick_ranges = Mem_root_array<QUICK_RANGE *>;
 using Quick_ranges_array = Mem_root_array<Quick_ranges *>;
 
+/**
+  The values of a large IN-list on the first keypart of an index, as sorted
+  key images without duplicates. A range scan reads one equality range per
+  value, but makes them from the images as it goes instead of having one
+  QUICK_RANGE each. See range_optimizer_max_in_list_expansion and
+  get_in_list_keys().
+*/
+struct In_list_keys {
+  /// num_keys key images of key_length bytes each, in index order.
+  const uchar *keys;
+  uint num_keys;
+  /// The store_length of the keypart, including any NULL byte.
+  uint16 key_length;
+  /// Flags for the ranges; EQ_RANGE, possibly with UNIQUE_RANGE.
+  uint16 flag;
+};
+
 bool setup_range_optimizer_param(THD *thd, MEM_ROOT *return_mem_root,
                                  MEM_ROOT *temp_mem_root, Key_map keys_to_use,
                                  TABLE *table, Query_block *query_block,
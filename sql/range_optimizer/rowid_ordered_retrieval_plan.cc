@@ -685,6 +685,7 @@ static AccessPath *MakeAccessPath(ROR_SCAN_INFO *scan, TABLE *table,
   path->index_range_scan().used_key_part = used_key_part;
   path->index_range_scan().ranges = &scan->ranges[0];
   path->index_range_scan().num_ranges = scan->ranges.size();
+  path->index_range_scan().in_list_keys = nullptr;
   path->index_range_scan().mrr_flags = HA_MRR_SORTED;
   path->index_range_scan().mrr_buf_size = 0;
   path->index_range_scan().index = scan->keynr;
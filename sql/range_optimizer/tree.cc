@@ -572,6 +572,8 @@ SEL_TREE *tree_and(RANGE_OPT_PARAM *param, SEL_TREE *tree1, SEL_TREE *tree2) {
   }
   tree1->keys_map = result_keys;
   tree1->inexact |= tree2->inexact;
+  if (tree1->large_in_list == nullptr)
+    tree1->large_in_list = tree2->large_in_list;
 
   /* ok, both trees are index_merge trees */
   imerge_list_and_list(&tree1->merges, &tree2->merges);
@@ -684,6 +686,7 @@ SEL_TREE *tree_or(RANGE_OPT_PARAM *param, bool remove_jump_scans,
 
   if (!tree1 || !tree2) return nullptr;
   tree1->inexact = tree2->inexact = tree1->inexact | tree2->inexact;
+  tree1->large_in_list = tree2->large_in_list = nullptr;
   if (tree1->type == SEL_TREE::IMPOSSIBLE || tree2->type == SEL_TREE::ALWAYS)
     return tree2;
   if (tree2->type == SEL_TREE::IMPOSSIBLE || tree1->type == SEL_TREE::ALWAYS)
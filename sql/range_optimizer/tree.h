@@ -39,6 +39,7 @@
 #include "sql/sql_list.h"
 
 class Cost_estimate;
+class Item_func_in;
 class SEL_ARG;
 class SEL_ROOT;
 class SEL_TREE;
@@ -918,6 +919,19 @@ class SEL_TREE {
    */
   bool inexact = false;
 
+  /**
+    An IN predicate with more values than
+    range_optimizer_max_in_list_expansion, which is represented in keys[]
+    by a single range covering all its values
+    (see get_covering_mm_tree_from_in_predicate()). Since the predicate is
+    AND-ed with everything else this tree represents, a range scan on an
+    index that starts with its field needs only look up its values, instead
+    of reading the entire covering range; see get_in_list_keys().
+
+    Kept by tree_and(), and cleared by tree_or().
+   */
+  Item_func_in *large_in_list = nullptr;
+
   SEL_TREE(enum Type type_arg, MEM_ROOT *root, size_t num_keys)
       : type(type_arg), keys(root, num_keys), n_ror_scans(0) {}
   SEL_TREE(MEM_ROOT *root, size_t num_keys)
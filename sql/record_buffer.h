@@ -126,6 +126,16 @@ class Record_buffer {
     --m_count;
   }
 
+  /**
+    Remove all records except the first @a count ones.
+    @param count the number of records to keep (must not be larger than
+                 records())
+  */
+  void truncate(ha_rows count) {
+    assert(count <= m_count);
+    m_count = count;
+  }
+
   /**
     Clear the buffer. Remove all the records. The end-of-range flag is
     preserved.
@@ -26,6 +26,8 @@
 
 #include <algorithm>  // copy
 #include <string>     // strlen
+#include <utility>
+#include <vector>
 
 #include "my_dbug.h"
 #include "sql/regexp/errors.h"
@@ -40,6 +42,75 @@ UBool QueryNotKilled(const void *thd, int32_t) {
 
 const char *icu_version_string() { return U_ICU_VERSION; }
 
+namespace {
+
+/**
+  The most recently compiled regular expressions of a thread, most recently
+  used first. The compiled objects are never matched against, only cloned.
+*/
+class Compiled_regexp_cache {
+ public:
+  ~Compiled_regexp_cache() {
+    for (Entry &entry : m_entries) uregex_close(entry.re);
+  }
+
+  /// @return A clone of the cached pattern, or nullptr if it isn't cached.
+  URegularExpression *Clone(const std::u16string &pattern, uint flags,
+                            UErrorCode *status) {
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+      if (m_entries[i].flags != flags || m_entries[i].pattern != pattern)
+        continue;
+      std::rotate(m_entries.begin(), m_entries.begin() + i,
+                  m_entries.begin() + i + 1);
+      return uregex_clone(m_entries.front().re, status);
+    }
+    return nullptr;
+  }
+
+  /// Remembers a clone of a freshly compiled pattern.
+  void Add(const std::u16string &pattern, uint flags,
+           const URegularExpression *re) {
+    UErrorCode status = U_ZERO_ERROR;
+    URegularExpression *clone = uregex_clone(re, &status);
+    if (U_FAILURE(status)) return; /* purecov: inspected */
+    if (m_entries.size() == kMaxEntries) {
+      uregex_close(m_entries.back().re);
+      m_entries.pop_back();
+    }
+    m_entries.insert(m_entries.begin(), Entry{pattern, flags, clone});
+  }
+
+ private:
+  static constexpr size_t kMaxEntries = 16;
+
+  struct Entry {
+    std::u16string pattern;
+    uint flags;
+    URegularExpression *re;
+  };
+  std::vector<Entry> m_entries;
+};
+
+thread_local Compiled_regexp_cache compiled_regexp_cache;
+
+}  // namespace
+
+URegularExpression *CompileRegexp(const std::u16string &pattern, uint flags,
+                                  UParseError *error, UErrorCode *status) {
+  if (U_FAILURE(*status)) return nullptr; /* purecov: inspected */
+
+  URegularExpression *re =
+      compiled_regexp_cache.Clone(pattern, flags, status);
+  if (re != nullptr) return re;
+
+  re = uregex_open(pointer_cast<const UChar *>(pattern.data()),
+                   pattern.size(), flags, error, status);
+  // Don't cache patterns that compile with a warning, as a clone wouldn't
+  // raise it again.
+  if (*status == U_ZERO_ERROR) compiled_regexp_cache.Add(pattern, flags, re);
+  return re;
+}
+
 void Regexp_engine::Reset(const std::u16string &subject) {
   m_error_code = U_ZERO_ERROR;
   auto usubject = subject.data();
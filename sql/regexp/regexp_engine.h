@@ -67,6 +67,26 @@ const char *icu_version_string();
 */
 UBool QueryNotKilled(const void *context, int32_t steps);
 
+/**
+  Compiles a regular expression. The most recently compiled patterns are
+  kept in a small per-thread cache, so that compiling a pattern that was
+  seen recently only clones the already compiled pattern. This saves
+  recompilation when the same pattern is used by many rows or many
+  executions of a statement.
+
+  The returned object is owned by the caller. As with uregex_open(), if
+  `status` indicates failure on entry, nothing is done.
+
+  @param pattern The pattern string in ICU's character set.
+  @param flags ICU flags.
+  @param[out] error Position of a syntax error, if any.
+  @param[in,out] status ICU status.
+
+  @return The compiled regular expression, or nullptr on failure.
+*/
+URegularExpression *CompileRegexp(const std::u16string &pattern, uint flags,
+                                  UParseError *error, UErrorCode *status);
+
 /**
   This class exposes high-level regular expression operations to the
   facade. It implements the algorithm for search-and-replace and the various
@@ -98,10 +118,7 @@ class Regexp_engine {
   Regexp_engine(const std::u16string &pattern, uint flags, int stack_limit,
                 int time_limit) {
     UParseError error;
-    auto upattern = pattern.data();
-    int length = pattern.size();
-    m_re = uregex_open(pointer_cast<const UChar *>(upattern), length, flags,
-                       &error, &m_error_code);
+    m_re = CompileRegexp(pattern, flags, &error, &m_error_code);
     uregex_setStackLimit(m_re, stack_limit, &m_error_code);
     uregex_setTimeLimit(m_re, time_limit, &m_error_code);
     uregex_setMatchCallback(m_re, QueryNotKilled, current_thd, &m_error_code);
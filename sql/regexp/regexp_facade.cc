@@ -25,6 +25,7 @@
 #include <optional>
 #include <string>
 #include <tuple>
+#include <utility>
 
 #include "my_pointer_arithmetic.h"
 #include "sql/item_func.h"
@@ -257,9 +258,18 @@ bool Regexp_facade::SetupEngine(Item *pattern_expr, uint flags) {
     return false;
   }
 
+  /*
+    A non-constant pattern often evaluates to the same string for many rows
+    in a row. There's no need to recompile it then.
+  */
+  if (m_engine != nullptr && !m_engine->IsError() && pattern == m_pattern &&
+      flags == m_engine->flags())
+    return false;
+
   // Actually compile the regular expression.
+  m_pattern = std::move(pattern);
   m_engine = make_unique_destroy_only<Regexp_engine>(
-      *THR_MALLOC, pattern, flags, opt_regexp_stack_limit,
+      *THR_MALLOC, m_pattern, flags, opt_regexp_stack_limit,
       opt_regexp_time_limit);
 
   // If something went wrong, an error was raised.
@@ -184,6 +184,9 @@ class Regexp_facade {
   */
   unique_ptr_destroy_only<Regexp_engine> m_engine;
 
+  /// The pattern that m_engine was compiled from, in ICU's character set.
+  std::u16string m_pattern;
+
   /**
     ICU does not copy the subject string, so we keep the subject buffer
     here. A call to Reset() causes it to be overwritten.
@@ -439,6 +439,39 @@ void Commit_stage_manager::wait_count_or_timeout(ulong count, long usec,
   }
 }
 
+long Commit_stage_manager::get_adaptive_sync_delay(long target_usec) const {
+  const ulonglong syncs = 2 * m_sync_duration_usec;
+  if (static_cast<ulonglong>(target_usec) <= syncs) return 0;
+
+  const ulonglong budget = target_usec - syncs;
+  if (m_sync_arrival_usec == 0 || m_sync_arrival_usec >= budget) return 0;
+
+  return static_cast<long>(budget);
+}
+
+void Commit_stage_manager::update_sync_stats(ulong group_size,
+                                             ulonglong sync_start,
+                                             ulonglong sync_end) {
+  /* Weight of a new sample in the moving averages is 1/8. */
+  auto average = [](ulonglong avg, ulonglong sample) {
+    return avg == 0 ? sample : (avg * 7 + sample) / 8;
+  };
+
+  if (sync_end >= sync_start) {
+    m_sync_duration_usec =
+        average(m_sync_duration_usec, sync_end - sync_start);
+  }
+
+  /* The sessions of this group arrived since the previous group was
+  fetched. */
+  if (m_last_sync_start != 0 && sync_start > m_last_sync_start &&
+      group_size > 0) {
+    m_sync_arrival_usec = average(
+        m_sync_arrival_usec, (sync_start - m_last_sync_start) / group_size);
+  }
+  m_last_sync_start = sync_start;
+}
+
 THD *Commit_stage_manager::fetch_queue_acquire_lock(StageID stage) {
   DBUG_PRINT("debug", ("Fetching queue for stage %d", stage));
   return m_queue[stage].fetch_and_empty_acquire_lock();
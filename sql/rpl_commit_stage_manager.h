@@ -145,7 +145,11 @@ class Commit_stage_manager {
   };  // MY_ATTRIBUTE((aligned(CPU_LEVEL1_DCACHE_LINESIZE)));
 
  private:
-  Commit_stage_manager() : m_is_initialized(false) {}
+  Commit_stage_manager()
+      : m_is_initialized(false),
+        m_sync_arrival_usec(0),
+        m_sync_duration_usec(0),
+        m_last_sync_start(0) {}
 
   Commit_stage_manager(const Commit_stage_manager &) = delete;
 
@@ -326,6 +330,40 @@ class Commit_stage_manager {
    */
   void wait_count_or_timeout(ulong count, long usec, StageID stage);
 
+  /**
+    Computes how long the sync stage leader should wait for the sync queue
+    to fill, so that a session spends at most target_usec in the sync
+    stage.
+
+    A session that joins the queue just after the leader started to sync
+    waits for that sync, for the delay and for its own sync, so the delay
+    is the target minus two syncs. If not even one more session is
+    expected to join within that time, waiting only adds latency and the
+    delay is 0.
+
+    Must be called by the sync stage leader, holding LOCK_sync.
+
+    @param target_usec  the latency target, in microseconds.
+
+    @return the number of microseconds to wait.
+  */
+  long get_adaptive_sync_delay(long target_usec) const;
+
+  /**
+    Updates the sync time and commit arrival rate that
+    get_adaptive_sync_delay() relies on, after the sync stage leader has
+    synced a group.
+
+    Must be called by the sync stage leader, holding LOCK_sync.
+
+    @param group_size   number of sessions in the group.
+    @param sync_start   when the leader fetched the group, from
+                        my_micro_time().
+    @param sync_end     when the sync completed, from my_micro_time().
+  */
+  void update_sync_stats(ulong group_size, ulonglong sync_start,
+                         ulonglong sync_end);
+
   /**
     The function is called after follower thread are processed by leader,
     to unblock follower threads.
@@ -462,6 +500,21 @@ class Commit_stage_manager {
   mysql_cond_t m_cond_wait_for_ticket_turn;
   /** Mutex to protect the wait for a given ticket to become active. */
   mysql_mutex_t m_lock_wait_for_ticket_turn;
+
+  /**
+    Moving average of the time between two sessions arriving at the sync
+    stage, in microseconds. Protected by LOCK_sync.
+  */
+  ulonglong m_sync_arrival_usec;
+
+  /**
+    Moving average of the time to sync a group, in microseconds.
+    Protected by LOCK_sync.
+  */
+  ulonglong m_sync_duration_usec;
+
+  /** When the previous group was fetched from the sync queue. */
+  ulonglong m_last_sync_start;
 };
 
 #endif /*RPL_COMMIT_STAGE_MANAGER*/
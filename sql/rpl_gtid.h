@@ -2716,7 +2716,8 @@ class Gtid_state {
         gtids_only_in_table(sid_map, sid_lock),
         previous_gtids_logged(sid_map, sid_lock),
         owned_gtids(sid_lock),
-        commit_group_sidnos(key_memory_Gtid_state_group_commit_sidno) {}
+        commit_group_sidnos(key_memory_Gtid_state_group_commit_sidno),
+        commit_group_sidno_list(key_memory_Gtid_state_group_commit_sidno) {}
   /**
     Add @@GLOBAL.SERVER_UUID to this binlog's Sid_map.
 
@@ -3646,6 +3647,15 @@ class Gtid_state {
     - MYSQL_BIN_LOG::LOCK_commit when setting true/false on array items.
   */
   Prealloced_array<bool, 8> commit_group_sidnos;
+  /**
+    The sidnos set to true in commit_group_sidnos, in increasing order once
+    they are locked. Lets locking and unlocking visit only the sidnos used
+    by the commit group, rather than every sidno of the sid_map.
+
+    Its capacity is kept at the size of commit_group_sidnos, so adding to
+    it never allocates. Its access is protected like commit_group_sidnos.
+  */
+  Prealloced_array<rpl_sidno, 8> commit_group_sidno_list;
   /**
     Ensure that commit_group_sidnos have room for the SIDNO passed as
     parameter.
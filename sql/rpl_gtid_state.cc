@@ -21,6 +21,7 @@
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
 
 #include <time.h>
+#include <algorithm>
 #include <atomic>
 
 #include "lex_string.h"
@@ -831,24 +832,31 @@ void Gtid_state::update_gtids_impl_lock_sidno(rpl_sidno sidno) {
 }
 
 void Gtid_state::update_gtids_impl_lock_sidnos(THD *first_thd) {
+  auto add_sidno = [this](rpl_sidno sidno) {
+    if (commit_group_sidnos[sidno]) return;
+    DBUG_PRINT("info", ("Setting sidno %d to be locked", sidno));
+    commit_group_sidnos[sidno] = true;
+    // Cannot fail: the capacity covers every sidno.
+    commit_group_sidno_list.push_back(sidno);
+  };
+
   /* Define which sidnos should be locked to be updated */
   for (THD *thd = first_thd; thd != nullptr; thd = thd->next_to_commit) {
     if (thd->owned_gtid.sidno > 0) {
-      DBUG_PRINT("info",
-                 ("Setting sidno %d to be locked", thd->owned_gtid.sidno));
-      commit_group_sidnos[thd->owned_gtid.sidno] = true;
+      add_sidno(thd->owned_gtid.sidno);
     } else if (thd->owned_gtid.sidno == THD::OWNED_SIDNO_GTID_SET)
 #ifdef HAVE_GTID_NEXT_LIST
       for (rpl_sidno i = 1; i < thd->owned_gtid_set.max_sidno; i++)
-        if (owned_gtid_set.contains_sidno(i)) commit_group_sidnos[i] = true;
+        if (owned_gtid_set.contains_sidno(i)) add_sidno(i);
 #else
       assert(0);
 #endif
   }
 
   /* Take the sidno_locks in order */
-  for (rpl_sidno i = 1; i < (rpl_sidno)commit_group_sidnos.size(); i++)
-    if (commit_group_sidnos[i]) update_gtids_impl_lock_sidno(i);
+  std::sort(commit_group_sidno_list.begin(), commit_group_sidno_list.end());
+  for (rpl_sidno sidno : commit_group_sidno_list)
+    update_gtids_impl_lock_sidno(sidno);
 }
 
 void Gtid_state::update_gtids_impl_own_gtid(THD *thd, bool is_commit) {
@@ -912,11 +920,11 @@ void Gtid_state::update_gtids_impl_broadcast_and_unlock_sidno(rpl_sidno sidno) {
 }
 
 void Gtid_state::update_gtids_impl_broadcast_and_unlock_sidnos() {
-  for (rpl_sidno i = 1; i < (rpl_sidno)commit_group_sidnos.size(); i++)
-    if (commit_group_sidnos[i]) {
-      update_gtids_impl_broadcast_and_unlock_sidno(i);
-      commit_group_sidnos[i] = false;
-    }
+  for (rpl_sidno sidno : commit_group_sidno_list) {
+    update_gtids_impl_broadcast_and_unlock_sidno(sidno);
+    commit_group_sidnos[sidno] = false;
+  }
+  commit_group_sidno_list.clear();
 }
 
 void Gtid_state::update_gtids_impl_own_anonymous(THD *thd, bool *more_trx) {
@@ -963,6 +971,7 @@ enum_return_status Gtid_state::ensure_commit_group_sidnos(rpl_sidno sidno) {
   while ((commit_group_sidnos.size()) < (size_t)sidno + 1) {
     if (commit_group_sidnos.push_back(false)) goto error;
   }
+  if (commit_group_sidno_list.reserve(commit_group_sidnos.size())) goto error;
   RETURN_OK;
 error:
   BINLOG_ERROR(("Out of memory."), (ER_OUT_OF_RESOURCES, MYF(0)));
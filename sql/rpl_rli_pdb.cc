@@ -34,6 +34,7 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 
@@ -80,6 +81,12 @@ uint mta_debug_concurrent_access = 0;
 
 #define HASH_DYNAMIC_INIT 4
 
+/**
+  How many times a Worker yields, waiting for the coordinator to assign
+  an event to its empty queue, before it goes to sleep on jobs_cond.
+*/
+static constexpr uint WORKER_EMPTY_QUEUE_SPINS = 64;
+
 using std::max;
 using std::min;
 
@@ -2296,6 +2303,17 @@ static struct slave_job_item *pop_jobs_item(Slave_worker *worker,
                                             Slave_job_item *job_item) {
   THD *thd = worker->info_thd;
 
+  /*
+    When the coordinator assigns events at a high rate, the next one usually
+    arrives very soon after the queue runs empty. Going to sleep on jobs_cond
+    and being woken up again costs more than that, so yield for a while
+    first. The queue length can be read without holding jobs_lock.
+  */
+  for (uint spins = 0;
+       worker->jobs.empty() && spins < WORKER_EMPTY_QUEUE_SPINS && !thd->killed;
+       ++spins)
+    std::this_thread::yield();
+
   mysql_mutex_lock(&worker->jobs_lock);
 
   job_item->data = nullptr;
@@ -245,11 +245,13 @@ void Writeset_trx_dependency_tracker::get_dependency(THD *thd,
   if (can_use_writesets) {
     /*
      Check if adding this transaction exceeds the capacity of the writeset
-     history. If that happens, m_writeset_history will be cleared only after
+     history. If so, first try to make room by evicting the oldest rows. If
+     that is not possible, m_writeset_history will be cleared only after
      using its information for current transaction.
     */
     exceeds_capacity =
-        m_writeset_history.size() + writeset->size() > m_opt_max_history_size;
+        m_writeset_history.size() + writeset->size() > m_opt_max_history_size &&
+        !evict_oldest(writeset->size());
 
     /*
      Compute the greatest sequence_number among all conflicts and add the
@@ -292,6 +294,44 @@ void Writeset_trx_dependency_tracker::get_dependency(THD *thd,
   }
 }
 
+bool Writeset_trx_dependency_tracker::evict_oldest(size_t needed) {
+  const size_t max_size = m_opt_max_history_size;
+  if (needed > max_size / 2) return false;
+
+  /*
+    Clearing the whole history makes every following transaction depend on
+    the one that overflowed it, which serializes the applier until the
+    history has filled up again. Instead, keep the most recent half of the
+    history and move m_writeset_history_start up to the newest evicted
+    sequence number, which keeps the commit parents correct: any later
+    transaction that touches an evicted row gets a commit parent at least
+    as large as the transaction that last changed that row.
+  */
+  std::vector<int64> sequence_numbers;
+  sequence_numbers.reserve(m_writeset_history.size());
+  for (const auto &entry : m_writeset_history)
+    sequence_numbers.push_back(entry.second);
+  if (sequence_numbers.empty()) return true;
+
+  const size_t keep = max_size / 2;
+  if (sequence_numbers.size() <= keep) return true;
+  const auto threshold =
+      sequence_numbers.begin() + (sequence_numbers.size() - keep - 1);
+  std::nth_element(sequence_numbers.begin(), threshold,
+                   sequence_numbers.end());
+  const int64 evict_up_to = *threshold;
+
+  for (auto it = m_writeset_history.begin(); it != m_writeset_history.end();) {
+    if (it->second <= evict_up_to)
+      it = m_writeset_history.erase(it);
+    else
+      ++it;
+  }
+  m_writeset_history_start = std::max(m_writeset_history_start, evict_up_to);
+
+  return m_writeset_history.size() + needed <= max_size;
+}
+
 void Writeset_trx_dependency_tracker::rotate(int64 start) {
   m_writeset_history_start = start;
   m_writeset_history.clear();
@@ -140,6 +140,16 @@ class Writeset_trx_dependency_tracker {
   std::atomic<ulong> m_opt_max_history_size;
 
  private:
+  /**
+    Make room in the history by removing the rows that were changed least
+    recently, instead of clearing the whole history.
+
+    @param [in] needed  number of rows that must fit in the history afterwards
+
+    @return true if there is room for the needed rows, false otherwise
+  */
+  bool evict_oldest(size_t needed);
+
   /*
     Monitor the last transaction with write-set to use as the minimal
     commit parent when logical clock source is WRITE_SET, i.e., the most recent
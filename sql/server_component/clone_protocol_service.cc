@@ -395,7 +395,15 @@ DEFINE_METHOD(MYSQL *, mysql_clone_connect,
 
   /* Enable compression. */
   if (ssl_ctx->m_enable_compression) {
-    mysql_options(mysql, MYSQL_OPT_COMPRESS, nullptr);
+    if (ssl_ctx->m_compression_algorithm != nullptr &&
+        strcmp(ssl_ctx->m_compression_algorithm, "zstd") == 0) {
+      mysql_options(mysql, MYSQL_OPT_COMPRESSION_ALGORITHMS,
+                    ssl_ctx->m_compression_algorithm);
+      mysql_options(mysql, MYSQL_OPT_ZSTD_COMPRESSION_LEVEL,
+                    &ssl_ctx->m_zstd_compression_level);
+    } else {
+      mysql_options(mysql, MYSQL_OPT_COMPRESS, nullptr);
+    }
     mysql_extension_set_server_extn(mysql, ssl_ctx->m_server_extn);
   }
 
@@ -310,6 +310,14 @@ class Sort_param {
   bool use_hash{false};         // Whether to use hash to distinguish cut JSON
   bool m_remove_duplicates{
       false};  ///< Whether we want to remove duplicate rows
+  uint m_num_sort_threads{1};  ///< Max threads for sorting a sort buffer.
+
+  /// For priority queue sorts: whether rows are checked against the largest
+  /// key in the queue before making their full sort key; see
+  /// init_key_prefix_check().
+  bool m_use_key_prefix_check{false};
+  /// The number of rows that key_prefix_exceeds() rejected.
+  ha_rows m_num_rows_rejected_by_prefix{0};
 
   /// If we are removing duplicate rows and merging, contains a buffer where we
   /// can store the last key seen.
@@ -401,6 +409,25 @@ class Sort_param {
                     const Mem_root_array<TABLE *> &tables,
                     size_t *longest_addons);
 
+  /// The longest first sort field that init_key_prefix_check() accepts.
+  static constexpr size_t kMaxKeyPrefixLength = 64;
+
+  /**
+    Decide whether a priority queue sort can reject rows by looking at the
+    first sort field only, which is the case if it is a plain column with a
+    short, fixed-length key. Sets m_use_key_prefix_check accordingly.
+   */
+  void init_key_prefix_check();
+
+  /**
+    Make the key of the first sort field for the current row, and compare it
+    to the start of the given sort key.
+
+    @param key  A complete sort key, typically the largest one in the queue.
+    @returns true if the current row is known to sort after “key”.
+   */
+  bool key_prefix_exceeds(const uchar *key);
+
   // Adapter for Bounded_queue.
   uint make_sortkey(uchar *dst, size_t dst_len,
                     const Mem_root_array<TABLE *> &tables) {
@@ -456,7 +483,8 @@ class Sort_param {
   enum enum_sort_algorithm {
     FILESORT_ALG_NONE,
     FILESORT_ALG_STD_SORT,
-    FILESORT_ALG_STD_STABLE
+    FILESORT_ALG_STD_STABLE,
+    FILESORT_ALG_RADIX
   };
   enum_sort_algorithm m_sort_algorithm{FILESORT_ALG_NONE};
 
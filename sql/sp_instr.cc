@@ -388,6 +388,17 @@ bool sp_lex_instr::reset_lex_and_exec_core(THD *thd, uint *nextp,
       Opt_trace_object trace_command(&thd->opt_trace);
       Opt_trace_array trace_command_steps(&thd->opt_trace, "steps");
 
+      /*
+        An expression that uses neither tables nor stored functions, like
+        the one of SET x = x + 1 in a loop, has nothing to open, lock or
+        close. Outside of LOCK TABLES and prelocked mode, skip the table
+        opening machinery for it.
+      */
+      const bool uses_tables =
+          m_lex->query_tables != nullptr ||
+          m_lex->sroutines_list.elements != 0 ||
+          m_lex->requires_prelocking() || thd->locked_tables_mode != LTM_NONE;
+
       /*
         Check whenever we have access to tables for this statement
         and open and lock them before executing instructions core function.
@@ -399,7 +410,12 @@ bool sp_lex_instr::reset_lex_and_exec_core(THD *thd, uint *nextp,
                  check_table_access(thd, SELECT_ACL, m_lex->query_tables, false,
                                     UINT_MAX, false));
 
-      if (!error) error = open_and_lock_tables(thd, m_lex->query_tables, 0);
+      if (uses_tables) {
+        if (!error) error = open_and_lock_tables(thd, m_lex->query_tables, 0);
+      } else {
+        // Like lock_tables() does for a statement without tables.
+        m_lex->lock_tables_state = Query_tables_list::LTS_LOCKED;
+      }
 
       if (!error) {
         m_lex->restore_cmd_properties();
@@ -423,9 +439,13 @@ bool sp_lex_instr::reset_lex_and_exec_core(THD *thd, uint *nextp,
         thd->is_error() ? trans_rollback_stmt(thd) : trans_commit_stmt(thd);
         thd->get_stmt_da()->set_overwrite_status(false);
       }
-      thd_proc_info(thd, "closing tables");
-      close_thread_tables(thd);
-      thd_proc_info(thd, nullptr);
+      if (uses_tables) {
+        thd_proc_info(thd, "closing tables");
+        close_thread_tables(thd);
+        thd_proc_info(thd, nullptr);
+      } else {
+        m_lex->lock_tables_state = Query_tables_list::LTS_NOT_LOCKED;
+      }
 
       if (!thd->in_sub_stmt) {
         if (thd->transaction_rollback_request) {
@@ -99,6 +99,7 @@
 #include "sql/error_handler.h"   // Internal_error_handler
 #include "sql/field.h"
 #include "sql/handler.h"
+#include "sql/histograms/column_group.h"  // Table_column_group
 #include "sql/histograms/histogram.h"
 #include "sql/item.h"
 #include "sql/item_cmpfunc.h"  // Item_func_eq
@@ -327,6 +328,17 @@ Table_definition_cache *table_def_cache;
 static TABLE_SHARE *oldest_unused_share, end_of_unused_share;
 static bool table_def_shutdown_in_progress = false;
 
+/**
+  Unused shares evicted from the TDC because it exceeded table_def_size,
+  linked through TABLE_SHARE::next. Destroying a share frees its memory and
+  releases its plugins and performance schema share, which is too much work
+  to do while holding LOCK_open. Such shares are therefore only taken out of
+  the TDC under LOCK_open, and destroyed by free_evicted_table_shares()
+  after LOCK_open has been released. Modified under LOCK_open.
+*/
+static std::atomic<TABLE_SHARE *> evicted_shares{nullptr};
+static void free_evicted_table_shares();
+
 static bool check_and_update_table_version(THD *thd, Table_ref *tables,
                                            TABLE_SHARE *table_share);
 static bool open_table_entry_fini(THD *thd, TABLE_SHARE *share,
@@ -502,6 +514,7 @@ void table_def_start_shutdown(void) {
     table_cache_manager.unlock_all_and_tdc();
     /* Free all cached but unused TABLEs and TABLE_SHAREs. */
     close_cached_tables(nullptr, nullptr, false, LONG_TIMEOUT);
+    free_evicted_table_shares();
   }
 }
 
@@ -509,6 +522,7 @@ void table_def_free(void) {
   DBUG_TRACE;
   if (table_def_cache != nullptr) {
     /* Free table definitions. */
+    free_evicted_table_shares();
     delete table_def_cache;
     table_def_cache = nullptr;
     table_cache_manager.destroy();
@@ -519,6 +533,57 @@ void table_def_free(void) {
 
 uint cached_table_definitions(void) { return table_def_cache->size(); }
 
+/**
+  Remove the least recently used unused share from the TDC. Unless threads
+  wait for it to be flushed, the share is only unlinked and put on the
+  evicted_shares list, to be destroyed after LOCK_open is released.
+*/
+
+static void evict_oldest_unused_share() {
+  mysql_mutex_assert_owner(&LOCK_open);
+  TABLE_SHARE *share = oldest_unused_share;
+  assert(share->next != nullptr && share->ref_count() == 0);
+
+  auto it = table_def_cache->find(to_string(share->table_cache_key));
+  assert(it != table_def_cache->end());
+
+  if (!share->m_flush_tickets.is_empty()) {
+    table_def_cache->erase(it);
+    return;
+  }
+
+  /* Remove from old_unused_share list, then from the TDC. */
+  *share->prev = share->next;
+  share->next->prev = share->prev;
+  share->prev = nullptr;
+  it->second.release();
+  table_def_cache->erase(it);
+
+  share->next = evicted_shares.load(std::memory_order_relaxed);
+  evicted_shares.store(share, std::memory_order_relaxed);
+}
+
+/**
+  Destroy the shares evicted from the TDC by evict_oldest_unused_share().
+  Must be called without holding LOCK_open.
+*/
+
+static void free_evicted_table_shares() {
+  mysql_mutex_assert_not_owner(&LOCK_open);
+  if (evicted_shares.load(std::memory_order_relaxed) == nullptr) return;
+
+  mysql_mutex_lock(&LOCK_open);
+  TABLE_SHARE *share = evicted_shares.exchange(nullptr);
+  mysql_mutex_unlock(&LOCK_open);
+
+  while (share != nullptr) {
+    TABLE_SHARE *next = share->next;
+    share->next = nullptr;
+    free_table_share(share);
+    share = next;
+  }
+}
+
 static TABLE_SHARE *process_found_table_share(THD *thd [[maybe_unused]],
                                               TABLE_SHARE *share,
                                               bool open_view) {
@@ -562,12 +627,68 @@ static TABLE_SHARE *process_found_table_share(THD *thd [[maybe_unused]],
 
   /* Free cache if too big */
   while (table_def_cache->size() > table_def_size && oldest_unused_share->next)
-    table_def_cache->erase(to_string(oldest_unused_share->table_cache_key));
+    evict_oldest_unused_share();
 
   DBUG_PRINT("exit", ("share: %p ref_count: %u", share, share->ref_count()));
   return share;
 }
 
+/**
+  Resolve the column groups stored in the histograms of a TABLE_SHARE to
+  field indexes, and store them in the TABLE_SHARE. Groups with columns that
+  no longer exist are ignored.
+
+  @param share The table share, with its histograms read
+  @param table_def Table definition
+
+  @retval true on error
+  @retval false on success
+*/
+static bool read_column_groups(TABLE_SHARE *share,
+                               const dd::Abstract_table *table_def) {
+  for (const auto &[field_index, histogram] : *share->m_histograms) {
+    for (const histograms::Column_group_statistics &group :
+         histogram->get_column_groups()) {
+      uint *field_indexes = share->mem_root.ArrayAlloc<uint>(group.num_columns);
+      if (field_indexes == nullptr) return true; /* purecov: inspected */
+
+      size_t num_found = 0;
+      for (size_t i = 0; i < group.num_columns; ++i) {
+        for (const auto column : table_def->columns()) {
+          if (!column->is_se_hidden() &&
+              my_strcasecmp(system_charset_info, column->name().c_str(),
+                            group.column_names[i].str) == 0) {
+            field_indexes[num_found++] = column->ordinal_position() - 1;
+            break;
+          }
+        }
+      }
+      if (num_found != group.num_columns || num_found < 2) continue;
+      std::sort(field_indexes, field_indexes + num_found);
+
+      if (share->m_column_groups == nullptr) {
+        share->m_column_groups = new (&share->mem_root)
+            Mem_root_array<histograms::Table_column_group>(&share->mem_root);
+        if (share->m_column_groups == nullptr)
+          return true; /* purecov: inspected */
+      }
+      if (share->m_column_groups->push_back(
+              {field_indexes, num_found, group.num_distinct_values}))
+        return true; /* purecov: inspected */
+    }
+  }
+
+  if (share->m_column_groups != nullptr) {
+    std::stable_sort(share->m_column_groups->begin(),
+                     share->m_column_groups->end(),
+                     [](const histograms::Table_column_group &a,
+                        const histograms::Table_column_group &b) {
+                       return a.num_fields > b.num_fields;
+                     });
+  }
+  return false;
+}
+
 /**
   Read any existing histogram statistics from the data dictionary and
   store a copy of them in the TABLE_SHARE.
@@ -625,7 +746,7 @@ static bool read_histograms(THD *thd, TABLE_SHARE *share,
     }
   }
 
-  return false;
+  return read_column_groups(share, table_def);
 }
 
 /** Update TABLE_SHARE with options from dd::Schema object */
@@ -1001,7 +1122,7 @@ void release_table_share(TABLE_SHARE *share) {
 
       if (table_def_cache->size() > table_def_size) {
         /* Delete the least used share to preserve LRU order. */
-        table_def_cache->erase(to_string(oldest_unused_share->table_cache_key));
+        evict_oldest_unused_share();
       }
     }
   }
@@ -3358,6 +3479,8 @@ share_found:
 
   mysql_mutex_unlock(&LOCK_open);
 
+  free_evicted_table_shares();
+
   DEBUG_SYNC(thd, "open_table_found_share");
 
   {
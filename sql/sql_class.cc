@@ -1458,6 +1458,7 @@ THD::~THD() {
   */
   unregister_replica(this, true, true);
 
+  set_retained_mem_root_size(0);
   main_mem_root.Clear();
 
   if (m_token_array != nullptr) {
@@ -2560,6 +2561,14 @@ void THD::mark_transaction_to_rollback(bool all) {
   transaction_rollback_request = all;
 }
 
+void THD::set_retained_mem_root_size(size_t size) {
+  if (size >= m_retained_mem_root_size)
+    query_alloc_retained_bytes += size - m_retained_mem_root_size;
+  else
+    query_alloc_retained_bytes -= m_retained_mem_root_size - size;
+  m_retained_mem_root_size = size;
+}
+
 void THD::set_next_event_pos(const char *_filename, ulonglong _pos) {
   char *&filename = binlog_next_event_pos.file_name;
   if (filename == nullptr) {
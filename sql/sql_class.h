@@ -4323,7 +4323,18 @@ class THD : public MDL_context_owner,
 
   void mark_transaction_to_rollback(bool all);
 
+  /**
+    Record how much memory the MEM_ROOT of the session keeps between
+    statements, for the Query_alloc_retained_bytes status variable.
+
+    @param size  bytes retained
+  */
+  void set_retained_mem_root_size(size_t size);
+
  private:
+  /** Bytes kept by the MEM_ROOT of the session between statements */
+  size_t m_retained_mem_root_size{0};
+
   /** The current internal error handler for this thread, or NULL. */
   Internal_error_handler *m_internal_handler;
 
@@ -888,6 +888,15 @@ bool thd_prepare_connection(THD *thd) {
 
   if (rc) return rc;
 
+  /*
+    Fetch pipelined commands from the socket with one read. Only done after
+    the login, so that no TLS handshake data ends up in the read buffer.
+  */
+  if (thd->is_classic_protocol()) {
+    Vio *vio = thd->get_protocol_classic()->get_vio();
+    if (vio != nullptr) vio_set_buffered_read(vio);
+  }
+
   prepare_new_connection_state(thd);
   return false;
 }
@@ -160,7 +160,16 @@ void compute_digest_hash(const sql_digest_storage *digest_storage,
   static_assert(DIGEST_HASH_SIZE == SHA256_DIGEST_LENGTH,
                 "DIGEST is no longer SHA256, fix compute_digest_hash()");
 
-  SHA_EVP256(digest_storage->m_token_array, digest_storage->m_byte_count, hash);
+  /*
+    The hash is needed by the rewriter, prepared statements and the
+    performance schema for the same statement, so compute it once.
+  */
+  auto *storage = const_cast<sql_digest_storage *>(digest_storage);
+  if (!storage->m_hash_computed) {
+    SHA_EVP256(storage->m_token_array, storage->m_byte_count, storage->m_hash);
+    storage->m_hash_computed = true;
+  }
+  if (hash != storage->m_hash) memcpy(hash, storage->m_hash, DIGEST_HASH_SIZE);
 }
 
 /*
@@ -381,6 +390,7 @@ sql_digest_state *digest_add_token(sql_digest_state *state, uint token,
   sql_digest_storage *digest_storage = nullptr;
 
   digest_storage = &state->m_digest_storage;
+  digest_storage->m_hash_computed = false;
 
   /*
     Stop collecting further tokens if digest storage is full or
@@ -624,6 +634,7 @@ sql_digest_state *digest_reduce_token(sql_digest_state *state, uint token_left,
   sql_digest_storage *digest_storage = nullptr;
 
   digest_storage = &state->m_digest_storage;
+  digest_storage->m_hash_computed = false;
 
   /*
     Stop collecting further tokens if digest storage is full.
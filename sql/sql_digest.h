@@ -98,6 +98,11 @@ struct sql_digest_storage {
   bool m_full;
   size_t m_byte_count;
   unsigned char m_hash[DIGEST_HASH_SIZE];
+  /**
+    True if m_hash holds the hash of the current token array, as computed
+    by compute_digest_hash(). Cleared whenever the token array changes.
+  */
+  bool m_hash_computed;
   /** Character set number. */
   uint m_charset_number;
   /**
@@ -129,6 +134,7 @@ struct sql_digest_storage {
     m_byte_count = 0;
     m_charset_number = 0;
     memset(m_hash, 0, DIGEST_HASH_SIZE);
+    m_hash_computed = false;
   }
 
   inline bool is_empty() { return (m_byte_count == 0); }
@@ -142,6 +148,7 @@ struct sql_digest_storage {
     size_t byte_count_copy = m_token_array_length < from->m_byte_count
                                  ? m_token_array_length
                                  : from->m_byte_count;
+    m_hash_computed = false;
 
     if (byte_count_copy > 0) {
       m_full = from->m_full;
@@ -3420,10 +3420,6 @@ void JOIN::create_access_paths_for_index_subquery() {
 */
 
 int do_sj_dups_weedout(THD *thd, SJ_TMP_TABLE *sjtbl) {
-  int error;
-  SJ_TMP_TABLE_TAB *tab = sjtbl->tabs;
-  SJ_TMP_TABLE_TAB *tab_end = sjtbl->tabs_end;
-
   DBUG_TRACE;
 
   if (sjtbl->is_confluent) {
@@ -3432,9 +3428,16 @@ int do_sj_dups_weedout(THD *thd, SJ_TMP_TABLE *sjtbl) {
     return 0;
   }
 
+  store_sj_weedout_rowids(sjtbl);
+  return write_sj_weedout_row(thd, sjtbl);
+}
+
+/**
+  Store the length of the rowid tuple in the temporary table's record, and
+  return where the tuple itself goes.
+*/
+static uchar *sj_weedout_tuple_ptr(SJ_TMP_TABLE *sjtbl) {
   uchar *ptr = sjtbl->tmp_table->visible_field_ptr()[0]->field_ptr();
-  // Put the rowids tuple into table->record[0]:
-  // 1. Store the length
   if (sjtbl->tmp_table->visible_field_ptr()[0]->get_length_bytes() == 1) {
     *ptr = (uchar)(sjtbl->rowid_len + sjtbl->null_bytes);
     ptr++;
@@ -3442,6 +3445,16 @@ int do_sj_dups_weedout(THD *thd, SJ_TMP_TABLE *sjtbl) {
     int2store(ptr, sjtbl->rowid_len + sjtbl->null_bytes);
     ptr += 2;
   }
+  return ptr;
+}
+
+std::string_view store_sj_weedout_rowids(SJ_TMP_TABLE *sjtbl) {
+  assert(!sjtbl->is_confluent);
+  // Put the rowids tuple into table->record[0]:
+  // 1. Store the length
+  uchar *ptr = sj_weedout_tuple_ptr(sjtbl);
+  const std::string_view tuple(pointer_cast<const char *>(ptr),
+                               sjtbl->rowid_len + sjtbl->null_bytes);
 
   // 2. Zero the null bytes
   uchar *const nulls_ptr = ptr;
@@ -3451,7 +3464,7 @@ int do_sj_dups_weedout(THD *thd, SJ_TMP_TABLE *sjtbl) {
   }
 
   // 3. Put the rowids
-  for (uint i = 0; tab != tab_end; tab++, i++) {
+  for (SJ_TMP_TABLE_TAB *tab = sjtbl->tabs; tab != sjtbl->tabs_end; tab++) {
     handler *h = tab->qep_tab->table()->file;
     if (tab->qep_tab->table()->is_nullable() &&
         tab->qep_tab->table()->has_null_row()) {
@@ -3463,9 +3476,13 @@ int do_sj_dups_weedout(THD *thd, SJ_TMP_TABLE *sjtbl) {
       memcpy(ptr + tab->rowid_offset, h->ref, h->ref_length);
     }
   }
+  return tuple;
+}
 
+int write_sj_weedout_row(THD *thd, SJ_TMP_TABLE *sjtbl) {
   if (!check_unique_constraint(sjtbl->tmp_table)) return 1;
-  error = sjtbl->tmp_table->file->ha_write_row(sjtbl->tmp_table->record[0]);
+  const int error =
+      sjtbl->tmp_table->file->ha_write_row(sjtbl->tmp_table->record[0]);
   if (error) {
     /* If this is a duplicate error, return immediately */
     if (sjtbl->tmp_table->file->is_ignorable_error(error)) return 1;
@@ -3482,6 +3499,13 @@ int do_sj_dups_weedout(THD *thd, SJ_TMP_TABLE *sjtbl) {
   return 0;
 }
 
+int write_sj_weedout_row(THD *thd, SJ_TMP_TABLE *sjtbl,
+                         std::string_view tuple) {
+  assert(tuple.size() == sjtbl->rowid_len + sjtbl->null_bytes);
+  memcpy(sj_weedout_tuple_ptr(sjtbl), tuple.data(), tuple.size());
+  return write_sj_weedout_row(thd, sjtbl);
+}
+
 /*****************************************************************************
   The different ways to read a record
   Returns -1 if row was not found, 0 if row was found and 1 on errors
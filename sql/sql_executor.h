@@ -32,6 +32,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "my_alloc.h"
@@ -236,6 +237,21 @@ int report_handler_error(TABLE *table, int error);
 int join_read_const_table(JOIN_TAB *tab, POSITION *pos);
 
 int do_sj_dups_weedout(THD *thd, SJ_TMP_TABLE *sjtbl);
+/**
+  Put the rowids of the current row combination into the weedout table's
+  record, as done by do_sj_dups_weedout().
+
+  @returns the rowid tuple (null bytes followed by the rowids) in the record
+*/
+std::string_view store_sj_weedout_rowids(SJ_TMP_TABLE *sjtbl);
+/**
+  Write the record filled by store_sj_weedout_rowids() to the weedout table.
+  Return values are as for do_sj_dups_weedout().
+*/
+int write_sj_weedout_row(THD *thd, SJ_TMP_TABLE *sjtbl);
+/// Like above, but for a rowid tuple saved earlier.
+int write_sj_weedout_row(THD *thd, SJ_TMP_TABLE *sjtbl,
+                         std::string_view tuple);
 int update_item_cache_if_changed(List<Cached_item> &list);
 
 // Create list for using with temporary table
@@ -123,6 +123,20 @@ class READ_INFO {
   const char *line_start_ptr, *line_start_end;
   size_t field_term_length, line_term_length, enclosed_length;
   int field_term_char, line_term_char, enclosed_char, escape_char;
+  /*
+    Bytes read_field() has to look at one by one: first bytes of
+    terminators, enclosing and escape characters, and bytes which are not
+    single byte characters in read_charset.
+  */
+  bool special_char[256];
+  /*
+    Set when special_char holds exactly the bytes in special_words, and all
+    bytes above 0x7F if special_high_bytes, so that read_field() can test
+    eight bytes at a time with word_has_special_char().
+  */
+  bool word_scan, special_high_bytes;
+  uint64 special_words[4];
+  uint n_special_words;
   int *stack, *stack_pos;
   bool found_end_of_line, start_of_line, eof;
   bool need_end_io_cache;
@@ -156,6 +170,7 @@ class READ_INFO {
   bool next_line();
   char unescape(char chr);
   bool terminator(const uchar *ptr, size_t length);
+  bool word_has_special_char(uint64 word) const;
   bool find_start_of_fields();
   /* load xml */
   List<XML_TAG> taglist;
@@ -1375,6 +1390,34 @@ READ_INFO::READ_INFO(File file_par, size_t tot_length, const CHARSET_INFO *cs,
   field_term_char = field_term_length ? field_term_ptr[0] : INT_MAX;
   line_term_char = line_term_length ? line_term_ptr[0] : INT_MAX;
 
+  special_high_bytes = false;
+  for (int chr = 0; chr < 256; chr++) {
+    bool single_byte = my_mbcharlen(cs, chr) == 1;
+    special_char[chr] = chr == field_term_char || chr == line_term_char ||
+                        chr == enclosed_char || chr == escape_char ||
+                        !single_byte;
+    if (chr > 0x7F && !single_byte) special_high_bytes = true;
+  }
+
+  n_special_words = 0;
+  const int term_chars[] = {field_term_char, line_term_char, enclosed_char,
+                            escape_char};
+  for (int chr : term_chars) {
+    if (chr < 0 || chr > 0xFF) continue;
+    const uint64 word = 0x0101010101010101ULL * static_cast<uchar>(chr);
+    if (std::find(special_words, special_words + n_special_words, word) ==
+        special_words + n_special_words)
+      special_words[n_special_words++] = word;
+  }
+  word_scan = true;
+  for (int chr = 0; chr < 256; chr++) {
+    bool expected = (special_high_bytes && chr > 0x7F) ||
+                    std::find(special_words, special_words + n_special_words,
+                              0x0101010101010101ULL * chr) !=
+                        special_words + n_special_words;
+    if (special_char[chr] != expected) word_scan = false;
+  }
+
   /* Set of a stack for unget if long terminators */
   size_t length =
       max<size_t>(cs->mbmaxlen, max(field_term_length, line_term_length)) + 1;
@@ -1464,6 +1507,26 @@ inline bool READ_INFO::terminator(const uchar *ptr, size_t length) {
   return false;
 }
 
+/**
+  Check if any of the eight bytes of a word is in special_char. Only valid
+  when word_scan is set.
+
+  @param word Eight bytes of input, in any byte order.
+
+  @returns true if the word contains a special byte.
+*/
+inline bool READ_INFO::word_has_special_char(uint64 word) const {
+  constexpr uint64 low_bits = 0x0101010101010101ULL;
+  constexpr uint64 high_bits = 0x8080808080808080ULL;
+  if (special_high_bytes && (word & high_bits)) return true;
+  for (uint i = 0; i < n_special_words; i++) {
+    // Non-zero iff some byte of word equals the special character.
+    const uint64 diff = word ^ special_words[i];
+    if ((diff - low_bits) & ~diff & high_bits) return true;
+  }
+  return false;
+}
+
 /**
   @returns true if error. If READ_INFO::error is true, then error is fatal (OOM
            or charset error). Otherwise see READ_INFO::found_end_of_line for
@@ -1498,6 +1561,28 @@ bool READ_INFO::read_field() {
   for (;;) {
     bool escaped_mb = false;
     while (to < end_of_buff) {
+      /*
+        Unless characters were pushed back, copy the run of ordinary bytes
+        available in the read cache in one go.
+      */
+      if (stack_pos == stack) {
+        uchar *pos = cache.read_pos;
+        uchar *end = pos + std::min<size_t>(cache.read_end - pos,
+                                            end_of_buff - to);
+        if (word_scan) {
+          uint64 word;
+          while (end - pos >= 8) {
+            memcpy(&word, pos, sizeof(word));
+            if (word_has_special_char(word)) break;
+            pos += 8;
+          }
+        }
+        while (pos < end && !special_char[*pos]) pos++;
+        memcpy(to, cache.read_pos, pos - cache.read_pos);
+        to += pos - cache.read_pos;
+        cache.read_pos = pos;
+        if (to == end_of_buff) break;
+      }
       chr = GET;
       if (chr == my_b_EOF) goto found_eof;
       if (chr == escape_char) {
@@ -1928,8 +1928,13 @@ bool dispatch_command(THD *thd, const COM_DATA *com_data,
         copy_bind_parameter_values(thd, parameters,
                                    com_data->com_stmt_execute.parameter_count);
 
+        const ulong iteration_count =
+            (com_data->com_stmt_execute.open_cursor & PARAMETER_ARRAY_AVAILABLE)
+                ? com_data->com_stmt_execute.iteration_count
+                : 1;
         mysqld_stmt_execute(thd, stmt, com_data->com_stmt_execute.has_new_types,
-                            com_data->com_stmt_execute.open_cursor, parameters);
+                            com_data->com_stmt_execute.open_cursor, parameters,
+                            iteration_count);
         thd->bind_parameter_values = nullptr;
         thd->bind_parameter_values_count = 0;
       }
@@ -2240,8 +2245,12 @@ bool dispatch_command(THD *thd, const COM_DATA *com_data,
       query_logger.general_log_print(thd, command, NullS);
       // Don't give 'abort' message
       // TODO: access of protocol_classic should be removed
-      if (thd->is_classic_protocol())
-        thd->get_protocol_classic()->get_net()->error = NET_ERROR_UNSET;
+      if (thd->is_classic_protocol()) {
+        NET *net = thd->get_protocol_classic()->get_net();
+        // Send responses held back for commands pipelined before COM_QUIT
+        net_flush(net);
+        net->error = NET_ERROR_UNSET;
+      }
       thd->get_stmt_da()->disable_status();  // Don't send anything back
       error = true;                          // End server
       break;
@@ -2477,20 +2486,19 @@ done:
   thd->work_part_info = nullptr;
 
   /*
-    If we've allocated a lot of memory (compared to the default preallocation
-    size = 8192; note that we don't actually preallocate anymore), free
-    it so that one big query won't cause us to hold on to a lot of RAM forever.
-    If not, keep the last block so that the next query will hopefully be able to
-    run without allocating memory from the OS.
-
-    The factor 5 is pretty much arbitrary, but ends up allowing three
-    allocations (1 + 1.5 + 1.5²) under the current allocation policy.
+    If the statement used no more than query_alloc_retain_size bytes, keep
+    the last block so that the next query will hopefully be able to run
+    without allocating memory from the OS. ClearForReuse() does not reset the
+    block size, so a connection repeating statements of similar size ends up
+    with a single block large enough for all of them. Otherwise free
+    everything, so that one big query won't cause us to hold on to a lot of
+    RAM forever.
   */
-  constexpr size_t kPreallocSz = 40960;
-  if (thd->mem_root->allocated_size() < kPreallocSz)
+  if (thd->mem_root->allocated_size() <= query_alloc_retain_size)
     thd->mem_root->ClearForReuse();
   else
     thd->mem_root->Clear();
+  thd->set_retained_mem_root_size(thd->mem_root->allocated_size());
 
     /* SHOW PROFILE instrumentation, end */
 #if defined(ENABLED_PROFILING)
@@ -54,6 +54,7 @@
 #include "sql/item.h"
 #include "sql/item_cmpfunc.h"
 #include "sql/join_optimizer/access_path.h"
+#include "sql/join_order_cache.h"
 #include "sql/key.h"
 #include "sql/merge_sort.h"  // merge_sort
 #include "sql/nested_join.h"
@@ -2023,8 +2024,14 @@ bool Optimize_table_order::choose_table_order() {
 
   if (straight_join)
     optimize_straight_join(join_tables);
-  else {
+  else if (emb_sjm_nest == nullptr && join_order_cache_lookup(join)) {
+    // Cost the order that was chosen for an earlier execution instead of
+    // searching for one.
+    Opt_trace_object(&join->thd->opt_trace).add("cached_join_order", true);
+    optimize_straight_join(join_tables);
+  } else {
     if (greedy_search(join_tables)) return true;
+    if (emb_sjm_nest == nullptr) join_order_cache_store(join);
   }
 
   deps_lateral.assert_unchanged();
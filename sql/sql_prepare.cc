@@ -1854,6 +1854,49 @@ static void reset_stmt_parameters(Prepared_statement *stmt) {
   }
 }
 
+/**
+  Execute an INSERT or REPLACE once for every parameter row of a
+  COM_STMT_EXECUTE with PARAMETER_ARRAY_AVAILABLE, and report the sum of
+  the affected rows in a single OK packet. Execution stops at the first
+  row that fails.
+
+  @param thd              current thread
+  @param stmt             prepared statement
+  @param has_new_types    true if the first row has data types defined
+  @param parameters       iteration_count rows of parameters
+  @param iteration_count  number of parameter rows
+*/
+static void execute_param_array(THD *thd, Prepared_statement *stmt,
+                                bool has_new_types, PS_PARAM *parameters,
+                                ulong iteration_count) {
+  const enum_sql_command command = stmt->m_lex->sql_command;
+  if (command != SQLCOM_INSERT && command != SQLCOM_REPLACE) {
+    my_error(ER_WRONG_ARGUMENTS, MYF(0), "COM_STMT_EXECUTE");
+    return;
+  }
+
+  ulonglong affected_rows = 0;
+  ulonglong last_insert_id = 0;
+  for (ulong row = 0; row < iteration_count; row++) {
+    if (row > 0) thd->reset_for_next_command();
+
+    String expanded_query;
+    expanded_query.set_charset(default_charset_info);
+    if (stmt->set_parameters(thd, &expanded_query, has_new_types && row == 0,
+                             parameters + row * stmt->m_param_count))
+      return;
+    if (stmt->execute_loop(thd, &expanded_query, false)) return;
+
+    const Diagnostics_area *da = thd->get_stmt_da();
+    if (!da->is_ok()) return;
+    affected_rows += da->affected_rows();
+    if (row == 0) last_insert_id = da->last_insert_id();
+  }
+
+  thd->get_stmt_da()->reset_diagnostics_area();
+  my_ok(thd, affected_rows, last_insert_id);
+}
+
 /**
   COM_STMT_EXECUTE handler: execute a previously prepared statement.
 
@@ -1871,10 +1914,12 @@ static void reset_stmt_parameters(Prepared_statement *stmt) {
                         otherwise types from last execution will be used
   @param execute_flags  flag used to decide if a cursor should be used
   @param parameters     prepared statement's parsed parameters
+  @param iteration_count  number of parameter rows in parameters
 */
 
 void mysqld_stmt_execute(THD *thd, Prepared_statement *stmt, bool has_new_types,
-                         ulong execute_flags, PS_PARAM *parameters) {
+                         ulong execute_flags, PS_PARAM *parameters,
+                         ulong iteration_count) {
   DBUG_TRACE;
 
 #if defined(ENABLED_PROFILING)
@@ -1905,8 +1950,11 @@ void mysqld_stmt_execute(THD *thd, Prepared_statement *stmt, bool has_new_types,
   // Query text for binary, general or slow log, if any of them is open
   String expanded_query;
   expanded_query.set_charset(default_charset_info);
-  // If no error happened while setting the parameters, execute statement.
-  if (!stmt->set_parameters(thd, &expanded_query, has_new_types, parameters)) {
+  if (iteration_count > 1) {
+    execute_param_array(thd, stmt, has_new_types, parameters, iteration_count);
+  } else if (!stmt->set_parameters(thd, &expanded_query, has_new_types,
+                                   parameters)) {
+    // If no error happened while setting the parameters, execute statement.
     bool open_cursor = execute_flags & (ulong)CURSOR_TYPE_READ_ONLY;
     stmt->execute_loop(thd, &expanded_query, open_cursor);
   }
@@ -2537,6 +2585,12 @@ bool Prepared_statement::prepare(THD *thd, const char *query_str,
     error = parse_sql(thd, &parser_state, nullptr);
   }
   error |= thd->is_error();
+  m_has_digest_hash = false;
+  if (!error && !digest.m_digest_storage.is_empty() &&
+      !digest.m_digest_storage.m_full) {
+    compute_digest_hash(&digest.m_digest_storage, m_digest_hash);
+    m_has_digest_hash = true;
+  }
   if (!error) {  // We've just created the statement maybe there is a rewrite
     invoke_post_parse_rewrite_plugins(thd, true);
     error = init_param_array(thd, this);
@@ -3342,6 +3396,8 @@ void Prepared_statement::swap_prepared_statement(Prepared_statement *copy) {
   std::swap(m_name, copy->m_name);
   /* Ditto */
   std::swap(m_db, copy->m_db);
+  std::swap(m_digest_hash, copy->m_digest_hash);
+  std::swap(m_has_digest_hash, copy->m_has_digest_hash);
   // Need a new cursor-specific query result after repreparation
   std::swap(m_cursor_result, copy->m_cursor_result);
   std::swap(m_regular_result, copy->m_regular_result);
@@ -36,6 +36,7 @@
 #include "mysql/components/services/bits/psi_statement_bits.h"
 #include "mysql_com.h"
 #include "sql/sql_class.h"  // Query_arena
+#include "sql/sql_digest.h"  // DIGEST_HASH_SIZE
 #include "sql/sql_error.h"
 #include "sql/sql_list.h"
 
@@ -119,7 +120,8 @@ bool mysql_stmt_precheck(THD *thd, const COM_DATA *com_data,
 void mysqld_stmt_prepare(THD *thd, const char *query, uint length,
                          Prepared_statement *stmt);
 void mysqld_stmt_execute(THD *thd, Prepared_statement *stmt, bool has_new_types,
-                         ulong execute_flags, PS_PARAM *parameters);
+                         ulong execute_flags, PS_PARAM *parameters,
+                         ulong iteration_count);
 void mysqld_stmt_close(THD *thd, Prepared_statement *stmt);
 void mysql_sql_stmt_prepare(THD *thd);
 void mysql_sql_stmt_execute(THD *thd);
@@ -392,6 +394,10 @@ class Prepared_statement final {
   /// Flag that specifies preparation state
   bool m_is_sql_prepare{false};
 
+  /// Hash of the statement digest, valid if m_has_digest_hash is true.
+  unsigned char m_digest_hash[DIGEST_HASH_SIZE];
+  bool m_has_digest_hash{false};
+
   /// Flag that prevents recursive invocation of prepared statements
   bool m_in_use{false};
 
@@ -431,6 +437,15 @@ class Prepared_statement final {
   bool is_in_use() const { return m_in_use; }
   bool is_sql_prepare() const { return m_is_sql_prepare; }
   void set_sql_prepare(bool prepare = true) { m_is_sql_prepare = prepare; }
+  const LEX_CSTRING &db() const { return m_db; }
+  /**
+    The hash of the digest of the statement text, which is the same for all
+    statements that differ only in their literals, or nullptr if no (complete)
+    digest was computed when the statement was prepared.
+  */
+  const unsigned char *digest_hash() const {
+    return m_has_digest_hash ? m_digest_hash : nullptr;
+  }
   void deallocate(THD *thd);
   bool prepare(THD *thd, const char *packet, size_t packet_length,
                Item_param **orig_param_array);
@@ -114,6 +114,7 @@
 #include "sql/transaction_info.h"
 #include "sql/trigger_chain.h"
 #include "sql/trigger_def.h"
+#include "sql/uniques.h"  // Unique
 #include "sql/visible_fields.h"
 #include "template_utils.h"
 #include "thr_lock.h"
@@ -697,6 +698,12 @@ bool Sql_cmd_update::update_single_table(THD *thd) {
           internally, which allows us to read from it
           using SortFileIndirectIterator.
 
+          Without ORDER BY, the order in which the rows are updated is
+          unspecified, so the row pointers are collected in a Unique object
+          instead. It returns them sorted by position, so the update loop
+          visits the rows in the order they are stored (for InnoDB, primary
+          key order) rather than in the order of the index being scanned.
+
           TODO: Find something less ugly.
          */
         Key_map covering_keys_for_cond;  // @todo - move this
@@ -745,14 +752,23 @@ bool Sql_cmd_update::update_single_table(THD *thd) {
         THD_STAGE_INFO(thd, stage_searching_rows_for_update);
         ha_rows tmp_limit = limit;
 
-        IO_CACHE *tempfile =
-            (IO_CACHE *)my_malloc(key_memory_TABLE_sort_io_cache,
-                                  sizeof(IO_CACHE), MYF(MY_FAE | MY_ZEROFILL));
+        IO_CACHE *tempfile = nullptr;
+        unique_ptr_destroy_only<Unique> sorted_rowids;
+        if (order == nullptr) {
+          sorted_rowids = make_unique_destroy_only<Unique>(
+              thd->mem_root, refpos_order_cmp, table->file,
+              table->file->ref_length, thd->variables.sortbuff_size);
+          if (sorted_rowids == nullptr) return true; /* purecov: inspected */
+        } else {
+          tempfile = (IO_CACHE *)my_malloc(key_memory_TABLE_sort_io_cache,
+                                           sizeof(IO_CACHE),
+                                           MYF(MY_FAE | MY_ZEROFILL));
 
-        if (open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX,
-                             DISK_BUFFER_SIZE, MYF(MY_WME))) {
-          my_free(tempfile);
-          return true;
+          if (open_cached_file(tempfile, mysql_tmpdir, TEMP_PREFIX,
+                               DISK_BUFFER_SIZE, MYF(MY_WME))) {
+            my_free(tempfile);
+            return true;
+          }
         }
 
         while (!(error = iterator->Read()) && !thd->killed) {
@@ -779,7 +795,10 @@ bool Sql_cmd_update::update_single_table(THD *thd) {
             continue; /* repeat the read of the same row if it still exists */
 
           table->file->position(table->record[0]);
-          if (my_b_write(tempfile, table->file->ref, table->file->ref_length)) {
+          if (sorted_rowids != nullptr
+                  ? sorted_rowids->unique_add(table->file->ref)
+                  : my_b_write(tempfile, table->file->ref,
+                               table->file->ref_length)) {
             error = 1; /* purecov: inspected */
             break;     /* purecov: inspected */
           }
@@ -798,21 +817,33 @@ bool Sql_cmd_update::update_single_table(THD *thd) {
         table->file->ha_index_or_rnd_end();
         iterator.reset();
 
-        // Change reader to use tempfile
-        if (reinit_io_cache(tempfile, READ_CACHE, 0L, false, false))
-          error = 1; /* purecov: inspected */
+        if (sorted_rowids != nullptr) {
+          if (error >= 0) return error > 0;
 
-        if (error >= 0) {
-          close_cached_file(tempfile);
-          my_free(tempfile);
-          return error > 0;
-        }
+          // Change reader to use the sorted row pointers
+          if (sorted_rowids->get(table)) return true; /* purecov: inspected */
+          sorted_rowids.reset();
+          iterator = init_table_iterator(thd, table,
+                                         /*ignore_not_found_rows=*/false,
+                                         /*count_examined_rows=*/false);
+          if (iterator == nullptr) return true; /* purecov: inspected */
+        } else {
+          // Change reader to use tempfile
+          if (reinit_io_cache(tempfile, READ_CACHE, 0L, false, false))
+            error = 1; /* purecov: inspected */
 
-        iterator = NewIterator<SortFileIndirectIterator>(
-            thd, thd->mem_root, Mem_root_array<TABLE *>{table}, tempfile,
-            /*ignore_not_found_rows=*/false, /*has_null_flags=*/false,
-            /*examined_rows=*/nullptr);
-        if (iterator->Init()) return true;
+          if (error >= 0) {
+            close_cached_file(tempfile);
+            my_free(tempfile);
+            return error > 0;
+          }
+
+          iterator = NewIterator<SortFileIndirectIterator>(
+              thd, thd->mem_root, Mem_root_array<TABLE *>{table}, tempfile,
+              /*ignore_not_found_rows=*/false, /*has_null_flags=*/false,
+              /*examined_rows=*/nullptr);
+          if (iterator->Init()) return true;
+        }
 
         destroy(range_scan);
         range_scan = nullptr;
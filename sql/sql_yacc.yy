@@ -1384,6 +1384,7 @@ void warn_about_deprecated_binary(THD *thd)
 %token<lexer.keyword> BULK_SYM                   1201  /* MYSQL */
 %token<lexer.keyword> URL_SYM                    1202   /* MYSQL */
 %token<lexer.keyword> GENERATE_SYM               1203   /* MYSQL */
+%token<lexer.keyword> APPROX_COUNT_DISTINCT_SYM  1204   /* MYSQL */
 
 /*
   Precedence rules used to resolve the ambiguity when using keywords as idents
@@ -11093,6 +11094,10 @@ sum_expr:
             $$ = NEW_PTN Item_sum_json_object(
                 @$, $3, $5, $7, std::move(wrapper), std::move(object));
           }
+        | APPROX_COUNT_DISTINCT_SYM '(' in_sum_expr ')'
+          {
+            $$= NEW_PTN Item_sum_approx_count_distinct(@$, $3);
+          }
         | ST_COLLECT_SYM '(' in_sum_expr ')' opt_windowing_clause
           {
             $$= NEW_PTN Item_sum_collect(@$, $3, $5, false);
@@ -15252,6 +15257,7 @@ ident_keywords_unambiguous:
         | ALGORITHM_SYM
         | ALWAYS_SYM
         | ANY_SYM
+        | APPROX_COUNT_DISTINCT_SYM
         | ARRAY_SYM
         | AT_SYM
         | ATTRIBUTE_SYM
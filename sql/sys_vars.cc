@@ -99,7 +99,10 @@
 #include "sql/derror.h"                          // read_texts
 #include "sql/discrete_interval.h"
 #include "sql/events.h"          // Events
-#include "sql/hostname_cache.h"  // host_cache_resize
+#include "sql/histograms/refresher.h"  // opt_histogram_refresh_threshold
+#include "sql/hostname_cache.h"        // host_cache_resize
+#include "sql/join_optimizer/cardinality_feedback.h"  // opt_cardinality_feedback_size
+#include "sql/join_order_cache.h"  // opt_join_order_cache_size
 #include "sql/log.h"
 #include "sql/log_event.h"  // MAX_MAX_ALLOWED_PACKET
 #include "sql/mdl.h"
@@ -1205,6 +1208,18 @@ static Sys_var_ulong Sys_binlog_group_commit_sync_no_delay_count(
     CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 100000 /* max connections */),
     DEFAULT(0), BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG);
 
+static Sys_var_long Sys_binlog_group_commit_sync_latency_target(
+    "binlog_group_commit_sync_latency_target",
+    "The number of microseconds a transaction should at most spend in the "
+    "binary log group commit sync stage. When not 0, it replaces "
+    "--binlog-group-commit-sync-delay: the server waits for the sync queue "
+    "to fill only as long as that budget allows, given the measured sync "
+    "time and commit rate, and does not wait when no more transactions are "
+    "expected to arrive in time. Default: 0. Min: 0. Max: 1000000.",
+    GLOBAL_VAR(opt_binlog_group_commit_sync_latency_target),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 1000000 /* max 1 sec */),
+    DEFAULT(0), BLOCK_SIZE(1), NO_MUTEX_GUARD, NOT_IN_BINLOG);
+
 static bool check_outside_trx(sys_var *var, THD *thd, set_var *) {
   if (thd->in_active_multi_stmt_transaction()) {
     my_error(ER_VARIABLE_NOT_SETTABLE_IN_TRANSACTION, MYF(0), var->name.str);
@@ -2320,6 +2335,26 @@ static Sys_var_ulong Sys_join_buffer_size(
     HINT_UPDATEABLE SESSION_VAR(join_buff_size), CMD_LINE(REQUIRED_ARG),
     VALID_RANGE(128, ULONG_MAX), DEFAULT(256 * 1024), BLOCK_SIZE(128));
 
+static Sys_var_ulong Sys_join_ref_hash_threshold(
+    "join_ref_hash_threshold",
+    "The number of index lookups into a table, within one execution of a "
+    "join, after which the lookups are answered from an in-memory hash table "
+    "over the whole table instead, as in a hash join. Only done for tables "
+    "that are expected to fit in join_buffer_size, and never before there "
+    "have been as many lookups as there are rows in the table. "
+    "The value 0 disables this",
+    HINT_UPDATEABLE SESSION_VAR(join_ref_hash_threshold),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, ULONG_MAX), DEFAULT(0),
+    BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_hash_join_build_threads(
+    "hash_join_build_threads",
+    "The number of threads used for inserting the rows from the build input "
+    "of a hash join into the in-memory hash table. The value 1 means that "
+    "the hash table is built by the session thread alone",
+    HINT_UPDATEABLE SESSION_VAR(hash_join_build_threads),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 static Sys_var_keycache Sys_key_buffer_size(
     "key_buffer_size",
     "The size of the buffer used for "
@@ -3295,6 +3330,53 @@ static Sys_var_ulong Sys_optimizer_max_subgraph_pairs(
     CMD_LINE(REQUIRED_ARG), VALID_RANGE(1, INT_MAX), DEFAULT(100000),
     BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_optimizer_join_order_cache_size(
+    "optimizer_join_order_cache_size",
+    "The maximum number of join orders to remember across statements. "
+    "Statements that differ only in their literals reuse the join order "
+    "that was chosen for the first of them, skipping the search for one, "
+    "as long as the table definitions and row estimates stay about the "
+    "same. The value 0 disables the cache. Requires statement digests "
+    "(max_digest_length > 0), and is ignored by the hypergraph join "
+    "optimizer",
+    GLOBAL_VAR(opt_join_order_cache_size), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, 1024 * 1024), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_optimizer_cardinality_feedback_size(
+    "optimizer_cardinality_feedback_size",
+    "The maximum number of filter selectivities to remember from EXPLAIN "
+    "ANALYZE. When the hypergraph join optimizer later sees a filter "
+    "condition that EXPLAIN ANALYZE has run on enough rows, it uses the "
+    "observed selectivity instead of its own estimate. The value 0 disables "
+    "both recording and use of the feedback. "
+    "Ignored by the old (non-hypergraph) join optimizer",
+    GLOBAL_VAR(opt_cardinality_feedback_size), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, 1024 * 1024), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_ulong Sys_optimizer_simplification_threads(
+    "optimizer_simplification_threads",
+    "The number of threads the hypergraph join optimizer uses for counting "
+    "subgraph pairs when a query has more than optimizer_max_subgraph_pairs "
+    "of them and needs to be simplified. Each thread tries a different "
+    "number of simplification steps. The value 1 means that all counting "
+    "is done by the session thread alone. "
+    "Ignored by the old (non-hypergraph) join optimizer",
+    HINT_UPDATEABLE SESSION_VAR(optimizer_simplification_threads),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(1, 64), DEFAULT(1), BLOCK_SIZE(1));
+
+static Sys_var_ulonglong Sys_parallel_table_scan_min_rows(
+    "parallel_table_scan_min_rows",
+    "Full scans of tables estimated to have at least this many rows are "
+    "read by the storage engine with several threads, when it supports "
+    "that, and the rows are gathered by the session thread. Only plain "
+    "SELECT statements doing consistent reads of tables without BLOB or "
+    "virtual columns are affected. The number of threads is set by the "
+    "storage engine, e.g. innodb_parallel_read_threads. A value of 0 "
+    "disables parallel table scans.",
+    HINT_UPDATEABLE SESSION_VAR(parallel_table_scan_min_rows),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, ULLONG_MAX), DEFAULT(0),
+    BLOCK_SIZE(1));
+
 static Sys_var_ulong Sys_range_optimizer_max_mem_size(
     "range_optimizer_max_mem_size",
     "Maximum amount of memory used by the range optimizer "
@@ -3308,6 +3390,17 @@ static Sys_var_ulong Sys_range_optimizer_max_mem_size(
     CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, ULONG_MAX), DEFAULT(8388608),
     BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_range_optimizer_max_in_list_expansion(
+    "range_optimizer_max_in_list_expansion",
+    "IN-lists with more values than this are not expanded into one range "
+    "per value during range analysis. The range optimizer uses a single "
+    "range covering all the values instead, and a range scan on an index "
+    "over the column looks up the values one by one while reading rows. "
+    "A value of 0 means that IN-lists are always expanded.",
+    HINT_UPDATEABLE SESSION_VAR(range_optimizer_max_in_list_expansion),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, ULONG_MAX), DEFAULT(0),
+    BLOCK_SIZE(1));
+
 static bool limit_parser_max_mem_size(sys_var *, THD *thd, set_var *var) {
   if (var->is_global_persist()) return false;
   ulonglong val = var->save_result.ulonglong_value;
@@ -3333,6 +3426,17 @@ static Sys_var_ulonglong Sys_histogram_generation_max_mem_size(
     NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(check_session_admin),
     ON_UPDATE(nullptr));
 
+static Sys_var_ulong Sys_histogram_refresh_threshold(
+    "histogram_refresh_threshold",
+    "When the number of rows written, updated or deleted in a table since its "
+    "histograms were last updated reaches this percentage of the rows in the "
+    "table, a background thread samples the table and merges the sample into "
+    "its equi-height histograms. The value 0 disables the refresh, so that "
+    "histograms are only updated by ANALYZE TABLE",
+    GLOBAL_VAR(opt_histogram_refresh_threshold), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, 100), DEFAULT(0), BLOCK_SIZE(1), NO_MUTEX_GUARD,
+    NOT_IN_BINLOG, ON_CHECK(nullptr), ON_UPDATE(nullptr));
+
 /*
   Need at least 400Kb to get through bootstrap.
   Need at least 8Mb to get through mtr check testcase, which does
@@ -3905,6 +4009,14 @@ static Sys_var_ulong Sys_query_alloc_block_size(
     BLOCK_SIZE(1024), NO_MUTEX_GUARD, NOT_IN_BINLOG, ON_CHECK(nullptr),
     ON_UPDATE(fix_thd_mem_root));
 
+static Sys_var_ulong Sys_query_alloc_retain_size(
+    "query_alloc_retain_size",
+    "Statement memory of up to this many bytes is kept by a session for its "
+    "next statement, to avoid allocating it again. Sessions that used more "
+    "free all of it",
+    GLOBAL_VAR(query_alloc_retain_size), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(0, UINT_MAX32), DEFAULT(256 * 1024), BLOCK_SIZE(1024));
+
 static Sys_var_ulong Sys_query_prealloc_size(
     "query_prealloc_size", "Persistent buffer for query parsing and execution",
     SESSION_VAR(query_prealloc_size), CMD_LINE(REQUIRED_ARG),
@@ -3998,14 +4110,39 @@ static Sys_var_ulong Sys_trans_prealloc_size(
     ON_UPDATE(nullptr), DEPRECATED_VAR(""));
 
 static const char *thread_handling_names[] = {
-    "one-thread-per-connection", "no-threads", "loaded-dynamically", nullptr};
+    "one-thread-per-connection", "no-threads", "pool-of-threads",
+    "loaded-dynamically", nullptr};
 static Sys_var_enum Sys_thread_handling(
     "thread_handling",
     "Define threads usage for handling queries, one of "
-    "one-thread-per-connection, no-threads, loaded-dynamically",
+    "one-thread-per-connection, no-threads, pool-of-threads, "
+    "loaded-dynamically",
     READ_ONLY GLOBAL_VAR(Connection_handler_manager::thread_handling),
     CMD_LINE(REQUIRED_ARG), thread_handling_names, DEFAULT(0));
 
+static Sys_var_uint Sys_thread_pool_groups(
+    "thread_pool_groups",
+    "Number of thread groups of the pool-of-threads connection handler. "
+    "0 means one group per CPU",
+    READ_ONLY GLOBAL_VAR(Thread_pool_connection_handler::group_count),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(0, 512), DEFAULT(0), BLOCK_SIZE(1));
+
+static Sys_var_uint Sys_thread_pool_stall_limit(
+    "thread_pool_stall_limit",
+    "Time in milliseconds after which a thread group of the pool-of-threads "
+    "connection handler that made no progress gets another worker thread",
+    GLOBAL_VAR(Thread_pool_connection_handler::stall_limit),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(10, 60000), DEFAULT(500),
+    BLOCK_SIZE(1));
+
+static Sys_var_uint Sys_thread_pool_max_threads(
+    "thread_pool_max_threads",
+    "Maximum number of worker threads of the pool-of-threads connection "
+    "handler",
+    READ_ONLY GLOBAL_VAR(Thread_pool_connection_handler::max_threads_limit),
+    CMD_LINE(REQUIRED_ARG), VALID_RANGE(1, 65536), DEFAULT(2000),
+    BLOCK_SIZE(1));
+
 static Sys_var_charptr Sys_secure_file_priv(
     "secure_file_priv",
     "Limit LOAD DATA, SELECT ... OUTFILE, and LOAD_FILE() to files "
@@ -4823,6 +4960,15 @@ static Sys_var_ulong Sys_sort_buffer(
     VALID_RANGE(MIN_SORT_MEMORY, ULONG_MAX), DEFAULT(DEFAULT_SORT_MEMORY),
     BLOCK_SIZE(1));
 
+static Sys_var_ulong Sys_sort_threads(
+    "sort_threads",
+    "The number of threads used for sorting the contents of a sort buffer. "
+    "Each thread sorts a slice of the buffer, and the slices are then "
+    "merged. The value 1 means that sorting is done by the session thread "
+    "alone",
+    HINT_UPDATEABLE SESSION_VAR(sort_threads), CMD_LINE(REQUIRED_ARG),
+    VALID_RANGE(1, 256), DEFAULT(1), BLOCK_SIZE(1));
+
 /**
   Check sql modes strict_mode, 'NO_ZERO_DATE', 'NO_ZERO_IN_DATE' and
   'ERROR_FOR_DIVISION_BY_ZERO' are used together. If only subset of it
@@ -5350,6 +5496,13 @@ static Sys_var_bool Sys_temptable_use_mmap(
     ON_UPDATE(update_deprecated_with_removal_message), nullptr,
     sys_var::PARSE_NORMAL);
 
+static Sys_var_bool Sys_temptable_spill_to_mmap(
+    "temptable_spill_to_mmap",
+    "Let a TempTable table that reaches tmp_table_size go on in MMAP-backed "
+    "files, as long as temptable_max_mmap allows, instead of converting it "
+    "to an on-disk table.",
+    GLOBAL_VAR(temptable_spill_to_mmap), CMD_LINE(OPT_ARG), DEFAULT(false));
+
 static Sys_var_plugin Sys_default_tmp_storage_engine(
     "default_tmp_storage_engine",
     "The default storage engine for new explicit temporary tables",
@@ -5453,6 +5606,15 @@ static Sys_var_bit Sys_autocommit("autocommit", "autocommit",
                                   ON_UPDATE(fix_autocommit));
 export sys_var *Sys_autocommit_ptr = &Sys_autocommit;  // for sql_yacc.yy
 
+static Sys_var_bool Sys_filter_compile_conditions(
+    "filter_compile_conditions",
+    "Evaluate the comparisons of integer columns with integer constants, "
+    "and IS [NOT] NULL tests of integer columns, in WHERE and HAVING "
+    "conditions from a flat program compiled when execution starts, "
+    "instead of walking the Item tree for every row",
+    HINT_UPDATEABLE SESSION_VAR(filter_compile_conditions), CMD_LINE(OPT_ARG),
+    DEFAULT(false));
+
 static Sys_var_bool Sys_big_tables(
     "big_tables",
     "Allow big result sets by saving all "
@@ -220,6 +220,7 @@ struct System_variables {
   ulonglong long_query_time;
   bool end_markers_in_json;
   bool windowing_use_high_precision;
+  bool filter_compile_conditions;
   /* A bitmap for switching optimizations on/off */
   ulonglong optimizer_switch;
   ulonglong optimizer_trace;           ///< bitmap to tune optimizer tracing
@@ -237,6 +238,8 @@ struct System_variables {
   uint cte_max_recursion_depth;
   ulonglong histogram_generation_max_mem_size;
   ulong join_buff_size;
+  ulong join_ref_hash_threshold;
+  ulong hash_join_build_threads;
   ulong lock_wait_timeout;
   ulong max_allowed_packet;
   ulong max_error_count;
@@ -254,14 +257,18 @@ struct System_variables {
   ulong optimizer_prune_level;
   ulong optimizer_search_depth;
   ulong optimizer_max_subgraph_pairs;
+  ulong optimizer_simplification_threads;
+  ulonglong parallel_table_scan_min_rows;
   ulonglong parser_max_mem_size;
   ulong range_optimizer_max_mem_size;
+  ulong range_optimizer_max_in_list_expansion;
   ulong preload_buff_size;
   ulong profiling_history_size;
   ulong read_buff_size;
   ulong read_rnd_buff_size;
   ulong div_precincrement;
   ulong sortbuff_size;
+  ulong sort_threads;
   ulong max_sp_recursion_depth;
   ulong default_week_format;
   ulong max_seeks_for_key;
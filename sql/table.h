@@ -26,6 +26,7 @@
 #include <assert.h>
 #include <string.h>
 #include <sys/types.h>
+#include <atomic>
 #include <string>
 
 #include "field_types.h"
@@ -67,6 +68,7 @@ class Field_longlong;
 
 namespace histograms {
 class Histogram;
+struct Table_column_group;
 }
 
 class ACL_internal_schema_access;
@@ -714,6 +716,22 @@ struct TABLE_SHARE {
   */
   const histograms::Histogram *find_histogram(uint field_index) const;
 
+  /**
+    The column-group statistics stored with the histograms, largest group
+    first, or nullptr if there are none. Allocated on mem_root together with
+    m_histograms.
+  */
+  Mem_root_array<histograms::Table_column_group> *m_column_groups{nullptr};
+
+  /**
+    The number of rows modified in the table since the histograms in
+    m_histograms were loaded; see histograms::note_modified_rows().
+  */
+  std::atomic<ha_rows> m_histogram_modified_rows{0};
+
+  /// Whether a background refresh of the histograms has been requested.
+  std::atomic<bool> m_histogram_refresh_requested{false};
+
   /** Category of this table. */
   TABLE_CATEGORY table_category{TABLE_UNKNOWN_CATEGORY};
 
@@ -31,7 +31,9 @@
   When the tree uses more memory than 'max_heap_table_size',
   write the tree (in sorted order) out to disk and start with a new tree.
   When all data has been generated, merge the trees (removing any found
-  duplicates).
+  duplicates). Keys that compare as raw bytes (e.g. for COUNT(DISTINCT) over
+  numbers) are kept in a hash table instead of the tree, and only sorted when
+  written to disk or read back.
 
   The unique entries will be returned in sort order, to ensure that we do the
   deletes in disk order.
@@ -49,6 +51,7 @@
 #include "my_compiler.h"
 #include "my_dbug.h"
 #include "my_io.h"
+#include "my_xxhash.h"
 #include "my_tree.h"  // element_count
 #include "mysql/components/services/bits/psi_bits.h"
 #include "mysql/psi/mysql_file.h"
@@ -351,12 +354,13 @@ int unique_write_to_ptrs(void *v_key, element_count, void *v_unique) {
 }
 
 Unique::Unique(qsort2_cmp comp_func, void *comp_func_fixed_arg, uint size_arg,
-               ulonglong max_in_memory_size_arg)
+               ulonglong max_in_memory_size_arg, bool raw_keys)
     : file_ptrs(PSI_INSTRUMENT_ME),
       max_elements(0),
       max_in_memory_size(max_in_memory_size_arg),
       record_pointers(nullptr),
       size(size_arg),
+      m_hashed(raw_keys),
       elements(0) {
   my_b_clear(&file);
   init_tree(&tree,
@@ -368,6 +372,13 @@ Unique::Unique(qsort2_cmp comp_func, void *comp_func_fixed_arg, uint size_arg,
   */
   max_elements =
       (ulong)(max_in_memory_size / ALIGN_SIZE(sizeof(TREE_ELEMENT) + size));
+  /*
+    A hashed key costs its own bytes plus at most four slots: the table is
+    kept at most half full, and the arrays it outgrew stay in the mem_root.
+  */
+  if (m_hashed)
+    max_elements =
+        (ulong)(max_in_memory_size / (ALIGN_SIZE(size) + 4 * sizeof(uchar *)));
   (void)open_cached_file(&file, mysql_tmpdir, TEMP_PREFIX, DISK_BUFFER_SIZE,
                          MYF(MY_WME));
 }
@@ -625,13 +636,75 @@ Unique::~Unique() {
   delete_tree(&tree);
 }
 
+bool Unique::hash_insert(const uchar *key) {
+  assert(!m_hash_sorted);
+  if ((m_hash_elements + 1) * 2 > m_slot_count) {
+    const size_t new_slot_count = std::max<size_t>(1024, m_slot_count * 2);
+    uchar **new_slots =
+        m_hash_mem_root.ArrayAlloc<uchar *>(new_slot_count, nullptr);
+    if (new_slots == nullptr) return true; /* purecov: inspected */
+    for (size_t i = 0; i < m_slot_count; i++) {
+      if (m_slots[i] == nullptr) continue;
+      size_t j = MY_XXH64(m_slots[i], size, 0) & (new_slot_count - 1);
+      while (new_slots[j] != nullptr) j = (j + 1) & (new_slot_count - 1);
+      new_slots[j] = m_slots[i];
+    }
+    m_slots = new_slots;
+    m_slot_count = new_slot_count;
+  }
+
+  size_t i = MY_XXH64(key, size, 0) & (m_slot_count - 1);
+  for (; m_slots[i] != nullptr; i = (i + 1) & (m_slot_count - 1)) {
+    if (memcmp(m_slots[i], key, size) == 0) return false;
+  }
+  // Zero-length keys still need a non-null copy to mark the slot as used.
+  uchar *copy = m_hash_mem_root.ArrayAlloc<uchar>(std::max(size, 1U));
+  if (copy == nullptr) return true; /* purecov: inspected */
+  memcpy(copy, key, size);
+  m_slots[i] = copy;
+  m_hash_elements++;
+  return false;
+}
+
+uchar **Unique::hash_sorted_keys() {
+  if (!m_hash_sorted) {
+    uchar **end = std::remove(m_slots, m_slots + m_slot_count, nullptr);
+    assert(static_cast<size_t>(end - m_slots) == m_hash_elements);
+    const uint key_size = size;
+    std::sort(m_slots, end, [key_size](const uchar *a, const uchar *b) {
+      return memcmp(a, b, key_size) < 0;
+    });
+    m_hash_sorted = true;
+  }
+  return m_slots;
+}
+
+void Unique::hash_clear() {
+  m_hash_mem_root.ClearForReuse();
+  m_slots = nullptr;
+  m_slot_count = 0;
+  m_hash_elements = 0;
+  m_hash_sorted = false;
+}
+
 /* Write tree to disk; clear tree */
 bool Unique::flush() {
   Merge_chunk file_ptr;
-  elements += tree.elements_in_tree;
-  file_ptr.set_rowcount(tree.elements_in_tree);
+  elements += elements_in_tree();
+  file_ptr.set_rowcount(elements_in_tree());
   file_ptr.set_file_position(my_b_tell(&file));
 
+  if (m_hashed) {
+    uchar **keys = hash_sorted_keys();
+    for (size_t i = 0; i < m_hash_elements; i++) {
+      if (my_b_write(&file, keys[i], size))
+        return true; /* purecov: inspected */
+    }
+    if (file_ptrs.push_back(file_ptr)) return true; /* purecov: inspected */
+    hash_clear();
+    return false;
+  }
+
   if (tree_walk(&tree, unique_write_to_file, this, left_root_right) ||
       file_ptrs.push_back(file_ptr))
     return true; /* purecov: inspected */
@@ -645,7 +718,10 @@ bool Unique::flush() {
 */
 
 void Unique::reset() {
-  reset_tree(&tree);
+  if (m_hashed)
+    hash_clear();
+  else
+    reset_tree(&tree);
   /*
     If elements != 0, some trees were stored in the file (see how
     flush() works). Note, that we can not count on my_b_tell(&file) == 0
@@ -855,6 +931,13 @@ bool Unique::walk(tree_walk_action action, void *walk_action_arg) {
   int res;
   uchar *merge_buffer;
 
+  if (elements == 0 && m_hashed) {
+    uchar **keys = hash_sorted_keys();
+    for (size_t i = 0; i < m_hash_elements; i++) {
+      if (action(keys[i], 1, walk_action_arg)) return true;
+    }
+    return false;
+  }
   if (elements == 0) /* the whole tree is in memory */
     return tree_walk(&tree, action, walk_action_arg, left_root_right);
 
@@ -890,16 +973,22 @@ bool Unique::walk(tree_walk_action action, void *walk_action_arg) {
 
 bool Unique::get(TABLE *table) {
   THD *thd = current_thd;
-  table->unique_result.found_records = elements + tree.elements_in_tree;
+  table->unique_result.found_records = elements + elements_in_tree();
 
   if (my_b_tell(&file) == 0) {
     /* Whole tree is in memory;  Don't use disk if you don't need to */
     assert(table->unique_result.sorted_result == nullptr);
     table->unique_result.sorted_result.reset(
         (uchar *)my_malloc(key_memory_Filesort_info_record_pointers,
-                           size * tree.elements_in_tree, MYF(0)));
+                           size * elements_in_tree(), MYF(0)));
     if ((record_pointers = table->unique_result.sorted_result.get())) {
-      (void)tree_walk(&tree, unique_write_to_ptrs, this, left_root_right);
+      if (m_hashed) {
+        uchar **keys = hash_sorted_keys();
+        for (size_t i = 0; i < m_hash_elements; i++)
+          unique_write_to_ptrs(keys[i], 1, this);
+      } else {
+        (void)tree_walk(&tree, unique_write_to_ptrs, this, left_root_right);
+      }
       return false;
     }
   }
@@ -968,6 +1057,32 @@ err:
 }
 
 bool Unique_on_insert::unique_add(void *ptr) {
+  if (!m_in_table) {
+    const std::string_view value(static_cast<const char *>(ptr), m_size);
+    if (m_values.count(value) != 0) return true;
+    if (m_values.size() < m_max_in_memory) {
+      char *copy = m_mem_root.ArrayAlloc<char>(m_size);
+      if (copy == nullptr) return true; /* purecov: inspected */
+      memcpy(copy, ptr, m_size);
+      m_values.emplace(copy, m_size);
+      return false;
+    }
+    if (move_to_table()) return true; /* purecov: inspected */
+  }
+  return table_add(ptr);
+}
+
+bool Unique_on_insert::move_to_table() {
+  for (const std::string_view &value : m_values) {
+    if (table_add(value.data())) return true; /* purecov: inspected */
+  }
+  m_values.clear();
+  m_mem_root.ClearForReuse();
+  m_in_table = true;
+  return false;
+}
+
+bool Unique_on_insert::table_add(const void *ptr) {
   THD *thd = current_thd;
   Field *key = *m_table->visible_field_ptr();
   if (key->store((const char *)ptr, m_size, &my_charset_bin) != TYPE_OK)
@@ -986,6 +1101,9 @@ bool Unique_on_insert::unique_add(void *ptr) {
 }
 
 void Unique_on_insert::reset(bool reinit) {
+  m_values.clear();
+  m_mem_root.ClearForReuse();
+  m_in_table = false;
   /* Finish index access and delete all records.  */
   m_table->file->ha_index_or_rnd_end();
   m_table->file->ha_delete_all_rows();
@@ -997,6 +1115,12 @@ bool Unique_on_insert::init() {
   if (!m_table && !(m_table = create_duplicate_weedout_tmp_table(
                         current_thd, m_size, nullptr)))
     return true; /* purecov: inspected */
+  /*
+    Each value in the in-memory set costs its own bytes plus a hash node
+    and a bucket, estimated at four pointers.
+  */
+  m_max_in_memory = current_thd->variables.tmp_table_size /
+                    (m_size + 4 * sizeof(void *));
   return false;
 }
 
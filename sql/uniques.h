@@ -25,13 +25,17 @@
 
 #include <stddef.h>
 #include <sys/types.h>
+#include <string_view>
 
+#include "map_helpers.h"  // malloc_unordered_set
+#include "my_alloc.h"     // MEM_ROOT
 #include "my_dbug.h"
 #include "my_inttypes.h"
 #include "my_pointer_arithmetic.h"
 #include "my_sys.h"
 #include "my_tree.h"           // TREE
 #include "prealloced_array.h"  // Prealloced_array
+#include "sql/psi_memory_key.h"  // key_memory_Unique_on_insert
 #include "sql/sql_array.h"
 #include "sql/sql_sort.h"  // IWYU pragma: keep
 
@@ -66,12 +70,44 @@ class Unique {
   /// Element size
   uint size;
 
+  /**
+    Whether keys compare as raw bytes. If so, duplicates are filtered in
+    memory by an open addressing hash table over the keys instead of the
+    tree, and the keys are only sorted when they are flushed or read.
+  */
+  bool m_hashed;
+  /// Copies of the keys in the hash table, and the slot arrays
+  MEM_ROOT m_hash_mem_root{key_memory_Unique_sort_buffer, 8192};
+  /// Hash table slots (nullptr if empty); a power of two of them
+  uchar **m_slots{nullptr};
+  size_t m_slot_count{0};
+  /// Number of keys in the hash table
+  size_t m_hash_elements{0};
+  /// Whether m_slots has been compacted to the sorted keys
+  bool m_hash_sorted{false};
+
+  /// Insert a key into the hash table unless it is there already.
+  bool hash_insert(const uchar *key);
+  /// Compact and sort the keys of the hash table, returning the first one.
+  uchar **hash_sorted_keys();
+  void hash_clear();
+
  public:
   ulong elements;
+  /**
+    @param comp_func             Key comparison function
+    @param comp_func_fixed_arg   First argument to comp_func
+    @param size_arg              Key size
+    @param max_in_memory_size_arg Memory to use before flushing to disk
+    @param raw_keys              Whether comp_func orders the keys as memcmp
+                                 does, so that they may be hashed
+  */
   Unique(qsort2_cmp comp_func, void *comp_func_fixed_arg, uint size_arg,
-         ulonglong max_in_memory_size_arg);
+         ulonglong max_in_memory_size_arg, bool raw_keys = false);
   ~Unique();
-  ulong elements_in_tree() { return tree.elements_in_tree; }
+  ulong elements_in_tree() {
+    return m_hashed ? m_hash_elements : tree.elements_in_tree;
+  }
 
   /**
     Add new value to Unique
@@ -83,13 +119,14 @@ class Unique {
     @param ptr  pointer to the binary string to insert
 
     @returns
-      false  error or duplicate
-      true   the value was inserted
+      false  success, whether or not the value was a duplicate
+      true   error
   */
   inline bool unique_add(void *ptr) {
     DBUG_TRACE;
-    DBUG_PRINT("info", ("tree %u - %lu", tree.elements_in_tree, max_elements));
-    if (tree.elements_in_tree > max_elements && flush()) return true;
+    DBUG_PRINT("info", ("tree %lu - %lu", elements_in_tree(), max_elements));
+    if (elements_in_tree() > max_elements && flush()) return true;
+    if (m_hashed) return hash_insert(static_cast<uchar *>(ptr));
     return !tree_insert(&tree, ptr, 0, tree.custom_arg);
   }
 
@@ -114,9 +151,10 @@ class Unique {
 /**
   Unique_on_insert -- similar to above, but rejects duplicates on insert, not
   just on read of the final result.
-  To achieve this values are inserted into mem tmp table which uses index to
-  detect duplicate keys. When memory buffer is full, tmp table is dumped to a
-  disk-based tmp table.
+  Values are first kept in an in-memory hash set. If the set grows beyond
+  tmp_table_size, its contents are moved to a mem tmp table which uses index
+  to detect duplicate keys, and all further values go to the tmp table. When
+  memory buffer is full, tmp table is dumped to a disk-based tmp table.
 */
 
 class Unique_on_insert {
@@ -124,6 +162,32 @@ class Unique_on_insert {
   uint m_size;
   /// Duplicate weedout tmp table
   TABLE *m_table{nullptr};
+  /// Memory for the values in m_values
+  MEM_ROOT m_mem_root{key_memory_Unique_on_insert, 8192};
+  /// Values seen so far, until they are moved to m_table
+  malloc_unordered_set<std::string_view> m_values{key_memory_Unique_on_insert};
+  /// Max number of values to keep in m_values
+  size_t m_max_in_memory{0};
+  /// Whether the values have been moved to m_table
+  bool m_in_table{false};
+
+  /**
+    Add a value to the tmp table.
+
+    @returns
+      false  value successfully inserted
+      true   duplicate or error
+  */
+  bool table_add(const void *ptr);
+
+  /**
+    Move all values from the in-memory set to the tmp table.
+
+    @returns
+      false  success
+      true   an error occurred
+  */
+  bool move_to_table();
 
  public:
   Unique_on_insert(uint size) : m_size(size) {}
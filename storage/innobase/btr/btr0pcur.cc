@@ -143,6 +143,78 @@ void btr_pcur_t::copy_stored_position(btr_pcur_t *dst, const btr_pcur_t *src) {
   dst->m_old_n_fields = src->m_old_n_fields;
 }
 
+bool btr_pcur_t::open_on_stored_page(dict_index_t *index,
+                                     const dtuple_t *tuple,
+                                     page_cur_mode_t mode, ulint latch_mode,
+                                     mtr_t *mtr, ut::Location location) {
+  ut_ad(mtr->is_active());
+  ut_ad(latch_mode == BTR_SEARCH_LEAF || latch_mode == BTR_MODIFY_LEAF);
+
+  if (!m_old_stored || m_read_level != 0 || m_btr_cur.index != index ||
+      (mode != PAGE_CUR_GE && mode != PAGE_CUR_LE) ||
+      index->table->is_intrinsic() || dict_index_is_spatial(index)) {
+    return false;
+  }
+
+  buf_block_t *block = nullptr;
+
+  if (!m_block_when_stored.run_with_hint([&](buf_block_t *hint) {
+        if (hint == nullptr ||
+            !btr_cur_optimistic_latch_leaves(hint, m_modify_clock, &latch_mode,
+                                             &m_btr_cur, location.filename,
+                                             location.line, mtr)) {
+          return false;
+        }
+        block = hint;
+        return true;
+      })) {
+    return false;
+  }
+
+  const page_t *page = buf_block_get_frame(block);
+
+  if (btr_page_get_level(page) == 0 &&
+      btr_page_get_index_id(page) == index->id) {
+    ulint up_match = 0;
+    ulint low_match = 0;
+    page_cur_t *page_cur = btr_cur_get_page_cur(&m_btr_cur);
+
+    page_cur_search_with_match(block, index, tuple, mode, &up_match,
+                               &low_match, page_cur, nullptr);
+
+    const rec_t *rec = page_cur_get_rec(page_cur);
+
+    /* The position is between two user records of the page, and no
+    other page can hold a record between them. */
+    if (page_rec_is_user_rec(rec) &&
+        page_rec_is_user_rec(mode == PAGE_CUR_GE
+                                 ? page_rec_get_prev_const(rec)
+                                 : page_rec_get_next_const(rec))) {
+      buf_block_dbg_add_level(block, SYNC_TREE_NODE);
+
+      m_btr_cur.flag = BTR_CUR_BINARY;
+      m_btr_cur.up_match = up_match;
+      m_btr_cur.low_match = low_match;
+
+      m_latch_mode = latch_mode;
+
+      m_search_mode = mode;
+
+      m_pos_state = BTR_PCUR_IS_POSITIONED;
+
+      m_old_stored = false;
+
+      m_trx_if_known = nullptr;
+
+      return true;
+    }
+  }
+
+  btr_leaf_page_release(block, latch_mode, mtr);
+
+  return false;
+}
+
 bool btr_pcur_t::restore_position(ulint latch_mode, mtr_t *mtr,
                                   ut::Location location) {
   dtuple_t *tuple;
@@ -65,6 +65,9 @@ std::atomic_bool btr_search_enabled = true;
 atomic and thus can be used as SYSVAR. */
 bool srv_btr_search_enabled = true;
 
+/** Whether AHI lookups are validated instead of latched, see btr0types.h. */
+bool btr_search_optimistic = false;
+
 /** Protects changes of btr_search_enabled flag. */
 static ib_mutex_t btr_search_enabled_mutex;
 
@@ -401,8 +404,9 @@ btr_search_t *btr_search_info_create(mem_heap_t *heap) {
 /** Updates the search info of an index about hash successes. NOTE that info
 is NOT protected by any semaphore, to save CPU time! Do not assume its fields
 are consistent.
-@param[in]      cursor  cursor which was just positioned */
-static void btr_search_info_update_hash(btr_cur_t *cursor) {
+@param[in]      cursor  cursor which was just positioned
+@param[in]      weight  number of searches this one stands for */
+static void btr_search_info_update_hash(btr_cur_t *cursor, uint32_t weight) {
   dict_index_t *index = cursor->index;
   int cmp;
 
@@ -435,7 +439,7 @@ static void btr_search_info_update_hash(btr_cur_t *cursor) {
     ut_ad(cursor->low_match <= n_unique);
     if (prefix_info.n_fields == n_unique &&
         std::max(cursor->up_match, cursor->low_match) == n_unique) {
-      info->n_hash_potential++;
+      info->n_hash_potential += weight;
 
       return;
     }
@@ -463,7 +467,7 @@ static void btr_search_info_update_hash(btr_cur_t *cursor) {
                          cursor->up_match, cursor->up_bytes);
     if (prefix_info.left_side ? (!low_matches_prefix && up_matches_prefix)
                               : (low_matches_prefix && !up_matches_prefix)) {
-      info->n_hash_potential++;
+      info->n_hash_potential += weight;
 
       return;
     }
@@ -482,7 +486,7 @@ static void btr_search_info_update_hash(btr_cur_t *cursor) {
     /* For extra safety, we set some sensible values here */
     info->prefix_info = {0, 1, true};
   } else if (cmp > 0) {
-    info->n_hash_potential = 1;
+    info->n_hash_potential = weight;
 
     ut_ad(cursor->up_match <= n_unique);
     if (cursor->up_match == n_unique) {
@@ -496,7 +500,7 @@ static void btr_search_info_update_hash(btr_cur_t *cursor) {
                            static_cast<uint16_t>(cursor->low_match), true};
     }
   } else {
-    info->n_hash_potential = 1;
+    info->n_hash_potential = weight;
 
     ut_ad(cursor->low_match <= n_unique);
     if (cursor->low_match == n_unique) {
@@ -516,9 +520,11 @@ block->n_hash_helps, ahi.prefix_info are NOT protected by any
 semaphore, to save CPU time! Do not assume the fields are consistent.
 @return true if building a (new) hash index on the block is recommended
 @param[in,out]  block   buffer block
-@param[in]      cursor  cursor */
+@param[in]      cursor  cursor
+@param[in]      weight  number of searches this one stands for */
 static bool btr_search_update_block_hash_info(buf_block_t *block,
-                                              const btr_cur_t *cursor) {
+                                              const btr_cur_t *cursor,
+                                              uint32_t weight) {
   ut_ad(!rw_lock_own(btr_get_search_latch(cursor->index), RW_LOCK_S));
   ut_ad(!rw_lock_own(btr_get_search_latch(cursor->index), RW_LOCK_X));
   ut_ad(rw_lock_own_flagged(&block->lock, RW_LOCK_FLAG_S | RW_LOCK_FLAG_X));
@@ -541,9 +547,9 @@ static bool btr_search_update_block_hash_info(buf_block_t *block,
       info->last_hash_succ = true;
     }
 
-    block->n_hash_helps++;
+    block->n_hash_helps += weight;
   } else {
-    block->n_hash_helps = 1;
+    block->n_hash_helps = weight;
     block->ahi.recommended_prefix_info = info->prefix_info.load();
   }
 
@@ -646,7 +652,7 @@ static void btr_search_update_hash_ref(buf_block_t *block,
   }
 }
 
-void btr_search_info_update_slow(btr_cur_t *cursor) {
+void btr_search_info_update_slow(btr_cur_t *cursor, uint32_t weight) {
   ut_ad(!rw_lock_own(btr_get_search_latch(cursor->index), RW_LOCK_S));
   ut_ad(!rw_lock_own(btr_get_search_latch(cursor->index), RW_LOCK_X));
 
@@ -656,7 +662,7 @@ void btr_search_info_update_slow(btr_cur_t *cursor) {
   info or block->ahi with any semaphore, to save CPU time!
   We cannot assume the fields are consistent when we return from
   those functions! */
-  btr_search_info_update_hash(cursor);
+  btr_search_info_update_hash(cursor, weight);
 
 #ifdef UNIV_SEARCH_PERF_STAT
   if (cursor->flag == BTR_CUR_HASH_FAIL) {
@@ -664,7 +670,7 @@ void btr_search_info_update_slow(btr_cur_t *cursor) {
   }
 #endif /* UNIV_SEARCH_PERF_STAT */
 
-  if (btr_search_update_block_hash_info(block, cursor)) {
+  if (btr_search_update_block_hash_info(block, cursor, weight)) {
     /* Note that since we did not protect block->ahi with any semaphore, the
     values can be inconsistent. We have to check inside the function call that
     they make sense. */
@@ -801,10 +807,128 @@ static bool btr_search_check_guess(btr_cur_t *cursor,
   }
 }
 
+/** Looks for a hash value in a part of the AHI without latching it. The
+nodes of the hash chain are only known to belong to the hash table as long as
+the sequence number of the part did not change, so it is validated before
+each node is dereferenced.
+@param[in]      part            AHI part of the index
+@param[in]      hash_value      hash value to look for
+@param[out]     rec             the record found, or nullptr if none
+@param[out]     seq             the sequence number the lookup is valid for
+@return true if the lookup was consistent, false if it raced with a
+modification of the part and must be retried with the latch */
+static bool btr_search_optimistic_get_data(
+    const btr_search_sys_t::search_part_t &part, uint64_t hash_value,
+    const rec_t **rec, uint64_t *seq) {
+  *seq = part.read_begin();
+  if (*seq % 2 != 0) {
+    return false;
+  }
+
+  /* This must be checked after reading the sequence number: the flag is reset
+  while all parts are X-latched, and btr_search_disable() then empties the hash
+  tables without the latches. */
+  if (!btr_search_enabled) {
+    return false;
+  }
+
+  hash_table_t *table = part.hash_table;
+  const ha_node_t *node = ha_chain_get_first(table, hash_value);
+
+  for (;;) {
+    if (!part.read_validate(*seq)) {
+      return false;
+    }
+
+    if (node == nullptr) {
+      *rec = nullptr;
+      return true;
+    }
+
+    if (node->hash_value == hash_value) {
+      *rec = node->data;
+      return part.read_validate(*seq);
+    }
+
+    node = ha_chain_get_next(node);
+  }
+}
+
+/** Buffer-fixes and latches the block of a record found by
+btr_search_optimistic_get_data(). Does what buf_page_get_known_nowait() does,
+but as the AHI part is not latched, the block may have been evicted and reused
+since the lookup, so instead of asserting its state this checks that the AHI
+part is unchanged.
+@param[in]      part            AHI part the record was found in
+@param[in]      seq             sequence number the lookup was valid for
+@param[in,out]  block           block of the record
+@param[in]      latch_mode      BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+@param[in,out]  mtr             mini-transaction
+@return true if the block was latched and the lookup is still valid */
+static bool btr_search_optimistic_get_block(
+    const btr_search_sys_t::search_part_t &part, uint64_t seq,
+    buf_block_t *block, ulint latch_mode, mtr_t *mtr) {
+  buf_page_mutex_enter(block);
+
+  /* While the part is unchanged, the AHI entry we found is there, so the block
+  holds the page of the record. Once it is buffer-fixed, it can't be evicted. */
+  if (buf_block_get_state(block) != BUF_BLOCK_FILE_PAGE ||
+      !part.read_validate(seq)) {
+    buf_page_mutex_exit(block);
+
+    return false;
+  }
+
+  buf_block_buf_fix_inc(block, UT_LOCATION_HERE);
+
+  buf_page_set_accessed(&block->page);
+
+  buf_page_mutex_exit(block);
+
+  bool success;
+  mtr_memo_type_t fix_type;
+
+  switch (latch_mode) {
+    case RW_S_LATCH:
+      success = rw_lock_s_lock_nowait(&block->lock, UT_LOCATION_HERE);
+      fix_type = MTR_MEMO_PAGE_S_FIX;
+      break;
+    case RW_X_LATCH:
+      success = rw_lock_x_lock_nowait(&block->lock, UT_LOCATION_HERE);
+      fix_type = MTR_MEMO_PAGE_X_FIX;
+      break;
+    default:
+      ut_error;
+  }
+
+  if (!success) {
+    buf_block_buf_fix_dec(block);
+
+    return false;
+  }
+
+  /* The AHI entry could have been dropped, and the page reorganized, before
+  we latched it. Once the page is latched, that can't happen any more. */
+  if (!part.read_validate(seq)) {
+    if (fix_type == MTR_MEMO_PAGE_S_FIX) {
+      rw_lock_s_unlock(&block->lock);
+    } else {
+      rw_lock_x_unlock(&block->lock);
+    }
+    buf_block_buf_fix_dec(block);
+
+    return false;
+  }
+
+  mtr_memo_push(mtr, block, fix_type);
+
+  return true;
+}
+
 bool btr_search_guess_on_hash(const dtuple_t *tuple, ulint mode,
                               ulint latch_mode, btr_cur_t *cursor,
                               ulint has_search_latch, mtr_t *mtr) {
-  const rec_t *rec;
+  const rec_t *rec = nullptr;
 #ifdef notdefined
   btr_cur_t cursor2;
   btr_pcur_t pcur;
@@ -849,7 +973,15 @@ bool btr_search_guess_on_hash(const dtuple_t *tuple, ulint mode,
 
   cursor->ahi.ahi_hash_value = hash_value;
 
-  if (!has_search_latch) {
+  /* Try to do without the AHI latch first; if the lookup races with a
+  modification of the AHI, do it again with the latch. */
+  const auto &part = btr_get_search_part(index);
+  uint64_t seq = 0;
+  const bool optimistic =
+      !has_search_latch && btr_search_optimistic &&
+      btr_search_optimistic_get_data(part, hash_value, &rec, &seq);
+
+  if (!optimistic && !has_search_latch) {
     if (!btr_search_s_lock_nowait(index, UT_LOCATION_HERE)) {
       return false;
     }
@@ -858,20 +990,19 @@ bool btr_search_guess_on_hash(const dtuple_t *tuple, ulint mode,
   auto latch_guard =
       create_scope_guard([index]() { btr_search_s_unlock(index); });
 
-  if (!has_search_latch) {
-    if (!btr_search_enabled) {
-      return false;
-    }
-  } else {
-    /* If we had a latch, then the guard is not needed. */
+  if (optimistic || has_search_latch) {
+    /* If we had a latch, or did not take one, then the guard is not needed. */
     latch_guard.commit();
+  } else if (!btr_search_enabled) {
+    return false;
   }
 
-  ut_ad(rw_lock_get_writer(btr_get_search_latch(index)) != RW_LOCK_X);
-  ut_ad(rw_lock_get_reader_count(btr_get_search_latch(index)) > 0);
+  if (!optimistic) {
+    ut_ad(rw_lock_get_writer(btr_get_search_latch(index)) != RW_LOCK_X);
+    ut_ad(rw_lock_get_reader_count(btr_get_search_latch(index)) > 0);
 
-  rec =
-      (rec_t *)ha_search_and_get_data(btr_get_search_table(index), hash_value);
+    rec = ha_search_and_get_data(btr_get_search_table(index), hash_value);
+  }
 
   /* We did the hash search. If we decide to return before successfully
   verifying the search is correct, we will return with the following state of
@@ -890,7 +1021,13 @@ bool btr_search_guess_on_hash(const dtuple_t *tuple, ulint mode,
 
   buf_block_t *block = buf_block_from_ahi(rec);
 
-  if (!has_search_latch) {
+  if (optimistic) {
+    if (!btr_search_optimistic_get_block(part, seq, block, latch_mode, mtr)) {
+      return false;
+    }
+
+    buf_block_dbg_add_level(block, SYNC_TREE_NODE_FROM_HASH);
+  } else if (!has_search_latch) {
     if (!buf_page_get_known_nowait(latch_mode, block, Cache_hint::MAKE_YOUNG,
                                    __FILE__, __LINE__, mtr)) {
       return false;
@@ -996,7 +1133,7 @@ bool btr_search_guess_on_hash(const dtuple_t *tuple, ulint mode,
   {
     buf_pool_t *buf_pool = buf_pool_from_bpage(&block->page);
 
-    Counter::inc(buf_pool->stat.m_n_page_gets, block->page.id.page_no());
+    buf_pool_count_page_get(buf_pool, block->page.id.page_no());
   }
 
   return true;
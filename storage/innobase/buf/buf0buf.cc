@@ -50,6 +50,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #ifndef UNIV_HOTBACKUP
 #include "btr0sea.h"
 #include "buf0buddy.h"
+#include "buf0ctier.h"
 #include "buf0stats.h"
 #include "dict0stats_bg.h"
 #include "ibuf0ibuf.h"
@@ -502,6 +503,8 @@ void buf_get_total_stat(
     buf_pool_stat_t *buf_stat = &buf_pool->stat;
 
     Counter::add(tot_stat->m_n_page_gets, buf_stat->m_n_page_gets);
+    Counter::add(tot_stat->m_n_page_gets_remote,
+                 buf_stat->m_n_page_gets_remote);
     tot_stat->n_pages_read += buf_stat->n_pages_read;
     tot_stat->n_pages_written += buf_stat->n_pages_written;
     tot_stat->n_pages_created += buf_stat->n_pages_created;
@@ -894,7 +897,23 @@ bool buf_pool_t::allocate_chunk(ulonglong mem_size, buf_chunk_t *chunk) {
     }
   }
 #ifdef HAVE_LIBNUMA
-  if (srv_numa_interleave) {
+  if (numa_node >= 0) {
+    /* Prefer rather than require the node, so that an instance that doesn't
+    fit into the memory of its node spills over to other nodes. */
+    const auto low_level_info = ut::large_page_low_level_info(
+        chunk->mem, ut::fallback_to_normal_page_t{});
+    struct bitmask *numa_nodes = numa_allocate_nodemask();
+    numa_bitmask_setbit(numa_nodes, numa_node);
+    int st = mbind(low_level_info.base_ptr, low_level_info.allocation_size,
+                   MPOL_PREFERRED, numa_nodes->maskp, numa_nodes->size,
+                   MPOL_MF_MOVE);
+    if (st != 0) {
+      ib::warn(ER_IB_MSG_54, low_level_info.base_ptr,
+               low_level_info.allocation_size, "MPOL_PREFERRED",
+               "MPOL_MF_MOVE", strerror(errno));
+    }
+    numa_bitmask_free(numa_nodes);
+  } else if (srv_numa_interleave) {
     const auto low_level_info = ut::large_page_low_level_info(
         chunk->mem, ut::fallback_to_normal_page_t{});
     struct bitmask *numa_nodes = numa_get_mems_allowed();
@@ -1189,6 +1208,29 @@ static void buf_pool_set_sizes(void) {
   os_wmb;
 }
 
+#ifdef HAVE_LIBNUMA
+/** Choose the NUMA node to bind a buffer pool instance to. The instances are
+spread round-robin over the nodes the server is allowed to allocate memory on.
+@param[in]      instance_no     id of the instance
+@return NUMA node */
+static int buf_pool_numa_node(ulint instance_no) {
+  struct bitmask *numa_nodes = numa_get_mems_allowed();
+  std::vector<int> nodes;
+
+  for (int node = 0; node <= numa_max_node(); ++node) {
+    if (numa_bitmask_isbitset(numa_nodes, node)) {
+      nodes.push_back(node);
+    }
+  }
+  numa_bitmask_free(numa_nodes);
+
+  if (nodes.empty()) {
+    return 0;
+  }
+  return nodes[instance_no % nodes.size()];
+}
+#endif /* HAVE_LIBNUMA */
+
 /** Initialize a buffer pool instance.
 @param[in]      buf_pool            buffer pool instance
 @param[in]      buf_pool_size size in bytes
@@ -1202,20 +1244,36 @@ static void buf_pool_create(buf_pool_t *buf_pool, ulint buf_pool_size,
   ulint chunk_size;
   buf_chunk_t *chunk;
 
+  buf_pool->numa_node = -1;
+#ifdef HAVE_LIBNUMA
+  if (srv_numa_bind) {
+    buf_pool->numa_node = buf_pool_numa_node(instance_no);
+  }
+#endif /* HAVE_LIBNUMA */
+
 #ifdef UNIV_LINUX
-  cpu_set_t cpuset;
+  buf_pool->stat.reset();
 
-  CPU_ZERO(&cpuset);
+  if (buf_pool->numa_node >= 0) {
+    /* Initialize the blocks from the node their memory is on. */
+    if (os_numa_run_on_node(buf_pool->numa_node) != 0) {
+      ib::error(ER_IB_ERR_SCHED_SETAFFNINITY_FAILED)
+          << "numa_run_on_node() failed!";
+    }
+  } else {
+    cpu_set_t cpuset;
 
-  const long n_cores = sysconf(_SC_NPROCESSORS_ONLN);
+    CPU_ZERO(&cpuset);
 
-  CPU_SET(instance_no % n_cores, &cpuset);
+    const long n_cores = sysconf(_SC_NPROCESSORS_ONLN);
 
-  buf_pool->stat.reset();
+    CPU_SET(instance_no % n_cores, &cpuset);
 
-  if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) == -1) {
-    ib::error(ER_IB_ERR_SCHED_SETAFFNINITY_FAILED)
-        << "sched_setaffinity() failed!";
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset) ==
+        -1) {
+      ib::error(ER_IB_ERR_SCHED_SETAFFNINITY_FAILED)
+          << "sched_setaffinity() failed!";
+    }
   }
   /* Linux might be able to set different setting for each thread
   worth to try to set high priority for this thread. */
@@ -1325,6 +1383,15 @@ static void buf_pool_create(buf_pool_t *buf_pool, ulint buf_pool_size,
     buf_pool->watch[i].buf_pool_index = buf_pool->instance_no;
   }
 
+  /* Remember about as many evicted pages as fit into the instance. */
+  buf_pool->LRU_ghost_size = std::max<ulint>(buf_pool->curr_size, 1);
+  buf_pool->LRU_ghost = static_cast<uint64_t *>(
+      ut::zalloc_withkey(UT_NEW_THIS_FILE_PSI_KEY,
+                         sizeof(*buf_pool->LRU_ghost) * buf_pool->LRU_ghost_size));
+
+  buf_ctier_create(buf_pool, static_cast<ulint>(srv_buf_pool_ctier_size /
+                                                srv_buf_pool_instances));
+
   /* All fields are initialized by ut::zalloc_withkey(UT_NEW_THIS_FILE_PSI_KEY).
    */
 
@@ -1393,6 +1460,9 @@ static void buf_pool_free_instance(buf_pool_t *buf_pool) {
 
   ut::free(buf_pool->watch);
   buf_pool->watch = nullptr;
+  ut::free(buf_pool->LRU_ghost);
+  buf_pool->LRU_ghost = nullptr;
+  buf_ctier_free(buf_pool);
   mutex_enter(&buf_pool->chunks_mutex);
   chunks = buf_pool->chunks;
   chunk = chunks + buf_pool->n_chunks;
@@ -1437,6 +1507,24 @@ static void buf_pool_free() {
 @param[in]  total_size    Size of the total pool in bytes.
 @param[in]  n_instances   Number of buffer pool instances to create.
 @return DB_SUCCESS if success, DB_ERROR if not enough memory or error */
+/** Registers the memory of all buffer pool chunks for native aio, see
+os_aio_register_buffers(). */
+static void buf_pool_register_io_buffers() {
+  os_aio_buffers_t buffers;
+
+  for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
+    const buf_pool_t *buf_pool = buf_pool_from_array(i);
+
+    for (ulint j = 0; j < buf_pool->n_chunks; ++j) {
+      const buf_chunk_t *chunk = &buf_pool->chunks[j];
+
+      buffers.emplace_back(chunk->mem, chunk->mem_size());
+    }
+  }
+
+  os_aio_register_buffers(buffers);
+}
+
 dberr_t buf_pool_init(ulint total_size, ulint n_instances) {
   ulint i;
   const ulint size = total_size / n_instances;
@@ -1525,6 +1613,8 @@ dberr_t buf_pool_init(ulint total_size, ulint n_instances) {
   buf_pool_set_sizes();
   buf_LRU_old_ratio_update(100 * 3 / 8, false);
 
+  buf_pool_register_io_buffers();
+
   btr_search_sys_create(buf_pool_get_curr_size() / sizeof(void *) / 64);
 
   buf_stat_per_index = ut::new_withkey<buf_stat_per_index_t>(
@@ -2360,6 +2450,10 @@ withdraw_retry:
 
   buf_resize_status_progress_reset();
   buf_resize_status(BUF_POOL_RESIZE_IN_PROGRESS, "Starting pool resize");
+
+  /* The chunks to delete must not be registered when they are freed. */
+  os_aio_unregister_buffers();
+
   /* add/delete chunks */
   for (ulint i = 0; i < srv_buf_pool_instances; ++i) {
     buf_pool_t *buf_pool = buf_pool_from_array(i);
@@ -2520,6 +2614,8 @@ withdraw_retry:
     innodb_set_buf_pool_size(buf_pool_size_align(curr_size));
   }
 
+  buf_pool_register_io_buffers();
+
   const bool new_size_too_diff =
       srv_buf_pool_base_size > srv_buf_pool_size * 2 ||
       srv_buf_pool_base_size * 2 < srv_buf_pool_size;
@@ -3229,7 +3325,7 @@ buf_page_t *buf_page_get_zip(const page_id_t &page_id,
   bool discard_attempted = false;
   buf_pool_t *buf_pool = buf_pool_get(page_id);
 
-  Counter::inc(buf_pool->stat.m_n_page_gets, page_id.page_no());
+  buf_pool_count_page_get(buf_pool, page_id.page_no());
 
   for (;;) {
   lookup:
@@ -4214,7 +4310,7 @@ template <typename T>
 buf_block_t *Buf_fetch<T>::single_page() {
   buf_block_t *block;
 
-  Counter::inc(m_buf_pool->stat.m_n_page_gets, m_page_id.page_no());
+  buf_pool_count_page_get(m_buf_pool, m_page_id.page_no());
 
   for (;;) {
     if (static_cast<T *>(this)->get(block) == DB_NOT_FOUND) {
@@ -4523,7 +4619,7 @@ bool buf_page_optimistic_get(ulint rw_latch, buf_block_t *block,
 
   {
     auto buf_pool = buf_pool_from_block(block);
-    Counter::inc(buf_pool->stat.m_n_page_gets, block->page.id.page_no());
+    buf_pool_count_page_get(buf_pool, block->page.id.page_no());
   }
 
   return (true);
@@ -4617,7 +4713,7 @@ bool buf_page_get_known_nowait(ulint rw_latch, buf_block_t *block,
   ut_a((hint == Cache_hint::KEEP_OLD) || ibuf_count_get(block->page.id) == 0);
 #endif /* UNIV_IBUF_COUNT_DEBUG */
 
-  Counter::inc(buf_pool->stat.m_n_page_gets, block->page.id.page_no());
+  buf_pool_count_page_get(buf_pool, block->page.id.page_no());
 
   return (true);
 }
@@ -4687,7 +4783,7 @@ const buf_block_t *buf_page_try_get(const page_id_t &page_id,
 
   buf_block_dbg_add_level(block, SYNC_NO_ORDER_CHECK);
 
-  Counter::inc(buf_pool->stat.m_n_page_gets, block->page.id.page_no());
+  buf_pool_count_page_get(buf_pool, block->page.id.page_no());
 
 #ifdef UNIV_IBUF_COUNT_DEBUG
   ut_a(ibuf_count_get(block->page.id) == 0);
@@ -4708,6 +4804,7 @@ static void buf_page_init_low(buf_page_t *bpage) noexcept {
   bpage->buf_fix_count.store(0);
   bpage->freed_page_clock = 0;
   bpage->access_time = {};
+  bpage->made_young = false;
   bpage->set_newest_lsn(0);
   bpage->set_clean();
 
@@ -4909,6 +5006,7 @@ buf_page_t *buf_page_init_for_read(dberr_t *err, ulint mode,
 
     /* The block must be put to the LRU list, to the old blocks */
     buf_LRU_add_block(bpage, true /* to old blocks */);
+    buf_LRU_note_read(buf_pool, page_id);
 
     if (page_size.is_compressed()) {
       block->page.zip.data = (page_zip_t *)data;
@@ -4992,6 +5090,7 @@ buf_page_t *buf_page_init_for_read(dberr_t *err, ulint mode,
     /* The block must be put to the LRU list, to the old blocks.
     The zip size is already set into the page zip */
     buf_LRU_add_block(bpage, true /* to old blocks */);
+    buf_LRU_note_read(buf_pool, page_id);
 #if defined UNIV_DEBUG || defined UNIV_BUF_DEBUG
     buf_LRU_insert_zip_clean(bpage);
 #endif /* UNIV_DEBUG || UNIV_BUF_DEBUG */
@@ -5087,6 +5186,9 @@ buf_block_t *buf_page_create(const page_id_t &page_id,
 
   buf_page_init(buf_pool, page_id, page_size, block);
 
+  /* A copy of an earlier incarnation of the page must not be read back. */
+  buf_ctier_take(&block->page, nullptr);
+
   buf_block_buf_fix_inc(block, UT_LOCATION_HERE);
 
   buf_page_set_accessed(&block->page);
@@ -5110,8 +5212,11 @@ buf_block_t *buf_page_create(const page_id_t &page_id,
 
   rw_lock_x_unlock(hash_lock);
 
-  /* The block must be put to the LRU list */
-  buf_LRU_add_block(&block->page, false);
+  /* The block must be put to the LRU list. Pages of temporary tablespaces
+are added to the old blocks like pages read from disk, so that a large
+temporary table or sort has to earn its place in the young sublist through
+innodb_old_blocks_time instead of pushing out hot user data. */
+  buf_LRU_add_block(&block->page, fsp_is_system_temporary(page_id.space()));
 
   buf_pool->stat.n_pages_created.fetch_add(1);
 
@@ -6529,6 +6634,11 @@ void buf_stats_get_pool_info(
 
   pool_info->n_page_gets = Counter::total(buf_pool->stat.m_n_page_gets);
 
+  pool_info->n_page_gets_remote =
+      Counter::total(buf_pool->stat.m_n_page_gets_remote);
+
+  pool_info->numa_node = buf_pool->numa_node;
+
   pool_info->n_ra_pages_read_rnd = buf_pool->stat.n_ra_pages_read_rnd;
   pool_info->n_ra_pages_read = buf_pool->stat.n_ra_pages_read;
 
@@ -0,0 +1,598 @@
+/*****************************************************************************
+
+Copyright (c) 2022, Oracle and/or its affiliates.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License, version 2.0, as published by the
+Free Software Foundation.
+
+This program is also distributed with certain software (including but not
+limited to OpenSSL) that is licensed under separate terms, as designated in a
+particular file or component or in included license documentation. The authors
+of MySQL hereby grant you an additional permission to link the program and
+your derivative works with the separately licensed software that they have
+included with MySQL.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License, version 2.0,
+for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+
+*****************************************************************************/
+
+/** @file buf/buf0ctier.cc
+ Compressed tier of the buffer pool
+
+ Created 2022
+ *******************************************************/
+
+#include "buf0ctier.h"
+
+#include <lz4.h>
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+
+#include "buf0buf.h"
+#include "fil0fil.h"
+#include "srv0mon.h"
+#include "srv0srv.h"
+#include "ut0byte.h"
+
+/** Size of the smallest block of the arena */
+static constexpr ulint BUF_CTIER_MIN_SHIFT = 9;
+
+/** Maximum number of block sizes: from 512 bytes to half of the largest
+page size */
+static constexpr ulint BUF_CTIER_N_ORDERS =
+    UNIV_PAGE_SIZE_SHIFT_MAX - BUF_CTIER_MIN_SHIFT;
+
+/** Flag in buf_ctier_t::orders of the first unit of a free block */
+static constexpr uint8_t BUF_CTIER_FREE = 0x80;
+
+/** End of a list of blocks */
+static constexpr uint32_t BUF_CTIER_NULL = UINT32_MAX;
+
+/** Start of a free block */
+struct buf_ctier_free_t {
+  /** Previous free block of the same order */
+  uint32_t prev;
+
+  /** Next free block of the same order */
+  uint32_t next;
+};
+
+/** Start of a block that holds a page */
+struct buf_ctier_page_t {
+  /** Previous page, towards the oldest one */
+  uint32_t prev;
+
+  /** Next page, towards the newest one */
+  uint32_t next;
+
+  /** Tablespace id */
+  space_id_t space;
+
+  /** Page number */
+  page_no_t page_no;
+
+  /** Version of the tablespace when the page was stored */
+  uint32_t version;
+
+  /** Length of the compressed page that follows, 0 while the page is being
+  compressed */
+  uint32_t length;
+
+  /** FIL header of the page */
+  byte fil_header[FIL_PAGE_DATA];
+};
+
+/** Compressed tier of a buffer pool instance. All fields except the
+constant ones are protected by mutex. */
+struct buf_ctier_t {
+  /** Protects the allocator and the stored pages */
+  ib_mutex_t mutex;
+
+  /** The arena, constant */
+  byte *arena;
+
+  /** Number of 512-byte units in the arena, constant */
+  uint32_t n_units;
+
+  /** Order of the largest block, of half a page, constant */
+  ulint max_order;
+
+  /** Order of the block that starts at each unit, with BUF_CTIER_FREE if
+  the block is free. Meaningless for units that do not start a block. */
+  uint8_t *orders;
+
+  /** First free block of each order */
+  uint32_t free[BUF_CTIER_N_ORDERS];
+
+  /** Oldest stored page */
+  uint32_t oldest;
+
+  /** Newest stored page */
+  uint32_t newest;
+
+  /** Stored pages and pages that are being compressed, by page id */
+  std::unordered_map<uint64_t, uint32_t> pages;
+};
+
+/** Key of a page in buf_ctier_t::pages */
+static inline uint64_t buf_ctier_key(const page_id_t &page_id) {
+  return ut_ull_create(page_id.space(), page_id.page_no());
+}
+
+/** Get the start of a block.
+@param[in]      tier    compressed tier
+@param[in]      unit    first unit of the block
+@return start of the block */
+template <typename T>
+static inline T *buf_ctier_block(const buf_ctier_t *tier, uint32_t unit) {
+  ut_ad(unit < tier->n_units);
+  return reinterpret_cast<T *>(tier->arena +
+                               (ulint{unit} << BUF_CTIER_MIN_SHIFT));
+}
+
+/** Add a block to a free list.
+@param[in,out]  tier    compressed tier
+@param[in]      unit    first unit of the block
+@param[in]      order   order of the block */
+static void buf_ctier_free_add(buf_ctier_t *tier, uint32_t unit, ulint order) {
+  auto block = buf_ctier_block<buf_ctier_free_t>(tier, unit);
+
+  block->prev = BUF_CTIER_NULL;
+  block->next = tier->free[order];
+
+  if (block->next != BUF_CTIER_NULL) {
+    buf_ctier_block<buf_ctier_free_t>(tier, block->next)->prev = unit;
+  }
+
+  tier->free[order] = unit;
+  tier->orders[unit] = static_cast<uint8_t>(BUF_CTIER_FREE | order);
+}
+
+/** Remove a block from a free list.
+@param[in,out]  tier    compressed tier
+@param[in]      unit    first unit of the block
+@param[in]      order   order of the block */
+static void buf_ctier_free_remove(buf_ctier_t *tier, uint32_t unit,
+                                  ulint order) {
+  auto block = buf_ctier_block<buf_ctier_free_t>(tier, unit);
+
+  ut_ad(tier->orders[unit] == (BUF_CTIER_FREE | order));
+
+  if (block->prev != BUF_CTIER_NULL) {
+    buf_ctier_block<buf_ctier_free_t>(tier, block->prev)->next = block->next;
+  } else {
+    tier->free[order] = block->next;
+  }
+
+  if (block->next != BUF_CTIER_NULL) {
+    buf_ctier_block<buf_ctier_free_t>(tier, block->next)->prev = block->prev;
+  }
+
+  tier->orders[unit] = static_cast<uint8_t>(order);
+}
+
+/** Split a block, freeing its upper halves until it is of the given order.
+@param[in,out]  tier    compressed tier
+@param[in]      unit    first unit of the block
+@param[in]      order   current order of the block
+@param[in]      target  order to split the block to */
+static void buf_ctier_split(buf_ctier_t *tier, uint32_t unit, ulint order,
+                            ulint target) {
+  while (order > target) {
+    --order;
+    buf_ctier_free_add(tier, unit + (1U << order), order);
+  }
+
+  tier->orders[unit] = static_cast<uint8_t>(target);
+}
+
+/** Allocate a block.
+@param[in,out]  tier    compressed tier
+@param[in]      order   order of the block
+@return first unit of the block, or BUF_CTIER_NULL if there is no free
+block that is large enough */
+static uint32_t buf_ctier_alloc(buf_ctier_t *tier, ulint order) {
+  ut_ad(mutex_own(&tier->mutex));
+
+  ulint k = order;
+
+  while (k <= tier->max_order && tier->free[k] == BUF_CTIER_NULL) {
+    ++k;
+  }
+
+  if (k > tier->max_order) {
+    return BUF_CTIER_NULL;
+  }
+
+  const uint32_t unit = tier->free[k];
+
+  buf_ctier_free_remove(tier, unit, k);
+  buf_ctier_split(tier, unit, k, order);
+
+  return unit;
+}
+
+/** Free a block, combining it with its free buddies.
+@param[in,out]  tier    compressed tier
+@param[in]      unit    first unit of the block */
+static void buf_ctier_dealloc(buf_ctier_t *tier, uint32_t unit) {
+  ut_ad(mutex_own(&tier->mutex));
+  ut_ad(!(tier->orders[unit] & BUF_CTIER_FREE));
+
+  ulint order = tier->orders[unit];
+
+  while (order < tier->max_order) {
+    const uint32_t buddy = unit ^ (1U << order);
+
+    if (tier->orders[buddy] != (BUF_CTIER_FREE | order)) {
+      break;
+    }
+
+    buf_ctier_free_remove(tier, buddy, order);
+
+    unit = std::min(unit, buddy);
+    ++order;
+  }
+
+  buf_ctier_free_add(tier, unit, order);
+}
+
+/** Remove a stored page from the list of stored pages.
+@param[in,out]  tier    compressed tier
+@param[in]      unit    first unit of the block of the page */
+static void buf_ctier_unlink(buf_ctier_t *tier, uint32_t unit) {
+  auto page = buf_ctier_block<buf_ctier_page_t>(tier, unit);
+
+  ut_ad(page->length > 0);
+
+  if (page->prev != BUF_CTIER_NULL) {
+    buf_ctier_block<buf_ctier_page_t>(tier, page->prev)->next = page->next;
+  } else {
+    tier->oldest = page->next;
+  }
+
+  if (page->next != BUF_CTIER_NULL) {
+    buf_ctier_block<buf_ctier_page_t>(tier, page->next)->prev = page->prev;
+  } else {
+    tier->newest = page->prev;
+  }
+
+  MONITOR_DEC(MONITOR_CTIER_PAGES);
+}
+
+/** Remove a page from the index and free its block. A page that is still
+being compressed is only removed from the index; buf_ctier_insert() notices
+that and frees the block.
+@param[in,out]  tier    compressed tier
+@param[in]      it      the page in tier->pages
+@return the next page in tier->pages */
+static std::unordered_map<uint64_t, uint32_t>::iterator buf_ctier_remove(
+    buf_ctier_t *tier, std::unordered_map<uint64_t, uint32_t>::iterator it) {
+  const uint32_t unit = it->second;
+
+  if (buf_ctier_block<buf_ctier_page_t>(tier, unit)->length > 0) {
+    buf_ctier_unlink(tier, unit);
+    buf_ctier_dealloc(tier, unit);
+  }
+
+  return tier->pages.erase(it);
+}
+
+/** Make room by freeing the oldest stored page.
+@param[in,out]  tier    compressed tier
+@return false if there were no stored pages */
+static bool buf_ctier_evict(buf_ctier_t *tier) {
+  ut_ad(mutex_own(&tier->mutex));
+
+  if (tier->oldest == BUF_CTIER_NULL) {
+    return false;
+  }
+
+  auto page = buf_ctier_block<buf_ctier_page_t>(tier, tier->oldest);
+  auto it = tier->pages.find(ut_ull_create(page->space, page->page_no));
+
+  ut_a(it != tier->pages.end() && it->second == tier->oldest);
+
+  buf_ctier_remove(tier, it);
+
+  MONITOR_INC(MONITOR_CTIER_EVICTED);
+
+  return true;
+}
+
+void buf_ctier_create(buf_pool_t *buf_pool, ulint size) {
+  buf_pool->ctier = nullptr;
+
+  ulint max_order = 0;
+
+  while ((ulint{1} << (BUF_CTIER_MIN_SHIFT + max_order + 1)) <
+         UNIV_PAGE_SIZE) {
+    ++max_order;
+  }
+
+  const ulint max_size = ulint{1} << (BUF_CTIER_MIN_SHIFT + max_order);
+  const ulint n_blocks =
+      std::min<ulint>(size / max_size, (UINT32_MAX >> max_order) - 1);
+
+  if (n_blocks == 0) {
+    return;
+  }
+
+  auto tier = ut::new_withkey<buf_ctier_t>(UT_NEW_THIS_FILE_PSI_KEY);
+
+  tier->arena = static_cast<byte *>(
+      ut::malloc_withkey(UT_NEW_THIS_FILE_PSI_KEY, n_blocks * max_size));
+
+  tier->n_units = static_cast<uint32_t>(n_blocks << max_order);
+
+  tier->orders = static_cast<uint8_t *>(
+      ut::zalloc_withkey(UT_NEW_THIS_FILE_PSI_KEY, tier->n_units));
+
+  if (tier->arena == nullptr || tier->orders == nullptr) {
+    ib::warn(ER_IB_MSG_761)
+        << "Cannot allocate " << n_blocks * max_size
+        << " bytes for the compressed tier of buffer pool instance "
+        << buf_pool->instance_no << ", it is disabled";
+
+    ut::free(tier->arena);
+    ut::free(tier->orders);
+    ut::delete_(tier);
+    return;
+  }
+
+  tier->max_order = max_order;
+  tier->oldest = BUF_CTIER_NULL;
+  tier->newest = BUF_CTIER_NULL;
+
+  std::fill_n(tier->free, BUF_CTIER_N_ORDERS, BUF_CTIER_NULL);
+
+  for (ulint i = n_blocks; i--;) {
+    buf_ctier_free_add(tier, static_cast<uint32_t>(i << max_order), max_order);
+  }
+
+  mutex_create(LATCH_ID_BUF_POOL_CTIER, &tier->mutex);
+
+  buf_pool->ctier = tier;
+}
+
+void buf_ctier_free(buf_pool_t *buf_pool) {
+  auto tier = buf_pool->ctier;
+
+  if (tier == nullptr) {
+    return;
+  }
+
+  mutex_free(&tier->mutex);
+  ut::free(tier->orders);
+  ut::free(tier->arena);
+  ut::delete_(tier);
+
+  buf_pool->ctier = nullptr;
+}
+
+bool buf_ctier_save(const buf_page_t *bpage, buf_ctier_save_t *save) {
+  if (buf_pool_from_bpage(bpage)->ctier == nullptr ||
+      buf_page_get_state(bpage) != BUF_BLOCK_FILE_PAGE ||
+      bpage->zip.data != nullptr) {
+    return false;
+  }
+
+  ut_ad(mutex_own(buf_page_get_mutex(bpage)));
+  ut_ad(!bpage->is_dirty());
+
+  /* Read the version before checking that the page is not stale, so that
+  a concurrent truncation makes the saved version outdated. */
+  save->version = bpage->get_space()->get_recent_version();
+
+  if (bpage->was_stale()) {
+    return false;
+  }
+
+  save->page_id = bpage->id;
+
+  memcpy(save->fil_header, reinterpret_cast<const buf_block_t *>(bpage)->frame,
+         FIL_PAGE_DATA);
+
+  return true;
+}
+
+void buf_ctier_insert(const buf_ctier_save_t *save, const byte *frame) {
+  auto buf_pool = buf_pool_get(save->page_id);
+  auto tier = buf_pool->ctier;
+  const auto key = buf_ctier_key(save->page_id);
+
+  ut_ad(tier != nullptr);
+
+  /* Reserve a block of half a page while the page is compressed into it.
+  The reservation is in the index, so that reading or creating the page
+  meanwhile cancels it. */
+  mutex_enter(&tier->mutex);
+
+  auto it = tier->pages.find(key);
+
+  if (it != tier->pages.end()) {
+    buf_ctier_remove(tier, it);
+  }
+
+  uint32_t unit;
+
+  while ((unit = buf_ctier_alloc(tier, tier->max_order)) == BUF_CTIER_NULL) {
+    if (!buf_ctier_evict(tier)) {
+      /* All of the arena is being compressed into. */
+      mutex_exit(&tier->mutex);
+      return;
+    }
+  }
+
+  auto page = buf_ctier_block<buf_ctier_page_t>(tier, unit);
+
+  page->prev = BUF_CTIER_NULL;
+  page->next = BUF_CTIER_NULL;
+  page->space = save->page_id.space();
+  page->page_no = save->page_id.page_no();
+  page->version = save->version;
+  page->length = 0;
+  memcpy(page->fil_header, save->fil_header, FIL_PAGE_DATA);
+
+  tier->pages.emplace(key, unit);
+
+  mutex_exit(&tier->mutex);
+
+  const ulint max_size = ulint{1} << (BUF_CTIER_MIN_SHIFT + tier->max_order);
+
+  const int length = LZ4_compress_default(
+      reinterpret_cast<const char *>(frame),
+      reinterpret_cast<char *>(page + 1), static_cast<int>(UNIV_PAGE_SIZE),
+      static_cast<int>(max_size - sizeof(*page)));
+
+  ulint order = tier->max_order;
+
+  while (length > 0 && order > 0 &&
+         (ulint{1} << (BUF_CTIER_MIN_SHIFT + order - 1)) >=
+             sizeof(*page) + static_cast<ulint>(length)) {
+    --order;
+  }
+
+  /* Do not store the page if it is in the buffer pool again. Holding the
+  page hash latch, a read or a creation that inserts the page into the page
+  hash later will find the page in the tier and remove it. */
+  auto hash_lock = buf_page_hash_lock_get(buf_pool, save->page_id);
+
+  rw_lock_s_lock(hash_lock, UT_LOCATION_HERE);
+
+  const bool in_pool =
+      buf_page_hash_get_low(buf_pool, save->page_id) != nullptr;
+
+  mutex_enter(&tier->mutex);
+
+  it = tier->pages.find(key);
+
+  const bool cancelled = it == tier->pages.end() || it->second != unit;
+
+  if (length <= 0 || in_pool || cancelled) {
+    if (!cancelled) {
+      tier->pages.erase(it);
+    }
+
+    buf_ctier_dealloc(tier, unit);
+
+    if (length <= 0) {
+      MONITOR_INC(MONITOR_CTIER_REJECTED);
+    }
+  } else {
+    buf_ctier_split(tier, unit, tier->max_order, order);
+
+    page->length = static_cast<uint32_t>(length);
+    page->prev = tier->newest;
+
+    if (tier->newest != BUF_CTIER_NULL) {
+      buf_ctier_block<buf_ctier_page_t>(tier, tier->newest)->next = unit;
+    } else {
+      tier->oldest = unit;
+    }
+
+    tier->newest = unit;
+
+    MONITOR_INC(MONITOR_CTIER_INSERTED);
+    MONITOR_INC(MONITOR_CTIER_PAGES);
+  }
+
+  mutex_exit(&tier->mutex);
+
+  rw_lock_s_unlock(hash_lock);
+}
+
+bool buf_ctier_take(const buf_page_t *bpage, byte *frame) {
+  auto tier = buf_pool_from_bpage(bpage)->ctier;
+
+  if (tier == nullptr) {
+    return false;
+  }
+
+  mutex_enter(&tier->mutex);
+
+  auto it = tier->pages.find(buf_ctier_key(bpage->id));
+
+  if (it == tier->pages.end()) {
+    mutex_exit(&tier->mutex);
+    return false;
+  }
+
+  const uint32_t unit = it->second;
+  auto page = buf_ctier_block<buf_ctier_page_t>(tier, unit);
+
+  if (page->length == 0) {
+    /* Cancel the insert that is compressing the page. */
+    tier->pages.erase(it);
+    mutex_exit(&tier->mutex);
+    return false;
+  }
+
+  if (frame == nullptr ||
+      page->version != bpage->get_space()->get_recent_version()) {
+    buf_ctier_remove(tier, it);
+    mutex_exit(&tier->mutex);
+
+    if (frame != nullptr) {
+      MONITOR_INC(MONITOR_CTIER_INVALIDATED);
+    }
+
+    return false;
+  }
+
+  /* Take the block out of the index, and decompress it without holding
+  the mutex. */
+  buf_ctier_unlink(tier, unit);
+  tier->pages.erase(it);
+
+  mutex_exit(&tier->mutex);
+
+  const int length = LZ4_decompress_safe(
+      reinterpret_cast<const char *>(page + 1), reinterpret_cast<char *>(frame),
+      static_cast<int>(page->length), static_cast<int>(UNIV_PAGE_SIZE));
+
+  const bool success = length == static_cast<int>(UNIV_PAGE_SIZE);
+
+  if (success) {
+    memcpy(frame, page->fil_header, FIL_PAGE_DATA);
+  }
+
+  mutex_enter(&tier->mutex);
+  buf_ctier_dealloc(tier, unit);
+  mutex_exit(&tier->mutex);
+
+  if (success) {
+    MONITOR_INC(MONITOR_CTIER_HITS);
+  }
+
+  return success;
+}
+
+void buf_ctier_remove_space(buf_pool_t *buf_pool, space_id_t space_id) {
+  auto tier = buf_pool->ctier;
+
+  if (tier == nullptr) {
+    return;
+  }
+
+  mutex_enter(&tier->mutex);
+
+  for (auto it = tier->pages.begin(); it != tier->pages.end();) {
+    if ((it->first >> 32) == space_id) {
+      it = buf_ctier_remove(tier, it);
+    } else {
+      ++it;
+    }
+  }
+
+  mutex_exit(&tier->mutex);
+}
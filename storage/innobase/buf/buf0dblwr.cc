@@ -1622,7 +1622,10 @@ dberr_t Double_write::write_to_datafile(const buf_page_t *in_bpage, bool sync,
 
   uint32_t type = IORequest::WRITE;
 
-  if (sync) {
+  /* Asynchronous writes are part of a batch, and the caller wakes the i/o
+  handler threads at the end of it; that is also when io_uring submits
+  them. */
+  if (!sync) {
     type |= IORequest::DO_NOT_WAKE;
   }
 
@@ -2509,10 +2512,15 @@ dberr_t dblwr::write(buf_flush_t flush_type, buf_page_t *bpage,
 
   if (srv_read_only_mode || fsp_is_system_temporary(space_id) ||
       !dblwr::is_enabled() || Double_write::s_instances == nullptr ||
-      mtr_t::s_logging.dblwr_disabled()) {
+      mtr_t::s_logging.dblwr_disabled() ||
+      bpage->get_space()->atomic_page_writes) {
     /* Skip the double-write buffer since it is not needed. Temporary
     tablespaces are never recovered, therefore we don't care about
-    torn writes. */
+    torn writes. Pages of tablespaces on storage with atomic writes
+    cannot be torn. */
+    if (bpage->get_space()->atomic_page_writes) {
+      MONITOR_INC(MONITOR_DBLWR_ATOMIC_WRITES);
+    }
     bpage->set_dblwr_batch_id(std::numeric_limits<uint16_t>::max());
     err = Double_write::write_to_datafile(bpage, sync, nullptr);
     if (err == DB_PAGE_IS_STALE || err == DB_TABLESPACE_DELETED) {
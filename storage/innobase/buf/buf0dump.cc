@@ -34,6 +34,10 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include <stdarg.h>
 #include <stdio.h>
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "buf0buf.h"
 #include "buf0dump.h"
@@ -64,7 +68,7 @@ take after being waked up. */
 static bool buf_dump_should_start = false;
 static bool buf_load_should_start = false;
 
-static bool buf_load_abort_flag = false;
+static std::atomic_bool buf_load_abort_flag{false};
 
 /* Used to temporary store dump info in order to avoid IO while holding
 buffer pool LRU list mutex during dump and also to sort the contents of the
@@ -253,6 +257,19 @@ static void buf_dump(bool obey_shutdown) {
   }
   /* else */
 
+  /* The pages of each buffer pool, most recently used first. All of them
+  are collected before any is written, so that the file can interleave the
+  buffer pools. */
+  std::vector<std::pair<buf_dump_t *, size_t>> dumps;
+  dumps.reserve(srv_buf_pool_instances);
+  size_t n_total = 0;
+
+  const auto free_dumps = [&dumps]() {
+    for (auto &d : dumps) {
+      ut::free(d.first);
+    }
+  };
+
   /* walk through each buffer pool */
   for (i = 0; i < srv_buf_pool_instances && !SHOULD_QUIT(); i++) {
     buf_pool_t *buf_pool;
@@ -287,6 +304,7 @@ static void buf_dump(bool obey_shutdown) {
 
     if (dump == nullptr) {
       mutex_exit(&buf_pool->LRU_list_mutex);
+      free_dumps();
       fclose(f);
       buf_dump_status(STATUS_ERR, "Cannot allocate %zu bytes: %s",
                       n_pages * sizeof(*dump), strerror(errno));
@@ -307,29 +325,46 @@ static void buf_dump(bool obey_shutdown) {
 
     mutex_exit(&buf_pool->LRU_list_mutex);
 
-    for (size_t j = 0; j < n_pages && !SHOULD_QUIT(); j++) {
-      ret = fprintf(f, SPACE_ID_PF "," PAGE_NO_PF "\n", BUF_DUMP_SPACE(dump[j]),
-                    BUF_DUMP_PAGE(dump[j]));
-      if (ret < 0) {
-        ut::free(dump);
-        fclose(f);
-        buf_dump_status(STATUS_ERR, "Cannot write to '%s': %s", tmp_filename,
-                        strerror(errno));
-        /* leave tmp_filename to exist */
-        return;
-      }
+    dumps.emplace_back(dump, n_pages);
+    n_total += n_pages;
+  }
 
-      if (j % 128 == 0) {
-        buf_dump_status(
-            STATUS_VERBOSE,
-            "Dumping buffer pool " ULINTPF "/" ULINTPF ", page %zu/%zu", i + 1,
-            static_cast<ulint>(srv_buf_pool_instances), j + 1, n_pages);
+  /* Write the buffer pools interleaved by the relative position of each page
+  in the LRU list of its buffer pool, so that the file goes from the most
+  to the least recently used pages of all of them. The format is the same
+  as before, a load that sorts the whole file does not notice the order,
+  and innodb_buffer_pool_load_order=hot_first reads the first lines first. */
+  static constexpr size_t n_rounds = 1024;
+  size_t n_written = 0;
+
+  for (size_t round = 0; round < n_rounds && !SHOULD_QUIT(); round++) {
+    for (const auto &d : dumps) {
+      const size_t begin = d.second * round / n_rounds;
+      const size_t end = d.second * (round + 1) / n_rounds;
+
+      for (size_t j = begin; j < end && !SHOULD_QUIT(); j++) {
+        ret = fprintf(f, SPACE_ID_PF "," PAGE_NO_PF "\n",
+                      BUF_DUMP_SPACE(d.first[j]), BUF_DUMP_PAGE(d.first[j]));
+        if (ret < 0) {
+          free_dumps();
+          fclose(f);
+          buf_dump_status(STATUS_ERR, "Cannot write to '%s': %s", tmp_filename,
+                          strerror(errno));
+          /* leave tmp_filename to exist */
+          return;
+        }
+
+        if (n_written++ % 128 == 0) {
+          buf_dump_status(STATUS_VERBOSE,
+                          "Dumping buffer pool(s), page %zu/%zu", n_written,
+                          n_total);
+        }
       }
     }
-
-    ut::free(dump);
   }
 
+  free_dumps();
+
   ret = fclose(f);
   if (ret != 0) {
     buf_dump_status(STATUS_ERR, "Cannot close '%s': %s", tmp_filename,
@@ -369,14 +404,16 @@ normal client queries.
 @param[in,out]  last_check_time         milliseconds since epoch of the last
                                         time we did check if throttling is
                                         needed, we do the check every
-                                        srv_io_capacity IO ops.
+                                        io_capacity IO ops.
 @param[in]      last_activity_count     activity count
 @param[in]      n_io                    number of IO ops done since buffer
-                                        pool load has started */
+                                        pool load has started
+@param[in]      io_capacity             IO ops per second allowed to this
+                                        thread of the buffer pool load */
 static inline void buf_load_throttle_if_needed(
     std::chrono::steady_clock::time_point *last_check_time,
-    ulint *last_activity_count, ulint n_io) {
-  if (n_io % srv_io_capacity < srv_io_capacity - 1) {
+    ulint *last_activity_count, ulint n_io, ulint io_capacity) {
+  if (n_io % io_capacity < io_capacity - 1) {
     return;
   }
 
@@ -387,8 +424,8 @@ static inline void buf_load_throttle_if_needed(
     return;
   }
 
-  /* srv_io_capacity IO operations have been performed by buffer pool
-  load since the last time we were here. */
+  /* io_capacity IO operations have been performed by this thread of the
+  buffer pool load since the last time we were here. */
 
   /* If no other activity, then keep going without any delay. */
   if (srv_get_activity_count() == *last_activity_count) {
@@ -400,19 +437,19 @@ static inline void buf_load_throttle_if_needed(
   const auto elapsed_time = std::chrono::steady_clock::now() - *last_check_time;
 
   /* Notice that elapsed_time is not the time for the last
-  srv_io_capacity IO operations performed by BP load. It is the
+  io_capacity IO operations performed by BP load. It is the
   time elapsed since the last time we detected that there has been
   other activity. This has a small and acceptable deficiency, e.g.:
   1. BP load runs and there is no other activity.
   2. Other activity occurs, we run N IO operations after that and
-     enter here (where 0 <= N < srv_io_capacity).
+     enter here (where 0 <= N < io_capacity).
   3. last_check_time is very old and we do not sleep at this time, but
      only update last_check_time and last_activity_count.
-  4. We run srv_io_capacity more IO operations and call this function
+  4. We run io_capacity more IO operations and call this function
      again.
   5. There has been more other activity and thus we enter here.
   6. Now last_check_time is recent and we sleep if necessary to prevent
-     more than srv_io_capacity IO operations per second.
+     more than io_capacity IO operations per second.
   The deficiency is that we could have slept at 3., but for this we
   would have to update last_check_time before the
   "cur_activity_count == *last_activity_count" check and calling
@@ -426,11 +463,125 @@ static inline void buf_load_throttle_if_needed(
   *last_activity_count = srv_get_activity_count();
 }
 
+/** Number of batches in which innodb_buffer_pool_load_order=hot_first
+reads the dump. */
+static constexpr size_t BUF_LOAD_HOT_FIRST_N_BATCHES = 16;
+
+/** Minimum number of pages in a batch of the dump, and in the share of
+a batch that is given to one thread. */
+static constexpr size_t BUF_LOAD_MIN_PAGES = 1024;
+
+/** Maximum number of consecutive pages to queue before waking up the IO
+handler threads. */
+static constexpr size_t BUF_LOAD_MAX_RUN = 64;
+
+/** Progress of a buffer pool load, shared by its threads. */
+struct buf_load_progress_t {
+  /** Number of pages in the dump */
+  size_t n_total{0};
+
+  /** Number of pages of the dump that have been processed */
+  std::atomic<size_t> n_done{0};
+
+  /** IO ops per second allowed to each thread */
+  ulint io_capacity{0};
+};
+
+/** Read the pages of a sorted part of the buffer pool dump in the
+background. A run of consecutive pages is queued as a whole before the IO
+handler threads are woken up, so that they can merge the reads or submit
+them together.
+@param[in]      dump                    page ids, sorted by (space, page)
+@param[in]      n                       number of page ids in dump
+@param[in,out]  progress                progress of the whole load
+@param[in]      report                  whether this thread reports the
+                                        progress of the load
+@param[in]      pfs_stage_progress      stage progress of the load */
+static void buf_load_pages(const buf_dump_t *dump, size_t n,
+                           buf_load_progress_t *progress, bool report,
+                           [[maybe_unused]] PSI_stage_progress
+                               *pfs_stage_progress) {
+  std::chrono::steady_clock::time_point last_check_time;
+  ulint last_activity_cnt = 0;
+  size_t run = 0;
+
+  if (n == 0) {
+    return;
+  }
+
+  /* Avoid calling the expensive fil_space_acquire_silent() for each
+  page within the same tablespace. dump[] is sorted by (space, page),
+  so all pages from a given tablespace are consecutive. */
+  space_id_t cur_space_id = BUF_DUMP_SPACE(dump[0]);
+  fil_space_t *space = fil_space_acquire_silent(cur_space_id);
+  page_size_t page_size(space ? space->flags : 0);
+
+  for (size_t i = 0; i < n && !SHUTTING_DOWN() && !buf_load_abort_flag;
+       i++) {
+    /* space_id for this iteration of the loop */
+    const space_id_t this_space_id = BUF_DUMP_SPACE(dump[i]);
+
+    if (this_space_id != cur_space_id) {
+      if (space != nullptr) {
+        fil_space_release(space);
+      }
+
+      cur_space_id = this_space_id;
+      space = fil_space_acquire_silent(cur_space_id);
+
+      if (space != nullptr) {
+        const page_size_t cur_page_size(space->flags);
+        page_size.copy_from(cur_page_size);
+      }
+    }
+
+    if (space != nullptr) {
+      buf_read_page_background(
+          page_id_t(this_space_id, BUF_DUMP_PAGE(dump[i])), page_size, false);
+
+      if (++run == BUF_LOAD_MAX_RUN || i + 1 == n ||
+          dump[i + 1] != dump[i] + 1) {
+        os_aio_simulated_wake_handler_threads();
+        run = 0;
+      }
+    }
+
+    const size_t n_done =
+        progress->n_done.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    /* Update the progress every 32 MiB, which is every Nth page,
+    where N = 32*1024^2 / page_size. */
+    static const ulint update_status_every_n_mb = 32;
+    static const ulint update_status_every_n_pages =
+        update_status_every_n_mb * 1024 * 1024 / page_size.physical();
+
+    if (report && i % update_status_every_n_pages == 0) {
+      buf_load_status(STATUS_VERBOSE, "Loaded %zu/%zu pages", n_done,
+                      progress->n_total);
+      mysql_stage_set_work_completed(pfs_stage_progress, n_done);
+    }
+
+    buf_load_throttle_if_needed(&last_check_time, &last_activity_cnt, i,
+                                progress->io_capacity);
+  }
+
+  if (run > 0) {
+    /* The loop was left in the middle of a run. */
+    os_aio_simulated_wake_handler_threads();
+  }
+
+  if (space != nullptr) {
+    fil_space_release(space);
+  }
+}
+
 /** Perform a buffer pool load from the file specified by
  innodb_buffer_pool_filename. If any errors occur then the value of
  innodb_buffer_pool_load_status will be set accordingly, see buf_load_status().
  The dump filename can be specified by (relative to srv_data_home):
- SET GLOBAL innodb_buffer_pool_filename='filename'; */
+ SET GLOBAL innodb_buffer_pool_filename='filename';
+ The pages are read by innodb_buffer_pool_load_threads threads, in batches
+ sorted by (space, page), see innodb_buffer_pool_load_order. */
 static void buf_load() {
   char full_filename[OS_FILE_MAX_PATH];
   char now[32];
@@ -563,95 +714,78 @@ static void buf_load() {
     return;
   }
 
-  if (!SHUTTING_DOWN()) {
-    std::sort(dump, dump + dump_n);
-  }
+  const bool hot_first = srv_buf_load_order == SRV_BUF_LOAD_ORDER_HOT_FIRST;
 
-  std::chrono::steady_clock::time_point last_check_time;
-  ulint last_activity_cnt = 0;
+  /* With the page order the whole dump is a single batch. */
+  const size_t batch_n =
+      hot_first ? std::max(dump_n / BUF_LOAD_HOT_FIRST_N_BATCHES,
+                           BUF_LOAD_MIN_PAGES)
+                : dump_n;
 
-  /* Avoid calling the expensive fil_space_acquire_silent() for each
-  page within the same tablespace. dump[] is sorted by (space, page),
-  so all pages from a given tablespace are consecutive. */
-  space_id_t cur_space_id = BUF_DUMP_SPACE(dump[0]);
-  fil_space_t *space = fil_space_acquire_silent(cur_space_id);
-  page_size_t page_size(space ? space->flags : 0);
+  const ulint n_threads = srv_buf_load_threads;
+
+  buf_load_progress_t progress;
+  progress.n_total = dump_n;
+  progress.io_capacity = std::max<ulint>(srv_io_capacity / n_threads, 1);
+
+  PSI_stage_progress *pfs_stage_progress = nullptr;
 
 #ifdef HAVE_PSI_STAGE_INTERFACE
-  PSI_stage_progress *pfs_stage_progress =
-      mysql_set_stage(srv_stage_buffer_pool_load.m_key);
+  pfs_stage_progress = mysql_set_stage(srv_stage_buffer_pool_load.m_key);
 #endif /* HAVE_PSI_STAGE_INTERFACE */
 
   mysql_stage_set_work_estimated(pfs_stage_progress, dump_n);
   mysql_stage_set_work_completed(pfs_stage_progress, 0);
 
-  for (i = 0; i < dump_n && !SHUTTING_DOWN(); i++) {
-    /* space_id for this iteration of the loop */
-    const space_id_t this_space_id = BUF_DUMP_SPACE(dump[i]);
+  for (size_t begin = 0;
+       begin < dump_n && !SHUTTING_DOWN() && !buf_load_abort_flag;
+       begin += batch_n) {
+    const size_t n = std::min(batch_n, dump_n - begin);
 
-    if (this_space_id != cur_space_id) {
-      if (space != nullptr) {
-        fil_space_release(space);
-      }
+    std::sort(dump + begin, dump + begin + n);
 
-      cur_space_id = this_space_id;
-      space = fil_space_acquire_silent(cur_space_id);
+    /* Give each thread a contiguous share of the batch, so that it reads
+    from few tablespaces and finds runs of consecutive pages. */
+    const size_t n_shares = std::min<size_t>(
+        n_threads, std::max<size_t>(n / BUF_LOAD_MIN_PAGES, 1));
 
-      if (space != nullptr) {
-        const page_size_t cur_page_size(space->flags);
-        page_size.copy_from(cur_page_size);
-      }
-    }
+    std::vector<std::thread> threads;
 
-    if (space == nullptr) {
-      continue;
+    for (size_t t = 1; t < n_shares; t++) {
+      const size_t share_begin = begin + n * t / n_shares;
+      const size_t share_end = begin + n * (t + 1) / n_shares;
+
+      threads.emplace_back(buf_load_pages, dump + share_begin,
+                           share_end - share_begin, &progress, false,
+                           pfs_stage_progress);
     }
 
-    buf_read_page_background(page_id_t(this_space_id, BUF_DUMP_PAGE(dump[i])),
-                             page_size, true);
+    /* This thread reads the first share and reports the progress. */
+    buf_load_pages(dump + begin, n / n_shares, &progress, true,
+                   pfs_stage_progress);
 
-    if (i % 64 == 63) {
-      os_aio_simulated_wake_handler_threads();
+    for (auto &thread : threads) {
+      thread.join();
     }
+  }
 
-    /* Update the progress every 32 MiB, which is every Nth page,
-    where N = 32*1024^2 / page_size. */
-    static const ulint update_status_every_n_mb = 32;
-    static const ulint update_status_every_n_pages =
-        update_status_every_n_mb * 1024 * 1024 / page_size.physical();
+  ut::free(dump);
 
-    if (i % update_status_every_n_pages == 0) {
-      buf_load_status(STATUS_VERBOSE, "Loaded " ULINTPF "/" ULINTPF " pages",
-                      i + 1, dump_n);
-      mysql_stage_set_work_completed(pfs_stage_progress, i);
-    }
+  if (buf_load_abort_flag) {
+    const size_t n_done = progress.n_done.load();
 
-    if (buf_load_abort_flag) {
-      if (space != nullptr) {
-        fil_space_release(space);
-      }
-      buf_load_abort_flag = false;
-      ut::free(dump);
-      buf_load_status(STATUS_INFO, "Buffer pool(s) load aborted on request");
-      /* Premature end, set estimated = completed = i and
-      end the current stage event. */
-      mysql_stage_set_work_estimated(pfs_stage_progress, i);
-      mysql_stage_set_work_completed(pfs_stage_progress, i);
+    buf_load_abort_flag = false;
+    buf_load_status(STATUS_INFO, "Buffer pool(s) load aborted on request");
+    /* Premature end, set estimated = completed = n_done and
+    end the current stage event. */
+    mysql_stage_set_work_estimated(pfs_stage_progress, n_done);
+    mysql_stage_set_work_completed(pfs_stage_progress, n_done);
 #ifdef HAVE_PSI_STAGE_INTERFACE
-      mysql_end_stage();
+    mysql_end_stage();
 #endif /* HAVE_PSI_STAGE_INTERFACE */
-      return;
-    }
-
-    buf_load_throttle_if_needed(&last_check_time, &last_activity_cnt, i);
-  }
-
-  if (space != nullptr) {
-    fil_space_release(space);
+    return;
   }
 
-  ut::free(dump);
-
   ut_sprintf_timestamp(now);
 
   buf_load_status(STATUS_INFO, "Buffer pool(s) load completed at %s", now);
@@ -35,6 +35,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include <mysql/service_thd_wait.h>
 #include <sys/types.h>
 #include <time.h>
+#include <vector>
 
 #ifndef UNIV_HOTBACKUP
 #include "buf0buf.h"
@@ -198,6 +199,10 @@ struct page_cleaner_t {
 
 static ut::unique_ptr<page_cleaner_t> page_cleaner;
 
+/** NUMA node the current page cleaner thread runs on, or -1 if it is not bound
+to any; see buf_flush_page_cleaner_bind(). */
+static thread_local int page_cleaner_numa_node = -1;
+
 #ifdef UNIV_DEBUG
 bool innodb_page_cleaner_disabled_debug;
 #endif /* UNIV_DEBUG */
@@ -227,8 +232,9 @@ static void buf_flush_sync_datafiles() {
 As of now we'll have only one coordinator. */
 static void buf_flush_page_coordinator_thread();
 
-/** Worker thread of page_cleaner. */
-static void buf_flush_page_cleaner_thread();
+/** Worker thread of page_cleaner.
+@param[in]      worker_no       number of the worker, starting from 1 */
+static void buf_flush_page_cleaner_thread(size_t worker_no);
 
 /** Increases flush_list size in bytes with the page size in inline function */
 static inline void incr_flush_list_size_in_bytes(
@@ -2748,6 +2754,180 @@ ulint set_flush_target_by_page(ulint n_pages_lsn) {
   return (n_pages);
 }
 
+/** LSN at the previous iteration of the predictive model. */
+lsn_t model_prev_lsn = 0;
+
+/** Redo generation rate estimated by the predictive model, in bytes per
+second. */
+double model_lsn_rate = 0;
+
+/** Integral term of the predictive model, in bytes of redo per second. */
+double model_correction = 0;
+
+/** Whether the predictive model asked for more than innodb_io_capacity_max
+in the previous iteration. */
+bool model_saturated = false;
+
+/** Set page flush target with the predictive model, for
+SRV_ADAPTIVE_FLUSHING_PREDICTIVE.
+
+The oldest modification of every buffer pool instance must move forward at
+the redo generation rate to keep the checkpoint age where it is. To bring the
+age of an instance towards the target, that rate is raised (or lowered) so
+that the difference goes away over innodb_flushing_avg_loops seconds, and an
+integral term removes what the proportional one leaves. The number of pages
+of the instance that this takes follows from the redo each of its dirty pages
+covers on average.
+@return number of pages requested to flush */
+ulint set_flush_target_by_model() {
+  ut_a(log_sys != nullptr);
+
+  lsn_t limit_for_free_check;
+  lsn_t limit_for_dirty_page_age;
+
+  log_files_capacity_get_limits(*log_sys, limit_for_free_check,
+                                limit_for_dirty_page_age);
+
+  const auto target_age = static_cast<double>(
+      limit_for_dirty_page_age / 100 * srv_adaptive_flushing_target_pct);
+
+  auto delta_time_s = 1.0;
+  if (cur_iter_time > prev_iter_time) {
+    delta_time_s = std::chrono::duration_cast<std::chrono::duration<double>>(
+                       cur_iter_time - prev_iter_time)
+                       .count();
+  }
+
+  if (model_prev_lsn == 0 || model_prev_lsn > cur_iter_lsn) {
+    model_prev_lsn = cur_iter_lsn;
+  }
+
+  const double lsn_rate = (cur_iter_lsn - model_prev_lsn) / delta_time_s;
+
+  model_lsn_rate = (model_lsn_rate + lsn_rate) / 2;
+  model_prev_lsn = cur_iter_lsn;
+
+  const auto horizon_s =
+      static_cast<double>(std::max<ulong>(srv_flushing_avg_loops, 1));
+
+  std::vector<double> ages(srv_buf_pool_instances);
+  std::vector<ulint> lengths(srv_buf_pool_instances);
+  double max_age = 0;
+
+  for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+    buf_pool_t *buf_pool = buf_pool_from_array(i);
+
+    buf_flush_list_mutex_enter(buf_pool);
+
+    const buf_page_t *oldest = UT_LIST_GET_LAST(buf_pool->flush_list);
+
+    lengths[i] = UT_LIST_GET_LEN(buf_pool->flush_list);
+
+    if (oldest != nullptr && oldest->get_oldest_lsn() < cur_iter_lsn) {
+      ages[i] = static_cast<double>(cur_iter_lsn - oldest->get_oldest_lsn());
+    } else {
+      ages[i] = 0;
+    }
+
+    buf_flush_list_mutex_exit(buf_pool);
+
+    max_age = std::max(max_age, ages[i]);
+  }
+
+  /* The checkpoint age is that of the oldest instance. Integrate its error,
+  unless we could not flush as much as we wanted and the error is still
+  positive. */
+  const double error = max_age - target_age;
+
+  if (!model_saturated || error < 0) {
+    model_correction += error / horizon_s * (delta_time_s / (4 * horizon_s));
+  }
+
+  const double correction_max =
+      static_cast<double>(limit_for_dirty_page_age) / horizon_s;
+
+  model_correction =
+      std::min(std::max(model_correction, -correction_max), correction_max);
+
+  std::vector<ulint> pages(srv_buf_pool_instances);
+  ulint n_pages = 0;
+
+  for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+    if (lengths[i] == 0 || ages[i] == 0) {
+      pages[i] = 0;
+      continue;
+    }
+
+    /* Redo that the oldest modification of the instance should move
+    forward in the next second. */
+    const double lsn_to_advance = model_lsn_rate +
+                                  (ages[i] - target_age) / horizon_s +
+                                  model_correction;
+
+    /* Redo covered per dirty page. */
+    const double lsn_per_page = ages[i] / lengths[i];
+
+    if (lsn_to_advance <= 0) {
+      pages[i] = 0;
+    } else {
+      pages[i] = std::min<ulint>(
+          static_cast<ulint>(lsn_to_advance / lsn_per_page), lengths[i]);
+    }
+
+    n_pages += pages[i];
+  }
+
+  /* Still honour innodb_max_dirty_pages_pct(_lwm). */
+  const ulint pct_for_dirty = get_pct_for_dirty();
+  const ulint n_pages_for_dirty = PCT_IO(pct_for_dirty);
+
+  if (n_pages < n_pages_for_dirty) {
+    const ulint extra =
+        (n_pages_for_dirty - n_pages) / srv_buf_pool_instances + 1;
+
+    n_pages = 0;
+    for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+      pages[i] += extra;
+      n_pages += pages[i];
+    }
+  }
+
+  model_saturated = n_pages > srv_max_io_capacity;
+
+  mutex_enter(&page_cleaner->mutex);
+  ut_ad(page_cleaner->n_slots_requested == 0);
+  ut_ad(page_cleaner->n_slots_flushing == 0);
+  ut_ad(page_cleaner->n_slots_finished == 0);
+
+  for (ulint i = 0; i < srv_buf_pool_instances; i++) {
+    if (model_saturated) {
+      pages[i] = pages[i] * srv_max_io_capacity / n_pages;
+    }
+
+    ut_ad(page_cleaner->slots[i].state == PAGE_CLEANER_STATE_NONE);
+    page_cleaner->slots[i].n_pages_requested = pages[i] + 1;
+  }
+  mutex_exit(&page_cleaner->mutex);
+
+  if (model_saturated) {
+    n_pages = srv_max_io_capacity;
+  }
+
+  buf_flush_sync_lsn = 0;
+
+  MONITOR_SET(MONITOR_FLUSH_MODEL_LSN_RATE,
+              static_cast<mon_type_t>(model_lsn_rate));
+  MONITOR_SET(MONITOR_FLUSH_MODEL_AGE, static_cast<mon_type_t>(max_age));
+  MONITOR_SET(MONITOR_FLUSH_MODEL_TARGET_AGE,
+              static_cast<mon_type_t>(target_age));
+  MONITOR_SET(MONITOR_FLUSH_MODEL_CORRECTION,
+              static_cast<mon_type_t>(model_correction));
+  MONITOR_SET(MONITOR_FLUSH_MODEL_PAGES, n_pages);
+  MONITOR_SET(MONITOR_FLUSH_PCT_FOR_DIRTY, pct_for_dirty);
+
+  return (n_pages);
+}
+
 /** This function is called approximately once every second by the
 page_cleaner thread, unless it is sync flushing mode, in which case
 it is called every small round. Based on various factors it decides
@@ -2772,10 +2952,21 @@ ulint page_recommendation(ulint last_pages_in, bool is_sync_flush,
   if limit is reached. */
   set_average();
 
-  /* Set page flush target based on LSN. */
-  auto n_pages =
-      skip_lsn ? 0
-               : set_flush_target_by_lsn(is_sync_flush, sync_flush_limit_lsn);
+  /* Set page flush target based on LSN. The model also looks at the age of
+  the oldest modifications when the LSN does not move; sync flushing keeps
+  its own target. */
+  ulint n_pages;
+  if (!is_sync_flush && srv_adaptive_flushing &&
+      srv_adaptive_flushing_method == SRV_ADAPTIVE_FLUSHING_PREDICTIVE) {
+    n_pages = set_flush_target_by_model();
+  } else {
+    /* Start the model afresh when it is used again. */
+    model_prev_lsn = 0;
+
+    n_pages = skip_lsn ? 0
+                       : set_flush_target_by_lsn(is_sync_flush,
+                                                 sync_flush_limit_lsn);
+  }
 
   /* Estimate based on only dirty pages. We don't want to flush at lesser rate
   as LSN based estimate may not represent the right picture for modifications
@@ -2938,15 +3129,28 @@ static ulint pc_flush_slot(void) {
   if (page_cleaner->n_slots_requested > 0) {
     page_cleaner_slot_t *slot = nullptr;
     ulint i;
+    ulint first_requested = page_cleaner->n_slots;
 
+    /* Prefer the instances on the NUMA node of this thread. */
     for (i = 0; i < page_cleaner->n_slots; i++) {
       slot = &page_cleaner->slots[i];
 
       if (slot->state == PAGE_CLEANER_STATE_REQUESTED) {
-        break;
+        if (page_cleaner_numa_node < 0 ||
+            buf_pool_from_array(i)->numa_node == page_cleaner_numa_node) {
+          break;
+        }
+        if (first_requested == page_cleaner->n_slots) {
+          first_requested = i;
+        }
       }
     }
 
+    if (i == page_cleaner->n_slots) {
+      i = first_requested;
+      slot = &page_cleaner->slots[i];
+    }
+
     /* slot should be found because
     page_cleaner->n_slots_requested > 0 */
     ut_a(i < page_cleaner->n_slots);
@@ -3075,6 +3279,27 @@ static bool buf_flush_page_cleaner_set_priority(int priority) {
 }
 #endif /* UNIV_LINUX */
 
+/** Runs a page cleaner thread on the NUMA node of the buffer pool instance
+with the same number as the thread, if the instances are bound to nodes. As
+the instances are spread over the nodes, so are the threads, and
+pc_flush_slot() makes them flush the instances on their own node first.
+@param[in]      worker_no       number of the thread, 0 for the coordinator */
+static void buf_flush_page_cleaner_bind(size_t worker_no) {
+  const buf_pool_t *buf_pool =
+      buf_pool_from_array(worker_no % srv_buf_pool_instances);
+
+  if (buf_pool->numa_node < 0) {
+    return;
+  }
+
+  if (os_numa_run_on_node(buf_pool->numa_node) == 0) {
+    page_cleaner_numa_node = buf_pool->numa_node;
+  } else {
+    ib::warn(ER_IB_ERR_SCHED_SETAFFNINITY_FAILED)
+        << "numa_run_on_node() failed for page_cleaner thread " << worker_no;
+  }
+}
+
 #ifdef UNIV_DEBUG
 /** Loop used to disable page cleaner threads. */
 static void buf_flush_page_cleaner_disabled_loop(void) {
@@ -3184,6 +3409,8 @@ static void buf_flush_page_coordinator_thread() {
 
   THD *thd = create_internal_thd();
 
+  buf_flush_page_cleaner_bind(0);
+
 #ifdef UNIV_LINUX
   /* linux might be able to set different setting for each thread.
   worth to try to set high priority for page cleaner threads */
@@ -3201,7 +3428,7 @@ static void buf_flush_page_coordinator_thread() {
   same set */
   for (size_t i = 1; i < srv_threads.m_page_cleaner_workers_n; ++i) {
     srv_threads.m_page_cleaner_workers[i] = os_thread_create(
-        page_flush_thread_key, i, buf_flush_page_cleaner_thread);
+        page_flush_thread_key, i, buf_flush_page_cleaner_thread, i);
 
     srv_threads.m_page_cleaner_workers[i].start();
   }
@@ -3599,7 +3826,9 @@ thread_exit:
 }
 
 /** Worker thread of page_cleaner. */
-static void buf_flush_page_cleaner_thread() {
+static void buf_flush_page_cleaner_thread(size_t worker_no) {
+  buf_flush_page_cleaner_bind(worker_no);
+
 #ifdef UNIV_LINUX
   /* linux might be able to set different setting for each thread
   worth to try to set high priority for page cleaner threads */
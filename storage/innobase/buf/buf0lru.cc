@@ -36,6 +36,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "btr0sea.h"
 #include "buf0buddy.h"
 #include "buf0buf.h"
+#include "buf0ctier.h"
 #include "buf0dblwr.h"
 #include "buf0flu.h"
 #include "buf0rea.h"
@@ -133,8 +134,42 @@ std::chrono::milliseconds get_buf_LRU_old_threshold() {
   return std::chrono::milliseconds{buf_LRU_old_threshold};
 }
 
+ulong buf_LRU_policy = BUF_LRU_POLICY_MIDPOINT;
+
+/** Largest buf_pool->LRU_old_ratio that BUF_LRU_POLICY_ADAPTIVE moves to; the
+same as the largest innodb_old_blocks_pct. */
+constexpr uint32_t BUF_LRU_ADAPTIVE_RATIO_MAX = BUF_LRU_OLD_RATIO_DIV * 95 / 100;
+
 /** @} */
 
+/** Gets the entry of buf_pool->LRU_ghost for a page. The low bits of the hash
+choose the buffer pool instance, so the high bits choose the entry.
+@param[in]      buf_pool        buffer pool instance
+@param[in]      hash            page_id_t::hash() of the page
+@return the entry */
+static inline uint64_t &buf_LRU_ghost_get(buf_pool_t *buf_pool,
+                                          uint64_t hash) {
+  return buf_pool->LRU_ghost[(hash >> 32) % buf_pool->LRU_ghost_size];
+}
+
+/** Remembers that a page was evicted. An entry of buf_pool->LRU_ghost holds
+a fingerprint of the page id in the high 32 bits, which is never 0 so that 0
+marks an empty entry, then the low 31 bits of buf_pool->freed_page_clock at
+the eviction, and in the lowest bit whether the page had been made young.
+@param[in]      buf_pool        buffer pool instance
+@param[in]      bpage           page that is evicted */
+static void buf_LRU_note_eviction(buf_pool_t *buf_pool,
+                                  const buf_page_t *bpage) {
+  ut_ad(mutex_own(&buf_pool->LRU_list_mutex));
+
+  const uint64_t hash = bpage->id.hash();
+  const uint32_t clock = static_cast<uint32_t>(buf_pool->freed_page_clock);
+
+  buf_LRU_ghost_get(buf_pool, hash) =
+      (uint64_t{static_cast<uint32_t>(hash) | 1} << 32) |
+      ((clock & 0x7FFFFFFF) << 1) | (bpage->made_young ? 1 : 0);
+}
+
 /** Takes a block out of the LRU list and page hash table.
 If the block is compressed-only (BUF_BLOCK_ZIP_PAGE),
 the object will be freed.
@@ -1003,6 +1038,8 @@ void buf_LRU_flush_or_remove_pages(space_id_t id, buf_remove_t buf_remove,
     }
 
     buf_LRU_remove_pages(buf_pool, id, buf_remove, trx, strict);
+
+    buf_ctier_remove_space(buf_pool, id);
   }
 }
 
@@ -1738,6 +1775,8 @@ void buf_LRU_make_block_young(buf_page_t *bpage) {
     buf_pool->stat.n_pages_made_young++;
   }
 
+  bpage->made_young = true;
+
   buf_LRU_remove_block(bpage);
   buf_LRU_add_block_low(bpage, false);
 }
@@ -1837,6 +1876,10 @@ bool buf_LRU_free_page(buf_page_t *bpage, bool zip) {
   ut_ad(rw_lock_own(hash_lock, RW_LOCK_X));
   ut_ad(buf_page_can_relocate(bpage));
 
+  /* A clean page that is freed completely can be kept compressed. */
+  buf_ctier_save_t ctier_save;
+  const bool to_ctier = b == nullptr && buf_ctier_save(bpage, &ctier_save);
+
   if (!buf_LRU_block_remove_hashed(bpage, zip, false)) {
     mutex_exit(&buf_pool->LRU_list_mutex);
 
@@ -1997,6 +2040,12 @@ bool buf_LRU_free_page(buf_page_t *bpage, bool zip) {
     mutex_exit(&buf_pool->zip_mutex);
   }
 
+  if (to_ctier) {
+    UNIV_MEM_VALID(((buf_block_t *)bpage)->frame, UNIV_PAGE_SIZE);
+    buf_ctier_insert(&ctier_save, ((buf_block_t *)bpage)->frame);
+    UNIV_MEM_INVALID(((buf_block_t *)bpage)->frame, UNIV_PAGE_SIZE);
+  }
+
   buf_LRU_block_free_hashed_page((buf_block_t *)bpage);
 
   return (true);
@@ -2109,6 +2158,12 @@ static bool buf_LRU_block_remove_hashed(buf_page_t *bpage, bool zip,
 
   buf_pool->freed_page_clock += 1;
 
+  /* Remember the page if it leaves the buffer pool, unless it is being
+  discarded. */
+  if (!ignore_content && (zip || bpage->zip.data == nullptr)) {
+    buf_LRU_note_eviction(buf_pool, bpage);
+  }
+
   switch (buf_page_get_state(bpage)) {
     case BUF_BLOCK_FILE_PAGE: {
       UNIV_MEM_ASSERT_W(bpage, sizeof(buf_block_t));
@@ -2405,6 +2460,73 @@ uint buf_LRU_old_ratio_update(
   return (new_ratio);
 }
 
+void buf_LRU_note_read(buf_pool_t *buf_pool, const page_id_t &page_id) {
+  ut_ad(mutex_own(&buf_pool->LRU_list_mutex));
+
+  const uint64_t hash = page_id.hash();
+  uint64_t &entry = buf_LRU_ghost_get(buf_pool, hash);
+
+  if (entry >> 32 != (static_cast<uint32_t>(hash) | 1)) {
+    return;
+  }
+
+  const uint32_t evicted_at = static_cast<uint32_t>(entry & 0xFFFFFFFF) >> 1;
+  const bool made_young = entry & 1;
+  entry = 0;
+
+  /* The page is read back "soon" if it would have still been in a buffer
+  pool twice as large, i.e. fewer than the size of the instance pages were
+  evicted since. */
+  const uint32_t clock = static_cast<uint32_t>(buf_pool->freed_page_clock);
+  if (((clock - evicted_at) & 0x7FFFFFFF) >= buf_pool->LRU_ghost_size) {
+    return;
+  }
+
+  if (made_young) {
+    MONITOR_INC(MONITOR_LRU_REREAD_YOUNG);
+  } else {
+    MONITOR_INC(MONITOR_LRU_REREAD_OLD);
+  }
+
+  if (buf_LRU_policy != BUF_LRU_POLICY_ADAPTIVE) {
+    return;
+  }
+
+  /* Like ARC adapts the target size of its recency list: a page that was
+  evicted before it was accessed again asks for more old blocks, so that such
+  pages stay long enough to be made young. A page that was evicted even though
+  it had been made young asks for fewer, so that pages must prove themselves
+  sooner before displacing the young ones. */
+  ulint ratio = buf_pool->LRU_old_ratio;
+
+  if (made_young) {
+    if (ratio <= BUF_LRU_OLD_RATIO_MIN) {
+      return;
+    }
+    --ratio;
+  } else {
+    if (ratio >= BUF_LRU_ADAPTIVE_RATIO_MAX) {
+      return;
+    }
+    ++ratio;
+  }
+
+  buf_pool->LRU_old_ratio = ratio;
+
+  if (UT_LIST_GET_LEN(buf_pool->LRU) >= BUF_LRU_OLD_MIN_LEN) {
+    buf_LRU_old_adjust_len(buf_pool);
+  }
+}
+
+void buf_LRU_policy_update(ulong policy, uint old_pct) {
+  buf_LRU_policy = policy;
+
+  if (policy == BUF_LRU_POLICY_MIDPOINT) {
+    /* Undo the adaptation. */
+    buf_LRU_old_ratio_update(old_pct, true);
+  }
+}
+
 /** Update the historical stats that we are collecting for LRU eviction
  policy at the end of each interval. */
 void buf_LRU_stat_update(void) {
@@ -34,6 +34,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include <stddef.h>
 
 #include "buf0buf.h"
+#include "buf0ctier.h"
 #include "buf0dblwr.h"
 #include "buf0flu.h"
 #include "buf0lru.h"
@@ -106,10 +107,6 @@ ulint buf_read_page_low(dberr_t *err, bool sync, ulint type, ulint mode,
   ut_ad(buf_page_in_file(bpage));
   ut_ad(!mutex_own(&buf_pool_from_bpage(bpage)->LRU_list_mutex));
 
-  if (sync) {
-    thd_wait_begin(nullptr, THD_WAIT_DISKIO);
-  }
-
   void *dst;
 
   if (page_size.is_compressed()) {
@@ -118,6 +115,21 @@ ulint buf_read_page_low(dberr_t *err, bool sync, ulint type, ulint mode,
     ut_a(buf_page_get_state(bpage) == BUF_BLOCK_FILE_PAGE);
 
     dst = ((buf_block_t *)bpage)->frame;
+
+    /* Serve a synchronous read from the compressed tier. An asynchronous
+    read only removes the page from there, its completion must be left to
+    the i/o handler threads. */
+    if (buf_ctier_take(bpage, sync ? static_cast<byte *>(dst) : nullptr)) {
+      if (!buf_page_io_complete(bpage, false)) {
+        return (0);
+      }
+
+      return (1);
+    }
+  }
+
+  if (sync) {
+    thd_wait_begin(nullptr, THD_WAIT_DISKIO);
   }
 
   IORequest request(type | IORequest::READ);
@@ -328,6 +328,51 @@ int Clone_Snapshot::init_page_copy(Snapshot_State new_state, byte *page_buffer,
   return err;
 }
 
+/** Callback to add page IDs from durable page tracking to current snapshot
+@param[in]      thd             session THD
+@param[in]      buff            buffer having page IDs
+@param[in]      buf_len         buffer length
+@param[in]      num_pages       number of tracked pages
+@param[in]      context         snapshot
+@return error code */
+static int add_tracked_page_callback(MYSQL_THD thd [[maybe_unused]],
+                                     const byte *buff,
+                                     size_t buf_len [[maybe_unused]],
+                                     int num_pages, void *context) {
+  return add_page_callback(context, const_cast<byte *>(buff),
+                           static_cast<uint>(num_pages));
+}
+
+int Clone_Snapshot::add_tracked_pages(lsn_t &start_lsn, lsn_t &stop_lsn,
+                                      byte *page_buffer,
+                                      uint page_buffer_len) {
+  ut_ad(m_snapshot_handle_type == CLONE_HDL_COPY);
+
+  if (start_lsn == 0 || start_lsn == LSN_MAX) {
+    return ER_PAGE_TRACKING_RANGE_NOT_TRACKED;
+  }
+
+  const auto num_before = m_num_pages;
+
+  /* Fails if the range is not covered by page tracking. The start LSN is
+  moved back to the nearest reset point, which only adds more pages. */
+  auto err = arch_page_sys->get_pages(nullptr, add_tracked_page_callback, this,
+                                      start_lsn, stop_lsn, page_buffer,
+                                      page_buffer_len);
+
+  if (err != 0) {
+    return err;
+  }
+
+  m_monitor.add_estimate((m_num_pages - num_before) * UNIV_PAGE_SIZE);
+
+  ib::info(ER_IB_CLONE_OPERATION)
+      << "Clone incremental pages since LSN " << start_lsn << " to LSN "
+      << stop_lsn << " : " << (m_num_pages - num_before) << " pages";
+
+  return 0;
+}
+
 int Clone_Snapshot::synchronize_binlog_gtid(Clone_Alert_Func cbk) {
   /* Get a list of binlog prepared transactions and wait for them to commit
   or rollback. This is to ensure that any possible unordered transactions
@@ -642,7 +642,7 @@ dberr_t Builder::init(Cursor &cursor, size_t n_threads) noexcept {
     m_local_stage->begin_phase_read_pk(1);
   }
 
-  auto buffer_size = m_ctx.scan_buffer_size(n_threads);
+  auto buffer_size = m_ctx.scan_buffer_size(n_threads, m_index);
   auto create_thread_ctx = [&](size_t id, dict_index_t *index) -> dberr_t {
     auto key_buffer = ut::new_withkey<Key_sort_buffer>(
         ut::make_psi_memory_key(mem_key_ddl), index, buffer_size.first);
@@ -1634,7 +1634,8 @@ dberr_t Builder::dtuple_copy_blobs(dtuple_t *dtuple, ulint *offsets,
 
 dberr_t Builder::check_duplicates(Thread_ctxs &dupcheck, Dup *dup) noexcept {
   Merge_cursor cursor(this, nullptr, m_local_stage);
-  const auto buffer_size = m_ctx.scan_buffer_size(m_thread_ctxs.size());
+  const auto buffer_size =
+      m_ctx.scan_buffer_size(m_thread_ctxs.size(), m_index);
 
   size_t n_files_to_check{};
 
@@ -145,16 +145,53 @@ const dict_index_t *Context::index() const noexcept {
   return m_old_table->first_index();
 }
 
+/** Estimate the size of an index entry, to share the sort buffer among the
+indexes that are built.
+@param[in] index              Index to estimate for.
+@return the estimated size in bytes, at least 1. */
+static size_t entry_size_estimate(const dict_index_t *index) noexcept {
+  /* Record header, including the null flags and field lengths. */
+  size_t size = REC_N_NEW_EXTRA_BYTES + index->n_fields;
+
+  for (size_t i = 0; i < index->n_fields; ++i) {
+    const auto field = index->get_field(i);
+    const auto col = field->col;
+    const size_t min_size = col->get_min_size();
+    size_t max_size = field->prefix_len > 0 ? field->prefix_len
+                                            : col->get_max_size();
+
+    /* Long columns are stored externally, or only as a prefix. */
+    max_size = std::min(max_size, size_t(srv_page_size / 2));
+
+    /* Variable length columns average half way between the limits. */
+    size += (std::min(min_size, max_size) + max_size) / 2;
+  }
+
+  return size;
+}
+
 Context::Scan_buffer_size Context::scan_buffer_size(
-    size_t n_threads) const noexcept {
+    size_t n_threads, const dict_index_t *index) const noexcept {
   ut_a(n_threads > 0);
   auto n_buffers{n_threads};
+  auto max_buffer_size{m_max_buffer_size};
 
   /* If there is an FTS index being built, take that into account. */
   if (m_fts.m_ptr != nullptr) {
     n_buffers *= FTS_NUM_AUX_INDEX;
-  } else {
+  } else if (index == nullptr || m_indexes.size() == 1) {
     n_buffers *= m_indexes.size();
+  } else {
+    /* An index with larger entries needs a larger buffer to sort as many
+    entries per run as the other indexes. */
+    size_t total_size{};
+
+    for (auto built_index : m_indexes) {
+      total_size += entry_size_estimate(built_index);
+    }
+
+    max_buffer_size = static_cast<size_t>(
+        double(m_max_buffer_size) * entry_size_estimate(index) / total_size);
   }
 
   /* The maximum size of the record is considered to be srv_page_size/2,
@@ -171,7 +208,7 @@ Context::Scan_buffer_size Context::scan_buffer_size(
   const auto io_block_size = IO_BLOCK_SIZE + ((IO_BLOCK_SIZE * 25) / 100);
   const auto io_size = std::max(size_t(min_io_size), io_block_size);
 
-  Scan_buffer_size size{m_max_buffer_size / n_buffers, io_size};
+  Scan_buffer_size size{max_buffer_size / n_buffers, io_size};
 
   if (size.first <= 64 * 1024) {
     if (size.first < srv_page_size) {
@@ -28,6 +28,9 @@ this program; if not, write to the Free Software Foundation, Inc.,
  DDL cluster index parallel scan implementation.
  Created 2020-11-01 by Sunny Bains. */
 
+#include <chrono>
+#include <thread>
+
 #include "ddl0impl-builder.h"
 #include "ddl0impl-cursor.h"
 #include "row0pread.h"
@@ -258,6 +261,39 @@ dberr_t Parallel_cursor::scan(Builders &builders) noexcept {
     return DB_SUCCESS;
   };
 
+  using Clock = std::chrono::steady_clock;
+
+  /* Pages that each thread may read per second, 0 if unlimited. */
+  const auto rate_limit = thd_ddl_scan_rate_limit(m_ctx.thd());
+  const double pages_per_sec = double(rate_limit) / use_n_threads;
+  const auto scan_start = Clock::now();
+  Row_counters n_pages{};
+
+  n_pages.resize(use_n_threads);
+
+  /* Sleep if this thread has read pages faster than the rate limit. The
+  latches are released while sleeping so that the scan doesn't block other
+  transactions. */
+  auto throttle = [&](Thread_ctx *thread_ctx) {
+    const auto thread_id = thread_ctx->m_thread_id;
+    const std::chrono::duration<double> due{++n_pages[thread_id] /
+                                             pages_per_sec};
+    const auto wait = scan_start +
+                      std::chrono::duration_cast<Clock::duration>(due) -
+                      Clock::now();
+
+    if (wait <= Clock::duration::zero()) {
+      return DB_SUCCESS;
+    }
+
+    thread_ctx->savepoint();
+
+    std::this_thread::sleep_for(
+        std::min<Clock::duration>(wait, std::chrono::seconds{1}));
+
+    return thread_ctx->restore_from_savepoint();
+  };
+
   size_t nr{};
 
   /* current_thread is a thread local variable. Set current_thd it
@@ -295,6 +331,10 @@ dberr_t Parallel_cursor::scan(Builders &builders) noexcept {
 
         n_rows[thread_id] = 0;
 
+        if (err == DB_SUCCESS && rate_limit > 0) {
+          err = throttle(thread_ctx);
+        }
+
         /* End of page counter. */
         return err;
 
@@ -162,6 +162,20 @@ static bool dict_stats_recalc_pool_get(
   return (true);
 }
 
+/** Get the number of tables in the auto recalc pool.
+@return number of table ids in the pool */
+static size_t dict_stats_recalc_pool_size() {
+  ut_ad(!srv_read_only_mode);
+
+  mutex_enter(&recalc_pool_mutex);
+
+  const size_t size = recalc_pool->size();
+
+  mutex_exit(&recalc_pool_mutex);
+
+  return size;
+}
+
 /** Delete a given table from the auto recalc pool.
  dict_stats_recalc_pool_del() */
 void dict_stats_recalc_pool_del(
@@ -378,7 +392,23 @@ void dict_stats_thread() {
       break;
     }
 
-    dict_stats_process_entry_from_recalc_pool(thd);
+    /* Process all tables queued at this point instead of one table per
+    wakeup, so that a backlog (e.g. after a mass load) does not drain at
+    one table per MIN_RECALC_INTERVAL. Tables that were recalculated too
+    recently are put back at the end of the pool; bounding the pass by
+    the initial size keeps us from spinning on them. */
+    for (size_t n = dict_stats_recalc_pool_size(); n > 0; --n) {
+      if (SHUTTING_DOWN()) {
+        break;
+      }
+#ifdef UNIV_DEBUG
+      if (innodb_dict_stats_disabled_debug) {
+        break;
+      }
+#endif /* UNIV_DEBUG */
+
+      dict_stats_process_entry_from_recalc_pool(thd);
+    }
 
     os_event_reset(dict_stats_event);
   }
@@ -503,6 +503,14 @@ class Tablespace_dirs {
   /** Clear all the tablespace file data but leave the list of
   scanned directories in place. */
   void clear() {
+    {
+      std::lock_guard<std::mutex> guard(m_deferred_mutex);
+
+      m_deferred_ibd_files.clear();
+      m_deferred_ibd_files.shrink_to_fit();
+      m_has_deferred = false;
+    }
+
     for (auto &dir : m_dirs) {
       dir.clear();
     }
@@ -514,6 +522,10 @@ class Tablespace_dirs {
   @param[in]    space_id        Tablespace ID to erase
   @return true if successful */
   [[nodiscard]] bool erase_path(space_id_t space_id) {
+    if (m_has_deferred.load() && !undo::is_reserved(space_id)) {
+      check_deferred();
+    }
+
     for (auto &dir : m_dirs) {
       if (dir.erase_path(space_id)) {
         return true;
@@ -528,6 +540,12 @@ class Tablespace_dirs {
   @return directory searched and pointer to names that map to the
           tablespace ID */
   [[nodiscard]] Result find_by_id(space_id_t space_id) {
+    /* Undo tablespaces are always known after scan(). Read the headers
+    of the .ibd files only when one of them is looked up. */
+    if (m_has_deferred.load() && !undo::is_reserved(space_id)) {
+      check_deferred();
+    }
+
     for (auto &dir : m_dirs) {
       const auto names = dir.find_by_id(space_id);
 
@@ -628,12 +646,27 @@ class Tablespace_dirs {
                        size_t thread_id, std::mutex *mutex,
                        Space_id_set *unique, Space_id_set *duplicates);
 
+  /** Read the tablespace IDs of the .ibd files whose check was deferred
+  by scan(), and check them for duplicates. Aborts if duplicates are
+  found, as startup would have been refused if the check had not been
+  deferred. */
+  void check_deferred();
+
  private:
   /** Directories scanned and the files discovered under them. */
   Scanned m_dirs;
 
   /** Number of files checked. */
   std::atomic_size_t m_checked;
+
+  /** .ibd files found by scan() whose headers have not been read yet */
+  Scanned_files m_deferred_ibd_files;
+
+  /** true if m_deferred_ibd_files must be checked before a lookup */
+  std::atomic_bool m_has_deferred{false};
+
+  /** Serializes check_deferred() */
+  std::mutex m_deferred_mutex;
 };
 
 /** Determine if space flushing should be disabled, for example when user has
@@ -2966,6 +2999,14 @@ bool Fil_shard::open_file(fil_node_t *file) {
 
   if (success) {
     add_to_lru_if_needed(file);
+
+    /* A page of a multi-file tablespace can be in any of its files, so only
+    single-file tablespaces are checked for atomic page writes. */
+    if (space->purpose == FIL_TYPE_TABLESPACE && space->files.size() == 1) {
+      space->atomic_page_writes = os_file_has_atomic_writes(
+          file->handle.m_file, page_size_t(space->flags).physical());
+    }
+
     /* The file is ready for IO. */
     file->is_open = true;
   } else {
@@ -8850,6 +8891,7 @@ dberr_t fil_set_compression(space_id_t space_id, const char *algorithm) {
     /* This is a Debug tool for setting compression on all
     compressible tables not otherwise specified. */
     switch (srv_debug_compress) {
+      case Compression::ZSTD:
       case Compression::LZ4:
       case Compression::ZLIB:
       case Compression::NONE:
@@ -11372,6 +11414,20 @@ dberr_t Tablespace_dirs::scan() {
                             << undo_files.size() << " undo files";
   }
 
+  /* Without path validation and crash recovery, nothing looks up the
+  .ibd files by tablespace ID during startup. Defer opening every one of
+  them until the first lookup, which then never happens on a clean
+  restart. */
+  if (!srv_validate_tablespace_paths && !ibd_files.empty()) {
+    ib::info(ER_IB_MSG_383)
+        << "Deferred the space ID check of " << ibd_files.size()
+        << " '.ibd' files until a tablespace is looked up by ID";
+
+    m_deferred_ibd_files = std::move(ibd_files);
+    m_has_deferred = true;
+    ibd_files.clear();
+  }
+
   Space_id_set unique;
   Space_id_set duplicates;
 
@@ -11425,6 +11481,52 @@ dberr_t Tablespace_dirs::scan() {
   return err;
 }
 
+void Tablespace_dirs::check_deferred() {
+  std::lock_guard<std::mutex> guard(m_deferred_mutex);
+
+  if (!m_has_deferred.load()) {
+    return;
+  }
+
+  ib::info(ER_IB_MSG_383) << "Checking the space IDs of "
+                          << m_deferred_ibd_files.size() << " '.ibd' files";
+
+  Space_id_set unique;
+  Space_id_set duplicates;
+  std::mutex m;
+
+  size_t n_threads = fil_get_scan_threads(m_deferred_ibd_files.size());
+
+  using std::placeholders::_1;
+  using std::placeholders::_2;
+  using std::placeholders::_3;
+  using std::placeholders::_4;
+  using std::placeholders::_5;
+  using std::placeholders::_6;
+
+  std::function<void(const Const_iter &, const Const_iter &, size_t,
+                     std::mutex *, Space_id_set *, Space_id_set *)>
+      check = std::bind(&Tablespace_dirs::duplicate_check, this, _1, _2, _3, _4,
+                        _5, _6);
+
+  par_for(PFS_NOT_INSTRUMENTED, m_deferred_ibd_files, n_threads, check, &m,
+          &unique, &duplicates);
+
+  m_deferred_ibd_files.clear();
+  m_deferred_ibd_files.shrink_to_fit();
+  m_has_deferred = false;
+
+  if (!duplicates.empty()) {
+    ib::error(ER_IB_MSG_384)
+        << "Multiple files found for the same tablespace ID:";
+
+    print_duplicates(duplicates);
+
+    ib::fatal(UT_LOCATION_HERE, ER_IB_MSG_384)
+        << "Multiple files found for the same tablespace ID";
+  }
+}
+
 void fil_set_scan_dir(const std::string &directory, bool is_undo_dir) {
   fil_system->set_scan_dir(directory, is_undo_dir);
 }
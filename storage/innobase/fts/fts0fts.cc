@@ -52,6 +52,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "row0mysql.h"
 #include "row0sel.h"
 #include "row0upd.h"
+#include "srv0mon.h"
 #include "sync0sync.h"
 #include "trx0roll.h"
 #include "ut0new.h"
@@ -4376,13 +4377,23 @@ static dberr_t fts_sync(fts_sync_t *sync, bool unlock_cache, bool wait,
     sync->trx->dict_operation_lock_mode = RW_S_LATCH;
   }
 
+  /* Size of the cache that this sync writes out, for the monitor */
+  const ulint sync_size = cache->total_size;
+  bool first_pass = true;
+
 begin_sync:
-  if (cache->total_size > fts_max_cache_size) {
-    /* Avoid the case: sync never finish when
-    insert/update keeps coming. */
-    ut_ad(sync->unlock_cache);
+  /* Write the words with the cache lock released for each node first,
+  so that inserts into the full cache do not wait for the whole sync.
+  Avoid the case: sync never finish when insert/update keeps coming, by
+  keeping the lock if the cache is still over its size after that pass,
+  or if it is so far over that it should not grow any further. */
+  if (sync->unlock_cache &&
+      (cache->total_size > 2 * fts_max_cache_size ||
+       (!first_pass && cache->total_size > fts_max_cache_size))) {
     sync->unlock_cache = false;
+    MONITOR_INC(MONITOR_FTS_SYNC_LOCKED);
   }
+  first_pass = false;
 
   DEBUG_SYNC_C("fts_instrument_sync1");
   for (i = 0; i < ib_vector_size(cache->indexes); ++i) {
@@ -4423,6 +4434,10 @@ end_sync:
     fts_sync_rollback(sync);
   }
 
+  MONITOR_INC(MONITOR_FTS_SYNC_COUNT);
+  MONITOR_INC_VALUE(MONITOR_FTS_SYNC_BYTES, sync_size);
+  MONITOR_INC_TIME(MONITOR_FTS_SYNC_MICROSECOND, sync->start_time);
+
   rw_lock_x_lock(&cache->lock, UT_LOCATION_HERE);
   sync->interrupted = false;
   sync->in_progress = false;
@@ -49,6 +49,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "que0types.h"
 #include "row0sel.h"
 #include "sql_thd_internal_api.h"
+#include "srv0mon.h"
 #include "srv0start.h"
 #include "ut0list.h"
 #include "ut0wqueue.h"
@@ -2518,6 +2519,7 @@ void fts_optimize_request_sync_table(dict_table_t *table) {
   msg->ptr = table_id;
 
   ib_wqueue_add(fts_optimize_wq, msg, msg->heap);
+  MONITOR_INC(MONITOR_FTS_SYNC_REQUESTS);
   DBUG_EXECUTE_IF(
       "fts_optimize_wq_count_check",
       if (ib_wqueue_get_count(fts_optimize_wq) > 1000) { DBUG_SUICIDE(); });
@@ -90,6 +90,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "buf0dump.h"
 #include "buf0flu.h"
 #include "buf0lru.h"
+#include "buf0rea.h"
 #include "buf0stats.h"
 #include "clone0api.h"
 #include "clone0clone.h"
@@ -153,6 +154,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "p_s.h"
 #include "page0zip.h"
 #include "pars0pars.h"
+#include "rem0cmp.h"
 #include "rem0types.h"
 #include "row0ext.h"
 #include "row0import.h"
@@ -175,6 +177,8 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "os0thread-create.h"
 #include "os0thread.h"
 #include "sql/item.h"
+#include "sql/item_cmpfunc.h"
+#include "sql/range_optimizer/range_optimizer.h"
 #include "sql_base.h"
 #include "srv0tmp.h"
 #include "trx0rec.h"
@@ -446,7 +450,7 @@ static ulong innodb_default_row_format = DEFAULT_ROW_FORMAT_DYNAMIC;
 #ifdef UNIV_DEBUG
 /** Values for --innodb-debug-compress names. */
 static const char *innodb_debug_compress_names[] = {"none", "zlib", "lz4",
-                                                    "lz4hc", NullS};
+                                                    "zstd", NullS};
 
 /** Enumeration of --innodb-debug-compress */
 static TYPELIB innodb_debug_compress_typelib = {
@@ -581,6 +585,43 @@ static TYPELIB innodb_change_buffering_typelib = {
     array_elements(innodb_change_buffering_names) - 1,
     "innodb_change_buffering_typelib", innodb_change_buffering_names, nullptr};
 
+/** Allowed values of innodb_adaptive_flushing_method
+@see srv_adaptive_flushing_method_t */
+static const char *innodb_adaptive_flushing_method_names[] = {
+    "heuristic",  /* SRV_ADAPTIVE_FLUSHING_HEURISTIC */
+    "predictive", /* SRV_ADAPTIVE_FLUSHING_PREDICTIVE */
+    NullS};
+
+/** Enumeration of innodb_adaptive_flushing_method */
+static TYPELIB innodb_adaptive_flushing_method_typelib = {
+    array_elements(innodb_adaptive_flushing_method_names) - 1,
+    "innodb_adaptive_flushing_method_typelib",
+    innodb_adaptive_flushing_method_names, nullptr};
+
+/** Allowed values of innodb_buffer_pool_load_order
+@see srv_buf_load_order_t */
+static const char *innodb_buffer_pool_load_order_names[] = {
+    "page",      /* SRV_BUF_LOAD_ORDER_PAGE */
+    "hot_first", /* SRV_BUF_LOAD_ORDER_HOT_FIRST */
+    NullS};
+
+/** Enumeration of innodb_buffer_pool_load_order */
+static TYPELIB innodb_buffer_pool_load_order_typelib = {
+    array_elements(innodb_buffer_pool_load_order_names) - 1,
+    "innodb_buffer_pool_load_order_typelib",
+    innodb_buffer_pool_load_order_names, nullptr};
+
+/** Allowed values of innodb_lru_policy */
+static const char *innodb_lru_policy_names[] = {
+    "midpoint", /* BUF_LRU_POLICY_MIDPOINT */
+    "adaptive", /* BUF_LRU_POLICY_ADAPTIVE */
+    NullS};
+
+/** Enumeration of innodb_lru_policy */
+static TYPELIB innodb_lru_policy_typelib = {
+    array_elements(innodb_lru_policy_names) - 1, "innodb_lru_policy_typelib",
+    innodb_lru_policy_names, nullptr};
+
 /** Retrieve the FTS Relevance Ranking result for doc with doc_id
 of m_prebuilt->fts_doc_id
 @param[in,out]  fts_hdl FTS handler
@@ -687,6 +728,7 @@ static PSI_mutex_info all_innodb_mutexes[] = {
     PSI_MUTEX_KEY(buffer_block_mutex, 0, 0, PSI_DOCUMENT_ME),
 #endif /* !PFS_SKIP_BUFFER_MUTEX_RWLOCK */
     PSI_MUTEX_KEY(buf_pool_chunks_mutex, 0, 0, PSI_DOCUMENT_ME),
+    PSI_MUTEX_KEY(buf_pool_ctier_mutex, 0, 0, PSI_DOCUMENT_ME),
     PSI_MUTEX_KEY(buf_pool_flush_state_mutex, 0, 0, PSI_DOCUMENT_ME),
     PSI_MUTEX_KEY(buf_pool_LRU_list_mutex, 0, 0, PSI_DOCUMENT_ME),
     PSI_MUTEX_KEY(buf_pool_free_list_mutex, 0, 0, PSI_DOCUMENT_ME),
@@ -1121,6 +1163,13 @@ static MYSQL_THDVAR_ULONG(ddl_threads, PLUGIN_VAR_RQCMDARG,
                           1,          /* Minimum. */
                           64, 0);     /* Maximum. */
 
+static MYSQL_THDVAR_ULONG(ddl_scan_rate_limit, PLUGIN_VAR_RQCMDARG,
+                          "Maximum number of clustered index pages per second"
+                          " that DDL reads to build indexes, 0 for no limit.",
+                          nullptr, nullptr, 0, /* Default. */
+                          0,                   /* Minimum. */
+                          ULONG_MAX, 0);       /* Maximum. */
+
 static SHOW_VAR innodb_status_variables[] = {
     {"buffer_pool_dump_status",
      (char *)&export_vars.innodb_buffer_pool_dump_status, SHOW_CHAR,
@@ -2045,6 +2094,10 @@ ulong thd_ddl_buffer_size(THD *thd) { return THDVAR(thd, ddl_buffer_size); }
 
 size_t thd_ddl_threads(THD *thd) noexcept { return THDVAR(thd, ddl_threads); }
 
+ulong thd_ddl_scan_rate_limit(THD *thd) noexcept {
+  return THDVAR(thd, ddl_scan_rate_limit);
+}
+
 /** Check if statement is of type INSERT .... SELECT that involves
 use of intrinsic tables.
 @param[in]      user_thd        thread handler
@@ -2611,6 +2664,9 @@ dberr_t Compression::check(const char *algorithm, Compression *compression) {
   } else if (innobase_strcasecmp(algorithm, "lz4") == 0) {
     compression->m_type = LZ4;
 
+  } else if (innobase_strcasecmp(algorithm, "zstd") == 0) {
+    compression->m_type = ZSTD;
+
   } else {
     return (DB_UNSUPPORTED);
   }
@@ -2634,6 +2690,7 @@ bool Compression::validate(const Compression::Type type) {
     case NONE:
     case ZLIB:
     case LZ4:
+    case ZSTD:
       break;
     default:
       ret = false;
@@ -4965,8 +5022,13 @@ static int innodb_init_params() {
   }
 
 #ifdef LINUX_NATIVE_AIO
+  if (!srv_use_native_aio) {
+    srv_use_io_uring = false;
+  }
+
   if (srv_use_native_aio) {
-    ib::info(ER_IB_MSG_541) << "Using Linux native AIO";
+    ib::info(ER_IB_MSG_541) << (srv_use_io_uring ? "Using Linux io_uring"
+                                                 : "Using Linux native AIO");
   }
 #elif !defined _WIN32
   /* Currently native AIO is supported only on Windows and Linux
@@ -8358,15 +8420,25 @@ void ha_innobase::build_template(bool whole_row) {
   ulint n_fields;
   bool fetch_all_in_key = false;
   bool fetch_primary_key_cols = false;
+  bool lock_clust_only = false;
   ulint i;
 
-  if (m_prebuilt->select_lock_type == LOCK_X) {
+  if (m_prebuilt->select_lock_type == LOCK_X &&
+      thd_sql_command(m_user_thd) == SQLCOM_SELECT && !whole_row) {
+    /* SELECT ... FOR UPDATE must lock the clustered index record,
+    but it only uses the columns in read_set, so there is no need to
+    convert the others or to fetch their off-page LOB data. */
+
+    lock_clust_only = true;
+  } else if (m_prebuilt->select_lock_type == LOCK_X) {
     /* We always retrieve the whole clustered index record if we
     use exclusive row level locks, for example, if the read is
     done in an UPDATE statement. */
 
     whole_row = true;
-  } else if (!whole_row) {
+  }
+
+  if (!whole_row) {
     if (m_prebuilt->hint_need_to_fetch_extra_cols == ROW_RETRIEVE_ALL_COLS) {
       /* We know we must at least fetch all columns in the
       key, or all columns in the table */
@@ -8398,7 +8470,7 @@ void ha_innobase::build_template(bool whole_row) {
 
   clust_index = m_prebuilt->table->first_index();
 
-  index = whole_row ? clust_index : m_prebuilt->index;
+  index = whole_row || lock_clust_only ? clust_index : m_prebuilt->index;
 
   m_prebuilt->need_to_access_clustered = (index == clust_index);
 
@@ -8575,6 +8647,7 @@ void ha_innobase::build_template(bool whole_row) {
     }
 
     m_prebuilt->idx_cond = true;
+    build_icp_filter();
   } else {
     mysql_row_templ_t *templ;
     ulint num_v = 0;
@@ -16775,6 +16848,137 @@ func_exit:
   return (ha_rows)n_rows;
 }
 
+/** Reads asynchronously the leaf pages of an index on which the given keys
+are, when they are not in the buffer pool yet. The search for each key stops
+at the level above the leaves, so that only the pages of the upper levels are
+read synchronously, and these are mostly in the buffer pool. This is only a
+hint: no records are locked and keys that cannot be searched are skipped.
+The hints are followed if innodb_prefetch_hints is set, and always for the
+rowids of a multi-range read.
+@param[in]      keynr           index number, or MAX_KEY for the clustered
+                                index and keys that are row positions
+@param[in]      keys            start keys of the lookups
+@param[in]      num_keys        number of keys */
+bool ha_innobase::prefetch_keys_enabled() const {
+  return srv_prefetch_hints || m_prebuilt->m_sorted_lookups;
+}
+
+void ha_innobase::prefetch_keys(uint keynr, const key_range *keys,
+                                uint num_keys) {
+  DBUG_TRACE;
+
+  if (!prefetch_keys_enabled() || num_keys == 0) {
+    return;
+  }
+
+  ut_a(m_prebuilt->trx == thd_to_trx(ha_thd()));
+
+  TrxInInnoDB trx_in_innodb(m_prebuilt->trx);
+
+  dict_index_t *index = innobase_get_index(keynr);
+
+  if (index == nullptr || dict_table_is_discarded(m_prebuilt->table) ||
+      index->is_corrupted() || !index->is_usable(m_prebuilt->trx) ||
+      dict_index_is_spatial(index) || index->table->is_intrinsic()) {
+    return;
+  }
+
+  const ulint n_fields = dict_index_get_n_fields(index);
+  const ulint key_buf_len = m_prebuilt->srch_key_val_len;
+
+  /* Do not use m_prebuilt->srch_key_val1, a scan of this handle may
+  still compare with the search tuple that it holds. */
+  mem_heap_t *heap = mem_heap_create(
+      n_fields * sizeof(dfield_t) + sizeof(dtuple_t) + key_buf_len,
+      UT_LOCATION_HERE);
+
+  dtuple_t *tuple = dtuple_create(heap, n_fields);
+  byte *key_buf = static_cast<byte *>(mem_heap_alloc(heap, key_buf_len));
+  ulint offsets_[REC_OFFS_NORMAL_SIZE];
+  ulint *offsets = offsets_;
+  rec_offs_init(offsets_);
+
+  const page_size_t page_size(dict_table_page_size(index->table));
+  page_no_t prev_page_no = FIL_NULL;
+  ulint n_reads = 0;
+
+  for (uint i = 0; i < num_keys; ++i) {
+    if (keys[i].key == nullptr || keys[i].length == 0) {
+      continue;
+    }
+
+    dtuple_set_n_fields(tuple, n_fields);
+    dict_index_copy_types(tuple, index, n_fields);
+
+    row_sel_convert_mysql_key_to_innobase(tuple, key_buf, key_buf_len, index,
+                                          keys[i].key, keys[i].length);
+
+    if (dtuple_get_n_fields(tuple) == 0) {
+      continue;
+    }
+
+    page_no_t page_no = FIL_NULL;
+    mtr_t mtr;
+
+    mtr_start(&mtr);
+
+    mtr_s_lock(dict_index_get_lock(index), &mtr, UT_LOCATION_HERE);
+
+    buf_block_t *block = btr_root_block_get(index, RW_S_LATCH, &mtr);
+
+    for (ulint level = btr_page_get_level(buf_block_get_frame(block));
+         level > 0; --level) {
+      page_cur_t page_cur;
+
+      page_cur_search(block, index, tuple, PAGE_CUR_LE, &page_cur);
+
+      const rec_t *node_ptr = page_cur_get_rec(&page_cur);
+
+      if (page_rec_is_infimum(node_ptr)) {
+        node_ptr = page_rec_get_next_const(node_ptr);
+      }
+
+      if (!page_rec_is_user_rec(node_ptr)) {
+        break;
+      }
+
+      offsets = rec_get_offsets(node_ptr, index, offsets, ULINT_UNDEFINED,
+                                UT_LOCATION_HERE, &heap);
+
+      const page_no_t child_page_no =
+          btr_node_ptr_get_child_page_no(node_ptr, offsets);
+
+      if (level == 1) {
+        page_no = child_page_no;
+        break;
+      }
+
+      block = btr_block_get(page_id_t(index->space, child_page_no), page_size,
+                            RW_S_LATCH, UT_LOCATION_HERE, index, &mtr);
+    }
+
+    mtr_commit(&mtr);
+
+    /* The keys are usually sorted, and many of them on the same page. */
+    if (page_no != FIL_NULL && page_no != prev_page_no) {
+      prev_page_no = page_no;
+
+      if (buf_read_page_background(page_id_t(index->space, page_no),
+                                   page_size, false)) {
+        ++n_reads;
+      }
+    }
+  }
+
+  mem_heap_free(heap);
+
+  if (n_reads > 0) {
+    os_aio_simulated_wake_handler_threads();
+
+    MONITOR_INC_VALUE(MONITOR_PREFETCH_HINT_READS, n_reads);
+  }
+}
+
 /** Gives an UPPER BOUND to the number of rows in a table. This is used in
  filesort.cc.
  @return upper bound of rows */
@@ -18309,6 +18513,53 @@ int ha_innobase::check(THD *thd,                /*!< in: user thread handle */
   return is_ok ? HA_ADMIN_OK : HA_ADMIN_CORRUPT;
 }
 
+/** Start a bulk insert. For LOAD DATA, INSERT ... SELECT and multi-row
+INSERT into an empty table, the entries of the non-unique secondary indexes
+are then inserted in index order when the buffer fills up and in
+end_bulk_insert(), instead of row by row.
+@param[in]      rows    estimated number of rows, or 0 if unknown */
+void ha_innobase::start_bulk_insert(ha_rows rows) {
+  const auto sql_command = thd_sql_command(m_user_thd);
+
+  /* A multi-row INSERT passes the number of rows in its VALUES list;
+  sorting is not worth it for a single row. */
+  const bool is_bulk_command =
+      sql_command == SQLCOM_LOAD || sql_command == SQLCOM_INSERT_SELECT ||
+      (sql_command == SQLCOM_INSERT && rows > 1);
+
+  /* Triggers could read the table, and REPLACE and ON DUPLICATE KEY
+  UPDATE could modify rows, while some of its entries are buffered.
+  Partitions switch m_prebuilt between rows. */
+  if (!is_bulk_command || table->triggers != nullptr ||
+      table->part_info != nullptr || srv_read_only_mode ||
+      m_prebuilt->ins_bulk != nullptr) {
+    return;
+  }
+
+  row_insert_bulk_start(m_prebuilt);
+}
+
+/** End a bulk insert, inserting any buffered secondary index entries.
+@return 0 or error number */
+int ha_innobase::end_bulk_insert() {
+  if (m_prebuilt->ins_bulk == nullptr) {
+    return 0;
+  }
+
+  TrxInInnoDB trx_in_innodb(m_prebuilt->trx);
+
+  const dberr_t err = row_insert_bulk_end(m_prebuilt, true);
+
+  const int error =
+      convert_error_code_to_mysql(err, m_prebuilt->table->flags, m_user_thd);
+
+  if (error != 0) {
+    set_my_errno(error);
+  }
+
+  return error;
+}
+
 /** Tells something additional to the handler about how to do things.
  @return 0 or error number */
 
@@ -18394,6 +18645,10 @@ int ha_innobase::end_stmt() {
     row_mysql_prebuilt_free_blob_heap(m_prebuilt);
   }
 
+  /* A bulk insert whose end_bulk_insert() was not called failed, and the
+  statement is rolled back. */
+  row_insert_bulk_end(m_prebuilt, false);
+
   m_prebuilt->end_stmt();
 
   reset_template();
@@ -20659,6 +20914,14 @@ static void innodb_old_blocks_pct_update(
       buf_LRU_old_ratio_update(*static_cast<const uint *>(save), true));
 }
 
+/** Update the system variable innodb_lru_policy using the "saved" value.
+This function is registered as a callback with MySQL. */
+static void innodb_lru_policy_update(THD *, SYS_VAR *, void *,
+                                     const void *save) {
+  buf_LRU_policy_update(*static_cast<const ulong *>(save),
+                        innobase_old_blocks_pct);
+}
+
 /** Update the system variable innodb_old_blocks_pct using the "saved"
  value. This function is registered as a callback with MySQL. */
 static void innodb_change_buffer_max_size_update(
@@ -22088,6 +22351,25 @@ static MYSQL_SYSVAR_BOOL(
     "Attempt flushing dirty pages to avoid IO bursts at checkpoints.", nullptr,
     nullptr, true);
 
+static MYSQL_SYSVAR_ENUM(
+    adaptive_flushing_method, srv_adaptive_flushing_method,
+    PLUGIN_VAR_RQCMDARG,
+    "How adaptive flushing decides how many pages to flush. heuristic mixes"
+    " innodb_io_capacity, the redo age and the dirty page percentage;"
+    " predictive models the redo generation rate and the age of the oldest"
+    " modification in each buffer pool instance, and steers that age towards"
+    " innodb_adaptive_flushing_target_pct.",
+    nullptr, nullptr, SRV_ADAPTIVE_FLUSHING_HEURISTIC,
+    &innodb_adaptive_flushing_method_typelib);
+
+static MYSQL_SYSVAR_ULONG(
+    adaptive_flushing_target_pct, srv_adaptive_flushing_target_pct,
+    PLUGIN_VAR_RQCMDARG,
+    "With innodb_adaptive_flushing_method=predictive, the age of the oldest"
+    " modification to aim for, as a percentage of the redo age at which"
+    " asynchronous flushing starts.",
+    nullptr, nullptr, 50, 10, 90, 0);
+
 static MYSQL_SYSVAR_BOOL(
     flush_sync, srv_flush_sync, PLUGIN_VAR_NOCMDARG,
     "Allow IO bursts at the checkpoints ignoring io_capacity setting.", nullptr,
@@ -22163,6 +22445,14 @@ static MYSQL_SYSVAR_BOOL(
     " Disable with --skip-innodb-adaptive-hash-index.",
     nullptr, innodb_adaptive_hash_index_update, true);
 
+static MYSQL_SYSVAR_BOOL(
+    adaptive_hash_index_optimistic, btr_search_optimistic,
+    PLUGIN_VAR_OPCMDARG,
+    "Look up rows in the InnoDB adaptive hash index without latching it,"
+    " validating the lookups instead, and use only a sample of the other"
+    " searches to decide which pages to hash (disabled by default).",
+    nullptr, nullptr, false);
+
 /** Number of distinct partitions of AHI.
 Each partition is protected by its own latch and so we have parts number
 of latches protecting complete search system. */
@@ -22335,6 +22625,15 @@ static MYSQL_SYSVAR_BOOL(
     "logic will not be affected. ",
     nullptr, innodb_srv_buffer_pool_in_core_file_update, true);
 
+static MYSQL_SYSVAR_ULONGLONG(
+    buffer_pool_compressed_tier_size, srv_buf_pool_ctier_size,
+    PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+    "Size in bytes of the memory in which clean pages evicted from the buffer"
+    " pool are kept LZ4 compressed, so that reading them again does not need"
+    " any I/O. It is divided between the buffer pool instances. 0 disables"
+    " this compressed tier.",
+    nullptr, nullptr, 0, 0, ~0ULL, 0);
+
 static MYSQL_SYSVAR_ULONG(
     buffer_pool_dump_pct, srv_buf_pool_dump_pct, PLUGIN_VAR_RQCMDARG,
     "Dump only the hottest N% of each buffer pool, defaults to 25", nullptr,
@@ -22363,6 +22662,21 @@ static MYSQL_SYSVAR_BOOL(buffer_pool_load_abort, innodb_buffer_pool_load_abort,
                          "Abort a currently running load of the buffer pool",
                          nullptr, buffer_pool_load_abort, false);
 
+static MYSQL_SYSVAR_ENUM(
+    buffer_pool_load_order, srv_buf_load_order, PLUGIN_VAR_RQCMDARG,
+    "In which order to load the pages of the buffer pool dump. page reads"
+    " them all sorted by tablespace and page number; hot_first reads the most"
+    " recently used pages first, in batches sorted by tablespace and page"
+    " number.",
+    nullptr, nullptr, SRV_BUF_LOAD_ORDER_PAGE,
+    &innodb_buffer_pool_load_order_typelib);
+
+static MYSQL_SYSVAR_ULONG(buffer_pool_load_threads, srv_buf_load_threads,
+                          PLUGIN_VAR_RQCMDARG,
+                          "Number of threads that read pages when loading"
+                          " the buffer pool",
+                          nullptr, nullptr, 4, 1, 64, 0);
+
 /* there is no point in changing this during runtime, thus readonly */
 static MYSQL_SYSVAR_BOOL(
     buffer_pool_load_at_startup, srv_buffer_pool_load_at_startup,
@@ -22499,6 +22813,12 @@ static MYSQL_SYSVAR_ULONG(force_recovery_crash, srv_force_recovery_crash,
                           nullptr, 0, 0, 100, 0);
 #endif /* UNIV_DEBUG */
 
+static MYSQL_SYSVAR_ULONG(recovery_apply_threads, srv_recv_apply_threads,
+                          PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
+                          "Number of threads that apply redo log records to"
+                          " pages in crash recovery",
+                          nullptr, nullptr, 4, 1, 64, 0);
+
 static MYSQL_SYSVAR_ULONG(page_size, srv_page_size,
                           PLUGIN_VAR_OPCMDARG | PLUGIN_VAR_READONLY |
                               PLUGIN_VAR_NOPERSIST,
@@ -22555,6 +22875,14 @@ static MYSQL_SYSVAR_BOOL(
     "of the redo log should be done by each thread individually (OFF).",
     nullptr, innodb_log_writer_threads_update, true);
 
+static MYSQL_SYSVAR_BOOL(
+    log_writer_merges_writes, srv_log_writer_merges_writes,
+    PLUGIN_VAR_NOCMDARG,
+    "Whether only the log writer thread merges the finished writes to the log"
+    " buffer (ON), or the user threads that finish them help it (OFF). ON"
+    " avoids contention between user threads at very high commit rates.",
+    nullptr, nullptr, false);
+
 static MYSQL_SYSVAR_UINT(
     log_spin_cpu_abs_lwm, srv_log_spin_cpu_abs_lwm, PLUGIN_VAR_RQCMDARG,
     "Minimum value of cpu time for which spin-delay is used."
@@ -22709,6 +23037,16 @@ static MYSQL_SYSVAR_UINT(
     " The timeout is disabled if 0.",
     nullptr, nullptr, 1000, 0, UINT_MAX32, 0);
 
+static MYSQL_SYSVAR_ENUM(
+    lru_policy, buf_LRU_policy, PLUGIN_VAR_RQCMDARG,
+    "Replacement policy of the buffer pool LRU list. midpoint keeps"
+    " innodb_old_blocks_pct of the pool for 'old' blocks; adaptive starts"
+    " from it, and grows or shrinks the 'old' blocks of each buffer pool"
+    " instance depending on which of them are read back soon after being"
+    " evicted.",
+    nullptr, innodb_lru_policy_update, BUF_LRU_POLICY_MIDPOINT,
+    &innodb_lru_policy_typelib);
+
 static MYSQL_SYSVAR_LONG(
     open_files, innobase_open_files, PLUGIN_VAR_RQCMDARG | PLUGIN_VAR_READONLY,
     "How many files at the maximum InnoDB keeps open at the same time.",
@@ -22848,12 +23186,43 @@ static MYSQL_SYSVAR_BOOL(use_native_aio, srv_use_native_aio,
                          "Use native AIO if supported on this platform.",
                          nullptr, nullptr, true);
 
+#ifdef HAVE_LIBURING
+static MYSQL_SYSVAR_BOOL(
+    use_io_uring, srv_use_io_uring, PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+    "Use io_uring instead of libaio for native AIO on Linux, and submit the"
+    " pages of a read-ahead or doublewrite batch together.",
+    nullptr, nullptr, false);
+
+static MYSQL_SYSVAR_BOOL(
+    io_uring_sqpoll, srv_io_uring_sqpoll,
+    PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+    "With innodb_use_io_uring, let a kernel thread poll for submitted i/o"
+    " requests instead of making a system call for them. Uses a CPU while"
+    " there is i/o.",
+    nullptr, nullptr, false);
+
+static MYSQL_SYSVAR_BOOL(
+    io_uring_fixed_buffers, srv_io_uring_fixed_buffers,
+    PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+    "With innodb_use_io_uring, register the buffer pool memory with the"
+    " kernel, so that page reads and writes need not map it every time. The"
+    " memory is locked, and counts against the memlock limit of the server.",
+    nullptr, nullptr, false);
+#endif /* HAVE_LIBURING */
+
 #ifdef HAVE_LIBNUMA
 static MYSQL_SYSVAR_BOOL(
     numa_interleave, srv_numa_interleave,
     PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
     "Use NUMA interleave memory policy to allocate InnoDB buffer pool.",
     nullptr, nullptr, false);
+
+static MYSQL_SYSVAR_BOOL(
+    numa_bind, srv_numa_bind, PLUGIN_VAR_NOCMDARG | PLUGIN_VAR_READONLY,
+    "Allocate the memory of each InnoDB buffer pool instance on one NUMA"
+    " node, spreading the instances over the nodes, and run the page cleaner"
+    " threads on the nodes of the instances they flush.",
+    nullptr, nullptr, false);
 #endif /* HAVE_LIBNUMA */
 
 static MYSQL_SYSVAR_BOOL(
@@ -22931,6 +23300,12 @@ static MYSQL_SYSVAR_BOOL(
     "Whether to use read ahead for random access within an extent.", nullptr,
     nullptr, false);
 
+static MYSQL_SYSVAR_BOOL(
+    prefetch_hints, srv_prefetch_hints, PLUGIN_VAR_NOCMDARG,
+    "Whether to read asynchronously the leaf pages of the index lookups that"
+    " a range scan or a multi-range read announces in advance.",
+    nullptr, nullptr, false);
+
 static MYSQL_SYSVAR_ULONG(
     read_ahead_threshold, srv_read_ahead_threshold, PLUGIN_VAR_RQCMDARG,
     "Number of pages that must be accessed sequentially for InnoDB to"
@@ -23137,11 +23512,14 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(buffer_pool_dump_at_shutdown),
     MYSQL_SYSVAR(buffer_pool_in_core_file),
     MYSQL_SYSVAR(buffer_pool_dump_pct),
+    MYSQL_SYSVAR(buffer_pool_compressed_tier_size),
 #ifdef UNIV_DEBUG
     MYSQL_SYSVAR(buffer_pool_evict),
 #endif /* UNIV_DEBUG */
     MYSQL_SYSVAR(buffer_pool_load_now),
     MYSQL_SYSVAR(buffer_pool_load_abort),
+    MYSQL_SYSVAR(buffer_pool_load_order),
+    MYSQL_SYSVAR(buffer_pool_load_threads),
     MYSQL_SYSVAR(buffer_pool_load_at_startup),
     MYSQL_SYSVAR(lru_scan_depth),
     MYSQL_SYSVAR(flush_neighbors),
@@ -23152,6 +23530,7 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(compression_level),
     MYSQL_SYSVAR(ddl_buffer_size),
     MYSQL_SYSVAR(ddl_threads),
+    MYSQL_SYSVAR(ddl_scan_rate_limit),
     MYSQL_SYSVAR(data_file_path),
     MYSQL_SYSVAR(temp_data_file_path),
     MYSQL_SYSVAR(data_home_dir),
@@ -23176,6 +23555,7 @@ static SYS_VAR *innobase_system_variables[] = {
 #ifdef UNIV_DEBUG
     MYSQL_SYSVAR(force_recovery_crash),
 #endif /* UNIV_DEBUG */
+    MYSQL_SYSVAR(recovery_apply_threads),
     MYSQL_SYSVAR(fill_factor),
     MYSQL_SYSVAR(ft_cache_size),
     MYSQL_SYSVAR(ft_total_cache_size),
@@ -23199,6 +23579,7 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(log_write_ahead_size),
     MYSQL_SYSVAR(log_group_home_dir),
     MYSQL_SYSVAR(log_writer_threads),
+    MYSQL_SYSVAR(log_writer_merges_writes),
     MYSQL_SYSVAR(log_spin_cpu_abs_lwm),
     MYSQL_SYSVAR(log_spin_cpu_pct_hwm),
     MYSQL_SYSVAR(log_wait_for_flush_spin_hwm),
@@ -23226,12 +23607,15 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(max_dirty_pages_pct),
     MYSQL_SYSVAR(max_dirty_pages_pct_lwm),
     MYSQL_SYSVAR(adaptive_flushing_lwm),
+    MYSQL_SYSVAR(adaptive_flushing_method),
+    MYSQL_SYSVAR(adaptive_flushing_target_pct),
     MYSQL_SYSVAR(adaptive_flushing),
     MYSQL_SYSVAR(flush_sync),
     MYSQL_SYSVAR(flushing_avg_loops),
     MYSQL_SYSVAR(max_purge_lag),
     MYSQL_SYSVAR(max_purge_lag_delay),
     MYSQL_SYSVAR(old_blocks_pct),
+    MYSQL_SYSVAR(lru_policy),
     MYSQL_SYSVAR(old_blocks_time),
     MYSQL_SYSVAR(open_files),
     MYSQL_SYSVAR(optimize_fulltext_only),
@@ -23247,6 +23631,7 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(stats_persistent_sample_pages),
     MYSQL_SYSVAR(stats_auto_recalc),
     MYSQL_SYSVAR(adaptive_hash_index),
+    MYSQL_SYSVAR(adaptive_hash_index_optimistic),
     MYSQL_SYSVAR(adaptive_hash_index_parts),
     MYSQL_SYSVAR(stats_method),
     MYSQL_SYSVAR(replication_delay),
@@ -23267,8 +23652,14 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(autoinc_lock_mode),
     MYSQL_SYSVAR(version),
     MYSQL_SYSVAR(use_native_aio),
+#ifdef HAVE_LIBURING
+    MYSQL_SYSVAR(use_io_uring),
+    MYSQL_SYSVAR(io_uring_sqpoll),
+    MYSQL_SYSVAR(io_uring_fixed_buffers),
+#endif /* HAVE_LIBURING */
 #ifdef HAVE_LIBNUMA
     MYSQL_SYSVAR(numa_interleave),
+    MYSQL_SYSVAR(numa_bind),
 #endif /* HAVE_LIBNUMA */
     MYSQL_SYSVAR(change_buffering),
     MYSQL_SYSVAR(change_buffer_max_size),
@@ -23277,6 +23668,7 @@ static SYS_VAR *innobase_system_variables[] = {
     MYSQL_SYSVAR(disable_background_merge),
 #endif /* UNIV_DEBUG || UNIV_IBUF_DEBUG */
     MYSQL_SYSVAR(random_read_ahead),
+    MYSQL_SYSVAR(prefetch_hints),
     MYSQL_SYSVAR(read_ahead_threshold),
     MYSQL_SYSVAR(read_only),
 
@@ -23400,11 +23792,28 @@ int ha_innobase::multi_range_read_init(RANGE_SEQ_IF *seq, void *seq_init_param,
                                        HANDLER_BUFFER *buf) {
   m_ds_mrr.init(table);
 
-  return (m_ds_mrr.dsmrr_init(seq, seq_init_param, n_ranges, mode, buf));
+  /* dsmrr_init() reads the first rowids, see multi_range_read_next() */
+  m_prebuilt->m_sorted_lookups = true;
+
+  const int error =
+      m_ds_mrr.dsmrr_init(seq, seq_init_param, n_ranges, mode, buf);
+
+  m_prebuilt->m_sorted_lookups = false;
+
+  return error;
 }
 
 int ha_innobase::multi_range_read_next(char **range_info) {
-  return (m_ds_mrr.dsmrr_next(range_info));
+  /* The rows are looked up in key order: let each search in the clustered
+  index start from the leaf page of the previous one, and read the leaf
+  pages of the next rowids ahead. */
+  m_prebuilt->m_sorted_lookups = true;
+
+  const int error = m_ds_mrr.dsmrr_next(range_info);
+
+  m_prebuilt->m_sorted_lookups = false;
+
+  return error;
 }
 
 ha_rows ha_innobase::multi_range_read_info_const(uint keyno, RANGE_SEQ_IF *seq,
@@ -23433,7 +23842,9 @@ Index Condition Pushdown interface implementation */
 /** InnoDB index push-down condition check
  @return ICP_NO_MATCH, ICP_MATCH, or ICP_OUT_OF_RANGE */
 ICP_RESULT
-innobase_index_cond(ha_innobase *h) /*!< in/out: pointer to ha_innobase */
+innobase_index_cond(ha_innobase *h, /*!< in/out: pointer to ha_innobase */
+                    bool rejected)  /*!< in: true if only the end of the
+                                    range needs to be checked */
 {
   DBUG_TRACE;
 
@@ -23445,9 +23856,17 @@ innobase_index_cond(ha_innobase *h) /*!< in/out: pointer to ha_innobase */
     return ICP_OUT_OF_RANGE;
   }
 
+  if (rejected) {
+    return ICP_NO_MATCH;
+  }
+
   return h->pushed_idx_cond->val_int() ? ICP_MATCH : ICP_NO_MATCH;
 }
 
+bool innobase_index_has_end_range(const ha_innobase *h) {
+  return h->end_range != nullptr;
+}
+
 /** Get the computed value by supplying the base column values.
 @param[in,out]  table   the table whose virtual column template to be built */
 void innobase_init_vc_templ(dict_table_t *table) {
@@ -23743,6 +24162,253 @@ dfield_t *innobase_get_computed_value(
   return (field);
 }
 
+/** Check if a comparison of a field with a constant can be evaluated by
+comparing the InnoDB format of the field with that of the constant.
+@param[in]      cond_func       comparison
+@param[in]      field           MySQL field
+@param[in]      comp_type       type of the comparison
+@param[in]      value           constant
+@return true if the comparison can be evaluated by InnoDB */
+static bool innobase_icp_comparable(Item *cond_func, const Field *field,
+                                    Item_func::Functype comp_type,
+                                    Item *value) {
+  switch (field->real_type()) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+    case MYSQL_TYPE_YEAR:
+    case MYSQL_TYPE_NEWDATE:
+    case MYSQL_TYPE_TIME2:
+    case MYSQL_TYPE_DATETIME2:
+      break;
+    case MYSQL_TYPE_STRING:
+      /* CHAR columns are compared as strings only with strings. */
+      if (value->result_type() != STRING_RESULT || value->is_temporal()) {
+        return false;
+      }
+      break;
+    default:
+      /* TIMESTAMP values are compared in the time zone of the session,
+      and ENUM, SET and BIT values as strings or integers. */
+      return false;
+  }
+
+  if (!value->const_for_execution() || value->has_subquery() ||
+      value->is_expensive()) {
+    return false;
+  }
+
+  return comparable_in_index(cond_func, field, Field::itRAW, comp_type,
+                             value);
+}
+
+/** Convert a constant to the InnoDB format of a field, if it is exactly a
+value of the field.
+@param[in,out]  field   MySQL field
+@param[in]      col     InnoDB column of the field
+@param[in]      comp    true if the table uses a compact format
+@param[in,out]  value   constant
+@param[out]     is_null true if the constant is NULL
+@param[out]     out     the constant in InnoDB format
+@return true if the constant was converted, or is NULL */
+static bool innobase_icp_value(Field *field, const dict_col_t *col, bool comp,
+                               Item *value, bool *is_null,
+                               row_icp_pred_t::value_t *out) {
+  /* Store the constant in the field like the range optimizer does, but
+  keep the value that was in the record. */
+  const ulint len = field->pack_length();
+  uchar *ptr = field->field_ptr();
+  uchar *null_ptr = field->get_null_ptr();
+  const std::vector<uchar> saved(ptr, ptr + len);
+  const uchar saved_null = null_ptr != nullptr ? *null_ptr : 0;
+
+  TABLE *table = field->table;
+  my_bitmap_map *old_map = dbug_tmp_use_all_columns(table, table->write_set);
+  const bool converted =
+      value->save_in_field_no_warnings(field, true) == TYPE_OK;
+  dbug_tmp_restore_column_map(table->write_set, old_map);
+
+  *is_null = value->null_value;
+  if (converted && !*is_null) {
+    std::vector<byte> buf(len);
+    dfield_t dfield;
+    col->copy_type(dfield_get_type(&dfield));
+    row_mysql_store_col_in_innobase_format(&dfield, buf.data(), true, ptr, len,
+                                           comp);
+    const byte *data = static_cast<const byte *>(dfield_get_data(&dfield));
+    out->assign(data, data + dfield_get_len(&dfield));
+  }
+
+  memcpy(ptr, saved.data(), len);
+  if (null_ptr != nullptr) {
+    *null_ptr = saved_null;
+  }
+
+  return converted || *is_null;
+}
+
+void ha_innobase::add_icp_pred(Item *cond) {
+  if (cond->type() != Item::FUNC_ITEM) {
+    return;
+  }
+
+  auto func = down_cast<Item_func *>(cond);
+  Item **args = func->arguments();
+  Item_func::Functype functype = func->functype();
+  uint field_arg = 0;
+
+  switch (functype) {
+    case Item_func::LT_FUNC:
+    case Item_func::LE_FUNC:
+    case Item_func::GT_FUNC:
+    case Item_func::GE_FUNC:
+    case Item_func::EQ_FUNC:
+      if (args[0]->real_item()->type() != Item::FIELD_ITEM) {
+        field_arg = 1;
+        functype = down_cast<Item_bool_func2 *>(func)->rev_functype();
+      }
+      break;
+    case Item_func::BETWEEN:
+    case Item_func::IN_FUNC:
+      if (down_cast<Item_func_opt_neg *>(func)->negated) {
+        return;
+      }
+      break;
+    default:
+      return;
+  }
+
+  if (args[field_arg]->real_item()->type() != Item::FIELD_ITEM) {
+    return;
+  }
+  Field *field = down_cast<Item_field *>(args[field_arg]->real_item())->field;
+  if (field->table != table) {
+    return;
+  }
+
+  /* Find the field in the index. Only the fields of the index are in the
+  template for the index condition. */
+  const auto offset = field->offset(table->record[0]);
+  const mysql_row_templ_t *templ = nullptr;
+  for (ulint i = 0; i < m_prebuilt->idx_cond_n_cols; i++) {
+    if (m_prebuilt->mysql_template[i].mysql_col_offset == offset) {
+      templ = &m_prebuilt->mysql_template[i];
+      break;
+    }
+  }
+  if (templ == nullptr || templ->is_virtual) {
+    return;
+  }
+
+  const dict_index_t *index = m_prebuilt->index;
+  const dict_field_t *index_field = index->get_field(templ->icp_rec_field_no);
+  if (index_field->prefix_len > 0) {
+    return;
+  }
+  const dict_col_t *col = index_field->col;
+  const bool comp = dict_table_is_comp(m_prebuilt->table);
+
+  row_icp_pred_t pred{};
+  pred.field_no = templ->icp_rec_field_no;
+  pred.mtype = col->mtype;
+  pred.prtype = col->prtype;
+
+  for (uint i = 0; i < func->argument_count(); i++) {
+    if (i != field_arg &&
+        !innobase_icp_comparable(func, field,
+                                 functype == Item_func::EQ_FUNC ||
+                                         functype == Item_func::IN_FUNC
+                                     ? Item_func::EQ_FUNC
+                                     : functype == Item_func::BETWEEN
+                                           ? Item_func::GE_FUNC
+                                           : functype,
+                                 args[i])) {
+      return;
+    }
+  }
+
+  bool is_null;
+  const auto bound = [&](Item *value, row_icp_pred_t::value_t *out) {
+    /* A NULL bound is left to the server too. */
+    return innobase_icp_value(field, col, comp, value, &is_null, out) &&
+           !is_null;
+  };
+
+  switch (functype) {
+    case Item_func::LT_FUNC:
+    case Item_func::LE_FUNC:
+      pred.has_high = bound(args[1 - field_arg], &pred.high);
+      pred.high_inclusive = functype == Item_func::LE_FUNC;
+      break;
+    case Item_func::GT_FUNC:
+    case Item_func::GE_FUNC:
+      pred.has_low = bound(args[1 - field_arg], &pred.low);
+      pred.low_inclusive = functype == Item_func::GE_FUNC;
+      break;
+    case Item_func::EQ_FUNC:
+      pred.has_low = pred.has_high = bound(args[1 - field_arg], &pred.low);
+      pred.high = pred.low;
+      pred.low_inclusive = pred.high_inclusive = true;
+      break;
+    case Item_func::BETWEEN:
+      pred.has_low = bound(args[1], &pred.low);
+      pred.has_high = bound(args[2], &pred.high);
+      pred.low_inclusive = pred.high_inclusive = true;
+      break;
+    default:
+      ut_ad(functype == Item_func::IN_FUNC);
+      for (uint i = 1; i < func->argument_count(); i++) {
+        row_icp_pred_t::value_t value;
+        if (!innobase_icp_value(field, col, comp, args[i], &is_null, &value)) {
+          return;
+        }
+        /* A NULL in the list never makes the comparison true. */
+        if (!is_null) {
+          pred.in_list.push_back(std::move(value));
+        }
+      }
+      if (pred.in_list.empty()) {
+        return;
+      }
+      std::sort(pred.in_list.begin(), pred.in_list.end(),
+                [&](const row_icp_pred_t::value_t &a,
+                    const row_icp_pred_t::value_t &b) {
+                  return cmp_data_data(pred.mtype, pred.prtype, true, a.data(),
+                                       a.size(), b.data(), b.size()) < 0;
+                });
+      break;
+  }
+
+  if (pred.has_low || pred.has_high || !pred.in_list.empty()) {
+    m_prebuilt->idx_cond_filter->preds.push_back(std::move(pred));
+  }
+}
+
+void ha_innobase::build_icp_filter() {
+  if (m_prebuilt->idx_cond_filter == nullptr) {
+    m_prebuilt->idx_cond_filter =
+        ut::new_withkey<row_icp_filter_t>(UT_NEW_THIS_FILE_PSI_KEY);
+  }
+  m_prebuilt->idx_cond_filter->preds.clear();
+
+  Item *cond = pushed_idx_cond;
+  if (cond->type() == Item::COND_ITEM &&
+      down_cast<Item_cond *>(cond)->functype() == Item_func::COND_AND_FUNC) {
+    for (Item &item : *down_cast<Item_cond *>(cond)->argument_list()) {
+      add_icp_pred(&item);
+    }
+  } else {
+    add_icp_pred(cond);
+  }
+
+  if (m_prebuilt->idx_cond_filter->preds.empty()) {
+    ut::delete_(m_prebuilt->idx_cond_filter);
+    m_prebuilt->idx_cond_filter = nullptr;
+  }
+}
+
 /** Attempt to push down an index condition.
 @param[in] keyno MySQL key number
 @param[in] idx_cond Index condition to be checked
@@ -23777,11 +24443,20 @@ bool ha_innobase::is_record_buffer_wanted(ha_rows *const max_rows) const {
     return false;
   }
 
-  /* Limit the number of rows in the buffer to 100 for now. We may want
-  to fine-tune this later, possibly taking record size and page size into
-  account. The optimizer might allocate an even smaller buffer if it
-  thinks a smaller number of rows will be fetched. */
-  *max_rows = 100;
+  /* Let a batch hold about the records of one leaf page of the index
+  that is scanned, so that scans of short records need fewer calls to
+  row_search_mvcc(), but no fewer than 100 and no more than 1000 records.
+  The optimizer might allocate an even smaller buffer if it thinks a
+  smaller number of rows will be fetched, or if the part of the MySQL
+  record that is read is long. */
+  constexpr ha_rows MIN_ROWS = 100;
+  constexpr ha_rows MAX_ROWS = 1000;
+
+  const ulint n_leaf_pages = m_prebuilt->index->stat_n_leaf_pages;
+  const ha_rows rows_per_page =
+      n_leaf_pages > 0 ? m_prebuilt->table->stat_n_rows / n_leaf_pages : 0;
+
+  *max_rows = std::clamp(rows_per_page, MIN_ROWS, MAX_ROWS);
   return true;
 }
 
@@ -131,6 +131,10 @@ class ha_innobase : public handler {
 
   int write_row(uchar *buf) override;
 
+  void start_bulk_insert(ha_rows rows) override;
+
+  int end_bulk_insert() override;
+
   int update_row(const uchar *old_data, uchar *new_data) override;
 
   int delete_row(const uchar *buf) override;
@@ -260,6 +264,10 @@ class ha_innobase : public handler {
   ha_rows records_in_range(uint inx, key_range *min_key,
                            key_range *max_key) override;
 
+  void prefetch_keys(uint inx, const key_range *keys, uint num_keys) override;
+
+  bool prefetch_keys_enabled() const override;
+
   ha_rows estimate_rows_upper_bound() override;
 
   void update_create_info(HA_CREATE_INFO *create_info) override;
@@ -451,6 +459,25 @@ class ha_innobase : public handler {
   int parallel_scan_init(void *&scan_ctx, size_t *num_threads,
                          bool use_reserved_threads) override;
 
+  /** Initializes a parallel scan of a range of the clustered index, see
+  handler::parallel_range_scan_init().
+  @param[out]   scan_ctx              A scan context created by this method
+                                      that has to be used in
+                                      parallel_scan
+  @param[out]   num_threads           Number of threads to be spawned
+  @param[in]    use_reserved_threads  true if reserved threads are to be used
+                                      if we exhaust the max cap of number of
+                                      parallel read threads that can be
+                                      spawned at a time
+  @param[in]    min_key               Start of the range, or nullptr
+  @param[in]    max_key               End of the range, or nullptr
+  @return error code
+  @retval 0 on success */
+  int parallel_range_scan_init(void *&scan_ctx, size_t *num_threads,
+                               bool use_reserved_threads,
+                               const key_range *min_key,
+                               const key_range *max_key) override;
+
   /** Start parallel read of InnoDB records.
   @param[in]  scan_ctx          A scan context created by parallel_scan_init
   @param[in]  thread_ctxs       Context for each of the spawned threads
@@ -564,6 +591,17 @@ class ha_innobase : public handler {
   accessing individual fields is enough */
   void build_template(bool whole_row);
 
+  /** Find the comparisons in the pushed index condition that InnoDB can
+  evaluate on the records of m_prebuilt->index itself, and set
+  m_prebuilt->idx_cond_filter to them. Called by build_template() when the
+  index condition is pushed down. */
+  void build_icp_filter();
+
+  /** Add the comparison in a conjunct of the pushed index condition to
+  m_prebuilt->idx_cond_filter, if InnoDB can evaluate it.
+  @param[in]    cond    conjunct of the pushed index condition */
+  void add_icp_pred(Item *cond);
+
   /** Returns statistics information of the table to the MySQL interpreter, in
   various fields of the handle object.
   @param[in]    flag            what information is requested
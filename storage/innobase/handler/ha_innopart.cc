@@ -4021,7 +4021,15 @@ int ha_innopart::external_lock(THD *thd, int lock_type) {
   m_prebuilt->table = m_part_share->get_table_part(0);
   error = ha_innobase::external_lock(thd, lock_type);
 
-  for (uint i = 0; i < m_tot_parts; i++) {
+  /* Partitions need to be visited only to start or complete a quiesce for
+  FLUSH TABLES ... FOR EXPORT. Skip the loop over all partitions for the
+  ordinary statements, which matters for tables with many partitions. */
+  const bool flush_for_export =
+      thd_sql_command(thd) == SQLCOM_FLUSH && lock_type == F_RDLCK;
+  const bool has_flushed_tables = m_prebuilt->trx->flush_tables > 0;
+
+  for (uint i = 0; (flush_for_export || has_flushed_tables) && i < m_tot_parts;
+       i++) {
     dict_table_t *table = m_part_share->get_table_part(i);
 
     switch (table->quiesce) {
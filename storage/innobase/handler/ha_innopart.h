@@ -414,6 +414,12 @@ class ha_innopart : public ha_innobase,
   ha_rows records_in_range(uint inx, key_range *min_key,
                            key_range *max_key) override;
 
+  /** The keys are not prefetched, because it is not known which
+  partitions they are in. */
+  void prefetch_keys(uint, const key_range *, uint) override {}
+
+  bool prefetch_keys_enabled() const override { return false; }
+
   ha_rows estimate_rows_upper_bound() override;
 
   uint alter_table_flags(uint flags);
@@ -588,6 +594,13 @@ class ha_innopart : public ha_innobase,
   int parallel_scan_init(void *&scan_ctx, size_t *num_threads,
                          bool use_reserved_threads) override;
 
+  /** Ranges of partitioned tables are not scanned in parallel.
+  @return HA_ERR_UNSUPPORTED */
+  int parallel_range_scan_init(void *&, size_t *, bool, const key_range *,
+                               const key_range *) override {
+    return HA_ERR_UNSUPPORTED;
+  }
+
   using Reader = Parallel_reader_adapter;
 
   /** Start parallel read of data.
@@ -1449,6 +1449,14 @@ bool ha_innobase::prepare_inplace_alter_table(TABLE *altered_table,
 
 int ha_innobase::parallel_scan_init(void *&scan_ctx, size_t *num_threads,
                                     bool use_reserved_threads) {
+  return ha_innobase::parallel_range_scan_init(
+      scan_ctx, num_threads, use_reserved_threads, nullptr, nullptr);
+}
+
+int ha_innobase::parallel_range_scan_init(void *&scan_ctx, size_t *num_threads,
+                                          bool use_reserved_threads,
+                                          const key_range *min_key,
+                                          const key_range *max_key) {
   if (dict_table_is_discarded(m_prebuilt->table)) {
     ib_senderrf(ha_thd(), IB_LOG_LEVEL_ERROR, ER_TABLESPACE_DISCARDED,
                 m_prebuilt->table->name.m_name);
@@ -1458,6 +1466,12 @@ int ha_innobase::parallel_scan_init(void *&scan_ctx, size_t *num_threads,
 
   scan_ctx = nullptr;
 
+  /* The keys are on the primary key, which must be the clustered index. */
+  if ((min_key != nullptr || max_key != nullptr) &&
+      m_prebuilt->clust_index_was_generated) {
+    return (HA_ERR_UNSUPPORTED);
+  }
+
   update_thd();
 
   auto trx = m_prebuilt->trx;
@@ -1487,15 +1501,59 @@ int ha_innobase::parallel_scan_init(void *&scan_ctx, size_t *num_threads,
     return (HA_ERR_OUT_OF_MEM);
   }
 
-  Parallel_reader::Scan_range full_scan{};
+  auto index = m_prebuilt->table->first_index();
+
+  Parallel_reader::Scan_range scan_range{};
+
+  mem_heap_t *heap{};
+
+  if (min_key != nullptr || max_key != nullptr) {
+    const auto n_fields = dict_index_get_n_unique(index);
+
+    heap = mem_heap_create(2 * (n_fields * sizeof(dfield_t) + sizeof(dtuple_t)),
+                           UT_LOCATION_HERE);
+
+    if (min_key != nullptr) {
+      auto tuple = dtuple_create(heap, n_fields);
+      dict_index_copy_types(tuple, index, n_fields);
+
+      row_sel_convert_mysql_key_to_innobase(
+          tuple, m_prebuilt->srch_key_val1, m_prebuilt->srch_key_val_len,
+          index, min_key->key, min_key->length);
+
+      scan_range.m_start = tuple;
 
-  Parallel_reader::Config config(full_scan, m_prebuilt->table->first_index());
+      if (min_key->flag == HA_READ_AFTER_KEY) {
+        adapter->set_exclusive_start(tuple);
+      }
+    }
+
+    if (max_key != nullptr) {
+      auto tuple = dtuple_create(heap, n_fields);
+      dict_index_copy_types(tuple, index, n_fields);
 
+      row_sel_convert_mysql_key_to_innobase(
+          tuple, m_prebuilt->srch_key_val2, m_prebuilt->srch_key_val_len,
+          index, max_key->key, max_key->length);
+
+      scan_range.m_end = tuple;
+      scan_range.m_end_inclusive = max_key->flag == HA_READ_AFTER_KEY;
+    }
+  }
+
+  Parallel_reader::Config config(scan_range, index);
+
+  /* The scan range tuples are only used while the scan is partitioned, the
+  end of the range is copied. */
   dberr_t err =
       adapter->add_scan(trx, config, [=](const Parallel_reader::Ctx *ctx) {
         return (adapter->process_rows(ctx));
       });
 
+  if (heap != nullptr) {
+    mem_heap_free(heap);
+  }
+
   if (err != DB_SUCCESS) {
     ut::delete_(adapter);
     return (convert_error_code_to_mysql(err, 0, ha_thd()));
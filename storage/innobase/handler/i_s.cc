@@ -3868,6 +3868,20 @@ static ST_FIELD_INFO i_s_innodb_buffer_stats_fields_info[] = {
      STRUCT_FLD(field_flags, MY_I_S_UNSIGNED), STRUCT_FLD(old_name, ""),
      STRUCT_FLD(open_method, 0)},
 
+#define IDX_BUF_STATS_NUMA_NODE 32
+    {STRUCT_FLD(field_name, "NUMA_NODE"),
+     STRUCT_FLD(field_length, MY_INT64_NUM_DECIMAL_DIGITS),
+     STRUCT_FLD(field_type, MYSQL_TYPE_LONGLONG), STRUCT_FLD(value, 0),
+     STRUCT_FLD(field_flags, MY_I_S_UNSIGNED | MY_I_S_MAYBE_NULL),
+     STRUCT_FLD(old_name, ""), STRUCT_FLD(open_method, 0)},
+
+#define IDX_BUF_STATS_GET_REMOTE 33
+    {STRUCT_FLD(field_name, "NUMBER_PAGES_GET_REMOTE"),
+     STRUCT_FLD(field_length, MY_INT64_NUM_DECIMAL_DIGITS),
+     STRUCT_FLD(field_type, MYSQL_TYPE_LONGLONG), STRUCT_FLD(value, 0),
+     STRUCT_FLD(field_flags, MY_I_S_UNSIGNED), STRUCT_FLD(old_name, ""),
+     STRUCT_FLD(open_method, 0)},
+
     END_OF_ST_FIELD_INFO};
 
 /** Fill Information Schema table INNODB_BUFFER_POOL_STATS for a particular
@@ -3965,6 +3979,15 @@ static int i_s_innodb_stats_fill(
 
   OK(fields[IDX_BUF_STATS_UNZIP_CUR]->store(info->unzip_cur, true));
 
+  if (info->numa_node >= 0) {
+    OK(fields[IDX_BUF_STATS_NUMA_NODE]->store(info->numa_node, true));
+    fields[IDX_BUF_STATS_NUMA_NODE]->set_notnull();
+  } else {
+    fields[IDX_BUF_STATS_NUMA_NODE]->set_null();
+  }
+
+  OK(fields[IDX_BUF_STATS_GET_REMOTE]->store(info->n_page_gets_remote, true));
+
   return schema_table_store_record(thd, table);
 }
 
@@ -2385,7 +2385,9 @@ static ulint ibuf_contract(bool sync) {
 /** Contract the change buffer by reading pages to the buffer pool.
 @param[in]      full            If true, do a full contraction based
 on PCT_IO(100). If false, the size of contract batch is determined
-based on the current size of the change buffer.
+based on the current size of the change buffer, and the batch is
+skipped while foreground page reads are queuing up and the change
+buffer is less than half full.
 @return a lower limit for the combined size in bytes of entries which
 will be merged from ibuf trees to the pages read, 0 if ibuf is
 empty */
@@ -2410,6 +2412,17 @@ ulint ibuf_merge_in_background(bool full) {
 
     mutex_enter(&ibuf_mutex);
 
+    /* Merge reads compete with foreground reads. If more reads are
+    pending than one such batch would issue, leave the merge to the idle
+    loop unless the change buffer is filling up. */
+    if (ibuf->size < ibuf->max_size / 2 &&
+        buf_get_n_pending_read_ios() > n_pages) {
+      mutex_exit(&ibuf_mutex);
+
+      MONITOR_INC(MONITOR_IBUF_MERGE_DEFERRED);
+      return (0);
+    }
+
     /* If the ibuf->size is more than half the max_size
     then we make more aggressive contraction.
     +1 is to avoid division by zero. */
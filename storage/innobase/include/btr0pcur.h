@@ -157,6 +157,25 @@ struct btr_pcur_t {
                     page_cur_mode_t mode, ulint latch_mode,
                     ulint has_search_latch, mtr_t *mtr, ut::Location location);
 
+  /** Tries to position the cursor as open_no_init() would, but by searching
+  only the leaf page on which the position was last stored. This succeeds if
+  the page was not modified since, and the records on both sides of the
+  position found are on it, so that a search from the root could not end
+  elsewhere. A series of searches in key order, such as the clustered index
+  lookups of a multi-range read, thus skips the search from the root for
+  the records that are on the page of the previous one.
+  @param[in]        index             Index of the stored position
+  @param[in]        tuple             Tuple on which search done
+  @param[in]        mode              PAGE_CUR_GE or PAGE_CUR_LE
+  @param[in]        latch_mode        BTR_SEARCH_LEAF or BTR_MODIFY_LEAF
+  @param[in]        mtr               Mini-transaction
+  @param[in]        location          Location where called
+  @return true if the cursor was positioned, false if nothing was changed
+  and open_no_init() must be called */
+  bool open_on_stored_page(dict_index_t *index, const dtuple_t *tuple,
+                           page_cur_mode_t mode, ulint latch_mode, mtr_t *mtr,
+                           ut::Location location);
+
   /** If mode is PAGE_CUR_G or PAGE_CUR_GE, opens a persistent cursor
   on the first user record satisfying the search condition, in the case
   PAGE_CUR_L or PAGE_CUR_LE, on the last user record. If no such user
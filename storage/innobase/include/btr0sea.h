@@ -112,6 +112,43 @@ class btr_search_sys_t {
     X-latched rwlock. Changes from nullptr to non-nullptr are done without any
     protection. Changes from non-null to a different non-null are prohibited. */
     std::atomic<buf_block_t *> free_block_for_heap;
+    /** Incremented to an odd value after the latch is X-latched, and to an
+    even value before it is released, so that the hash table can be read
+    without the latch and the read validated afterwards, like in ut::Seq_lock.
+    It shares the cache line of hash_table, which is written only under the
+    X-latch as well. */
+    std::atomic<uint64_t> sequence{0};
+
+    /** Marks the start of a modification. Must be called with the latch
+    X-latched. */
+    void begin_write() {
+      sequence.store(sequence.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    /** Marks the end of a modification. Must be called with the latch
+    X-latched. */
+    void end_write() {
+      sequence.store(sequence.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_release);
+    }
+
+    /** Starts reading the hash table without the latch.
+    @return the sequence number to pass to read_validate(); odd if a
+    modification is in progress, in which case the read must not start */
+    uint64_t read_begin() const {
+      return sequence.load(std::memory_order_acquire);
+    }
+
+    /** Checks that nothing read from the hash table since read_begin() was
+    modified in the meantime.
+    @param[in]      seq     value returned by read_begin()
+    @return true if the values read are consistent */
+    bool read_validate(uint64_t seq) const {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return sequence.load(std::memory_order_relaxed) == seq;
+    }
   };
 
   /** Partitions of the AHI system. */
@@ -336,6 +373,11 @@ before starting the hash analysis again: this is to save CPU time when there
 is no hope in building a hash index. */
 constexpr uint32_t BTR_SEARCH_HASH_ANALYSIS = 17;
 
+/** If btr_search_optimistic is set, only one in this many searches not served
+by the adaptive hash index is used to update the search info, with this
+weight. */
+constexpr uint32_t BTR_SEARCH_SAMPLE_INTERVAL = 8;
+
 /** Limit of consecutive searches for trying a search shortcut on the search
 pattern */
 constexpr uint32_t BTR_SEARCH_ON_PATTERN_LIMIT = 3;
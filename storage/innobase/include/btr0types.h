@@ -52,6 +52,12 @@ struct btr_search_t;
 Search system is protected by array of latches. */
 extern std::atomic_bool btr_search_enabled;
 
+/** If true, lookups in the adaptive hash index do not latch its partition,
+but are validated against the partition's sequence number instead, and only a
+sample of the searches not served by it are used to decide which pages to
+hash. */
+extern bool btr_search_optimistic;
+
 /** Number of adaptive hash index partition. */
 extern ulong btr_ahi_parts;
 
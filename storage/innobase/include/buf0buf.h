@@ -176,6 +176,8 @@ struct buf_pool_info_t {
   ulint n_pages_created;             /*!< buf_pool->n_pages_created */
   ulint n_pages_written;             /*!< buf_pool->n_pages_written */
   ulint n_page_gets;                 /*!< buf_pool->n_page_gets */
+  ulint n_page_gets_remote;          /*!< buf_pool->n_page_gets_remote */
+  long numa_node;                    /*!< buf_pool->numa_node */
   ulint n_ra_pages_read_rnd;         /*!< buf_pool->n_ra_pages_read_rnd,
                                      number of pages readahead */
   ulint n_ra_pages_read;             /*!< buf_pool->n_ra_pages_read, number
@@ -1151,7 +1153,8 @@ class buf_page_t {
         m_version(other.m_version),
         access_time(other.access_time),
         m_dblwr_id(other.m_dblwr_id),
-        old(other.old)
+        old(other.old),
+        made_young(other.made_young)
 #ifdef UNIV_DEBUG
         ,
         file_page_was_freed(other.file_page_was_freed),
@@ -1628,6 +1631,11 @@ class buf_page_t {
   /** true if the block is in the old blocks in buf_pool->LRU_old */
   bool old;
 
+  /** true if the block has been moved to the start of the LRU list by
+  buf_LRU_make_block_young() since it was read in. Protected by
+  buf_pool->LRU_list_mutex. */
+  bool made_young;
+
 #ifdef UNIV_DEBUG
   /** This is set to true when fsp frees a page in buffer pool;
   protected by buf_pool->zip_mutex or buf_block_t::mutex. */
@@ -2072,6 +2080,10 @@ struct buf_pool_stat_t {
   by the buffer pool mutex */
   Shards m_n_page_gets;
 
+  /** Number of the page gets by threads running on a different NUMA node
+  than the one the buffer pool instance is bound to. */
+  Shards m_n_page_gets_remote;
+
   /** Number of read operations. */
   std::atomic<uint64_t> n_pages_read;
 
@@ -2108,6 +2120,8 @@ struct buf_pool_stat_t {
   static void copy(buf_pool_stat_t &dst, const buf_pool_stat_t &src) noexcept {
     Counter::copy(dst.m_n_page_gets, src.m_n_page_gets);
 
+    Counter::copy(dst.m_n_page_gets_remote, src.m_n_page_gets_remote);
+
     dst.n_pages_read.store(src.n_pages_read.load());
 
     dst.n_pages_written.store(src.n_pages_written.load());
@@ -2131,6 +2145,7 @@ struct buf_pool_stat_t {
 
   void reset() {
     Counter::clear(m_n_page_gets);
+    Counter::clear(m_n_page_gets_remote);
 
     n_pages_read = 0;
     n_pages_written = 0;
@@ -2205,11 +2220,27 @@ struct buf_pool_t {
   /** Array index of this buffer pool instance */
   ulint instance_no;
 
+  /** NUMA node the memory of this instance is bound to, or -1 if it is not
+  bound to any; see srv_numa_bind */
+  int numa_node;
+
   /** Current pool size in bytes */
   ulint curr_pool_size;
 
   /** Reserve this much of the buffer pool for "old" blocks */
   ulint LRU_old_ratio;
+
+  /** History of recently evicted pages, to notice pages that are read back
+  soon after their eviction; see buf_LRU_note_read(). Protected by
+  LRU_list_mutex. */
+  uint64_t *LRU_ghost;
+
+  /** Number of entries in LRU_ghost */
+  ulint LRU_ghost_size;
+
+  /** Compressed copies of clean pages evicted from this instance, or nullptr
+  if innodb_buffer_pool_compressed_tier_size is 0; see buf0ctier.h */
+  buf_ctier_t *ctier;
 #ifdef UNIV_DEBUG
   /** Number of frames allocated from the buffer pool to the buddy system.
   Protected by zip_hash_mutex. */
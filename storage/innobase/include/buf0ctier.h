@@ -0,0 +1,100 @@
+/*****************************************************************************
+
+Copyright (c) 2022, Oracle and/or its affiliates.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License, version 2.0, as published by the
+Free Software Foundation.
+
+This program is also distributed with certain software (including but not
+limited to OpenSSL) that is licensed under separate terms, as designated in a
+particular file or component or in included license documentation. The authors
+of MySQL hereby grant you an additional permission to link the program and
+your derivative works with the separately licensed software that they have
+included with MySQL.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License, version 2.0,
+for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
+
+*****************************************************************************/
+
+/** @file include/buf0ctier.h
+ Compressed tier of the buffer pool
+
+ Clean uncompressed pages that are evicted from the LRU list are kept LZ4
+ compressed in a memory arena of each buffer pool instance, whose blocks are
+ managed by a binary buddy allocator. A synchronous read of such a page is
+ served by decompressing it instead of reading it from the file. A page is
+ in the tier only while it is not in the buffer pool: reading or creating it
+ again removes it from the tier.
+
+ Created 2022
+ *******************************************************/
+
+#ifndef buf0ctier_h
+#define buf0ctier_h
+
+#include "buf0types.h"
+#include "fil0types.h"
+#include "univ.i"
+
+/** What buf_ctier_insert() needs to know about a page that is being freed,
+saved before buf_LRU_block_remove_hashed() invalidates the frame. */
+struct buf_ctier_save_t {
+  /** Page id */
+  page_id_t page_id{0, 0};
+
+  /** Version of the tablespace when the page was freed */
+  uint32_t version{0};
+
+  /** FIL header of the frame, part of which is overwritten when the page
+  is removed from the page hash */
+  byte fil_header[FIL_PAGE_DATA];
+};
+
+/** Create the compressed tier of a buffer pool instance.
+@param[in,out]  buf_pool        buffer pool instance
+@param[in]      size            size of the arena in bytes, 0 to disable */
+void buf_ctier_create(buf_pool_t *buf_pool, ulint size);
+
+/** Free the compressed tier of a buffer pool instance.
+@param[in,out]  buf_pool        buffer pool instance */
+void buf_ctier_free(buf_pool_t *buf_pool);
+
+/** Check if a page that is being freed should go to the compressed tier,
+and save what is needed for that. The caller must hold the block mutex and
+the page must not be removed from the page hash yet.
+@param[in]      bpage           clean page that is freed completely
+@param[out]     save            page id, version and FIL header
+@return whether to call buf_ctier_insert() after freeing the page */
+bool buf_ctier_save(const buf_page_t *bpage, buf_ctier_save_t *save);
+
+/** Store a page that was freed in the compressed tier. Neither the
+LRU list mutex nor any page hash or block latch may be held.
+@param[in]      save            filled in by buf_ctier_save()
+@param[in]      frame           frame of the page, which is not in the page
+                                hash any more and not yet on the free list */
+void buf_ctier_insert(const buf_ctier_save_t *save, const byte *frame);
+
+/** Remove a page from the compressed tier, and copy it to a frame if it was
+there. Called for every page that is read or created, after inserting it into
+the page hash.
+@param[in]      bpage           page in the page hash
+@param[out]     frame           frame to decompress the page into, or nullptr
+                                to only remove it
+@return true if the page was decompressed into frame */
+bool buf_ctier_take(const buf_page_t *bpage, byte *frame);
+
+/** Remove all pages of a tablespace from the compressed tier of a buffer
+pool instance.
+@param[in,out]  buf_pool        buffer pool instance
+@param[in]      space_id        tablespace id */
+void buf_ctier_remove_space(buf_pool_t *buf_pool, space_id_t space_id);
+
+#endif /* buf0ctier_h */
@@ -174,6 +174,35 @@ uint buf_LRU_old_ratio_update(
  policy at the end of each interval. */
 void buf_LRU_stat_update(void);
 
+/** Replacement policies of the LRU list, the values of innodb_lru_policy. */
+enum buf_LRU_policy_t : ulong {
+  /** Insert read pages at the midpoint and move them to the start once they
+  are accessed innodb_old_blocks_time after the first access. The size of the
+  old sublist is innodb_old_blocks_pct. */
+  BUF_LRU_POLICY_MIDPOINT,
+  /** Like BUF_LRU_POLICY_MIDPOINT, but the size of the old sublist of each
+  buffer pool instance adapts to the pages that are read back soon after
+  being evicted, with innodb_old_blocks_pct as the starting point. */
+  BUF_LRU_POLICY_ADAPTIVE
+};
+
+/** The replacement policy of the LRU list, see buf_LRU_policy_t. */
+extern ulong buf_LRU_policy;
+
+/** Sets the replacement policy of the LRU list.
+@param[in]      policy  the new policy, see buf_LRU_policy_t
+@param[in]      old_pct innodb_old_blocks_pct, to return to when the policy is
+                        BUF_LRU_POLICY_MIDPOINT */
+void buf_LRU_policy_update(ulong policy, uint old_pct);
+
+/** Notes that a page is being read into the buffer pool. If it was evicted
+only a short while ago, that is counted in the buffer_LRU_reread_* monitor
+counters, and with BUF_LRU_POLICY_ADAPTIVE the size of the old sublist is
+adapted. The caller must hold the LRU list mutex.
+@param[in,out]  buf_pool        buffer pool instance of the page
+@param[in]      page_id         page that is read */
+void buf_LRU_note_read(buf_pool_t *buf_pool, const page_id_t &page_id);
+
 /** Remove one page from LRU list and put it to free list. The caller must hold
 the LRU list and block mutexes and have page hash latched in X. The latch and
 the block mutexes will be released.
@@ -55,6 +55,8 @@ struct buf_pool_t;
 struct buf_pool_stat_t;
 /** Buffer pool buddy statistics struct */
 struct buf_buddy_stat_t;
+/** Compressed tier of a buffer pool instance */
+struct buf_ctier_t;
 /** Doublewrite memory struct */
 struct buf_dblwr_t;
 /** Flush observer for bulk create index */
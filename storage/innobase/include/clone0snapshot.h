@@ -775,6 +775,21 @@ class Clone_Snapshot {
   int init_page_copy(Snapshot_State new_state, byte *page_buffer,
                      uint page_buffer_len);
 
+  /** Add pages modified since an earlier clone to the snapshot page set.
+  Uses durable page tracking started by the page archiver, so that a
+  recipient holding a clone consistent up to start_lsn needs only these
+  pages to catch up. The page set is transferred in page copy state.
+  @param[in,out]  start_lsn       LSN of earlier clone, set to the LSN
+                                  tracking actually starts from
+  @param[in,out]  stop_lsn        last LSN to consider, set to the LSN
+                                  tracking actually stops at
+  @param[in]      page_buffer     temporary buffer to copy page IDs
+  @param[in]      page_buffer_len buffer length
+  @return error code, ER_PAGE_TRACKING_RANGE_NOT_TRACKED if pages modified
+  after start_lsn are not all tracked. */
+  int add_tracked_pages(lsn_t &start_lsn, lsn_t &stop_lsn, byte *page_buffer,
+                        uint page_buffer_len);
+
   /** Initialize snapshot state for redo copy
   @param[in]    new_state       state to move for apply
   @param[in]    cbk             alert callback for long wait
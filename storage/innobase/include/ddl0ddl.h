@@ -465,9 +465,14 @@ struct Context {
 
   /** Calculate the sort and  buffer size per thread.
   @param[in] n_threads          Total number of threads used for scanning.
+  @param[in] index              Index the buffers are for, or nullptr for an
+                                equal share of each index. When several
+                                indexes are built, each gets a share of
+                                the buffer proportional to the estimated
+                                size of its entries.
   @return the sort and IO buffer size per thread. */
   [[nodiscard]] Scan_buffer_size scan_buffer_size(
-      size_t n_threads) const noexcept;
+      size_t n_threads, const dict_index_t *index = nullptr) const noexcept;
 
   /** Calculate the io buffer size per file for the sort phase.
   @param[in] n_buffers          Total number of buffers to use for the merge.
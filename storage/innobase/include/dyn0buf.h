@@ -161,7 +161,7 @@ class dyn_buf_t {
   /** Reset the buffer vector */
   void erase() {
     if (m_heap != nullptr) {
-      mem_heap_free(m_heap);
+      release_heap(m_heap);
       m_heap = nullptr;
 
       /* Initialise the list and add the first block. */
@@ -384,7 +384,7 @@ class dyn_buf_t {
     block_t *block;
 
     if (m_heap == nullptr) {
-      m_heap = mem_heap_create(sizeof(*block), UT_LOCATION_HERE);
+      m_heap = acquire_heap();
     }
 
     block = reinterpret_cast<block_t *>(mem_heap_alloc(m_heap, sizeof(*block)));
@@ -395,6 +395,47 @@ class dyn_buf_t {
   }
 
  private:
+  /** A heap kept by a thread for its next buffer that outgrows
+  m_first_block. Mini-transactions are started and committed in a loop
+  by the same thread, so this saves a malloc() and free() pair for each
+  of them that writes more than one block. */
+  struct Heap_cache {
+    ~Heap_cache() {
+      if (m_heap != nullptr) {
+        mem_heap_free(m_heap);
+      }
+    }
+
+    mem_heap_t *m_heap{};
+  };
+
+  static inline thread_local Heap_cache s_heap_cache;
+
+  /** @return an empty heap for add_block(), from the cache if possible */
+  static mem_heap_t *acquire_heap() {
+    mem_heap_t *heap = s_heap_cache.m_heap;
+
+    if (heap == nullptr) {
+      return mem_heap_create(sizeof(block_t), UT_LOCATION_HERE);
+    }
+
+    s_heap_cache.m_heap = nullptr;
+    return heap;
+  }
+
+  /** Free a heap returned by acquire_heap(), or keep it in the cache.
+  @param[in]    heap    heap to release */
+  static void release_heap(mem_heap_t *heap) {
+    if (s_heap_cache.m_heap != nullptr) {
+      mem_heap_free(heap);
+      return;
+    }
+
+    /* Only the first block of the heap is kept. */
+    mem_heap_empty(heap);
+    s_heap_cache.m_heap = heap;
+  }
+
   /** Heap to use for memory allocation */
   mem_heap_t *m_heap;
 
@@ -331,6 +331,7 @@ struct fil_space_t {
     new (&m_n_ref_count) std::atomic_size_t;
     new (&m_deleted) std::atomic<bool>;
 #endif /* !UNIV_HOTBACKUP */
+    new (&atomic_page_writes) std::atomic_bool;
   }
 
  private:
@@ -490,6 +491,12 @@ struct fil_space_t {
   /** true if this space is currently in unflushed_spaces */
   bool is_in_unflushed_spaces{};
 
+  /** true if the storage under the file of this single-file tablespace
+  writes its pages atomically, so that they need not go through the
+  doublewrite buffer. Set when the file is opened, see
+  os_file_has_atomic_writes(). */
+  std::atomic_bool atomic_page_writes{};
+
   /** Compression algorithm */
   Compression::Type compression_type;
 
@@ -412,7 +412,16 @@ void ib_warn_row_too_big(const dict_table_t *table);
 #include <my_icp.h>
 
 [[nodiscard]] ICP_RESULT innobase_index_cond(
-    ha_innobase *h); /*!< in/out: pointer to ha_innobase */
+    ha_innobase *h, /*!< in/out: pointer to ha_innobase */
+    bool rejected); /*!< in: true if the record is known not to
+                    satisfy the condition, and only the end of the
+                    range needs to be checked */
+
+/** Check if a range scan has to check the end of its range together with
+the pushed index condition.
+@param[in]      h       pointer to ha_innobase
+@return true if innobase_index_cond() checks the end of the range */
+[[nodiscard]] bool innobase_index_has_end_range(const ha_innobase *h);
 
 /** Gets information on the durability property requested by thread.
  Used when writing either a prepare or commit record to the log
@@ -457,4 +466,8 @@ ulong thd_parallel_read_threads(THD *thd);
 /** @return the number of DDL threads to use (global/session). */
 [[nodiscard]] size_t thd_ddl_threads(THD *thd) noexcept;
 
+/** @return the maximum number of clustered index pages per second that DDL
+may read to build indexes, 0 if unlimited (global/session). */
+[[nodiscard]] ulong thd_ddl_scan_rate_limit(THD *thd) noexcept;
+
 #endif /* HA_INNODB_PROTOTYPES_H */
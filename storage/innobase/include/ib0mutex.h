@@ -39,6 +39,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "ut0rnd.h"
 #include "ut0ut.h"
 
+#include <algorithm>
 #include <atomic>
 
 /** OS mutex for tracking lock/unlock for debugging */
@@ -509,6 +510,14 @@ struct TTASEventMutex {
                          const char *filename, uint32_t line) UNIV_NOTHROW {
     uint32_t n_spins = 0;
     uint32_t n_waits = 0;
+
+    /* Spin for at most about twice the number of rounds that recent
+    acquisitions of this mutex needed. A mutex that is released quickly
+    then gives up early when it happens to be held for long, while one
+    that needs long spins works its way back up to max_spins. */
+    const uint32_t avg_spins = m_avg_spins.load(std::memory_order_relaxed);
+    max_spins = std::min(max_spins, 2 * avg_spins + MIN_SPINS);
+
     const uint32_t step = max_spins;
 
     for (;;) {
@@ -549,6 +558,14 @@ struct TTASEventMutex {
     mutex design */
 
     m_policy.add(n_spins, n_waits);
+
+    /* Move the average 1/8 of the way towards the spins used now,
+    capped by the limit when the thread had to wait. Lost updates from
+    concurrent threads do not matter. */
+    const int32_t used = std::min({n_spins, step, uint32_t{UINT16_MAX}});
+    const int32_t avg = static_cast<int32_t>(avg_spins);
+    m_avg_spins.store(static_cast<uint16_t>(avg + (used - avg) / 8),
+                      std::memory_order_relaxed);
   }
 
   /** Note that there are threads waiting on the mutex */
@@ -580,6 +597,12 @@ struct TTASEventMutex {
   /** true if there are (or may be) threads waiting
   in the global wait array for this mutex to be released. */
   std::atomic_bool m_waiters{false};
+
+  /** Spin rounds allowed even when m_avg_spins is 0 */
+  static constexpr uint32_t MIN_SPINS = 10;
+
+  /** Moving average of the spin rounds that spin_and_try_lock() used */
+  std::atomic<uint16_t> m_avg_spins{0};
 };
 
 /** Mutex interface for all policy mutexes. This class handles the interfacing
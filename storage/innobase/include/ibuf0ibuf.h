@@ -279,7 +279,8 @@ void ibuf_delete_for_discarded_space(space_id_t space); /*!< in: space id */
 /** Contract the change buffer by reading pages to the buffer pool.
 @param[in]      full            If true, do a full contraction based on
 PCT_IO(100). If false, the size of contract batch is determined based on the
-current size of the change buffer.
+current size of the change buffer, and the batch is skipped while foreground
+page reads are queuing up and the change buffer is less than half full.
 @return a lower limit for the combined size in bytes of entries which will be
 merged from ibuf trees to the pages read, 0 if ibuf is empty */
 ulint ibuf_merge_in_background(bool full);
@@ -886,6 +886,15 @@ void lock_wait_timeout_thread();
  so that the thread will know it has to analyze it. */
 void lock_wait_request_check_for_cycles();
 
+/** Checks if the (only) edge in the wait-for graph outgoing from a waiting
+transaction may close a cycle, by following the outgoing edges from its
+endpoint, and calls lock_wait_request_check_for_cycles() if it may. As every
+new or modified edge is checked, each cycle is found when its last edge is
+created, in time bounded by LOCK_WAIT_MAX_PATH_LENGTH, so that the thread
+which analyzes the wait-for graph need not scan it on every new wait.
+@param[in]  waiter    transaction whose trx->blocking_trx has been set */
+void lock_wait_check_for_cycle_from(const trx_t *waiter);
+
 /** Puts a user OS thread to wait for a lock to be released. If an error
  occurs during the wait trx->error_state associated with thr is != DB_SUCCESS
  when we return. DB_INTERRUPTED, DB_LOCK_WAIT_TIMEOUT and DB_DEADLOCK
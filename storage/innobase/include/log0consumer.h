@@ -29,11 +29,25 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
  Redo log functions and types related to the log consumption.
 
+ A redo log consumer reports up to which lsn it has consumed the redo log,
+ and log_files_governor does not recycle or remove redo log files which
+ some registered consumer still needs. A consumer that falls behind makes
+ the redo log files pile up, and log_writer stalls once they use up the
+ whole redo log capacity.
+
+ The Log_stream_consumer lets a process outside InnoDB (for example for
+ point-in-time recovery or change data capture) stream the redo log without
+ copying it: it hands out read-only views of complete redo log blocks,
+ mapped directly from the redo log files.
+
  *******************************************************/
 
 #ifndef log0consumer_h
 #define log0consumer_h
 
+#include <atomic>
+
+#include "db0err.h"   /* dberr_t */
 #include "log0types.h" /* lsn_t, log_t& */
 
 class Log_consumer {
@@ -92,6 +106,145 @@ class Log_checkpoint_consumer : public Log_consumer {
   log_t &m_log;
 };
 
+/** Read-only view of complete redo log blocks, which is mapped from one
+redo log file by Log_stream_consumer::acquire(). The blocks are in the format
+of the redo log files, starting with the block header. */
+struct Log_stream_view {
+  /** First byte of the first block, nullptr if nothing is mapped */
+  const byte *m_data{nullptr};
+
+  /** Size of the view in bytes, a multiple of OS_FILE_LOG_BLOCK_SIZE */
+  size_t m_size{0};
+
+  /** LSN of the first byte of the view, aligned to OS_FILE_LOG_BLOCK_SIZE */
+  lsn_t m_start_lsn{0};
+
+  /** LSN of the first byte after the view, aligned to
+  OS_FILE_LOG_BLOCK_SIZE */
+  lsn_t m_end_lsn{0};
+
+ private:
+  friend class Log_stream_consumer;
+
+  /** Start of the mapping, which is aligned down from m_data */
+  void *m_map{nullptr};
+
+  /** Size of the mapping in bytes */
+  size_t m_map_size{0};
+
+  /** File descriptor of the mapped redo log file */
+  int m_fd{-1};
+};
+
+/** Redo log consumer which streams the redo log through read-only views of
+redo log blocks, mapped from the redo log files. Only redo which has been
+flushed to disk is handed out, in complete blocks.
+
+Usage, from one thread:
+@code
+  Log_stream_consumer consumer{*log_sys, "cdc", max_lag};
+  consumer.start();
+  for (;;) {
+    Log_stream_view view;
+    dberr_t err = consumer.acquire(max_size, view);
+    if (err == DB_NOT_FOUND) {
+      wait and retry
+    } else if (err != DB_SUCCESS) {
+      break;
+    }
+    process view.m_data, view.m_size
+    consumer.release(view, view.m_end_lsn);
+  }
+  consumer.stop();
+@endcode
+
+Backpressure: the consumer holds the redo it has not consumed yet, and when
+log_files_governor needs the oldest redo log file, consumption_requested()
+marks it, see is_consumption_requested(). Nothing of the consumer runs in
+log_writer, which only stalls when the redo log capacity is used up. If the
+consumer is given a hard limit (max_lag), it holds at most that many bytes
+of redo behind the current lsn: once it lags further, the older redo is
+released to log_files_governor and the consumer becomes overrun instead of
+stalling log_writer. While a view is acquired, the redo from its start is
+held regardless of the limit, so views should be released promptly. */
+class Log_stream_consumer : public Log_consumer {
+ public:
+  /** Constructor
+  @param[in]  log       redo log
+  @param[in]  name      name of the consumer
+  @param[in]  max_lag   hard limit in bytes for the redo which the consumer
+                        holds, or 0 to hold all it has not consumed */
+  Log_stream_consumer(log_t &log, const std::string &name, lsn_t max_lag);
+
+  ~Log_stream_consumer() override;
+
+  Log_stream_consumer(const Log_stream_consumer &) = delete;
+  Log_stream_consumer &operator=(const Log_stream_consumer &) = delete;
+
+  const std::string &get_name() const override;
+
+  lsn_t get_consumed_lsn() const override;
+
+  void consumption_requested() override;
+
+  /** Register the consumer, to consume the redo log from the last
+  checkpoint on.
+  @retval DB_SUCCESS      the consumer was registered
+  @retval DB_UNSUPPORTED  the redo log is encrypted, so that it cannot be
+                          handed out as it is in the files */
+  dberr_t start();
+
+  /** Unregister the consumer. No view may be acquired. */
+  void stop();
+
+  /** Map the complete blocks of flushed redo after get_consumed_lsn(), up to
+  the end of the redo log file which contains them.
+  @param[in]   max_size  maximum size of the view in bytes, at least
+                         OS_FILE_LOG_BLOCK_SIZE
+  @param[out]  view      the view, which must be released by release()
+  @retval DB_SUCCESS          the view was mapped
+  @retval DB_NOT_FOUND        no complete block has been flushed yet
+  @retval DB_MISSING_HISTORY  the consumer was overrun: the redo it has not
+                              consumed is not available any more, and it has
+                              to be stopped and started again
+  @retval DB_IO_ERROR         the redo log file could not be mapped */
+  dberr_t acquire(size_t max_size, Log_stream_view &view);
+
+  /** Unmap a view and advance the consumed lsn.
+  @param[in,out]  view          view mapped by acquire()
+  @param[in]      consumed_lsn  lsn up to which the redo was consumed,
+                                within [view.m_start_lsn, view.m_end_lsn] */
+  void release(Log_stream_view &view, lsn_t consumed_lsn);
+
+  /** @return true if log_files_governor asked the consumer to consume
+  faster since the consumed lsn was last advanced by release() */
+  bool is_consumption_requested() const {
+    return m_consumption_requested.load();
+  }
+
+ private:
+  /** Redo log */
+  log_t &m_log;
+
+  /** Name of this consumer (saved value from ctor) */
+  const std::string m_name;
+
+  /** Hard limit in bytes for the redo which is held, 0 if none */
+  const lsn_t m_max_lag;
+
+  /** Whether the consumer is registered */
+  bool m_started{false};
+
+  /** LSN up to which the redo has been consumed */
+  std::atomic<lsn_t> m_consumed_lsn{0};
+
+  /** Start lsn of the acquired view, LSN_MAX if none */
+  std::atomic<lsn_t> m_view_start_lsn{LSN_MAX};
+
+  /** Whether consumption_requested() was called */
+  std::atomic<bool> m_consumption_requested{false};
+};
+
 /** Register the given redo log consumer.
 @param[in,out]  log           redo log
 @param[in]      log_consumer  redo log consumer to register */
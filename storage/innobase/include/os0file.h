@@ -61,6 +61,8 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
 
 #include <functional>
 #include <stack>
+#include <utility>
+#include <vector>
 
 /** Prefix all files and directory created under data directory with special
 string so that it never conflicts with MySQL schema directory. */
@@ -1665,9 +1667,27 @@ void os_aio_wake_all_threads_at_shutdown();
 be other, synchronous, pending writes. */
 void os_aio_wait_until_no_pending_writes();
 
-/** Wakes up simulated aio i/o-handler threads if they have something to do. */
+/** Wakes up simulated aio i/o-handler threads if they have something to do.
+With io_uring, submits the requests that were posted with
+IORequest::DO_NOT_WAKE, so that a batch of them needs one system call per
+i/o-handler thread instead of one per page. */
 void os_aio_simulated_wake_handler_threads();
 
+/** Memory areas to register with the native aio system, see
+os_aio_register_buffers(): pairs of start address and length. */
+using os_aio_buffers_t = std::vector<std::pair<byte *, size_t>>;
+
+/** Registers memory that most aio requests read into or write from, such as
+the buffer pool, with io_uring, so that the kernel need not map it for every
+request. Replaces any memory that was registered before. Does nothing unless
+innodb_use_io_uring and innodb_io_uring_fixed_buffers are set.
+@param[in]      buffers         the memory to register */
+void os_aio_register_buffers(const os_aio_buffers_t &buffers);
+
+/** Unregisters the memory registered by os_aio_register_buffers(). This must
+be done before that memory is freed. */
+void os_aio_unregister_buffers();
+
 /** This function can be called if one wants to post a batch of reads and
 prefers an i/o-handler thread to handle them all at once later. You must
 call os_aio_simulated_wake_handler_threads later to ensure the threads
@@ -1781,6 +1801,16 @@ ulint os_file_get_umask();
 [[nodiscard]] dberr_t os_file_punch_hole(os_file_t fh, os_offset_t off,
                                          os_offset_t len);
 
+/** Check if the storage under a file writes blocks of a given size
+atomically: a write of that size at an offset aligned to it is either
+on the media completely or not at all after a power failure. This is
+only the case for direct I/O to a device that reports an atomic write
+unit of at least that size.
+@param[in]      fh      File handle of a data file
+@param[in]      size    Size of the writes in bytes
+@return true if the writes are atomic */
+[[nodiscard]] bool os_file_has_atomic_writes(os_file_t fh, ulint size);
+
 /** Check if the file system supports sparse files.
 
 Warning: On POSIX systems we try and punch a hole from offset 0 to
@@ -180,6 +180,49 @@ inline int os_numa_node_of_cpu(int cpu) {
 #endif
 }
 
+/** Get the number of NUMA nodes in the system.
+@return number of nodes */
+inline int os_numa_num_configured_nodes() {
+#if defined(HAVE_LIBNUMA)
+  return (numa_num_configured_nodes());
+#elif defined(HAVE_WINNUMA)
+  ULONG highest_node;
+
+  if (!GetNumaHighestNodeNumber(&highest_node)) {
+    return (1);
+  }
+
+  return (static_cast<int>(highest_node) + 1);
+#else
+  return (1);
+#endif
+}
+
+/** Run the current thread, and the threads it creates later, only on the CPUs
+of a given NUMA node.
+@param[in]      node    NUMA node to run on
+@return 0 on success, -1 on failure */
+inline int os_numa_run_on_node(int node) {
+#if defined(HAVE_LIBNUMA)
+  return (numa_run_on_node(node));
+#elif defined(HAVE_WINNUMA)
+  GROUP_AFFINITY affinity;
+
+  if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(node), &affinity)) {
+    return (-1);
+  }
+
+  if (!SetThreadGroupAffinity(GetCurrentThread(), &affinity, NULL)) {
+    return (-1);
+  }
+
+  return (0);
+#else
+  ut_error;
+  return (-1);
+#endif
+}
+
 /** Allocate a memory on a given NUMA node.
 @param[in]      size    number of bytes to allocate
 @param[in]      node    NUMA node on which to allocate the memory
@@ -33,12 +33,15 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #ifndef row0ins_h
 #define row0ins_h
 
+#include <vector>
+
 #include "data0data.h"
 #include "dict0types.h"
 #include "que0types.h"
 #include "row0types.h"
 #include "trx0types.h"
 #include "univ.i"
+#include "ut0new.h"
 
 /** Checks if foreign key constraint fails for an index entry. Sets shared locks
  which lock either the success or the failure of the constraint. NOTE that
@@ -156,6 +159,110 @@ and return. don't execute actual insert. */
  @return query thread to run next or NULL */
 que_thr_t *row_ins_step(que_thr_t *thr); /*!< in: query thread */
 
+/** Secondary index entries of an INSERT ... SELECT or LOAD DATA into an
+empty table. The entries of the non-unique secondary indexes are not
+inserted row by row into random places of each index, but buffered and
+inserted in index order when the buffer fills up or the statement ends.
+
+The clustered index and the unique secondary indexes are still modified
+row by row, so duplicates are reported for the right row and every row
+has its undo log record as before. Rolling back an insert removes the
+secondary index entries that were inserted and skips the ones that were
+not, so a rollback at any point leaves the indexes consistent, as long as
+the entries of the rows that were rolled back are discarded from the
+buffer, see rollback(). */
+class Row_ins_bulk {
+ public:
+  /** Constructor.
+  @param[in]  table     table to insert into
+  @param[in]  max_size  bytes of entries to buffer before inserting them */
+  Row_ins_bulk(dict_table_t *table, size_t max_size);
+
+  ~Row_ins_bulk();
+
+  Row_ins_bulk(const Row_ins_bulk &) = delete;
+  Row_ins_bulk &operator=(const Row_ins_bulk &) = delete;
+
+  /** Check if inserts into a table can be buffered: it must be empty,
+  have some index to buffer, and no FOREIGN KEY constraints or full-text
+  indexes that would look at the indexes before the entries are inserted.
+  @param[in]  table     table to insert into
+  @return true if the table qualifies */
+  static bool can_buffer(dict_table_t *table);
+
+  /** Check if the entries of an index are buffered.
+  @param[in]  index     index of the table
+  @return true if the entries are buffered */
+  bool is_buffered(const dict_index_t *index) const;
+
+  /** Buffer an entry.
+  @param[in]  index     index with is_buffered() true
+  @param[in]  entry     entry to insert, which is copied
+  @param[in]  undo_no   trx_t::undo_no after the clustered index record
+                        of the row was inserted */
+  void add(const dict_index_t *index, const dtuple_t *entry,
+           undo_no_t undo_no);
+
+  /** Discard the entries of rows that were rolled back.
+  @param[in]  undo_no   trx_t::undo_no after the rollback */
+  void rollback(undo_no_t undo_no);
+
+  /** Discard all entries, because the transaction was rolled back or
+  inserting them failed. */
+  void clear();
+
+  /** @return true if the entries should be inserted now */
+  bool is_full() const;
+
+  /** @return true if no entries are buffered */
+  bool is_empty() const;
+
+  /** Insert the buffered entries in index order. If this returns
+  DB_LOCK_WAIT, it continues with the entry that had to wait when called
+  again.
+  @param[in]  thr       query thread
+  @return DB_SUCCESS, DB_LOCK_WAIT or error code */
+  [[nodiscard]] dberr_t flush(que_thr_t *thr);
+
+ private:
+  /** A buffered entry */
+  struct Entry {
+    /** The entry, allocated from m_heap */
+    dtuple_t *m_tuple;
+
+    /** trx_t::undo_no after the row was inserted in the clustered index */
+    undo_no_t m_undo_no;
+  };
+
+  using Entries = std::vector<Entry, ut::allocator<Entry>>;
+
+  /** Buffered entries of an index */
+  struct Index {
+    /** The index */
+    dict_index_t *m_index;
+
+    /** Entries in insert order, or index order once m_sorted */
+    Entries m_entries;
+
+    /** Number of m_entries that were inserted by flush() */
+    size_t m_n_inserted;
+
+    /** Whether m_entries was sorted by flush() */
+    bool m_sorted;
+  };
+
+  using Indexes = std::vector<Index, ut::allocator<Index>>;
+
+  /** The indexes whose entries are buffered */
+  Indexes m_indexes;
+
+  /** Heap of the buffered entries */
+  mem_heap_t *m_heap;
+
+  /** Bytes of entries to buffer before inserting them */
+  size_t m_max_size;
+};
+
 /* Insert node structure */
 
 struct ins_node_t {
@@ -188,6 +295,9 @@ struct ins_node_t {
   the multi-value field, before which the values have been inserted */
   uint32_t ins_multi_val_pos;
 
+  /** Buffer of secondary index entries of a bulk insert, or nullptr */
+  Row_ins_bulk *bulk;
+
   ulint magic_n;
 };
 
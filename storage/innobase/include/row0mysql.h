@@ -41,6 +41,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include <stddef.h>
 #include <sys/types.h>
 #include <algorithm>
+#include <vector>
 
 #include "btr0pcur.h"
 #include "data0data.h"
@@ -80,6 +81,7 @@ struct dict_table_t;
 struct dict_v_col_t;
 struct dtuple_t;
 struct ins_node_t;
+class Row_ins_bulk;
 struct mtr_t;
 struct que_fork_t;
 struct que_thr_t;
@@ -235,6 +237,20 @@ dberr_t row_lock_table(row_prebuilt_t *prebuilt);
 [[nodiscard]] dberr_t row_insert_for_mysql(const byte *mysql_rec,
                                            row_prebuilt_t *prebuilt);
 
+/** Start a bulk insert of a LOAD DATA or INSERT ... SELECT statement.
+If the table is empty, the entries of its non-unique secondary indexes
+are buffered and inserted in index order, see Row_ins_bulk.
+@param[in,out]  prebuilt        prebuilt struct in MySQL handle */
+void row_insert_bulk_start(row_prebuilt_t *prebuilt);
+
+/** End a bulk insert started by row_insert_bulk_start().
+@param[in,out]  prebuilt        prebuilt struct in MySQL handle
+@param[in]      flush           true to insert the buffered entries,
+                                false to discard them because the
+                                statement is being rolled back
+@return error code or DB_SUCCESS */
+dberr_t row_insert_bulk_end(row_prebuilt_t *prebuilt, bool flush);
+
 /** Builds a dummy query graph used in selects. */
 void row_prebuild_sel_graph(row_prebuilt_t *prebuilt); /*!< in: prebuilt struct
                                                        in MySQL handle */
@@ -501,6 +517,44 @@ struct mysql_row_templ_t {
                                 column */
 };
 
+/** A comparison of a field of an index with constants, taken from a
+conjunct of the pushed index condition. It is evaluated on the InnoDB
+record, so that records which cannot satisfy the index condition are
+rejected without converting them to the MySQL format and evaluating the
+condition in the server. */
+struct row_icp_pred_t {
+  /** A constant in the InnoDB format of the field */
+  using value_t = std::vector<byte>;
+
+  /** field number in prebuilt->index */
+  ulint field_no;
+  /** main type of the field */
+  ulint mtype;
+  /** precise type of the field */
+  ulint prtype;
+  /** whether there is a lower bound */
+  bool has_low;
+  /** whether there is an upper bound */
+  bool has_high;
+  /** whether the lower bound itself satisfies the comparison */
+  bool low_inclusive;
+  /** whether the upper bound itself satisfies the comparison */
+  bool high_inclusive;
+  /** lower bound, if has_low */
+  value_t low;
+  /** upper bound, if has_high */
+  value_t high;
+  /** the values of an IN list in ascending order, or empty if the
+  comparison is not with an IN list */
+  std::vector<value_t> in_list;
+};
+
+/** The conjuncts of a pushed index condition that InnoDB can evaluate by
+itself; see ha_innobase::build_icp_filter(). */
+struct row_icp_filter_t {
+  std::vector<row_icp_pred_t> preds;
+};
+
 constexpr uint32_t MYSQL_FETCH_CACHE_SIZE = 8;
 /* After fetching this many rows, we start caching them in fetch_cache */
 constexpr uint32_t MYSQL_FETCH_CACHE_THRESHOLD = 4;
@@ -596,6 +650,9 @@ struct row_prebuilt_t {
   /** Innobase SQL insert node used to perform inserts to the table */
   ins_node_t *ins_node;
 
+  /** Buffered secondary index entries of a bulk insert, or nullptr */
+  Row_ins_bulk *ins_bulk;
+
   /** buffer for storing data converted to the Innobase format from the MySQL
   format */
   byte *ins_upd_rec_buff;
@@ -786,6 +843,10 @@ struct row_prebuilt_t {
                          is used, false otherwise. */
   ulint idx_cond_n_cols; /*!< Number of fields in idx_cond_cols.
                          0 if and only if idx_cond == false. */
+  row_icp_filter_t *idx_cond_filter; /*!< The part of the index condition
+                         that is checked on the InnoDB record before the
+                         whole condition, or nullptr. Only used if
+                         idx_cond == true. */
   /*----------------------*/
   unsigned innodb_api : 1;     /*!< whether this is a InnoDB API
                                query */
@@ -824,6 +885,11 @@ struct row_prebuilt_t {
   /** Return materialized key for secondary index scan */
   bool m_read_virtual_key;
 
+  /** Whether the unique searches on the clustered index come in key order,
+  as in a multi-range read, so that each one first tries the leaf page of
+  the previous one. See btr_pcur_t::open_on_stored_page(). */
+  bool m_sorted_lookups;
+
   /** Whether this is a temporary(intrinsic) table read to keep the position
   for this MySQL TABLE object */
   bool m_temp_read_shared;
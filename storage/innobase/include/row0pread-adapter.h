@@ -59,7 +59,7 @@ class Parallel_reader_adapter {
   Parallel_reader_adapter(size_t max_threads, ulint rowlen);
 
   /** Destructor. */
-  ~Parallel_reader_adapter() = default;
+  ~Parallel_reader_adapter();
 
   /** Add scan context.
   @param[in]  trx               Transaction used for parallel read.
@@ -91,6 +91,12 @@ class Parallel_reader_adapter {
   @param[in]  prebuilt           The prebuilt cache for the query. */
   void set(row_prebuilt_t *prebuilt);
 
+  /** Skip the records whose key starts with the given key, for a scan of a
+  range that starts after that key. A scan range always starts at the first
+  record that is not less than its start key.
+  @param[in]  key               Key prefix, it is copied. */
+  void set_exclusive_start(const dtuple_t *key);
+
  private:
   /** Each parallel reader thread's init function.
   @param[in]  reader_thread_ctx  context info related to the
@@ -205,6 +211,12 @@ class Parallel_reader_adapter {
 
   /** Parallel reader to use. */
   Parallel_reader m_parallel_reader;
+
+  /** Records equal to this key prefix are not sent, or nullptr. */
+  dtuple_t *m_exclusive_start{};
+
+  /** Heap for m_exclusive_start. */
+  mem_heap_t *m_heap{};
 };
 
 #endif /* !row0pread_adapter_h */
@@ -162,6 +162,10 @@ class Parallel_reader {
     /** End of the scan, can be null for +infinity. */
     const dtuple_t *m_end{};
 
+    /** Whether the records that are equal to m_end are in the range. By
+    default the scan ends before the first of them. */
+    bool m_end_inclusive{};
+
     /** Convert the instance to a string representation. */
     [[nodiscard]] std::string to_string() const;
   };
@@ -500,6 +504,11 @@ class Parallel_reader::Scan_ctx {
     m_tuple will be [first->m_tuple, second->m_tuple). */
     const dtuple_t *m_tuple{};
 
+    /** Whether the records equal to m_tuple are in the range that ends at
+    this Iter, [first->m_tuple, second->m_tuple]. Only set for the end of
+    a Scan_range with m_end_inclusive. */
+    bool m_tuple_inclusive{};
+
     /** Persistent cursor.*/
     btr_pcur_t *m_pcur{};
   };
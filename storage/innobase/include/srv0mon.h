@@ -144,11 +144,14 @@ enum monitor_id_t {
   MONITOR_DEADLOCK,
   MONITOR_DEADLOCK_FALSE_POSITIVES,
   MONITOR_DEADLOCK_ROUNDS,
+  MONITOR_DEADLOCK_CANDIDATES,
+  MONITOR_DEADLOCK_DETECTION_TIME,
   MONITOR_LOCK_THREADS_WAITING,
   MONITOR_TIMEOUT,
   MONITOR_LOCKREC_WAIT,
   MONITOR_TABLELOCK_WAIT,
   MONITOR_NUM_RECLOCK_REQ,
+  MONITOR_NUM_RECLOCK_IMPLICIT,
   MONITOR_RECLOCK_RELEASE_ATTEMPTS,
   MONITOR_RECLOCK_GRANT_ATTEMPTS,
   MONITOR_RECLOCK_CREATED,
@@ -213,11 +216,25 @@ enum monitor_id_t {
 
   MONITOR_LRU_GET_FREE_LOOPS,
   MONITOR_LRU_GET_FREE_WAITS,
+  MONITOR_LRU_REREAD_OLD,
+  MONITOR_LRU_REREAD_YOUNG,
+  MONITOR_CTIER_HITS,
+  MONITOR_CTIER_INSERTED,
+  MONITOR_CTIER_REJECTED,
+  MONITOR_CTIER_EVICTED,
+  MONITOR_CTIER_INVALIDATED,
+  MONITOR_CTIER_PAGES,
+  MONITOR_PREFETCH_HINT_READS,
 
   MONITOR_FLUSH_AVG_PAGE_RATE,
   MONITOR_FLUSH_LSN_AVG_RATE,
   MONITOR_FLUSH_PCT_FOR_DIRTY,
   MONITOR_FLUSH_PCT_FOR_LSN,
+  MONITOR_FLUSH_MODEL_LSN_RATE,
+  MONITOR_FLUSH_MODEL_AGE,
+  MONITOR_FLUSH_MODEL_TARGET_AGE,
+  MONITOR_FLUSH_MODEL_CORRECTION,
+  MONITOR_FLUSH_MODEL_PAGES,
   MONITOR_FLUSH_SYNC_WAITS,
   MONITOR_FLUSH_ADAPTIVE_TOTAL_PAGE,
   MONITOR_FLUSH_ADAPTIVE_COUNT,
@@ -312,6 +329,7 @@ enum monitor_id_t {
   MONITOR_TRX_ROLLBACK_ACTIVE,
   MONITOR_TRX_ACTIVE,
   MONITOR_TRX_ALLOCATIONS,
+  MONITOR_TRX_VIEW_REUSED,
   MONITOR_TRX_ON_LOG_NO_WAITS,
   MONITOR_TRX_ON_LOG_WAITS,
   MONITOR_TRX_ON_LOG_WAIT_LOOPS,
@@ -444,6 +462,7 @@ enum monitor_id_t {
   MONITOR_OVLD_IBUF_MERGE_DISCARD_PURGE,
   MONITOR_OVLD_IBUF_MERGES,
   MONITOR_OVLD_IBUF_SIZE,
+  MONITOR_IBUF_MERGE_DEFERRED,
 
   /* Counters for server operations */
   MONITOR_MODULE_SERVER,
@@ -494,6 +513,14 @@ enum monitor_id_t {
   MONITOR_ALTER_TABLE_SORT_FILES,
   MONITOR_ALTER_TABLE_LOG_FILES,
 
+  /* Full-text cache sync related counters */
+  MONITOR_MODULE_FTS,
+  MONITOR_FTS_SYNC_REQUESTS,
+  MONITOR_FTS_SYNC_COUNT,
+  MONITOR_FTS_SYNC_LOCKED,
+  MONITOR_FTS_SYNC_BYTES,
+  MONITOR_FTS_SYNC_MICROSECOND,
+
   MONITOR_MODULE_ICP,
   MONITOR_ICP_ATTEMPTS,
   MONITOR_ICP_NO_MATCH,
@@ -523,6 +550,7 @@ enum monitor_id_t {
   MONITOR_DBLWR_SYNC_REQUESTS,
   MONITOR_DBLWR_FLUSH_REQUESTS,
   MONITOR_DBLWR_FLUSH_WAIT_EVENTS,
+  MONITOR_DBLWR_ATOMIC_WRITES,
 
   /* This is used only for control system to turn
   on/off and reset all monitor counters */
@@ -65,7 +65,10 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
 #include <future>
 
-/* Global counters used inside InnoDB. */
+/* Global counters used inside InnoDB. Counters that every mini-transaction
+commit or I/O updates are spread over ulint_ctr_64_t slots, so that
+concurrent threads do not contend for a single cache line; they are summed
+when read. */
 struct srv_stats_t {
   typedef ib_counter_t<ulint, 64> ulint_ctr_64_t;
   typedef ib_counter_t<lsn_t, 1, single_indexer_t> lsn_ctr_1_t;
@@ -74,10 +77,10 @@ struct srv_stats_t {
   typedef ib_counter_t<int64_t, 1, single_indexer_t> int64_ctr_1_t;
 
   /** Count the amount of data written in total (in bytes) */
-  ulint_ctr_1_t data_written;
+  ulint_ctr_64_t data_written;
 
   /** Number of the log write requests done */
-  ulint_ctr_1_t log_write_requests;
+  ulint_ctr_64_t log_write_requests;
 
   /** Number of physical writes to the log performed */
   ulint_ctr_1_t log_writes;
@@ -100,7 +103,7 @@ struct srv_stats_t {
   ulint_ctr_1_t dblwr_pages_written;
 
   /** Store the number of write requests issued */
-  ulint_ctr_1_t buf_pool_write_requests;
+  ulint_ctr_64_t buf_pool_write_requests;
 
   /** Store the number of times when we had to wait for a free page
   in the buffer pool. It happens when the buffer pool is full and we
@@ -113,10 +116,10 @@ struct srv_stats_t {
 
   /** Number of buffer pool reads that led to the reading of
   a disk page */
-  ulint_ctr_1_t buf_pool_reads;
+  ulint_ctr_64_t buf_pool_reads;
 
   /** Number of data read in total (in bytes) */
-  ulint_ctr_1_t data_read;
+  ulint_ctr_64_t data_read;
 
   /** Wait time of database locks */
   int64_ctr_1_t n_lock_wait_time;
@@ -392,7 +395,18 @@ OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads.
 Currently we support native aio on windows and linux */
 extern bool srv_use_native_aio;
+/** If true, native aio on Linux goes through io_uring instead of libaio. */
+extern bool srv_use_io_uring;
+/** If true, the io_uring instances use a kernel thread that polls for
+submissions, instead of a system call for each batch of them. */
+extern bool srv_io_uring_sqpoll;
+/** If true, the buffer pool memory is registered with the io_uring
+instances, so that the kernel does not need to map it for each page i/o. */
+extern bool srv_io_uring_fixed_buffers;
 extern bool srv_numa_interleave;
+/** If true, bind the memory of each buffer pool instance to one NUMA node, and
+run the page cleaner threads on the nodes of the instances they flush. */
+extern bool srv_numa_bind;
 
 /* The innodb_directories variable value. This a list of directories
 deliminated by ';', i.e the FIL_PATH_SEPARATOR. */
@@ -484,6 +498,10 @@ extern ulong srv_log_recent_closed_size;
 /** Whether to activate/pause the log writer threads. */
 extern bool srv_log_writer_threads;
 
+/** If true, only the log writer thread follows the links of finished writes
+to the log buffer in recent_written. */
+extern bool srv_log_writer_merges_writes;
+
 /** Minimum absolute value of cpu time for which spin-delay is used. */
 extern uint srv_log_spin_cpu_abs_lwm;
 
@@ -608,11 +626,30 @@ extern ulint srv_buf_pool_base_size;
 extern long long srv_buf_pool_curr_size;
 /** Dump this % of each buffer pool during BP dump */
 extern ulong srv_buf_pool_dump_pct;
+/** Size in bytes of the compressed tier of all buffer pool instances */
+extern ulonglong srv_buf_pool_ctier_size;
+
+/** Alternatives for innodb_buffer_pool_load_order.
+@see innodb_buffer_pool_load_order_names */
+enum srv_buf_load_order_t {
+  /** Read the whole dump sorted by tablespace and page number. */
+  SRV_BUF_LOAD_ORDER_PAGE = 0,
+  /** Read the dump in the order it was written, most recently used pages
+  first, sorting only batches of it by tablespace and page number. */
+  SRV_BUF_LOAD_ORDER_HOT_FIRST = 1
+};
+
+/** In which order a BP load reads the pages, see srv_buf_load_order_t. */
+extern ulong srv_buf_load_order;
+/** Number of threads that read pages during BP load */
+extern ulong srv_buf_load_threads;
 /** Lock table size in bytes */
 extern ulint srv_lock_table_size;
 
 extern ulint srv_n_file_io_threads;
 extern bool srv_random_read_ahead;
+/** Whether to act on prefetch hints from the SQL layer */
+extern bool srv_prefetch_hints;
 extern ulong srv_read_ahead_threshold;
 extern ulong srv_n_read_io_threads;
 extern ulong srv_n_write_io_threads;
@@ -677,11 +714,33 @@ extern double srv_max_dirty_pages_pct_lwm;
 extern ulong srv_adaptive_flushing_lwm;
 extern ulong srv_flushing_avg_loops;
 
+/** Alternatives for innodb_adaptive_flushing_method.
+@see innodb_adaptive_flushing_method_names */
+enum srv_adaptive_flushing_method_t {
+  /** Mix of innodb_io_capacity, redo age and dirty page percentage. */
+  SRV_ADAPTIVE_FLUSHING_HEURISTIC = 0,
+  /** Model of the redo generation rate and of the age of the oldest
+  modification in each buffer pool instance, steering the age towards
+  innodb_adaptive_flushing_target_pct. */
+  SRV_ADAPTIVE_FLUSHING_PREDICTIVE = 1
+};
+
+/** How adaptive flushing decides how many pages to flush, see
+srv_adaptive_flushing_method_t. */
+extern ulong srv_adaptive_flushing_method;
+
+/** With SRV_ADAPTIVE_FLUSHING_PREDICTIVE, the age of the oldest modification
+to aim for, in percent of the redo age at which async flushing starts. */
+extern ulong srv_adaptive_flushing_target_pct;
+
 extern ulong srv_force_recovery;
 #ifdef UNIV_DEBUG
 extern ulong srv_force_recovery_crash;
 #endif /* UNIV_DEBUG */
 
+/** Number of threads that apply a batch of redo log records in recovery */
+extern ulong srv_recv_apply_threads;
+
 /** The value of the configuration parameter innodb_fast_shutdown,
 controlling the InnoDB shutdown.
 
@@ -859,6 +918,10 @@ extern PSI_stage_info srv_stage_alter_tablespace_encryption;
 
 /** Performance schema stage event for monitoring buffer pool load progress. */
 extern PSI_stage_info srv_stage_buffer_pool_load;
+
+/** Performance schema stage event for monitoring redo log apply progress
+in crash recovery. */
+extern PSI_stage_info srv_stage_recovery_apply;
 #endif /* HAVE_PSI_STAGE_INTERFACE */
 
 /** Performance schema stage event for monitoring clone file copy progress. */
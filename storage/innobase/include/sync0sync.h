@@ -88,6 +88,7 @@ extern mysql_pfs_key_t autoinc_persisted_mutex_key;
 extern mysql_pfs_key_t buffer_block_mutex_key;
 #endif /* !PFS_SKIP_BUFFER_MUTEX_RWLOCK */
 extern mysql_pfs_key_t buf_pool_chunks_mutex_key;
+extern mysql_pfs_key_t buf_pool_ctier_mutex_key;
 extern mysql_pfs_key_t buf_pool_flush_state_mutex_key;
 extern mysql_pfs_key_t buf_pool_LRU_list_mutex_key;
 extern mysql_pfs_key_t buf_pool_free_list_mutex_key;
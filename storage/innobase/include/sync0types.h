@@ -218,6 +218,7 @@ enum latch_level_t {
 
   SYNC_PAGE_ARCH_OPER,
 
+  SYNC_BUF_CTIER,
   SYNC_BUF_FLUSH_LIST,
   SYNC_BUF_FLUSH_STATE,
   SYNC_BUF_ZIP_HASH,
@@ -344,6 +345,7 @@ enum latch_id_t {
   LATCH_ID_AUTOINC,
   LATCH_ID_BUF_BLOCK_MUTEX,
   LATCH_ID_BUF_POOL_CHUNKS,
+  LATCH_ID_BUF_POOL_CTIER,
   LATCH_ID_BUF_POOL_ZIP,
   LATCH_ID_BUF_POOL_LRU_LIST,
   LATCH_ID_BUF_POOL_FREE_LIST,
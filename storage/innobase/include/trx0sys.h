@@ -550,6 +550,12 @@ struct trx_sys_t {
   releasing locks to ensure right order of removal and consistent snapshot. */
   trx_ids_t rw_trx_ids;
 
+  /** Incremented whenever a transaction id is removed from rw_trx_ids,
+  while next_trx_id_or_no changes whenever one is added. Together they tell
+  if a ReadView still matches rw_trx_ids, without the trx_sys_t::mutex.
+  Modified under the trx_sys_t::mutex. */
+  std::atomic<uint64_t> rw_trx_ids_version;
+
   char pad7[ut::INNODB_CACHE_LINE_SIZE];
 
   /** Mapping from transaction id to transaction instance. */
@@ -117,6 +117,17 @@ class Link_buf {
   @param[in]    to      position where the link ends (from -> to) */
   void add_link_advance_tail(Position from, Position to);
 
+  /** Add a directed link between two given positions. It is user's
+  responsibility to ensure that there is space for the link. If the tail
+  pointer is at the start of the link, it is moved to its end instead.
+  Unlike add_link_advance_tail(), the links added by other threads are
+  not followed: the thread tracking the path is left to do it, so that
+  concurrent callers do not contend on the tail pointer.
+
+  @param[in]    from    position where the link starts
+  @param[in]    to      position where the link ends (from -> to) */
+  void add_link_or_move_tail(Position from, Position to);
+
   /** Advances the tail pointer in the buffer by following connected
   path created by links. Starts at current position of the pointer.
   Stops when the provided function returns true.
@@ -300,6 +311,25 @@ inline void Link_buf<Position>::add_link_advance_tail(Position from,
   }
 }
 
+template <typename Position>
+inline void Link_buf<Position>::add_link_or_move_tail(Position from,
+                                                      Position to) {
+  ut_ad(to > from);
+  ut_ad(to - from <= std::numeric_limits<Distance>::max());
+
+  auto position = m_tail.load(std::memory_order_acquire);
+
+  ut_ad(position <= from);
+
+  if (position == from) {
+    /* can advance m_tail directly and exclusively, as in
+    add_link_advance_tail() */
+    m_tail.store(to, std::memory_order_release);
+  } else {
+    m_links[slot_index(from)].store(to, std::memory_order_release);
+  }
+}
+
 template <typename Position>
 template <typename Stop_condition>
 bool Link_buf<Position>::advance_tail_until(Stop_condition stop_condition,
@@ -255,6 +255,7 @@ static constexpr const char *auto_event_names[] = {
     "buf0buddy",
     "buf0buf",
     "buf0checksum",
+    "buf0ctier",
     "buf0dblwr",
     "buf0dump",
     "buf0flu",
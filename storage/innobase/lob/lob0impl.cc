@@ -25,6 +25,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 *****************************************************************************/
 
 #include "lob0impl.h"
+#include "buf0rea.h"
 #include "lob0del.h"
 #include "lob0index.h"
 #include "lob0inf.h"
@@ -1063,6 +1064,10 @@ dberr_t insert(InsertContext *ctx, trx_t *trx, ref_t &ref,
   return ret;
 }
 
+/** Number of LOB index entries ahead of the one being read, whose data pages
+lob::read() asks to be read in the background. */
+static constexpr ulint LOB_READ_AHEAD_ENTRIES = 32;
+
 /** Fetch a large object (LOB) from the system.
 @param[in]  ctx    the read context information.
 @param[in]  ref    the LOB reference identifying the LOB.
@@ -1157,9 +1162,35 @@ ulint read(ReadContext *ctx, ref_t ref, ulint offset, ulint len, byte *buf) {
   const ulint commit_freq = 10;
   ulint data_pages_count = 0;
 
+  /* The data pages of a large LOB are read one after the other, and
+  each one could be a synchronous read. Walk the index ahead of the
+  entry that is being read and issue asynchronous reads of the data pages
+  up to LOB_READ_AHEAD_ENTRIES entries ahead, but not beyond the requested
+  length. The page of an older version that the transaction has to see
+  instead is not read ahead. */
+  index_entry_t ahead_entry(&mtr, ctx->m_index);
+  fil_addr_t ahead_loc = node_loc;
+  ulint n_ahead = 0;
+  ulint ahead_len = 0;
+
   while (!fil_addr_is_null(node_loc) && want > 0) {
     old_version.reset(nullptr);
 
+    while (n_ahead < LOB_READ_AHEAD_ENTRIES && ahead_len < want + page_offset &&
+           !fil_addr_is_null(ahead_loc)) {
+      ahead_entry.reset(first_page.addr2ptr_s_cache(cached_blocks, ahead_loc));
+
+      const page_no_t ahead_page_no = ahead_entry.get_page_no();
+      if (ahead_page_no != FIL_NULL && ahead_page_no != first_page_no) {
+        buf_read_page_background(page_id_t(ctx->m_space_id, ahead_page_no),
+                                 ctx->m_page_size, false);
+      }
+
+      ahead_len += ahead_entry.get_data_len();
+      ahead_loc = ahead_entry.get_next();
+      ++n_ahead;
+    }
+
     node = first_page.addr2ptr_s_cache(cached_blocks, node_loc);
     cur_entry.reset(node);
 
@@ -1230,6 +1261,12 @@ ulint read(ReadContext *ctx, ref_t ref, ulint offset, ulint len, byte *buf) {
     total_read += actual_read;
     page_offset = 0;
     node_loc = cur_entry.get_next();
+
+    /* This entry was the oldest one that was read ahead. */
+    if (n_ahead > 0) {
+      --n_ahead;
+      ahead_len -= std::min(ahead_len, cur_entry.get_data_len());
+    }
   }
 
   /* Assert that we have read what has been requested or what is
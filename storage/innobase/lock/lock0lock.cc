@@ -2135,10 +2135,10 @@ static void lock_update_wait_for_edge(const lock_t *waiting_lock,
   /* Still needs to wait, but perhaps the reason has changed */
   if (waiting_lock->trx->lock.blocking_trx.load() != blocking_lock->trx) {
     waiting_lock->trx->lock.blocking_trx.store(blocking_lock->trx);
-    /* We call lock_wait_request_check_for_cycles() because the outgoing edge of
-    wait_lock->trx has changed it's endpoint and we need to analyze the
-    wait-for-graph again. */
-    lock_wait_request_check_for_cycles();
+    /* We check for a cycle because the outgoing edge of wait_lock->trx has
+    changed it's endpoint and we may need to analyze the wait-for-graph
+    again. */
+    lock_wait_check_for_cycle_from(waiting_lock->trx);
     lock_report_wait_for_edge_to_server(waiting_lock, blocking_lock);
   }
 }
@@ -5546,6 +5546,27 @@ void lock_rec_convert_impl_to_expl(const buf_block_t *block, const rec_t *rec,
   }
 }
 
+/** Checks if a transaction holds an implicit x-lock on a clustered index
+record, because the record carries the id of the transaction. Such a lock
+satisfies any request of the transaction for a LOCK_REC_NOT_GAP lock on the
+record, so that it need not latch the lock queue nor create a lock object:
+the implicit lock is converted to an explicit one only when another
+transaction has to wait for it, see lock_rec_convert_impl_to_expl().
+@param[in]  rec       user record in a clustered index
+@param[in]  index     clustered index
+@param[in]  offsets   rec_get_offsets(rec, index)
+@param[in]  trx       transaction
+@return true if trx has an implicit x-lock on rec */
+static bool lock_clust_rec_has_own_impl(const rec_t *rec,
+                                        const dict_index_t *index,
+                                        const ulint *offsets,
+                                        const trx_t *trx) {
+  /* Records whose DB_TRX_ID was reset by purge carry 0, which is also the
+  id of a transaction that has not modified anything. */
+  return trx->id != 0 &&
+         lock_clust_rec_some_has_impl(rec, index, offsets) == trx->id;
+}
+
 /** Checks if locks of other transactions prevent an immediate modify (update,
  delete mark, or delete unmark) of a clustered index record. If they do,
  first tests if the query thread should anyway be suspended for some
@@ -5575,6 +5596,13 @@ dberr_t lock_clust_rec_modify_check_and_lock(
   }
   ut_ad(!index->table->is_temporary());
 
+  /* A record which this transaction has already inserted or modified
+  stays implicitly locked by it until it commits. */
+  if (lock_clust_rec_has_own_impl(rec, index, offsets, thr_get_trx(thr))) {
+    MONITOR_INC(MONITOR_NUM_RECLOCK_IMPLICIT);
+    return (DB_SUCCESS);
+  }
+
   heap_no = rec_offs_comp(offsets) ? rec_get_heap_no_new(rec)
                                    : rec_get_heap_no_old(rec);
 
@@ -5732,6 +5760,14 @@ dberr_t lock_clust_rec_read_check_and_lock(
 
   heap_no = page_rec_get_heap_no(rec);
 
+  if (gap_mode == LOCK_REC_NOT_GAP && heap_no != PAGE_HEAP_NO_SUPREMUM &&
+      lock_clust_rec_has_own_impl(rec, index, offsets, thr_get_trx(thr))) {
+    /* The implicit x-lock covers the requested lock, which is thus not
+    a new one (DB_SUCCESS_LOCKED_REC) that could be released early. */
+    MONITOR_INC(MONITOR_NUM_RECLOCK_IMPLICIT);
+    return (DB_SUCCESS);
+  }
+
   if (heap_no != PAGE_HEAP_NO_SUPREMUM) {
     lock_rec_convert_impl_to_expl(block, rec, index, offsets);
   }
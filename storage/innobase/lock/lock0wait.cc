@@ -34,6 +34,8 @@ this program; if not, write to the Free Software Foundation, Inc.,
 
 #include <mysql/service_thd_wait.h>
 #include <sys/types.h>
+#include <atomic>
+#include <chrono>
 
 #include "ha_prototypes.h"
 #include "lock0lock.h"
@@ -167,7 +169,8 @@ static srv_slot_t *lock_wait_table_reserve_slot(
       ut_ad(lock_sys->last_slot <=
             lock_sys->waiting_threads + srv_max_n_threads);
 
-      /* We call lock_wait_request_check_for_cycles() because the
+      /* We check for a cycle (and call lock_wait_request_check_for_cycles()
+      if there may be one) because the
       node representing the `thr` only now becomes visible to the thread which
       analyzes contents of lock_sys->waiting_threads. The edge itself was
       created by lock_create_wait_for_edge() during RecLock::add_to_waitq() or
@@ -176,7 +179,7 @@ static srv_slot_t *lock_wait_table_reserve_slot(
       visible.
       I hope this explains why we do waste time on calling
       lock_wait_request_check_for_cycles() from lock_create_wait_for_edge().*/
-      lock_wait_request_check_for_cycles();
+      lock_wait_check_for_cycle_from(thr_get_trx(thr));
       return (slot);
     }
   }
@@ -194,6 +197,83 @@ static srv_slot_t *lock_wait_table_reserve_slot(
 
 void lock_wait_request_check_for_cycles() { lock_set_timeout_event(); }
 
+/** Maximum number of edges of the wait-for graph which
+lock_wait_check_for_cycle_from() follows. A longer path is handled as if
+it closed a cycle. */
+static constexpr size_t LOCK_WAIT_MAX_PATH_LENGTH = 32;
+
+/** How often the schedule weights are refreshed at most when new waits do
+not close a cycle. */
+static constexpr std::chrono::milliseconds LOCK_WAIT_SCHEDULE_REFRESH_INTERVAL{
+    10};
+
+/** When lock_wait_update_schedule_and_check_for_deadlocks() last started, in
+microseconds since the epoch of std::chrono::steady_clock */
+static std::atomic<uint64_t> lock_wait_last_round_at_us{0};
+
+/** When lock_wait_check_for_cycle_from() found the oldest candidate cycle
+which has not been analyzed yet, in microseconds since the epoch of
+std::chrono::steady_clock, or 0 if there is none */
+static std::atomic<uint64_t> lock_wait_candidate_found_at_us{0};
+
+/** @return the current time, in microseconds since the epoch of
+std::chrono::steady_clock */
+static uint64_t lock_wait_now_us() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void lock_wait_check_for_cycle_from(const trx_t *waiter) {
+  if (!innobase_deadlock_detect) {
+    /* The wait-for graph is still analyzed to compute schedule weights */
+    lock_wait_request_check_for_cycles();
+    return;
+  }
+
+  /* The edges are followed without latching anything: trx_t objects come
+  from trx_pools, which keeps their memory until shutdown, so a stale
+  blocking_trx can at worst lead to a reused trx. The blocking_trx of each
+  trx is updated with a sequentially consistent store before it is checked
+  from, so out of the edges forming a cycle, the one stored last observes all
+  the others. A concurrent modification can only make us report a spurious
+  candidate, which lock_wait_check_candidate_cycle() rejects, or miss a cycle
+  which is then closed by a later store. A transaction on the cycle which is
+  not in a slot yet checks again from lock_wait_table_reserve_slot(). */
+  const trx_t *trx = waiter;
+
+  for (size_t n = 0; n < LOCK_WAIT_MAX_PATH_LENGTH; ++n) {
+    trx = trx->lock.blocking_trx.load();
+
+    if (trx == nullptr) {
+      /* The path ends in a transaction which does not wait, so there is
+      no cycle through waiter (yet). */
+      const auto now = lock_wait_now_us();
+      const auto interval = static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              LOCK_WAIT_SCHEDULE_REFRESH_INTERVAL)
+              .count());
+
+      if (now - lock_wait_last_round_at_us.load() >= interval) {
+        lock_wait_request_check_for_cycles();
+      }
+      return;
+    }
+
+    if (trx == waiter) {
+      break;
+    }
+  }
+
+  MONITOR_INC(MONITOR_DEADLOCK_CANDIDATES);
+
+  uint64_t none = 0;
+  lock_wait_candidate_found_at_us.compare_exchange_strong(none,
+                                                          lock_wait_now_us());
+
+  lock_wait_request_check_for_cycles();
+}
+
 void lock_wait_suspend_thread(que_thr_t *thr) {
   srv_slot_t *slot;
   trx_t *trx;
@@ -1261,11 +1341,15 @@ in the wait-for graph
                               will update the new_weights entries for
                               transactions involved in this cycle (as it will
                               unfold to a path, and schedule weight can be thus
-                              computed) */
+                              computed)
+@param[in]      candidate_found_at_us   when lock_wait_check_for_cycle_from()
+                                        found the oldest candidate cycle which
+                                        was not analyzed yet, or 0 */
 static void lock_wait_find_and_handle_deadlocks(
     const ut::vector<waiting_trx_info_t> &infos,
     const ut::vector<int> &outgoing,
-    ut::vector<trx_schedule_weight_t> &new_weights) {
+    ut::vector<trx_schedule_weight_t> &new_weights,
+    uint64_t candidate_found_at_us) {
   ut_ad(infos.size() == new_weights.size());
   ut_ad(infos.size() == outgoing.size());
   /** We are going to use int and uint to store positions within infos */
@@ -1304,6 +1388,11 @@ static void lock_wait_find_and_handle_deadlocks(
         lock_wait_extract_cycle_ids(cycle_ids, id, outgoing);
         if (lock_wait_check_candidate_cycle(cycle_ids, infos, new_weights)) {
           MONITOR_INC(MONITOR_DEADLOCK);
+
+          if (candidate_found_at_us != 0) {
+            MONITOR_INC_VALUE(MONITOR_DEADLOCK_DETECTION_TIME,
+                              lock_wait_now_us() - candidate_found_at_us);
+          }
         } else {
           MONITOR_INC(MONITOR_DEADLOCK_FALSE_POSITIVES);
         }
@@ -1413,6 +1502,11 @@ static void lock_wait_update_schedule_and_check_for_deadlocks() {
   ut::vector<int> outgoing;
   ut::vector<trx_schedule_weight_t> new_weights;
 
+  lock_wait_last_round_at_us.store(lock_wait_now_us());
+
+  /* Candidates found from now on are for waits the snapshot may miss */
+  const auto candidate_found_at_us = lock_wait_candidate_found_at_us.exchange(0);
+
   auto table_reservations = lock_wait_snapshot_waiting_threads(infos);
   lock_wait_build_wait_for_graph(infos, outgoing);
 
@@ -1422,7 +1516,8 @@ static void lock_wait_update_schedule_and_check_for_deadlocks() {
 
   if (innobase_deadlock_detect) {
     /* This will also update trx->lock.schedule_weight for trxs on cycles. */
-    lock_wait_find_and_handle_deadlocks(infos, outgoing, new_weights);
+    lock_wait_find_and_handle_deadlocks(infos, outgoing, new_weights,
+                                        candidate_found_at_us);
   }
 }
 
@@ -1101,8 +1101,17 @@ void log_buffer_write_completed(log_t &log, lsn_t start_lsn, lsn_t end_lsn) {
   ut_ad(log_buffer_ready_for_write_lsn(log) <= start_lsn);
 
   /* Note that end_lsn will not point to just before footer,
-  because we have already validated that end_lsn is valid. */
-  log.recent_written.add_link_advance_tail(start_lsn, end_lsn);
+  because we have already validated that end_lsn is valid. When the log
+  writer thread is active, it may be left to follow the links alone, so
+  that user threads finishing writes at the same time only store their
+  own link. While the log writer threads are paused, the user threads
+  write the log themselves and keep advancing the tail. */
+  if (srv_log_writer_merges_writes &&
+      !log.writer_threads_paused.load(std::memory_order_acquire)) {
+    log.recent_written.add_link_or_move_tail(start_lsn, end_lsn);
+  } else {
+    log.recent_written.add_link_advance_tail(start_lsn, end_lsn);
+  }
 
   /* if someone is waiting for, set the event. (if possible) */
   lsn_t ready_lsn = log_buffer_ready_for_write_lsn(log);
@@ -30,13 +30,21 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
  *******************************************************/
 
 #include "log0consumer.h" /* Log_consumer */
+
+#include <fcntl.h>
+#include <algorithm>
+
 #include "arch0arch.h"
 #include "arch0log.h"
 #include "log0chkp.h"
+#include "log0encryption.h"     /* log_can_encrypt */
 #include "log0files_governor.h" /* log_files_mutex_own() */
+#include "log0files_io.h"       /* log_file_path */
 #include "log0log.h"            /* log_get_lsn */
+#include "my_sys.h"             /* my_mmap, my_open */
 #include "srv0shutdown.h"       /* srv_shutdown_state, ... */
 #include "srv0start.h"          /* srv_is_being_started */
+#include "ut0byte.h"            /* ut_uint64_align_down */
 
 Log_user_consumer::Log_user_consumer(const std::string &name) : m_name{name} {}
 
@@ -69,6 +77,174 @@ void Log_checkpoint_consumer::consumption_requested() {
   log_request_checkpoint_in_next_file(m_log);
 }
 
+/** Alignment of the offset in a redo log file at which a view is mapped.
+This is the allocation granularity of mappings on Windows, and a multiple
+of the page size elsewhere. */
+static constexpr os_offset_t LOG_STREAM_MAP_ALIGNMENT = 64 * 1024;
+
+Log_stream_consumer::Log_stream_consumer(log_t &log, const std::string &name,
+                                         lsn_t max_lag)
+    : m_log{log}, m_name{name}, m_max_lag{max_lag} {}
+
+Log_stream_consumer::~Log_stream_consumer() {
+  if (m_started) {
+    stop();
+  }
+}
+
+const std::string &Log_stream_consumer::get_name() const { return m_name; }
+
+lsn_t Log_stream_consumer::get_consumed_lsn() const {
+  const lsn_t consumed_lsn = m_consumed_lsn.load();
+  const lsn_t view_start_lsn = m_view_start_lsn.load();
+
+  if (view_start_lsn != LSN_MAX) {
+    return std::min(consumed_lsn, view_start_lsn);
+  }
+
+  if (m_max_lag != 0) {
+    const lsn_t current_lsn = log_get_lsn(m_log);
+
+    if (current_lsn > consumed_lsn + m_max_lag) {
+      /* Let the redo log files behind the hard limit go. If the consumer
+      needs them, acquire() reports that it was overrun. */
+      return current_lsn - m_max_lag;
+    }
+  }
+
+  return consumed_lsn;
+}
+
+void Log_stream_consumer::consumption_requested() {
+  m_consumption_requested.store(true);
+}
+
+dberr_t Log_stream_consumer::start() {
+  ut_a(!m_started);
+
+  if (log_can_encrypt(m_log)) {
+    return DB_UNSUPPORTED;
+  }
+
+  IB_mutex_guard checkpointer_latch{&(m_log.checkpointer_mutex),
+                                    UT_LOCATION_HERE};
+
+  IB_mutex_guard files_latch{&(m_log.m_files_mutex), UT_LOCATION_HERE};
+
+  m_consumed_lsn.store(log_get_checkpoint_lsn(m_log));
+  m_consumption_requested.store(false);
+
+  log_consumer_register(m_log, this);
+
+  m_started = true;
+
+  return DB_SUCCESS;
+}
+
+void Log_stream_consumer::stop() {
+  ut_a(m_started);
+  ut_a(m_view_start_lsn.load() == LSN_MAX);
+
+  IB_mutex_guard files_latch{&(m_log.m_files_mutex), UT_LOCATION_HERE};
+
+  log_consumer_unregister(m_log, this);
+
+  m_started = false;
+}
+
+dberr_t Log_stream_consumer::acquire(size_t max_size, Log_stream_view &view) {
+  ut_a(m_started);
+  ut_a(view.m_data == nullptr);
+  ut_a(max_size >= OS_FILE_LOG_BLOCK_SIZE);
+  ut_a(m_view_start_lsn.load() == LSN_MAX);
+
+  std::string file_path;
+  os_offset_t offset;
+
+  {
+    IB_mutex_guard files_latch{&(m_log.m_files_mutex), UT_LOCATION_HERE};
+
+    const lsn_t start_lsn =
+        ut_uint64_align_down(m_consumed_lsn.load(), OS_FILE_LOG_BLOCK_SIZE);
+
+    const auto file = m_log.m_files.find(start_lsn);
+
+    if (file == m_log.m_files.end() || file->m_consumed) {
+      return DB_MISSING_HISTORY;
+    }
+
+    const lsn_t flushed_lsn = ut_uint64_align_down(
+        m_log.flushed_to_disk_lsn.load(), OS_FILE_LOG_BLOCK_SIZE);
+
+    const lsn_t end_lsn = std::min(
+        {flushed_lsn, file->m_end_lsn,
+         start_lsn + ut_uint64_align_down(max_size, OS_FILE_LOG_BLOCK_SIZE)});
+
+    if (end_lsn <= start_lsn) {
+      return DB_NOT_FOUND;
+    }
+
+    /* Hold the redo log file until the view is released. */
+    m_view_start_lsn.store(start_lsn);
+
+    file_path = log_file_path(m_log.m_files_ctx, file->m_id);
+    offset = file->offset(start_lsn);
+
+    view.m_start_lsn = start_lsn;
+    view.m_end_lsn = end_lsn;
+    view.m_size = static_cast<size_t>(end_lsn - start_lsn);
+  }
+
+  const os_offset_t map_offset =
+      ut_uint64_align_down(offset, LOG_STREAM_MAP_ALIGNMENT);
+
+  view.m_map_size = static_cast<size_t>(offset - map_offset) + view.m_size;
+
+  view.m_fd = my_open(file_path.c_str(), O_RDONLY, MYF(0));
+
+  if (view.m_fd >= 0) {
+    view.m_map = my_mmap(nullptr, view.m_map_size, PROT_READ, MAP_SHARED,
+                         view.m_fd, map_offset);
+  }
+
+  if (view.m_fd < 0 || view.m_map == MAP_FAILED) {
+    ib::error(ER_IB_MSG_761) << "Cannot map redo log file " << file_path
+                             << " for redo log consumer " << m_name;
+
+    if (view.m_fd >= 0) {
+      my_close(view.m_fd, MYF(0));
+    }
+
+    view = Log_stream_view{};
+
+    m_view_start_lsn.store(LSN_MAX);
+
+    return DB_IO_ERROR;
+  }
+
+  view.m_data = static_cast<const byte *>(view.m_map) + (offset - map_offset);
+
+  return DB_SUCCESS;
+}
+
+void Log_stream_consumer::release(Log_stream_view &view, lsn_t consumed_lsn) {
+  ut_a(view.m_data != nullptr);
+  ut_a(m_view_start_lsn.load() == view.m_start_lsn);
+  ut_a(view.m_start_lsn <= consumed_lsn && consumed_lsn <= view.m_end_lsn);
+
+  my_munmap(view.m_map, view.m_map_size);
+  my_close(view.m_fd, MYF(0));
+
+  if (consumed_lsn > m_consumed_lsn.load()) {
+    m_consumed_lsn.store(consumed_lsn);
+    m_consumption_requested.store(false);
+  }
+
+  view = Log_stream_view{};
+
+  m_view_start_lsn.store(LSN_MAX);
+}
+
 void log_consumer_register(log_t &log, Log_consumer *log_consumer) {
   ut_ad(log_files_mutex_own(log) || srv_is_being_started);
 
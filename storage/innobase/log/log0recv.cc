@@ -36,11 +36,14 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include <my_aes.h>
 #include <sys/types.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <iomanip>
 #include <map>
 #include <new>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "arch0arch.h"
@@ -62,6 +65,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "mem0mem.h"
 #include "mtr0log.h"
 #include "mtr0mtr.h"
+#include "mysql/psi/mysql_stage.h"
 #include "os0thread-create.h"
 #include "page0cur.h"
 #include "page0zip.h"
@@ -90,6 +94,10 @@ this must be less than UNIV_PAGE_SIZE as it is stored in the buffer pool */
 /** Read-ahead area in applying log records to file pages */
 static const size_t RECV_READ_AHEAD_AREA = 32;
 
+/** Minimum number of pages that each thread applies log records to, when
+a batch is applied by more than one thread */
+static const size_t RECV_APPLY_MIN_PAGES = 256;
+
 /** The recovery system */
 recv_sys_t *recv_sys = nullptr;
 
@@ -1194,6 +1202,89 @@ static void recv_apply_log_rec(recv_addr_t *recv_addr) {
   }
 }
 
+/** Redo log records of pages that one thread applies in a batch */
+using Recv_addrs = std::vector<recv_addr_t *>;
+
+/** Apply the log records to pages, in a thread of
+recv_apply_hashed_log_recs() other than the one that reports the progress.
+@param[in]      recv_addrs      Redo log records of the pages to apply
+@param[in,out]  n_applied       Number of pages handled by all the threads */
+static void recv_apply_log_recs(const Recv_addrs *recv_addrs,
+                                std::atomic<size_t> *n_applied) {
+  mutex_enter(&recv_sys->mutex);
+
+  for (auto recv_addr : *recv_addrs) {
+    recv_apply_log_rec(recv_addr);
+
+    n_applied->fetch_add(1);
+  }
+
+  mutex_exit(&recv_sys->mutex);
+}
+
+/** Progress of applying a batch of log records, reported to the error log
+and to performance schema. */
+struct recv_apply_progress_t {
+  /** Report the progress in steps of this percentage */
+  static constexpr size_t PCT = 10;
+
+  /** Constructor
+  @param[in]    n_total         Number of pages in the batch */
+  explicit recv_apply_progress_t(size_t n_total)
+      : m_n_total(n_total), m_pct(PCT), m_unit(n_total / PCT) {
+    if (m_unit <= PCT) {
+      m_pct = 100;
+      m_unit = n_total;
+    }
+
+    m_next = m_unit;
+  }
+
+  /** Report the progress if the next step was reached, or if it was not
+  reported for PRINT_INTERVAL.
+  @param[in]    n_applied       Number of pages handled so far */
+  void report(size_t n_applied) {
+    mysql_stage_set_work_completed(pfs_stage_progress, n_applied);
+
+    if (m_unit == 0 || n_applied >= m_next) {
+      ib::info(ER_IB_MSG_708) << m_pct << "%";
+
+      m_pct += PCT;
+      m_next += m_unit;
+
+      m_start_time = std::chrono::steady_clock::now();
+
+    } else if (std::chrono::steady_clock::now() - m_start_time >=
+               PRINT_INTERVAL) {
+      m_start_time = std::chrono::steady_clock::now();
+
+      ib::info(ER_IB_MSG_709)
+          << std::setprecision(2)
+          << ((double)n_applied * 100) / (double)m_n_total << "%";
+    }
+  }
+
+  /** Performance schema stage of the batch */
+  PSI_stage_progress *pfs_stage_progress{nullptr};
+
+ private:
+  /** Number of pages in the batch */
+  size_t m_n_total;
+
+  /** Percentage to report at the next step */
+  size_t m_pct;
+
+  /** Number of pages in a step */
+  size_t m_unit;
+
+  /** Number of pages at which the next step is reached */
+  size_t m_next;
+
+  /** When the progress was last reported */
+  std::chrono::steady_clock::time_point m_start_time{
+      std::chrono::steady_clock::now()};
+};
+
 dberr_t recv_apply_hashed_log_recs(log_t &log, bool allow_ibuf) {
   for (;;) {
     mutex_enter(&recv_sys->mutex);
@@ -1218,18 +1309,15 @@ dberr_t recv_apply_hashed_log_recs(log_t &log, bool allow_ibuf) {
 
   ib::info(ER_IB_MSG_707, ulonglong{batch_size});
 
-  static const size_t PCT = 10;
+  recv_apply_progress_t progress(batch_size);
 
-  size_t pct = PCT;
-  size_t applied = 0;
-  auto unit = batch_size / PCT;
+  /* Collect the pages to apply, and give all the pages of a read-ahead area
+  to the same thread, so that recv_read_in_area() reads the area in one go. */
+  const size_t n_threads = std::min<size_t>(
+      srv_recv_apply_threads,
+      std::max<size_t>(batch_size / RECV_APPLY_MIN_PAGES, 1));
 
-  if (unit <= PCT) {
-    pct = 100;
-    unit = batch_size;
-  }
-
-  auto start_time = std::chrono::steady_clock::now();
+  std::vector<Recv_addrs> shares(n_threads);
 
   for (const auto &space : *recv_sys->spaces) {
     bool dropped;
@@ -1263,26 +1351,65 @@ dberr_t recv_apply_hashed_log_recs(log_t &log, bool allow_ibuf) {
         pages.second->state = RECV_DISCARDED;
       }
 
-      recv_apply_log_rec(pages.second);
+      const auto area = ut::hash_uint64_pair(
+          space.first, pages.second->page_no / RECV_READ_AHEAD_AREA);
 
-      ++applied;
+      shares[area % n_threads].push_back(pages.second);
+    }
+  }
 
-      if (unit == 0 || (applied % unit) == 0) {
-        ib::info(ER_IB_MSG_708) << pct << "%";
+#ifdef HAVE_PSI_STAGE_INTERFACE
+  progress.pfs_stage_progress =
+      mysql_set_stage(srv_stage_recovery_apply.m_key);
+#endif /* HAVE_PSI_STAGE_INTERFACE */
 
-        pct += PCT;
+  mysql_stage_set_work_estimated(progress.pfs_stage_progress, batch_size);
+  mysql_stage_set_work_completed(progress.pfs_stage_progress, 0);
 
-        start_time = std::chrono::steady_clock::now();
+  size_t n_pages = 0;
 
-      } else if (std::chrono::steady_clock::now() - start_time >=
-                 PRINT_INTERVAL) {
-        start_time = std::chrono::steady_clock::now();
+  for (auto &share : shares) {
+    /* Apply in page order, so that the pages that recv_read_in_area() read
+    in are skipped until the reads complete and apply the log records. */
+    std::sort(share.begin(), share.end(),
+              [](const recv_addr_t *lhs, const recv_addr_t *rhs) {
+                return lhs->space < rhs->space ||
+                       (lhs->space == rhs->space &&
+                        lhs->page_no < rhs->page_no);
+              });
 
-        ib::info(ER_IB_MSG_709)
-            << std::setprecision(2)
-            << ((double)applied * 100) / (double)batch_size << "%";
-      }
+    n_pages += share.size();
+  }
+
+  std::atomic<size_t> n_applied{0};
+  std::vector<std::thread> threads;
+
+  for (size_t t = 1; t < n_threads; ++t) {
+    threads.emplace_back(recv_apply_log_recs, &shares[t], &n_applied);
+  }
+
+  /* This thread applies the first share and reports the progress of all. */
+  for (auto recv_addr : shares[0]) {
+    recv_apply_log_rec(recv_addr);
+
+    progress.report(n_applied.fetch_add(1) + 1);
+  }
+
+  if (n_threads > 1) {
+    mutex_exit(&recv_sys->mutex);
+
+    for (size_t applied = n_applied.load(); applied < n_pages;
+         applied = n_applied.load()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+      progress.report(n_applied.load());
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
     }
+
+    mutex_enter(&recv_sys->mutex);
   }
 
   /* Wait until all the pages have been processed */
@@ -1295,6 +1422,11 @@ dberr_t recv_apply_hashed_log_recs(log_t &log, bool allow_ibuf) {
     mutex_enter(&recv_sys->mutex);
   }
 
+  mysql_stage_set_work_completed(progress.pfs_stage_progress, batch_size);
+#ifdef HAVE_PSI_STAGE_INTERFACE
+  mysql_end_stage();
+#endif /* HAVE_PSI_STAGE_INTERFACE */
+
   if (!allow_ibuf) {
     /* Flush all the file pages to disk and invalidate them in
     the buffer pool */
@@ -76,6 +76,18 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
 #endif /* !UNIV_HOTBACKUP */
 #endif /* LINUX_NATIVE_AIO */
 
+#if defined(LINUX_NATIVE_AIO) && defined(HAVE_LIBURING)
+/** io_uring is an alternative to libaio for native aio on Linux, see
+srv_use_io_uring. */
+#define LINUX_IO_URING
+#include <liburing.h>
+#endif /* LINUX_NATIVE_AIO && HAVE_LIBURING */
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif /* __linux__ */
+
 #ifdef HAVE_FALLOC_PUNCH_HOLE_AND_KEEP_SIZE
 #include <fcntl.h>
 #include <linux/falloc.h>
@@ -90,6 +102,8 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA
 
 #include <sys/types.h>
 #include <zlib.h>
+#include <zstd.h>
+#include <algorithm>
 #include <ctime>
 #include <functional>
 #include <new>
@@ -538,6 +552,58 @@ class AIO {
   [[nodiscard]] static bool is_linux_native_aio_supported();
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+  /** Accessor for the io_uring
+  @param[in]    segment Segment for which to get the ring
+  @return the io_uring of the segment */
+  [[nodiscard]] io_uring *io_ring(ulint segment) {
+    ut_ad(segment < get_n_segments());
+
+    return (&m_rings[segment]);
+  }
+
+  /** Puts an io_uring request for a reserved slot in the submission queue
+  of its segment. It is not submitted until uring_submit() is called for the
+  segment. The caller must own the mutex.
+  @param[in,out]        slot    an already reserved slot
+  @return true on success, false if the submission queue is full */
+  [[nodiscard]] bool uring_prepare(Slot *slot);
+
+  /** Submits the io_uring requests that were prepared for a segment. If the
+  kernel cannot take them now, they stay queued, and are submitted by the
+  next call. The caller must own the mutex.
+  @param[in]    segment Local segment in the array */
+  void uring_submit(ulint segment);
+
+  /** Submits the io_uring requests that were prepared for all segments. The
+  caller must own the mutex. */
+  void uring_submit_all();
+
+  /** @return true if io_uring requests were prepared but not submitted for
+  the segment; the caller must own the mutex.
+  @param[in]    segment Local segment in the array */
+  [[nodiscard]] bool has_unsubmitted(ulint segment) const {
+    ut_ad(is_mutex_owned());
+
+    return (m_n_unsubmitted[segment] > 0);
+  }
+
+  /** Submits the io_uring requests that were prepared for all arrays. */
+  static void uring_submit_all_arrays();
+
+  /** Registers memory for io_uring fixed buffers, see
+  os_aio_register_buffers().
+  @param[in]    buffers         the memory to register */
+  static void uring_register_buffers(const os_aio_buffers_t &buffers);
+
+  /** Unregisters the fixed buffers of all arrays. */
+  static void uring_unregister_buffers();
+
+  /** Checks if the system supports what we need of io_uring.
+  @return true if supported, false otherwise. */
+  [[nodiscard]] static bool is_linux_io_uring_supported();
+#endif /* LINUX_IO_URING */
+
 #ifdef WIN_ASYNC_IO
   /** Wakes up all async i/o threads in the array in Windows async I/O at
   shutdown. */
@@ -692,6 +758,29 @@ class AIO {
   [[nodiscard]] dberr_t init_linux_native_aio();
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+  /** Initialise one io_uring per segment
+  @return DB_SUCCESS or error code */
+  [[nodiscard]] dberr_t init_linux_io_uring();
+
+  /** Registers io_uring fixed buffers with the rings of this array. The
+  caller must own the mutex.
+  @param[in]    iovs    the buffers, sorted by address
+  @return true on success */
+  [[nodiscard]] bool register_fixed_buffers(const std::vector<iovec> &iovs);
+
+  /** Unregisters the fixed buffers of the rings of this array. The caller
+  must own the mutex. */
+  void unregister_fixed_buffers();
+
+  /** Finds the fixed buffer that contains a memory area. The caller must own
+  the mutex.
+  @param[in]    ptr     start of the area
+  @param[in]    len     length of the area
+  @return index of the buffer, or -1 if it is in none of them */
+  [[nodiscard]] int uring_find_fixed_buffer(const byte *ptr, ulint len) const;
+#endif /* LINUX_IO_URING */
+
  private:
   typedef std::vector<Slot> Slots;
 
@@ -747,6 +836,25 @@ class AIO {
   IOEvents m_events;
 #endif /* LINUX_NATIV_AIO */
 
+#ifdef LINUX_IO_URING
+  /** With srv_use_io_uring, one ring per segment, used instead of
+  m_aio_ctx. The submission queue is protected by m_mutex; the completion
+  queue is only read by the i/o-handler thread of the segment. */
+  io_uring *m_rings;
+
+  /** Number of requests prepared in the submission queue of each segment
+  that were not submitted yet. Protected by m_mutex. */
+  std::vector<ulint> m_n_unsubmitted;
+
+  /** The buffers registered with the rings, sorted by address. Protected
+  by m_mutex. */
+  std::vector<iovec> m_fixed_buffers;
+
+  /** The ring whose polling kernel thread the other rings share with
+  srv_io_uring_sqpoll, or -1 */
+  static int s_sqpoll_fd;
+#endif /* LINUX_IO_URING */
+
   /** The aio arrays for non-ibuf i/o and ibuf i/o. These are NULL when the
   module has not yet been initialized. */
 
@@ -769,6 +877,20 @@ AIO *AIO::s_writes;
 AIO *AIO::s_ibuf;
 AIO *AIO::s_log;
 
+#ifdef LINUX_IO_URING
+int AIO::s_sqpoll_fd = -1;
+
+/** How long the kernel thread of srv_io_uring_sqpoll polls for new submissions
+before it goes to sleep, in milliseconds. */
+static constexpr unsigned OS_AIO_URING_SQPOLL_IDLE = 1000;
+
+/** Largest fixed buffer that io_uring accepts: 1GiB. */
+static constexpr size_t OS_AIO_URING_MAX_FIXED_BUFFER = 1UL << 30;
+
+/** Largest number of fixed buffers that io_uring accepts. */
+static constexpr size_t OS_AIO_URING_MAX_FIXED_BUFFERS = 16384;
+#endif /* LINUX_IO_URING */
+
 #if defined(LINUX_NATIVE_AIO)
 /** timeout for each io_getevents() call = 500ms. */
 static constexpr uint64_t OS_AIO_REAP_TIMEOUT = 500000000UL;
@@ -1404,6 +1526,23 @@ byte *os_file_compress_page(Compression compression, ulint block_size,
 
       break;
 
+    case Compression::ZSTD: {
+      /* innodb_compression_level 0 selects the default level of zstd. */
+      const size_t zlen = ZSTD_compress(
+          dst + FIL_PAGE_DATA, out_len, src + FIL_PAGE_DATA, content_len,
+          static_cast<int>(compression_level));
+
+      if (ZSTD_isError(zlen) || zlen >= out_len) {
+        *dst_len = src_len;
+
+        return (src);
+      }
+
+      len = static_cast<ulint>(zlen);
+
+      break;
+    }
+
     default:
       *dst_len = src_len;
       return (src);
@@ -1918,6 +2057,8 @@ file::Block *os_file_compress_page(IORequest &type, void *&buf, ulint *n) {
   ut_a(n_alloc <= UNIV_PAGE_SIZE_MAX * 2);
   ut_a(type.compression_algorithm().m_type != Compression::LZ4 ||
        static_cast<ulint>(LZ4_COMPRESSBOUND(*n)) < n_alloc);
+  ut_a(type.compression_algorithm().m_type != Compression::ZSTD ||
+       ZSTD_compressBound(*n) < n_alloc);
 
   auto block = os_alloc_block();
 
@@ -2156,6 +2297,21 @@ class LinuxAIOHandler {
   each wakeup and that is why we use timed wait in io_getevents(). */
   void collect();
 
+#ifdef LINUX_IO_URING
+  /** Like collect(), but waits for the completion queue of the io_uring
+  of the segment. It also submits the requests that were left queued, so
+  that a batch that was never followed by
+  os_aio_simulated_wake_handler_threads() is not delayed by more than one
+  timeout. */
+  void collect_uring();
+#endif /* LINUX_IO_URING */
+
+  /** Marks the request of a slot as completed, with the result that the
+  kernel returned for it.
+  @param[in,out]        slot    The slot of the request
+  @param[in]    res     Number of bytes read or written, or -errno */
+  void mark_completed(Slot *slot, long res);
+
  private:
   /** Slot array */
   AIO *m_array;
@@ -2197,6 +2353,20 @@ dberr_t LinuxAIOHandler::resubmit(Slot *slot) {
 
   /* make sure that slot->offset fits in off_t */
   ut_ad(sizeof(off_t) >= sizeof(os_offset_t));
+
+#ifdef LINUX_IO_URING
+  if (srv_use_io_uring) {
+    if (!m_array->uring_prepare(slot)) {
+      errno = EAGAIN;
+      return (DB_IO_PARTIAL_FAILED);
+    }
+
+    m_array->uring_submit(m_segment);
+
+    return (DB_SUCCESS);
+  }
+#endif /* LINUX_IO_URING */
+
   struct iocb *iocb = &slot->control;
   if (slot->type.is_read()) {
     io_prep_pread(iocb, slot->file.m_file, slot->ptr, slot->len, slot->offset);
@@ -2301,6 +2471,13 @@ void LinuxAIOHandler::collect() {
   ut_ad(m_n_slots > 0);
   ut_ad(m_segment < m_array->get_n_segments());
 
+#ifdef LINUX_IO_URING
+  if (srv_use_io_uring) {
+    collect_uring();
+    return;
+  }
+#endif /* LINUX_IO_URING */
+
   /* Which io_context we are going to use. */
   io_context *io_ctx = m_array->io_ctx(m_segment);
 
@@ -2344,43 +2521,14 @@ void LinuxAIOHandler::collect() {
       /* We have not overstepped to next segment. */
       ut_a(slot->pos < end_pos);
 
-      /** If write of the page is compressed (compression is enabled, it is not
-      the first page, it is not a redolog, not a doublewrite buffer) and punch
-      holes are enabled, call AIOHandler::io_complete to check if hole punching
-      is needed.
-      Keep in sync with os_aio_windows_handler(). */
-      if (slot->offset > 0 && !slot->skip_punch_hole &&
-          slot->type.is_compression_enabled() && !slot->type.is_log() &&
-          slot->type.is_write() && slot->type.is_compressed() &&
-          slot->type.punch_hole() && !slot->type.is_dblwr()) {
-        slot->err = AIOHandler::io_complete(slot);
-      } else {
-        slot->err = DB_SUCCESS;
-      }
-
-      /* Mark this request as completed. The error handling
-      will be done in the calling function. */
-      m_array->acquire();
-
       /* events[i].res2 should always be ZERO */
       ut_ad(events[i].res2 == 0);
-      slot->io_already_done = true;
 
       /* Even though events[i].res is an unsigned number in libaio, it is
       used to return a negative value (negated errno value) to indicate
       error and a positive value to indicate number of bytes read or
       written. */
-
-      if (events[i].res > slot->len) {
-        /* failure */
-        slot->n_bytes = 0;
-        slot->ret = events[i].res;
-      } else {
-        /* success */
-        slot->n_bytes = events[i].res;
-        slot->ret = 0;
-      }
-      m_array->release();
+      mark_completed(slot, static_cast<long>(events[i].res));
     }
 
     if (srv_shutdown_state.load() == SRV_SHUTDOWN_EXIT_THREADS ||
@@ -2417,6 +2565,114 @@ void LinuxAIOHandler::collect() {
   }
 }
 
+void LinuxAIOHandler::mark_completed(Slot *slot, long res) {
+  /** If write of the page is compressed (compression is enabled, it is not
+  the first page, it is not a redolog, not a doublewrite buffer) and punch
+  holes are enabled, call AIOHandler::io_complete to check if hole punching
+  is needed.
+  Keep in sync with os_aio_windows_handler(). */
+  if (slot->offset > 0 && !slot->skip_punch_hole &&
+      slot->type.is_compression_enabled() && !slot->type.is_log() &&
+      slot->type.is_write() && slot->type.is_compressed() &&
+      slot->type.punch_hole() && !slot->type.is_dblwr()) {
+    slot->err = AIOHandler::io_complete(slot);
+  } else {
+    slot->err = DB_SUCCESS;
+  }
+
+  /* Mark this request as completed. The error handling
+  will be done in the calling function. */
+  m_array->acquire();
+
+  slot->io_already_done = true;
+
+  if (res < 0 || static_cast<ulint>(res) > slot->len) {
+    /* failure */
+    slot->n_bytes = 0;
+    slot->ret = static_cast<int>(res);
+  } else {
+    /* success */
+    slot->n_bytes = res;
+    slot->ret = 0;
+  }
+
+  m_array->release();
+}
+
+#ifdef LINUX_IO_URING
+void LinuxAIOHandler::collect_uring() {
+  io_uring *ring = m_array->io_ring(m_segment);
+
+  /* Starting point of the m_segment we will be working on. */
+  const ulint start_pos = m_segment * m_n_slots;
+
+  /* End point. */
+  const ulint end_pos = start_pos + m_n_slots;
+
+  for (;;) {
+    m_array->acquire();
+
+    if (m_array->has_unsubmitted(m_segment)) {
+      m_array->uring_submit(m_segment);
+    }
+
+    m_array->release();
+
+    /* Needs IORING_FEAT_EXT_ARG, see is_linux_io_uring_supported(); without
+    it liburing would take a submission queue entry for the timeout, and the
+    submission queue belongs to the threads that own m_array->m_mutex. */
+    __kernel_timespec timeout;
+
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = OS_AIO_REAP_TIMEOUT;
+
+    io_uring_cqe *cqe;
+
+    int ret = io_uring_wait_cqe_timeout(ring, &cqe, &timeout);
+
+    unsigned head;
+    unsigned n_completed = 0;
+
+    if (ret == 0) {
+      io_uring_for_each_cqe(ring, head, cqe) {
+        auto slot = reinterpret_cast<Slot *>(io_uring_cqe_get_data(cqe));
+
+        /* Some sanity checks. */
+        ut_a(slot != nullptr);
+        ut_a(slot->is_reserved);
+        ut_a(slot->pos >= start_pos);
+        ut_a(slot->pos < end_pos);
+
+        mark_completed(slot, cqe->res);
+
+        ++n_completed;
+      }
+
+      io_uring_cq_advance(ring, n_completed);
+    }
+
+    if (srv_shutdown_state.load() == SRV_SHUTDOWN_EXIT_THREADS ||
+        !buf_flush_page_cleaner_is_active() || n_completed > 0) {
+      break;
+    }
+
+    switch (ret) {
+      case 0:
+      case -ETIME:
+      case -EAGAIN:
+      case -EINTR:
+        /* Timed out or interrupted. Go back and check again. */
+        continue;
+    }
+
+    ib::fatal(UT_LOCATION_HERE, ER_IB_MSG_755)
+        << "Unexpected ret_code[" << ret << "] from io_uring_wait_cqe()!";
+
+    break;
+  }
+}
+#endif /* LINUX_IO_URING */
+
 /** Process a Linux AIO request
 @param[out]     m1              the messages passed with the
 @param[out]     m2              AIO request; note that in case the
@@ -2550,6 +2806,28 @@ bool AIO::linux_dispatch(Slot *slot) {
 
   io_ctx_index = (slot->pos * m_n_segments) / m_slots.size();
 
+#ifdef LINUX_IO_URING
+  if (srv_use_io_uring) {
+    acquire();
+
+    const bool success = uring_prepare(slot);
+
+    /* Requests that do not wake the handler threads are part of a batch
+    that ends with os_aio_simulated_wake_handler_threads(). */
+    if (success && slot->type.is_wake()) {
+      uring_submit(io_ctx_index);
+    }
+
+    release();
+
+    if (!success) {
+      errno = EAGAIN;
+    }
+
+    return (success);
+  }
+#endif /* LINUX_IO_URING */
+
   int ret = io_submit(m_aio_ctx[io_ctx_index], 1, &iocb);
 
   /* io_submit() returns number of successfully queued requests
@@ -2562,6 +2840,305 @@ bool AIO::linux_dispatch(Slot *slot) {
   return (ret == 1);
 }
 
+#ifdef LINUX_IO_URING
+int AIO::uring_find_fixed_buffer(const byte *ptr, ulint len) const {
+  ut_ad(is_mutex_owned());
+
+  /* The last buffer that starts at or before ptr. */
+  auto it = std::upper_bound(
+      m_fixed_buffers.begin(), m_fixed_buffers.end(), ptr,
+      [](const byte *p, const iovec &iov) { return p < iov.iov_base; });
+
+  if (it == m_fixed_buffers.begin()) {
+    return (-1);
+  }
+
+  --it;
+
+  const auto base = static_cast<const byte *>(it->iov_base);
+
+  if (ptr + len > base + it->iov_len) {
+    return (-1);
+  }
+
+  return (static_cast<int>(it - m_fixed_buffers.begin()));
+}
+
+bool AIO::uring_prepare(Slot *slot) {
+  ut_ad(is_mutex_owned());
+  ut_a(slot->is_reserved);
+
+  const ulint segment = (slot->pos * m_n_segments) / m_slots.size();
+  io_uring *ring = &m_rings[segment];
+
+  io_uring_sqe *sqe = io_uring_get_sqe(ring);
+
+  if (sqe == nullptr) {
+    /* Make room by submitting what is queued. There are as many entries
+    as slots in the segment, so this should not happen. */
+    uring_submit(segment);
+
+    sqe = io_uring_get_sqe(ring);
+
+    if (sqe == nullptr) {
+      return (false);
+    }
+  }
+
+  const int fixed = uring_find_fixed_buffer(slot->ptr, slot->len);
+  const auto len = static_cast<unsigned>(slot->len);
+
+  if (slot->type.is_read()) {
+    if (fixed >= 0) {
+      io_uring_prep_read_fixed(sqe, slot->file.m_file, slot->ptr, len,
+                               slot->offset, fixed);
+    } else {
+      io_uring_prep_read(sqe, slot->file.m_file, slot->ptr, len,
+                         slot->offset);
+    }
+  } else {
+    ut_a(slot->type.is_write());
+
+    if (fixed >= 0) {
+      io_uring_prep_write_fixed(sqe, slot->file.m_file, slot->ptr, len,
+                                slot->offset, fixed);
+    } else {
+      io_uring_prep_write(sqe, slot->file.m_file, slot->ptr, len,
+                          slot->offset);
+    }
+  }
+
+  io_uring_sqe_set_data(sqe, slot);
+
+  ++m_n_unsubmitted[segment];
+
+  return (true);
+}
+
+void AIO::uring_submit(ulint segment) {
+  ut_ad(is_mutex_owned());
+
+  int ret = io_uring_submit(&m_rings[segment]);
+
+  if (ret >= 0) {
+    m_n_unsubmitted[segment] = 0;
+    return;
+  }
+
+  switch (ret) {
+    case -EAGAIN:
+    case -EBUSY:
+    case -EINTR:
+      /* The requests stay in the submission queue, and are submitted by the
+      next call, at the latest by the i/o-handler thread of the segment. */
+      return;
+  }
+
+  ib::fatal(UT_LOCATION_HERE, ER_IB_MSG_755)
+      << "Unexpected ret_code[" << ret << "] from io_uring_submit()!";
+}
+
+void AIO::uring_submit_all() {
+  ut_ad(is_mutex_owned());
+
+  for (ulint i = 0; i < m_n_segments; ++i) {
+    if (m_n_unsubmitted[i] > 0) {
+      uring_submit(i);
+    }
+  }
+}
+
+void AIO::uring_submit_all_arrays() {
+  for (auto array : {s_ibuf, s_log, s_reads, s_writes}) {
+    if (array != nullptr) {
+      array->acquire();
+      array->uring_submit_all();
+      array->release();
+    }
+  }
+}
+
+bool AIO::register_fixed_buffers(const std::vector<iovec> &iovs) {
+  ut_ad(is_mutex_owned());
+  ut_ad(m_fixed_buffers.empty());
+
+  for (ulint i = 0; i < m_n_segments; ++i) {
+    int ret = io_uring_register_buffers(&m_rings[i], iovs.data(),
+                                        static_cast<unsigned>(iovs.size()));
+
+    if (ret < 0) {
+      ib::warn(ER_IB_MSG_761)
+          << "Could not register the buffer pool with io_uring, error["
+          << -ret << "]. Page i/o will not use fixed buffers. It may help"
+          << " to raise the memlock limit of the server.";
+
+      for (ulint j = 0; j < i; ++j) {
+        io_uring_unregister_buffers(&m_rings[j]);
+      }
+
+      return (false);
+    }
+  }
+
+  m_fixed_buffers = iovs;
+
+  return (true);
+}
+
+void AIO::unregister_fixed_buffers() {
+  ut_ad(is_mutex_owned());
+
+  if (m_fixed_buffers.empty()) {
+    return;
+  }
+
+  for (ulint i = 0; i < m_n_segments; ++i) {
+    io_uring_unregister_buffers(&m_rings[i]);
+  }
+
+  m_fixed_buffers.clear();
+}
+
+void AIO::uring_register_buffers(const os_aio_buffers_t &buffers) {
+  uring_unregister_buffers();
+
+  std::vector<iovec> iovs;
+
+  for (const auto &buffer : buffers) {
+    for (size_t offset = 0; offset < buffer.second;
+         offset += OS_AIO_URING_MAX_FIXED_BUFFER) {
+      iovec iov;
+
+      iov.iov_base = buffer.first + offset;
+      iov.iov_len =
+          std::min(buffer.second - offset, OS_AIO_URING_MAX_FIXED_BUFFER);
+
+      iovs.push_back(iov);
+    }
+  }
+
+  if (iovs.empty()) {
+    return;
+  }
+
+  if (iovs.size() > OS_AIO_URING_MAX_FIXED_BUFFERS) {
+    ib::warn(ER_IB_MSG_761)
+        << "The buffer pool has too many chunks to register them with"
+           " io_uring. Page i/o will not use fixed buffers.";
+    return;
+  }
+
+  std::sort(iovs.begin(), iovs.end(), [](const iovec &a, const iovec &b) {
+    return (std::less<void *>()(a.iov_base, b.iov_base));
+  });
+
+  /* Only the arrays that do page i/o. The log writes from its own
+  buffers. */
+  for (auto array : {s_ibuf, s_reads, s_writes}) {
+    if (array == nullptr) {
+      continue;
+    }
+
+    array->acquire();
+    const bool success = array->register_fixed_buffers(iovs);
+    array->release();
+
+    if (!success) {
+      uring_unregister_buffers();
+      return;
+    }
+  }
+}
+
+void AIO::uring_unregister_buffers() {
+  for (auto array : {s_ibuf, s_reads, s_writes}) {
+    if (array != nullptr) {
+      array->acquire();
+      array->unregister_fixed_buffers();
+      array->release();
+    }
+  }
+}
+
+bool AIO::is_linux_io_uring_supported() {
+  io_uring ring;
+
+  int ret = io_uring_queue_init(1, &ring, 0);
+
+  if (ret < 0) {
+    ib::warn(ER_IB_MSG_761) << "io_uring_queue_init() returned error["
+                            << -ret << "]";
+    return (false);
+  }
+
+  bool supported = true;
+
+  /* Waiting for completions with a timeout must not use the submission
+  queue, see LinuxAIOHandler::collect_uring(). That came in Linux 5.11,
+  after IORING_OP_READ and IORING_OP_WRITE. */
+  if (!(ring.features & IORING_FEAT_EXT_ARG)) {
+    ib::warn(ER_IB_MSG_761) << "io_uring of this kernel does not support"
+                               " waiting with a timeout (Linux 5.11).";
+    supported = false;
+  }
+
+  io_uring_queue_exit(&ring);
+
+  return (supported);
+}
+
+/** Initialise one io_uring per segment */
+dberr_t AIO::init_linux_io_uring() {
+  ut_a(m_rings == nullptr);
+
+  m_rings = static_cast<io_uring *>(ut::zalloc_withkey(
+      UT_NEW_THIS_FILE_PSI_KEY, m_n_segments * sizeof(*m_rings)));
+
+  if (m_rings == nullptr) {
+    return (DB_OUT_OF_MEMORY);
+  }
+
+  m_n_unsubmitted.assign(m_n_segments, 0);
+
+  const auto entries = static_cast<unsigned>(slots_per_segment());
+
+  for (ulint i = 0; i < m_n_segments; ++i) {
+    io_uring_params params;
+
+    memset(&params, 0x0, sizeof(params));
+
+    if (srv_io_uring_sqpoll) {
+      params.flags |= IORING_SETUP_SQPOLL;
+      params.sq_thread_idle = OS_AIO_URING_SQPOLL_IDLE;
+
+      /* One polling kernel thread for all rings, not one per i/o-handler
+      thread. */
+      if (s_sqpoll_fd >= 0) {
+        params.flags |= IORING_SETUP_ATTACH_WQ;
+        params.wq_fd = s_sqpoll_fd;
+      }
+    }
+
+    int ret = io_uring_queue_init_params(entries, &m_rings[i], &params);
+
+    if (ret < 0) {
+      ib::error(ER_IB_MSG_761) << "io_uring_queue_init() returned error["
+                               << -ret << "]";
+
+      /* Like init_linux_native_aio(), a failure here means that InnoDB will
+      not start, so we don't care about the rings created so far. */
+      return (DB_IO_ERROR);
+    }
+
+    if (srv_io_uring_sqpoll && s_sqpoll_fd < 0) {
+      s_sqpoll_fd = m_rings[i].ring_fd;
+    }
+  }
+
+  return (DB_SUCCESS);
+}
+#endif /* LINUX_IO_URING */
+
 /** Creates an io_context for native linux AIO.
 @param[in]      max_events      number of events
 @param[out]     io_ctx          io_ctx to initialize.
@@ -5915,6 +6492,35 @@ dberr_t os_file_punch_hole(os_file_t fh, os_offset_t off, os_offset_t len) {
 #endif /* _WIN32 */
 }
 
+bool os_file_has_atomic_writes(os_file_t fh [[maybe_unused]],
+                               ulint size [[maybe_unused]]) {
+  DBUG_EXECUTE_IF("dblwr_assume_atomic_writes", return (true););
+
+#if defined(UNIV_LINUX) && defined(STATX_WRITE_ATOMIC)
+  /* A buffered write can reach the device in pieces, whatever the
+  device guarantees. */
+  if (srv_unix_file_flush_method != SRV_UNIX_O_DIRECT &&
+      srv_unix_file_flush_method != SRV_UNIX_O_DIRECT_NO_FSYNC) {
+    return (false);
+  }
+
+  struct statx stx;
+
+  if (statx(fh, "", AT_EMPTY_PATH, STATX_WRITE_ATOMIC, &stx) != 0 ||
+      !(stx.stx_mask & STATX_WRITE_ATOMIC) ||
+      !(stx.stx_attributes & STATX_ATTR_WRITE_ATOMIC)) {
+    return (false);
+  }
+
+  /* The atomic write units are powers of two, so a write of a power of
+  two size between them that is aligned to its size is atomic. */
+  return (ut_is_2pow(size) && stx.stx_atomic_write_unit_min <= size &&
+          stx.stx_atomic_write_unit_max >= size);
+#else
+  return (false);
+#endif /* UNIV_LINUX && STATX_WRITE_ATOMIC */
+}
+
 bool os_is_sparse_file_supported(pfs_os_file_t fh) {
   /* In this debugging mode, we act as if punch hole is supported,
   then we skip any calls to actually punch a hole.  In this way,
@@ -6095,6 +6701,10 @@ AIO::AIO(latch_id_t id, ulint n, ulint segments)
       ,
       m_aio_ctx(),
       m_events(m_slots.size())
+#ifdef LINUX_IO_URING
+      ,
+      m_rings()
+#endif /* LINUX_IO_URING */
 #elif defined(_WIN32)
       ,
       m_handles()
@@ -6195,7 +6805,12 @@ dberr_t AIO::init() {
 
   if (srv_use_native_aio) {
 #ifdef LINUX_NATIVE_AIO
+#ifdef LINUX_IO_URING
+    dberr_t err =
+        srv_use_io_uring ? init_linux_io_uring() : init_linux_native_aio();
+#else
     dberr_t err = init_linux_native_aio();
+#endif /* LINUX_IO_URING */
 
     if (err != DB_SUCCESS) {
       return (err);
@@ -6261,13 +6876,41 @@ AIO::~AIO() {
   }
 #endif /* LINUX_NATIVE_AIO */
 
+#ifdef LINUX_IO_URING
+  if (m_rings != nullptr) {
+    /* The rings that share the polling thread of the first one must go
+    before it. */
+    for (ulint i = m_n_segments; i-- > 0;) {
+      if (m_rings[i].ring_fd == s_sqpoll_fd) {
+        s_sqpoll_fd = -1;
+      }
+
+      io_uring_queue_exit(&m_rings[i]);
+    }
+
+    ut::free(m_rings);
+  }
+#endif /* LINUX_IO_URING */
+
   m_slots.clear();
 }
 
 bool AIO::start(ulint n_per_seg, ulint n_readers, ulint n_writers) {
+#ifdef LINUX_IO_URING
+  if (!srv_use_native_aio) {
+    srv_use_io_uring = false;
+  } else if (srv_use_io_uring && !is_linux_io_uring_supported()) {
+    ib::warn(ER_IB_MSG_829) << "Linux io_uring disabled, using libaio.";
+
+    srv_use_io_uring = false;
+  }
+#endif /* LINUX_IO_URING */
+
 #if defined(LINUX_NATIVE_AIO)
-  /* Check if native aio is supported on this system and tmpfs */
-  if (srv_use_native_aio && !is_linux_native_aio_supported()) {
+  /* Check if native aio is supported on this system and tmpfs. With
+  io_uring, libaio is not used. */
+  if (srv_use_native_aio && !srv_use_io_uring &&
+      !is_linux_native_aio_supported()) {
     ib::warn(ER_IB_MSG_829) << "Linux Native AIO disabled.";
 
     srv_use_native_aio = false;
@@ -6589,6 +7232,22 @@ void os_aio_wait_until_no_pending_writes() {
   AIO::wait_until_no_pending_writes();
 }
 
+void os_aio_register_buffers(const os_aio_buffers_t &buffers [[maybe_unused]]) {
+#ifdef LINUX_IO_URING
+  if (srv_use_io_uring && srv_io_uring_fixed_buffers) {
+    AIO::uring_register_buffers(buffers);
+  }
+#endif /* LINUX_IO_URING */
+}
+
+void os_aio_unregister_buffers() {
+#ifdef LINUX_IO_URING
+  if (srv_use_io_uring && srv_io_uring_fixed_buffers) {
+    AIO::uring_unregister_buffers();
+  }
+#endif /* LINUX_IO_URING */
+}
+
 /** Calculates segment number for a slot.
 @param[in]      array           AIO wait array
 @param[in]      slot            slot in this array
@@ -6645,9 +7304,10 @@ Slot *AIO::reserve_slot(IORequest &type, fil_node_t *m1, void *m2,
 
     release();
 
-    if (!srv_use_native_aio) {
+    if (!srv_use_native_aio || srv_use_io_uring) {
       /* If the handler threads are suspended,
-      wake them so that we get more slots */
+      wake them so that we get more slots. With io_uring, the
+      requests that fill the array may not have been submitted. */
 
       os_aio_simulated_wake_handler_threads();
     }
@@ -6923,6 +7583,15 @@ void AIO::wake_simulated_handler_thread(ulint global_segment, ulint segment) {
 
 /** Wakes up simulated aio i/o-handler threads if they have something to do. */
 void os_aio_simulated_wake_handler_threads() {
+#ifdef LINUX_IO_URING
+  if (srv_use_io_uring) {
+    /* Submit the batch that was posted with IORequest::DO_NOT_WAKE. */
+    AIO::uring_submit_all_arrays();
+
+    return;
+  }
+#endif /* LINUX_IO_URING */
+
   if (srv_use_native_aio) {
     /* We do not use simulated aio: do nothing */
 
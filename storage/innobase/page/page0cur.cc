@@ -489,6 +489,19 @@ void page_cur_search_with_match(const buf_block_t *block,
     slot = page_dir_get_nth_slot(page, mid);
     mid_rec = page_dir_slot_get_rec(slot);
 
+    /* The directory slots are next to each other at the end of the
+    page, but the records they own are spread over it. Prefetch the
+    records of both possible next middle slots, so that the cache miss
+    on the next record overlaps with the comparison of this one. */
+    if (mid - low > 1) {
+      UNIV_PREFETCH_R(
+          page_dir_slot_get_rec(page_dir_get_nth_slot(page, (low + mid) / 2)));
+    }
+    if (up - mid > 1) {
+      UNIV_PREFETCH_R(
+          page_dir_slot_get_rec(page_dir_get_nth_slot(page, (mid + up) / 2)));
+    }
+
     cur_matched_fields = std::min(low_matched_fields, up_matched_fields);
 
     auto offsets = get_mid_rec_offsets();
@@ -33,6 +33,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
 #include "read0read.h"
 #include "clone0clone.h"
 
+#include "srv0mon.h"
 #include "srv0srv.h"
 #include "trx0sys.h"
 
@@ -316,7 +317,8 @@ ReadView::ReadView()
       m_up_limit_id(),
       m_creator_trx_id(),
       m_ids(),
-      m_low_limit_no() {
+      m_low_limit_no(),
+      m_rw_trx_ids_version() {
   ut_d(::memset(&m_view_list, 0x0, sizeof(m_view_list)));
   ut_d(m_view_low_limit_no = 0);
 }
@@ -454,6 +456,8 @@ void ReadView::prepare(trx_id_t id) {
 
   ut_a(m_low_limit_no <= m_low_limit_id);
 
+  m_rw_trx_ids_version = trx_sys->rw_trx_ids_version.load();
+
   if (!trx_sys->rw_trx_ids.empty()) {
     copy_trx_ids(trx_sys->rw_trx_ids);
   } else {
@@ -537,18 +541,24 @@ void MVCC::view_open(ReadView *&view, trx_t *trx) {
 
     ut_ad(view->m_closed);
 
-    /* NOTE: This can be optimised further, for now we only
-    reuse the view if there are no active RW transactions.
+    /* The view still matches rw_trx_ids if no transaction id
+    has been added to it, which would have advanced next_trx_id_or_no,
+    and none has been removed from it. A transaction which commits
+    without a transaction number (e.g. it only inserted) only shows
+    in rw_trx_ids_version.
 
     There is an inherent race here between purge and this
     thread. Purge will skip views that are marked as closed.
     Therefore we must set the low limit id after we reset the
     closed status after the check. */
 
-    if (trx_is_autocommit_non_locking(trx) && view->empty()) {
+    if (trx_is_autocommit_non_locking(trx)) {
       view->m_closed = false;
 
-      if (view->m_low_limit_id == trx_sys_get_next_trx_id_or_no()) {
+      if (view->m_low_limit_id == trx_sys_get_next_trx_id_or_no() &&
+          view->m_rw_trx_ids_version ==
+              trx_sys->rw_trx_ids_version.load()) {
+        MONITOR_INC(MONITOR_TRX_VIEW_REUSED);
         return;
       } else {
         view->m_closed = true;
@@ -635,6 +645,8 @@ void ReadView::copy_prepare(const ReadView &other) {
 
   m_low_limit_no = other.m_low_limit_no;
 
+  m_rw_trx_ids_version = other.m_rw_trx_ids_version;
+
   ut_d(m_view_low_limit_no = other.m_view_low_limit_no);
 
   m_low_limit_id = other.m_low_limit_id;
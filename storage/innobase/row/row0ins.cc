@@ -31,6 +31,7 @@ this program; if not, write to the Free Software Foundation, Inc.,
  *******************************************************/
 
 #include <sys/types.h>
+#include <algorithm>
 
 #include "btr0btr.h"
 #include "btr0cur.h"
@@ -104,6 +105,8 @@ ins_node_t *ins_node_create(
 
   node->ins_multi_val_pos = 0;
 
+  node->bulk = nullptr;
+
   return (node);
 }
 
@@ -3432,6 +3435,11 @@ dberr_t row_ins_index_entry_set_vals(const dict_index_t *index, dtuple_t *entry,
 
   ut_ad(dtuple_check_typed(node->entry));
 
+  if (node->bulk != nullptr && node->bulk->is_buffered(node->index)) {
+    node->bulk->add(node->index, node->entry, thr_get_trx(thr)->undo_no);
+    return DB_SUCCESS;
+  }
+
   err = row_ins_index_entry(node->index, node->entry, node->ins_multi_val_pos,
                             thr);
 
@@ -3440,6 +3448,168 @@ dberr_t row_ins_index_entry_set_vals(const dict_index_t *index, dtuple_t *entry,
   return err;
 }
 
+/** Check if an index has no records.
+@param[in]  index     index
+@return true if the root page of the index is an empty leaf */
+static bool row_ins_index_is_empty(const dict_index_t *index) {
+  mtr_t mtr;
+
+  mtr_start(&mtr);
+
+  const page_t *root = btr_root_get(index, &mtr);
+  const bool empty = page_is_leaf(root) && page_get_n_recs(root) == 0;
+
+  mtr_commit(&mtr);
+
+  return empty;
+}
+
+Row_ins_bulk::Row_ins_bulk(dict_table_t *table, size_t max_size)
+    : m_heap(mem_heap_create(1024, UT_LOCATION_HERE)), m_max_size(max_size) {
+  for (auto index : table->indexes) {
+    if (index->is_clustered() || dict_index_is_unique(index) ||
+        dict_index_is_spatial(index) || index->is_multi_value() ||
+        dict_index_is_online_ddl(index) || index->is_corrupted()) {
+      continue;
+    }
+
+    m_indexes.push_back({index, Entries{}, 0, false});
+  }
+}
+
+Row_ins_bulk::~Row_ins_bulk() { mem_heap_free(m_heap); }
+
+bool Row_ins_bulk::can_buffer(dict_table_t *table) {
+  if (table->is_temporary() || !table->foreign_set.empty() ||
+      !table->referenced_set.empty() || dict_table_has_fts_index(table)) {
+    return false;
+  }
+
+  bool has_buffered_index = false;
+
+  for (auto index : table->indexes) {
+    if (!index->is_clustered() && !dict_index_is_unique(index) &&
+        !dict_index_is_spatial(index) && !index->is_multi_value()) {
+      has_buffered_index = true;
+    }
+  }
+
+  return has_buffered_index && !table->first_index()->is_corrupted() &&
+         row_ins_index_is_empty(table->first_index());
+}
+
+bool Row_ins_bulk::is_buffered(const dict_index_t *index) const {
+  for (const auto &buffered : m_indexes) {
+    if (buffered.m_index == index) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void Row_ins_bulk::add(const dict_index_t *index, const dtuple_t *entry,
+                       undo_no_t undo_no) {
+  dtuple_t *tuple = dtuple_copy(entry, m_heap);
+
+  for (ulint i = 0; i < dtuple_get_n_fields(tuple); ++i) {
+    dfield_dup(dtuple_get_nth_field(tuple, i), m_heap);
+  }
+
+  for (auto &buffered : m_indexes) {
+    if (buffered.m_index == index) {
+      ut_ad(!buffered.m_sorted);
+      buffered.m_entries.push_back({tuple, undo_no});
+      return;
+    }
+  }
+
+  ut_error;
+}
+
+void Row_ins_bulk::rollback(undo_no_t undo_no) {
+  for (auto &buffered : m_indexes) {
+    ut_ad(!buffered.m_sorted);
+
+    auto &entries = buffered.m_entries;
+
+    /* Entries are in insert order, so the rolled back ones are last. */
+    while (!entries.empty() && entries.back().m_undo_no > undo_no) {
+      entries.pop_back();
+    }
+  }
+}
+
+void Row_ins_bulk::clear() {
+  for (auto &buffered : m_indexes) {
+    buffered.m_entries.clear();
+    buffered.m_n_inserted = 0;
+    buffered.m_sorted = false;
+  }
+
+  mem_heap_empty(m_heap);
+}
+
+bool Row_ins_bulk::is_full() const {
+  return mem_heap_get_size(m_heap) >= m_max_size;
+}
+
+bool Row_ins_bulk::is_empty() const {
+  for (const auto &buffered : m_indexes) {
+    if (!buffered.m_entries.empty()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+dberr_t Row_ins_bulk::flush(que_thr_t *thr) {
+  for (auto &buffered : m_indexes) {
+    const dict_index_t *index = buffered.m_index;
+    auto &entries = buffered.m_entries;
+
+    if (!buffered.m_sorted) {
+      const ulint n_fields = dict_index_get_n_fields(index);
+
+      std::sort(entries.begin(), entries.end(),
+                [index, n_fields](const Entry &lhs, const Entry &rhs) {
+                  for (ulint i = 0; i < n_fields; ++i) {
+                    const int cmp = cmp_dfield_dfield(
+                        dtuple_get_nth_field(lhs.m_tuple, i),
+                        dtuple_get_nth_field(rhs.m_tuple, i),
+                        index->get_field(i)->is_ascending);
+
+                    if (cmp != 0) {
+                      return cmp < 0;
+                    }
+                  }
+
+                  return false;
+                });
+
+      buffered.m_sorted = true;
+    }
+
+    while (buffered.m_n_inserted < entries.size()) {
+      const dberr_t err =
+          row_ins_sec_index_entry(buffered.m_index,
+                                  entries[buffered.m_n_inserted].m_tuple, thr,
+                                  false);
+
+      if (err != DB_SUCCESS) {
+        return err;
+      }
+
+      ++buffered.m_n_inserted;
+    }
+  }
+
+  clear();
+
+  return DB_SUCCESS;
+}
+
 /** Allocates a row id for row and inits the node->index field. */
 static inline void row_ins_alloc_row_id_step(
     ins_node_t *node) /*!< in: row insert node */
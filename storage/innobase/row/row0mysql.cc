@@ -922,6 +922,7 @@ row_prebuilt_t *row_create_prebuilt(
 
   prebuilt->m_no_prefetch = false;
   prebuilt->m_read_virtual_key = false;
+  prebuilt->m_sorted_lookups = false;
 
   return prebuilt;
 }
@@ -947,6 +948,10 @@ void row_prebuilt_free(row_prebuilt_t *prebuilt, bool dict_locked) {
 
   ut::free(prebuilt->mysql_template);
 
+  ut::delete_(prebuilt->idx_cond_filter);
+
+  row_insert_bulk_end(prebuilt, false);
+
   if (prebuilt->ins_graph) {
     que_graph_free_recursive(prebuilt->ins_graph);
   }
@@ -1501,6 +1506,69 @@ INSERT graph.
 @param[in]      mysql_rec       row in the MySQL format
 @param[in,out]  prebuilt        prebuilt struct in MySQL handle
 @return error code or DB_SUCCESS */
+/** Insert the secondary index entries buffered by a bulk insert.
+@param[in,out]  prebuilt        prebuilt struct in MySQL handle
+@return error code or DB_SUCCESS */
+static dberr_t row_insert_bulk_flush(row_prebuilt_t *prebuilt) {
+  Row_ins_bulk *bulk = prebuilt->ins_bulk;
+  trx_t *trx = prebuilt->trx;
+
+  if (bulk->is_empty()) {
+    return DB_SUCCESS;
+  }
+
+  trx->op_info = "inserting";
+
+  /* Each buffered entry belongs to a row that was inserted by the
+  insert graph, so it exists. */
+  ut_ad(prebuilt->ins_graph != nullptr);
+
+  que_thr_t *thr = que_fork_get_first_thr(prebuilt->ins_graph);
+
+  /* Inserting secondary index entries writes no undo log, so this
+  savepoint only makes a lock wait timeout roll back nothing. */
+  trx_savept_t savept = trx_savept_take(trx);
+
+  que_thr_move_to_run_state_for_mysql(thr, trx);
+
+  for (;;) {
+    thr->run_node = prebuilt->ins_node;
+    thr->prev_node = prebuilt->ins_node;
+
+    dberr_t err = bulk->flush(thr);
+
+    if (err == DB_SUCCESS) {
+      break;
+    }
+
+    trx->error_state = err;
+
+    que_thr_stop_for_mysql(thr);
+
+    thr->lock_state = QUE_THR_LOCK_ROW;
+
+    auto was_lock_wait = row_mysql_handle_errors(&err, trx, thr, &savept);
+
+    thr->lock_state = QUE_THR_LOCK_NOLOCK;
+
+    if (!was_lock_wait) {
+      /* The statement fails, and rolling it back removes the rows
+      whose entries are not inserted. */
+      bulk->clear();
+
+      trx->op_info = "";
+
+      return err;
+    }
+  }
+
+  que_thr_stop_for_mysql_no_error(thr, trx);
+
+  trx->op_info = "";
+
+  return DB_SUCCESS;
+}
+
 static dberr_t row_insert_for_mysql_using_ins_graph(const byte *mysql_rec,
                                                     row_prebuilt_t *prebuilt) {
   trx_savept_t savept;
@@ -1562,6 +1630,7 @@ static dberr_t row_insert_for_mysql_using_ins_graph(const byte *mysql_rec,
 
   row_get_prebuilt_insert_row(prebuilt);
   node = prebuilt->ins_node;
+  node->bulk = prebuilt->ins_bulk;
 
   row_mysql_convert_row_to_innobase(node->row, prebuilt, mysql_rec, &temp_heap);
 
@@ -1605,6 +1674,11 @@ run_again:
       goto run_again;
     }
 
+    if (prebuilt->ins_bulk != nullptr) {
+      /* Forget the entries of the rows, if any, that were rolled back. */
+      prebuilt->ins_bulk->rollback(trx->undo_no);
+    }
+
     trx->op_info = "";
 
     if (temp_heap != nullptr) {
@@ -1698,6 +1772,10 @@ run_again:
     mem_heap_free(temp_heap);
   }
 
+  if (prebuilt->ins_bulk != nullptr && prebuilt->ins_bulk->is_full()) {
+    err = row_insert_bulk_flush(prebuilt);
+  }
+
   return (err);
 }
 
@@ -1716,6 +1794,39 @@ dberr_t row_insert_for_mysql(const byte *mysql_rec, row_prebuilt_t *prebuilt) {
   }
 }
 
+void row_insert_bulk_start(row_prebuilt_t *prebuilt) {
+  ut_a(prebuilt->ins_bulk == nullptr);
+
+  if (prebuilt->table->is_intrinsic() || prebuilt->allow_duplicates() ||
+      !Row_ins_bulk::can_buffer(prebuilt->table)) {
+    return;
+  }
+
+  prebuilt->ins_bulk = ut::new_withkey<Row_ins_bulk>(
+      UT_NEW_THIS_FILE_PSI_KEY, prebuilt->table, srv_sort_buf_size);
+}
+
+dberr_t row_insert_bulk_end(row_prebuilt_t *prebuilt, bool flush) {
+  if (prebuilt->ins_bulk == nullptr) {
+    return DB_SUCCESS;
+  }
+
+  dberr_t err = DB_SUCCESS;
+
+  if (flush) {
+    err = row_insert_bulk_flush(prebuilt);
+  }
+
+  ut::delete_(prebuilt->ins_bulk);
+  prebuilt->ins_bulk = nullptr;
+
+  if (prebuilt->ins_node != nullptr) {
+    prebuilt->ins_node->bulk = nullptr;
+  }
+
+  return err;
+}
+
 void row_prebuild_sel_graph(row_prebuilt_t *prebuilt) {
   sel_node_t *node;
 
@@ -41,6 +41,12 @@ Parallel_reader_adapter::Parallel_reader_adapter(size_t max_threads,
   m_batch_size = ADAPTER_SEND_BUFFER_SIZE / rowlen;
 }
 
+Parallel_reader_adapter::~Parallel_reader_adapter() {
+  if (m_heap != nullptr) {
+    mem_heap_free(m_heap);
+  }
+}
+
 dberr_t Parallel_reader_adapter::add_scan(trx_t *trx,
                                           const Parallel_reader::Config &config,
                                           Parallel_reader::F &&f) {
@@ -97,6 +103,19 @@ void Parallel_reader_adapter::set(row_prebuilt_t *prebuilt) {
   m_prebuilt = prebuilt;
 }
 
+void Parallel_reader_adapter::set_exclusive_start(const dtuple_t *key) {
+  ut_a(m_exclusive_start == nullptr);
+
+  m_heap = mem_heap_create(dtuple_get_n_fields(key) * sizeof(dfield_t) + 256,
+                           UT_LOCATION_HERE);
+
+  m_exclusive_start = dtuple_copy(key, m_heap);
+
+  for (size_t i = 0; i < dtuple_get_n_fields(m_exclusive_start); ++i) {
+    dfield_dup(&m_exclusive_start->fields[i], m_heap);
+  }
+}
+
 dberr_t Parallel_reader_adapter::run(void **thread_ctxs, Init_fn init_fn,
                                      Load_fn load_fn, End_fn end_fn) {
   m_end_fn = end_fn;
@@ -206,6 +225,16 @@ dberr_t Parallel_reader_adapter::process_rows(
   offsets = rec_get_offsets(reader_ctx->m_rec, reader_ctx->index(), offsets,
                             ULINT_UNDEFINED, UT_LOCATION_HERE, &heap);
 
+  if (m_exclusive_start != nullptr &&
+      m_exclusive_start->compare(reader_ctx->m_rec, reader_ctx->index(),
+                                 offsets) == 0) {
+    if (heap != nullptr) {
+      mem_heap_free(heap);
+    }
+
+    return DB_SUCCESS;
+  }
+
   const auto next_rec = ctx->m_n_read % m_batch_size;
 
   const auto buffer_loc = &ctx->m_buffer[0] + next_rec * m_mysql_row.m_max_len;
@@ -65,6 +65,7 @@ std::string Parallel_reader::Scan_range::to_string() const {
   os << ", m_end: ";
   if (m_end != nullptr) {
     m_end->print(os);
+    os << (m_end_inclusive ? " (inclusive)" : "");
   } else {
     os << "null";
   }
@@ -152,6 +153,7 @@ dberr_t Parallel_reader::Ctx::split() {
 
   /* Setup the sub-range. */
   Scan_range scan_range(m_range.first->m_tuple, m_range.second->m_tuple);
+  scan_range.m_end_inclusive = m_range.second->m_tuple_inclusive;
 
   /* S lock so that the tree structure doesn't change while we are
   figuring out the sub-trees to scan. */
@@ -733,7 +735,7 @@ dberr_t Parallel_reader::Ctx::traverse_recs(PCursor *pcursor, mtr_t *mtr) {
 
       /* Note: The range creation doesn't use MVCC. Therefore it's possible
       that the range boundary entry could have been deleted. */
-      if (ret <= 0) {
+      if (ret < 0 || (ret == 0 && !m_range.second->m_tuple_inclusive)) {
         break;
       }
     }
@@ -1100,8 +1102,12 @@ dberr_t Parallel_reader::Scan_ctx::create_ranges(const Scan_range &scan_range,
 
     const auto end = scan_range.m_end;
 
-    if (end != nullptr && end->compare(rec, index, offsets) <= 0) {
-      break;
+    if (end != nullptr) {
+      const auto cmp = end->compare(rec, index, offsets);
+
+      if (cmp < 0 || (cmp == 0 && !scan_range.m_end_inclusive)) {
+        break;
+      }
     }
 
     page_cur_t level_page_cursor;
@@ -1203,6 +1209,7 @@ dberr_t Parallel_reader::Scan_ctx::partition(
                                    UT_LOCATION_HERE);
 
     iter->m_tuple = dtuple_copy(scan_range.m_end, iter->m_heap);
+    iter->m_tuple_inclusive = scan_range.m_end_inclusive;
 
     /* Do a deep copy. */
     for (size_t i = 0; i < dtuple_get_n_fields(iter->m_tuple); ++i) {
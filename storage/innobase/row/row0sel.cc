@@ -3726,6 +3726,68 @@ static ulint row_sel_try_search_shortcut_for_mysql(
   return (SEL_FOUND);
 }
 
+/** Check the part of a pushed-down index condition that can be evaluated on
+the InnoDB record.
+@param[in]      filter          comparisons of fields with constants
+@param[in]      index           index of the record
+@param[in]      rec             InnoDB record
+@param[in]      offsets         rec_get_offsets()
+@return false if the record cannot satisfy the index condition */
+static bool row_search_idx_cond_filter(const row_icp_filter_t *filter,
+                                       const dict_index_t *index,
+                                       const rec_t *rec,
+                                       const ulint *offsets) {
+  for (const auto &pred : filter->preds) {
+    /* Leave the comparison to the server. */
+    if (rec_offs_nth_extern(index, offsets, pred.field_no)) {
+      continue;
+    }
+
+    ulint len;
+    const byte *data =
+        rec_get_nth_field_instant(rec, offsets, pred.field_no, index, &len);
+
+    /* A comparison with NULL is never true, and neither is the
+    conjunction it is a part of. */
+    if (len == UNIV_SQL_NULL) {
+      return false;
+    }
+
+    const auto cmp = [&](const row_icp_pred_t::value_t &value) {
+      return cmp_data_data(pred.mtype, pred.prtype, true, data, len,
+                           value.data(), value.size());
+    };
+
+    if (!pred.in_list.empty()) {
+      const auto it = std::lower_bound(
+          pred.in_list.begin(), pred.in_list.end(), 0,
+          [&](const row_icp_pred_t::value_t &value, int) {
+            return cmp(value) > 0;
+          });
+      if (it == pred.in_list.end() || cmp(*it) != 0) {
+        return false;
+      }
+      continue;
+    }
+
+    if (pred.has_low) {
+      const int ret = cmp(pred.low);
+      if (ret < 0 || (ret == 0 && !pred.low_inclusive)) {
+        return false;
+      }
+    }
+
+    if (pred.has_high) {
+      const int ret = cmp(pred.high);
+      if (ret > 0 || (ret == 0 && !pred.high_inclusive)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 /** Check a pushed-down index condition.
  @return ICP_NO_MATCH, ICP_MATCH, or ICP_OUT_OF_RANGE */
 static ICP_RESULT row_search_idx_cond_check(
@@ -3749,6 +3811,19 @@ static ICP_RESULT row_search_idx_cond_check(
 
   MONITOR_INC(MONITOR_ICP_ATTEMPTS);
 
+  /* Reject the records that fail the comparisons InnoDB can evaluate by
+  itself. Without an end of the range to check, there is no need to convert
+  them to the MySQL format at all. */
+  const bool rejected =
+      prebuilt->idx_cond_filter != nullptr &&
+      !row_search_idx_cond_filter(prebuilt->idx_cond_filter, prebuilt->index,
+                                  rec, offsets);
+
+  if (rejected && !innobase_index_has_end_range(prebuilt->m_mysql_handler)) {
+    MONITOR_INC(MONITOR_ICP_NO_MATCH);
+    return (ICP_NO_MATCH);
+  }
+
   /* Convert to MySQL format those fields that are needed for
   evaluating the index condition. */
 
@@ -3778,7 +3853,7 @@ static ICP_RESULT row_search_idx_cond_check(
   index, if the case of the column has been updated in
   the past, or a record has been deleted and a record
   inserted in a different case. */
-  result = innobase_index_cond(prebuilt->m_mysql_handler);
+  result = innobase_index_cond(prebuilt->m_mysql_handler, rejected);
   switch (result) {
     case ICP_MATCH:
       /* Convert the remaining fields to MySQL format.
@@ -4853,8 +4928,13 @@ dberr_t row_search_mvcc(byte *buf, page_cur_mode_t mode,
       }
     }
 
-    pcur->open_no_init(index, search_tuple, mode, BTR_SEARCH_LEAF, 0, &mtr,
-                       UT_LOCATION_HERE);
+    if (!prebuilt->m_sorted_lookups || !unique_search ||
+        !index->is_clustered() ||
+        !pcur->open_on_stored_page(index, search_tuple, mode, BTR_SEARCH_LEAF,
+                                   &mtr, UT_LOCATION_HERE)) {
+      pcur->open_no_init(index, search_tuple, mode, BTR_SEARCH_LEAF, 0, &mtr,
+                         UT_LOCATION_HERE);
+    }
 
     pcur->m_trx_if_known = trx;
 
@@ -5690,14 +5770,15 @@ rec_loop:
   store the pcur position, because any fetch next or prev will anyway
   return 'end of file'. Exceptions are locking reads and the MySQL
   HANDLER command where the user can move the cursor with PREV or NEXT
-  even after a unique search. */
+  even after a unique search, and sorted lookups, where the next search
+  starts from the stored position. */
 
   err = DB_SUCCESS;
 
 idx_cond_failed:
   if (!unique_search || !index->is_clustered() || direction != 0 ||
       prebuilt->select_lock_type != LOCK_NONE || prebuilt->used_in_HANDLER ||
-      prebuilt->innodb_api) {
+      prebuilt->innodb_api || prebuilt->m_sorted_lookups) {
     /* Inside an update always store the cursor position */
 
     if (!spatial_search) {
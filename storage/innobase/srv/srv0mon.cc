@@ -132,6 +132,17 @@ static monitor_info_t innodb_counter_info[] = {
      "Number of times a wait-for graph was scanned in search for deadlocks",
      MONITOR_DEFAULT_ON, MONITOR_DEFAULT_START, MONITOR_DEADLOCK_ROUNDS},
 
+    {"lock_deadlock_candidates", "lock",
+     "Number of new or changed waits which possibly closed a cycle in the"
+     " wait-for graph",
+     MONITOR_DEFAULT_ON, MONITOR_DEFAULT_START, MONITOR_DEADLOCK_CANDIDATES},
+
+    {"lock_deadlock_detection_time", "lock",
+     "Time from when a wait closed a deadlock cycle until the deadlock was"
+     " resolved, in microseconds",
+     MONITOR_DEFAULT_ON, MONITOR_DEFAULT_START,
+     MONITOR_DEADLOCK_DETECTION_TIME},
+
     {"lock_threads_waiting", "lock",
      "Number of query threads sleeping waiting for a lock",
      static_cast<monitor_type_t>(MONITOR_DEFAULT_ON | MONITOR_DISPLAY_CURRENT),
@@ -151,6 +162,11 @@ static monitor_info_t innodb_counter_info[] = {
     {"lock_rec_lock_requests", "lock", "Number of record locks requested",
      MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_NUM_RECLOCK_REQ},
 
+    {"lock_rec_lock_implicit", "lock",
+     "Number of record locks requested by a transaction which were covered by"
+     " its implicit lock",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_NUM_RECLOCK_IMPLICIT},
+
     {"lock_rec_release_attempts", "lock",
      "Number of times we attempted to release record locks", MONITOR_DEFAULT_ON,
      MONITOR_DEFAULT_START, MONITOR_RECLOCK_RELEASE_ATTEMPTS},
@@ -427,6 +443,45 @@ static monitor_info_t innodb_counter_info[] = {
      "Total sleep waits in LRU get free.", MONITOR_NONE, MONITOR_DEFAULT_START,
      MONITOR_LRU_GET_FREE_WAITS},
 
+    {"buffer_LRU_reread_old", "buffer",
+     "Pages read back soon after they were evicted without having been made"
+     " young",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_LRU_REREAD_OLD},
+
+    {"buffer_LRU_reread_young", "buffer",
+     "Pages read back soon after they were evicted after having been made"
+     " young",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_LRU_REREAD_YOUNG},
+
+    {"buffer_ctier_hits", "buffer",
+     "Pages read from the compressed tier instead of the file", MONITOR_NONE,
+     MONITOR_DEFAULT_START, MONITOR_CTIER_HITS},
+
+    {"buffer_ctier_inserted", "buffer",
+     "Evicted pages stored in the compressed tier", MONITOR_NONE,
+     MONITOR_DEFAULT_START, MONITOR_CTIER_INSERTED},
+
+    {"buffer_ctier_rejected", "buffer",
+     "Evicted pages not stored in the compressed tier because they did not"
+     " compress to half a page",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_CTIER_REJECTED},
+
+    {"buffer_ctier_evicted", "buffer",
+     "Pages evicted from the compressed tier to make room", MONITOR_NONE,
+     MONITOR_DEFAULT_START, MONITOR_CTIER_EVICTED},
+
+    {"buffer_ctier_invalidated", "buffer",
+     "Pages in the compressed tier found outdated by a truncation of their"
+     " tablespace",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_CTIER_INVALIDATED},
+
+    {"buffer_ctier_pages", "buffer", "Pages stored in the compressed tier",
+     MONITOR_DISPLAY_CURRENT, MONITOR_DEFAULT_START, MONITOR_CTIER_PAGES},
+
+    {"buffer_prefetch_hint_reads", "buffer",
+     "Pages read asynchronously on prefetch hints from the SQL layer",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_PREFETCH_HINT_READS},
+
     {"buffer_flush_avg_page_rate", "buffer",
      "Average number of pages at which flushing is happening", MONITOR_NONE,
      MONITOR_DEFAULT_START, MONITOR_FLUSH_AVG_PAGE_RATE},
@@ -442,6 +497,30 @@ static monitor_info_t innodb_counter_info[] = {
      "Percent of IO capacity used to avoid reusable redo space limit",
      MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_FLUSH_PCT_FOR_LSN},
 
+    {"buffer_flush_model_lsn_rate", "buffer",
+     "Redo generation rate in bytes per second, as seen by predictive"
+     " adaptive flushing",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_FLUSH_MODEL_LSN_RATE},
+
+    {"buffer_flush_model_age", "buffer",
+     "Age of the oldest modification in the buffer pool instance where it is"
+     " oldest, as seen by predictive adaptive flushing",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_FLUSH_MODEL_AGE},
+
+    {"buffer_flush_model_target_age", "buffer",
+     "Age of the oldest modification that predictive adaptive flushing aims"
+     " for",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_FLUSH_MODEL_TARGET_AGE},
+
+    {"buffer_flush_model_correction", "buffer",
+     "Redo bytes per second that predictive adaptive flushing adds to the"
+     " redo generation rate to correct a lasting error in the age",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_FLUSH_MODEL_CORRECTION},
+
+    {"buffer_flush_model_pages", "buffer",
+     "Pages predictive adaptive flushing asks to flush in the next second",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_FLUSH_MODEL_PAGES},
+
     {"buffer_flush_sync_waits", "buffer",
      "Number of times a wait happens due to sync flushing", MONITOR_NONE,
      MONITOR_DEFAULT_START, MONITOR_FLUSH_SYNC_WAITS},
@@ -778,6 +857,10 @@ static monitor_info_t innodb_counter_info[] = {
     {"trx_allocations", "transaction", "Number of trx_t allocations",
      MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_TRX_ALLOCATIONS},
 
+    {"trx_read_views_reused", "transaction",
+     "Number of read views of autocommit read only transactions reused",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_TRX_VIEW_REUSED},
+
     MONITOR_WAIT_STATS("trx_on_log_", "transaction",
                        "Waits for redo during transaction commits",
                        MONITOR_TRX_ON_LOG_),
@@ -1169,6 +1252,11 @@ static monitor_info_t innodb_counter_info[] = {
      static_cast<monitor_type_t>(MONITOR_EXISTING | MONITOR_DEFAULT_ON),
      MONITOR_DEFAULT_START, MONITOR_OVLD_IBUF_SIZE},
 
+    {"ibuf_merges_deferred", "change_buffer",
+     "Number of background change buffer merge batches deferred because"
+     " of pending foreground page reads",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_IBUF_MERGE_DEFERRED},
+
     /* ========== Counters for server operations ========== */
     {"module_innodb", "innodb",
      "Counter for general InnoDB server wide operations and properties",
@@ -1340,6 +1428,30 @@ static monitor_info_t innodb_counter_info[] = {
      "Number of log files created during alter table", MONITOR_NONE,
      MONITOR_DEFAULT_START, MONITOR_ALTER_TABLE_LOG_FILES},
 
+    /* ========== Counters for full-text cache sync ========== */
+    {"module_fts", "fts", "Full-text index cache sync", MONITOR_MODULE,
+     MONITOR_DEFAULT_START, MONITOR_MODULE_FTS},
+
+    {"fts_sync_requests", "fts",
+     "Number of full-text cache syncs requested from the background thread",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_FTS_SYNC_REQUESTS},
+
+    {"fts_sync_count", "fts", "Number of full-text cache syncs", MONITOR_NONE,
+     MONITOR_DEFAULT_START, MONITOR_FTS_SYNC_COUNT},
+
+    {"fts_sync_locked", "fts",
+     "Number of full-text cache syncs that blocked inserts because the cache"
+     " stayed over innodb_ft_cache_size",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_FTS_SYNC_LOCKED},
+
+    {"fts_sync_bytes", "fts",
+     "Size of the full-text caches written by syncs (in bytes)", MONITOR_NONE,
+     MONITOR_DEFAULT_START, MONITOR_FTS_SYNC_BYTES},
+
+    {"fts_sync_usec", "fts",
+     "Time (in microseconds) spent to sync full-text caches", MONITOR_NONE,
+     MONITOR_DEFAULT_START, MONITOR_FTS_SYNC_MICROSECOND},
+
     /* ===== Counters for ICP (Index Condition Pushdown) Module ===== */
     {"module_icp", "icp", "Index Condition Pushdown", MONITOR_MODULE,
      MONITOR_DEFAULT_START, MONITOR_MODULE_ICP},
@@ -1420,6 +1532,10 @@ static monitor_info_t innodb_counter_info[] = {
     {"dblwr_flush_wait_events", "dblwr", "Total flush wait events",
      MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_DBLWR_FLUSH_WAIT_EVENTS},
 
+    {"dblwr_atomic_writes", "dblwr",
+     "Total pages written without doublewrite to atomic write storage",
+     MONITOR_NONE, MONITOR_DEFAULT_START, MONITOR_DBLWR_ATOMIC_WRITES},
+
     /* ========== To turn on/off reset all counters ========== */
     {"all", "All Counters", "Turn on/off and reset all counters",
      MONITOR_MODULE, MONITOR_DEFAULT_START, MONITOR_ALL_COUNTER},
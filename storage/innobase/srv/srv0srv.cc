@@ -214,8 +214,12 @@ ulong srv_parallel_read_threads;
 OS (provided we compiled Innobase with it in), otherwise we will
 use simulated aio we build below with threads. */
 bool srv_use_native_aio = false;
+bool srv_use_io_uring = false;
+bool srv_io_uring_sqpoll = false;
+bool srv_io_uring_fixed_buffers = false;
 
 bool srv_numa_interleave = false;
+bool srv_numa_bind = false;
 
 #ifdef UNIV_DEBUG
 /** Force all user tables to use page compression. */
@@ -257,6 +261,8 @@ ulong srv_log_write_ahead_size;
 /** Whether to activate/pause the log writer threads. */
 bool srv_log_writer_threads;
 
+bool srv_log_writer_merges_writes = false;
+
 /** Minimum absolute value of cpu time for which spin-delay is used. */
 uint srv_log_spin_cpu_abs_lwm;
 
@@ -456,6 +462,12 @@ ulint srv_buf_pool_base_size = 0;
 long long srv_buf_pool_curr_size = 0;
 /** Dump this % of each buffer pool during BP dump */
 ulong srv_buf_pool_dump_pct;
+/** Size in bytes of the compressed tier of all buffer pool instances */
+ulonglong srv_buf_pool_ctier_size = 0;
+/** In which order a BP load reads the pages */
+ulong srv_buf_load_order = SRV_BUF_LOAD_ORDER_PAGE;
+/** Number of threads that read pages during BP load */
+ulong srv_buf_load_threads = 4;
 /** Lock table size in bytes */
 ulint srv_lock_table_size = ULINT_MAX;
 
@@ -469,6 +481,9 @@ ulong srv_n_write_io_threads;
 
 /* Switch to enable random read ahead. */
 bool srv_random_read_ahead = false;
+/* Switch to read the leaf pages of index lookups that are announced with
+handler::prefetch_keys() ahead of time. */
+bool srv_prefetch_hints = false;
 /* User settable value of the number of pages that must be present
 in the buffer cache and accessed sequentially for InnoDB to trigger a
 readahead request. */
@@ -506,6 +521,10 @@ ulong srv_adaptive_flushing_lwm = 10;
 /* Number of iterations over which adaptive flushing is averaged. */
 ulong srv_flushing_avg_loops = 30;
 
+ulong srv_adaptive_flushing_method = SRV_ADAPTIVE_FLUSHING_HEURISTIC;
+
+ulong srv_adaptive_flushing_target_pct = 50;
+
 /* The number of purge threads to use.*/
 ulong srv_n_purge_threads = 4;
 
@@ -537,6 +556,9 @@ This is for testing and debugging only. */
 ulong srv_force_recovery_crash;
 #endif /* UNIV_DEBUG */
 
+/** Number of threads that apply a batch of redo log records in recovery */
+ulong srv_recv_apply_threads = 4;
+
 /** Print all user-level transactions deadlocks to mysqld stderr */
 bool srv_print_all_deadlocks = false;
 
@@ -843,6 +865,11 @@ PSI_stage_info srv_stage_alter_tablespace_encryption = {
 /** Performance schema stage event for monitoring buffer pool load progress. */
 PSI_stage_info srv_stage_buffer_pool_load = {
     0, "buffer pool load", PSI_FLAG_STAGE_PROGRESS, PSI_DOCUMENT_ME};
+
+/** Performance schema stage event for monitoring redo log apply progress
+in crash recovery. */
+PSI_stage_info srv_stage_recovery_apply = {
+    0, "redo log apply", PSI_FLAG_STAGE_PROGRESS, PSI_DOCUMENT_ME};
 #endif /* HAVE_PSI_STAGE_INTERFACE */
 
 /** Performance schema stage event for monitoring clone file copy progress. */
@@ -452,6 +452,7 @@ LatchDebug::LatchDebug() {
   LEVEL_MAP_INSERT(SYNC_FIL_SHARD);
   LEVEL_MAP_INSERT(SYNC_DBLWR);
   LEVEL_MAP_INSERT(SYNC_BUF_CHUNKS);
+  LEVEL_MAP_INSERT(SYNC_BUF_CTIER);
   LEVEL_MAP_INSERT(SYNC_BUF_FLUSH_LIST);
   LEVEL_MAP_INSERT(SYNC_BUF_FLUSH_STATE);
   LEVEL_MAP_INSERT(SYNC_BUF_ZIP_HASH);
@@ -799,6 +800,7 @@ Latches *LatchDebug::check_order(const latch_t *latch,
     case SYNC_FIL_SHARD:
     case SYNC_DBLWR:
     case SYNC_BUF_CHUNKS:
+    case SYNC_BUF_CTIER:
     case SYNC_BUF_FLUSH_LIST:
     case SYNC_BUF_LRU_LIST:
     case SYNC_BUF_FREE_LIST:
@@ -1212,6 +1214,8 @@ static void sync_latch_meta_init() UNIV_NOTHROW {
 #endif /* PFS_SKIP_BUFFER_MUTEX_RWLOCK */
   LATCH_ADD_MUTEX(BUF_POOL_CHUNKS, SYNC_BUF_CHUNKS, buf_pool_chunks_mutex_key);
 
+  LATCH_ADD_MUTEX(BUF_POOL_CTIER, SYNC_BUF_CTIER, buf_pool_ctier_mutex_key);
+
   LATCH_ADD_MUTEX(BUF_POOL_LRU_LIST, SYNC_BUF_LRU_LIST,
                   buf_pool_LRU_list_mutex_key);
 
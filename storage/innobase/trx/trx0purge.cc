@@ -31,8 +31,11 @@ this program; if not, write to the Free Software Foundation, Inc.,
  *******************************************************/
 
 #include <sys/types.h>
+#include <algorithm>
 #include <new>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "clone0api.h"
 #include "clone0clone.h"
@@ -85,6 +88,9 @@ static constexpr int64_t PURGE_CHECK_UNDO_TRUNCATE_DELAY_IN_MS = 1000;
 bool srv_purge_view_update_only_debug;
 #endif /* UNIV_DEBUG */
 
+/** Rollback segments whose history one thread truncates */
+using Purge_rsegs = std::vector<trx_rseg_t *>;
+
 /** Sentinel value */
 const TrxUndoRsegs TrxUndoRsegsIterator::NullElement(UINT64_UNDEFINED);
 
@@ -1588,13 +1594,27 @@ static bool trx_purge_truncate_marked_undo() {
   return (true);
 }
 
+/** Removes unnecessary history data from rollback segments, in a thread
+of trx_purge_truncate_history().
+@param[in]  rsegs  Rollback segments
+@param[in]  limit  Truncate limit */
+static void trx_purge_truncate_rsegs_history(const Purge_rsegs *rsegs,
+                                             const purge_iter_t *limit) {
+  for (auto rseg : *rsegs) {
+    trx_purge_truncate_rseg_history(rseg, limit);
+  }
+}
+
 /** Removes unnecessary history data from rollback segments.
+The rollback segments of different tablespaces are truncated in parallel.
 NOTE that when this function is called, the caller must not
 have any latches on undo log pages!
-@param[in]  limit  Truncate limit
-@param[in]  view   Purge view */
+@param[in]  limit      Truncate limit
+@param[in]  view       Purge view
+@param[in]  n_threads  Maximum number of threads to use */
 static void trx_purge_truncate_history(purge_iter_t *limit,
-                                       const ReadView *view) {
+                                       const ReadView *view,
+                                       ulint n_threads) {
   MONITOR_INC_VALUE(MONITOR_PURGE_TRUNCATE_HISTORY_COUNT, 1);
 
   auto counter_time_truncate_history = std::chrono::steady_clock::now();
@@ -1610,6 +1630,34 @@ static void trx_purge_truncate_history(purge_iter_t *limit,
 
   ut_ad(limit->trx_no <= purge_sys->view.low_limit_no());
 
+  ut_a(n_threads > 0);
+
+  /* All rollback segments of a tablespace go to the same thread, because
+  freeing undo segments of one tablespace is serialized on its latch.
+  Each tablespace goes to the thread with the fewest rollback segments. */
+  std::vector<Purge_rsegs> shares(n_threads);
+
+  auto add_rsegs = [&](Rsegs &rsegs) {
+    rsegs.s_lock();
+
+    if (rsegs.size() == 0) {
+      rsegs.s_unlock();
+      return;
+    }
+
+    auto share = std::min_element(
+        shares.begin(), shares.end(),
+        [](const Purge_rsegs &a, const Purge_rsegs &b) {
+          return a.size() < b.size();
+        });
+
+    for (auto rseg : rsegs) {
+      share->push_back(rseg);
+    }
+
+    rsegs.s_unlock();
+  };
+
   /* Purge rollback segments in all undo tablespaces.  This may take
   some time and we do not want an undo DDL to attempt an x_lock during
   this time.  If it did, all other transactions seeking a short s_lock()
@@ -1625,33 +1673,37 @@ static void trx_purge_truncate_history(purge_iter_t *limit,
       continue;
     }
 
-    /* Purge rollback segments in this undo tablespace. */
-    undo_space->rsegs()->s_lock();
-
-    for (auto rseg : *undo_space->rsegs()) {
-      trx_purge_truncate_rseg_history(rseg, limit);
-    }
-    undo_space->rsegs()->s_unlock();
+    /* Purge rollback segments in this undo tablespace. They cannot be
+    removed while we hold the ddl_mutex. */
+    add_rsegs(*undo_space->rsegs());
   }
 
-  undo::spaces->s_unlock();
-  mutex_exit(&undo::ddl_mutex);
-
   /* Purge rollback segments in the system tablespace, if any.
   Use an s-lock for the whole list since it can have gaps and
-  may be sorted when added to. */
-  trx_sys->rsegs.s_lock();
-  for (auto rseg : trx_sys->rsegs) {
-    trx_purge_truncate_rseg_history(rseg, limit);
-  }
-  trx_sys->rsegs.s_unlock();
+  may be sorted when added to. Rollback segments are only ever
+  added to this list, so they stay valid after the s-lock. */
+  add_rsegs(trx_sys->rsegs);
 
   /* Purge rollback segments in the temporary tablespace. */
-  trx_sys->tmp_rsegs.s_lock();
-  for (auto rseg : trx_sys->tmp_rsegs) {
-    trx_purge_truncate_rseg_history(rseg, limit);
+  add_rsegs(trx_sys->tmp_rsegs);
+
+  std::vector<std::thread> threads;
+
+  for (size_t t = 1; t < shares.size(); ++t) {
+    if (!shares[t].empty()) {
+      threads.emplace_back(trx_purge_truncate_rsegs_history, &shares[t],
+                           limit);
+    }
+  }
+
+  trx_purge_truncate_rsegs_history(&shares[0], limit);
+
+  for (auto &thread : threads) {
+    thread.join();
   }
-  trx_sys->tmp_rsegs.s_unlock();
+
+  undo::spaces->s_unlock();
+  mutex_exit(&undo::ddl_mutex);
 
   MONITOR_INC_TIME(MONITOR_PURGE_TRUNCATE_HISTORY_MICROSECOND,
                    counter_time_truncate_history);
@@ -2374,14 +2426,16 @@ static void trx_purge_wait_for_workers_to_complete() {
   ut_a(srv_get_task_queue_length() == 0);
 }
 
-/** Remove old historical changes from the rollback segments. */
-static void trx_purge_truncate(void) {
+/** Remove old historical changes from the rollback segments.
+@param[in]  n_threads  Maximum number of threads to use */
+static void trx_purge_truncate(ulint n_threads) {
   ut_ad(trx_purge_check_limit());
 
   if (purge_sys->limit.trx_no == 0) {
-    trx_purge_truncate_history(&purge_sys->iter, &purge_sys->view);
+    trx_purge_truncate_history(&purge_sys->iter, &purge_sys->view, n_threads);
   } else {
-    trx_purge_truncate_history(&purge_sys->limit, &purge_sys->view);
+    trx_purge_truncate_history(&purge_sys->limit, &purge_sys->view,
+                               n_threads);
   }
 
   /* Attempt to truncate an undo tablespace. */
@@ -2491,7 +2545,7 @@ ulint trx_purge(ulint n_purge_threads, /*!< in: number of purge tasks
   undo logs during upgrade to update purge history
   length. */
   if (truncate || srv_upgrade_old_undo_found) {
-    trx_purge_truncate();
+    trx_purge_truncate(n_purge_threads);
   }
 
   MONITOR_INC_VALUE(MONITOR_PURGE_INVOKED, 1);
@@ -31,6 +31,9 @@ this program; if not, write to the Free Software Foundation, Inc.,
  *******************************************************/
 
 #include <sys/types.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 #include "clone0clone.h"
 #include "dict0dd.h"
@@ -61,15 +64,26 @@ this program; if not, write to the Free Software Foundation, Inc.,
 rollback */
 static const ulint TRX_ROLL_TRUNC_THRESHOLD = 1;
 
-/** In crash recovery, the current trx to be rolled back; NULL otherwise */
-static const trx_t *trx_roll_crash_recv_trx = nullptr;
+/** Number of threads rolling back recovered transactions in the background,
+including the recovery rollback thread itself. Each thread rolls back whole
+transactions, so a single large transaction still uses one thread. */
+static const size_t TRX_ROLL_RECOVERY_THREADS = 4;
+
+/** In crash recovery, the current trx to be rolled back by this thread;
+NULL otherwise */
+static thread_local const trx_t *trx_roll_crash_recv_trx = nullptr;
 
 /** In crash recovery we set this to the undo n:o of the current trx to be
 rolled back. Then we can print how many % the rollback has progressed. */
-static undo_no_t trx_roll_max_undo_no;
+static thread_local undo_no_t trx_roll_max_undo_no;
 
 /** Auxiliary variable which tells the previous progress % we printed */
-static ulint trx_roll_progress_printed_pct;
+static thread_local ulint trx_roll_progress_printed_pct;
+
+/** Recovered transactions that some thread is cleaning up or rolling back,
+so that the other recovery rollback threads skip them. Protected by
+trx_sys->mutex. */
+static std::vector<const trx_t *> trx_roll_recv_claimed;
 
 /** Finishes a transaction rollback. */
 static void trx_rollback_finish(trx_t *trx); /*!< in: transaction */
@@ -675,20 +689,40 @@ static bool trx_rollback_or_clean_resurrected(
     return false;
   }
 
+  /* Another recovery rollback thread is already working on it. */
+  if (std::find(trx_roll_recv_claimed.begin(), trx_roll_recv_claimed.end(),
+                trx) != trx_roll_recv_claimed.end()) {
+    return false;
+  }
+
+  /* Claim the transaction, and release trx_sys->mutex while working on it. */
+  auto claim = [trx]() {
+    trx_roll_recv_claimed.push_back(trx);
+    trx_sys_mutex_exit();
+  };
+  auto unclaim = [trx]() {
+    trx_sys_mutex_enter();
+    trx_roll_recv_claimed.erase(std::find(
+        trx_roll_recv_claimed.begin(), trx_roll_recv_claimed.end(), trx));
+    trx_sys_mutex_exit();
+  };
+
   switch (state) {
     case TRX_STATE_COMMITTED_IN_MEMORY:
-      trx_sys_mutex_exit();
+      claim();
       ib::info(ER_IB_MSG_1188)
           << "Cleaning up trx with id " << trx_get_id_for_print(trx);
 
       trx_cleanup_at_db_startup(trx);
+      unclaim();
       trx_free_resurrected(trx);
       ut_ad(!trx->is_recovered);
       return true;
     case TRX_STATE_ACTIVE:
       if (all || trx->ddl_operation) {
-        trx_sys_mutex_exit();
+        claim();
         trx_rollback_active(trx);
+        unclaim();
         trx_free_for_background(trx);
         ut_ad(!trx->is_recovered);
         return true;
@@ -704,29 +738,12 @@ static bool trx_rollback_or_clean_resurrected(
   ut_error;
 }
 
-/** Rollback or clean up any incomplete transactions which were
- encountered in crash recovery.  If the transaction already was
- committed, then we clean up a possible insert undo log. If the
- transaction was not yet committed, then we roll it back. */
-void trx_rollback_or_clean_recovered(
-    bool all) /*!< in: false=roll back dictionary transactions;
-               true=roll back all non-PREPARED transactions */
-{
-  ut_ad(!srv_read_only_mode);
-
-  ut_a(srv_force_recovery < SRV_FORCE_NO_TRX_UNDO);
-  ut_ad(!all || trx_sys_need_rollback());
-
-  if (all) {
-    ib::info(ER_IB_MSG_1189) << "Starting in background the rollback"
-                                " of uncommitted transactions";
-  }
-
-  /* Note: For XA recovered transactions, we rely on MySQL to
-  do rollback. They will be in TRX_STATE_PREPARED state. If the server
-  is shutdown and they are still lingering in trx_sys_t::trx_list
-  then the shutdown will hang. */
-
+/** Clean up or roll back recovered transactions until none are left that
+this thread can claim.
+@param[in]      all     false=roll back dictionary transactions;
+                        true=roll back all non-PREPARED transactions
+@return false if interrupted by shutdown */
+static bool trx_rollback_or_clean_recovered_low(bool all) {
   /* Loop over the transaction list as long as there are
   recovered transactions to clean up or recover. */
 
@@ -751,11 +768,7 @@ void trx_rollback_or_clean_recovered(
         }));
 
         trx_sys_mutex_exit();
-
-        if (all) {
-          ib::info(ER_IB_MSG_TRX_RECOVERY_ROLLBACK_NOT_COMPLETED);
-        }
-        return;
+        return false;
       }
 
       /* If this function does a cleanup or rollback
@@ -769,9 +782,85 @@ void trx_rollback_or_clean_recovered(
     }
   }
   trx_sys_mutex_exit();
+  return true;
+}
+
+/** Helps the recovery rollback thread roll back recovered transactions.
+@param[out]     completed       set to false if interrupted by shutdown */
+static void trx_recovery_rollback_helper(std::atomic<bool> *completed) {
+  THD *thd = create_internal_thd();
 
+  if (!trx_rollback_or_clean_recovered_low(true)) {
+    completed->store(false);
+  }
+
+  destroy_internal_thd(thd);
+}
+
+/** Rollback or clean up any incomplete transactions which were
+ encountered in crash recovery.  If the transaction already was
+ committed, then we clean up a possible insert undo log. If the
+ transaction was not yet committed, then we roll it back. */
+void trx_rollback_or_clean_recovered(
+    bool all) /*!< in: false=roll back dictionary transactions;
+               true=roll back all non-PREPARED transactions */
+{
+  ut_ad(!srv_read_only_mode);
+
+  ut_a(srv_force_recovery < SRV_FORCE_NO_TRX_UNDO);
+  ut_ad(!all || trx_sys_need_rollback());
+
+  if (all) {
+    ib::info(ER_IB_MSG_1189) << "Starting in background the rollback"
+                                " of uncommitted transactions";
+  }
+
+  /* Note: For XA recovered transactions, we rely on MySQL to
+  do rollback. They will be in TRX_STATE_PREPARED state. If the server
+  is shutdown and they are still lingering in trx_sys_t::trx_list
+  then the shutdown will hang. */
+
+  /* In the background, independent transactions are rolled back in
+  parallel, one per thread. */
+  size_t n_helpers = 0;
   if (all) {
-    ib::info(ER_IB_MSG_TRX_RECOVERY_ROLLBACK_COMPLETED);
+    size_t n_active = 0;
+    trx_sys_mutex_enter();
+    for (auto trx : trx_sys->rw_trx_list) {
+      if (trx->is_recovered &&
+          trx->state.load(std::memory_order_relaxed) == TRX_STATE_ACTIVE) {
+        n_active++;
+      }
+    }
+    trx_sys_mutex_exit();
+    if (n_active > 1) {
+      n_helpers = std::min(n_active, TRX_ROLL_RECOVERY_THREADS) - 1;
+    }
+  }
+
+  std::atomic<bool> completed{true};
+  std::vector<IB_thread> helpers;
+  for (size_t i = 0; i < n_helpers; i++) {
+    auto helper = os_thread_create(trx_recovery_rollback_thread_key, i + 1,
+                                   trx_recovery_rollback_helper, &completed);
+    helper.start();
+    helpers.push_back(std::move(helper));
+  }
+
+  if (!trx_rollback_or_clean_recovered_low(all)) {
+    completed.store(false);
+  }
+
+  for (auto &helper : helpers) {
+    helper.join();
+  }
+
+  if (all) {
+    if (completed.load()) {
+      ib::info(ER_IB_MSG_TRX_RECOVERY_ROLLBACK_COMPLETED);
+    } else {
+      ib::info(ER_IB_MSG_TRX_RECOVERY_ROLLBACK_NOT_COMPLETED);
+    }
   }
 }
 
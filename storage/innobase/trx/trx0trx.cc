@@ -1781,6 +1781,7 @@ static void trx_erase_lists(trx_t *trx) {
 
   ut_ad(*it == trx->id);
   trx_sys->rw_trx_ids.erase(it);
+  trx_sys->rw_trx_ids_version.fetch_add(1);
 
   if (trx->read_only || trx->rsegs.m_redo.rseg == nullptr) {
     ut_ad(!trx->in_rw_trx_list);
@@ -276,6 +276,22 @@ PFS_statements_digest_stat *find_or_create_digest(
 
   ulonglong now = my_micro_time();
 
+  /*
+    Threads often run the same statement repeatedly: try the digest row used
+    by the previous statement before searching the hash. The row may have
+    been reset and reused since, which changes its lock version.
+  */
+  pfs = thread->m_last_digest_stat;
+  if (pfs != nullptr &&
+      digest_hash_cmp_func(reinterpret_cast<const uchar *>(&hash_key),
+                           sizeof(PFS_digest_key),
+                           reinterpret_cast<const uchar *>(&pfs->m_digest_key),
+                           sizeof(PFS_digest_key)) == 0 &&
+      pfs->m_lock.end_optimistic_lock(&thread->m_last_digest_stat_state)) {
+    pfs->m_last_seen = now;
+    return pfs;
+  }
+
 search:
 
   /* Lookup LF_HASH using this new key. */
@@ -286,6 +302,8 @@ search:
     /* If digest already exists, update stats and return. */
     pfs = *entry;
     pfs->m_last_seen = now;
+    pfs->m_lock.begin_optimistic_lock(&thread->m_last_digest_stat_state);
+    thread->m_last_digest_stat = pfs;
     lf_hash_search_unpin(pins);
     return pfs;
   }
@@ -336,6 +354,9 @@ search:
         res = lf_hash_insert(&digest_hash, pins, &pfs);
         if (likely(res == 0)) {
           pfs->m_lock.dirty_to_allocated(&dirty_state);
+          pfs->m_lock.begin_optimistic_lock(
+              &thread->m_last_digest_stat_state);
+          thread->m_last_digest_stat = pfs;
           return pfs;
         }
 
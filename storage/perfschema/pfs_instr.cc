@@ -645,6 +645,7 @@ PFS_thread *create_thread(PFS_thread_class *klass, PSI_thread_seqnum seqnum,
     pfs->m_account_hash_pins = nullptr;
     pfs->m_host_hash_pins = nullptr;
     pfs->m_digest_hash_pins = nullptr;
+    pfs->m_last_digest_stat = nullptr;
     pfs->m_program_hash_pins = nullptr;
 
     pfs->m_user_name.reset();
@@ -905,6 +906,7 @@ void destroy_thread(PFS_thread *pfs) {
     lf_hash_put_pins(pfs->m_digest_hash_pins);
     pfs->m_digest_hash_pins = nullptr;
   }
+  pfs->m_last_digest_stat = nullptr;
   if (pfs->m_program_hash_pins) {
     lf_hash_put_pins(pfs->m_program_hash_pins);
     pfs->m_program_hash_pins = nullptr;
@@ -83,6 +83,7 @@ struct PFS_thread;
 struct PFS_host;
 struct PFS_user;
 struct PFS_account;
+struct PFS_statements_digest_stat;
 
 /** Base structure for wait instruments. */
 struct PFS_instr {
@@ -470,6 +471,10 @@ struct PFS_ALIGNED PFS_thread : PFS_connection_slice {
   LF_PINS *m_account_hash_pins;
   /** Pins for digest_hash. */
   LF_PINS *m_digest_hash_pins;
+  /** Digest row used last by this thread, @sa find_or_create_digest(). */
+  PFS_statements_digest_stat *m_last_digest_stat;
+  /** Lock version of @c m_last_digest_stat when it was used. */
+  pfs_optimistic_state m_last_digest_stat_state;
   /** Pins for routine_hash. */
   LF_PINS *m_program_hash_pins;
   /** Internal thread identifier, unique. */
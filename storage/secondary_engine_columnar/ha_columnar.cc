@@ -0,0 +1,766 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#include "storage/secondary_engine_columnar/ha_columnar.h"
+
+#include <stddef.h>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "my_byteorder.h"
+#include "my_dbug.h"
+#include "my_inttypes.h"
+#include "my_sys.h"
+#include "mysql/plugin.h"
+#include "mysqld_error.h"
+#include "sql/field.h"
+#include "sql/handler.h"
+#include "sql/item.h"
+#include "sql/item_cmpfunc.h"
+#include "sql/item_func.h"
+#include "sql/join_optimizer/access_path.h"
+#include "sql/join_optimizer/walk_access_paths.h"
+#include "sql/range_optimizer/range_optimizer.h"
+#include "sql/sql_class.h"
+#include "sql/sql_const.h"
+#include "sql/sql_lex.h"
+#include "sql/table.h"
+#include "template_utils.h"
+#include "thr_lock.h"
+
+namespace dd {
+class Table;
+}
+
+namespace columnar {
+
+/// Where a column is in the MySQL record format. The null bitmap of the
+/// record is stored as a column of its own, which also covers the bits of
+/// BIT columns that are kept there.
+struct Column_layout {
+  size_t offset;
+  size_t length;
+  /// The length bytes of a VARCHAR column, whose unused tail is not
+  /// stored; 0 for other columns.
+  size_t varchar_length_bytes;
+};
+
+/// One column of a row group: the distinct values of the column, and runs
+/// of the codes of the values of consecutive rows.
+struct Column_chunk {
+  struct Run {
+    uint32_t code;
+    uint32_t length;
+  };
+
+  std::vector<std::string> dictionary;
+  std::vector<Run> runs;
+
+  /// The codes of the smallest and the largest value in the dictionary,
+  /// for columns of fields. The values of NULLs are included, which makes
+  /// the range wider than it has to be, but not wrong.
+  uint32_t min_code{0};
+  uint32_t max_code{0};
+};
+
+/// A set of rows of a table, stored column by column.
+struct Row_group {
+  /// Number of the first row of the group in the table.
+  uint64_t first_row{0};
+  size_t num_rows{0};
+  std::vector<Column_chunk> columns;
+};
+
+struct Columnar_table {
+  /// Locked by the handlers that read the table, through their own
+  /// THR_LOCK_DATA.
+  mutable THR_LOCK lock;
+  std::vector<Column_layout> layout;
+  /// The column of the first field; the columns of the fields follow the
+  /// column of the null bitmap, if there is one.
+  size_t first_field_column{0};
+  size_t record_length{0};
+  std::vector<Row_group> row_groups;
+  uint64_t num_rows{0};
+
+  Columnar_table() { thr_lock_init(&lock); }
+  ~Columnar_table() { thr_lock_delete(&lock); }
+
+  // Not copyable. The THR_LOCK object must stay where it is in memory
+  // after it has been initialized.
+  Columnar_table(const Columnar_table &) = delete;
+  Columnar_table &operator=(const Columnar_table &) = delete;
+};
+
+}  // namespace columnar
+
+namespace {
+
+using columnar::Column_chunk;
+using columnar::Column_layout;
+using columnar::Columnar_table;
+using columnar::Row_group;
+
+/// Rows of a row group when it is loaded. Large enough for the runs and
+/// dictionaries to pay off, small enough for the load threads to hand
+/// over their rows regularly.
+constexpr size_t kRowGroupSize = 65536;
+
+// Map from (db_name, table_name) to the loaded table.
+class LoadedTables {
+  std::map<std::pair<std::string, std::string>,
+           std::shared_ptr<const Columnar_table>>
+      m_tables;
+  std::mutex m_mutex;
+
+ public:
+  void add(const std::string &db, const std::string &table,
+           std::shared_ptr<const Columnar_table> columnar_table) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_tables[std::make_pair(db, table)] = std::move(columnar_table);
+  }
+
+  std::shared_ptr<const Columnar_table> get(const std::string &db,
+                                            const std::string &table) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto it = m_tables.find(std::make_pair(db, table));
+    return it == m_tables.end() ? nullptr : it->second;
+  }
+
+  void erase(const std::string &db, const std::string &table) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_tables.erase(std::make_pair(db, table));
+  }
+};
+
+LoadedTables *loaded_tables{nullptr};
+
+/// Collects the row groups that the load threads build.
+class Table_loader {
+ public:
+  explicit Table_loader(Columnar_table *table) : m_table(table) {}
+
+  void add(Row_group &&row_group) {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    row_group.first_row = m_table->num_rows;
+    m_table->num_rows += row_group.num_rows;
+    m_table->row_groups.push_back(std::move(row_group));
+  }
+
+  const Columnar_table &table() const { return *m_table; }
+
+ private:
+  Columnar_table *m_table;
+  std::mutex m_mutex;
+};
+
+/// Encodes the rows that one load thread reads into row groups.
+class Row_group_builder {
+ public:
+  explicit Row_group_builder(Table_loader *loader)
+      : m_loader(loader),
+        m_layout(loader->table().layout),
+        m_columns(m_layout.size()),
+        m_codes(m_layout.size()) {}
+
+  /// Add a row in the MySQL record format.
+  void add(const uchar *record) {
+    for (size_t i = 0; i < m_layout.size(); ++i) {
+      const Column_layout &column = m_layout[i];
+      const uchar *value = record + column.offset;
+      size_t length = column.length;
+      if (column.varchar_length_bytes == 1) {
+        length = std::min<size_t>(length, 1 + value[0]);
+      } else if (column.varchar_length_bytes == 2) {
+        length = std::min<size_t>(length, 2 + uint2korr(value));
+      }
+
+      Column_chunk &chunk = m_columns[i];
+      const auto inserted = m_codes[i].emplace(
+          std::string(pointer_cast<const char *>(value), length),
+          static_cast<uint32_t>(chunk.dictionary.size()));
+      if (inserted.second) chunk.dictionary.push_back(inserted.first->first);
+
+      const uint32_t code = inserted.first->second;
+      if (!chunk.runs.empty() && chunk.runs.back().code == code) {
+        ++chunk.runs.back().length;
+      } else {
+        chunk.runs.push_back({code, 1});
+      }
+    }
+    if (++m_num_rows == kRowGroupSize) flush();
+  }
+
+  /// Hand over the rows added so far as a row group.
+  void flush() {
+    if (m_num_rows == 0) return;
+    Row_group row_group;
+    row_group.num_rows = m_num_rows;
+    row_group.columns = std::move(m_columns);
+    m_loader->add(std::move(row_group));
+
+    m_columns.clear();
+    m_columns.resize(m_layout.size());
+    for (auto &codes : m_codes) codes.clear();
+    m_num_rows = 0;
+  }
+
+ private:
+  Table_loader *m_loader;
+  const std::vector<Column_layout> &m_layout;
+  std::vector<Column_chunk> m_columns;
+  /// The code of each value in the dictionary of each column.
+  std::vector<std::unordered_map<std::string, uint32_t>> m_codes;
+  size_t m_num_rows{0};
+};
+
+/// Find the smallest and the largest value of each field in each row group.
+void set_zone_maps(const TABLE &table_arg, Columnar_table *table) {
+  for (Row_group &row_group : table->row_groups) {
+    for (uint i = 0; i < table_arg.s->fields; ++i) {
+      const Field *field = table_arg.field[i];
+      Column_chunk &chunk =
+          row_group.columns[table->first_field_column + i];
+      for (uint32_t code = 1; code < chunk.dictionary.size(); ++code) {
+        const uchar *value =
+            pointer_cast<const uchar *>(chunk.dictionary[code].data());
+        if (field->cmp(value, pointer_cast<const uchar *>(
+                                  chunk.dictionary[chunk.min_code].data())) <
+            0) {
+          chunk.min_code = code;
+        }
+        if (field->cmp(value, pointer_cast<const uchar *>(
+                                  chunk.dictionary[chunk.max_code].data())) >
+            0) {
+          chunk.max_code = code;
+        }
+      }
+    }
+  }
+}
+
+/// Check if the values of a field in a row group can be compared with
+/// Field::cmp() instead of the comparison of the condition. The constant is
+/// stored in the field before it is compared, so the comparison must be
+/// done in the type of the field.
+bool is_zone_map_comparable(const Item *cond_func, const Field *field,
+                            Item_func::Functype comp_type, const Item *value) {
+  switch (field->real_type()) {
+    case MYSQL_TYPE_BIT:
+    case MYSQL_TYPE_ENUM:
+    case MYSQL_TYPE_SET:
+      // Compared as strings or integers depending on the other operand.
+      return false;
+    default:
+      break;
+  }
+  if (field->result_type() == STRING_RESULT &&
+      !is_temporal_type(field->type()) &&
+      (value->result_type() != STRING_RESULT || value->is_temporal())) {
+    // Compared as numbers or temporal values, not as strings.
+    return false;
+  }
+  return comparable_in_index(const_cast<Item *>(cond_func), field,
+                             Field::itRAW, comp_type, value);
+}
+
+/// Copy the value of a column of a row into a record.
+void copy_value(const Column_chunk &chunk, uint32_t code,
+                const Column_layout &column, uchar *record) {
+  const std::string &value = chunk.dictionary[code];
+  memcpy(record + column.offset, value.data(), value.size());
+}
+
+}  // namespace
+
+namespace columnar {
+
+ha_columnar::ha_columnar(handlerton *hton, TABLE_SHARE *table_share_arg)
+    : handler(hton, table_share_arg) {}
+
+int ha_columnar::open(const char *, int, unsigned int, const dd::Table *) {
+  m_table = loaded_tables->get(table_share->db.str, table_share->table_name.str);
+  if (m_table == nullptr) {
+    // The table has not been loaded into the secondary storage engine yet.
+    my_error(ER_SECONDARY_ENGINE_PLUGIN, MYF(0), "Table has not been loaded");
+    return HA_ERR_GENERIC;
+  }
+  thr_lock_data_init(&m_table->lock, &m_lock, nullptr);
+  ref_length = sizeof(uint64_t);
+  m_runs = std::make_unique<size_t[]>(m_table->layout.size());
+  m_run_offsets = std::make_unique<size_t[]>(m_table->layout.size());
+  return 0;
+}
+
+int ha_columnar::close() {
+  m_runs.reset();
+  m_run_offsets.reset();
+  m_table.reset();
+  return 0;
+}
+
+int ha_columnar::rnd_init(bool) {
+  m_row_group = 0;
+  m_row = 0;
+  std::fill_n(m_runs.get(), m_table->layout.size(), 0);
+  std::fill_n(m_run_offsets.get(), m_table->layout.size(), 0);
+  evaluate_zone_predicates();
+  return 0;
+}
+
+const Item *ha_columnar::cond_push(const Item *cond) {
+  m_zone_predicates.clear();
+  add_zone_predicates(cond);
+  pushed_cond = cond;
+  // The row groups are only skipped as a whole, so the server must still
+  // evaluate the condition on the rows that are read.
+  return cond;
+}
+
+int ha_columnar::reset() {
+  m_zone_predicates.clear();
+  return 0;
+}
+
+void ha_columnar::add_zone_predicates(const Item *cond) {
+  if (cond->type() == Item::COND_ITEM &&
+      down_cast<const Item_cond *>(cond)->functype() ==
+          Item_func::COND_AND_FUNC) {
+    for (const Item &item :
+         *const_cast<Item_cond *>(down_cast<const Item_cond *>(cond))
+              ->argument_list()) {
+      add_zone_predicates(&item);
+    }
+    return;
+  }
+  if (cond->type() != Item::FUNC_ITEM) return;
+
+  const auto func = down_cast<const Item_func *>(cond);
+  Item **args = func->arguments();
+  Item_func::Functype functype = func->functype();
+  size_t field_arg = 0;
+  switch (functype) {
+    case Item_func::LT_FUNC:
+    case Item_func::LE_FUNC:
+    case Item_func::GT_FUNC:
+    case Item_func::GE_FUNC:
+    case Item_func::EQ_FUNC:
+      // Either side may be the field.
+      if (args[0]->real_item()->type() != Item::FIELD_ITEM) {
+        field_arg = 1;
+        functype = down_cast<const Item_bool_func2 *>(func)->rev_functype();
+      }
+      break;
+    case Item_func::BETWEEN:
+      if (down_cast<const Item_func_between *>(func)->negated) return;
+      break;
+    default:
+      return;
+  }
+
+  if (args[field_arg]->real_item()->type() != Item::FIELD_ITEM) return;
+  Field *field = down_cast<Item_field *>(args[field_arg]->real_item())->field;
+  if (field->table != table) return;
+
+  Zone_predicate predicate{};
+  predicate.field = field;
+  predicate.column = m_table->first_field_column + field->field_index();
+  for (uint i = 0; i < func->argument_count(); ++i) {
+    if (i == field_arg) continue;
+    Item *value = args[i];
+    if (!value->const_for_execution() || value->has_subquery() ||
+        value->is_expensive() ||
+        !is_zone_map_comparable(func, field,
+                                functype == Item_func::BETWEEN
+                                    ? Item_func::GE_FUNC
+                                    : functype,
+                                value)) {
+      return;
+    }
+  }
+
+  switch (functype) {
+    case Item_func::LT_FUNC:
+    case Item_func::LE_FUNC:
+      predicate.high = args[1 - field_arg];
+      predicate.high_inclusive = functype == Item_func::LE_FUNC;
+      break;
+    case Item_func::GT_FUNC:
+    case Item_func::GE_FUNC:
+      predicate.low = args[1 - field_arg];
+      predicate.low_inclusive = functype == Item_func::GE_FUNC;
+      break;
+    case Item_func::EQ_FUNC:
+      predicate.low = predicate.high = args[1 - field_arg];
+      predicate.low_inclusive = predicate.high_inclusive = true;
+      break;
+    default:
+      assert(functype == Item_func::BETWEEN);
+      predicate.low = args[1];
+      predicate.high = args[2];
+      predicate.low_inclusive = predicate.high_inclusive = true;
+      break;
+  }
+  m_zone_predicates.push_back(std::move(predicate));
+}
+
+void ha_columnar::evaluate_zone_predicates() {
+  if (m_zone_predicates.empty()) return;
+
+  // Store the bounds in the fields in record[0], like the range optimizer
+  // does, and keep a copy. The scan overwrites the record anyway.
+  const auto evaluate = [](Field *field, Item *value, std::string *image) {
+    image->clear();
+    if (value == nullptr) return;
+    if (value->save_in_field_no_warnings(field, true) != TYPE_OK ||
+        value->null_value) {
+      // The bound is NULL, or it is not exactly a value of the field. Do
+      // not try to skip any rows with it.
+      return;
+    }
+    image->assign(pointer_cast<const char *>(field->field_ptr()),
+                  field->pack_length());
+  };
+
+  my_bitmap_map *old_map = dbug_tmp_use_all_columns(table, table->write_set);
+  for (Zone_predicate &predicate : m_zone_predicates) {
+    evaluate(predicate.field, predicate.low, &predicate.low_value);
+    evaluate(predicate.field, predicate.high, &predicate.high_value);
+  }
+  dbug_tmp_restore_column_map(table->write_set, old_map);
+}
+
+bool ha_columnar::may_match(size_t row_group) const {
+  const Row_group &group = m_table->row_groups[row_group];
+  for (const Zone_predicate &predicate : m_zone_predicates) {
+    const Column_chunk &chunk = group.columns[predicate.column];
+    if (!predicate.low_value.empty()) {
+      const int cmp = predicate.field->cmp(
+          pointer_cast<const uchar *>(chunk.dictionary[chunk.max_code].data()),
+          pointer_cast<const uchar *>(predicate.low_value.data()));
+      if (cmp < 0 || (cmp == 0 && !predicate.low_inclusive)) return false;
+    }
+    if (!predicate.high_value.empty()) {
+      const int cmp = predicate.field->cmp(
+          pointer_cast<const uchar *>(chunk.dictionary[chunk.min_code].data()),
+          pointer_cast<const uchar *>(predicate.high_value.data()));
+      if (cmp > 0 || (cmp == 0 && !predicate.high_inclusive)) return false;
+    }
+  }
+  return true;
+}
+
+int ha_columnar::rnd_next(unsigned char *buf) {
+  const std::vector<Row_group> &row_groups = m_table->row_groups;
+  const size_t num_columns = m_table->layout.size();
+  if (m_row_group < row_groups.size() &&
+      m_row == row_groups[m_row_group].num_rows) {
+    ++m_row_group;
+    m_row = 0;
+    std::fill_n(m_runs.get(), num_columns, 0);
+    std::fill_n(m_run_offsets.get(), num_columns, 0);
+  }
+  if (m_row == 0) {
+    // Skip the row groups that the pushed condition rules out.
+    while (m_row_group < row_groups.size() && !may_match(m_row_group)) {
+      ++m_row_group;
+    }
+  }
+  if (m_row_group == row_groups.size()) return HA_ERR_END_OF_FILE;
+
+  const Row_group &row_group = row_groups[m_row_group];
+  for (size_t i = 0; i < num_columns; ++i) {
+    const Column_chunk &chunk = row_group.columns[i];
+    const Column_chunk::Run &run = chunk.runs[m_runs[i]];
+    copy_value(chunk, run.code, m_table->layout[i], buf);
+    if (++m_run_offsets[i] == run.length) {
+      ++m_runs[i];
+      m_run_offsets[i] = 0;
+    }
+  }
+  m_last_row = row_group.first_row + m_row;
+  ++m_row;
+  return 0;
+}
+
+void ha_columnar::position(const unsigned char *) {
+  int8store(ref, m_last_row);
+}
+
+int ha_columnar::rnd_pos(unsigned char *buf, unsigned char *pos) {
+  const uint64_t row = uint8korr(pos);
+  const std::vector<Row_group> &row_groups = m_table->row_groups;
+  // The row groups are in the order of their first rows.
+  auto it = std::upper_bound(row_groups.begin(), row_groups.end(), row,
+                             [](uint64_t value, const Row_group &row_group) {
+                               return value < row_group.first_row;
+                             });
+  if (it == row_groups.begin()) return HA_ERR_KEY_NOT_FOUND;
+  const Row_group &row_group = *--it;
+  if (row - row_group.first_row >= row_group.num_rows) {
+    return HA_ERR_KEY_NOT_FOUND;
+  }
+
+  for (size_t i = 0; i < m_table->layout.size(); ++i) {
+    const Column_chunk &chunk = row_group.columns[i];
+    uint64_t skip = row - row_group.first_row;
+    auto run = chunk.runs.begin();
+    while (skip >= run->length) {
+      skip -= run->length;
+      ++run;
+    }
+    copy_value(chunk, run->code, m_table->layout[i], buf);
+  }
+  m_last_row = row;
+  return 0;
+}
+
+int ha_columnar::info(unsigned int flags) {
+  // Get the cardinality statistics from the primary storage engine, but
+  // the number of rows from the loaded copy.
+  handler *primary = ha_get_primary_handler();
+  int ret = primary->info(flags);
+  if (ret == 0) {
+    stats.records =
+        m_table != nullptr ? m_table->num_rows : primary->stats.records;
+  }
+  return ret;
+}
+
+handler::Table_flags ha_columnar::table_flags() const {
+  // Secondary engines do not support index access. Indexes are only used for
+  // cost estimates.
+  return HA_NO_INDEX_ACCESS;
+}
+
+unsigned long ha_columnar::index_flags(unsigned int idx, unsigned int part,
+                                       bool all_parts) const {
+  const handler *primary = ha_get_primary_handler();
+  const unsigned long primary_flags =
+      primary == nullptr ? 0 : primary->index_flags(idx, part, all_parts);
+
+  // Inherit HA_READ_RANGE and HA_KEY_SCAN_NOT_ROR from the primary handler,
+  // so that the optimizer can use the indexes for estimates; see ha_mock.
+  return ((HA_READ_RANGE | HA_KEY_SCAN_NOT_ROR) & primary_flags);
+}
+
+ha_rows ha_columnar::records_in_range(unsigned int index, key_range *min_key,
+                                      key_range *max_key) {
+  // Get the number of records in the range from the primary storage engine.
+  return ha_get_primary_handler()->records_in_range(index, min_key, max_key);
+}
+
+THR_LOCK_DATA **ha_columnar::store_lock(THD *, THR_LOCK_DATA **to,
+                                        thr_lock_type lock_type) {
+  if (lock_type != TL_IGNORE && m_lock.type == TL_UNLOCK)
+    m_lock.type = lock_type;
+  *to++ = &m_lock;
+  return to;
+}
+
+int ha_columnar::load_table(const TABLE &table_arg) {
+  assert(table_arg.file != nullptr);
+  THD *thd = table_arg.in_use;
+
+  // The values of BLOB columns are not in the record, and virtual columns
+  // are not read by the scan of the primary engine.
+  for (Field **field = table_arg.field; *field != nullptr; ++field) {
+    if ((*field)->is_flag_set(BLOB_FLAG) || (*field)->is_virtual_gcol()) {
+      my_error(ER_SECONDARY_ENGINE_PLUGIN, MYF(0),
+               "Tables with BLOB or virtual generated columns cannot be "
+               "loaded");
+      return HA_ERR_GENERIC;
+    }
+  }
+
+  auto table = std::make_shared<Columnar_table>();
+  table->record_length = table_arg.s->reclength;
+  if (table_arg.s->null_bytes > 0) {
+    table->layout.push_back({0, table_arg.s->null_bytes, 0});
+    table->first_field_column = 1;
+  }
+  for (Field **field = table_arg.field; *field != nullptr; ++field) {
+    table->layout.push_back(
+        {(*field)->offset(table_arg.record[0]), (*field)->pack_length(),
+         (*field)->type() == MYSQL_TYPE_VARCHAR ? (*field)->get_length_bytes()
+                                                : 0});
+  }
+
+  handler *primary = table_arg.file;
+  void *scan_ctx = nullptr;
+  size_t num_threads = 0;
+  int error = primary->parallel_scan_init(scan_ctx, &num_threads, true);
+  if (error != 0 || scan_ctx == nullptr) {
+    if (!thd->is_error()) {
+      my_error(ER_SECONDARY_ENGINE_PLUGIN, MYF(0),
+               "The primary storage engine cannot scan the table");
+    }
+    return HA_ERR_GENERIC;
+  }
+
+  Table_loader loader(table.get());
+  std::vector<std::unique_ptr<Row_group_builder>> builders;
+  std::vector<void *> thread_ctxs;
+  for (size_t i = 0; i < num_threads; ++i) {
+    builders.push_back(std::make_unique<Row_group_builder>(&loader));
+    thread_ctxs.push_back(builders.back().get());
+  }
+
+  const size_t record_length = table->record_length;
+  error = primary->parallel_scan(
+      scan_ctx, thread_ctxs.data(),
+      [record_length](void *, ulong, ulong row_len, const ulong *,
+                      const ulong *, const ulong *) {
+        return row_len != record_length;
+      },
+      [record_length](void *cookie, uint nrows, void *rowdata, uint64_t) {
+        auto builder = static_cast<Row_group_builder *>(cookie);
+        const uchar *record = static_cast<const uchar *>(rowdata);
+        try {
+          for (uint i = 0; i < nrows; ++i, record += record_length) {
+            builder->add(record);
+          }
+        } catch (const std::bad_alloc &) {
+          return true;
+        }
+        return false;
+      },
+      [](void *cookie) {
+        try {
+          static_cast<Row_group_builder *>(cookie)->flush();
+        } catch (const std::bad_alloc &) {
+          // The rows are lost; parallel_scan() reports the error of the
+          // load callback, but there is no way to report this one.
+          assert(false);
+        }
+      });
+  primary->parallel_scan_end(scan_ctx);
+
+  if (error != 0) {
+    if (!thd->is_error()) primary->print_error(error, MYF(0));
+    return error;
+  }
+
+  set_zone_maps(table_arg, table.get());
+  loaded_tables->add(table_arg.s->db.str, table_arg.s->table_name.str,
+                     std::move(table));
+  return 0;
+}
+
+int ha_columnar::unload_table(const char *db_name, const char *table_name,
+                              bool error_if_not_loaded) {
+  if (error_if_not_loaded &&
+      loaded_tables->get(db_name, table_name) == nullptr) {
+    my_error(ER_SECONDARY_ENGINE_PLUGIN, MYF(0),
+             "Table is not loaded on a secondary engine");
+    return 1;
+  } else {
+    loaded_tables->erase(db_name, table_name);
+    return 0;
+  }
+}
+
+}  // namespace columnar
+
+static bool PrepareSecondaryEngine(THD *, LEX *lex) {
+  // Disable use of constant tables and evaluation of subqueries during
+  // optimization, as the tables can only be read with table scans.
+  lex->add_statement_options(OPTION_NO_CONST_TABLES |
+                             OPTION_NO_SUBQUERY_DURING_OPTIMIZATION);
+  return false;
+}
+
+static bool OptimizeSecondaryEngine(THD *, LEX *lex) {
+  // Push the conditions of table scans to the handlers, so that they can
+  // use them to skip row groups.
+  if (lex->unit->root_access_path() == nullptr) return false;
+  WalkAccessPaths(lex->unit->root_access_path(), nullptr,
+                  WalkAccessPathPolicy::ENTIRE_TREE,
+                  [](AccessPath *path, const JOIN *) {
+                    if (path->type != AccessPath::FILTER ||
+                        path->filter().child->type != AccessPath::TABLE_SCAN) {
+                      return false;
+                    }
+                    // Temporary tables are in another storage engine.
+                    TABLE *table = path->filter().child->table_scan().table;
+                    if (table->s->tmp_table == NO_TMP_TABLE) {
+                      table->file->cond_push(path->filter().condition);
+                    }
+                    return false;
+                  });
+  return false;
+}
+
+static handler *Create(handlerton *hton, TABLE_SHARE *table_share, bool,
+                       MEM_ROOT *mem_root) {
+  return new (mem_root) columnar::ha_columnar(hton, table_share);
+}
+
+static int Init(MYSQL_PLUGIN p) {
+  loaded_tables = new LoadedTables();
+
+  handlerton *hton = static_cast<handlerton *>(p);
+  hton->create = Create;
+  hton->state = SHOW_OPTION_YES;
+  hton->flags = HTON_IS_SECONDARY_ENGINE;
+  hton->db_type = DB_TYPE_UNKNOWN;
+  hton->prepare_secondary_engine = PrepareSecondaryEngine;
+  hton->optimize_secondary_engine = OptimizeSecondaryEngine;
+  hton->secondary_engine_flags =
+      MakeSecondaryEngineFlags(SecondaryEngineFlag::SUPPORTS_HASH_JOIN);
+  return 0;
+}
+
+static int Deinit(MYSQL_PLUGIN) {
+  delete loaded_tables;
+  loaded_tables = nullptr;
+  return 0;
+}
+
+static st_mysql_storage_engine columnar_storage_engine{
+    MYSQL_HANDLERTON_INTERFACE_VERSION};
+
+mysql_declare_plugin(columnar){
+    MYSQL_STORAGE_ENGINE_PLUGIN,
+    &columnar_storage_engine,
+    "COLUMNAR",
+    PLUGIN_AUTHOR_ORACLE,
+    "In-memory columnar secondary storage engine",
+    PLUGIN_LICENSE_GPL,
+    Init,
+    nullptr,
+    Deinit,
+    0x0001,
+    nullptr,
+    nullptr,
+    nullptr,
+    0,
+} mysql_declare_plugin_end;
@@ -0,0 +1,166 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License, version 2.0,
+   as published by the Free Software Foundation.
+
+   This program is also distributed with certain software (including
+   but not limited to OpenSSL) that is licensed under separate terms,
+   as designated in a particular file or component or in included license
+   documentation.  The authors of MySQL hereby grant you an additional
+   permission to link the program and your derivative works with the
+   separately licensed software that they have included with MySQL.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License, version 2.0, for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+#ifndef PLUGIN_SECONDARY_ENGINE_COLUMNAR_HA_COLUMNAR_H_
+#define PLUGIN_SECONDARY_ENGINE_COLUMNAR_HA_COLUMNAR_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "my_base.h"
+#include "sql/handler.h"
+#include "thr_lock.h"
+
+class Field;
+class Item;
+class THD;
+struct TABLE;
+struct TABLE_SHARE;
+
+namespace dd {
+class Table;
+}
+
+namespace columnar {
+
+struct Columnar_table;
+
+/**
+ * The COLUMNAR storage engine is an in-memory secondary storage engine that
+ * keeps a copy of a table column by column.
+ *
+ * ALTER TABLE ... SECONDARY_LOAD reads the table from the primary storage
+ * engine with its parallel scan, and stores the rows in row groups. Within a
+ * row group, each column is dictionary encoded, and the codes are run-length
+ * encoded, so that columns with few distinct values or long runs of the same
+ * value take little memory. Queries read the rows back with table scans,
+ * and are otherwise executed by the server.
+ *
+ * Each row group also has the smallest and largest value of each column.
+ * Comparisons of a column with a constant in the condition of a table scan
+ * are pushed to the handler, and the scan skips the row groups whose values
+ * cannot satisfy them. The server still evaluates the whole condition.
+ *
+ * The copy is a snapshot: changes in the primary table are not seen until
+ * the table is loaded again. Tables with BLOB or virtual generated columns
+ * cannot be loaded.
+ *
+ * @note This storage engine does not support being set as a primary
+ * storage engine.
+ */
+class ha_columnar : public handler {
+ public:
+  ha_columnar(handlerton *hton, TABLE_SHARE *table_share);
+
+ private:
+  int create(const char *, TABLE *, HA_CREATE_INFO *, dd::Table *) override {
+    return HA_ERR_WRONG_COMMAND;
+  }
+
+  int open(const char *name, int mode, unsigned int test_if_locked,
+           const dd::Table *table_def) override;
+
+  int close() override;
+
+  int rnd_init(bool scan) override;
+
+  int rnd_next(unsigned char *buf) override;
+
+  int rnd_pos(unsigned char *buf, unsigned char *pos) override;
+
+  int info(unsigned int) override;
+
+  const Item *cond_push(const Item *cond) override;
+
+  int reset() override;
+
+  ha_rows records_in_range(unsigned int index, key_range *min_key,
+                           key_range *max_key) override;
+
+  void position(const unsigned char *) override;
+
+  unsigned long index_flags(unsigned int, unsigned int, bool) const override;
+
+  THR_LOCK_DATA **store_lock(THD *thd, THR_LOCK_DATA **to,
+                             thr_lock_type lock_type) override;
+
+  Table_flags table_flags() const override;
+
+  const char *table_type() const override { return "COLUMNAR"; }
+
+  int load_table(const TABLE &table) override;
+
+  int unload_table(const char *db_name, const char *table_name,
+                   bool error_if_not_loaded) override;
+
+  /// A comparison of a column with constants in the pushed condition, as a
+  /// range of the values of the column.
+  struct Zone_predicate {
+    Field *field;
+    /// The column of the field in the loaded table.
+    size_t column;
+    /// The bounds of the range, nullptr if there is none.
+    Item *low;
+    Item *high;
+    bool low_inclusive;
+    bool high_inclusive;
+    /// The bounds in the record format of the field, evaluated when the
+    /// scan starts. Empty if there is no bound, or it cannot be used.
+    std::string low_value;
+    std::string high_value;
+  };
+
+  /// Add the comparisons in a condition that row groups can be skipped by.
+  void add_zone_predicates(const Item *cond);
+
+  /// Evaluate the bounds of the pushed comparisons for a scan.
+  void evaluate_zone_predicates();
+
+  /// Check if some rows of a row group may satisfy the pushed comparisons.
+  bool may_match(size_t row_group) const;
+
+  THR_LOCK_DATA m_lock;
+
+  /// The loaded table. Shared, so that the table can be unloaded or loaded
+  /// again while this handler is reading it.
+  std::shared_ptr<const Columnar_table> m_table;
+
+  /// Position of the table scan: the row group, and the row within it.
+  size_t m_row_group{0};
+  size_t m_row{0};
+
+  /// The run and the offset within the run of each column, for the next row
+  /// of the table scan.
+  std::unique_ptr<size_t[]> m_runs;
+  std::unique_ptr<size_t[]> m_run_offsets;
+
+  /// Number of the row last returned, for position().
+  uint64_t m_last_row{0};
+
+  /// The comparisons of the pushed condition.
+  std::vector<Zone_predicate> m_zone_predicates;
+};
+
+}  // namespace columnar
+
+#endif  // PLUGIN_SECONDARY_ENGINE_COLUMNAR_HA_COLUMNAR_H_
@@ -250,17 +250,30 @@ struct Prefer_RAM_over_MMAP_policy {
  * updated during the duration of some query which is running within the same
  * session. Separate sessions can still of course change this value to their
  * liking.
+ *
+ * If temptable_spill_to_mmap is set, a table that reaches the threshold is
+ * given MMAP-backed blocks from then on, as long as the global MMAP threshold
+ * allows, instead of failing with RECORD_FILE_FULL.
  * */
 struct Prefer_RAM_over_MMAP_policy_obeying_per_table_limit {
   static Source block_source(uint32_t block_size,
                              TableResourceMonitor *table_resource_monitor) {
     assert(table_resource_monitor);
-    assert(table_resource_monitor->consumption() <=
-           table_resource_monitor->threshold());
 
     if (table_resource_monitor->consumption() + block_size >
-        table_resource_monitor->threshold())
+        table_resource_monitor->threshold()) {
+      /* With temptable_spill_to_mmap the table goes on in MMAP-backed files
+       * in its own format, which is much cheaper than converting it to an
+       * on-disk table. Only the global MMAP threshold limits it then. */
+      if (temptable_spill_to_mmap) {
+        if (MemoryMonitor::MMAP::increase(block_size) <=
+            MemoryMonitor::MMAP::threshold()) {
+          return Source::MMAP_FILE;
+        }
+        MemoryMonitor::MMAP::decrease(block_size);
+      }
       throw Result::RECORD_FILE_FULL;
+    }
 
     return Prefer_RAM_over_MMAP_policy::block_source(block_size);
   }
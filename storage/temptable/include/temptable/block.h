@@ -35,6 +35,7 @@ Block abstraction for temptable-allocator. */
 #include "memory_debugging.h"
 #include "my_dbug.h"
 #include "mysql/psi/mysql_memory.h"
+#include "storage/temptable/include/temptable/block_cache.h"
 #include "storage/temptable/include/temptable/chunk.h"
 #include "storage/temptable/include/temptable/header.h"
 #include "storage/temptable/include/temptable/memutils.h"
@@ -283,7 +284,10 @@ static inline uint8_t *allocate_from(Source src, size_t size) {
   raw_size += PSI_HEADER_SIZE;
 #endif
   if (src == Source::RAM) {
-    ptr = Memory<Source::RAM>::allocate(raw_size);
+    ptr = Block_cache::fetch(size, raw_size);
+    if (ptr == nullptr) {
+      ptr = Memory<Source::RAM>::allocate(raw_size);
+    }
     Block_PSI_track_physical_ram_allocation(ptr, size);
   } else if (src == Source::MMAP_FILE) {
     ptr = Memory<Source::MMAP_FILE>::allocate(raw_size);
@@ -306,7 +310,9 @@ static inline void deallocate_from(Source src, size_t size,
 #endif
   if (src == Source::RAM) {
     Block_PSI_track_physical_ram_deallocation(raw_block_address);
-    Memory<Source::RAM>::deallocate(raw_block_address, raw_size);
+    if (!Block_cache::retain(raw_block_address, size, raw_size)) {
+      Memory<Source::RAM>::deallocate(raw_block_address, raw_size);
+    }
   } else if (src == Source::MMAP_FILE) {
     Block_PSI_track_physical_disk_deallocation(raw_block_address);
     Memory<Source::MMAP_FILE>::deallocate(raw_block_address, raw_size);
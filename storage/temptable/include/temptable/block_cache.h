@@ -0,0 +1,103 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License, version 2.0, as published by the
+Free Software Foundation.
+
+This program is also distributed with certain software (including but not
+limited to OpenSSL) that is licensed under separate terms, as designated in a
+particular file or component or in included license documentation. The authors
+of MySQL hereby grant you an additional permission to link the program and
+your derivative works with the separately licensed software that they have
+included with MySQL.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License, version 2.0,
+for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/** @file storage/temptable/include/temptable/block_cache.h
+TempTable cache of freed RAM blocks. */
+
+#ifndef TEMPTABLE_BLOCK_CACHE_H
+#define TEMPTABLE_BLOCK_CACHE_H
+
+#include <atomic>  /* std::atomic */
+#include <cstddef> /* size_t */
+#include <cstdint> /* uint8_t, uint64_t */
+
+#include "storage/temptable/include/temptable/constants.h"
+#include "storage/temptable/include/temptable/lock_free_pool.h"
+
+namespace temptable {
+
+/** Lock-free cache of the memory of freed RAM blocks.
+ *
+ * Blocks are mostly allocated with the sizes of the exponential growth policy,
+ * 1 MiB << n. Threads that keep creating and dropping small tables would
+ * allocate and free blocks of these sizes from the OS over and over again.
+ * Instead, the memory of a freed block of such a size is kept in the slot pool
+ * of its size class, and the next allocation of a block of the same size takes
+ * it from there. At most BLOCK_CACHE_MAX_BYTES are kept in all size classes
+ * together.
+ *
+ * The memory in the cache is not accounted for in MemoryMonitor, it was
+ * released by the table that used it. */
+class Block_cache {
+ public:
+  /** Take memory of a given size out of the cache.
+   * @return memory or nullptr if there is none of that size */
+  static uint8_t *fetch(
+      /** [in] Size of the block, excluding any PSI header. */
+      size_t block_size,
+      /** [in] Size of the memory to fetch, including any PSI header. */
+      size_t raw_size);
+
+  /** Put the memory of a freed block into the cache.
+   * @return true if kept, false if the caller must free the memory */
+  static bool retain(
+      /** [in] Memory of the block. */
+      uint8_t *memory,
+      /** [in] Size of the block, excluding any PSI header. */
+      size_t block_size,
+      /** [in] Size of the memory, including any PSI header. */
+      size_t raw_size);
+
+  /** Free all memory in the cache. */
+  static void clear();
+
+  /** Number of block allocations served from the cache. */
+  static std::atomic<uint64_t> hits;
+
+  /** Number of block allocations of a cacheable size that had to allocate
+   * memory. */
+  static std::atomic<uint64_t> misses;
+
+  /** Number of bytes in the cache. */
+  static std::atomic<size_t> bytes;
+
+ private:
+  /** Number of size classes, one for each block size 1 MiB << n. */
+  static constexpr size_t SIZE_CLASSES = ALLOCATOR_MAX_BLOCK_MB_EXP + 1;
+
+  /** Number of slots per size class. */
+  static constexpr size_t SLOTS_PER_CLASS = 64;
+
+  /** Get the size class of a block size.
+   * @return size class or SIZE_CLASSES if the size is not cacheable */
+  static size_t size_class(size_t block_size);
+
+  /** Slots of cached memory of a size class, nullptr if free. */
+  using Slots = Lock_free_pool<uint8_t *, SLOTS_PER_CLASS>;
+
+  /** Slots of each size class. */
+  static Slots slots[SIZE_CLASSES];
+};
+
+} /* namespace temptable */
+
+#endif /* TEMPTABLE_BLOCK_CACHE_H */
@@ -64,12 +64,21 @@ constexpr size_t ALLOCATOR_MAX_BLOCK_MB_EXP = 9;
 constexpr size_t ALLOCATOR_MAX_BLOCK_BYTES = 1_MiB
                                              << ALLOCATOR_MAX_BLOCK_MB_EXP;
 
+/** Limit on the memory of freed RAM blocks that `Block_cache` keeps for reuse
+ * (in bytes). */
+constexpr size_t BLOCK_CACHE_MAX_BYTES = 128_MiB;
+
 /** `Storage` page size. */
 constexpr size_t STORAGE_PAGE_SIZE = 64_KiB;
 
 /** Number of buckets to have by default in a hash index. */
 constexpr size_t INDEX_DEFAULT_HASH_TABLE_BUCKETS = 1024;
 
+/** Number of slots of a unique hash index after its first insert. It is small,
+ * because the index grows incrementally and iterating over it visits empty
+ * slots too. Must be a power of 2. */
+constexpr size_t INDEX_DEFAULT_HASH_TABLE_SLOTS = 64;
+
 /** Store build-type information into the constexpr expression. */
 #ifndef NDEBUG
 constexpr bool DEBUG_BUILD = true;
@@ -27,10 +27,10 @@ TempTable index containers declarations. */
 #define TEMPTABLE_CONTAINERS_H
 
 #include <set>           /* std::multiset */
-#include <type_traits>   /* std::is_same */
 #include <unordered_set> /* std::unordered_set, std::unordered_multiset */
 
 #include "storage/temptable/include/temptable/allocator.h" /* temptable::Allocator */
+#include "storage/temptable/include/temptable/hash_table.h" /* temptable::Hash_table */
 #include "storage/temptable/include/temptable/indexed_cells.h" /* temptable::Indexed_cells */
 
 namespace temptable {
@@ -47,14 +47,7 @@ typedef std::unordered_multiset<Indexed_cells, Indexed_cells_hash,
     Hash_duplicates_container;
 
 /** The container used by hash unique indexes. */
-typedef std::unordered_set<Indexed_cells, Indexed_cells_hash,
-                           Indexed_cells_equal_to, Allocator<Indexed_cells>>
-    Hash_unique_container;
-
-static_assert(
-    std::is_same<Hash_duplicates_container::const_iterator,
-                 Hash_unique_container::const_iterator>::value,
-    "Duplicates and unique hash tables must have the same iterator type.");
+typedef Hash_table Hash_unique_container;
 
 } /* namespace temptable */
 
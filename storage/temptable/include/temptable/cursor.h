@@ -47,6 +47,11 @@ class Cursor {
       /** [in] Iterator for cursor initial position. */
       const Hash_duplicates_container::const_iterator &iterator);
 
+  /** Constructor from `Hash_unique` iterator. */
+  explicit Cursor(
+      /** [in] Iterator for cursor initial position. */
+      const Hash_unique_container::const_iterator &iterator);
+
   /** Constructor from `Tree` iterator. */
   explicit Cursor(
       /** [in] Iterator for cursor initial position. */
@@ -80,10 +85,16 @@ class Cursor {
       /** [in] Presumed length of the mysql row in bytes. */
       size_t mysql_row_length) const;
 
-  /** Get the underlying hash iterator. The cursor must be on a hash index.
+  /** Get the underlying hash iterator. The cursor must be on a non-unique
+   * hash index.
    * @return iterator */
   const Hash_duplicates_container::const_iterator &hash_iterator() const;
 
+  /** Get the underlying hash iterator. The cursor must be on a unique hash
+   * index.
+   * @return iterator */
+  const Hash_unique_container::const_iterator &hash_unique_iterator() const;
+
   /** Get the underlying tree iterator. The cursor must be on a tree index.
    * @return iterator */
   const Tree_container::const_iterator &tree_iterator() const;
@@ -117,8 +128,10 @@ class Cursor {
  private:
   /** Type of the index the cursor iterates over. */
   enum class Type : uint8_t {
-    /** Hash index. */
+    /** Non-unique hash index. */
     HASH,
+    /** Unique hash index. */
+    HASH_UNIQUE,
     /** Tree index. */
     TREE,
   };
@@ -132,6 +145,9 @@ class Cursor {
   /** Iterator that is used if `m_type == Type::HASH`. */
   Hash_duplicates_container::const_iterator m_hash_iterator;
 
+  /** Iterator that is used if `m_type == Type::HASH_UNIQUE`. */
+  Hash_unique_container::const_iterator m_hash_unique_iterator;
+
   /** Iterator that is used if `m_type == Type::TREE`. */
   Tree_container::const_iterator m_tree_iterator;
 };
@@ -143,6 +159,11 @@ inline Cursor::Cursor() : m_is_positioned(false) {}
 inline Cursor::Cursor(const Hash_duplicates_container::const_iterator &iterator)
     : m_type(Type::HASH), m_is_positioned(true), m_hash_iterator(iterator) {}
 
+inline Cursor::Cursor(const Hash_unique_container::const_iterator &iterator)
+    : m_type(Type::HASH_UNIQUE),
+      m_is_positioned(true),
+      m_hash_unique_iterator(iterator) {}
+
 inline Cursor::Cursor(const Tree_container::const_iterator &iterator)
     : m_type(Type::TREE), m_is_positioned(true), m_tree_iterator(iterator) {}
 
@@ -157,6 +178,10 @@ inline const Indexed_cells &Cursor::indexed_cells() const {
     return *m_hash_iterator;
   }
 
+  if (m_type == Type::HASH_UNIQUE) {
+    return *m_hash_unique_iterator;
+  }
+
   assert(m_type == Type::TREE);
   return *m_tree_iterator;
 }
@@ -168,6 +193,10 @@ inline Storage::Element *Cursor::row() const {
     return m_hash_iterator->row();
   }
 
+  if (m_type == Type::HASH_UNIQUE) {
+    return m_hash_unique_iterator->row();
+  }
+
   assert(m_type == Type::TREE);
   return m_tree_iterator->row();
 }
@@ -182,6 +211,11 @@ inline void Cursor::export_row_to_mysql(const Columns &columns,
                                                 mysql_row_length);
   }
 
+  if (m_type == Type::HASH_UNIQUE) {
+    return m_hash_unique_iterator->export_row_to_mysql(columns, mysql_row,
+                                                       mysql_row_length);
+  }
+
   assert(m_type == Type::TREE);
   return m_tree_iterator->export_row_to_mysql(columns, mysql_row,
                                               mysql_row_length);
@@ -193,6 +227,12 @@ inline const Hash_duplicates_container::const_iterator &Cursor::hash_iterator()
   return m_hash_iterator;
 }
 
+inline const Hash_unique_container::const_iterator &
+Cursor::hash_unique_iterator() const {
+  assert(m_type == Type::HASH_UNIQUE);
+  return m_hash_unique_iterator;
+}
+
 inline const Tree_container::const_iterator &Cursor::tree_iterator() const {
   assert(m_type == Type::TREE);
   return m_tree_iterator;
@@ -206,6 +246,8 @@ inline Cursor &Cursor::operator=(const Cursor &rhs) {
   if (m_is_positioned) {
     if (m_type == Type::HASH) {
       m_hash_iterator = rhs.m_hash_iterator;
+    } else if (m_type == Type::HASH_UNIQUE) {
+      m_hash_unique_iterator = rhs.m_hash_unique_iterator;
     } else {
       assert(m_type == Type::TREE);
       m_tree_iterator = rhs.m_tree_iterator;
@@ -220,6 +262,8 @@ inline Cursor &Cursor::operator++() {
 
   if (m_type == Type::HASH) {
     ++m_hash_iterator;
+  } else if (m_type == Type::HASH_UNIQUE) {
+    ++m_hash_unique_iterator;
   } else {
     assert(m_type == Type::TREE);
     ++m_tree_iterator;
@@ -231,7 +275,7 @@ inline Cursor &Cursor::operator++() {
 inline Cursor &Cursor::operator--() {
   assert(m_is_positioned);
 
-  if (m_type == Type::HASH) {
+  if (m_type == Type::HASH || m_type == Type::HASH_UNIQUE) {
     /* We don't support decrement on a hash and it shouldn't be called. */
     my_abort();
   } else {
@@ -249,6 +293,10 @@ inline bool Cursor::operator==(const Cursor &other) const {
     return m_hash_iterator == other.m_hash_iterator;
   }
 
+  if (m_type == Type::HASH_UNIQUE) {
+    return m_hash_unique_iterator == other.m_hash_unique_iterator;
+  }
+
   assert(m_type == Type::TREE);
   return m_tree_iterator == other.m_tree_iterator;
 }
@@ -0,0 +1,504 @@
+/* Copyright (c) 2016, 2022, Oracle and/or its affiliates.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License, version 2.0, as published by the
+Free Software Foundation.
+
+This program is also distributed with certain software (including but not
+limited to OpenSSL) that is licensed under separate terms, as designated in a
+particular file or component or in included license documentation. The authors
+of MySQL hereby grant you an additional permission to link the program and
+your derivative works with the separately licensed software that they have
+included with MySQL.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License, version 2.0,
+for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/** @file storage/temptable/include/temptable/hash_table.h
+TempTable open addressing hash table of unique indexed cells. */
+
+#ifndef TEMPTABLE_HASH_TABLE_H
+#define TEMPTABLE_HASH_TABLE_H
+
+#include <assert.h>
+#include <cstddef>     /* size_t */
+#include <cstdint>     /* uint64_t */
+#include <new>         /* new */
+#include <type_traits> /* std::is_trivially_copyable */
+#include <utility>     /* std::pair */
+
+#include "storage/temptable/include/temptable/allocator.h" /* temptable::Allocator */
+#include "storage/temptable/include/temptable/indexed_cells.h" /* temptable::Indexed_cells */
+
+namespace temptable {
+
+/** Hash table of unique indexed cells with open addressing (linear probing).
+ *
+ * Each slot keeps the hash of its indexed cells next to them, so that a probe
+ * compares cells only if their hashes are equal and growing the table does not
+ * hash the cells again. When the table gets too full, a new slot array is
+ * allocated and the following inserts move a few slots each from the old
+ * array to the new one, so that no single insert has to move the whole table.
+ * Until then lookups search both arrays.
+ *
+ * As with std::unordered_set, an insert may invalidate all iterators. An erase
+ * leaves a tombstone in the slot and invalidates only the iterators to the
+ * erased entry. */
+class Hash_table {
+ private:
+  /** A slot of the table. */
+  struct Slot {
+    /** Hash of the indexed cells, or `EMPTY` or `ERASED`. */
+    size_t m_hash;
+
+    /** Storage for the indexed cells, valid if the slot is occupied. */
+    alignas(Indexed_cells) unsigned char m_cells[sizeof(Indexed_cells)];
+
+    /** Get the indexed cells of an occupied slot.
+     * @return indexed cells */
+    const Indexed_cells &cells() const {
+      return *reinterpret_cast<const Indexed_cells *>(m_cells);
+    }
+  };
+
+  static_assert(std::is_trivially_copyable<Indexed_cells>::value,
+                "Indexed_cells are copied into the slots as plain bytes.");
+
+ public:
+  /** Forward iterator over the entries of the table. */
+  class const_iterator {
+   public:
+    /** Constructor of an unpositioned iterator. */
+    const_iterator() = default;
+
+    /** Get the indexed cells of the current entry.
+     * @return indexed cells */
+    const Indexed_cells &operator*() const {
+      return m_table->slot_at(m_pos)->cells();
+    }
+
+    /** Get a pointer to the indexed cells of the current entry.
+     * @return a pointer to indexed cells */
+    const Indexed_cells *operator->() const { return &**this; }
+
+    /** Advance to the next entry.
+     * @return *this */
+    const_iterator &operator++() {
+      m_pos = m_table->next_occupied(m_pos + 1);
+      return *this;
+    }
+
+    /** Check if equal to another iterator.
+     * @return true if equal */
+    bool operator==(const const_iterator &other) const {
+      return m_pos == other.m_pos;
+    }
+
+    /** Check if not equal to another iterator.
+     * @return true if not equal */
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class Hash_table;
+
+    /** Constructor.
+     * @param[in] table Table to iterate over.
+     * @param[in] pos Position in the table, see `Hash_table::slot_at()`. */
+    const_iterator(const Hash_table *table, size_t pos)
+        : m_table(table), m_pos(pos) {}
+
+    /** Table that is iterated over. */
+    const Hash_table *m_table{nullptr};
+
+    /** Position in the table. */
+    size_t m_pos{0};
+  };
+
+  typedef const_iterator iterator;
+
+  /** Constructor. No memory is allocated until the first insert. */
+  Hash_table(
+      /** [in] Number of slots to allocate on the first insert, must be a
+       * power of 2. */
+      size_t initial_capacity,
+      /** [in] Hash function of indexed cells. */
+      const Indexed_cells_hash &hash,
+      /** [in] Equality of indexed cells. */
+      const Indexed_cells_equal_to &equal_to,
+      /** [in] Allocator of the slot arrays. */
+      const Allocator<Indexed_cells> &allocator);
+
+  Hash_table(const Hash_table &) = delete;
+  Hash_table &operator=(const Hash_table &) = delete;
+
+  /** Destructor. */
+  ~Hash_table();
+
+  /** Insert indexed cells, unless equal cells are already in the table.
+   * @return an iterator to the inserted or to the existing entry and whether
+   * the cells were inserted */
+  std::pair<iterator, bool> emplace(
+      /** [in] Indexed cells to insert. */
+      const Indexed_cells &cells);
+
+  /** Find the entry equal to some indexed cells.
+   * @return iterator to the entry or end() if there is none */
+  const_iterator find(
+      /** [in] Indexed cells to search for. */
+      const Indexed_cells &cells) const;
+
+  /** Erase an entry. */
+  void erase(
+      /** [in] Position of the entry to erase. */
+      const const_iterator &pos);
+
+  /** Erase all entries, keeping the current slot array. */
+  void clear();
+
+  /** Get an iterator to the first entry.
+   * @return iterator */
+  const_iterator begin() const {
+    return const_iterator(this, next_occupied(0));
+  }
+
+  /** Get an iterator after the last entry.
+   * @return iterator */
+  const_iterator end() const {
+    return const_iterator(this, m_old_capacity + m_capacity);
+  }
+
+  /** Get the number of entries.
+   * @return number of entries */
+  size_t size() const { return m_size; }
+
+ private:
+  /** Hash value of a slot that was never used. */
+  static constexpr size_t EMPTY = 0;
+
+  /** Hash value of a slot whose entry was erased or moved to the new slot
+   * array. Probes continue past such slots. */
+  static constexpr size_t ERASED = 1;
+
+  /** Number of slots of the old array that each insert moves to the new
+   * array. The new array is at least as large as the old one and both are
+   * grown when 3/4 full, so the old array is empty before the new one needs
+   * to grow. */
+  static constexpr size_t SLOTS_MOVED_PER_INSERT = 8;
+
+  /** Check if a slot holds an entry.
+   * @return true if occupied */
+  static bool is_occupied(const Slot &slot) { return slot.m_hash > ERASED; }
+
+  /** Compute the hash of indexed cells as kept in the slots. The hash of the
+   * cells is mixed, because linear probing uses its low bits, and moved out
+   * of the range of the special values `EMPTY` and `ERASED`.
+   * @return hash */
+  size_t hash(const Indexed_cells &cells) const;
+
+  /** Get the slot at a position. Positions [0, m_old_capacity) are in the
+   * old slot array, and the following m_capacity positions in the current
+   * one.
+   * @return slot */
+  const Slot *slot_at(size_t pos) const {
+    return pos < m_old_capacity ? &m_old_slots[pos]
+                                : &m_slots[pos - m_old_capacity];
+  }
+
+  /** Get the position of a slot, see `slot_at()`.
+   * @return position */
+  size_t pos_of(const Slot *slot) const {
+    if (slot >= m_old_slots && slot < m_old_slots + m_old_capacity) {
+      return slot - m_old_slots;
+    }
+    return m_old_capacity + (slot - m_slots);
+  }
+
+  /** Get the first position of an occupied slot at or after a position.
+   * @return position or the position of end() */
+  size_t next_occupied(size_t pos) const {
+    const size_t end_pos = m_old_capacity + m_capacity;
+    while (pos < end_pos && !is_occupied(*slot_at(pos))) {
+      ++pos;
+    }
+    return pos;
+  }
+
+  /** Find indexed cells in a slot array.
+   * @return slot of the cells or nullptr if not found */
+  const Slot *find_slot(
+      /** [in] Slot array to search. */
+      const Slot *slots,
+      /** [in] Number of slots of `slots`, a power of 2 or 0. */
+      size_t capacity,
+      /** [in] Hash of the cells. */
+      size_t hash_value,
+      /** [in] Cells to search for. */
+      const Indexed_cells &cells) const;
+
+  /** Put indexed cells into the current slot array. The cells must not be
+   * in the table and the array must have room for them.
+   * @return slot of the cells */
+  Slot *place(
+      /** [in] Hash of the cells. */
+      size_t hash_value,
+      /** [in] Cells to put. */
+      const Indexed_cells &cells);
+
+  /** Allocate a slot array with all slots empty.
+   * @return slot array */
+  Slot *allocate_slots(
+      /** [in] Number of slots. */
+      size_t capacity);
+
+  /** Replace the current slot array with a new one and make it the old array
+   * whose entries are moved by the following inserts. */
+  void start_rehash();
+
+  /** Move entries from the old slot array to the current one, freeing the old
+   * array once it has been moved completely. */
+  void move_slots(
+      /** [in] Maximum number of old slots to move. */
+      size_t n_slots);
+
+  /** Allocator of the slot arrays. */
+  Allocator<Slot> m_allocator;
+
+  /** Hash function of indexed cells. */
+  Indexed_cells_hash m_hash;
+
+  /** Equality of indexed cells. */
+  Indexed_cells_equal_to m_equal_to;
+
+  /** Number of slots allocated on the first insert. */
+  size_t m_initial_capacity;
+
+  /** Current slot array, where new entries go. */
+  Slot *m_slots{nullptr};
+
+  /** Number of slots of `m_slots`, a power of 2 or 0. */
+  size_t m_capacity{0};
+
+  /** Number of slots of `m_slots` that are not empty, including the erased
+   * ones. */
+  size_t m_used{0};
+
+  /** Slot array that is being moved to `m_slots`, or nullptr. */
+  Slot *m_old_slots{nullptr};
+
+  /** Number of slots of `m_old_slots`. */
+  size_t m_old_capacity{0};
+
+  /** Number of slots of `m_old_slots` that were moved. */
+  size_t m_moved{0};
+
+  /** Number of entries in both slot arrays. */
+  size_t m_size{0};
+};
+
+/* Implementation of inlined methods. */
+
+inline Hash_table::Hash_table(size_t initial_capacity,
+                              const Indexed_cells_hash &hash,
+                              const Indexed_cells_equal_to &equal_to,
+                              const Allocator<Indexed_cells> &allocator)
+    : m_allocator(allocator),
+      m_hash(hash),
+      m_equal_to(equal_to),
+      m_initial_capacity(initial_capacity) {
+  assert(m_initial_capacity > 0 &&
+         (m_initial_capacity & (m_initial_capacity - 1)) == 0);
+}
+
+inline Hash_table::~Hash_table() {
+  if (m_slots != nullptr) {
+    m_allocator.deallocate(m_slots, m_capacity);
+  }
+  if (m_old_slots != nullptr) {
+    m_allocator.deallocate(m_old_slots, m_old_capacity);
+  }
+}
+
+inline size_t Hash_table::hash(const Indexed_cells &cells) const {
+  uint64_t h = m_hash(cells);
+
+  /* Finalizer of MurmurHash3. */
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+
+  const size_t hash_value = static_cast<size_t>(h);
+  return hash_value > ERASED ? hash_value : hash_value + ERASED + 1;
+}
+
+inline const Hash_table::Slot *Hash_table::find_slot(
+    const Slot *slots, size_t capacity, size_t hash_value,
+    const Indexed_cells &cells) const {
+  if (capacity == 0) {
+    return nullptr;
+  }
+
+  const size_t mask = capacity - 1;
+
+  /* There is always an empty slot, because the arrays are never more than
+   * 3/4 used and moving entries out of the old array leaves erased slots. */
+  for (size_t i = hash_value & mask;; i = (i + 1) & mask) {
+    const Slot &slot = slots[i];
+    if (slot.m_hash == EMPTY) {
+      return nullptr;
+    }
+    if (slot.m_hash == hash_value && m_equal_to(slot.cells(), cells)) {
+      return &slot;
+    }
+  }
+}
+
+inline Hash_table::Slot *Hash_table::place(size_t hash_value,
+                                           const Indexed_cells &cells) {
+  const size_t mask = m_capacity - 1;
+
+  size_t i = hash_value & mask;
+  while (is_occupied(m_slots[i])) {
+    i = (i + 1) & mask;
+  }
+
+  Slot &slot = m_slots[i];
+  if (slot.m_hash == EMPTY) {
+    ++m_used;
+  }
+  slot.m_hash = hash_value;
+  new (slot.m_cells) Indexed_cells(cells);
+
+  return &slot;
+}
+
+inline Hash_table::Slot *Hash_table::allocate_slots(size_t capacity) {
+  /* Throws Result on failure, see Allocator::allocate(). */
+  Slot *slots = m_allocator.allocate(capacity);
+  for (size_t i = 0; i < capacity; ++i) {
+    slots[i].m_hash = EMPTY;
+  }
+  return slots;
+}
+
+inline void Hash_table::start_rehash() {
+  assert(m_old_slots == nullptr);
+
+  /* Grow unless most of the used slots are erased ones, in which case a new
+   * array of the same size gets rid of them. */
+  const size_t new_capacity =
+      (m_size + 1) * 2 <= m_capacity ? m_capacity : m_capacity * 2;
+
+  Slot *new_slots = allocate_slots(new_capacity);
+
+  m_old_slots = m_slots;
+  m_old_capacity = m_capacity;
+  m_moved = 0;
+
+  m_slots = new_slots;
+  m_capacity = new_capacity;
+  m_used = 0;
+}
+
+inline void Hash_table::move_slots(size_t n_slots) {
+  assert(m_old_slots != nullptr);
+
+  for (; n_slots > 0 && m_moved < m_old_capacity; --n_slots) {
+    Slot &slot = m_old_slots[m_moved++];
+    if (is_occupied(slot)) {
+      place(slot.m_hash, slot.cells());
+      /* Keep probes of the old array going past this slot. */
+      slot.m_hash = ERASED;
+    }
+  }
+
+  if (m_moved == m_old_capacity) {
+    m_allocator.deallocate(m_old_slots, m_old_capacity);
+    m_old_slots = nullptr;
+    m_old_capacity = 0;
+    m_moved = 0;
+  }
+}
+
+inline std::pair<Hash_table::iterator, bool> Hash_table::emplace(
+    const Indexed_cells &cells) {
+  const size_t hash_value = hash(cells);
+
+  const Slot *existing = find_slot(m_slots, m_capacity, hash_value, cells);
+  if (existing == nullptr) {
+    existing = find_slot(m_old_slots, m_old_capacity, hash_value, cells);
+  }
+  if (existing != nullptr) {
+    return std::make_pair(iterator(this, pos_of(existing)), false);
+  }
+
+  if (m_capacity == 0) {
+    m_slots = allocate_slots(m_initial_capacity);
+    m_capacity = m_initial_capacity;
+  } else if ((m_used + 1) * 4 > m_capacity * 3) {
+    if (m_old_slots != nullptr) {
+      move_slots(m_old_capacity);
+    }
+    start_rehash();
+  }
+
+  const Slot *slot = place(hash_value, cells);
+  ++m_size;
+
+  if (m_old_slots != nullptr) {
+    move_slots(SLOTS_MOVED_PER_INSERT);
+  }
+
+  return std::make_pair(iterator(this, pos_of(slot)), true);
+}
+
+inline Hash_table::const_iterator Hash_table::find(
+    const Indexed_cells &cells) const {
+  const size_t hash_value = hash(cells);
+
+  const Slot *slot = find_slot(m_slots, m_capacity, hash_value, cells);
+  if (slot == nullptr) {
+    slot = find_slot(m_old_slots, m_old_capacity, hash_value, cells);
+  }
+
+  return slot == nullptr ? end() : const_iterator(this, pos_of(slot));
+}
+
+inline void Hash_table::erase(const const_iterator &pos) {
+  assert(pos.m_table == this);
+
+  Slot *slot = const_cast<Slot *>(slot_at(pos.m_pos));
+  assert(is_occupied(*slot));
+
+  slot->m_hash = ERASED;
+  --m_size;
+}
+
+inline void Hash_table::clear() {
+  if (m_old_slots != nullptr) {
+    m_allocator.deallocate(m_old_slots, m_old_capacity);
+    m_old_slots = nullptr;
+    m_old_capacity = 0;
+    m_moved = 0;
+  }
+
+  for (size_t i = 0; i < m_capacity; ++i) {
+    m_slots[i].m_hash = EMPTY;
+  }
+
+  m_used = 0;
+  m_size = 0;
+}
+
+} /* namespace temptable */
+
+#endif /* TEMPTABLE_HASH_TABLE_H */
@@ -0,0 +1,114 @@
+/* Copyright (c) 2022, Oracle and/or its affiliates.
+
+This program is free software; you can redistribute it and/or modify it under
+the terms of the GNU General Public License, version 2.0, as published by the
+Free Software Foundation.
+
+This program is also distributed with certain software (including but not
+limited to OpenSSL) that is licensed under separate terms, as designated in a
+particular file or component or in included license documentation. The authors
+of MySQL hereby grant you an additional permission to link the program and
+your derivative works with the separately licensed software that they have
+included with MySQL.
+
+This program is distributed in the hope that it will be useful, but WITHOUT
+ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+FOR A PARTICULAR PURPOSE. See the GNU General Public License, version 2.0,
+for more details.
+
+You should have received a copy of the GNU General Public License along with
+this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
+
+/** @file storage/temptable/src/block_cache.cc
+TempTable cache of freed RAM blocks implementation. */
+
+#include "storage/temptable/include/temptable/block_cache.h"
+
+#include "my_psi_config.h"
+#include "mysql/psi/mysql_memory.h"
+#include "storage/temptable/include/temptable/constants.h"
+#include "storage/temptable/include/temptable/memutils.h"
+
+namespace temptable {
+
+std::atomic<uint64_t> Block_cache::hits(0);
+std::atomic<uint64_t> Block_cache::misses(0);
+std::atomic<size_t> Block_cache::bytes(0);
+Block_cache::Slots Block_cache::slots[Block_cache::SIZE_CLASSES];
+
+size_t Block_cache::size_class(size_t block_size) {
+  for (size_t i = 0; i < SIZE_CLASSES; ++i) {
+    if (block_size == (1_MiB << i)) {
+      return i;
+    }
+  }
+  return SIZE_CLASSES;
+}
+
+uint8_t *Block_cache::fetch(size_t block_size, size_t raw_size) {
+  const size_t cls = size_class(block_size);
+  if (cls == SIZE_CLASSES) {
+    return nullptr;
+  }
+
+  Slots &pool = slots[cls];
+
+  for (size_t i = 0; i < pool.size(); ++i) {
+    uint8_t *memory = pool.load(i, std::memory_order_relaxed);
+    if (memory != nullptr && pool.compare_exchange_strong(i, memory, nullptr)) {
+      bytes.fetch_sub(raw_size);
+      hits.fetch_add(1, std::memory_order_relaxed);
+      return memory;
+    }
+  }
+
+  misses.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+bool Block_cache::retain(uint8_t *memory, size_t block_size,
+                         size_t raw_size) {
+  const size_t cls = size_class(block_size);
+  if (cls == SIZE_CLASSES) {
+    return false;
+  }
+
+  if (bytes.fetch_add(raw_size) + raw_size > BLOCK_CACHE_MAX_BYTES) {
+    bytes.fetch_sub(raw_size);
+    return false;
+  }
+
+  Slots &pool = slots[cls];
+
+  for (size_t i = 0; i < pool.size(); ++i) {
+    uint8_t *expected = nullptr;
+    if (pool.load(i, std::memory_order_relaxed) == nullptr &&
+        pool.compare_exchange_strong(i, expected, memory)) {
+      return true;
+    }
+  }
+
+  bytes.fetch_sub(raw_size);
+  return false;
+}
+
+void Block_cache::clear() {
+  for (size_t cls = 0; cls < SIZE_CLASSES; ++cls) {
+    size_t raw_size = 1_MiB << cls;
+#ifdef HAVE_PSI_MEMORY_INTERFACE
+    raw_size += PSI_HEADER_SIZE;
+#endif
+    Slots &pool = slots[cls];
+    for (size_t i = 0; i < pool.size(); ++i) {
+      uint8_t *memory = pool.load(i);
+      if (memory != nullptr &&
+          pool.compare_exchange_strong(i, memory, nullptr)) {
+        bytes.fetch_sub(raw_size);
+        Memory<Source::RAM>::deallocate(memory, raw_size);
+      }
+    }
+  }
+}
+
+} /* namespace temptable */
@@ -214,7 +214,7 @@ Cursor Hash_duplicates::end() const { return Cursor(m_hash_table.end()); }
 Hash_unique::Hash_unique(const Table &table, const KEY &mysql_index,
                          const Allocator<Indexed_cells> &allocator)
     : Index(table, mysql_index),
-      m_hash_table(INDEX_DEFAULT_HASH_TABLE_BUCKETS, Indexed_cells_hash(*this),
+      m_hash_table(INDEX_DEFAULT_HASH_TABLE_SLOTS, Indexed_cells_hash(*this),
                    Indexed_cells_equal_to(*this), allocator) {}
 
 Result Hash_unique::insert(const Indexed_cells &indexed_cells,
@@ -246,22 +246,24 @@ Index::Lookup Hash_unique::lookup(const Indexed_cells &search_cells,
 
 Index::Lookup Hash_unique::lookup(const Indexed_cells &search_cells,
                                   Cursor *first, Cursor *after_last) const {
-  auto range = m_hash_table.equal_range(search_cells);
+  auto it = m_hash_table.find(search_cells);
 
-  if (range.first == m_hash_table.end()) {
+  if (it == m_hash_table.end()) {
     return Lookup::NOT_FOUND_CURSOR_UNDEFINED;
   }
 
-  *first = Cursor(range.first);
+  *first = Cursor(it);
   if (after_last != nullptr) {
-    *after_last = Cursor(range.second);
+    /* The entries are unique, so the range ends right after the found one. */
+    ++it;
+    *after_last = Cursor(it);
   }
 
   return Lookup::FOUND;
 }
 
 void Hash_unique::erase(const Cursor &target) {
-  m_hash_table.erase(target.hash_iterator());
+  m_hash_table.erase(target.hash_unique_iterator());
 }
 
 void Hash_unique::truncate() { m_hash_table.clear(); }
@@ -28,6 +28,7 @@ Glue code for registering the TempTable plugin at MySQL. */
 #include "sql/handler.h"
 #include "sql/table.h"
 #include "storage/temptable/include/temptable/allocator.h"
+#include "storage/temptable/include/temptable/block_cache.h"
 #include "storage/temptable/include/temptable/handler.h"
 
 struct MEM_ROOT;
@@ -63,6 +64,41 @@ static int init(void *p) {
   return 0;
 }
 
+static int deinit(void *) {
+  temptable::Block_cache::clear();
+  return 0;
+}
+
+/** Copies of the Block_cache counters for SHOW STATUS. */
+static ulonglong block_cache_hits;
+static ulonglong block_cache_misses;
+static ulonglong block_cache_bytes;
+
+static SHOW_VAR temptable_status_variables[] = {
+    {"block_cache_hits", (char *)&block_cache_hits, SHOW_LONGLONG,
+     SHOW_SCOPE_GLOBAL},
+    {"block_cache_misses", (char *)&block_cache_misses, SHOW_LONGLONG,
+     SHOW_SCOPE_GLOBAL},
+    {"block_cache_bytes", (char *)&block_cache_bytes, SHOW_LONGLONG,
+     SHOW_SCOPE_GLOBAL},
+    {NullS, NullS, SHOW_LONG, SHOW_SCOPE_GLOBAL}};
+
+static int show_temptable_vars(THD *, SHOW_VAR *var, char *) {
+  block_cache_hits = temptable::Block_cache::hits.load();
+  block_cache_misses = temptable::Block_cache::misses.load();
+  block_cache_bytes = temptable::Block_cache::bytes.load();
+
+  var->type = SHOW_ARRAY;
+  var->value = (char *)&temptable_status_variables;
+  var->scope = SHOW_SCOPE_GLOBAL;
+
+  return 0;
+}
+
+static SHOW_VAR temptable_status_variables_export[] = {
+    {"Temptable", (char *)&show_temptable_vars, SHOW_FUNC, SHOW_SCOPE_GLOBAL},
+    {NullS, NullS, SHOW_LONG, SHOW_SCOPE_GLOBAL}};
+
 // clang-format off
 mysql_declare_plugin(temptable) {
   MYSQL_STORAGE_ENGINE_PLUGIN,
@@ -75,11 +111,11 @@ mysql_declare_plugin(temptable) {
   /* check uninstall */
   nullptr,
   /* destroy */
-  nullptr,
+  deinit,
   /* 1.0 */
   0x0100,
   /* status variables */
-  nullptr,
+  temptable_status_variables_export,
   /* system variables */
   nullptr,
   /* config options */
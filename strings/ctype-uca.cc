@@ -1605,6 +1605,27 @@ ALWAYS_INLINE void uca_scanner_900<Mb_wc, LEVELS_FOR_COMPARE>::for_each_weight(
       we'd otherwise have to do.
     */
     const uchar *sbeg_local = sbeg;
+
+    /*
+      Same as the loop below, but eight bytes at a time. The range check
+      works lane by lane just like the 32-bit version does, since lanes
+      that are in range never produce a carry or a borrow.
+    */
+    while (send - sbeg_local >= 8 &&
+           preaccept_data(sizeof(uint64))) {
+      uint64 eight_bytes;
+      memcpy(&eight_bytes, sbeg_local, sizeof(eight_bytes));
+      if (((eight_bytes + 0x0101010101010101ULL) & 0x8080808080808080ULL) ||
+          ((eight_bytes - 0x2020202020202020ULL) & 0x8080808080808080ULL))
+        break;
+      for (int i = 0; i < 8; ++i) {
+        const int s_res = ascii_wpage[sbeg_local[i]];
+        assert(s_res != 0);
+        func(s_res, /*is_level_separator=*/false);
+      }
+      sbeg_local += sizeof(uint64);
+    }
+
     while (sbeg_local < send_local && preaccept_data(sizeof(uint32))) {
       /*
         Check if all four bytes are in the range 0x20..0x7e, inclusive.
@@ -4891,9 +4912,80 @@ static size_t my_strnxfrm_any_uca(const CHARSET_INFO *cs, uchar *dst,
                          flags);
 }
 
+/**
+  Skip the leading printable ASCII characters (0x20..0x7e) that two strings
+  have in common, before handing the rest over to the scanners.
+
+  In collations without tailoring or reordering, each of these characters
+  is a single byte with exactly one weight per level, independent of its
+  neighbours, so a common prefix contributes equal weights on every level
+  and can be dropped from both strings. When comparing on the primary level
+  only, characters with equal weights (e.g. 'a' and 'A') count as common,
+  and the first pair with different weights decides the comparison.
+
+  @param cs              the collation
+  @param[in,out] s       first string; advanced past the common prefix
+  @param[in,out] slen    length of the first string
+  @param[in,out] t       second string; advanced past the common prefix
+  @param[in,out] tlen    length of the second string
+  @param[out] result     set to the comparison result if one was found
+
+  @retval true   the comparison was decided, see "result"
+  @retval false  compare the remainders of the strings
+*/
+static bool my_strnncoll_uca_900_ascii_prefix(const CHARSET_INFO *cs,
+                                              const uchar **s, size_t *slen,
+                                              const uchar **t, size_t *tlen,
+                                              int *result) {
+  if (cs->tailoring || cs->mbminlen != 1 || cs->coll_param) return false;
+
+  const uchar *sp = *s;
+  const uchar *tp = *t;
+  const size_t len = std::min(*slen, *tlen);
+  const uchar *const end = sp + len;
+
+  // Eight identical printable bytes at a time.
+  while (end - sp >= 8) {
+    uint64 s8, t8;
+    memcpy(&s8, sp, sizeof(s8));
+    memcpy(&t8, tp, sizeof(t8));
+    if (s8 != t8 || ((s8 + 0x0101010101010101ULL) & 0x8080808080808080ULL) ||
+        ((s8 - 0x2020202020202020ULL) & 0x8080808080808080ULL))
+      break;
+    sp += 8;
+    tp += 8;
+  }
+
+  const uint16 *ascii_wpage =
+      UCA900_WEIGHT_ADDR(cs->uca->weights[0], /*level=*/0, /*subcode=*/0);
+  for (; sp < end; ++sp, ++tp) {
+    const uchar sc = *sp;
+    const uchar tc = *tp;
+    if (sc < 0x20 || sc > 0x7e || tc < 0x20 || tc > 0x7e) break;
+    if (sc == tc) continue;
+    if (cs->levels_for_compare != 1) break;
+    const int s_res = ascii_wpage[sc];
+    const int t_res = ascii_wpage[tc];
+    if (s_res != t_res) {
+      *result = s_res - t_res;
+      return true;
+    }
+  }
+
+  *slen -= sp - *s;
+  *tlen -= tp - *t;
+  *s = sp;
+  *t = tp;
+  return false;
+}
+
 static int my_strnncoll_uca_900(const CHARSET_INFO *cs, const uchar *s,
                                 size_t slen, const uchar *t, size_t tlen,
                                 bool t_is_prefix) {
+  int result;
+  if (my_strnncoll_uca_900_ascii_prefix(cs, &s, &slen, &t, &tlen, &result))
+    return result;
+
   if (cs->cset->mb_wc == my_mb_wc_utf8mb4_thunk) {
     switch (cs->levels_for_compare) {
       case 1:
@@ -5687,6 +5687,17 @@ static size_t my_well_formed_len_utf8mb3(const CHARSET_INFO *, const char *b,
   const char *b_start = b;
   *error = 0;
   while (pos) {
+    // Fast path as long as we see ASCII characters only.
+    if (pos >= 8 && e - b >= 8) {
+      uint64_t data;
+      memcpy(&data, b, sizeof(data));
+      if (!(data & 0x8080808080808080ULL)) {
+        b += 8;
+        pos -= 8;
+        continue;
+      }
+    }
+
     int mb_len;
 
     if ((mb_len = my_valid_mbcharlen_utf8mb3(pointer_cast<const uchar *>(b),
@@ -7641,6 +7652,17 @@ static size_t my_well_formed_len_utf8mb4(const CHARSET_INFO *cs, const char *b,
   const char *b_start = b;
   *error = 0;
   while (pos) {
+    // Fast path as long as we see ASCII characters only.
+    if (pos >= 8 && e - b >= 8) {
+      uint64_t data;
+      memcpy(&data, b, sizeof(data));
+      if (!(data & 0x8080808080808080ULL)) {
+        b += 8;
+        pos -= 8;
+        continue;
+      }
+    }
+
     int mb_len;
 
     if ((mb_len = my_valid_mbcharlen_utf8mb4(cs, pointer_cast<const uchar *>(b),
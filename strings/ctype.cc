@@ -832,12 +832,17 @@ bool my_charset_is_ascii_compatible(const CHARSET_INFO *cs) {
   Convert a string between two character sets.
   'to' must be large enough to store (form_length * to_cs->mbmaxlen) bytes.
 
+  If both character sets are ASCII compatible, runs of ASCII characters
+  (0x00..0x7F) are copied as they are, eight bytes at a time, and only
+  the other characters go through mb_wc()/wc_mb().
+
   @param [out] to       Store result here
   @param  to_length     Size of "to" buffer
   @param  to_cs         Character set of result string
   @param  from          Copy from here
   @param  from_length   Length of the "from" string
   @param  from_cs       Character set of the "from" string
+  @param  ascii_copy    Whether both character sets are ASCII compatible
   @param [out] errors   Number of conversion errors
 
   @return Number of bytes copied to 'to' string
@@ -846,7 +851,8 @@ bool my_charset_is_ascii_compatible(const CHARSET_INFO *cs) {
 static size_t my_convert_internal(char *to, size_t to_length,
                                   const CHARSET_INFO *to_cs, const char *from,
                                   size_t from_length,
-                                  const CHARSET_INFO *from_cs, uint *errors) {
+                                  const CHARSET_INFO *from_cs, bool ascii_copy,
+                                  uint *errors) {
   int cnvres;
   my_wc_t wc;
   const uchar *from_end = (const uchar *)from + from_length;
@@ -857,6 +863,27 @@ static size_t my_convert_internal(char *to, size_t to_length,
   uint error_count = 0;
 
   while (true) {
+    if (ascii_copy) {
+      /*
+        We are at a character boundary, so a byte below 0x80 is an ASCII
+        character in both character sets.
+      */
+      const size_t length = std::min<size_t>(
+          from_end - pointer_cast<const uchar *>(from),
+          to_end - pointer_cast<uchar *>(to));
+      const char *ascii_end = from + length;
+      while (ascii_end - from >= 8) {
+        uint64_t data;
+        memcpy(&data, from, sizeof(data));
+        if (data & 0x8080808080808080ULL) break;
+        memcpy(to, &data, sizeof(data));
+        from += 8;
+        to += 8;
+      }
+      while (from < ascii_end && static_cast<uchar>(*from) < 0x80)
+        *to++ = *from++;
+    }
+
     if ((cnvres = (*mb_wc)(from_cs, &wc, pointer_cast<const uchar *>(from),
                            from_end)) > 0)
       from += cnvres;
@@ -915,23 +942,20 @@ size_t my_convert(char *to, size_t to_length, const CHARSET_INFO *to_cs,
   */
   if ((to_cs->state | from_cs->state) & MY_CS_NONASCII)
     return my_convert_internal(to, to_length, to_cs, from, from_length, from_cs,
-                               errors);
+                               false, errors);
 
   length = length2 = std::min(to_length, from_length);
 
-#if defined(__i386__) || defined(_WIN32) || defined(__x86_64__)
   /*
-    Special loop for i386, it allows to refer to a
-    non-aligned memory block as UINT32, which makes
-    it possible to copy four bytes at once. This
-    gives about 10% performance improvement comparing
-    to byte-by-byte loop.
+    Copy eight bytes at once as long as they are all ASCII. memcpy() keeps
+    the unaligned access portable.
   */
-  for (; length >= 4; length -= 4, from += 4, to += 4) {
-    if (uint4korr(from) & 0x80808080) break;
-    int4store(to, uint4korr(from));
+  for (; length >= 8; length -= 8, from += 8, to += 8) {
+    uint64_t data;
+    memcpy(&data, from, sizeof(data));
+    if (data & 0x8080808080808080ULL) break;
+    memcpy(to, &data, sizeof(data));
   }
-#endif /* __i386__ */
 
   for (;; *to++ = *from++, length--) {
     if (!length) {
@@ -944,7 +968,8 @@ size_t my_convert(char *to, size_t to_length, const CHARSET_INFO *to_cs,
       to_length -= copied_length;
       from_length -= copied_length;
       return copied_length + my_convert_internal(to, to_length, to_cs, from,
-                                                 from_length, from_cs, errors);
+                                                 from_length, from_cs, true,
+                                                 errors);
     }
   }
 
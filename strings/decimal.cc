@@ -1218,6 +1218,89 @@ int decimal2longlong(const decimal_t *from, longlong *to) {
   return E_DEC_OK;
 }
 
+#ifdef __SIZEOF_INT128__
+/// The largest number of decimal digits decimal2int128() produces.
+static constexpr int INT128_DIGITS = 38;
+
+/// 10^n as an unsigned 128-bit integer, for 0 <= n <= INT128_DIGITS.
+static unsigned __int128 pow10_u128(int n) {
+  assert(n >= 0 && n <= INT128_DIGITS);
+  unsigned __int128 x = 1;
+  for (; n >= DIG_PER_DEC1; n -= DIG_PER_DEC1) x *= DIG_BASE;
+  return x * powers10[n];
+}
+
+int decimal2int128(const decimal_t *from, int scale, __int128 *to) {
+  if (scale < 0 || scale > DECIMAL_MAX_SCALE || from->frac > scale)
+    return E_DEC_TRUNCATED;
+
+  const dec1 *buf = from->buf;
+  // The integral part must stay below 10^(INT128_DIGITS - scale).
+  const unsigned __int128 int_max = pow10_u128(INT128_DIGITS - scale) - 1;
+  unsigned __int128 int_part = 0;
+  for (int intg = from->intg; intg > 0; intg -= DIG_PER_DEC1) {
+    const dec1 digit = *buf++;
+    if (unlikely(int_part > (int_max - digit) / DIG_BASE))
+      return E_DEC_OVERFLOW;
+    int_part = int_part * DIG_BASE + digit;
+  }
+
+  /*
+    Fraction words are left-aligned, so the fraction has
+    ROUND_UP(frac) * DIG_PER_DEC1 digits, of which those past "frac" are
+    zero. Since frac <= scale, rescaling to "scale" digits is exact.
+  */
+  unsigned __int128 frac_part = 0;
+  const int frac_words = ROUND_UP(from->frac);
+  for (int i = 0; i < frac_words; i++) frac_part = frac_part * DIG_BASE + *buf++;
+  const int frac_digits = frac_words * DIG_PER_DEC1;
+  if (frac_digits > scale)
+    frac_part /= pow10_u128(frac_digits - scale);
+  else
+    frac_part *= pow10_u128(scale - frac_digits);
+
+  const __int128 x =
+      static_cast<__int128>(int_part * pow10_u128(scale) + frac_part);
+  *to = from->sign ? -x : x;
+  return E_DEC_OK;
+}
+
+int int1282decimal(__int128 from, int scale, decimal_t *to) {
+  assert(scale >= 0 && scale <= DECIMAL_MAX_SCALE);
+  sanity(to);
+
+  const unsigned __int128 x = from < 0 ? -static_cast<unsigned __int128>(from)
+                                       : static_cast<unsigned __int128>(from);
+  const unsigned __int128 scale_pow = pow10_u128(scale);
+  unsigned __int128 int_part = x / scale_pow;
+  const int frac_words = ROUND_UP(scale);
+  unsigned __int128 frac_part =
+      (x % scale_pow) * pow10_u128(frac_words * DIG_PER_DEC1 - scale);
+
+  int intg_words = 1;
+  for (unsigned __int128 y = int_part / DIG_BASE; y != 0; y /= DIG_BASE)
+    intg_words++;
+  if (unlikely(intg_words + frac_words > to->len)) {
+    decimal_make_zero(to);
+    return E_DEC_OVERFLOW;
+  }
+
+  to->sign = from < 0;
+  to->intg = intg_words * DIG_PER_DEC1;
+  to->frac = scale;
+  for (dec1 *buf = to->buf + intg_words; buf != to->buf;) {
+    *--buf = static_cast<dec1>(int_part % DIG_BASE);
+    int_part /= DIG_BASE;
+  }
+  for (dec1 *buf = to->buf + intg_words + frac_words;
+       buf != to->buf + intg_words;) {
+    *--buf = static_cast<dec1>(frac_part % DIG_BASE);
+    frac_part /= DIG_BASE;
+  }
+  return E_DEC_OK;
+}
+#endif  // __SIZEOF_INT128__
+
 #define LLDIV_MIN -1000000000000000000LL
 #define LLDIV_MAX 1000000000000000000LL
 
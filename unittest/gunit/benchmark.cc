@@ -24,9 +24,14 @@
 #include <math.h>
 #include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #include <algorithm>
 #include <chrono>
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
 
 using std::chrono::duration;
 using std::chrono::nanoseconds;
@@ -53,6 +58,71 @@ void StopBenchmarkTiming() {
 
 void SetBytesProcessed(size_t bytes) { bytes_processed = bytes; }
 
+#if defined(NDEBUG)
+/**
+  Read the baseline results named by MYSQL_BENCHMARK_BASELINE, as
+  written through MYSQL_BENCHMARK_OUTPUT, mapping benchmark names to
+  nanoseconds per iteration. If the same benchmark is listed several times,
+  the last entry wins.
+*/
+static const std::map<std::string, double> &baseline_results() {
+  static const std::map<std::string, double> results = [] {
+    std::map<std::string, double> ret;
+    const char *filename = getenv("MYSQL_BENCHMARK_BASELINE");
+    if (filename == nullptr) return ret;
+
+    FILE *fp = fopen(filename, "r");
+    if (fp == nullptr) {
+      fprintf(stderr, "WARNING: Could not open benchmark baseline %s.\n",
+              filename);
+      return ret;
+    }
+    char name[256];
+    double ns_per_iteration;
+    while (fscanf(fp, "%255s %lf%*[^\n]", name, &ns_per_iteration) == 2) {
+      ret[name] = ns_per_iteration;
+    }
+    fclose(fp);
+    return ret;
+  }();
+  return results;
+}
+
+/**
+  Write the result of a benchmark to MYSQL_BENCHMARK_OUTPUT, and compare it
+  to MYSQL_BENCHMARK_BASELINE, if those are set.
+*/
+static void report_benchmark_result(const char *name, size_t num_iterations,
+                                    double ns_per_iteration) {
+  const char *output_filename = getenv("MYSQL_BENCHMARK_OUTPUT");
+  if (output_filename != nullptr) {
+    FILE *fp = fopen(output_filename, "a");
+    if (fp != nullptr) {
+      fprintf(fp, "%s\t%.1f\t%lu\n", name, ns_per_iteration,
+              static_cast<unsigned long>(num_iterations));
+      fclose(fp);
+    } else {
+      fprintf(stderr, "WARNING: Could not open benchmark output %s.\n",
+              output_filename);
+    }
+  }
+
+  const auto &baseline = baseline_results();
+  const auto it = baseline.find(name);
+  if (it == baseline.end() || it->second <= 0.0) return;
+
+  const double change_pct = 100.0 * (ns_per_iteration / it->second - 1.0);
+  printf("%-40s %+9.1f%% vs. baseline %10.0f ns/iter\n", name, change_pct,
+         it->second);
+
+  const char *max_regression = getenv("MYSQL_BENCHMARK_MAX_REGRESSION");
+  if (max_regression != nullptr && change_pct > atof(max_regression)) {
+    ADD_FAILURE() << name << " took " << ns_per_iteration
+                  << " ns/iter, baseline is " << it->second << " ns/iter";
+  }
+}
+#endif
+
 void internal_do_microbenchmark(const char *name, void (*func)(size_t)) {
 #if !defined(NDEBUG)
   printf(
@@ -95,9 +165,9 @@ void internal_do_microbenchmark(const char *name, void (*func)(size_t)) {
   }
 #endif
 
+  const double ns_per_iteration = 1e9 * seconds_used / double(num_iterations);
   printf("%-40s %10ld iterations %10.0f ns/iter", name,
-         static_cast<long>(num_iterations),
-         1e9 * seconds_used / double(num_iterations));
+         static_cast<long>(num_iterations), ns_per_iteration);
 
   if (bytes_processed > 0) {
     double bytes_per_second = bytes_processed / seconds_used;
@@ -109,4 +179,8 @@ void internal_do_microbenchmark(const char *name, void (*func)(size_t)) {
   }
 
   printf("\n");
+
+#if defined(NDEBUG)
+  report_benchmark_result(name, num_iterations, ns_per_iteration);
+#endif
 }
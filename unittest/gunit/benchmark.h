@@ -26,6 +26,20 @@
   Rudimentary microbenchmark framework. The API is generally a minimal
   subset of Google's microbenchmark framework, in order to be compatible
   if we should ever import the full one.
+
+  In optimized builds, the following environment variables make it possible
+  to track results over time:
+
+  - MYSQL_BENCHMARK_OUTPUT=<file>: Append one line per benchmark to the
+    given file, with the benchmark name, the nanoseconds per iteration and
+    the number of iterations, separated by tabs.
+
+  - MYSQL_BENCHMARK_BASELINE=<file>: Read a file in the same format, and
+    print how much slower or faster each benchmark is than its baseline.
+
+  - MYSQL_BENCHMARK_MAX_REGRESSION=<percent>: Together with
+    MYSQL_BENCHMARK_BASELINE, fail benchmarks that got slower than their
+    baseline by more than the given percentage.
 */
 
 #ifndef BENCHMARK_H_INCLUDED
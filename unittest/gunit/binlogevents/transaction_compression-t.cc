@@ -200,6 +200,17 @@ TEST_F(TransactionPayloadCompressionTest, CompressDecompressZstdTest) {
   }
 }
 
+TEST_F(TransactionPayloadCompressionTest, CompressDecompressPledgedZstdTest) {
+  for (auto size : m_payloads) {
+    binary_log::transaction::compression::Zstd_dec d;
+    binary_log::transaction::compression::Zstd_comp c;
+    c.set_pledged_input_size(size);
+    TransactionPayloadCompressionTest::compression_idempotency_test(c, d, size);
+    // the announced size only applies to the stream opened right after it
+    TransactionPayloadCompressionTest::compression_idempotency_test(c, d, size);
+  }
+}
+
 TEST_F(TransactionPayloadCompressionTest, CompressDecompressNoneTest) {
   for (auto size : m_payloads) {
     binary_log::transaction::compression::None_dec d;
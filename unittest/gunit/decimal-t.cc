@@ -940,6 +940,62 @@ TEST_F(DecimalTest, DecimalActualFraction) {
   test_fr("10000000000000000000.0", "10000000000000000000");
 }
 
+#ifdef __SIZEOF_INT128__
+static void test_int128_round_trip(const char *str, int scale,
+                                   const char *expected) {
+  SCOPED_TRACE(str);
+  const char *end = str + strlen(str);
+  ASSERT_EQ(E_DEC_OK, string2decimal(str, &a, &end));
+  __int128 scaled;
+  ASSERT_EQ(E_DEC_OK, decimal2int128(&a, scale, &scaled));
+  ASSERT_EQ(E_DEC_OK, int1282decimal(scaled, scale, &b));
+  char buf[100];
+  int len = sizeof(buf);
+  decimal2string(&b, buf, &len);
+  EXPECT_STREQ(expected, buf);
+}
+
+TEST_F(DecimalTest, Int128) {
+  test_int128_round_trip("0", 0, "0");
+  test_int128_round_trip("0", 2, "0.00");
+  test_int128_round_trip("12.34", 2, "12.34");
+  test_int128_round_trip("-12.34", 3, "-12.340");
+  test_int128_round_trip("-0.000000001", 9, "-0.000000001");
+  test_int128_round_trip("1234567890123.1234567891", 10,
+                         "1234567890123.1234567891");
+  test_int128_round_trip("99999999999999999999999999999999999999", 0,
+                         "99999999999999999999999999999999999999");
+  test_int128_round_trip("-9999999.999999999999999999999999999999", 30,
+                         "-9999999.999999999999999999999999999999");
+  test_int128_round_trip("0.123456789012345678901234567891", 30,
+                         "0.123456789012345678901234567891");
+
+  // Sums of scaled values convert back to the decimal sum.
+  const char *str = "45983.16";
+  const char *end = str + strlen(str);
+  string2decimal(str, &a, &end);
+  __int128 scaled;
+  ASSERT_EQ(E_DEC_OK, decimal2int128(&a, 2, &scaled));
+  ASSERT_EQ(E_DEC_OK, int1282decimal(scaled * 1000, 2, &b));
+  char buf[100];
+  int len = sizeof(buf);
+  decimal2string(&b, buf, &len);
+  EXPECT_STREQ("45983160.00", buf);
+
+  // Too many fractional digits for the scale.
+  str = "1.234";
+  end = str + strlen(str);
+  string2decimal(str, &a, &end);
+  EXPECT_EQ(E_DEC_TRUNCATED, decimal2int128(&a, 2, &scaled));
+
+  // More than 38 digits.
+  str = "99999999999999999999999999999999999999";
+  end = str + strlen(str);
+  string2decimal(str, &a, &end);
+  EXPECT_EQ(E_DEC_OVERFLOW, decimal2int128(&a, 1, &scaled));
+}
+#endif
+
 // Some test data from DBT-3.
 static const char *decimal_testdata[] = {
     "45983.16", "0.09",     "983",      "0.09",     "36.00",    "45983.16",
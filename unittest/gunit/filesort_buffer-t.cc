@@ -23,12 +23,19 @@
 #include <gtest/gtest.h>
 #include <stddef.h>
 #include <sys/types.h>
+#include <algorithm>
+#include <random>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "my_inttypes.h"
 #include "my_pointer_arithmetic.h"
+#include "myisampack.h"
 #include "sql/filesort_utils.h"
+#include "sql/sort_param.h"
 #include "sql/table.h"
+#include "template_utils.h"
 
 namespace filesort_buffer_unittest {
 
@@ -162,4 +169,82 @@ TEST_F(FileSortBufferTest, PreallocateRecords) {
   }
 }
 
+// Sort enough rows for several threads to get a slice each, with many
+// duplicate keys, and check that the result is sorted and stable.
+TEST_F(FileSortBufferTest, ParallelSortIsStable) {
+  constexpr uint kNumRows = 100000;
+  constexpr uint kKeyLength = 4;
+  constexpr uint kRecordLength = 8;  // Key followed by the row number.
+
+  fs_info.set_max_size(16 * 1024 * 1024, kRecordLength);
+  for (uint ix = 0; ix < kNumRows; ++ix) {
+    Bounds_checked_array<uchar> buf =
+        fs_info.get_next_record_pointer(kRecordLength);
+    ASSERT_GE(buf.size(), kRecordLength);
+    mi_int4store(buf.array(), (ix * 7919) % 1000);
+    mi_int4store(buf.array() + kKeyLength, ix);
+    fs_info.commit_used_memory(kRecordLength);
+  }
+
+  Sort_param param;
+  param.set_max_compare_length(kKeyLength);
+  param.set_max_record_length(kRecordLength);
+  param.m_num_sort_threads = 4;
+  EXPECT_EQ(kNumRows, fs_info.sort_buffer(&param, kNumRows, HA_POS_ERROR));
+  EXPECT_EQ(Sort_param::FILESORT_ALG_RADIX, param.m_sort_algorithm);
+
+  uchar **data = fs_info.get_sort_keys();
+  for (uint ix = 1; ix < kNumRows; ++ix) {
+    const uint prev_key = mi_uint4korr(data[ix - 1]);
+    const uint key = mi_uint4korr(data[ix]);
+    ASSERT_LE(prev_key, key) << "index:" << ix;
+    if (prev_key == key) {
+      ASSERT_LT(mi_uint4korr(data[ix - 1] + kKeyLength),
+                mi_uint4korr(data[ix] + kKeyLength))
+          << "index:" << ix;
+    }
+  }
+}
+
+// Radix sort keys of varying length against std::stable_sort. Use few
+// distinct values per key byte, so that there are both large buckets that
+// are split further and small ones that are comparison sorted.
+TEST_F(FileSortBufferTest, RadixSortMatchesStableSort) {
+  constexpr uint kNumRows = 5000;
+  for (uint key_length : {1U, 3U, 8U, 16U}) {
+    const uint record_length = key_length + 4;  // Key and row number.
+    fs_info.free_sort_buffer();
+    fs_info.set_max_size(16 * 1024 * 1024, record_length);
+    std::mt19937 rng(key_length);
+    std::vector<std::string> expected;
+    for (uint ix = 0; ix < kNumRows; ++ix) {
+      Bounds_checked_array<uchar> buf =
+          fs_info.get_next_record_pointer(record_length);
+      ASSERT_GE(buf.size(), record_length);
+      for (uint i = 0; i < key_length; ++i) buf[i] = rng() % 4 * 60;
+      mi_int4store(buf.array() + key_length, ix);
+      fs_info.commit_used_memory(record_length);
+      expected.emplace_back(pointer_cast<const char *>(buf.array()),
+                            record_length);
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [key_length](const std::string &a, const std::string &b) {
+                       return memcmp(a.data(), b.data(), key_length) < 0;
+                     });
+
+    Sort_param param;
+    param.set_max_compare_length(key_length);
+    param.set_max_record_length(record_length);
+    EXPECT_EQ(kNumRows, fs_info.sort_buffer(&param, kNumRows, HA_POS_ERROR));
+    EXPECT_EQ(Sort_param::FILESORT_ALG_RADIX, param.m_sort_algorithm);
+
+    uchar **data = fs_info.get_sort_keys();
+    for (uint ix = 0; ix < kNumRows; ++ix) {
+      ASSERT_EQ(expected[ix], std::string(pointer_cast<const char *>(data[ix]),
+                                          record_length))
+          << "key length:" << key_length << " index:" << ix;
+    }
+  }
+}
+
 }  // namespace filesort_buffer_unittest
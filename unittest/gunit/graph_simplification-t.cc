@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <memory>
 #include <random>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -41,6 +42,7 @@
 #include "sql/join_optimizer/subgraph_enumeration.h"
 #include "sql/join_optimizer/trivial_receiver.h"
 #include "sql/mem_root_array.h"
+#include "sql/sql_class.h"
 #include "sql/table.h"
 #include "unittest/gunit/benchmark.h"
 #include "unittest/gunit/fake_table.h"
@@ -684,6 +686,34 @@ TEST(GraphSimplificationTest, UndoRedo) {
   EXPECT_EQ(171, s.num_steps_done());
 }
 
+TEST(GraphSimplificationTest, ParallelSearchFindsSameNumberOfSteps) {
+  my_testing::Server_initializer initializer;
+  initializer.SetUp();
+  THD *thd = initializer.thd();
+
+  std::string traces[2];
+  std::vector<hypergraph::Hyperedge> edges[2];
+  for (int i = 0; i < 2; ++i) {
+    std::mt19937 engine(1234);
+    MEM_ROOT mem_root;
+    JoinHypergraph g(&mem_root, /*query_block=*/nullptr);
+    NodeGuard node_guard =
+        CreateStarJoin(thd, /*graph_size=*/20, &engine, &mem_root, &g);
+
+    thd->variables.optimizer_simplification_threads = i == 0 ? 1 : 4;
+    SimplifyQueryGraph(thd, /*subgraph_pair_limit=*/500, &g, &traces[i]);
+    edges[i].assign(g.graph.edges.begin(), g.graph.edges.end());
+  }
+
+  EXPECT_NE(std::string::npos, traces[0].find("simplification steps"));
+  EXPECT_EQ(traces[0], traces[1]);
+  ASSERT_EQ(edges[0].size(), edges[1].size());
+  for (size_t i = 0; i < edges[0].size(); ++i) {
+    EXPECT_EQ(edges[0][i].left, edges[1][i].left);
+    EXPECT_EQ(edges[0][i].right, edges[1][i].right);
+  }
+}
+
 static void BM_FullySimplifyStarJoin(int graph_size, size_t num_iterations) {
   StopBenchmarkTiming();
 
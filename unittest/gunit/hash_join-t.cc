@@ -20,6 +20,7 @@
    along with this program; if not, write to the Free Software
    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301  USA */
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -78,9 +79,8 @@ namespace hash_join_unittest {
 
 static TableCollection CreateTenTableJoin(
     const my_testing::Server_initializer &initializer, MEM_ROOT *mem_root,
-    bool store_data) {
+    bool store_data, bool columns_nullable = true) {
   constexpr int kNumColumns = 10;
-  constexpr bool kColumnsNullable = true;
   constexpr int kNumTablesInJoin = 10;
   Prealloced_array<TABLE *, 4> tables(PSI_NOT_INSTRUMENTED);
 
@@ -92,7 +92,7 @@ static TableCollection CreateTenTableJoin(
   join.tables = kNumTablesInJoin;
   for (int i = 0; i < kNumTablesInJoin; ++i) {
     Fake_TABLE *fake_table =
-        new (mem_root) Fake_TABLE(kNumColumns, kColumnsNullable);
+        new (mem_root) Fake_TABLE(kNumColumns, columns_nullable);
     fake_table->pos_in_table_list->set_tableno(i);
     QEP_TAB *qep_tab = &join.qep_tab[i];
     qep_tab->set_qs(new (mem_root) QEP_shared);
@@ -166,6 +166,30 @@ static void BM_StoreFromTableBuffersWithData(size_t num_iterations) {
 }
 BENCHMARK(BM_StoreFromTableBuffersWithData)
 
+static void BM_StoreFromTableBuffersNotNull(size_t num_iterations) {
+  StopBenchmarkTiming();
+
+  my_testing::Server_initializer initializer;
+  initializer.SetUp();
+
+  MEM_ROOT mem_root;
+  TableCollection table_collection = CreateTenTableJoin(
+      initializer, &mem_root, true, /*columns_nullable=*/false);
+
+  String buffer;
+  buffer.reserve(1024);
+
+  StartBenchmarkTiming();
+  for (size_t i = 0; i < num_iterations; ++i) {
+    ASSERT_FALSE(StoreFromTableBuffers(table_collection, &buffer));
+    ASSERT_GT(buffer.length(), 0);
+  }
+  StopBenchmarkTiming();
+
+  DestroyFakeTables(table_collection);
+}
+BENCHMARK(BM_StoreFromTableBuffersNotNull)
+
 // Return eight bytes of data.
 static vector<uchar> GetShortData() { return {1, 2, 3, 4, 5, 6, 7, 8}; }
 
@@ -478,6 +502,34 @@ TEST(HashJoinTest, InnerJoinIntOneToManyMatch) {
               ElementsAre(2, 2));
 }
 
+TEST(HashJoinTest, InnerJoinIntParallelBuild) {
+  my_testing::Server_initializer initializer;
+  initializer.SetUp();
+  initializer.thd()->variables.hash_join_build_threads = 4;
+
+  // Enough rows to go through several rounds of staging and inserting.
+  vector<optional<int>> build_values;
+  for (int i = 0; i < 50000; ++i) build_values.push_back(i);
+  build_values.push_back(7);
+  HashJoinTestHelper test_helper(initializer, build_values,
+                                 {5, 49999, 50000, 7});
+
+  HashJoinIterator hash_join_iterator(
+      initializer.thd(), std::move(test_helper.left_iterator),
+      test_helper.left_tables(),
+      /*estimated_build_rows=*/1000, std::move(test_helper.right_iterator),
+      test_helper.right_tables(), /*store_rowids=*/false,
+      /*tables_to_get_rowid_for=*/0, 10 * 1024 * 1024 /* 10 MB */,
+      {*test_helper.join_condition}, true, JoinType::INNER,
+      test_helper.extra_conditions,
+      /*probe_input_batch_mode=*/false, nullptr);
+
+  ASSERT_FALSE(hash_join_iterator.Init());
+  EXPECT_THAT(CollectIntResults(&hash_join_iterator,
+                                test_helper.left_qep_tab->table()->field[0]),
+              ElementsAre(5, 49999, 7, 7));
+}
+
 TEST(HashJoinTest, InnerJoinStringOneToOneMatch) {
   my_testing::Server_initializer initializer;
   initializer.SetUp();
@@ -847,6 +899,165 @@ TEST(HashJoinTest, HashJoinChunkFiles) {
   EXPECT_EQ(2, hash_join_iterator.ChunkCount());
 }
 
+TEST(HashJoinTest, HashJoinChunkRepartitioning) {
+  my_testing::Server_initializer initializer;
+  initializer.SetUp();
+
+  vector<optional<int>> dataset;
+  constexpr int kDatasetSize = 5000;
+  for (int i = 0; i < kDatasetSize; ++i) {
+    dataset.emplace_back(i);
+  }
+
+  HashJoinTestHelper test_helper(initializer, dataset, dataset);
+
+  // Make the planner estimate far too low, so that all the rows that do not
+  // fit in the hash table go into a single chunk pair, which then has to be
+  // repartitioned.
+  HashJoinIterator hash_join_iterator(
+      initializer.thd(), std::move(test_helper.left_iterator),
+      test_helper.left_tables(), /*estimated_build_rows=*/1,
+      std::move(test_helper.right_iterator), test_helper.right_tables(),
+      /*store_rowids=*/false,
+      /*tables_to_get_rowid_for=*/0, 1024 /* 1 KB */,
+      {*test_helper.join_condition}, true, JoinType::INNER,
+      test_helper.extra_conditions,
+      /*probe_input_batch_mode=*/false, nullptr);
+
+  ASSERT_FALSE(hash_join_iterator.Init());
+  vector<optional<int>> results = CollectIntResults(
+      &hash_join_iterator, test_helper.left_qep_tab->table()->field[0]);
+  std::sort(results.begin(), results.end());
+  EXPECT_EQ(dataset, results);
+
+  const HashJoinSpillStats &stats = hash_join_iterator.spill_stats();
+  EXPECT_EQ(size_t{1}, stats.initial_chunks);
+  EXPECT_LT(size_t{0}, stats.repartitioned_chunks);
+  EXPECT_LT(stats.initial_chunks, stats.total_chunks);
+  EXPECT_EQ(static_cast<size_t>(hash_join_iterator.ChunkCount()),
+            stats.total_chunks);
+}
+
+TEST(HashJoinTest, StoredKey) {
+  using hash_join_buffer::Key;
+  using hash_join_buffer::StoredKey;
+
+  const string short_key(StoredKey::kMaxInlineLength, 'a');
+  const StoredKey inline_key = StoredKey::Inline(Key{short_key});
+  EXPECT_TRUE(inline_key.is_inline());
+  EXPECT_EQ(Key{short_key}, inline_key.Decode());
+
+  const StoredKey empty_key = StoredKey::Inline(Key{});
+  EXPECT_TRUE(empty_key.is_inline());
+  EXPECT_EQ(Key{}, empty_key.Decode());
+
+  MEM_ROOT mem_root(PSI_NOT_INSTRUMENTED, 1024);
+  const string long_key(StoredKey::kMaxInlineLength + 1, 'b');
+  char *ptr = pointer_cast<char *>(mem_root.Alloc(
+      ImmutableStringWithLength::RequiredBytesForEncode(long_key.size())));
+  const StoredKey external_key =
+      StoredKey::External(ImmutableStringWithLength::Encode(
+          long_key.data(), long_key.size(), &ptr));
+  EXPECT_FALSE(external_key.is_inline());
+  EXPECT_EQ(Key{long_key}, external_key.Decode());
+
+  const hash_join_buffer::KeyEquals equals;
+  const hash_join_buffer::KeyHasher hasher;
+  EXPECT_TRUE(equals(Key{short_key}, inline_key));
+  EXPECT_FALSE(equals(Key{long_key}, inline_key));
+  EXPECT_TRUE(equals(Key{long_key}, external_key));
+  EXPECT_FALSE(equals(inline_key, external_key));
+  EXPECT_EQ(hasher(Key{short_key}), hasher(inline_key));
+  EXPECT_EQ(hasher(Key{long_key}), hasher(external_key));
+}
+
+TEST(HashJoinTest, BloomFilter) {
+  MEM_ROOT mem_root(PSI_NOT_INSTRUMENTED, 1024);
+  hash_join_buffer::BloomFilter filter;
+  constexpr int kNumKeys = 10000;
+  ASSERT_FALSE(filter.Init(&mem_root, kNumKeys, /*max_bytes=*/1024 * 1024));
+  EXPECT_LE(size_t{kNumKeys}, filter.capacity());
+
+  for (int i = 0; i < kNumKeys; ++i) {
+    filter.Insert(pointer_cast<const char *>(&i), sizeof(i));
+  }
+  EXPECT_EQ(size_t{kNumKeys}, filter.num_keys());
+
+  // No false negatives, and a false positive rate close to 1%.
+  int false_positives = 0;
+  for (int i = 0; i < 2 * kNumKeys; ++i) {
+    const bool may_contain =
+        filter.MayContain(pointer_cast<const char *>(&i), sizeof(i));
+    if (i < kNumKeys) {
+      EXPECT_TRUE(may_contain);
+    } else if (may_contain) {
+      ++false_positives;
+    }
+  }
+  EXPECT_GT(kNumKeys / 20, false_positives);
+
+  filter.Clear();
+  EXPECT_EQ(size_t{0}, filter.num_keys());
+  int key = 0;
+  EXPECT_FALSE(
+      filter.MayContain(pointer_cast<const char *>(&key), sizeof(key)));
+}
+
+// Tables where all columns are fixed-width and NOT NULL are stored as raw
+// copies of the record buffer; verify that such rows survive a round trip.
+TEST(HashJoinTest, StoreAndLoadFixedWidthColumns) {
+  my_testing::Server_initializer initializer;
+  initializer.SetUp();
+
+  Fake_TABLE nullable_table(3, /*cols_nullable=*/true);
+  Fake_TABLE not_null_table(3, /*cols_nullable=*/false);
+
+  // Place the NOT NULL columns back to back, so that they can be copied as
+  // a single run.
+  for (uint i = 0; i < not_null_table.s->fields; ++i) {
+    not_null_table.field[i]->set_field_ptr(
+        not_null_table.record[0] + i * not_null_table.field[0]->pack_length());
+  }
+
+  Prealloced_array<TABLE *, 4> tables(PSI_NOT_INSTRUMENTED);
+  tables.push_back(&nullable_table);
+  tables.push_back(&not_null_table);
+  TableCollection table_collection(tables, /*store_rowids=*/false,
+                                   /*tables_to_get_rowid_for=*/0);
+  ASSERT_EQ(size_t{2}, table_collection.tables().size());
+  EXPECT_FALSE(table_collection.tables()[0].use_column_runs);
+  const pack_rows::Table &not_null = table_collection.tables()[1];
+  ASSERT_TRUE(not_null.use_column_runs);
+  ASSERT_EQ(size_t{1}, not_null.column_runs.size());
+  EXPECT_EQ(size_t{3} * not_null_table.field[0]->pack_length(),
+            not_null.column_runs[0].length);
+
+  bitmap_set_all(nullable_table.write_set);
+  bitmap_set_all(not_null_table.write_set);
+  for (uint i = 0; i < 3; ++i) {
+    nullable_table.field[i]->set_notnull();
+    nullable_table.field[i]->store(10 + i, /*unsigned_val=*/false);
+    not_null_table.field[i]->store(-20 - static_cast<int>(i),
+                                   /*unsigned_val=*/false);
+  }
+
+  String buffer;
+  ASSERT_FALSE(StoreFromTableBuffers(table_collection, &buffer));
+
+  for (uint i = 0; i < 3; ++i) {
+    nullable_table.field[i]->store(0, /*unsigned_val=*/false);
+    not_null_table.field[i]->store(0, /*unsigned_val=*/false);
+  }
+
+  const uchar *end = LoadIntoTableBuffers(
+      table_collection, pointer_cast<const uchar *>(buffer.ptr()));
+  EXPECT_EQ(pointer_cast<const uchar *>(buffer.ptr()) + buffer.length(), end);
+  for (uint i = 0; i < 3; ++i) {
+    EXPECT_EQ(10 + static_cast<int>(i), nullable_table.field[i]->val_int());
+    EXPECT_EQ(-20 - static_cast<int>(i), not_null_table.field[i]->val_int());
+  }
+}
+
 TEST(HashJoinTest, InnerJoinIntNullable) {
   my_testing::Server_initializer initializer;
   initializer.SetUp();
@@ -2234,6 +2234,97 @@ TEST_F(HistogramsTest, BigEquiHeight) {
   VerifyEquiHeightBucketConstraintsInt(histogram);
 }
 
+/*
+  Attach column-group statistics to a histogram, and check that they survive
+  cloning and a round trip through JSON.
+*/
+TEST_F(HistogramsTest, ColumnGroupSerialization) {
+  Value_map<longlong> values(&my_charset_numeric, Value_map_type::INT);
+  for (longlong i = 0; i < 100; i++) values.add_values(i, 10);
+
+  Equi_height<longlong> *histogram = Equi_height<longlong>::create(
+      &m_mem_root, "db1", "tbl1", "col1", Value_map_type::INT);
+  ASSERT_TRUE(histogram != nullptr);
+  EXPECT_FALSE(histogram->build_histogram(values, 10U));
+  EXPECT_TRUE(histogram->get_column_groups().empty());
+  EXPECT_FALSE(histogram->add_column_group({"col1", "col2"}, 150.0));
+
+  const Histogram *clone = histogram->clone(&m_mem_root);
+  ASSERT_TRUE(clone != nullptr);
+
+  Json_object json_object;
+  EXPECT_FALSE(clone->histogram_to_json(&json_object));
+  Error_context ctx;
+  Histogram *deserialized = Histogram::json_to_histogram(
+      &m_mem_root, "db1", "tbl1", "col1", json_object, &ctx);
+  ASSERT_TRUE(deserialized != nullptr);
+
+  ASSERT_EQ(1U, deserialized->get_column_groups().size());
+  const histograms::Column_group_statistics &group =
+      deserialized->get_column_groups()[0];
+  ASSERT_EQ(2U, group.num_columns);
+  EXPECT_STREQ("col1", group.column_names[0].str);
+  EXPECT_STREQ("col2", group.column_names[1].str);
+  EXPECT_DOUBLE_EQ(150.0, group.num_distinct_values);
+}
+
+/*
+  Merge a sample into an existing equi-height histogram. The sample has
+  values outside the existing buckets' boundaries and a different fraction of
+  NULL values, and the merged histogram must still satisfy the bucket
+  constraints.
+*/
+TEST_F(HistogramsTest, EquiHeightMergeSample) {
+  Value_map<longlong> values(&my_charset_numeric, Value_map_type::INT);
+  for (longlong i = 0; i < 100; i++) values.add_values(i * 10, 10);
+
+  Equi_height<longlong> *histogram = Equi_height<longlong>::create(
+      &m_mem_root, "db1", "tbl1", "col1", Value_map_type::INT);
+  ASSERT_TRUE(histogram != nullptr);
+  EXPECT_FALSE(histogram->build_histogram(values, 10U));
+  EXPECT_EQ(10U, histogram->get_num_buckets());
+  EXPECT_DOUBLE_EQ(0.0, histogram->get_null_values_fraction());
+
+  // The new rows are all above the current maximum, or NULL.
+  Value_map<longlong> sample(&my_charset_numeric, Value_map_type::INT);
+  sample.add_null_values(100);
+  for (longlong i = 0; i < 100; i++) sample.add_values(i * 10, 1);
+  for (longlong i = 1000; i < 1200; i++) sample.add_values(i, 1);
+
+  EXPECT_FALSE(histogram->merge_sample(sample, 0.5));
+  EXPECT_EQ(10U, histogram->get_num_buckets());
+  EXPECT_DOUBLE_EQ(0.5 * 0.25, histogram->get_null_values_fraction());
+  VerifyEquiHeightBucketConstraintsInt(histogram);
+
+  // The last bucket now reaches the new maximum.
+  EXPECT_DOUBLE_EQ(0.0, histogram->get_greater_than_selectivity(1199));
+  EXPECT_GT(histogram->get_greater_than_selectivity(1000), 0.1);
+  EXPECT_GT(histogram->get_less_than_selectivity(1000), 0.5);
+}
+
+/*
+  Merging into a histogram built from NULL values only builds a new
+  histogram from the sample.
+*/
+TEST_F(HistogramsTest, EquiHeightMergeSampleIntoEmpty) {
+  Value_map<longlong> values(&my_charset_numeric, Value_map_type::INT);
+  values.add_null_values(10);
+
+  Equi_height<longlong> *histogram = Equi_height<longlong>::create(
+      &m_mem_root, "db1", "tbl1", "col1", Value_map_type::INT);
+  ASSERT_TRUE(histogram != nullptr);
+  EXPECT_FALSE(histogram->build_histogram(values, 4U));
+  EXPECT_EQ(0U, histogram->get_num_buckets());
+
+  Value_map<longlong> sample(&my_charset_numeric, Value_map_type::INT);
+  for (longlong i = 0; i < 100; i++) sample.add_values(i, 1);
+
+  EXPECT_FALSE(histogram->merge_sample(sample, 0.5));
+  EXPECT_EQ(4U, histogram->get_num_buckets());
+  EXPECT_DOUBLE_EQ(0.0, histogram->get_null_values_fraction());
+  VerifyEquiHeightBucketConstraintsInt(histogram);
+}
+
 /*
   Build a singleton histogram, and check if the printed time is within a few
   seconds of the current time.
@@ -4721,6 +4721,60 @@ TEST_F(HypergraphOptimizerTest, SimpleRangeScan) {
   query_block->cleanup(/*full=*/true);
 }
 
+TEST_F(HypergraphOptimizerTest, LargeInListRangeScan) {
+  Query_block *query_block =
+      ParseAndResolve("SELECT 1 FROM t1 WHERE t1.x IN (7, 3, 5, 3)",
+                      /*nullable=*/false);
+
+  Fake_TABLE *t1 = m_fake_tables["t1"];
+  t1->file->stats.records = 1000;
+  t1->create_index(t1->field[0], nullptr, /*unique=*/false);
+
+  // Mark the index as supporting range scans.
+  ON_CALL(*down_cast<Mock_HANDLER *>(m_fake_tables["t1"]->file),
+          index_flags(_, _, _))
+      .WillByDefault(Return(HA_READ_RANGE | HA_READ_NEXT | HA_READ_PREV));
+
+  // Do not expand the IN-list into one range per value.
+  m_thd->variables.range_optimizer_max_in_list_expansion = 2;
+  string trace;
+  AccessPath *root = FindBestQueryPlan(m_thd, query_block, &trace);
+  m_thd->variables.range_optimizer_max_in_list_expansion = 0;
+  SCOPED_TRACE(trace);  // Prints out the trace on failure.
+  // Prints out the query plan on failure.
+  SCOPED_TRACE(PrintQueryPlan(0, root, query_block->join,
+                              /*is_root_of_join=*/true));
+
+  // The range covers values that are not in the list, so the IN predicate
+  // must be rechecked.
+  ASSERT_EQ(AccessPath::FILTER, root->type);
+  AccessPath *range_scan = root->filter().child;
+  ASSERT_EQ(AccessPath::INDEX_RANGE_SCAN, range_scan->type);
+  ASSERT_EQ(1, range_scan->index_range_scan().num_ranges);
+  EXPECT_EQ(0, range_scan->index_range_scan().ranges[0]->flag);
+  string_view min_key{
+      pointer_cast<char *>(range_scan->index_range_scan().ranges[0]->min_key),
+      range_scan->index_range_scan().ranges[0]->min_length};
+  string_view max_key{
+      pointer_cast<char *>(range_scan->index_range_scan().ranges[0]->max_key),
+      range_scan->index_range_scan().ranges[0]->max_length};
+  EXPECT_EQ("\x03\x00\x00\x00"sv, min_key);
+  EXPECT_EQ("\x07\x00\x00\x00"sv, max_key);
+
+  // The scan looks up the distinct values, in index order.
+  const In_list_keys *in_list_keys =
+      range_scan->index_range_scan().in_list_keys;
+  ASSERT_NE(nullptr, in_list_keys);
+  ASSERT_EQ(3, in_list_keys->num_keys);
+  EXPECT_EQ(4, in_list_keys->key_length);
+  EXPECT_EQ(EQ_RANGE, in_list_keys->flag);
+  string_view keys{pointer_cast<const char *>(in_list_keys->keys),
+                   in_list_keys->num_keys * in_list_keys->key_length};
+  EXPECT_EQ("\x03\x00\x00\x00\x05\x00\x00\x00\x07\x00\x00\x00"sv, keys);
+
+  query_block->cleanup(/*full=*/true);
+}
+
 TEST_F(HypergraphOptimizerTest, ComplexMultipartRangeScan) {
   Query_block *query_block = ParseAndResolve(
       "SELECT 1 FROM t1 "
@@ -26,6 +26,7 @@
 #include <gtest/gtest.h>
 #include <atomic>
 #include <chrono>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -33,6 +34,7 @@
 
 #include "os0thread.h"
 #include "sync0arr_impl.h"
+#include "unittest/gunit/benchmark.h"
 
 namespace innodb_sync0rw_unittest {
 
@@ -246,4 +248,86 @@ TEST(sync0rw, rw_lock_reader_thread) {
   os_event_global_destroy();
 }
 
+/** Number of threads used by the contended rw_lock benchmarks. Can be
+overridden with the MYSQL_BENCHMARK_THREADS environment variable. */
+static size_t benchmark_thread_count() {
+  const char *threads = getenv("MYSQL_BENCHMARK_THREADS");
+  if (threads != nullptr && atoi(threads) > 0) return atoi(threads);
+  return 4;
+}
+
+/** Runs the given rw_lock action num_iterations times in each of n_threads
+threads, all working on the same latch. Only the time spent in the worker
+threads is measured. */
+template <typename Action>
+static void benchmark_rw_lock(const size_t num_iterations, size_t n_threads,
+                              Action action) {
+  StopBenchmarkTiming();
+
+  os_event_global_init();
+  sync_check_init(n_threads + 1);
+
+  auto rw_lock = static_cast<rw_lock_t *>(malloc(sizeof(rw_lock_t)));
+  rw_lock_create(PSI_NOT_INSTRUMENTED, rw_lock, LATCH_ID_BUF_BLOCK_LOCK);
+
+  std::vector<std::thread> threads;
+  threads.reserve(n_threads);
+
+  StartBenchmarkTiming();
+
+  for (size_t i = 0; i < n_threads; ++i) {
+    threads.emplace_back([&] {
+      for (size_t n = 0; n < num_iterations; ++n) {
+        action(rw_lock);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  StopBenchmarkTiming();
+
+  EXPECT_EQ(rw_lock_get_reader_count(rw_lock), 0);
+  rw_lock_free(rw_lock);
+  free(rw_lock);
+
+  sync_check_close();
+  os_event_global_destroy();
+
+  StartBenchmarkTiming();
+}
+
+static void rw_lock_s_lock_unlock(rw_lock_t *rw_lock) {
+  rw_lock_s_lock(rw_lock, UT_LOCATION_HERE);
+  rw_lock_s_unlock(rw_lock);
+}
+
+static void rw_lock_x_lock_unlock(rw_lock_t *rw_lock) {
+  rw_lock_x_lock(rw_lock, UT_LOCATION_HERE);
+  rw_lock_x_unlock(rw_lock);
+}
+
+static void BM_RW_LOCK_S_LOCK_UNLOCK(const size_t num_iterations) {
+  benchmark_rw_lock(num_iterations, 1, rw_lock_s_lock_unlock);
+}
+BENCHMARK(BM_RW_LOCK_S_LOCK_UNLOCK)
+
+static void BM_RW_LOCK_X_LOCK_UNLOCK(const size_t num_iterations) {
+  benchmark_rw_lock(num_iterations, 1, rw_lock_x_lock_unlock);
+}
+BENCHMARK(BM_RW_LOCK_X_LOCK_UNLOCK)
+
+static void BM_RW_LOCK_S_LOCK_UNLOCK_CONTENDED(const size_t num_iterations) {
+  benchmark_rw_lock(num_iterations, benchmark_thread_count(),
+                    rw_lock_s_lock_unlock);
+}
+BENCHMARK(BM_RW_LOCK_S_LOCK_UNLOCK_CONTENDED)
+
+static void BM_RW_LOCK_X_LOCK_UNLOCK_CONTENDED(const size_t num_iterations) {
+  benchmark_rw_lock(num_iterations, benchmark_thread_count(),
+                    rw_lock_x_lock_unlock);
+}
+BENCHMARK(BM_RW_LOCK_X_LOCK_UNLOCK_CONTENDED)
+
 }  // namespace innodb_sync0rw_unittest
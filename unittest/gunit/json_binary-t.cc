@@ -752,6 +752,70 @@ TEST_F(JsonBinaryTest, StringLengthTest) {
   serialize_deserialize_string(thd, 3000000);
 }
 
+/*
+  Verify that serialize_text() produces the same binary as parsing the
+  text into a DOM and serializing the DOM.
+*/
+static void serialize_text_matches_dom(const THD *thd,
+                                       const std::string &text) {
+  SCOPED_TRACE(text.substr(0, 100));
+  String expected;
+  EXPECT_FALSE(json_binary::serialize(thd, parse_json(text.c_str()).get(),
+                                      &expected));
+
+  String actual;
+  EXPECT_FALSE(json_binary::serialize_text(
+      thd, text.data(), text.length(), &actual,
+      [](const char *, size_t) { ADD_FAILURE(); }, [] { ADD_FAILURE(); }));
+  EXPECT_EQ(std::string(expected.ptr(), expected.length()),
+            std::string(actual.ptr(), actual.length()));
+}
+
+TEST_F(JsonBinaryTest, SerializeText) {
+  const THD *thd = this->thd();
+  for (const char *text :
+       {"null", "true", "false", "0", "-1", "32767", "32768", "-32769",
+        "65535", "65536", "2147483648", "4294967296", "-2147483649",
+        "9223372036854775807", "18446744073709551615", "-9223372036854775808",
+        "3.14", "-1e300", "\"\"", "\"abc\"", "[]", "{}",
+        "[1, 70000, 5000000000, -70000, 4294967295, null, true, \"x\", 1.5]",
+        "{\"b\": 1, \"a\": [2, {\"cc\": 3, \"c\": 4}], \"aa\": \"x\"}",
+        "{\"a\": 1, \"b\": 2, \"a\": 3}",
+        "{\"a\": {\"x\": 1}, \"a\": [1, 2], \"a\": {\"y\": 2}, \"b\": 0}",
+        "[[[]], {\"\": {}}, [{}]]"})
+    serialize_text_matches_dom(thd, text);
+
+  // Documents that need the large storage format, at the top level and
+  // nested inside a small container.
+  std::string big_array = "[";
+  std::string big_object = "{";
+  for (int i = 0; i < 20000; ++i) {
+    if (i > 0) {
+      big_array += ", ";
+      big_object += ", ";
+    }
+    big_array += "\"" + std::to_string(i) + "\"";
+    big_object +=
+        "\"k" + std::to_string(i % 15000) + "\": " + std::to_string(i * 7);
+  }
+  big_array += "]";
+  big_object += "}";
+  serialize_text_matches_dom(thd, big_array);
+  serialize_text_matches_dom(thd, big_object);
+  serialize_text_matches_dom(thd, "[1, " + big_array + ", {\"a\": " +
+                                      big_object + "}, 2]");
+
+  // Invalid text is reported through the error handler.
+  String buf;
+  bool error_reported = false;
+  const std::string bad = "{\"a\": [1, 2}";
+  EXPECT_TRUE(json_binary::serialize_text(
+      thd, bad.data(), bad.length(), &buf,
+      [&error_reported](const char *, size_t) { error_reported = true; },
+      [] { ADD_FAILURE(); }));
+  EXPECT_TRUE(error_reported);
+}
+
 /**
   Error handler which registers if an error has been raised. If an error is
   raised, it asserts that the error is ER_INVALID_JSON_BINARY_DATA.
@@ -356,6 +356,20 @@ void JsonPathTest::vet_wrapper_seek(const char *json_text,
   good_path_common(path_text, &path);
   vet_wrapper_seek(&dom_wrapper, path, expected, expected_null);
   vet_wrapper_seek(&binary_wrapper, path, expected, expected_null);
+
+  // Paths that match at most one value can also be walked directly on
+  // the binary representation. Verify that this gives the same answer.
+  if (!path.can_match_many()) {
+    Json_wrapper hit;
+    const bool found = binary_wrapper.seek_single(path, true, &hit);
+    EXPECT_EQ(!expected_null, found);
+    if (found) {
+      String buffer;
+      EXPECT_FALSE(
+          hit.to_string(&buffer, true, "test", [] { ASSERT_TRUE(false); }));
+      EXPECT_EQ(expected, std::string(buffer.ptr(), buffer.length()));
+    }
+  }
 }
 
 void vet_dom_location(const char *json_text, const char *path_text) {
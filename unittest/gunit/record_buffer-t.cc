@@ -135,4 +135,26 @@ TEST(RecordBufferTest, Reset) {
   EXPECT_EQ(0U, buf.records());
 }
 
+TEST(RecordBufferTest, Truncate) {
+  constexpr ha_rows rows = 10;
+  constexpr size_t row_size = 10;
+  uchar ch[Record_buffer::buffer_size(rows, row_size)];
+  Record_buffer buf(rows, row_size, ch);
+  const uchar *first = buf.add_record();
+  buf.add_record();
+  buf.add_record();
+  buf.set_out_of_range(true);
+  /*
+    Record_buffer::truncate() should keep the first records only, and it
+    should keep the out-of-range flag.
+  */
+  buf.truncate(1);
+  EXPECT_EQ(1U, buf.records());
+  EXPECT_TRUE(buf.is_out_of_range());
+  EXPECT_EQ(first, buf.record(0));
+  EXPECT_EQ(buf.record(1), buf.add_record());
+  buf.truncate(0);
+  EXPECT_EQ(0U, buf.records());
+}
+
 }  // namespace record_buffer_unittest
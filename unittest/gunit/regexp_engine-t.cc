@@ -152,4 +152,31 @@ TEST_F(RegexpEngineTest, AppendTail) {
   EXPECT_EQ(3, engine.replace_pos());
 }
 
+TEST_F(RegexpEngineTest, RecompileSamePattern) {
+  // The second engine is cloned from the cache of compiled patterns. The two
+  // must not share any matching state.
+  Regexp_engine first(m_pattern, 0, 0, 0);
+  Regexp_engine second(m_pattern, 0, 0, 0);
+  EXPECT_FALSE(first.IsError());
+  EXPECT_FALSE(second.IsError());
+
+  std::u16string other_subject{'b', 'b'};
+  first.Reset(m_subject);
+  second.Reset(other_subject);
+  EXPECT_TRUE(first.Matches(0, 1));
+  EXPECT_TRUE(second.Matches(0, 2));
+  EXPECT_EQ(1, first.StartOfMatch());
+  EXPECT_EQ(1, second.StartOfMatch());
+  EXPECT_FALSE(first.Matches(0, 2));
+
+  // Same pattern, different flags.
+  Regexp_engine case_insensitive(std::u16string{'B'}, UREGEX_CASE_INSENSITIVE,
+                                 0, 0);
+  Regexp_engine case_sensitive(std::u16string{'B'}, 0, 0, 0);
+  case_insensitive.Reset(m_subject);
+  case_sensitive.Reset(m_subject);
+  EXPECT_TRUE(case_insensitive.Matches(0, 1));
+  EXPECT_FALSE(case_sensitive.Matches(0, 1));
+}
+
 }  // namespace regexp_engine_unittest
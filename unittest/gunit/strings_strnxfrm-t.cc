@@ -2192,6 +2192,46 @@ TEST(StrxfrmTest, Contractions) {
   EXPECT_LT(compare_through_strxfrm(hu_ai_ci, "cukor", "csak"), 0);
 }
 
+static int sign(int x) { return (x > 0) - (x < 0); }
+
+/*
+  strnncoll() skips common printable ASCII prefixes before running the
+  scanners. Verify that it still orders strings the same way as strnxfrm().
+*/
+TEST(StrnncollTest, AsciiPrefixAgreesWithStrxfrm) {
+  const char *collations[] = {"utf8mb4_0900_ai_ci", "utf8mb4_0900_as_ci",
+                              "utf8mb4_0900_as_cs", "utf8mb4_hu_0900_ai_ci"};
+  const char *strings[] = {"",
+                           "abc",
+                           "ABC",
+                           "abcdefghijkl",
+                           "ABCDEFGHIJKL",
+                           "abcdefghijklm",
+                           "abcdefghijkl ",
+                           "abcdefghijk_",
+                           "abcdefghijk-",
+                           "abcdefghijk\x01l",
+                           "abcdefghijk\tl",
+                           u8"abcdefghijk\u00e9",
+                           u8"abcdefghijke\u0301",
+                           "abcdefghcsk",
+                           "abcdefghczk",
+                           "0123456789",
+                           "0123456789a"};
+  for (const char *name : collations) {
+    CHARSET_INFO *cs = init_collation(name);
+    for (const char *a : strings) {
+      for (const char *b : strings) {
+        SCOPED_TRACE(std::string(name) + ": '" + a + "' vs. '" + b + "'");
+        const int res = cs->coll->strnncoll(
+            cs, pointer_cast<const uchar *>(a), strlen(a),
+            pointer_cast<const uchar *>(b), strlen(b), false);
+        EXPECT_EQ(sign(compare_through_strxfrm(cs, a, b)), sign(res));
+      }
+    }
+  }
+}
+
 /*
   This test is disabled by default since it needs ~10 seconds to run,
   even in optimized mode.
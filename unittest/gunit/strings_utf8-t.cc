@@ -792,4 +792,51 @@ TEST(WellFormedCopy, WellFormed) {
       &my_charset_utf8mb4_0900_ai_ci, &my_charset_utf8mb4_0900_ai_ci,
       u8"でもっとも普及しているオープンソースデータベースソフトウ"));
 }
+
+TEST(WellFormedLen, LongAsciiRuns) {
+  const CHARSET_INFO *cs = &my_charset_utf8mb4_0900_ai_ci;
+  const std::string str = u8"abcdefghijklmnopÅqrstuvwxyz0123456789";
+  int error;
+
+  // Stops after the requested number of characters, inside an ASCII run.
+  EXPECT_EQ(10U, cs->cset->well_formed_len(cs, str.data(),
+                                           str.data() + str.size(), 10, &error));
+  EXPECT_EQ(0, error);
+  EXPECT_EQ(str.size(),
+            cs->cset->well_formed_len(cs, str.data(), str.data() + str.size(),
+                                      str.size(), &error));
+  EXPECT_EQ(0, error);
+
+  // An invalid byte after a long ASCII run is still found.
+  const std::string bad = std::string(20, 'a') + "\xff" + std::string(20, 'b');
+  EXPECT_EQ(20U, cs->cset->well_formed_len(cs, bad.data(),
+                                           bad.data() + bad.size(), 100, &error));
+  EXPECT_EQ(1, error);
+}
+
+TEST(Convert, MixedAsciiUtf8mb4ToLatin1) {
+  const std::string from =
+      u8"The quick brown fox jumps over the lazy dog. Æble og øl på "
+      u8"café, 20 →.";
+  const std::string expected =
+      "The quick brown fox jumps over the lazy dog. \xc6"
+      "ble og \xf8l p\xe5 caf\xe9, 20 ?.";
+  char to[128];
+  uint errors;
+  const size_t length =
+      my_convert(to, sizeof(to), &my_charset_latin1, from.data(), from.size(),
+                 &my_charset_utf8mb4_0900_ai_ci, &errors);
+  EXPECT_EQ(expected, std::string(to, length));
+  EXPECT_EQ(1U, errors);  // The arrow is not in latin1.
+
+  // And back again.
+  char back[128];
+  const size_t back_length =
+      my_convert(back, sizeof(back), &my_charset_utf8mb4_0900_ai_ci, to,
+                 length, &my_charset_latin1, &errors);
+  EXPECT_EQ(0U, errors);
+  EXPECT_EQ(std::string(u8"The quick brown fox jumps over the lazy dog. "
+                        u8"Æble og øl på café, 20 ?."),
+            std::string(back, back_length));
+}
 }  // namespace strings_utf8_unittest
@@ -26,6 +26,7 @@
 #include <memory>
 #include <vector>
 
+#include "my_byteorder.h"
 #include "mysql/plugin.h"
 #include "sql/mysqld.h"
 #include "storage/temptable/include/temptable/handler.h"
@@ -577,4 +578,57 @@ TEST_F(Handler_test, IndexOnOff) {
   EXPECT_EQ(handler.delete_table(table_name, nullptr), 0);
 }
 
+TEST_F(Handler_test, UniqueHashIndexGrowth) {
+  const char *table_name = "t1";
+
+  Table_helper table_helper(table_name, thd());
+  table_helper.add_field_long("col0", false);
+  table_helper.add_field_long("col1", false);
+  table_helper.add_index(HA_KEY_ALG_HASH, true, {0});
+  table_helper.finalize();
+
+  temptable::Handler handler(hton(), table_helper.table_share());
+  table_helper.set_handler(&handler);
+
+  EXPECT_EQ(handler.create(table_name, table_helper.table(), nullptr, nullptr),
+            0);
+  EXPECT_EQ(handler.open(table_name, 0, 0, nullptr), 0);
+
+  /* Enough rows for the index to grow several times, with each insert
+   * checked against the rows that may still be in the old slot array. */
+  constexpr int n_rows = 10000;
+
+  for (int i = 0; i < n_rows; ++i) {
+    table_helper.field<Field_long>(0)->store(i, false);
+    table_helper.field<Field_long>(1)->store(i * 2, false);
+    EXPECT_EQ(handler.write_row(table_helper.record_0()), 0);
+
+    table_helper.field<Field_long>(0)->store(i / 2, false);
+    EXPECT_EQ(handler.write_row(table_helper.record_0()),
+              HA_ERR_FOUND_DUPP_KEY);
+  }
+
+  EXPECT_EQ(handler.index_init(0, false), 0);
+
+  unsigned char key[4];
+
+  for (int i = 0; i < n_rows; ++i) {
+    int4store(key, i);
+    EXPECT_EQ(handler.index_read(table_helper.record_0(), key, sizeof(key),
+                                 HA_READ_KEY_EXACT),
+              0);
+    EXPECT_EQ(table_helper.field<Field_long>(1)->val_int(), i * 2);
+  }
+
+  int4store(key, n_rows);
+  EXPECT_EQ(handler.index_read(table_helper.record_0(), key, sizeof(key),
+                               HA_READ_KEY_EXACT),
+            HA_ERR_KEY_NOT_FOUND);
+
+  EXPECT_EQ(handler.index_end(), 0);
+
+  EXPECT_EQ(handler.close(), 0);
+  EXPECT_EQ(handler.delete_table(table_name, nullptr), 0);
+}
+
 }  // namespace temptable_test
@@ -406,6 +406,32 @@ bool vio_reset(Vio *vio, enum enum_vio_type type, my_socket sd,
   return ret;
 }
 
+/**
+  Switch a plain socket Vio to buffered reads, so that small packets sent
+  back to back by the peer are fetched from the socket with one read.
+
+  Must not be used while data still has to be read directly from the socket,
+  e.g. before a TLS handshake.
+
+  @param vio  The Vio.
+
+  @retval true  Not a plain socket, or out of memory. The Vio is unchanged.
+  @retval false Success.
+*/
+bool vio_set_buffered_read(Vio *vio) {
+  if (vio->type != VIO_TYPE_TCPIP && vio->type != VIO_TYPE_SOCKET) return true;
+  if (vio->read_buffer != nullptr) return false;
+
+  vio->read_buffer = (char *)my_malloc(key_memory_vio_read_buffer,
+                                       VIO_READ_BUFFER_SIZE, MYF(0));
+  if (vio->read_buffer == nullptr) return true;
+
+  vio->read_pos = vio->read_end = vio->read_buffer;
+  vio->read = vio_read_buff;
+  vio->has_data = vio_buff_has_data;
+  return false;
+}
+
 Vio *internal_vio_create(uint flags) {
   void *rawmem = my_malloc(key_memory_vio, sizeof(Vio), MYF(MY_WME));
   if (rawmem == nullptr) return nullptr;